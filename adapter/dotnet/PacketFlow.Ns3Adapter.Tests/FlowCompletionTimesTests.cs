@@ -0,0 +1,65 @@
+// FlowCompletionTimesTests.cs
+// Tests for native flow completion time tracking on a real TCP transfer.
+//
+// Verifies:
+// - A BulkSend of known size is reported as exactly one flow of that size
+// - The flow completes, with a completion time inside the run
+// - The completed flow lands in the expected size bucket of the distribution
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+
+namespace PacketFlow.Ns3Adapter.Tests;
+
+public class FlowCompletionTimesTests
+{
+    /// <summary>
+    /// Verifies that one BulkSend transfer over a point-to-point link is
+    /// tracked as a single complete flow of the sent size. The handshake's
+    /// SYN-ACK and the receiver's FIN must not show up as a second flow.
+    /// </summary>
+    [Fact]
+    public void BulkSend_KnownSize_ReportsOneCompleteFlow()
+    {
+        const long size = 100_000;
+        var start = TimeSpan.FromSeconds(1.0);
+        var stop = TimeSpan.FromSeconds(5.0);
+
+        using var sim = new Simulation();
+        sim.SetSeed(42);
+
+        var nodes = sim.CreateNodes(2);
+        sim.InstallInternetStack(nodes);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "10Mbps", "2ms");
+        sim.AssignIpv4Addresses(new[] { dev0, dev1 }, "10.1.1.0", "255.255.255.0");
+
+        TrafficApps.Install(sim, nodes, new[]
+        {
+            new AppSpec(AppKind.PacketSink, 1, 5000),
+            new AppSpec(AppKind.BulkSend, 0, 5000) { PeerNode = 1, Size = size, Start = start },
+        });
+
+        var fct = FlowCompletionTimes.InstallAll(sim, sizeEdges: new long[] { 10_000, 1_000_000 });
+
+        sim.Stop(stop);
+        sim.Run();
+
+        // Assert: one TCP flow of exactly the bytes sent
+        var flow = Assert.Single(fct.GetFlows());
+        Assert.Equal(6, flow.Protocol);
+        Assert.Equal(5000, flow.DestinationPort);
+        Assert.Equal(size, flow.Bytes);
+        Assert.True(flow.Complete, "Flow should complete once the sender's FIN is delivered");
+
+        // 100 kB at 10 Mbps takes at least 80 ms, and everything happens inside the run
+        Assert.InRange(flow.StartSeconds, start.TotalSeconds, stop.TotalSeconds);
+        Assert.InRange(flow.CompletionSeconds, size * 8 / 10e6, stop.TotalSeconds - flow.StartSeconds);
+
+        // Assert: counted once, in the (10 kB, 1 MB] bucket
+        var distribution = fct.GetDistribution(new[] { 0.5 });
+        Assert.Equal(1, distribution.BucketOf(size));
+        Assert.Equal(new long[] { 0, 1, 0 }, distribution.Buckets.Select(b => b.Flows).ToArray());
+        Assert.Equal(flow.CompletionSeconds, distribution.Buckets[1].MinSeconds, 9);
+        Assert.Equal(flow.CompletionSeconds, distribution.Get(1, 0.5), 6);
+    }
+}
@@ -0,0 +1,80 @@
+// FlowQuantilesTests.cs
+// Tests for the native per-flow quantile estimates (FlowMonitor.GetQuantiles)
+// on real UDP traffic.
+//
+// Verifies:
+// - Every flow contributes to the mean-delay digest exactly once
+// - The p50 and p99 estimates of mean delay are within 1% of the flows, by
+//   rank, of the exact quantiles of FlowMonitor's own per-flow delay sums
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+
+namespace PacketFlow.Ns3Adapter.Tests;
+
+public class FlowQuantilesTests
+{
+    private const int Flows = 200;
+    private const ushort SinkPort = 9;
+
+    // Allowed error of an estimate, as a fraction of the flows (t-digest error is in rank)
+    private const double RankError = 0.01;
+
+    /// <summary>
+    /// Sends 200 short UDP flows of distinct packet sizes over a point-to-point
+    /// link, one after the other, so each has its own mean delay. The exact
+    /// per-flow means come from FlowMonitor's delay sums, read back through a
+    /// FlowEpochs snapshot after the traffic ends; the estimates must fall
+    /// between the exact values RankError of the flows either side of p50 and p99.
+    /// </summary>
+    [Fact]
+    public void MeanDelay_DistinctFlows_P50AndP99WithinRankError()
+    {
+        using var sim = new Simulation();
+        sim.SetSeed(5);
+
+        var nodes = sim.CreateNodes(2);
+        sim.InstallInternetStack(nodes);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "10Mbps", "2ms");
+        sim.AssignIpv4Addresses(new[] { dev0, dev1 }, "10.1.1.0", "255.255.255.0");
+
+        // A UdpServer sink, so no ICMP replies add reverse flows
+        TrafficApps.Install(sim, nodes, new[] { new AppSpec(AppKind.UdpServer, 1, SinkPort) });
+
+        // Flow i: 5 packets of 100 + 6i bytes, 3 ms apart, starting 20 ms after flow i - 1
+        for (int i = 0; i < Flows; i++)
+        {
+            var generator = TrafficGenerator.Create(sim, nodes[0], "10.1.1.2", SinkPort,
+                TimeSpan.FromMilliseconds(3), packetSize: (uint)(100 + 6 * i), maxPackets: 5);
+            generator.Start(TimeSpan.FromSeconds(1.0 + i * 0.02));
+        }
+
+        var monitor = FlowMonitor.InstallAll(sim);
+        var epochs = FlowEpochs.Start(monitor, TimeSpan.FromSeconds(1.0));
+
+        sim.Stop(TimeSpan.FromSeconds(8.0));
+        sim.Run();
+
+        // Exact per-flow mean delays from the cumulative counters of the last snapshot
+        var report = epochs.Export();
+        int last = report.EpochCount - 1;
+        var exact = new List<double>();
+        for (int flow = 0; flow < report.FlowCount; flow++)
+        {
+            long received = report.RxPackets[last, flow];
+            if (received > 0) exact.Add(report.DelaySumSeconds[last, flow] / received);
+        }
+        exact.Sort();
+        Assert.Equal(Flows, exact.Count);
+
+        var quantiles = monitor.GetQuantiles(new[] { FlowMetric.MeanDelay }, new[] { 0.5, 0.99 });
+        Assert.Equal(Flows, quantiles.FlowCount(FlowMetric.MeanDelay));
+
+        foreach (var q in new[] { 0.5, 0.99 })
+        {
+            double low = exact[Math.Max(0, (int)Math.Floor((q - RankError) * Flows))];
+            double high = exact[Math.Min(Flows - 1, (int)Math.Ceiling((q + RankError) * Flows))];
+            Assert.InRange(quantiles.Get(FlowMetric.MeanDelay, q), low, high);
+        }
+    }
+}
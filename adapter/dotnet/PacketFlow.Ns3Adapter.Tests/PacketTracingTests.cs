@@ -7,6 +7,8 @@
 // - TX/RX events are captured on Wi-Fi devices (was broken before fix)
 // - GCHandles for trace delegates are properly tracked and freed on Dispose
 // - Null callbacks are handled correctly (subscribe to only TX or only RX)
+// - Unsubscribing from inside a callback stops further events and recycles
+//   the native context slot
 
 using Xunit;
 using PacketFlow.Ns3Adapter;
@@ -290,4 +292,65 @@ public class PacketTracingTests
         Assert.True(count1 > 0);
         Assert.True(count2 > 0);
     }
+
+    /// <summary>
+    /// Verifies that unsubscribing from inside an RX callback stops all
+    /// further events of that subscription, and that the next subscription
+    /// reuses the freed context slot instead of growing the pool.
+    /// </summary>
+    [Fact]
+    public void Unsubscribe_FromRxCallback_StopsEventsAndReusesContext()
+    {
+        using var sim = new Simulation();
+        var nodes = sim.CreateNodes(2);
+        sim.InstallInternetStack(nodes);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        sim.AssignIpv4Addresses(new[] { dev0, dev1 }, "10.1.1.0", "255.255.255.0");
+
+        var server = UdpEcho.CreateServer(sim, nodes[1], 9);
+        server.Start(TimeSpan.FromSeconds(1.0));
+        server.Stop(TimeSpan.FromSeconds(5.0));
+        var client = UdpEcho.CreateClient(sim, nodes[0], "10.1.1.2", 9, 1024,
+            TimeSpan.FromSeconds(0.5), 5);
+        client.Start(TimeSpan.FromSeconds(2.0));
+        client.Stop(TimeSpan.FromSeconds(5.0));
+
+        // Requests reach dev1 at about 2.0, 2.5, 3.0, 3.5 and 4.0 s; stop at the one after 2.8 s
+        var unsubscribeAfter = TimeSpan.FromSeconds(2.8);
+        var events = new List<PacketEvent>();
+        TimeSpan? unsubscribedAt = null;
+        TraceSubscription? subscription = null;
+        subscription = dev1.SubscribeToPacketEvents(
+            onTx: evt => events.Add(evt),
+            onRx: evt =>
+            {
+                events.Add(evt);
+                if (unsubscribedAt == null && evt.Time >= unsubscribeAfter)
+                {
+                    subscription!.Unsubscribe();
+                    unsubscribedAt = evt.Time;
+                }
+            });
+
+        // Fill the rest of the first slab so a fresh slot would have to grow the pool
+        var capacity = sim.TraceStats.ContextCapacity;
+        var lastEchoRx = TimeSpan.Zero;
+        var others = new List<TraceSubscription>();
+        while (sim.TraceStats.Contexts < capacity)
+            others.Add(dev0.SubscribeToPacketEvents(onTx: null, onRx: evt => lastEchoRx = evt.Time));
+
+        sim.Stop(TimeSpan.FromSeconds(5.0));
+        sim.Run();
+
+        Assert.NotNull(unsubscribedAt);
+        var cutoff = unsubscribedAt.Value;
+        Assert.False(subscription.IsActive);
+        Assert.True(lastEchoRx > cutoff, "Traffic should continue after unsubscribing");
+        Assert.All(events, evt => Assert.True(evt.Time <= cutoff,
+            $"Event at {evt.Time.TotalSeconds}s after unsubscribing at {cutoff.TotalSeconds}s"));
+        Assert.Equal(new TraceStats(capacity - 1, capacity - 1, capacity), sim.TraceStats);
+
+        using var again = dev1.SubscribeToPacketEvents(onTx: null, onRx: _ => { });
+        Assert.Equal(new TraceStats(capacity, capacity, capacity), sim.TraceStats);
+    }
 }
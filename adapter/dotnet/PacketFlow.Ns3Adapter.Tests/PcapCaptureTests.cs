@@ -0,0 +1,151 @@
+// PcapCaptureTests.cs
+// Tests for the buffered PCAP writer (Device.EnablePcap) on CSMA and Wi-Fi
+// devices, reading the written files back.
+//
+// Verifies:
+// - The file header carries the device's link type (Ethernet for CSMA,
+//   802.11 + radiotap for Wi-Fi) and the requested snaplen
+// - Records longer than the snaplen are cut to it, with the original length kept
+// - Every record has captured bytes
+
+using System.Buffers.Binary;
+using Xunit;
+using PacketFlow.Ns3Adapter;
+
+namespace PacketFlow.Ns3Adapter.Tests;
+
+public class PcapCaptureTests
+{
+    private const uint LinkTypeEthernet = 1;
+    private const uint LinkTypeRadiotap = 127;
+    private const int Snaplen = 128;
+
+    /// <summary>
+    /// Verifies that a CSMA capture is an Ethernet pcap whose 1024-byte
+    /// echo frames are cut to the snaplen.
+    /// </summary>
+    [Fact]
+    public void Csma_EnablePcap_WritesEthernetRecordsCutToSnaplen()
+    {
+        var dir = CreateTempDirectory();
+        try
+        {
+            using (var sim = new Simulation())
+            {
+                sim.SetSeed(7);
+                var nodes = sim.CreateNodes(3);
+                sim.InstallInternetStack(nodes);
+                var devices = Csma.Install(sim, nodes, "100Mbps", "6560ns");
+                sim.AssignIpv4Addresses(devices, "192.168.1.0", "255.255.255.0");
+
+                var server = UdpEcho.CreateServer(sim, nodes[2], 9);
+                server.Start(TimeSpan.FromSeconds(1.0));
+                server.Stop(TimeSpan.FromSeconds(3.0));
+                var client = UdpEcho.CreateClient(sim, nodes[0], "192.168.1.3", 9, 1024,
+                    TimeSpan.FromSeconds(0.5), 3);
+                client.Start(TimeSpan.FromSeconds(1.5));
+                client.Stop(TimeSpan.FromSeconds(3.0));
+
+                devices[0].EnablePcap(Path.Combine(dir, "csma"), new PcapOptions { Snaplen = Snaplen });
+
+                sim.Stop(TimeSpan.FromSeconds(3.0));
+                sim.Run();
+            }
+
+            AssertCapture(Path.Combine(dir, "csma"), LinkTypeEthernet);
+        }
+        finally
+        {
+            Directory.Delete(dir, recursive: true);
+        }
+    }
+
+    /// <summary>
+    /// Verifies that a Wi-Fi capture is a radiotap pcap whose data frames
+    /// are cut to the snaplen.
+    /// </summary>
+    [Fact]
+    public void WiFi_EnablePcap_WritesRadiotapRecordsCutToSnaplen()
+    {
+        var dir = CreateTempDirectory();
+        try
+        {
+            using (var sim = new Simulation())
+            {
+                sim.SetSeed(456);
+                var allNodes = sim.CreateNodes(2);
+                var sta = allNodes[0];
+                var ap = allNodes[1];
+                sim.InstallInternetStack(allNodes);
+
+                var (staDevices, apDevice) = WiFi.InstallStationAp(
+                    sim, new[] { sta }, ap, WiFiStandard.Std_80211n_2_4GHz, "HtMcs7", 1);
+                sta.SetPosition(0, 0, 0);
+                ap.SetPosition(5, 0, 0);
+
+                sim.AssignIpv4Addresses(new[] { staDevices[0], apDevice }, "10.1.2.0", "255.255.255.0");
+                sim.PopulateRoutingTables();
+
+                var server = UdpEcho.CreateServer(sim, ap, 9);
+                server.Start(TimeSpan.FromSeconds(1.0));
+                server.Stop(TimeSpan.FromSeconds(4.0));
+                var client = UdpEcho.CreateClient(sim, sta, "10.1.2.2", 9, 512,
+                    TimeSpan.FromSeconds(0.5), 3);
+                client.Start(TimeSpan.FromSeconds(2.0));
+                client.Stop(TimeSpan.FromSeconds(4.0));
+
+                staDevices[0].EnablePcap(Path.Combine(dir, "wifi"), new PcapOptions { Snaplen = Snaplen });
+
+                sim.Stop(TimeSpan.FromSeconds(4.0));
+                sim.Run();
+            }
+
+            AssertCapture(Path.Combine(dir, "wifi"), LinkTypeRadiotap);
+        }
+        finally
+        {
+            Directory.Delete(dir, recursive: true);
+        }
+    }
+
+    private static string CreateTempDirectory()
+    {
+        var dir = Path.Combine(Path.GetTempPath(), "ns3shim-pcap-" + Guid.NewGuid().ToString("N"));
+        Directory.CreateDirectory(dir);
+        return dir;
+    }
+
+    // Reads the single "<prefix>-<node>-<device>.pcap" file back (native byte order)
+    private static void AssertCapture(string prefix, uint expectedLinkType)
+    {
+        var files = Directory.GetFiles(Path.GetDirectoryName(prefix)!, Path.GetFileName(prefix) + "-*.pcap");
+        var file = Assert.Single(files);
+        var bytes = File.ReadAllBytes(file);
+
+        Assert.True(bytes.Length > 24, "File should hold more than the header");
+        Assert.Equal(0xa1b2c3d4u, BinaryPrimitives.ReadUInt32LittleEndian(bytes.AsSpan(0)));
+        Assert.Equal((uint)Snaplen, BinaryPrimitives.ReadUInt32LittleEndian(bytes.AsSpan(16)));
+        Assert.Equal(expectedLinkType, BinaryPrimitives.ReadUInt32LittleEndian(bytes.AsSpan(20)));
+
+        int records = 0;
+        int truncated = 0;
+        int pos = 24;
+        while (pos + 16 <= bytes.Length)
+        {
+            uint capLen = BinaryPrimitives.ReadUInt32LittleEndian(bytes.AsSpan(pos + 8));
+            uint origLen = BinaryPrimitives.ReadUInt32LittleEndian(bytes.AsSpan(pos + 12));
+
+            Assert.InRange(capLen, 1u, (uint)Snaplen);
+            Assert.Equal(Math.Min(origLen, (uint)Snaplen), capLen);
+            Assert.True(pos + 16 + capLen <= bytes.Length, "Record should be complete");
+
+            records++;
+            if (origLen > capLen) truncated++;
+            pos += 16 + (int)capLen;
+        }
+
+        Assert.Equal(bytes.Length, pos);
+        Assert.True(records > 0, "Capture should hold records");
+        Assert.True(truncated > 0, "Echo frames should be cut to the snaplen");
+    }
+}
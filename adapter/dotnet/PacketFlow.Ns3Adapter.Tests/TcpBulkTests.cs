@@ -0,0 +1,67 @@
+// TcpBulkTests.cs
+// Tests for native TCP bulk transfers (TcpBulk.Install) over a real link.
+//
+// Verifies:
+// - The sender socket runs the requested congestion control, and paces
+//   only with BBR
+// - A finite transfer completes with every byte delivered
+// - Goodput over a single bottleneck is close to its rate
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+
+namespace PacketFlow.Ns3Adapter.Tests;
+
+public class TcpBulkTests
+{
+    private const double LinkBitsPerSecond = 10e6;
+
+    /// <summary>
+    /// Sends 5 MB over a 10 Mbit/s point-to-point link with each congestion
+    /// control that needs no ECN marking. The default 128 KiB buffers keep
+    /// the window below the bandwidth-delay product plus the device queue,
+    /// so there is no loss: goodput must reach 85% of the link rate, the
+    /// rest being headers (about 4% at 1448-byte segments), the handshake
+    /// and slow start.
+    /// </summary>
+    [Theory]
+    [InlineData(TcpCongestionControl.NewReno)]
+    [InlineData(TcpCongestionControl.Cubic)]
+    [InlineData(TcpCongestionControl.Bbr)]
+    public void Transfer_PointToPoint_UsesCongestionControlAndFillsLink(TcpCongestionControl congestionControl)
+    {
+        const long bytes = 5_000_000;
+
+        using var sim = new Simulation();
+        sim.SetSeed(3);
+
+        var nodes = sim.CreateNodes(2);
+        sim.InstallInternetStack(nodes);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "10Mbps", "5ms");
+        sim.AssignIpv4Addresses(new[] { dev0, dev1 }, "10.1.1.0", "255.255.255.0");
+
+        var bulk = TcpBulk.Install(sim, nodes, new[]
+        {
+            new TcpFlowSpec(0, 1, 5000)
+            {
+                CongestionControl = congestionControl,
+                Bytes = bytes,
+                Start = TimeSpan.FromSeconds(1.0),
+            },
+        });
+
+        sim.Stop(TimeSpan.FromSeconds(10.0));
+        sim.Run();
+
+        var flow = Assert.Single(bulk.Export().Flows);
+
+        // Assert: the socket got the requested algorithm
+        Assert.Equal(congestionControl, flow.CongestionControl);
+        Assert.Equal(congestionControl == TcpCongestionControl.Bbr, flow.Pacing);
+
+        // Assert: complete, 5 MB at 10 Mbit/s taking at least 4 s
+        Assert.Equal(TcpFlowState.Complete, flow.State);
+        Assert.Equal(bytes, flow.RxBytes);
+        Assert.InRange(flow.GoodputBitsPerSecond, 0.85 * LinkBitsPerSecond, LinkBitsPerSecond);
+    }
+}
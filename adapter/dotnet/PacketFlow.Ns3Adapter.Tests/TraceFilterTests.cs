@@ -0,0 +1,113 @@
+// TraceFilterTests.cs
+// Tests for the native trace filter (Device.SetTraceFilter) on real traffic
+// over each supported framing.
+//
+// Verifies:
+// - A destination port filter passes only UDP packets to that port, on
+//   PointToPoint (PPP), CSMA (Ethernet) and Wi-Fi (802.11 + LLC/SNAP) devices
+// - The dropped traffic really crossed the link (an unfiltered device sees it)
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+
+namespace PacketFlow.Ns3Adapter.Tests;
+
+public class TraceFilterTests
+{
+    private const ushort KeptPort = 9;
+    private const ushort DroppedPort = 10;
+    private const uint EchoPackets = 3;
+
+    /// <summary>
+    /// Runs two UDP echo exchanges, to ports 9 and 10, and filters the
+    /// client's device on destination port 9: every event it delivers is
+    /// UDP to port 9, including all requests to it, while the server's
+    /// unfiltered device also sees the port 10 traffic and the replies.
+    /// </summary>
+    [Theory]
+    [InlineData("p2p")]
+    [InlineData("csma")]
+    [InlineData("wifi")]
+    public void PortFilter_EchoRun_DropsNonMatchingUdp(string link)
+    {
+        using var sim = new Simulation();
+        sim.SetSeed(11);
+        var (client, server, clientDev, serverDev, serverIp) = BuildLink(sim, link);
+
+        foreach (var port in new[] { KeptPort, DroppedPort })
+        {
+            var echoServer = UdpEcho.CreateServer(sim, server, port);
+            echoServer.Start(TimeSpan.FromSeconds(1.0));
+            echoServer.Stop(TimeSpan.FromSeconds(4.0));
+            var echoClient = UdpEcho.CreateClient(sim, client, serverIp, port, 512,
+                TimeSpan.FromSeconds(0.5), EchoPackets);
+            echoClient.Start(TimeSpan.FromSeconds(2.0));
+            echoClient.Stop(TimeSpan.FromSeconds(4.0));
+        }
+
+        clientDev.SetTraceFilter(new TraceFilter
+        {
+            Protocol = 17,
+            DestinationPorts = PortRange.Single(KeptPort),
+        });
+
+        var filtered = new List<(bool Tx, PacketEventEx Event)>();
+        var unfiltered = new List<PacketEventEx>();
+        using var clientSub = clientDev.SubscribeToPacketEventsEx(
+            onTx: evt => filtered.Add((true, evt)),
+            onRx: evt => filtered.Add((false, evt)));
+        using var serverSub = serverDev.SubscribeToPacketEventsEx(
+            onTx: evt => unfiltered.Add(evt),
+            onRx: evt => unfiltered.Add(evt));
+
+        sim.Stop(TimeSpan.FromSeconds(4.0));
+        sim.Run();
+
+        // Assert: only UDP to the kept port passed, and every request to it did
+        Assert.All(filtered, e =>
+        {
+            Assert.True(e.Event.IsIpv4 && e.Event.HasPorts, "Filtered event should be IPv4 with ports");
+            Assert.Equal(17, e.Event.Protocol);
+            Assert.Equal(KeptPort, e.Event.DestinationPort);
+        });
+        Assert.True(filtered.Count(e => e.Tx) >= EchoPackets,
+            $"Expected every request to port {KeptPort} on {link}, got {filtered.Count(e => e.Tx)}");
+
+        // Assert: the dropped traffic existed on the link
+        Assert.Contains(unfiltered, evt => evt.HasPorts && evt.DestinationPort == DroppedPort);
+        Assert.Contains(unfiltered, evt => evt.HasPorts && evt.SourcePort == KeptPort);
+    }
+
+    private static (Node Client, Node Server, Device ClientDev, Device ServerDev, string ServerIp) BuildLink(
+        Simulation sim, string link)
+    {
+        var nodes = sim.CreateNodes(2);
+        sim.InstallInternetStack(nodes);
+
+        switch (link)
+        {
+            case "p2p":
+            {
+                var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+                sim.AssignIpv4Addresses(new[] { dev0, dev1 }, "10.1.1.0", "255.255.255.0");
+                return (nodes[0], nodes[1], dev0, dev1, "10.1.1.2");
+            }
+            case "csma":
+            {
+                var devices = Csma.Install(sim, nodes, "100Mbps", "6560ns");
+                sim.AssignIpv4Addresses(devices, "192.168.1.0", "255.255.255.0");
+                return (nodes[0], nodes[1], devices[0], devices[1], "192.168.1.2");
+            }
+            default:
+            {
+                var (staDevices, apDevice) = WiFi.InstallStationAp(
+                    sim, new[] { nodes[0] }, nodes[1], WiFiStandard.Std_80211n_2_4GHz, "HtMcs7", 1);
+                nodes[0].SetPosition(0, 0, 0);
+                nodes[1].SetPosition(5, 0, 0);
+                sim.AssignIpv4Addresses(new[] { staDevices[0], apDevice }, "10.1.2.0", "255.255.255.0");
+                sim.PopulateRoutingTables();
+                return (nodes[0], nodes[1], staDevices[0], apDevice, "10.1.2.2");
+            }
+        }
+    }
+}
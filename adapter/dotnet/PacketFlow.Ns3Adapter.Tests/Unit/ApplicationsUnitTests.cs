@@ -120,6 +120,138 @@ public class ApplicationsUnitTests
         app.Stop(TimeSpan.FromSeconds(10.0));
     }
 
+    // ========================================================================
+    // TrafficGenerator
+    // ========================================================================
+
+    [Fact]
+    public void TrafficGenerator_Create_PassesOptions()
+    {
+        var (sim, stub) = Create();
+        var node = sim.CreateNodes(1)[0];
+
+        var app = TrafficGenerator.Create(sim, node, "10.1.1.2", 9, TimeSpan.FromMicroseconds(10),
+            packetSize: 64, pattern: TrafficPattern.Poisson, batch: 16, maxPackets: 1000, uniqueUids: true);
+
+        Assert.Same(sim, app.Simulation);
+        var (dstIp, port, options) = stub.LastTrafficGen!.Value;
+        Assert.Equal(("10.1.1.2", (ushort)9), (dstIp, port));
+        Assert.Equal((64u, 1u, 16u, 1000ul), (options.PacketSize, options.Pattern, options.Batch, options.MaxPackets));
+        Assert.Equal(1e-5, options.IntervalSec, 12);
+        Assert.Equal(NativeMethods.TrafficGenUniqueUids, options.Flags);
+    }
+
+    [Fact]
+    public void TrafficGenerator_Create_Defaults()
+    {
+        var (sim, stub) = Create();
+        TrafficGenerator.Create(sim, sim.CreateNodes(1)[0], "10.1.1.2", 9, TimeSpan.FromMilliseconds(1));
+
+        var options = stub.LastTrafficGen!.Value.Options;
+        Assert.Equal((1024u, 0u, 1u, 0u, 0ul), (options.PacketSize, options.Pattern, options.Batch, options.Flags, options.MaxPackets));
+    }
+
+    [Fact]
+    public void TrafficGenerator_Create_InvalidArguments_Throw()
+    {
+        var (sim, stub) = Create();
+        var node = sim.CreateNodes(1)[0];
+        Assert.Throws<ArgumentException>(() => TrafficGenerator.Create(sim, node, "", 9, TimeSpan.FromSeconds(1)));
+        Assert.Throws<ArgumentOutOfRangeException>(() => TrafficGenerator.Create(sim, node, "10.0.0.1", 9, TimeSpan.Zero));
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            TrafficGenerator.Create(sim, node, "10.0.0.1", 9, TimeSpan.FromSeconds(1), batch: 0));
+        Assert.Null(stub.LastTrafficGen);
+    }
+
+    [Fact]
+    public void TrafficGenerator_Create_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        var node = sim.CreateNodes(1)[0];
+        stub.AppResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => TrafficGenerator.Create(sim, node, "10.0.0.1", 9, TimeSpan.FromSeconds(1)));
+    }
+
+    // ========================================================================
+    // TrafficApps
+    // ========================================================================
+
+    [Fact]
+    public void TrafficApps_Install_PacksSpecsInOneCall()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(3);
+        var specs = new[]
+        {
+            new AppSpec(AppKind.PacketSink, 2, 5000),
+            new AppSpec(AppKind.BulkSend, 0, 5000)
+            {
+                PeerNode = 2,
+                Size = 1_000_000,
+                PacketSize = 1448,
+                Start = TimeSpan.FromSeconds(1),
+                Stop = TimeSpan.FromSeconds(9),
+            },
+            new AppSpec(AppKind.UdpClient, 1, 9)
+            {
+                PeerAddress = System.Net.IPAddress.Parse("10.1.2.3"),
+                RateBitsPerSecond = 1e6,
+            },
+        };
+
+        var apps = TrafficApps.Install(sim, nodes, specs);
+
+        Assert.Equal(3, apps.Count);
+        Assert.Equal(nodes.Select(n => n.NativeHandle), stub.LastBulkNodes);
+        var sink = stub.LastBulkSpecs[0];
+        Assert.Equal((4u, 2u, NativeMethods.AppNoNode, (ushort)5000), (sink.Kind, sink.SrcNode, sink.DstNode, sink.Port));
+        var bulk = stub.LastBulkSpecs[1];
+        Assert.Equal((3u, 0u, 2u, 0u), (bulk.Kind, bulk.SrcNode, bulk.DstNode, bulk.DstAddr));
+        Assert.Equal((1_000_000ul, 1448u, 1.0, 9.0), (bulk.Size, bulk.PacketSize, bulk.StartSec, bulk.StopSec));
+        var client = stub.LastBulkSpecs[2];
+        Assert.Equal((NativeMethods.AppNoNode, 0x0A010203u, 1e6, 0.0), (client.DstNode, client.DstAddr, client.RateBps, client.StopSec));
+    }
+
+    [Fact]
+    public void TrafficApps_Install_ReturnsHandlesInOrder()
+    {
+        var (sim, _) = Create();
+        var nodes = sim.CreateNodes(1);
+        var apps = TrafficApps.Install(sim, nodes,
+            new[] { new AppSpec(AppKind.UdpServer, 0, 9), new AppSpec(AppKind.PacketSink, 0, 10) });
+
+        Assert.Equal((nint)0x400, apps[0].NativeHandle);
+        Assert.Equal((nint)0x401, apps[1].NativeHandle);
+    }
+
+    [Fact]
+    public void TrafficApps_Install_NodeOutOfRange_Throws()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        Assert.Throws<ArgumentOutOfRangeException>(() => TrafficApps.Install(sim, nodes,
+            new[] { new AppSpec(AppKind.BulkSend, 0, 5000) { PeerNode = 2 } }));
+        Assert.Empty(stub.LastBulkSpecs);
+    }
+
+    [Fact]
+    public void TrafficApps_Install_IPv6Peer_Throws()
+    {
+        var (sim, _) = Create();
+        var nodes = sim.CreateNodes(1);
+        Assert.Throws<ArgumentException>(() => TrafficApps.Install(sim, nodes,
+            new[] { new AppSpec(AppKind.OnOff, 0, 9) { PeerAddress = System.Net.IPAddress.IPv6Loopback } }));
+    }
+
+    [Fact]
+    public void TrafficApps_Install_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(1);
+        stub.AppResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => TrafficApps.Install(sim, nodes, new[] { new AppSpec(AppKind.UdpServer, 0, 9) }));
+    }
+
     // ========================================================================
     // FlowMonitor
     // ========================================================================
@@ -138,6 +270,48 @@ public class ApplicationsUnitTests
         Assert.Throws<ArgumentNullException>(() => FlowMonitor.InstallAll(null!));
     }
 
+    [Fact]
+    public void FlowMonitor_Install_EdgeOnly_PassesNodesAndOptions()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(3);
+
+        var fm = FlowMonitor.Install(sim, new[] { nodes[0], nodes[2] }, edgeOnly: true,
+            maxPerHopDelay: TimeSpan.FromSeconds(2), startTime: TimeSpan.FromSeconds(1));
+
+        var (handles, options) = stub.LastFlowMonInstall!.Value;
+        Assert.Equal(new[] { nodes[0].NativeHandle, nodes[2].NativeHandle }, handles);
+        Assert.Equal(1, options.EdgeOnly);
+        Assert.Equal(2.0, options.MaxPerHopDelaySec);
+        Assert.Equal(1.0, options.StartTimeSec);
+        Assert.Equal(2, fm.ProbedNodeCount);
+    }
+
+    [Fact]
+    public void FlowMonitor_Install_Defaults_AllNodesZeroOptions()
+    {
+        var (sim, stub) = Create();
+        FlowMonitor.Install(sim);
+
+        var (handles, options) = stub.LastFlowMonInstall!.Value;
+        Assert.Empty(handles);
+        Assert.Equal(0, options.EdgeOnly);
+        Assert.Equal(0.0, options.MaxPerHopDelaySec);
+        Assert.Equal(0.0, options.StartTimeSec);
+        Assert.Null(FlowMonitor.InstallAll(sim).ProbedNodeCount);
+    }
+
+    [Fact]
+    public void FlowMonitor_Install_InvalidOrFailing_Throws()
+    {
+        var (sim, stub) = Create();
+        Assert.Throws<ArgumentOutOfRangeException>(() => FlowMonitor.Install(sim, maxPerHopDelay: TimeSpan.Zero));
+        Assert.Null(stub.LastFlowMonInstall);
+
+        stub.FlowMonInstallResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => FlowMonitor.Install(sim, edgeOnly: true));
+    }
+
     [Fact]
     public void FlowMonitor_CollectStatistics_ReturnsCorrectValues()
     {
@@ -168,6 +342,48 @@ public class ApplicationsUnitTests
         Assert.Throws<Ns3Exception>(() => fm.CollectStatistics());
     }
 
+    [Fact]
+    public void FlowMonitor_GetHistogram_MergesAllFlows()
+    {
+        var (sim, stub) = Create();
+        var fm = FlowMonitor.InstallAll(sim);
+
+        var h = fm.GetHistogram(FlowHistogramKind.Delay);
+
+        Assert.Equal(0.001, h.BinWidth);
+        Assert.Equal(new long[] { 10, 11, 12 }, h.Counts);
+        Assert.All(stub.FlowHistogramCalls, c => Assert.Null(c.FlowIds));
+        Assert.Equal(NativeMethods.Ns3FlowHistKind.Delay, stub.FlowHistogramCalls[0].Kind);
+    }
+
+    [Fact]
+    public void FlowMonitor_GetHistograms_OneRowPerFlow()
+    {
+        var (sim, stub) = Create();
+        stub.FlowHistogramBinWidth = 20;
+        var fm = FlowMonitor.InstallAll(sim);
+
+        var rows = fm.GetHistograms(FlowHistogramKind.PacketSize, 2, 5);
+
+        Assert.Equal(2, rows.Count);
+        Assert.Equal(new long[] { 20, 21, 22 }, rows[1].Counts);
+        Assert.Equal(new uint[] { 2, 5 }, stub.FlowHistogramCalls[^1].FlowIds);
+        Assert.Equal(NativeMethods.Ns3FlowHistKind.PacketSize, stub.FlowHistogramCalls[^1].Kind);
+        Assert.Empty(fm.GetHistograms(FlowHistogramKind.Jitter));
+    }
+
+    [Fact]
+    public void FlowHistogram_Quantile_ReturnsBinUpperEdge()
+    {
+        var h = new FlowHistogram(0.5, new long[] { 2, 0, 8 });
+        Assert.Equal(10, h.Total);
+        Assert.Equal(0.5, h.Quantile(0.2));
+        Assert.Equal(1.5, h.Quantile(0.21));
+        Assert.Equal(1.0, h.BinStart(2));
+        Assert.Equal(0, new FlowHistogram(1, Array.Empty<long>()).Quantile(0.5));
+        Assert.Throws<ArgumentOutOfRangeException>(() => h.Quantile(1.5));
+    }
+
     // ========================================================================
     // FlowStatistics Computed Properties (pure C# logic, no interop)
     // ========================================================================
@@ -0,0 +1,53 @@
+// CallJournalUnitTests.cs — unit tests for CallJournal using StubNativeInterop (no native DLL).
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class CallJournalUnitTests
+{
+    [Fact]
+    public void Start_PassesPath()
+    {
+        var stub = new StubNativeInterop();
+        using var journal = CallJournal.Start(stub, "run.ns3j");
+
+        Assert.Equal("run.ns3j", stub.JournalPath);
+        Assert.Equal("run.ns3j", journal.Path);
+    }
+
+    [Fact]
+    public void Start_EmptyPath_Throws()
+    {
+        var stub = new StubNativeInterop();
+        Assert.Throws<ArgumentException>(() => CallJournal.Start(stub, ""));
+        Assert.Null(stub.JournalPath);
+    }
+
+    [Fact]
+    public void Start_NativeFails_Throws()
+    {
+        var stub = new StubNativeInterop
+        {
+            JournalOpenResult = NativeMethods.Ns3Status.Error,
+            JournalLastErrorMessage = "journal already open"
+        };
+        var ex = Assert.Throws<Ns3Exception>(() => CallJournal.Start(stub, "run.ns3j"));
+        Assert.Contains("journal already open", ex.Message);
+        Assert.Equal(0, stub.JournalCloseCount);
+    }
+
+    [Fact]
+    public void Dispose_ClosesOnce()
+    {
+        var stub = new StubNativeInterop();
+        var journal = CallJournal.Start(stub, "run.ns3j");
+
+        journal.Dispose();
+        journal.Dispose();
+
+        Assert.Equal(1, stub.JournalCloseCount);
+    }
+}
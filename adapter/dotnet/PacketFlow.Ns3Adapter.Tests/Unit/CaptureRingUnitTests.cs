@@ -0,0 +1,84 @@
+// CaptureRingUnitTests.cs — unit tests for CaptureRing (StubNativeInterop).
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class CaptureRingUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void Open_Defaults_PassZeroOptions()
+    {
+        var (sim, stub) = Create();
+        using var ring = CaptureRing.Open(sim, "/sim-capture");
+
+        var (name, options) = stub.LastCaptureRingOpen!.Value;
+        Assert.Equal("/sim-capture", name);
+        Assert.Equal(new NativeMethods.Ns3CaptureRingOptions(), options);
+    }
+
+    [Fact]
+    public void Open_PassesCapacitySnaplenAndFlags()
+    {
+        var (sim, stub) = Create();
+        using var ring = CaptureRing.Open(sim, "cap", capacityBytes: 1 << 20, snaplen: 128, dropWhenFull: true, promiscuous: false);
+
+        var options = stub.LastCaptureRingOpen!.Value.options!.Value;
+        Assert.Equal((1u << 20, 128u, NativeMethods.CaptureRingDrop | NativeMethods.CaptureRingNoPromisc),
+            (options.CapacityBytes, options.Snaplen, options.Flags));
+    }
+
+    [Theory]
+    [InlineData(0, null)]
+    [InlineData(null, -1)]
+    public void Open_InvalidSizes_Throw(int? capacityBytes, int? snaplen)
+    {
+        var (sim, stub) = Create();
+        Assert.Throws<ArgumentOutOfRangeException>(() => CaptureRing.Open(sim, "cap", capacityBytes, snaplen));
+        Assert.Null(stub.LastCaptureRingOpen);
+    }
+
+    [Fact]
+    public void Open_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.CaptureRingOpenResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => CaptureRing.Open(sim, "cap"));
+    }
+
+    [Fact]
+    public void Attach_PassesEveryDevice_AndGetStatsMapsCounters()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        stub.CaptureRingStats = new NativeMethods.Ns3CaptureRingStats { Records = 10, Bytes = 1500, Dropped = 2, Overwritten = 3 };
+
+        using var ring = CaptureRing.Open(sim, "cap").Attach(dev0, dev1);
+
+        Assert.Equal(new[] { dev0.NativeHandle, dev1.NativeHandle }, stub.CaptureRingAttachedDevices);
+        Assert.Equal(new CaptureRingStats(10, 1500, 2, 3), ring.GetStats());
+    }
+
+    [Fact]
+    public void Close_ThenDispose_ClosesOnce()
+    {
+        var (sim, stub) = Create();
+        var ring = CaptureRing.Open(sim, "cap");
+
+        ring.Close();
+        ring.Dispose();
+
+        Assert.Equal(1, stub.CaptureRingCloseCount);
+        Assert.Throws<InvalidOperationException>(() => ring.Close());
+        Assert.Throws<InvalidOperationException>(() => ring.Attach());
+    }
+}
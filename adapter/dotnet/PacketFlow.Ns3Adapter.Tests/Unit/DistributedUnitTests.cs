@@ -0,0 +1,118 @@
+// DistributedUnitTests.cs — unit tests for distributed execution using StubNativeInterop (no native DLL).
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class DistributedUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create(
+        SimulatorImplementation implementation = SimulatorImplementation.Default)
+    {
+        var stub = new StubNativeInterop();
+        var sim = new Simulation(stub, ownsNative: false, implementation);
+        return (sim, stub);
+    }
+
+    [Fact]
+    public void Constructor_Default_UsesPlainCreate()
+    {
+        var (sim, stub) = Create();
+        Assert.Null(stub.LastSimOptions);
+        Assert.Equal(SimulatorImplementation.Default, sim.Implementation);
+    }
+
+    [Theory]
+    [InlineData(SimulatorImplementation.Distributed, 1)]
+    [InlineData(SimulatorImplementation.NullMessage, 2)]
+    public void Constructor_Distributed_PassesImplementation(SimulatorImplementation impl, int expected)
+    {
+        var (_, stub) = Create(impl);
+        Assert.Equal(expected, (int)stub.LastSimOptions!.Value.Impl);
+    }
+
+    [Fact]
+    public void Constructor_DistributedCreateFails_Throws()
+    {
+        var stub = new StubNativeInterop { SimCreateResult = NativeMethods.Ns3Status.Error };
+        Assert.Throws<Ns3Exception>(() => new Simulation(stub, ownsNative: false, SimulatorImplementation.Distributed));
+    }
+
+    [Fact]
+    public void Rank_ReturnsNativeValues()
+    {
+        var (sim, stub) = Create(SimulatorImplementation.Distributed);
+        stub.Rank = 2;
+        stub.RankCount = 4;
+        Assert.Equal(2, sim.Rank);
+        Assert.Equal(4, sim.RankCount);
+    }
+
+    [Fact]
+    public void CreateNodes_WithSystemIds_SetsOwnership()
+    {
+        var (sim, stub) = Create(SimulatorImplementation.Distributed);
+        stub.Rank = 1;
+        stub.RankCount = 2;
+
+        var nodes = sim.CreateNodes(new uint[] { 0, 1, 1 });
+
+        Assert.Equal(3, nodes.Length);
+        Assert.Equal(0, nodes[0].SystemId);
+        Assert.False(nodes[0].IsLocal);
+        Assert.True(nodes[2].IsLocal);
+    }
+
+    [Fact]
+    public void CreateNodes_EmptySystemIds_Throws()
+    {
+        var (sim, _) = Create();
+        Assert.Throws<ArgumentException>(() => sim.CreateNodes(Array.Empty<uint>()));
+    }
+
+    [Fact]
+    public void TopologyPlan_AddLink_OutOfRange_Throws()
+    {
+        var plan = new TopologyPlan(2);
+        Assert.Throws<ArgumentOutOfRangeException>(() => plan.AddLink(0, 2, TimeSpan.FromMilliseconds(1)));
+    }
+
+    [Fact]
+    public void TopologyPlan_AddSharedMedium_AddsZeroDelayStar()
+    {
+        var plan = new TopologyPlan(4).AddSharedMedium(0, 1, 2, 3);
+        Assert.Equal(3, plan.Links.Count);
+        Assert.All(plan.Links, l => Assert.Equal(TimeSpan.Zero, l.Delay));
+        Assert.All(plan.Links, l => Assert.Equal(0, l.A));
+    }
+
+    [Fact]
+    public void Partition_MarshalsLinksAndDefaultsToSimulationRankCount()
+    {
+        var (sim, stub) = Create(SimulatorImplementation.Distributed);
+        stub.RankCount = 3;
+        var plan = new TopologyPlan(6)
+            .AddLink(0, 1, TimeSpan.FromMicroseconds(10))
+            .AddLink(1, 4, TimeSpan.FromMilliseconds(5));
+
+        var result = plan.Partition(sim, TimeSpan.FromMilliseconds(1));
+
+        Assert.Equal((6u, 3u, 0.001), stub.LastPartitionArgs!.Value);
+        Assert.Equal(2, stub.LastPartitionEdges!.Length);
+        Assert.Equal(4u, stub.LastPartitionEdges[1].B);
+        Assert.Equal(0.005, stub.LastPartitionEdges[1].DelaySec, 9);
+        Assert.Equal(new uint[] { 0, 1, 2, 0, 1, 2 }, result.SystemIds);
+        Assert.Equal(TimeSpan.FromMilliseconds(5), result.Lookahead);
+        Assert.Equal(2, result.CutLinks);
+    }
+
+    [Fact]
+    public void Partition_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.PartitionResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => new TopologyPlan(2).Partition(sim, TimeSpan.FromMilliseconds(1), rankCount: 2));
+    }
+}
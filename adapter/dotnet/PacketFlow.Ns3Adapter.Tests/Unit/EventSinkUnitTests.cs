@@ -0,0 +1,115 @@
+// EventSinkUnitTests.cs — unit tests for EventSink (StubNativeInterop).
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class EventSinkUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void Open_Defaults_PassZeroCapacity()
+    {
+        var (sim, stub) = Create();
+        using var sink = EventSink.Open(sim, _ => { });
+
+        Assert.Equal(0u, stub.LastEventBatchCapacity);
+        Assert.Equal(EventSink.DefaultBatchCapacity, sink.BatchCapacity);
+        Assert.NotNull(stub.LastEventBatchCallback);
+    }
+
+    [Fact]
+    public void Open_InvalidCapacity_Throws()
+    {
+        var (sim, stub) = Create();
+        Assert.Throws<ArgumentOutOfRangeException>(() => EventSink.Open(sim, _ => { }, batchCapacity: 0));
+        Assert.Null(stub.LastEventBatchCapacity);
+    }
+
+    [Fact]
+    public void Open_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.EventSinkOpenResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => EventSink.Open(sim, _ => { }));
+    }
+
+    [Fact]
+    public void Enable_AssignsSlots_AndDisableKeepsThem()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        using var sink = EventSink.Open(sim, _ => { });
+
+        Assert.Equal(0, sink.Enable(dev0));
+        Assert.Equal(1, sink.Enable(dev1, DeviceEventMask.Receive | DeviceEventMask.Drop));
+        sink.Disable(dev0);
+
+        Assert.Equal(new[]
+        {
+            (dev0.NativeHandle, 0x7u),
+            (dev1.NativeHandle, 0x6u),
+            (dev0.NativeHandle, 0x0u),
+        }, stub.EventSinkEnableCalls);
+        Assert.Same(dev0, sink.DeviceAt(0));
+        Assert.Same(dev1, sink.DeviceAt(1));
+        Assert.Throws<ArgumentOutOfRangeException>(() => sink.DeviceAt(2));
+    }
+
+    [Fact]
+    public unsafe void Batch_IsReadInPlace_AndSlotsResolveToDevices()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        var received = new List<(Device Device, DeviceEventType Type, double Time, ulong Uid, uint Bytes)>();
+        EventSink? sink = null;
+        sink = EventSink.Open(sim, events =>
+        {
+            foreach (var e in events)
+                received.Add((sink!.DeviceAt(e.Slot), e.Type, e.TimeSeconds, e.Uid, e.Bytes));
+        });
+        sink.Enable(DeviceEventMask.All, dev0, dev1);
+
+        var batch = new[]
+        {
+            new NativeMethods.Ns3Event { TimeSec = 1.0, Uid = 7, Slot = 0, Size = 1500, Type = 0 },
+            new NativeMethods.Ns3Event { TimeSec = 1.002, Uid = 7, Slot = 1, Size = 1500, Type = 1 },
+            new NativeMethods.Ns3Event { TimeSec = 1.5, Uid = 9, Slot = 1, Size = 64, Type = 2 },
+        };
+        fixed (NativeMethods.Ns3Event* events = batch)
+            stub.LastEventBatchCallback!(stub.LastEventBatchUser, events, (uint)batch.Length);
+
+        Assert.Equal(new[]
+        {
+            (dev0, DeviceEventType.Transmit, 1.0, 7ul, 1500u),
+            (dev1, DeviceEventType.Receive, 1.002, 7ul, 1500u),
+            (dev1, DeviceEventType.Drop, 1.5, 9ul, 64u),
+        }, received);
+        sink.Dispose();
+    }
+
+    [Fact]
+    public void Close_ThenDispose_ClosesOnce()
+    {
+        var (sim, stub) = Create();
+        var sink = EventSink.Open(sim, _ => { });
+
+        sink.Flush();
+        sink.Close();
+        sink.Dispose();
+
+        Assert.Equal(1, stub.EventSinkFlushCount);
+        Assert.Equal(1, stub.EventSinkCloseCount);
+        Assert.Throws<InvalidOperationException>(() => sink.Flush());
+        Assert.Throws<InvalidOperationException>(() => sink.Close());
+    }
+}
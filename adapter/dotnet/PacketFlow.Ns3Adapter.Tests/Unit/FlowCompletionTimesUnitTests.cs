@@ -0,0 +1,123 @@
+// FlowCompletionTimesUnitTests.cs — unit tests for FlowCompletionTimes using StubNativeInterop.
+
+using System.Net;
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class FlowCompletionTimesUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void InstallAll_PassesOptions()
+    {
+        var (sim, stub) = Create();
+        var fct = FlowCompletionTimes.InstallAll(sim, new long[] { 10_000, 1_000_000 },
+            idleTimeout: TimeSpan.FromMilliseconds(5), compression: 200);
+
+        Assert.Equal(new ulong[] { 10_000, 1_000_000 }, stub.LastFctOptions!.Value.SizeEdges);
+        Assert.Equal(0.005, stub.LastFctOptions.Value.IdleSec, 9);
+        Assert.Equal(200, stub.LastFctOptions.Value.Compression);
+        Assert.Equal(new long[] { 10_000, 1_000_000 }, fct.SizeEdges);
+    }
+
+    [Fact]
+    public void InstallAll_Defaults_PassZeros()
+    {
+        var (sim, stub) = Create();
+        FlowCompletionTimes.InstallAll(sim);
+
+        Assert.Empty(stub.LastFctOptions!.Value.SizeEdges);
+        Assert.Equal((0.0, 0.0), (stub.LastFctOptions.Value.IdleSec, stub.LastFctOptions.Value.Compression));
+    }
+
+    [Theory]
+    [InlineData(new long[] { 100, 100 })]
+    [InlineData(new long[] { 200, 100 })]
+    [InlineData(new long[] { -1 })]
+    public void InstallAll_InvalidEdges_Throws(long[] edges)
+    {
+        var (sim, stub) = Create();
+        Assert.Throws<ArgumentException>(() => FlowCompletionTimes.InstallAll(sim, edges));
+        Assert.Null(stub.LastFctOptions);
+    }
+
+    [Fact]
+    public void InstallAll_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.FctInstallResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => FlowCompletionTimes.InstallAll(sim));
+    }
+
+    [Fact]
+    public void GetFlows_ConvertsRecords()
+    {
+        var (sim, stub) = Create();
+        stub.FctFlowsResult.Add(new NativeMethods.Ns3FctFlow
+        {
+            SrcAddr = 0x0A010101,
+            DstAddr = 0x0A010102,
+            SrcPort = 49153,
+            DstPort = 5000,
+            Protocol = 6,
+            Complete = 1,
+            Bytes = 65536,
+            StartSec = 1.0,
+            FctSec = 0.012,
+        });
+
+        var flow = Assert.Single(FlowCompletionTimes.InstallAll(sim).GetFlows());
+
+        Assert.Equal(IPAddress.Parse("10.1.1.1"), flow.Source);
+        Assert.Equal(IPAddress.Parse("10.1.1.2"), flow.Destination);
+        Assert.Equal((49153, 5000, 6), (flow.SourcePort, flow.DestinationPort, flow.Protocol));
+        Assert.True(flow.Complete);
+        Assert.Equal(65536, flow.Bytes);
+        Assert.Equal(0.012, flow.CompletionSeconds);
+    }
+
+    [Fact]
+    public void GetDistribution_ReturnsBucketsAndQuantiles()
+    {
+        var (sim, stub) = Create();
+        var fct = FlowCompletionTimes.InstallAll(sim, new long[] { 10_000, 1_000_000 });
+
+        var dist = fct.GetDistribution(new[] { 0.5, 0.99 });
+
+        Assert.Equal(new[] { 0.5, 0.99 }, stub.LastFctQuantiles);
+        Assert.Equal(3, dist.Buckets.Length);
+        Assert.Equal(new long[] { 10_000, 1_000_000, long.MaxValue }, dist.Buckets.Select(b => b.MaxBytes));
+        Assert.Equal(new long[] { 1, 2, 3 }, dist.Buckets.Select(b => b.Flows));
+        Assert.Equal(2.00099, dist.Get(2, 0.99), 9);
+        Assert.Equal(1.0005, dist.QuantileSeconds[1, 0], 9);
+    }
+
+    [Theory]
+    [InlineData(0, 0)]
+    [InlineData(10_000, 0)]
+    [InlineData(10_001, 1)]
+    [InlineData(5_000_000, 2)]
+    public void BucketOf_UsesInclusiveUpperBounds(long bytes, int bucket)
+    {
+        var (sim, _) = Create();
+        var dist = FlowCompletionTimes.InstallAll(sim, new long[] { 10_000, 1_000_000 }).GetDistribution(new[] { 0.5 });
+        Assert.Equal(bucket, dist.BucketOf(bytes));
+    }
+
+    [Fact]
+    public void GetDistribution_InvalidQuantile_Throws()
+    {
+        var (sim, stub) = Create();
+        var fct = FlowCompletionTimes.InstallAll(sim);
+        Assert.Throws<ArgumentOutOfRangeException>(() => fct.GetDistribution(new[] { 1.5 }));
+        Assert.Null(stub.LastFctQuantiles);
+    }
+}
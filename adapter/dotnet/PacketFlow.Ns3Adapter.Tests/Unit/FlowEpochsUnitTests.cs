@@ -0,0 +1,107 @@
+// FlowEpochsUnitTests.cs — unit tests for FlowEpochs (StubNativeInterop).
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class FlowEpochsUnitTests
+{
+    private static (FlowMonitor Monitor, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        var sim = new Simulation(stub, ownsNative: false);
+        return (FlowMonitor.InstallAll(sim), stub);
+    }
+
+    [Fact]
+    public void Start_Defaults_PassZeroFieldsAndNoPath()
+    {
+        var (fm, stub) = Create();
+        var epochs = FlowEpochs.Start(fm, TimeSpan.FromMilliseconds(100));
+
+        var (options, path) = stub.LastFlowEpochsStart!.Value;
+        Assert.Equal(0.1, options.EpochSec, 9);
+        Assert.Equal(0u, options.EpochCapacity);
+        Assert.Equal(0u, options.MaxFlows);
+        Assert.Null(path);
+        Assert.Equal(FlowEpochs.DefaultEpochCapacity, epochs.EpochCapacity);
+        Assert.Equal(FlowEpochs.DefaultMaxFlows, epochs.MaxFlows);
+    }
+
+    [Fact]
+    public void Start_PassesOptionsAndPath()
+    {
+        var (fm, stub) = Create();
+        FlowEpochs.Start(fm, TimeSpan.FromSeconds(1), epochCapacity: 64, maxFlows: 8, path: "epochs.bin");
+
+        var (options, path) = stub.LastFlowEpochsStart!.Value;
+        Assert.Equal(64u, options.EpochCapacity);
+        Assert.Equal(8u, options.MaxFlows);
+        Assert.Equal("epochs.bin", path);
+    }
+
+    [Fact]
+    public void Start_InvalidArguments_Throw()
+    {
+        var (fm, stub) = Create();
+        Assert.Throws<ArgumentOutOfRangeException>(() => FlowEpochs.Start(fm, TimeSpan.Zero));
+        Assert.Throws<ArgumentOutOfRangeException>(() => FlowEpochs.Start(fm, TimeSpan.FromSeconds(1), epochCapacity: 0));
+        Assert.Throws<ArgumentOutOfRangeException>(() => FlowEpochs.Start(fm, TimeSpan.FromSeconds(1), maxFlows: -1));
+        Assert.Null(stub.LastFlowEpochsStart);
+
+        stub.FlowEpochsStartResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => FlowEpochs.Start(fm, TimeSpan.FromSeconds(1)));
+    }
+
+    [Fact]
+    public void Export_FillsMatricesInOneFetch()
+    {
+        var (fm, stub) = Create();
+        var epochs = FlowEpochs.Start(fm, TimeSpan.FromSeconds(0.5));
+        stub.FlowEpochsInfo = new NativeMethods.Ns3FlowEpochsInfo
+        {
+            FirstEpoch = 3, EpochCount = 2, FlowCount = 3, DroppedFlows = 1, EpochSec = 0.5, StartSec = 1.0,
+        };
+
+        var report = epochs.Export();
+
+        Assert.Equal(new uint[] { 6 }, stub.FlowEpochsExportCapacities);
+        Assert.Equal(3, report.FirstEpoch);
+        Assert.Equal(2, report.EpochCount);
+        Assert.Equal(3, report.FlowCount);
+        Assert.Equal(1, report.DroppedFlows);
+        Assert.Equal(new[] { TimeSpan.FromSeconds(2.5), TimeSpan.FromSeconds(3.0) }, report.Times);
+        Assert.Equal(101, report.TxPackets[0, 0]);
+        Assert.Equal(203, report.RxBytes[1, 2]);
+        Assert.Equal(0.202, report.DelaySumSeconds[1, 1], 9);
+        Assert.Equal(3u, FlowEpochReport.FlowId(2));
+
+        // 100 bytes more over 0.5 s; 100 packets more with 0.1 s more delay
+        Assert.Equal(1600.0, report.RxBitsPerSecond(1, 0), 6);
+        Assert.Equal(0.001, report.MeanDelay(1, 0)!.Value.TotalSeconds, 9);
+        Assert.Throws<ArgumentOutOfRangeException>(() => report.RxBitsPerSecond(0, 0));
+    }
+
+    [Fact]
+    public void Export_Empty_ReturnsEmptyMatrices()
+    {
+        var (fm, stub) = Create();
+        var report = FlowEpochs.Start(fm, TimeSpan.FromSeconds(1)).Export();
+
+        Assert.Equal(0, report.EpochCount);
+        Assert.Equal(0, report.FlowCount);
+    }
+
+    [Fact]
+    public void Stop_Twice_Throws()
+    {
+        var (fm, stub) = Create();
+        var epochs = FlowEpochs.Start(fm, TimeSpan.FromSeconds(1));
+
+        epochs.Stop();
+        Assert.Throws<InvalidOperationException>(() => epochs.Stop());
+        Assert.Equal(1, stub.FlowEpochsStopCount);
+    }
+}
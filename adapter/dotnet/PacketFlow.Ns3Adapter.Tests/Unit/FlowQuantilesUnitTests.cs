@@ -0,0 +1,70 @@
+// FlowQuantilesUnitTests.cs — unit tests for native flow metric quantiles (StubNativeInterop).
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class FlowQuantilesUnitTests
+{
+    private static (FlowMonitor Monitor, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        var sim = new Simulation(stub, ownsNative: false);
+        return (FlowMonitor.InstallAll(sim), stub);
+    }
+
+    [Fact]
+    public void GetQuantiles_OneCall_FillsMetricByQuantileMatrix()
+    {
+        var (fm, stub) = Create();
+
+        var result = fm.GetQuantiles(new[] { FlowMetric.Throughput, FlowMetric.CompletionTime }, new[] { 0.5, 0.99 });
+
+        var call = stub.LastFlowQuantiles!.Value;
+        Assert.Null(call.Epoch);
+        Assert.Equal(new[] { NativeMethods.Ns3FlowMetric.Throughput, NativeMethods.Ns3FlowMetric.Fct }, call.Metrics);
+        Assert.Equal(new[] { 0.5, 0.99 }, call.Quantiles);
+        Assert.Equal(0.0, call.Compression);
+        Assert.Equal(0.99, result.Values[0, 1]);
+        Assert.Equal(1000.5, result.Get(FlowMetric.CompletionTime, 0.5));
+        Assert.Equal(20, result.FlowCount(FlowMetric.CompletionTime));
+        Assert.Throws<ArgumentException>(() => result.Get(FlowMetric.MeanDelay, 0.5));
+        Assert.Throws<ArgumentException>(() => result.Get(FlowMetric.Throughput, 0.95));
+    }
+
+    [Fact]
+    public void GetQuantiles_InvalidArguments_Throw()
+    {
+        var (fm, stub) = Create();
+        var metrics = new[] { FlowMetric.MeanDelay };
+
+        Assert.Throws<ArgumentException>(() => fm.GetQuantiles(Array.Empty<FlowMetric>(), new[] { 0.5 }));
+        Assert.Throws<ArgumentException>(() => fm.GetQuantiles(metrics, Array.Empty<double>()));
+        Assert.Throws<ArgumentOutOfRangeException>(() => fm.GetQuantiles(metrics, new[] { 1.5 }));
+        Assert.Throws<ArgumentOutOfRangeException>(() => fm.GetQuantiles(metrics, new[] { 0.5 }, compression: 0));
+        Assert.Null(stub.LastFlowQuantiles);
+
+        stub.FlowQuantilesResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => fm.GetQuantiles(metrics, new[] { 0.5 }));
+    }
+
+    [Fact]
+    public void EpochQuantiles_PassEpochAndCompression()
+    {
+        var (fm, stub) = Create();
+        var epochs = FlowEpochs.Start(fm, TimeSpan.FromSeconds(1));
+
+        var result = epochs.GetQuantiles(new[] { FlowMetric.LossRatio }, new[] { 0.95 }, epoch: 7, compression: 200);
+
+        var call = stub.LastFlowQuantiles!.Value;
+        Assert.Equal(7ul, call.Epoch);
+        Assert.Equal(200.0, call.Compression);
+        Assert.Equal(4000.95, result.Get(FlowMetric.LossRatio, 0.95));
+
+        epochs.GetQuantiles(new[] { FlowMetric.Throughput }, new[] { 0.5 });
+        Assert.Equal(0ul, stub.LastFlowQuantiles!.Value.Epoch);
+        Assert.Throws<ArgumentOutOfRangeException>(() => epochs.GetQuantiles(new[] { FlowMetric.Throughput }, new[] { 0.5 }, epoch: 0));
+    }
+}
@@ -0,0 +1,114 @@
+// LatencyUnitTests.cs — unit tests for LatencyMonitor using StubNativeInterop.
+
+using System.Net;
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class LatencyUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void InstallAll_PassesPrecision()
+    {
+        var (sim, stub) = Create();
+        LatencyMonitor.InstallAll(sim, precisionBits: 6);
+        Assert.Equal(6u, stub.LastLatencyPrecisionBits);
+    }
+
+    [Theory]
+    [InlineData(1)]
+    [InlineData(9)]
+    public void InstallAll_PrecisionOutOfRange_Throws(int bits)
+    {
+        var (sim, stub) = Create();
+        Assert.Throws<ArgumentOutOfRangeException>(() => LatencyMonitor.InstallAll(sim, bits));
+        Assert.Null(stub.LastLatencyPrecisionBits);
+    }
+
+    [Fact]
+    public void InstallAll_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.LatencyInstallResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => LatencyMonitor.InstallAll(sim));
+    }
+
+    [Fact]
+    public void GetFlows_ConvertsFiveTuple()
+    {
+        var (sim, stub) = Create();
+        stub.LatencyFlowsResult.Add(new NativeMethods.Ns3LatencyFlow
+        {
+            SrcAddr = 0x0A010101,
+            DstAddr = 0x0A010102,
+            SrcPort = 49153,
+            DstPort = 9,
+            Protocol = 17,
+            Packets = 42,
+            MinSec = 0.002,
+            MaxSec = 0.004,
+            MeanSec = 0.003,
+        });
+
+        var flows = LatencyMonitor.InstallAll(sim).GetFlows();
+
+        var flow = Assert.Single(flows);
+        Assert.Equal(IPAddress.Parse("10.1.1.1"), flow.Source);
+        Assert.Equal(IPAddress.Parse("10.1.1.2"), flow.Destination);
+        Assert.Equal((49153, 9, 17, 42L), (flow.SourcePort, flow.DestinationPort, flow.Protocol, flow.Packets));
+        Assert.Equal(0.003, flow.MeanDelaySeconds);
+    }
+
+    [Fact]
+    public void GetPercentiles_DefaultsToAllFlows()
+    {
+        var (sim, stub) = Create();
+        var result = LatencyMonitor.InstallAll(sim).GetPercentiles(new[] { 0.5, 0.99 });
+
+        Assert.Equal(NativeMethods.LatencyAllFlows, stub.LastLatencyFlowIndex);
+        Assert.Equal(new[] { 0.5e-3, 0.99e-3 }, result);
+    }
+
+    [Fact]
+    public void GetPercentiles_SelectsFlow()
+    {
+        var (sim, stub) = Create();
+        LatencyMonitor.InstallAll(sim).GetPercentiles(new[] { 0.999 }, flowIndex: 3);
+
+        Assert.Equal(3u, stub.LastLatencyFlowIndex);
+        Assert.Equal(new[] { 0.999 }, stub.LastLatencyQuantiles);
+    }
+
+    [Theory]
+    [InlineData(-0.1)]
+    [InlineData(1.5)]
+    [InlineData(double.NaN)]
+    public void GetPercentiles_InvalidQuantile_Throws(double q)
+    {
+        var (sim, stub) = Create();
+        var monitor = LatencyMonitor.InstallAll(sim);
+        Assert.Throws<ArgumentOutOfRangeException>(() => monitor.GetPercentiles(new[] { q }));
+        Assert.Null(stub.LastLatencyQuantiles);
+    }
+
+    [Fact]
+    public void GetBuckets_ReturnsCountsAndBounds()
+    {
+        var (sim, stub) = Create();
+        stub.LatencyBucketCounts = new ulong[] { 0, 5, 7 };
+
+        var buckets = LatencyMonitor.InstallAll(sim).GetBuckets(flowIndex: 1);
+
+        Assert.Equal(1u, stub.LastLatencyFlowIndex);
+        Assert.Equal(new long[] { 0, 5, 7 }, buckets.Counts);
+        Assert.Equal(new[] { 0.0, 1e-6, 2e-6 }, buckets.LowerBoundsSeconds);
+    }
+}
@@ -0,0 +1,76 @@
+// PcapReplayUnitTests.cs — unit tests for PcapReplay using StubNativeInterop.
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class PcapReplayUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void Create_PassesPathDestinationAndOptions()
+    {
+        var (sim, stub) = Create();
+        var node = sim.CreateNodes(1)[0];
+
+        var replay = PcapReplay.Create(sim, node, "prod.pcap", "10.1.1.2", 9, timeScale: 0.5, maxPackets: 1000);
+
+        Assert.Same(sim, replay.Application.Simulation);
+        Assert.Equal(stub.AppHandle, replay.Application.NativeHandle);
+        var (path, dstIp, port, options) = stub.LastPcapReplay!.Value;
+        Assert.Equal(("prod.pcap", "10.1.1.2", (ushort)9), (path, dstIp, port));
+        Assert.Equal((0.5, 1000ul), (options!.Value.TimeScale, options.Value.MaxPackets));
+    }
+
+    [Fact]
+    public void Create_Defaults_RealTimeWholeCapture()
+    {
+        var (sim, stub) = Create();
+        PcapReplay.Create(sim, sim.CreateNodes(1)[0], "prod.pcap", "10.1.1.2", 9);
+
+        var options = stub.LastPcapReplay!.Value.Options!.Value;
+        Assert.Equal((1.0, 0ul), (options.TimeScale, options.MaxPackets));
+    }
+
+    [Fact]
+    public void Create_InvalidArguments_Throw()
+    {
+        var (sim, stub) = Create();
+        var node = sim.CreateNodes(1)[0];
+        Assert.Throws<ArgumentNullException>(() => PcapReplay.Create(sim, null!, "prod.pcap", "10.0.0.1", 9));
+        Assert.Throws<ArgumentException>(() => PcapReplay.Create(sim, node, "", "10.0.0.1", 9));
+        Assert.Throws<ArgumentException>(() => PcapReplay.Create(sim, node, "prod.pcap", "", 9));
+        Assert.Throws<ArgumentOutOfRangeException>(() => PcapReplay.Create(sim, node, "prod.pcap", "10.0.0.1", 9, timeScale: 0));
+        Assert.Throws<ArgumentOutOfRangeException>(() => PcapReplay.Create(sim, node, "prod.pcap", "10.0.0.1", 9, timeScale: double.NaN));
+        Assert.Null(stub.LastPcapReplay);
+    }
+
+    [Fact]
+    public void Create_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        var node = sim.CreateNodes(1)[0];
+        stub.AppResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => PcapReplay.Create(sim, node, "missing.pcap", "10.0.0.1", 9));
+    }
+
+    [Fact]
+    public void GetStats_ConvertsCounters()
+    {
+        var (sim, stub) = Create();
+        var replay = PcapReplay.Create(sim, sim.CreateNodes(1)[0], "prod.pcap", "10.1.1.2", 9);
+        stub.PcapReplayStatsResult = new NativeMethods.Ns3PcapReplayStats
+        {
+            Records = 120, Skipped = 20, PacketsSent = 100, BytesSent = 150_000, Stalls = 1, CaptureSpanSec = 2.5,
+        };
+
+        Assert.Equal(new PcapReplayStats(120, 20, 100, 150_000, 1, TimeSpan.FromSeconds(2.5)), replay.GetStats());
+    }
+}
@@ -0,0 +1,79 @@
+// QueueMonitorUnitTests.cs — unit tests for QueueMonitor using StubNativeInterop.
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class QueueMonitorUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void Create_PassesBinWidthAndWindow_WithoutCallback()
+    {
+        var (sim, stub) = Create();
+        var monitor = QueueMonitor.Create(sim, TimeSpan.FromMilliseconds(10), 1000);
+
+        Assert.Equal((0.01, 1000u), stub.LastQueueMonitorCreate!.Value);
+        Assert.Null(stub.LastQueueEventCallback);
+        Assert.Equal(1000, monitor.WindowBins);
+    }
+
+    [Theory]
+    [InlineData(0, 10)]
+    [InlineData(100, 0)]
+    public void Create_InvalidArguments_Throw(int binWidthMs, int windowBins)
+    {
+        var (sim, stub) = Create();
+        Assert.Throws<ArgumentOutOfRangeException>(
+            () => QueueMonitor.Create(sim, TimeSpan.FromMilliseconds(binWidthMs), windowBins));
+        Assert.Null(stub.LastQueueMonitorCreate);
+    }
+
+    [Fact]
+    public void Create_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.QueueMonitorCreateResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => QueueMonitor.Create(sim, TimeSpan.FromSeconds(1), 10, _ => { }));
+    }
+
+    [Fact]
+    public unsafe void Create_WithCallback_ConvertsEvents()
+    {
+        var (sim, stub) = Create();
+        QueueEvent? received = null;
+        QueueMonitor.Create(sim, TimeSpan.FromSeconds(1), 10, e => received = e);
+
+        var native = new NativeMethods.Ns3QueueEvent { DeviceId = 3, TimeSec = 2.5, Size = 1500, Backlog = 99, Kind = 5 };
+        stub.LastQueueEventCallback!(stub.LastUserPtr, &native);
+
+        Assert.Equal(new QueueEvent(3, TimeSpan.FromSeconds(2.5), QueueEventKind.QdiscDrop, 1500, 99), received);
+    }
+
+    [Fact]
+    public void Export_ReturnsCountersAndBacklog()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        stub.QueueMonitorBinCount = 3;
+        stub.QueueMonitorFirstBin = 4;
+
+        var report = QueueMonitor.Create(sim, TimeSpan.FromMilliseconds(100), 3).Attach(dev1, dev0).Export();
+
+        Assert.Equal(new[] { dev1.NativeHandle, dev0.NativeHandle }, stub.QueueMonitorAttachedDevices);
+        Assert.Equal(new[] { dev1, dev0 }, report.Devices);
+        Assert.Equal((2L, 3000L), (report.Counters[1].Dropped, report.Counters[1].DroppedBytes));
+        Assert.Equal(2, report.Counters[1].TotalDrops);
+        Assert.Equal((2, 3), (report.Backlog.GetLength(0), report.Backlog.GetLength(1)));
+        Assert.Equal(new BacklogBin(2.5, 2, 3, TimeSpan.FromMilliseconds(100)), report.Backlog[1, 2]);
+        Assert.Equal(TimeSpan.FromMilliseconds(500), report.BinStart(1));
+    }
+}
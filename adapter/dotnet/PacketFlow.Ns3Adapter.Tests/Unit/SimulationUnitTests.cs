@@ -1,6 +1,7 @@
 // SimulationUnitTests.cs
 // Unit tests using StubNativeInterop — run WITHOUT ns-3 native DLL.
 
+using System.Net;
 using Xunit;
 using PacketFlow.Ns3Adapter;
 using PacketFlow.Ns3Adapter.Interop;
@@ -257,6 +258,89 @@ public class SimulationUnitTests
         Assert.Equal("my-capture", stub.LastPcapPrefix);
     }
 
+    [Fact]
+    public void Device_EnablePcap_WithOptions_PassesNativeOptions()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+
+        dev0.EnablePcap("cap", new PcapOptions
+        {
+            BufferBytes = 16 << 20, Snaplen = 96, FlushInterval = TimeSpan.FromSeconds(5), Promiscuous = false,
+        });
+
+        var native = stub.LastPcapOptions!.Value;
+        Assert.Equal("cap", stub.LastPcapPrefix);
+        Assert.Equal((16u << 20, 96u, 5.0, NativeMethods.PcapNoPromisc),
+            (native.BufferBytes, native.Snaplen, native.FlushIntervalSec, native.Flags));
+    }
+
+    [Fact]
+    public void Device_EnablePcap_DefaultOptions_AreZero_InfiniteFlushIsNegative()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+
+        dev0.EnablePcap("cap", new PcapOptions());
+        Assert.Equal(new NativeMethods.Ns3PcapOptions(), stub.LastPcapOptions);
+
+        dev0.EnablePcap("cap", new PcapOptions { FlushInterval = Timeout.InfiniteTimeSpan });
+        Assert.Equal(-1.0, stub.LastPcapOptions!.Value.FlushIntervalSec);
+    }
+
+    [Fact]
+    public void Device_EnablePcap_Compression_PassesCodecAndLevel()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+
+        dev0.EnablePcap("cap", new PcapOptions { Compression = PcapCompression.Zstd, CompressionLevel = 3 });
+
+        var native = stub.LastPcapOptions!.Value;
+        Assert.Equal((2u, 3), (native.Compression, native.CompressionLevel));
+    }
+
+    [Fact]
+    public void Device_EnablePcap_InvalidCompression_Throws()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+
+        Assert.Throws<ArgumentOutOfRangeException>(() => dev0.EnablePcap("cap", new PcapOptions { Compression = (PcapCompression)7 }));
+        Assert.Throws<ArgumentOutOfRangeException>(() => dev0.EnablePcap("cap", new PcapOptions { Compression = PcapCompression.Gzip, CompressionLevel = 0 }));
+        Assert.Null(stub.LastPcapOptions);
+    }
+
+    [Theory]
+    [InlineData(-1, null, 1.0)]
+    [InlineData(null, -1, 1.0)]
+    [InlineData(null, null, 0.0)]
+    public void Device_EnablePcap_InvalidOptions_Throw(int? bufferBytes, int? snaplen, double flushSec)
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        var options = new PcapOptions { BufferBytes = bufferBytes, Snaplen = snaplen, FlushInterval = TimeSpan.FromSeconds(flushSec) };
+
+        Assert.Throws<ArgumentOutOfRangeException>(() => dev0.EnablePcap("cap", options));
+        Assert.Null(stub.LastPcapOptions);
+    }
+
+    [Fact]
+    public void Device_EnablePcap_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        stub.PcapEnableExResult = NativeMethods.Ns3Status.Error;
+
+        Assert.Throws<Ns3Exception>(() => dev0.EnablePcap("cap", new PcapOptions()));
+    }
+
     [Fact]
     public void Device_SubscribeToPacketEvents_RegistersCallbacks()
     {
@@ -308,6 +392,115 @@ public class SimulationUnitTests
             dev0.SubscribeToPacketEvents(onTx: _ => { }, onRx: _ => { }));
     }
 
+    [Fact]
+    public void Device_SubscribeToPacketEvents_Unsubscribe_PassesHandleOnce()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+
+        var first = dev0.SubscribeToPacketEvents(onTx: _ => { }, onRx: null);
+        var second = dev1.SubscribeToPacketEventsEx(onTx: null, onRx: _ => { });
+        second.Unsubscribe();
+        first.Dispose();
+        first.Dispose();
+
+        Assert.Equal(new nint[] { 0xA01, 0xA00 }, stub.Unsubscribed);
+        Assert.False(first.IsActive || second.IsActive);
+        Assert.Throws<InvalidOperationException>(() => second.Unsubscribe());
+    }
+
+    [Fact]
+    public void Device_Unsubscribe_NativeFails_StaysActive()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        var subscription = dev0.SubscribeToPacketEvents(onTx: _ => { }, onRx: _ => { });
+        stub.TraceUnsubscribeResult = NativeMethods.Ns3Status.Error;
+
+        Assert.Throws<Ns3Exception>(() => subscription.Unsubscribe());
+        Assert.True(subscription.IsActive);
+    }
+
+    [Fact]
+    public void TraceStats_ConvertsNativeCounters()
+    {
+        var (sim, stub) = Create();
+        stub.TraceStats = new NativeMethods.Ns3TraceStats { Subscriptions = 2, Contexts = 3, ContextCapacity = 64 };
+
+        Assert.Equal(new TraceStats(2, 3, 64), sim.TraceStats);
+    }
+
+    [Fact]
+    public void Device_Subscription_DisposedAfterSimulation_SkipsNative()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        var subscription = dev0.SubscribeToPacketEvents(onTx: _ => { }, onRx: null);
+
+        sim.Dispose();
+        subscription.Dispose();
+
+        Assert.Empty(stub.Unsubscribed);
+        Assert.False(subscription.IsActive);
+    }
+
+    [Fact]
+    public unsafe void Device_SubscribeToPacketEventsEx_ConvertsHeaderFields()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        PacketEventEx? received = null;
+
+        dev0.SubscribeToPacketEventsEx(onTx: null, onRx: e => received = e);
+
+        Assert.Null(stub.LastTxExCallback);
+        var native = new NativeMethods.Ns3PktEventEx
+        {
+            DeviceId = 7, TimeSec = 1.5, Uid = 42, Size = 1052,
+            SrcAddr = 0x0A010101, DstAddr = 0x0A010102, SrcPort = 49153, DstPort = 9,
+            Direction = 1, Flags = NativeMethods.PktFlagIpv4 | NativeMethods.PktFlagPorts, Protocol = 17, Ttl = 63,
+        };
+        stub.LastRxExCallback!(stub.LastUserPtr, &native);
+
+        var e = Assert.IsType<PacketEventEx>(received);
+        Assert.Equal((7UL, TimeSpan.FromSeconds(1.5), 1052u, 42UL), (e.DeviceId, e.Time, e.Bytes, e.Uid));
+        Assert.True(e.IsIpv4 && e.HasPorts);
+        Assert.Equal(IPAddress.Parse("10.1.1.1"), e.Source);
+        Assert.Equal(IPAddress.Parse("10.1.1.2"), e.Destination);
+        Assert.Equal((17, 63, 49153, 9), ((int)e.Protocol, (int)e.Ttl, (int)e.SourcePort, (int)e.DestinationPort));
+    }
+
+    [Fact]
+    public unsafe void Device_SubscribeToPacketEventsEx_NonIpv4_HasNoAddresses()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        PacketEventEx? sent = null;
+
+        dev0.SubscribeToPacketEventsEx(onTx: e => sent = e, onRx: null);
+        var native = new NativeMethods.Ns3PktEventEx { DeviceId = 1, Size = 60 };
+        stub.LastTxExCallback!(stub.LastUserPtr, &native);
+
+        Assert.False(sent!.Value.IsIpv4);
+        Assert.Null(sent.Value.Source);
+    }
+
+    [Fact]
+    public void Device_SubscribeToPacketEventsEx_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        stub.TraceSubscribePacketEventsExResult = NativeMethods.Ns3Status.Error;
+
+        Assert.Throws<Ns3Exception>(() => dev0.SubscribeToPacketEventsEx(onTx: _ => { }, onRx: null));
+    }
+
     // ========================================================================
     // PopulateRoutingTables
     // ========================================================================
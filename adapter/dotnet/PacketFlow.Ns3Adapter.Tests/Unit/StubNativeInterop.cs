@@ -76,6 +76,16 @@ internal class StubNativeInterop : INativeInterop
         return SimCreateResult;
     }
 
+    public NativeMethods.Ns3SimOptions? LastSimOptions { get; private set; }
+
+    public unsafe NativeMethods.Ns3Status SimCreateEx(out nint outSim, NativeMethods.Ns3SimOptions* options)
+    {
+        OnSimCreate?.Invoke();
+        LastSimOptions = options != null ? *options : null;
+        outSim = SimCreateHandle;
+        return SimCreateResult;
+    }
+
     public NativeMethods.Ns3Status SimSetSeed(nint sim, uint seed)
     {
         CapturedSeed = seed;
@@ -123,6 +133,49 @@ internal class StubNativeInterop : INativeInterop
     public unsafe NativeMethods.Ns3Status InternetInstall(nint sim, nint* nodes, uint count) =>
         NativeMethods.Ns3Status.Ok;
 
+    public uint Rank { get; set; }
+    public uint RankCount { get; set; } = 1;
+    public Dictionary<nint, uint> NodeSystemIds { get; } = new();
+
+    public unsafe NativeMethods.Ns3Status NodesCreateEx(nint sim, uint count, uint* systemIds, nint* outArray)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            outArray[i] = (nint)(0x200 + i * 8);
+            NodeSystemIds[outArray[i]] = systemIds != null ? systemIds[i] : 0;
+        }
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status NodeGetSystemId(nint sim, nint node, out uint outSystemId, out int outIsLocal)
+    {
+        outSystemId = NodeSystemIds.TryGetValue(node, out var id) ? id : 0;
+        outIsLocal = outSystemId == Rank ? 1 : 0;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status SimGetRank(nint sim, out uint outRank, out uint outRankCount)
+    {
+        outRank = Rank;
+        outRankCount = RankCount;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status PartitionResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public NativeMethods.Ns3PartitionEdge[]? LastPartitionEdges { get; private set; }
+    public (uint nodeCount, uint rankCount, double minLookaheadSec)? LastPartitionArgs { get; private set; }
+
+    public unsafe NativeMethods.Ns3Status PartitionNodes(nint sim, uint nodeCount, NativeMethods.Ns3PartitionEdge* edges,
+        uint edgeCount, uint rankCount, double minLookaheadSec, uint* outSystemIds, NativeMethods.Ns3PartitionStats* outStats)
+    {
+        LastPartitionEdges = new ReadOnlySpan<NativeMethods.Ns3PartitionEdge>(edges, (int)edgeCount).ToArray();
+        LastPartitionArgs = (nodeCount, rankCount, minLookaheadSec);
+        for (uint i = 0; i < nodeCount; i++)
+            outSystemIds[i] = i % rankCount;
+        *outStats = new NativeMethods.Ns3PartitionStats { LookaheadSec = 0.005, Imbalance = 1.0, CutEdges = 2 };
+        return PartitionResult;
+    }
+
     public NativeMethods.Ns3Status P2PInstall(nint sim, nint a, nint b, string dataRate, string delay, uint mtu,
         out nint outDevA, out nint outDevB)
     {
@@ -173,41 +226,752 @@ internal class StubNativeInterop : INativeInterop
         return AppResult;
     }
 
+    public (string DstIp, ushort Port, NativeMethods.Ns3TrafficGenOptions Options)? LastTrafficGen { get; private set; }
+
+    public unsafe NativeMethods.Ns3Status AppTrafficGen(nint sim, nint node, string dstIp, ushort port, NativeMethods.Ns3TrafficGenOptions* options, out nint outApp)
+    {
+        LastTrafficGen = (dstIp, port, *options);
+        outApp = AppHandle;
+        return AppResult;
+    }
+
+    public (string Path, string DstIp, ushort Port, NativeMethods.Ns3PcapReplayOptions? Options)? LastPcapReplay { get; private set; }
+    public NativeMethods.Ns3PcapReplayStats PcapReplayStatsResult { get; set; }
+
+    public unsafe NativeMethods.Ns3Status AppPcapReplay(nint sim, nint node, string path, string dstIp, ushort port, NativeMethods.Ns3PcapReplayOptions* options, out nint outApp)
+    {
+        LastPcapReplay = (path, dstIp, port, options != null ? *options : null);
+        outApp = AppHandle;
+        return AppResult;
+    }
+
+    public NativeMethods.Ns3Status AppPcapReplayStats(nint sim, nint app, out NativeMethods.Ns3PcapReplayStats outStats)
+    {
+        outStats = PcapReplayStatsResult;
+        return AppResult;
+    }
+
+    public List<nint> LastBulkNodes { get; } = new();
+    public List<NativeMethods.Ns3AppSpec> LastBulkSpecs { get; } = new();
+
+    // Handle of spec i is AppHandle + i
+    public unsafe NativeMethods.Ns3Status AppInstallBulk(nint sim, nint* nodes, uint nodeCount, NativeMethods.Ns3AppSpec* specs, uint count, nint* outApps)
+    {
+        LastBulkNodes.Clear();
+        LastBulkSpecs.Clear();
+        for (int i = 0; i < nodeCount; i++)
+            LastBulkNodes.Add(nodes[i]);
+        for (int i = 0; i < count; i++)
+            LastBulkSpecs.Add(specs[i]);
+        if (AppResult != NativeMethods.Ns3Status.Ok)
+            return AppResult;
+        for (int i = 0; i < count; i++)
+            outApps[i] = AppHandle + i;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
     public NativeMethods.Ns3Status AppStart(nint sim, nint app, double atTimeSec) =>
         NativeMethods.Ns3Status.Ok;
 
     public NativeMethods.Ns3Status AppStop(nint sim, nint app, double atTimeSec) =>
         NativeMethods.Ns3Status.Ok;
 
+    public NativeMethods.Ns3Status WorkloadOpenResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public (string Path, nint[] Nodes, NativeMethods.Ns3WorkloadOptions? Options)? LastWorkloadOpen { get; private set; }
+    public NativeMethods.Ns3WorkloadStats WorkloadStatsResult { get; set; }
+
+    public unsafe NativeMethods.Ns3Status WorkloadOpen(nint sim, string path, nint* nodes, uint nodeCount, NativeMethods.Ns3WorkloadOptions* options, out nint outWorkload)
+    {
+        var handles = new nint[nodeCount];
+        for (int i = 0; i < handles.Length; i++)
+            handles[i] = nodes[i];
+        LastWorkloadOpen = (path, handles, options != null ? *options : null);
+        outWorkload = WorkloadOpenResult == NativeMethods.Ns3Status.Ok ? (nint)0x8C0 : 0;
+        return WorkloadOpenResult;
+    }
+
+    public NativeMethods.Ns3Status WorkloadStats(nint sim, nint workload, out NativeMethods.Ns3WorkloadStats outStats)
+    {
+        outStats = WorkloadStatsResult;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
     public NativeMethods.Ns3Status TraceSubscribePacketEventsResult { get; set; } = NativeMethods.Ns3Status.Ok;
 
     public NativeMethods.Ns3Status TraceSubscribePacketEvents(nint sim, nint dev,
-        NativeMethods.PacketCallback? onTx, NativeMethods.PacketCallback? onRx, nint user)
+        NativeMethods.PacketCallback? onTx, NativeMethods.PacketCallback? onRx, nint user, out nint outSub)
     {
         LastTxCallback = onTx;
         LastRxCallback = onRx;
         LastUserPtr = user;
+        outSub = TraceSubscribePacketEventsResult == NativeMethods.Ns3Status.Ok ? _nextSubscription++ : 0;
         return TraceSubscribePacketEventsResult;
     }
 
+    public NativeMethods.Ns3Status TraceSubscribePacketEventsExResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public NativeMethods.PacketCallbackEx? LastTxExCallback { get; private set; }
+    public NativeMethods.PacketCallbackEx? LastRxExCallback { get; private set; }
+
+    public NativeMethods.Ns3Status TraceSubscribePacketEventsEx(nint sim, nint dev,
+        NativeMethods.PacketCallbackEx? onTx, NativeMethods.PacketCallbackEx? onRx, nint user, out nint outSub)
+    {
+        LastTxExCallback = onTx;
+        LastRxExCallback = onRx;
+        LastUserPtr = user;
+        outSub = TraceSubscribePacketEventsExResult == NativeMethods.Ns3Status.Ok ? _nextSubscription++ : 0;
+        return TraceSubscribePacketEventsExResult;
+    }
+
+    private nint _nextSubscription = 0xA00;
+    public NativeMethods.Ns3Status TraceUnsubscribeResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public List<nint> Unsubscribed { get; } = new();
+
+    public NativeMethods.Ns3Status TraceUnsubscribe(nint sim, nint sub)
+    {
+        Unsubscribed.Add(sub);
+        return TraceUnsubscribeResult;
+    }
+
+    public NativeMethods.Ns3TraceStats TraceStats { get; set; }
+
+    public NativeMethods.Ns3Status TraceGetStats(nint sim, out NativeMethods.Ns3TraceStats outStats)
+    {
+        outStats = TraceStats;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status TraceSetFilterResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public List<(nint dev, NativeMethods.Ns3TraceFilter? filter)> TraceFilterCalls { get; } = new();
+
+    public unsafe NativeMethods.Ns3Status TraceSetFilter(nint sim, nint dev, NativeMethods.Ns3TraceFilter* filter)
+    {
+        TraceFilterCalls.Add((dev, filter != null ? *filter : null));
+        return TraceSetFilterResult;
+    }
+
+    public NativeMethods.Ns3Status EventSinkOpenResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public NativeMethods.EventBatchCallback? LastEventBatchCallback { get; private set; }
+    public nint LastEventBatchUser { get; private set; }
+    public uint? LastEventBatchCapacity { get; private set; }
+    public List<(nint dev, uint mask)> EventSinkEnableCalls { get; } = new();
+    public int EventSinkFlushCount { get; private set; }
+    public int EventSinkCloseCount { get; private set; }
+    private readonly List<nint> _eventSlots = new();
+
+    public NativeMethods.Ns3Status EventSinkOpen(nint sim, NativeMethods.EventBatchCallback onBatch, nint user, uint batchCapacity)
+    {
+        LastEventBatchCallback = onBatch;
+        LastEventBatchUser = user;
+        LastEventBatchCapacity = batchCapacity;
+        return EventSinkOpenResult;
+    }
+
+    public NativeMethods.Ns3Status EventSinkEnable(nint sim, nint dev, uint eventMask, out uint outSlot)
+    {
+        EventSinkEnableCalls.Add((dev, eventMask));
+        int slot = _eventSlots.IndexOf(dev);
+        if (slot < 0)
+        {
+            slot = _eventSlots.Count;
+            _eventSlots.Add(dev);
+        }
+        outSlot = (uint)slot;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status EventSinkFlush(nint sim)
+    {
+        EventSinkFlushCount++;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status EventSinkClose(nint sim)
+    {
+        EventSinkCloseCount++;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
     public NativeMethods.Ns3Status PcapEnable(nint sim, nint dev, string filePrefix)
     {
         LastPcapPrefix = filePrefix;
         return NativeMethods.Ns3Status.Ok;
     }
 
+    public NativeMethods.Ns3Status PcapEnableExResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public NativeMethods.Ns3PcapOptions? LastPcapOptions { get; private set; }
+
+    public unsafe NativeMethods.Ns3Status PcapEnableEx(nint sim, nint dev, string filePrefix, NativeMethods.Ns3PcapOptions* options)
+    {
+        LastPcapPrefix = filePrefix;
+        LastPcapOptions = options != null ? *options : null;
+        return PcapEnableExResult;
+    }
+
+    public NativeMethods.Ns3Status CaptureRingOpenResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public (string name, NativeMethods.Ns3CaptureRingOptions? options)? LastCaptureRingOpen { get; private set; }
+    public List<nint> CaptureRingAttachedDevices { get; } = new();
+    public NativeMethods.Ns3CaptureRingStats CaptureRingStats { get; set; }
+    public int CaptureRingCloseCount { get; private set; }
+
+    public unsafe NativeMethods.Ns3Status CaptureRingOpen(nint sim, string name, NativeMethods.Ns3CaptureRingOptions* options, out nint outRing)
+    {
+        LastCaptureRingOpen = (name, options != null ? *options : null);
+        outRing = CaptureRingOpenResult == NativeMethods.Ns3Status.Ok ? (nint)0xC00 : 0;
+        return CaptureRingOpenResult;
+    }
+
+    public NativeMethods.Ns3Status CaptureRingAttach(nint sim, nint ring, nint dev)
+    {
+        CaptureRingAttachedDevices.Add(dev);
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status CaptureRingGetStats(nint sim, nint ring, out NativeMethods.Ns3CaptureRingStats outStats)
+    {
+        outStats = CaptureRingStats;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status CaptureRingClose(nint sim, nint ring)
+    {
+        CaptureRingCloseCount++;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status TraceFileOpenResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public (string path, uint flags)? LastTraceFileOpen { get; private set; }
+    public List<nint> TraceFileAttachedDevices { get; } = new();
+    public ulong TraceFileRecordCount { get; set; }
+    public int TraceFileCloseCount { get; private set; }
+
+    public NativeMethods.Ns3Status TraceFileOpen(nint sim, string path, uint flags, out nint outFile)
+    {
+        LastTraceFileOpen = (path, flags);
+        outFile = TraceFileOpenResult == NativeMethods.Ns3Status.Ok ? (nint)0x600 : 0;
+        return TraceFileOpenResult;
+    }
+
+    public NativeMethods.Ns3Status TraceFileAttach(nint sim, nint file, nint dev)
+    {
+        TraceFileAttachedDevices.Add(dev);
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status TraceFileClose(nint sim, nint file, out ulong outRecordCount)
+    {
+        TraceFileCloseCount++;
+        outRecordCount = TraceFileRecordCount;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status ThroughputCreateResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public (double binWidthSec, uint windowBins)? LastThroughputCreate { get; private set; }
+    public List<nint> ThroughputAttachedDevices { get; } = new();
+    public uint ThroughputBinCount { get; set; }
+    public ulong ThroughputFirstBin { get; set; }
+    public int ThroughputExportCalls { get; private set; }
+
+    public NativeMethods.Ns3Status ThroughputCreate(nint sim, double binWidthSec, uint windowBins, out nint outThroughput)
+    {
+        LastThroughputCreate = (binWidthSec, windowBins);
+        outThroughput = ThroughputCreateResult == NativeMethods.Ns3Status.Ok ? (nint)0x700 : 0;
+        return ThroughputCreateResult;
+    }
+
+    public NativeMethods.Ns3Status ThroughputAttach(nint sim, nint tp, nint dev)
+    {
+        ThroughputAttachedDevices.Add(dev);
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    // Cell (row, i) reports TxBytes = 1000 * row + i and RxBytes = TxBytes / 2
+    public unsafe NativeMethods.Ns3Status ThroughputExport(nint sim, nint tp, nint* outDevices, uint deviceCapacity, NativeMethods.Ns3BinCounts* outMatrix, uint matrixCapacity, out NativeMethods.Ns3ThroughputInfo outInfo)
+    {
+        ThroughputExportCalls++;
+        uint rows = (uint)ThroughputAttachedDevices.Count;
+        outInfo = new NativeMethods.Ns3ThroughputInfo
+        {
+            DeviceCount = rows,
+            BinCount = ThroughputBinCount,
+            FirstBin = ThroughputFirstBin,
+            BinWidthSec = LastThroughputCreate?.binWidthSec ?? 0,
+        };
+        if ((outDevices != null && deviceCapacity < rows) || (outMatrix != null && matrixCapacity < rows * ThroughputBinCount))
+            return NativeMethods.Ns3Status.Error;
+
+        for (int row = 0; row < rows; row++)
+        {
+            if (outDevices != null)
+                outDevices[row] = ThroughputAttachedDevices[row];
+            for (int i = 0; outMatrix != null && i < ThroughputBinCount; i++)
+            {
+                ulong tx = (ulong)(1000 * row + i);
+                outMatrix[row * ThroughputBinCount + i] = new NativeMethods.Ns3BinCounts
+                {
+                    TxBytes = tx,
+                    RxBytes = tx / 2,
+                    TxPackets = 1,
+                    RxPackets = 1,
+                };
+            }
+        }
+        return NativeMethods.Ns3Status.Ok;
+    }
+
     public NativeMethods.Ns3Status FlowMonInstallAll(nint sim, out nint outFlowMon)
     {
         outFlowMon = (nint)0x500;
         return NativeMethods.Ns3Status.Ok;
     }
 
+    public NativeMethods.Ns3Status FlowMonInstallResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public (nint[] Nodes, NativeMethods.Ns3FlowMonOptions Options)? LastFlowMonInstall { get; private set; }
+    public uint FlowMonProbedNodes { get; set; } = 2;
+
+    public unsafe NativeMethods.Ns3Status FlowMonInstall(nint sim, nint* nodes, uint count, NativeMethods.Ns3FlowMonOptions* options,
+        out nint outFlowMon, out uint outProbedNodes)
+    {
+        var handles = nodes == null ? Array.Empty<nint>() : new ReadOnlySpan<nint>(nodes, (int)count).ToArray();
+        LastFlowMonInstall = (handles, *options);
+        outFlowMon = FlowMonInstallResult == NativeMethods.Ns3Status.Ok ? (nint)0x501 : 0;
+        outProbedNodes = FlowMonProbedNodes;
+        return FlowMonInstallResult;
+    }
+
     public NativeMethods.Ns3Status FlowMonCollect(nint sim, nint fm, out NativeMethods.Ns3FlowStats outStats)
     {
         outStats = FlowStatsResult;
         return FlowMonCollectResult;
     }
 
+    public NativeMethods.Ns3Status FlowEpochsStartResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public (NativeMethods.Ns3FlowEpochOptions Options, string? Path)? LastFlowEpochsStart { get; private set; }
+    public NativeMethods.Ns3FlowEpochsInfo FlowEpochsInfo { get; set; }
+    public List<uint> FlowEpochsExportCapacities { get; } = new();
+    public int FlowEpochsStopCount { get; private set; }
+
+    public unsafe NativeMethods.Ns3Status FlowEpochsStart(nint sim, nint fm, NativeMethods.Ns3FlowEpochOptions* options, out nint outEpochs)
+    {
+        LastFlowEpochsStart = (*options, Marshal.PtrToStringUTF8(options->Path));
+        outEpochs = FlowEpochsStartResult == NativeMethods.Ns3Status.Ok ? (nint)0xD00 : 0;
+        return FlowEpochsStartResult;
+    }
+
+    /// <summary>
+    /// Fills row r, column f with (r + 1) * 100 + f + 1 (counters) and that
+    /// value / 1000 (sums); times follow FlowEpochsInfo
+    /// </summary>
+    public unsafe NativeMethods.Ns3Status FlowEpochsExport(nint sim, nint epochs, NativeMethods.Ns3FlowEpochColumns* columns,
+        out NativeMethods.Ns3FlowEpochsInfo outInfo)
+    {
+        outInfo = FlowEpochsInfo;
+        if (columns == null) return NativeMethods.Ns3Status.Ok;
+
+        FlowEpochsExportCapacities.Add(columns->Capacity);
+        uint flows = outInfo.FlowCount;
+        for (uint row = 0; row < outInfo.EpochCount; row++)
+        {
+            columns->TimeSec[row] = outInfo.StartSec + (outInfo.FirstEpoch + row) * outInfo.EpochSec;
+            for (uint col = 0; col < flows; col++)
+            {
+                long cell = row * flows + col;
+                ulong value = (row + 1) * 100 + col + 1;
+                columns->TxPackets[cell] = value;
+                columns->RxPackets[cell] = value;
+                columns->TxBytes[cell] = value;
+                columns->RxBytes[cell] = value;
+                columns->LostPackets[cell] = value;
+                columns->DelaySumSec[cell] = value / 1000.0;
+                columns->JitterSumSec[cell] = value / 1000.0;
+            }
+        }
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status FlowEpochsStop(nint sim, nint epochs)
+    {
+        FlowEpochsStopCount++;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public double FlowHistogramBinWidth { get; set; } = 0.001;
+    public uint FlowHistogramBins { get; set; } = 3;
+    public List<(NativeMethods.Ns3FlowHistKind Kind, uint[]? FlowIds)> FlowHistogramCalls { get; } = new();
+
+    /// <summary>
+    /// Fills row r, bin i with (r + 1) * 10 + i; one row when flowIds is null
+    /// </summary>
+    public unsafe NativeMethods.Ns3Status FlowMonHistogram(nint sim, nint fm, NativeMethods.Ns3FlowHistKind kind,
+        uint* flowIds, uint flowCount, ulong* outCounts, uint capacity, out double outBinWidth, out uint outBinCount)
+    {
+        FlowHistogramCalls.Add((kind, flowIds == null ? null : new ReadOnlySpan<uint>(flowIds, (int)flowCount).ToArray()));
+        outBinWidth = FlowHistogramBinWidth;
+        outBinCount = FlowHistogramBins;
+        if (outCounts == null) return NativeMethods.Ns3Status.Ok;
+
+        uint rows = flowIds == null ? 1 : flowCount;
+        if (capacity < rows * FlowHistogramBins) return NativeMethods.Ns3Status.Error;
+        for (uint r = 0; r < rows; r++)
+            for (uint i = 0; i < FlowHistogramBins; i++)
+                outCounts[r * FlowHistogramBins + i] = (r + 1) * 10 + i;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status FlowQuantilesResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public (ulong? Epoch, NativeMethods.Ns3FlowMetric[] Metrics, double[] Quantiles, double Compression)? LastFlowQuantiles { get; private set; }
+
+    /// <summary>
+    /// Value of metric m at quantile q is m * 1000 + q; each metric has 10 * (m + 1) flows
+    /// </summary>
+    public unsafe NativeMethods.Ns3Status FlowMonQuantiles(nint sim, nint fm, NativeMethods.Ns3FlowMetric* metrics, uint metricCount,
+        double* quantiles, uint quantileCount, double compression, double* outValues, ulong* outFlowCounts) =>
+        FillFlowQuantiles(null, metrics, metricCount, quantiles, quantileCount, compression, outValues, outFlowCounts);
+
+    public unsafe NativeMethods.Ns3Status FlowEpochsQuantiles(nint sim, nint epochs, ulong epoch, NativeMethods.Ns3FlowMetric* metrics,
+        uint metricCount, double* quantiles, uint quantileCount, double compression, double* outValues, ulong* outFlowCounts) =>
+        FillFlowQuantiles(epoch, metrics, metricCount, quantiles, quantileCount, compression, outValues, outFlowCounts);
+
+    private unsafe NativeMethods.Ns3Status FillFlowQuantiles(ulong? epoch, NativeMethods.Ns3FlowMetric* metrics, uint metricCount,
+        double* quantiles, uint quantileCount, double compression, double* outValues, ulong* outFlowCounts)
+    {
+        LastFlowQuantiles = (epoch, new ReadOnlySpan<NativeMethods.Ns3FlowMetric>(metrics, (int)metricCount).ToArray(),
+            new ReadOnlySpan<double>(quantiles, (int)quantileCount).ToArray(), compression);
+        if (FlowQuantilesResult != NativeMethods.Ns3Status.Ok) return FlowQuantilesResult;
+
+        for (uint m = 0; m < metricCount; m++)
+        {
+            for (uint q = 0; q < quantileCount; q++)
+                outValues[m * quantileCount + q] = (double)metrics[m] * 1000 + quantiles[q];
+            if (outFlowCounts != null) outFlowCounts[m] = 10 * (ulong)(metrics[m] + 1);
+        }
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status LatencyInstallResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public uint? LastLatencyPrecisionBits { get; private set; }
+    public List<NativeMethods.Ns3LatencyFlow> LatencyFlowsResult { get; } = new();
+    public ulong[] LatencyBucketCounts { get; set; } = Array.Empty<ulong>();
+    public uint? LastLatencyFlowIndex { get; private set; }
+    public double[]? LastLatencyQuantiles { get; private set; }
+
+    public NativeMethods.Ns3Status LatencyInstallAll(nint sim, uint precisionBits, out nint outLatency)
+    {
+        LastLatencyPrecisionBits = precisionBits;
+        outLatency = LatencyInstallResult == NativeMethods.Ns3Status.Ok ? (nint)0x800 : 0;
+        return LatencyInstallResult;
+    }
+
+    public unsafe NativeMethods.Ns3Status LatencyFlows(nint sim, nint lat, NativeMethods.Ns3LatencyFlow* outFlows, uint capacity, out uint outCount)
+    {
+        outCount = (uint)LatencyFlowsResult.Count;
+        if (outFlows == null)
+            return NativeMethods.Ns3Status.Ok;
+        if (capacity < outCount)
+            return NativeMethods.Ns3Status.Error;
+        for (int i = 0; i < LatencyFlowsResult.Count; i++)
+            outFlows[i] = LatencyFlowsResult[i];
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    // Reports quantile q as q milliseconds
+    public unsafe NativeMethods.Ns3Status LatencyPercentiles(nint sim, nint lat, uint flowIndex, double* quantiles, uint count, double* outSec)
+    {
+        LastLatencyFlowIndex = flowIndex;
+        LastLatencyQuantiles = new double[count];
+        for (int i = 0; i < count; i++)
+        {
+            LastLatencyQuantiles[i] = quantiles[i];
+            outSec[i] = quantiles[i] * 1e-3;
+        }
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    // Bucket i starts at i microseconds
+    public unsafe NativeMethods.Ns3Status LatencyBuckets(nint sim, nint lat, uint flowIndex, ulong* outCounts, double* outLowerSec, uint capacity, out uint outBucketCount)
+    {
+        LastLatencyFlowIndex = flowIndex;
+        outBucketCount = (uint)LatencyBucketCounts.Length;
+        if (outCounts == null && outLowerSec == null)
+            return NativeMethods.Ns3Status.Ok;
+        if (capacity < outBucketCount)
+            return NativeMethods.Ns3Status.Error;
+        for (int i = 0; i < LatencyBucketCounts.Length; i++)
+        {
+            if (outCounts != null) outCounts[i] = LatencyBucketCounts[i];
+            if (outLowerSec != null) outLowerSec[i] = i * 1e-6;
+        }
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status FctInstallResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public (ulong[] SizeEdges, double IdleSec, double Compression)? LastFctOptions { get; private set; }
+    public List<NativeMethods.Ns3FctFlow> FctFlowsResult { get; } = new();
+    public double[]? LastFctQuantiles { get; private set; }
+
+    public unsafe NativeMethods.Ns3Status FctInstallAll(nint sim, NativeMethods.Ns3FctOptions* options, out nint outFct)
+    {
+        LastFctOptions = (new ReadOnlySpan<ulong>(options->SizeEdges, (int)options->SizeEdgeCount).ToArray(),
+            options->IdleSec, options->Compression);
+        outFct = FctInstallResult == NativeMethods.Ns3Status.Ok ? (nint)0x880 : 0;
+        return FctInstallResult;
+    }
+
+    public unsafe NativeMethods.Ns3Status FctFlows(nint sim, nint fct, NativeMethods.Ns3FctFlow* outFlows, uint capacity, out uint outCount)
+    {
+        outCount = (uint)FctFlowsResult.Count;
+        if (outFlows == null)
+            return NativeMethods.Ns3Status.Ok;
+        if (capacity < outCount)
+            return NativeMethods.Ns3Status.Error;
+        for (int i = 0; i < FctFlowsResult.Count; i++)
+            outFlows[i] = FctFlowsResult[i];
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    // One bucket per recorded edge plus one; bucket b has b + 1 flows and
+    // reports quantile q as b seconds plus q milliseconds
+    public unsafe NativeMethods.Ns3Status FctDistribution(nint sim, nint fct, double* quantiles, uint quantileCount, NativeMethods.Ns3FctBucket* outBuckets, double* outQuantileSec, uint capacity, out uint outBucketCount)
+    {
+        var edges = LastFctOptions?.SizeEdges ?? Array.Empty<ulong>();
+        outBucketCount = (uint)edges.Length + 1;
+        LastFctQuantiles = new ReadOnlySpan<double>(quantiles, (int)quantileCount).ToArray();
+        if (outBuckets == null && outQuantileSec == null)
+            return NativeMethods.Ns3Status.Ok;
+        if (capacity < outBucketCount)
+            return NativeMethods.Ns3Status.Error;
+        for (uint b = 0; b < outBucketCount; b++)
+        {
+            if (outBuckets != null)
+                outBuckets[b] = new NativeMethods.Ns3FctBucket
+                {
+                    MaxBytes = b < edges.Length ? edges[b] : ulong.MaxValue,
+                    Flows = b + 1,
+                    MeanSec = b,
+                };
+            if (outQuantileSec != null)
+                for (uint q = 0; q < quantileCount; q++)
+                    outQuantileSec[b * quantileCount + q] = b + quantiles[q] * 1e-3;
+        }
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status QueueMonitorCreateResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public (double binWidthSec, uint windowBins)? LastQueueMonitorCreate { get; private set; }
+    public NativeMethods.QueueEventCallback? LastQueueEventCallback { get; private set; }
+    public List<nint> QueueMonitorAttachedDevices { get; } = new();
+    public uint QueueMonitorBinCount { get; set; }
+    public ulong QueueMonitorFirstBin { get; set; }
+
+    public NativeMethods.Ns3Status QueueMonitorCreate(nint sim, double binWidthSec, uint windowBins, NativeMethods.QueueEventCallback? onEvent, nint user, out nint outMonitor)
+    {
+        LastQueueMonitorCreate = (binWidthSec, windowBins);
+        LastQueueEventCallback = onEvent;
+        LastUserPtr = user;
+        outMonitor = QueueMonitorCreateResult == NativeMethods.Ns3Status.Ok ? (nint)0x900 : 0;
+        return QueueMonitorCreateResult;
+    }
+
+    public NativeMethods.Ns3Status QueueMonitorAttach(nint sim, nint qm, nint dev)
+    {
+        QueueMonitorAttachedDevices.Add(dev);
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    // Row r has r + 1 drops; cell (r, i) has backlog min i, max i + r, mean i + 0.5
+    public unsafe NativeMethods.Ns3Status QueueMonitorExport(nint sim, nint qm, nint* outDevices, NativeMethods.Ns3QueueCounters* outCounters, uint deviceCapacity, NativeMethods.Ns3QueueBin* outMatrix, uint matrixCapacity, out NativeMethods.Ns3ThroughputInfo outInfo)
+    {
+        uint rows = (uint)QueueMonitorAttachedDevices.Count;
+        outInfo = new NativeMethods.Ns3ThroughputInfo
+        {
+            DeviceCount = rows,
+            BinCount = QueueMonitorBinCount,
+            FirstBin = QueueMonitorFirstBin,
+            BinWidthSec = LastQueueMonitorCreate?.binWidthSec ?? 0,
+        };
+        if (((outDevices != null || outCounters != null) && deviceCapacity < rows) ||
+            (outMatrix != null && matrixCapacity < rows * QueueMonitorBinCount))
+            return NativeMethods.Ns3Status.Error;
+
+        for (int row = 0; row < rows; row++)
+        {
+            if (outDevices != null)
+                outDevices[row] = QueueMonitorAttachedDevices[row];
+            if (outCounters != null)
+                outCounters[row] = new NativeMethods.Ns3QueueCounters { Dropped = (ulong)row + 1, DroppedBytes = 1500 * ((ulong)row + 1) };
+            for (int i = 0; outMatrix != null && i < QueueMonitorBinCount; i++)
+            {
+                outMatrix[row * QueueMonitorBinCount + i] = new NativeMethods.Ns3QueueBin
+                {
+                    MeanPackets = i + 0.5,
+                    CoveredSec = outInfo.BinWidthSec,
+                    MinPackets = (uint)i,
+                    MaxPackets = (uint)(i + row),
+                };
+            }
+        }
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status TcpBulkInstallResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public List<nint> LastTcpBulkNodes { get; } = new();
+    public List<NativeMethods.Ns3TcpFlowSpec> LastTcpBulkSpecs { get; } = new();
+    public NativeMethods.Ns3TcpBulkOptions? LastTcpBulkOptions { get; private set; }
+    public uint TcpBulkBinCount { get; set; }
+    public ulong TcpBulkFirstBin { get; set; }
+
+    // Sender of spec i is AppHandle + i
+    public unsafe NativeMethods.Ns3Status TcpBulkInstall(nint sim, nint* nodes, uint nodeCount, NativeMethods.Ns3TcpFlowSpec* specs, uint count, NativeMethods.Ns3TcpBulkOptions* options, nint* outSenders, out nint outBulk)
+    {
+        LastTcpBulkNodes.Clear();
+        LastTcpBulkSpecs.Clear();
+        for (int i = 0; i < nodeCount; i++)
+            LastTcpBulkNodes.Add(nodes[i]);
+        for (int i = 0; i < count; i++)
+        {
+            LastTcpBulkSpecs.Add(specs[i]);
+            if (outSenders != null)
+                outSenders[i] = AppHandle + i;
+        }
+        LastTcpBulkOptions = options != null ? *options : null;
+        outBulk = TcpBulkInstallResult == NativeMethods.Ns3Status.Ok ? (nint)0x940 : 0;
+        return TcpBulkInstallResult;
+    }
+
+    // Row r delivered 1000 (r + 1) bytes; cell (r, i) has cwnd min 1000 i, max 1000 (i + r), rtt 10 + i ms
+    public unsafe NativeMethods.Ns3Status TcpBulkExport(nint sim, nint bulk, NativeMethods.Ns3TcpFlowStats* outStats, uint flowCapacity, NativeMethods.Ns3TcpBin* outMatrix, uint matrixCapacity, out NativeMethods.Ns3ThroughputInfo outInfo)
+    {
+        uint rows = (uint)LastTcpBulkSpecs.Count;
+        outInfo = new NativeMethods.Ns3ThroughputInfo
+        {
+            DeviceCount = rows,
+            BinCount = TcpBulkBinCount,
+            FirstBin = TcpBulkFirstBin,
+            BinWidthSec = LastTcpBulkOptions?.IntervalSec ?? 0,
+        };
+        if ((outStats != null && flowCapacity < rows) || (outMatrix != null && matrixCapacity < rows * TcpBulkBinCount))
+            return NativeMethods.Ns3Status.Error;
+
+        for (int row = 0; row < rows; row++)
+        {
+            if (outStats != null)
+            {
+                outStats[row] = new NativeMethods.Ns3TcpFlowStats
+                {
+                    TxBytes = 2000 * ((ulong)row + 1),
+                    RxBytes = 1000 * ((ulong)row + 1),
+                    StartSec = 1,
+                    FirstRxSec = 1.01,
+                    LastRxSec = 2,
+                    CompleteSec = row == 0 ? 2 : -1,
+                    GoodputBps = 8000 * (row + 1),
+                    RttSec = 0.02,
+                    MinRttSec = 0.01,
+                    CwndBytes = 14480,
+                    MaxCwndBytes = 28960,
+                    State = row == 0 ? 2u : 1u,
+                    CongestionControl = 2,
+                    Pacing = 1,
+                };
+            }
+            for (int i = 0; outMatrix != null && i < TcpBulkBinCount; i++)
+            {
+                outMatrix[row * TcpBulkBinCount + i] = new NativeMethods.Ns3TcpBin
+                {
+                    RxBytes = 100,
+                    CwndMeanBytes = 1000 * i + 500,
+                    RttMeanSec = 0.01 + i * 0.001,
+                    RttMinSec = 0.01 + i * 0.001,
+                    RttMaxSec = 0.01 + i * 0.001,
+                    CoveredSec = outInfo.BinWidthSec,
+                    CwndMinBytes = (uint)(1000 * i),
+                    CwndMaxBytes = (uint)(1000 * (i + row)),
+                };
+            }
+        }
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public NativeMethods.Ns3Status SweepResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public NativeMethods.Ns3SweepConfig? LastSweepConfig { get; private set; }
+    public List<string[]> LastSweepAxisValues { get; } = new();
+    public uint LastSweepCapacity { get; private set; }
+
+    public unsafe NativeMethods.Ns3Status SimSweepRun(nint sim, NativeMethods.Ns3SweepConfig* config,
+        NativeMethods.Ns3SweepPointSummary* outSummaries, uint capacity)
+    {
+        LastSweepConfig = *config;
+        LastSweepCapacity = capacity;
+        LastSweepAxisValues.Clear();
+        for (int a = 0; a < config->AxisCount; a++)
+        {
+            var axis = config->Axes[a];
+            var values = new string[axis.ValueCount];
+            for (int v = 0; v < axis.ValueCount; v++)
+                values[v] = Marshal.PtrToStringUTF8(axis.Values[v].S)!;
+            LastSweepAxisValues.Add(values);
+        }
+
+        for (uint i = 0; i < capacity; i++)
+        {
+            outSummaries[i] = new NativeMethods.Ns3SweepPointSummary
+            {
+                PointIndex = i,
+                RunsCompleted = config->RunCount,
+                TxPackets = new NativeMethods.Ns3MetricSummary { Mean = 100 + i, Max = 200 + i }
+            };
+        }
+        return SweepResult;
+    }
+
+    public NativeMethods.Ns3Status ForkRunsResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public ulong[]? LastForkRuns { get; private set; }
+    public (nint fm, double stopTimeSec, uint maxParallel)? LastForkArgs { get; private set; }
+    public HashSet<ulong> FailingForkRuns { get; } = new();
+
+    public unsafe NativeMethods.Ns3Status SimForkRuns(nint sim, ulong* runs, uint count, nint fm,
+        double stopTimeSec, uint maxParallel, NativeMethods.Ns3ForkRunResult* outResults)
+    {
+        LastForkRuns = new ReadOnlySpan<ulong>(runs, (int)count).ToArray();
+        LastForkArgs = (fm, stopTimeSec, maxParallel);
+        for (uint i = 0; i < count; i++)
+        {
+            bool failed = FailingForkRuns.Contains(runs[i]);
+            outResults[i] = new NativeMethods.Ns3ForkRunResult
+            {
+                Run = runs[i],
+                Status = failed ? NativeMethods.Ns3Status.Error : NativeMethods.Ns3Status.Ok,
+                WallTimeSec = 0.5,
+                Stats = failed ? default : new NativeMethods.Ns3FlowStats { TxPackets = 10 * runs[i], RxPackets = 9 * runs[i], FlowCount = 1 }
+            };
+        }
+        return ForkRunsResult;
+    }
+
+    public NativeMethods.Ns3Status JournalOpenResult { get; set; } = NativeMethods.Ns3Status.Ok;
+    public string? JournalPath { get; private set; }
+    public int JournalCloseCount { get; private set; }
+
+    public NativeMethods.Ns3Status JournalOpen(string path)
+    {
+        JournalPath = path;
+        return JournalOpenResult;
+    }
+
+    public NativeMethods.Ns3Status JournalClose()
+    {
+        JournalCloseCount++;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
+    public string JournalLastErrorMessage { get; set; } = "";
+
+    public NativeMethods.Ns3Status JournalLastError(Span<byte> buf)
+    {
+        int length = System.Text.Encoding.UTF8.GetBytes(JournalLastErrorMessage, buf);
+        buf[length] = 0;
+        return NativeMethods.Ns3Status.Ok;
+    }
+
     public NativeMethods.Ns3Status ConfigSet(nint sim, string path, string attrName, NativeMethods.Ns3Attr value) =>
         NativeMethods.Ns3Status.Ok;
 }
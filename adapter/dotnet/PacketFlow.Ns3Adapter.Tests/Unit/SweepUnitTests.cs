@@ -0,0 +1,177 @@
+// SweepUnitTests.cs — unit tests for ParameterSweep using StubNativeInterop (no native DLL).
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class SweepUnitTests
+{
+    private const string P2PPath = "/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice";
+
+    private static (Simulation Sim, StubNativeInterop Stub, FlowMonitor FlowMon) Create()
+    {
+        var stub = new StubNativeInterop();
+        var sim = new Simulation(stub, ownsNative: false);
+        return (sim, stub, FlowMonitor.InstallAll(sim));
+    }
+
+    [Fact]
+    public void Constructor_NullFlowMonitor_Throws()
+    {
+        Assert.Throws<ArgumentNullException>(() => new ParameterSweep(null!));
+    }
+
+    [Fact]
+    public void AddAxis_EmptyValues_Throws()
+    {
+        var (_, _, fm) = Create();
+        var sweep = new ParameterSweep(fm);
+        Assert.Throws<ArgumentException>(() => sweep.AddAxis(P2PPath, "DataRate"));
+    }
+
+    [Fact]
+    public void PointCount_IsProductOfAxisSizes()
+    {
+        var (_, _, fm) = Create();
+        var sweep = new ParameterSweep(fm)
+            .AddAxis(P2PPath, "DataRate", "1Mbps", "5Mbps", "10Mbps")
+            .AddAxis(P2PPath, "Mtu", "1500", "9000");
+        Assert.Equal(6, sweep.PointCount);
+    }
+
+    [Fact]
+    public void ValuesAt_DecodesRowMajor()
+    {
+        var (_, _, fm) = Create();
+        var sweep = new ParameterSweep(fm)
+            .AddAxis(P2PPath, "DataRate", "1Mbps", "5Mbps", "10Mbps")
+            .AddAxis(P2PPath, "Mtu", "1500", "9000");
+        Assert.Equal(new[] { "1Mbps", "1500" }, sweep.ValuesAt(0));
+        Assert.Equal(new[] { "1Mbps", "9000" }, sweep.ValuesAt(1));
+        Assert.Equal(new[] { "10Mbps", "9000" }, sweep.ValuesAt(5));
+    }
+
+    [Fact]
+    public void Run_MarshalsConfigAndAxes()
+    {
+        var (_, stub, fm) = Create();
+        var sweep = new ParameterSweep(fm)
+        {
+            Seed = 7,
+            FirstRun = 3,
+            RunsPerPoint = 20,
+            MaxParallelism = 4,
+            StopTime = TimeSpan.FromSeconds(12),
+            ConfidenceLevel = 0.99
+        }.AddAxis(P2PPath, "DataRate", "1Mbps", "5Mbps");
+
+        sweep.Run();
+
+        var cfg = stub.LastSweepConfig!.Value;
+        Assert.Equal((nint)0x500, cfg.FlowMon);
+        Assert.Equal(1u, cfg.AxisCount);
+        Assert.Equal(7u, cfg.Seed);
+        Assert.Equal(3ul, cfg.FirstRun);
+        Assert.Equal(20u, cfg.RunCount);
+        Assert.Equal(4u, cfg.MaxParallel);
+        Assert.Equal(12.0, cfg.StopTimeSec);
+        Assert.Equal(0.99, cfg.ConfidenceLevel);
+        Assert.Equal(2u, stub.LastSweepCapacity);
+        Assert.Equal(new[] { "1Mbps", "5Mbps" }, stub.LastSweepAxisValues[0]);
+    }
+
+    [Fact]
+    public void Run_MapsSummariesToPoints()
+    {
+        var (_, _, fm) = Create();
+        var sweep = new ParameterSweep(fm) { RunsPerPoint = 5 }
+            .AddAxis(P2PPath, "DataRate", "1Mbps", "5Mbps");
+
+        var results = sweep.Run();
+
+        Assert.Equal(2, results.Count);
+        Assert.Equal(1, results[1].PointIndex);
+        Assert.Equal(new[] { "5Mbps" }, results[1].Values);
+        Assert.Equal(5, results[1].RunsCompleted);
+        Assert.Equal(101.0, results[1].TxPackets.Mean);
+        Assert.Equal(201.0, results[1].TxPackets.Max);
+    }
+
+    [Fact]
+    public void Run_NoAxes_RunsSinglePoint()
+    {
+        var (_, stub, fm) = Create();
+        var results = new ParameterSweep(fm) { RunsPerPoint = 3 }.Run();
+        Assert.Single(results);
+        Assert.Empty(results[0].Values);
+        Assert.Equal(0u, stub.LastSweepConfig!.Value.AxisCount);
+    }
+
+    [Fact]
+    public void Run_ZeroRuns_Throws()
+    {
+        var (_, _, fm) = Create();
+        var sweep = new ParameterSweep(fm) { RunsPerPoint = 0 };
+        Assert.Throws<InvalidOperationException>(() => sweep.Run());
+    }
+
+    [Fact]
+    public void Run_NativeFails_Throws()
+    {
+        var (_, stub, fm) = Create();
+        stub.SweepResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => new ParameterSweep(fm).Run());
+    }
+
+    [Fact]
+    public void RunForked_PassesRunsAndArguments()
+    {
+        var (sim, stub, fm) = Create();
+        sim.RunForked(new ulong[] { 3, 7, 11 }, fm, TimeSpan.FromSeconds(20), maxParallelism: 2);
+
+        Assert.Equal(new ulong[] { 3, 7, 11 }, stub.LastForkRuns);
+        Assert.Equal(((nint)0x500, 20.0, 2u), stub.LastForkArgs!.Value);
+    }
+
+    [Fact]
+    public void RunForked_NoFlowMonitor_PassesNullHandle()
+    {
+        var (sim, stub, _) = Create();
+        sim.RunForked(new ulong[] { 1 });
+        Assert.Equal((nint)0, stub.LastForkArgs!.Value.fm);
+    }
+
+    [Fact]
+    public void RunForked_MapsPerRunResults()
+    {
+        var (sim, stub, fm) = Create();
+        stub.FailingForkRuns.Add(2);
+
+        var results = sim.RunForked(new ulong[] { 1, 2, 3 }, fm);
+
+        Assert.Equal(3, results.Count);
+        Assert.True(results[0].Succeeded);
+        Assert.Equal(10ul, results[0].Statistics.TxPackets);
+        Assert.Equal(TimeSpan.FromSeconds(0.5), results[0].WallTime);
+        Assert.False(results[1].Succeeded);
+        Assert.Equal(2ul, results[1].Run);
+        Assert.Equal(27ul, results[2].Statistics.RxPackets);
+    }
+
+    [Fact]
+    public void RunForked_EmptyRuns_Throws()
+    {
+        var (sim, _, _) = Create();
+        Assert.Throws<ArgumentException>(() => sim.RunForked(Array.Empty<ulong>()));
+    }
+
+    [Fact]
+    public void RunForked_NativeFails_Throws()
+    {
+        var (sim, stub, _) = Create();
+        stub.ForkRunsResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => sim.RunForked(new ulong[] { 1 }));
+    }
+}
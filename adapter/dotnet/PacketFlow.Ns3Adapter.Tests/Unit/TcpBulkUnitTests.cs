@@ -0,0 +1,118 @@
+// TcpBulkUnitTests.cs — unit tests for TcpBulk using StubNativeInterop.
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class TcpBulkUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void Install_PacksSpecsAndOptionsInOneCall()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(3);
+        var specs = new[]
+        {
+            new TcpFlowSpec(0, 2, 5000) { CongestionControl = TcpCongestionControl.Bbr, Bytes = 10_000_000 },
+            new TcpFlowSpec(1, 2, 5001)
+            {
+                CongestionControl = TcpCongestionControl.Dctcp,
+                InitialCwndSegments = 10,
+                Start = TimeSpan.FromSeconds(1),
+                Stop = TimeSpan.FromSeconds(9),
+            },
+        };
+        var options = new TcpBulkOptions
+        {
+            SegmentSize = 8948,
+            SendBufferBytes = 4 << 20,
+            ReceiveBufferBytes = 4 << 20,
+            Interval = TimeSpan.FromMilliseconds(10),
+            WindowIntervals = 500,
+        };
+
+        var bulk = TcpBulk.Install(sim, nodes, specs, options);
+
+        Assert.Equal(nodes.Select(n => n.NativeHandle), stub.LastTcpBulkNodes);
+        var first = stub.LastTcpBulkSpecs[0];
+        Assert.Equal((0u, 2u, (ushort)5000, (ushort)2), (first.SrcNode, first.DstNode, first.Port, first.CongestionControl));
+        Assert.Equal((10_000_000ul, 0.0, 0.0), (first.Bytes, first.StartSec, first.StopSec));
+        var second = stub.LastTcpBulkSpecs[1];
+        Assert.Equal(((ushort)3, 10u, 1.0, 9.0), (second.CongestionControl, second.InitialCwndSegments, second.StartSec, second.StopSec));
+        var o = stub.LastTcpBulkOptions!.Value;
+        Assert.Equal((0u, 8948u, 4u << 20, 4u << 20, 0.01, 500u),
+            (o.SendSize, o.SegmentSize, o.SndBufBytes, o.RcvBufBytes, o.IntervalSec, o.WindowIntervals));
+        Assert.Equal(new[] { (nint)0x400, (nint)0x401 }, bulk.Senders.Select(a => a.NativeHandle));
+        Assert.All(bulk.Senders, a => Assert.Same(sim, a.Simulation));
+    }
+
+    [Fact]
+    public void Install_NoOptions_PassesNull()
+    {
+        var (sim, stub) = Create();
+        TcpBulk.Install(sim, sim.CreateNodes(2), new[] { new TcpFlowSpec(0, 1, 80) });
+
+        Assert.Null(stub.LastTcpBulkOptions);
+        Assert.Equal((ushort)0, stub.LastTcpBulkSpecs[0].CongestionControl);
+    }
+
+    [Fact]
+    public void Install_InvalidArguments_Throw()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        Assert.Throws<ArgumentException>(() => TcpBulk.Install(sim, nodes, Array.Empty<TcpFlowSpec>()));
+        Assert.Throws<ArgumentOutOfRangeException>(() => TcpBulk.Install(sim, nodes, new[] { new TcpFlowSpec(0, 2, 80) }));
+        Assert.Throws<ArgumentOutOfRangeException>(() => TcpBulk.Install(sim, nodes,
+            new[] { new TcpFlowSpec(0, 1, 80) { CongestionControl = (TcpCongestionControl)7 } }));
+        Assert.Throws<ArgumentOutOfRangeException>(() => TcpBulk.Install(sim, nodes, new[] { new TcpFlowSpec(0, 1, 80) },
+            new TcpBulkOptions { Interval = TimeSpan.Zero }));
+        Assert.Empty(stub.LastTcpBulkSpecs);
+    }
+
+    [Fact]
+    public void Install_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.TcpBulkInstallResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => TcpBulk.Install(sim, sim.CreateNodes(2), new[] { new TcpFlowSpec(0, 1, 80) }));
+    }
+
+    [Fact]
+    public void Export_ConvertsTotalsAndIntervals()
+    {
+        var (sim, stub) = Create();
+        stub.TcpBulkBinCount = 3;
+        stub.TcpBulkFirstBin = 40;
+        var bulk = TcpBulk.Install(sim, sim.CreateNodes(2),
+            new[] { new TcpFlowSpec(0, 1, 80) { Bytes = 1000 }, new TcpFlowSpec(1, 0, 81) },
+            new TcpBulkOptions { Interval = TimeSpan.FromMilliseconds(100) });
+
+        var report = bulk.Export();
+
+        Assert.Equal(2, report.Flows.Count);
+        var done = report.Flows[0];
+        Assert.Equal((TcpFlowState.Complete, 2000L, 1000L, 8000.0), (done.State, done.TxBytes, done.RxBytes, done.GoodputBitsPerSecond));
+        Assert.Equal((TimeSpan.FromSeconds(1), TimeSpan.FromSeconds(2)), (done.Started!.Value, done.Completed!.Value));
+        Assert.Equal((14480, 28960), (done.CwndBytes, done.MaxCwndBytes));
+        Assert.Equal(TimeSpan.FromMilliseconds(10), done.MinRtt);
+        Assert.Equal((TcpCongestionControl.Bbr, true), (done.CongestionControl, done.Pacing));
+        Assert.Equal(TcpFlowState.Running, report.Flows[1].State);
+        Assert.Null(report.Flows[1].Completed);
+
+        Assert.Equal((2, 3), (report.Intervals.GetLength(0), report.Intervals.GetLength(1)));
+        var cell = report.Intervals[1, 2];
+        Assert.Equal((2000, 3000, 2500.0), (cell.CwndMinBytes, cell.CwndMaxBytes, cell.CwndMeanBytes));
+        Assert.Equal(0.012, cell.RttMean.TotalSeconds, 9);
+        Assert.Equal(8000.0, cell.GoodputBitsPerSecond, 6);
+        Assert.Equal(TimeSpan.FromSeconds(4.1), report.IntervalStart(1));
+    }
+}
@@ -0,0 +1,93 @@
+// ThroughputUnitTests.cs — unit tests for ThroughputMonitor using StubNativeInterop.
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class ThroughputUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void Create_PassesBinWidthAndWindow()
+    {
+        var (sim, stub) = Create();
+        var monitor = ThroughputMonitor.Create(sim, TimeSpan.FromMilliseconds(100), 600);
+
+        Assert.Equal((0.1, 600u), stub.LastThroughputCreate!.Value);
+        Assert.Equal(600, monitor.WindowBins);
+    }
+
+    [Theory]
+    [InlineData(0, 10)]
+    [InlineData(-1, 10)]
+    [InlineData(100, 0)]
+    public void Create_InvalidArguments_Throw(int binWidthMs, int windowBins)
+    {
+        var (sim, stub) = Create();
+        Assert.Throws<ArgumentOutOfRangeException>(
+            () => ThroughputMonitor.Create(sim, TimeSpan.FromMilliseconds(binWidthMs), windowBins));
+        Assert.Null(stub.LastThroughputCreate);
+    }
+
+    [Fact]
+    public void Create_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.ThroughputCreateResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => ThroughputMonitor.Create(sim, TimeSpan.FromSeconds(1), 10));
+    }
+
+    [Fact]
+    public void Attach_PassesEveryDevice_InRowOrder()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+
+        var monitor = ThroughputMonitor.Create(sim, TimeSpan.FromSeconds(1), 10).Attach(dev1, dev0);
+
+        Assert.Equal(new[] { dev1.NativeHandle, dev0.NativeHandle }, stub.ThroughputAttachedDevices);
+        Assert.Equal(new[] { dev1, dev0 }, monitor.Devices);
+    }
+
+    [Fact]
+    public void Export_ReturnsDenseMatrix()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        stub.ThroughputBinCount = 3;
+        stub.ThroughputFirstBin = 7;
+
+        var matrix = ThroughputMonitor.Create(sim, TimeSpan.FromMilliseconds(500), 3).Attach(dev0, dev1).Export();
+
+        Assert.Equal(2, stub.ThroughputExportCalls);
+        Assert.Equal(new[] { dev0, dev1 }, matrix.Devices);
+        Assert.Equal(7, matrix.FirstBin);
+        Assert.Equal(TimeSpan.FromMilliseconds(500), matrix.BinWidth);
+        Assert.Equal(2, matrix.Bins.GetLength(0));
+        Assert.Equal(3, matrix.Bins.GetLength(1));
+        Assert.Equal(new BinCounts(1002, 501, 1, 1), matrix.Bins[1, 2]);
+        Assert.Equal(TimeSpan.FromSeconds(4), matrix.BinStart(1));
+        Assert.Equal(1002 * 8 / 0.5, matrix.TxBitsPerSecond(1, 2));
+    }
+
+    [Fact]
+    public void Export_NoDevices_ReturnsEmptyMatrix()
+    {
+        var (sim, stub) = Create();
+        stub.ThroughputBinCount = 4;
+
+        var matrix = ThroughputMonitor.Create(sim, TimeSpan.FromSeconds(1), 4).Export();
+
+        Assert.Empty(matrix.Devices);
+        Assert.Equal(0, matrix.Bins.GetLength(0));
+    }
+}
@@ -0,0 +1,233 @@
+// TraceFileUnitTests.cs — unit tests for TraceFile (StubNativeInterop) and TraceFileReader (synthetic files).
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class TraceFileUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void Open_PassesPathAndDirectFlag()
+    {
+        var (sim, stub) = Create();
+        using var file = TraceFile.Open(sim, "trace.ns3t", directIo: true);
+        Assert.Equal(("trace.ns3t", 1u), stub.LastTraceFileOpen!.Value);
+    }
+
+    [Fact]
+    public void Open_PassesHeadersFlag()
+    {
+        var (sim, stub) = Create();
+        using var file = TraceFile.Open(sim, "trace.ns3t", includeHeaders: true);
+        Assert.Equal(NativeMethods.TraceFileHeaders, stub.LastTraceFileOpen!.Value.flags);
+    }
+
+    [Fact]
+    public void Open_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.TraceFileOpenResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => TraceFile.Open(sim, "trace.ns3t"));
+    }
+
+    [Fact]
+    public void Attach_PassesEveryDevice()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(2);
+        var (dev0, dev1) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+
+        using var file = TraceFile.Open(sim, "trace.ns3t").Attach(dev0, dev1);
+
+        Assert.Equal(new[] { dev0.NativeHandle, dev1.NativeHandle }, stub.TraceFileAttachedDevices);
+    }
+
+    [Fact]
+    public void Close_ReturnsRecordCount_AndDisposeDoesNotCloseAgain()
+    {
+        var (sim, stub) = Create();
+        stub.TraceFileRecordCount = 1234;
+        var file = TraceFile.Open(sim, "trace.ns3t");
+
+        Assert.Equal(1234, file.Close());
+        file.Dispose();
+
+        Assert.Equal(1, stub.TraceFileCloseCount);
+        Assert.Throws<InvalidOperationException>(() => file.Close());
+    }
+
+    [Fact]
+    public void Reader_ReadsColumnsAcrossBlocks()
+    {
+        var path = Path.GetTempFileName();
+        try
+        {
+            WriteTraceFile(path, blocks: new[] { 3, 2 });
+
+            using var reader = TraceFileReader.Open(path);
+
+            Assert.Equal(5, reader.RecordCount);
+            Assert.Equal(2, reader.Blocks.Count);
+            Assert.Equal(new TraceFileBlock(3, 2, TimeSpan.FromSeconds(3), TimeSpan.FromSeconds(4)), reader.Blocks[1]);
+            Assert.Equal(new[] { 0.0, 1.0, 2.0, 3.0, 4.0 }, reader.ReadTimes());
+            Assert.Equal(new ulong[] { 10, 11, 12, 13, 14 }, reader.ReadDeviceIds());
+            Assert.Equal(new uint[] { 100, 101, 102, 103, 104 }, reader.ReadSizes());
+            Assert.Equal(new byte[] { 0, 1, 0, 1, 0 }, reader.ReadDirections());
+            Assert.Equal(new ulong[] { 1000, 1001, 1002, 1003, 1004 }, reader.ReadUids());
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public void Reader_ReadsHeaderColumns()
+    {
+        var path = Path.GetTempFileName();
+        try
+        {
+            WriteTraceFile(path, blocks: new[] { 2, 1 }, withHeaders: true);
+
+            using var reader = TraceFileReader.Open(path);
+
+            Assert.True(reader.HasHeaderColumns);
+            Assert.Equal(new ulong[] { 1000, 1001, 1002 }, reader.ReadUids());
+            Assert.Equal(new byte[] { 17, 17, 17 }, reader.ReadProtocols());
+            Assert.Equal(new byte[] { 64, 63, 62 }, reader.ReadTtls());
+            Assert.Equal(new uint[] { 0x0A000000, 0x0A000001, 0x0A000002 }, reader.ReadSourceAddresses());
+            Assert.Equal(new uint[] { 0x0A010000, 0x0A010001, 0x0A010002 }, reader.ReadDestinationAddresses());
+            Assert.Equal(new ushort[] { 5000, 5001, 5002 }, reader.ReadSourcePorts());
+            Assert.Equal(new ushort[] { 9, 9, 9 }, reader.ReadDestinationPorts());
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public void Reader_WithoutHeaderColumns_HeaderReadsThrow()
+    {
+        var path = Path.GetTempFileName();
+        try
+        {
+            WriteTraceFile(path, blocks: new[] { 1 });
+
+            using var reader = TraceFileReader.Open(path);
+
+            Assert.False(reader.HasHeaderColumns);
+            Assert.Throws<InvalidOperationException>(() => reader.ReadProtocols());
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public void Reader_UnclosedFile_Throws()
+    {
+        var path = Path.GetTempFileName();
+        try
+        {
+            WriteTraceFile(path, blocks: new[] { 1 }, withTrailer: false);
+            Assert.Throws<InvalidDataException>(() => TraceFileReader.Open(path));
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    // Writes the layout documented in native/src/trace_file.h; row i has
+    // time i, device 10+i, size 100+i, direction i%2 and uid 1000+i, and with
+    // header columns UDP from 10.0.0.i:5000+i to 10.1.0.i:9 with TTL 64-i
+    private static void WriteTraceFile(string path, int[] blocks, bool withTrailer = true, bool withHeaders = false)
+    {
+        const int align = 4096;
+        int[] widths = withHeaders ? new[] { 8, 8, 4, 1, 8, 1, 1, 4, 4, 2, 2 } : new[] { 8, 8, 4, 1, 8 };
+
+        using var stream = File.Create(path);
+        using var w = new BinaryWriter(stream);
+
+        w.Write("NS3T"u8);
+        w.Write((ushort)1);
+        w.Write((ushort)widths.Length);
+        w.Write(65536u);
+        w.Write((uint)align);
+        foreach (int width in widths)
+        {
+            w.Write(new byte[16]);
+            w.Write((byte)0);
+            w.Write((byte)width);
+            w.Write((ushort)0);
+        }
+        stream.SetLength(align);
+        stream.Position = align;
+
+        var index = new List<(long first, int rows, long[] offsets)>();
+        long row = 0;
+        foreach (int rows in blocks)
+        {
+            var offsets = new long[widths.Length];
+            for (int c = 0; c < widths.Length; c++)
+            {
+                offsets[c] = stream.Position;
+                for (long i = row; i < row + rows; i++)
+                {
+                    switch (c)
+                    {
+                        case 0: w.Write((double)i); break;
+                        case 1: w.Write((ulong)(10 + i)); break;
+                        case 2: w.Write((uint)(100 + i)); break;
+                        case 3: w.Write((byte)(i % 2)); break;
+                        case 4: w.Write((ulong)(1000 + i)); break;
+                        case 5: w.Write((byte)17); break;
+                        case 6: w.Write((byte)(64 - i)); break;
+                        case 7: w.Write((uint)(0x0A000000 + i)); break;
+                        case 8: w.Write((uint)(0x0A010000 + i)); break;
+                        case 9: w.Write((ushort)(5000 + i)); break;
+                        case 10: w.Write((ushort)9); break;
+                    }
+                }
+                long padded = (stream.Position + align - 1) / align * align;
+                stream.SetLength(padded);
+                stream.Position = padded;
+            }
+            index.Add((row, rows, offsets));
+            row += rows;
+        }
+
+        long footerOffset = stream.Position;
+        w.Write((ulong)row);
+        w.Write((uint)index.Count);
+        w.Write(0u);
+        foreach (var (first, rows, offsets) in index)
+        {
+            w.Write((ulong)first);
+            w.Write((uint)rows);
+            w.Write(0u);
+            w.Write((double)first);
+            w.Write((double)(first + rows - 1));
+            foreach (long offset in offsets)
+                w.Write((ulong)offset);
+        }
+
+        if (withTrailer)
+        {
+            uint footerSize = (uint)(stream.Position - footerOffset);
+            w.Write((ulong)footerOffset);
+            w.Write(footerSize);
+            w.Write("NS3T"u8);
+        }
+    }
+}
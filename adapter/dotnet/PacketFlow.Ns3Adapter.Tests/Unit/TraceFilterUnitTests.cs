@@ -0,0 +1,91 @@
+// TraceFilterUnitTests.cs — unit tests for Device.SetTraceFilter using StubNativeInterop.
+
+using System.Net;
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class TraceFilterUnitTests
+{
+    private static (Device Device, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        var sim = new Simulation(stub, ownsNative: false);
+        var nodes = sim.CreateNodes(2);
+        var (dev0, _) = PointToPoint.Install(sim, nodes[0], nodes[1], "5Mbps", "2ms");
+        return (dev0, stub);
+    }
+
+    [Fact]
+    public void SetTraceFilter_EncodesEveryCondition()
+    {
+        var (device, stub) = Create();
+
+        device.SetTraceFilter(new TraceFilter
+        {
+            MinSize = 100,
+            MaxSize = 1500,
+            Protocol = 17,
+            Source = IPNetwork.Parse("10.1.0.0/16"),
+            Destination = IPNetwork.Parse("10.2.3.4/32"),
+            SourcePorts = new PortRange(49152, 65535),
+            DestinationPorts = PortRange.Single(9),
+            SampleEvery = 10,
+        });
+
+        var (dev, filter) = Assert.Single(stub.TraceFilterCalls);
+        Assert.Equal(device.NativeHandle, dev);
+        var f = filter!.Value;
+        Assert.Equal((100u, 1500u, (byte)17, 10u), (f.MinSize, f.MaxSize, f.Protocol, f.SampleEvery));
+        Assert.Equal((0x0A010000u, 0xFFFF0000u), (f.SrcAddr, f.SrcMask));
+        Assert.Equal((0x0A020304u, 0xFFFFFFFFu), (f.DstAddr, f.DstMask));
+        Assert.Equal(((ushort)49152, (ushort)65535), (f.SrcPortMin, f.SrcPortMax));
+        Assert.Equal(((ushort)9, (ushort)9), (f.DstPortMin, f.DstPortMax));
+    }
+
+    [Fact]
+    public void SetTraceFilter_EmptyFilter_LeavesFieldsUnconstrained()
+    {
+        var (device, stub) = Create();
+        device.SetTraceFilter(new TraceFilter());
+
+        var f = stub.TraceFilterCalls[0].filter!.Value;
+        Assert.Equal(0u, f.SrcMask | f.DstMask | f.MinSize | f.MaxSize | f.Protocol);
+        Assert.Equal(1u, f.SampleEvery);
+    }
+
+    [Fact]
+    public void SetTraceFilter_Null_ClearsFilter()
+    {
+        var (device, stub) = Create();
+        device.SetTraceFilter(null);
+        Assert.Null(stub.TraceFilterCalls[0].filter);
+    }
+
+    [Fact]
+    public void SetTraceFilter_Ipv6Prefix_Throws()
+    {
+        var (device, stub) = Create();
+        Assert.Throws<ArgumentException>(() =>
+            device.SetTraceFilter(new TraceFilter { Source = IPNetwork.Parse("2001:db8::/32") }));
+        Assert.Empty(stub.TraceFilterCalls);
+    }
+
+    [Fact]
+    public void SetTraceFilter_InvalidPortRange_Throws()
+    {
+        var (device, _) = Create();
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            device.SetTraceFilter(new TraceFilter { DestinationPorts = new PortRange(10, 5) }));
+    }
+
+    [Fact]
+    public void SetTraceFilter_NativeFails_Throws()
+    {
+        var (device, stub) = Create();
+        stub.TraceSetFilterResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => device.SetTraceFilter(new TraceFilter { Protocol = 6 }));
+    }
+}
@@ -0,0 +1,129 @@
+// WorkloadUnitTests.cs — unit tests for Workload using StubNativeInterop.
+
+using Xunit;
+using PacketFlow.Ns3Adapter;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter.Tests.Unit;
+
+public class WorkloadUnitTests
+{
+    private static (Simulation Sim, StubNativeInterop Stub) Create()
+    {
+        var stub = new StubNativeInterop();
+        return (new Simulation(stub, ownsNative: false), stub);
+    }
+
+    [Fact]
+    public void WriteFile_WritesHeaderAndRecords()
+    {
+        var path = Path.GetTempFileName();
+        try
+        {
+            long written = Workload.WriteFile(path, new[]
+            {
+                new WorkloadFlow(TimeSpan.FromMilliseconds(1), 0, 1, 1000),
+                new WorkloadFlow(TimeSpan.FromMilliseconds(1), 2, 0, 70_000),
+            });
+
+            var bytes = File.ReadAllBytes(path);
+            Assert.Equal(2, written);
+            Assert.Equal(16 + 2 * 24, bytes.Length);
+            Assert.Equal("NS3W"u8.ToArray(), bytes[..4]);
+            Assert.Equal(1, BitConverter.ToUInt16(bytes, 4));
+            Assert.Equal(24, BitConverter.ToUInt16(bytes, 6));
+            Assert.Equal(2UL, BitConverter.ToUInt64(bytes, 8));
+            Assert.Equal(0.001, BitConverter.ToDouble(bytes, 40));
+            Assert.Equal((2u, 0u), (BitConverter.ToUInt32(bytes, 48), BitConverter.ToUInt32(bytes, 52)));
+            Assert.Equal(70_000UL, BitConverter.ToUInt64(bytes, 56));
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public void WriteFile_Unsorted_ThrowsAndLeavesNoRecords()
+    {
+        var path = Path.GetTempFileName();
+        try
+        {
+            Assert.Throws<ArgumentException>(() => Workload.WriteFile(path, new[]
+            {
+                new WorkloadFlow(TimeSpan.FromSeconds(2), 0, 1, 10),
+                new WorkloadFlow(TimeSpan.FromSeconds(1), 0, 1, 10),
+            }));
+            Assert.Equal(0UL, BitConverter.ToUInt64(File.ReadAllBytes(path), 8));
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public void Open_PassesNodesAndOptions()
+    {
+        var (sim, stub) = Create();
+        var nodes = sim.CreateNodes(3);
+
+        var workload = Workload.Open(sim, "flows.wl", nodes, port: 5001, sendSize: 536);
+
+        var (path, handles, options) = stub.LastWorkloadOpen!.Value;
+        Assert.Equal("flows.wl", path);
+        Assert.Equal(nodes.Select(n => n.NativeHandle), handles);
+        Assert.Equal(((ushort)5001, 536u), (options!.Value.Port, options.Value.SendSize));
+        Assert.Equal(5001, workload.Port);
+    }
+
+    [Fact]
+    public void Open_Defaults_PassZeros()
+    {
+        var (sim, stub) = Create();
+        var workload = Workload.Open(sim, "flows.wl", sim.CreateNodes(2));
+
+        var options = stub.LastWorkloadOpen!.Value.Options!.Value;
+        Assert.Equal(((ushort)0, 0u), (options.Port, options.SendSize));
+        Assert.Equal(Workload.DefaultPort, workload.Port);
+    }
+
+    [Fact]
+    public void Open_InvalidSendSize_Throws()
+    {
+        var (sim, stub) = Create();
+        Assert.Throws<ArgumentOutOfRangeException>(() => Workload.Open(sim, "flows.wl", sim.CreateNodes(2), sendSize: 0));
+        Assert.Null(stub.LastWorkloadOpen);
+    }
+
+    [Fact]
+    public void Open_NativeFails_Throws()
+    {
+        var (sim, stub) = Create();
+        stub.WorkloadOpenResult = NativeMethods.Ns3Status.Error;
+        Assert.Throws<Ns3Exception>(() => Workload.Open(sim, "missing.wl", sim.CreateNodes(2)));
+    }
+
+    [Fact]
+    public void GetStats_ConvertsCounters()
+    {
+        var (sim, stub) = Create();
+        stub.WorkloadStatsResult = new NativeMethods.Ns3WorkloadStats
+        {
+            Records = 1_000_000,
+            Started = 400_000,
+            Completed = 399_000,
+            Failed = 10,
+            Skipped = 2,
+            Active = 990,
+            PeakActive = 1200,
+            BytesDelivered = 5_000_000_000,
+            MeanFctSec = 0.004,
+            MaxFctSec = 0.25,
+        };
+
+        var stats = Workload.Open(sim, "flows.wl", sim.CreateNodes(2)).GetStats();
+
+        Assert.Equal(new WorkloadStats(1_000_000, 400_000, 399_000, 10, 2, 990, 1200, 5_000_000_000, 0.004, 0.25), stats);
+    }
+}
@@ -1,6 +1,7 @@
 // Applications.cs
 // High-level API for ns-3 applications
 
+using System.Net;
 using PacketFlow.Ns3Adapter.Interop;
 
 namespace PacketFlow.Ns3Adapter;
@@ -111,6 +112,216 @@ public static class UdpEcho
     }
 }
 
+/// <summary>
+/// Inter-packet gaps of a <see cref="TrafficGenerator"/>
+/// </summary>
+public enum TrafficPattern
+{
+    /// <summary>Every gap is the interval</summary>
+    ConstantBitRate = 0,
+    /// <summary>Exponential gaps with the interval as mean</summary>
+    Poisson = 1,
+}
+
+/// <summary>
+/// Helper class for creating native UDP traffic generators
+/// </summary>
+public static class TrafficGenerator
+{
+    /// <summary>
+    /// Creates a UDP traffic generator application
+    /// </summary>
+    /// <remarks>
+    /// Cheaper than <see cref="UdpEcho.CreateClient"/> at high packet rates:
+    /// packets are copy-on-write clones of one template and several can be
+    /// sent per scheduler event. Clones share one packet uid, which makes
+    /// uid-based <see cref="TraceFilter.SampleEvery"/> keep all or none of
+    /// them; pass <paramref name="uniqueUids"/> to avoid that. Point it at a
+    /// UdpServer or PacketSink (see <see cref="TrafficApps"/>).
+    /// </remarks>
+    /// <param name="simulation">Simulation to create the application in</param>
+    /// <param name="node">Node to host the generator</param>
+    /// <param name="destinationIp">Destination IPv4 address</param>
+    /// <param name="port">Destination UDP port</param>
+    /// <param name="interval">Interval, or mean interval for <see cref="TrafficPattern.Poisson"/>, between packets</param>
+    /// <param name="packetSize">UDP payload bytes</param>
+    /// <param name="pattern">Gap distribution</param>
+    /// <param name="batch">Packets sent back to back per scheduler event; the next event follows after their summed gaps</param>
+    /// <param name="maxPackets">Packets to send before stopping (0 = unlimited)</param>
+    /// <param name="uniqueUids">Allocate every packet, giving each its own uid</param>
+    public static unsafe Application Create(
+        Simulation simulation,
+        Node node,
+        string destinationIp,
+        ushort port,
+        TimeSpan interval,
+        uint packetSize = 1024,
+        TrafficPattern pattern = TrafficPattern.ConstantBitRate,
+        uint batch = 1,
+        ulong maxPackets = 0,
+        bool uniqueUids = false)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        ArgumentNullException.ThrowIfNull(node);
+        if (string.IsNullOrEmpty(destinationIp))
+            throw new ArgumentException("Destination IP cannot be empty", nameof(destinationIp));
+        if (interval <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(interval), "Interval must be positive");
+        if (packetSize == 0 || batch == 0)
+            throw new ArgumentOutOfRangeException(packetSize == 0 ? nameof(packetSize) : nameof(batch),
+                "packetSize and batch must be positive");
+
+        var options = new NativeMethods.Ns3TrafficGenOptions
+        {
+            PacketSize = packetSize,
+            Pattern = (uint)pattern,
+            IntervalSec = interval.TotalSeconds,
+            Batch = batch,
+            Flags = uniqueUids ? NativeMethods.TrafficGenUniqueUids : 0,
+            MaxPackets = maxPackets,
+        };
+        var status = simulation.Interop.AppTrafficGen(simulation.Handle, node.NativeHandle, destinationIp, port,
+            &options, out nint appHandle);
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Create));
+
+        return new Application(simulation, new AppHandle(appHandle));
+    }
+}
+
+/// <summary>
+/// Application kinds installed by <see cref="TrafficApps.Install"/>
+/// </summary>
+public enum AppKind
+{
+    /// <summary>UdpServer listening on the port</summary>
+    UdpServer = 0,
+    /// <summary>UdpClient sending packets at a constant rate</summary>
+    UdpClient = 1,
+    /// <summary>OnOffApplication, always on, at a constant rate</summary>
+    OnOff = 2,
+    /// <summary>BulkSendApplication (TCP), as fast as the socket allows</summary>
+    BulkSend = 3,
+    /// <summary>PacketSink listening on the port</summary>
+    PacketSink = 4,
+}
+
+/// <summary>
+/// One application of a <see cref="TrafficApps.Install"/> call
+/// </summary>
+/// <param name="Kind">Application kind</param>
+/// <param name="Node">Index into the node list of the node hosting the application</param>
+/// <param name="Port">Destination port for senders, listening port for servers and sinks</param>
+public readonly record struct AppSpec(AppKind Kind, int Node, ushort Port)
+{
+    /// <summary>Index into the node list of the peer (senders; resolved to its first IPv4 address)</summary>
+    public int? PeerNode { get; init; }
+
+    /// <summary>Peer IPv4 address, when <see cref="PeerNode"/> is not set</summary>
+    public IPAddress? PeerAddress { get; init; }
+
+    /// <summary>6 = TCP, 17 = UDP (OnOff and PacketSink only; 0 = UDP for OnOff, TCP for PacketSink)</summary>
+    public int Protocol { get; init; }
+
+    /// <summary>Bytes per packet or socket write (0 = 1024)</summary>
+    public int PacketSize { get; init; }
+
+    /// <summary>Send rate in bits per second (UdpClient, OnOff)</summary>
+    public double RateBitsPerSecond { get; init; }
+
+    /// <summary>Bytes to send before stopping (senders; 0 = unlimited)</summary>
+    public long Size { get; init; }
+
+    /// <summary>Start time</summary>
+    public TimeSpan Start { get; init; }
+
+    /// <summary>Stop time (null = run until the simulation ends)</summary>
+    public TimeSpan? Stop { get; init; }
+}
+
+/// <summary>
+/// Bulk installation of traffic-matrix applications
+/// </summary>
+public static class TrafficApps
+{
+    /// <summary>
+    /// Installs every application in one native call and schedules its start and stop
+    /// </summary>
+    /// <remarks>
+    /// All specs are validated natively before any application is created,
+    /// so on error nothing is installed. Assign IPv4 addresses before using
+    /// <see cref="AppSpec.PeerNode"/>.
+    /// </remarks>
+    /// <param name="simulation">Simulation to install into</param>
+    /// <param name="nodes">Nodes the specs refer to by index</param>
+    /// <param name="specs">Applications to install</param>
+    /// <returns>One application per spec, in order</returns>
+    public static unsafe IReadOnlyList<Application> Install(Simulation simulation, IReadOnlyList<Node> nodes,
+        IReadOnlyList<AppSpec> specs)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        ArgumentNullException.ThrowIfNull(nodes);
+        ArgumentNullException.ThrowIfNull(specs);
+
+        var nodeHandles = new nint[nodes.Count];
+        for (int i = 0; i < nodeHandles.Length; i++)
+            nodeHandles[i] = nodes[i].NativeHandle;
+
+        var nativeSpecs = new NativeMethods.Ns3AppSpec[specs.Count];
+        for (int i = 0; i < nativeSpecs.Length; i++)
+            nativeSpecs[i] = ToNative(specs[i], nodes.Count);
+
+        var appHandles = new nint[specs.Count];
+        NativeMethods.Ns3Status status;
+        fixed (nint* nodePtr = nodeHandles)
+        fixed (NativeMethods.Ns3AppSpec* specPtr = nativeSpecs)
+        fixed (nint* appPtr = appHandles)
+        {
+            status = simulation.Interop.AppInstallBulk(simulation.Handle, nodePtr, (uint)nodeHandles.Length, specPtr,
+                (uint)nativeSpecs.Length, appPtr);
+        }
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Install));
+
+        var apps = new Application[appHandles.Length];
+        for (int i = 0; i < apps.Length; i++)
+            apps[i] = new Application(simulation, new AppHandle(appHandles[i]));
+        return apps;
+    }
+
+    private static NativeMethods.Ns3AppSpec ToNative(in AppSpec spec, int nodeCount)
+    {
+        if ((uint)spec.Node >= (uint)nodeCount)
+            throw new ArgumentOutOfRangeException(nameof(spec), spec.Node, "Node index out of range");
+        if (spec.PeerNode is { } peer && (uint)peer >= (uint)nodeCount)
+            throw new ArgumentOutOfRangeException(nameof(spec), peer, "PeerNode index out of range");
+        if (spec.PacketSize < 0 || spec.Size < 0)
+            throw new ArgumentOutOfRangeException(nameof(spec), "PacketSize and Size must not be negative");
+
+        uint address = 0;
+        if (spec.PeerNode is null && spec.PeerAddress is { } ip)
+        {
+            if (ip.AddressFamily != System.Net.Sockets.AddressFamily.InterNetwork)
+                throw new ArgumentException("PeerAddress must be IPv4", nameof(spec));
+            var b = ip.GetAddressBytes();
+            address = (uint)(b[0] << 24 | b[1] << 16 | b[2] << 8 | b[3]);
+        }
+
+        return new NativeMethods.Ns3AppSpec
+        {
+            Kind = (uint)spec.Kind,
+            SrcNode = (uint)spec.Node,
+            DstNode = spec.PeerNode is { } p ? (uint)p : NativeMethods.AppNoNode,
+            DstAddr = address,
+            Port = spec.Port,
+            Protocol = (ushort)spec.Protocol,
+            PacketSize = (uint)spec.PacketSize,
+            RateBps = spec.RateBitsPerSecond,
+            Size = (ulong)spec.Size,
+            StartSec = spec.Start.TotalSeconds,
+            StopSec = spec.Stop?.TotalSeconds ?? 0,
+        };
+    }
+}
+
 /// <summary>
 /// Flow monitor statistics
 /// </summary>
@@ -123,6 +334,15 @@ public readonly record struct FlowStatistics(
     TimeSpan JitterSum,
     uint FlowCount)
 {
+    internal static FlowStatistics FromNative(in NativeMethods.Ns3FlowStats stats) =>
+        new(stats.TxPackets,
+            stats.RxPackets,
+            stats.TxBytes,
+            stats.RxBytes,
+            TimeSpan.FromSeconds(stats.DelaySumSec),
+            TimeSpan.FromSeconds(stats.JitterSumSec),
+            stats.FlowCount);
+
     /// <summary>
     /// Average delay per packet
     /// </summary>
@@ -145,6 +365,65 @@ public readonly record struct FlowStatistics(
         : 0.0;
 }
 
+/// <summary>
+/// FlowMonitor per-flow histograms
+/// </summary>
+public enum FlowHistogramKind
+{
+    /// <summary>One-way delay of received packets (bin width in seconds)</summary>
+    Delay = 0,
+    /// <summary>Delay variation between consecutive received packets (bin width in seconds)</summary>
+    Jitter = 1,
+    /// <summary>Size of transmitted packets (bin width in bytes)</summary>
+    PacketSize = 2,
+}
+
+/// <summary>
+/// Uniform-width FlowMonitor histogram: bin i covers [i, i + 1) x BinWidth
+/// </summary>
+/// <param name="BinWidth">Bin width, in seconds or bytes depending on the kind</param>
+/// <param name="Counts">Packets per bin</param>
+public sealed record FlowHistogram(double BinWidth, long[] Counts)
+{
+    /// <summary>
+    /// Lower edge of a bin
+    /// </summary>
+    public double BinStart(int bin) => bin * BinWidth;
+
+    /// <summary>
+    /// Number of packets counted
+    /// </summary>
+    public long Total
+    {
+        get
+        {
+            long total = 0;
+            foreach (long c in Counts) total += c;
+            return total;
+        }
+    }
+
+    /// <summary>
+    /// Upper edge of the bin holding a quantile in [0, 1] (0 if empty)
+    /// </summary>
+    public double Quantile(double q)
+    {
+        if (q is < 0 or > 1)
+            throw new ArgumentOutOfRangeException(nameof(q), q, "Quantile must be in [0, 1]");
+
+        long total = Total;
+        if (total == 0) return 0;
+        long rank = Math.Max(1, (long)Math.Ceiling(q * total));
+        long seen = 0;
+        for (int i = 0; i < Counts.Length; i++)
+        {
+            seen += Counts[i];
+            if (seen >= rank) return (i + 1) * BinWidth;
+        }
+        return Counts.Length * BinWidth;
+    }
+}
+
 /// <summary>
 /// Flow monitor for collecting network statistics
 /// </summary>
@@ -153,10 +432,11 @@ public sealed class FlowMonitor
     private readonly Simulation _simulation;
     private readonly FlowMonHandle _handle;
 
-    internal FlowMonitor(Simulation simulation, FlowMonHandle handle)
+    internal FlowMonitor(Simulation simulation, FlowMonHandle handle, int? probedNodeCount = null)
     {
         _simulation = simulation ?? throw new ArgumentNullException(nameof(simulation));
         _handle = handle ?? throw new ArgumentNullException(nameof(handle));
+        ProbedNodeCount = probedNodeCount;
     }
 
     /// <summary>
@@ -164,6 +444,16 @@ public sealed class FlowMonitor
     /// </summary>
     internal nint NativeHandle => _handle.DangerousGetHandle();
 
+    /// <summary>
+    /// Gets the simulation this flow monitor belongs to
+    /// </summary>
+    public Simulation Simulation => _simulation;
+
+    /// <summary>
+    /// Number of nodes carrying probes (null when installed with <see cref="InstallAll"/>)
+    /// </summary>
+    public int? ProbedNodeCount { get; }
+
     /// <summary>
     /// Installs flow monitor on all nodes in the simulation
     /// </summary>
@@ -179,6 +469,53 @@ public sealed class FlowMonitor
         return new FlowMonitor(simulation, new FlowMonHandle(handle));
     }
 
+    /// <summary>
+    /// Installs flow monitor probes on a subset of nodes
+    /// </summary>
+    /// <remarks>
+    /// Every probed node adds per-packet work for each packet it sends,
+    /// forwards or receives. Probing end hosts only still yields end-to-end
+    /// counts, delay, jitter and histograms, but a drop inside the network is
+    /// only detected after <paramref name="maxPerHopDelay"/>, which must then
+    /// exceed the whole path's delay. Call after IPv4 addresses are assigned.
+    /// </remarks>
+    /// <param name="simulation">Simulation to monitor</param>
+    /// <param name="nodes">Candidate nodes (null = all nodes)</param>
+    /// <param name="edgeOnly">Skip transit nodes (more than one non-loopback IPv4 interface)</param>
+    /// <param name="maxPerHopDelay">Time after which an unseen packet counts as lost (null = 10 s)</param>
+    /// <param name="startTime">Simulation time monitoring starts (null = immediately)</param>
+    public static unsafe FlowMonitor Install(Simulation simulation, IReadOnlyList<Node>? nodes = null, bool edgeOnly = false,
+        TimeSpan? maxPerHopDelay = null, TimeSpan? startTime = null)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        if (maxPerHopDelay is { } delay && delay <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(maxPerHopDelay), "maxPerHopDelay must be positive");
+        if (startTime is { } start && start < TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(startTime), "startTime must not be negative");
+
+        var handles = new nint[nodes?.Count ?? 0];
+        for (int i = 0; i < handles.Length; i++)
+            handles[i] = nodes![i].NativeHandle;
+
+        var options = new NativeMethods.Ns3FlowMonOptions
+        {
+            EdgeOnly = edgeOnly ? 1 : 0,
+            MaxPerHopDelaySec = maxPerHopDelay?.TotalSeconds ?? 0,
+            StartTimeSec = startTime?.TotalSeconds ?? 0,
+        };
+        NativeMethods.Ns3Status status;
+        nint handle;
+        uint probed;
+        fixed (nint* nodePtr = handles)
+        {
+            status = simulation.Interop.FlowMonInstall(simulation.Handle, nodePtr, (uint)handles.Length, &options,
+                out handle, out probed);
+        }
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Install));
+
+        return new FlowMonitor(simulation, new FlowMonHandle(handle), (int)probed);
+    }
+
     /// <summary>
     /// Collects flow statistics
     /// </summary>
@@ -188,14 +525,70 @@ public sealed class FlowMonitor
         var status = interop.FlowMonCollect(_simulation.Handle, NativeHandle, out var stats);
         Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(CollectStatistics));
 
-        return new FlowStatistics(
-            stats.TxPackets,
-            stats.RxPackets,
-            stats.TxBytes,
-            stats.RxBytes,
-            TimeSpan.FromSeconds(stats.DelaySumSec),
-            TimeSpan.FromSeconds(stats.JitterSumSec),
-            stats.FlowCount
-        );
+        return FlowStatistics.FromNative(stats);
+    }
+
+    /// <summary>
+    /// Histogram of all flows, merged natively
+    /// </summary>
+    public FlowHistogram GetHistogram(FlowHistogramKind kind) => ExportHistograms(kind, null)[0];
+
+    /// <summary>
+    /// Histograms of the given flows, in order (ids the monitor has not seen
+    /// yield empty counts); all share one bin count
+    /// </summary>
+    /// <param name="kind">Histogram to export</param>
+    /// <param name="flowIds">FlowMonitor flow ids (1-based)</param>
+    public IReadOnlyList<FlowHistogram> GetHistograms(FlowHistogramKind kind, params uint[] flowIds)
+    {
+        ArgumentNullException.ThrowIfNull(flowIds);
+        return flowIds.Length == 0 ? Array.Empty<FlowHistogram>() : ExportHistograms(kind, flowIds);
+    }
+
+    /// <summary>
+    /// Estimated quantiles of per-flow metrics across all flows (e.g. median,
+    /// p95 and p99 of throughput and completion time), computed natively
+    /// </summary>
+    /// <param name="metrics">Metrics to summarise</param>
+    /// <param name="quantiles">Quantiles in [0, 1]</param>
+    /// <param name="compression">t-digest compression (null = <see cref="FlowQuantiles.DefaultCompression"/>; higher is more accurate)</param>
+    public unsafe FlowQuantiles GetQuantiles(IReadOnlyList<FlowMetric> metrics, IReadOnlyList<double> quantiles,
+        double? compression = null) =>
+        FlowQuantiles.Query(_simulation, nameof(GetQuantiles), metrics, quantiles, compression,
+            (m, mc, q, qc, c, values, counts) =>
+                _simulation.Interop.FlowMonQuantiles(_simulation.Handle, NativeHandle, m, mc, q, qc, c, values, counts));
+
+    private unsafe FlowHistogram[] ExportHistograms(FlowHistogramKind kind, uint[]? flowIds)
+    {
+        var interop = _simulation.Interop;
+        var nativeKind = (NativeMethods.Ns3FlowHistKind)kind;
+        int rows = flowIds?.Length ?? 1;
+        ulong[] counts;
+        double binWidth;
+        uint bins;
+        fixed (uint* ids = flowIds)
+        {
+            var status = interop.FlowMonHistogram(_simulation.Handle, NativeHandle, nativeKind, ids, (uint)(flowIds?.Length ?? 0),
+                null, 0, out binWidth, out bins);
+            Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetHistogram));
+
+            counts = new ulong[(long)rows * bins];
+            fixed (ulong* countPtr = counts)
+            {
+                status = interop.FlowMonHistogram(_simulation.Handle, NativeHandle, nativeKind, ids, (uint)(flowIds?.Length ?? 0),
+                    countPtr, (uint)counts.Length, out binWidth, out bins);
+            }
+            Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetHistogram));
+        }
+
+        var histograms = new FlowHistogram[rows];
+        for (int r = 0; r < rows; r++)
+        {
+            var row = new long[bins];
+            for (int i = 0; i < row.Length; i++)
+                row[i] = (long)counts[r * (long)bins + i];
+            histograms[r] = new FlowHistogram(binWidth, row);
+        }
+        return histograms;
     }
 }
@@ -0,0 +1,70 @@
+// CallJournal.cs
+// High-level API for recording native API calls to a replayable journal
+//
+// While a journal is open, every state-changing shim call made by any
+// Simulation in the process is written to a compact binary file. The native
+// ns3shim-replay tool re-executes the file without the managed host, which
+// reproduces a scenario from a bug report and shows how much of the recorded
+// time was spent in the shim and ns-3 versus P/Invoke and managed code.
+
+using System.Text;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// An open native call journal; disposing it flushes and closes the file
+/// </summary>
+public sealed class CallJournal : IDisposable
+{
+    private readonly INativeInterop _interop;
+    private bool _disposed;
+
+    private CallJournal(INativeInterop interop, string path)
+    {
+        _interop = interop;
+        Path = path;
+    }
+
+    /// <summary>
+    /// Journal file path
+    /// </summary>
+    public string Path { get; }
+
+    /// <summary>
+    /// Starts journaling to <paramref name="path"/> (truncated); only one journal may be open per process
+    /// </summary>
+    /// <exception cref="Ns3Exception">The file cannot be created or a journal is already open</exception>
+    public static CallJournal Start(string path) => Start(NativeInterop.Instance, path);
+
+    internal static CallJournal Start(INativeInterop interop, string path)
+    {
+        ArgumentNullException.ThrowIfNull(interop);
+        ArgumentException.ThrowIfNullOrEmpty(path);
+
+        if (interop.JournalOpen(path) != NativeMethods.Ns3Status.Ok)
+            throw new Ns3Exception($"{nameof(Start)} failed: {LastError(interop)}");
+        return new CallJournal(interop, path);
+    }
+
+    private static string LastError(INativeInterop interop)
+    {
+        Span<byte> buffer = stackalloc byte[1024];
+        if (interop.JournalLastError(buffer) != NativeMethods.Ns3Status.Ok)
+            return "cannot open journal";
+
+        int length = buffer.IndexOf((byte)0);
+        if (length < 0) length = buffer.Length;
+        return length > 0 ? Encoding.UTF8.GetString(buffer[..length]) : "cannot open journal";
+    }
+
+    /// <summary>
+    /// Flushes and closes the journal
+    /// </summary>
+    public void Dispose()
+    {
+        if (_disposed) return;
+        _disposed = true;
+        _interop.JournalClose();
+    }
+}
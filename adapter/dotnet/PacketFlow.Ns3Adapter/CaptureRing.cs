@@ -0,0 +1,127 @@
+// CaptureRing.cs
+// High-level API for shared-memory live packet capture
+//
+// A CaptureRing streams pcap records of its devices into a POSIX
+// shared-memory ring while the simulation runs. Other local processes tail
+// the ring without files or copies through the simulator (ns3shim-ringcat
+// pipes it into Wireshark); the simulation never waits for them.
+
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// Capture ring counters
+/// </summary>
+/// <param name="Records">Records written</param>
+/// <param name="Bytes">Captured bytes written</param>
+/// <param name="Dropped">Records dropped because the reader was a full ring behind (drop mode)</param>
+/// <param name="Overwritten">Records overwritten by newer ones (overwrite mode)</param>
+public readonly record struct CaptureRingStats(long Records, long Bytes, long Dropped, long Overwritten);
+
+/// <summary>
+/// A live pcap capture ring in POSIX shared memory (Linux and macOS)
+/// </summary>
+public sealed class CaptureRing : IDisposable
+{
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+    private bool _closed;
+
+    private CaptureRing(Simulation simulation, nint handle, string name)
+    {
+        _simulation = simulation;
+        _handle = handle;
+        Name = name;
+    }
+
+    /// <summary>
+    /// Shared-memory object name
+    /// </summary>
+    public string Name { get; }
+
+    /// <summary>
+    /// Creates the ring, replacing a stale object of the same name
+    /// </summary>
+    /// <param name="simulation">Simulation whose devices will be captured</param>
+    /// <param name="name">Shared-memory object name, e.g. "/sim-capture"</param>
+    /// <param name="capacityBytes">Record area in bytes, rounded up to a power of two (null = 64 MiB)</param>
+    /// <param name="snaplen">Bytes captured per packet (null = 65535)</param>
+    /// <param name="dropWhenFull">
+    /// Drop new records while the (single) reader is a full ring behind, instead of overwriting the oldest
+    /// </param>
+    /// <param name="promiscuous">PointToPoint/CSMA: capture every frame on the link rather than only the device's own</param>
+    public static unsafe CaptureRing Open(Simulation simulation, string name, int? capacityBytes = null, int? snaplen = null,
+        bool dropWhenFull = false, bool promiscuous = true)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        ArgumentException.ThrowIfNullOrEmpty(name);
+        if (capacityBytes is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(capacityBytes), capacityBytes, "capacityBytes must be positive");
+        if (snaplen is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(snaplen), snaplen, "snaplen must be positive");
+
+        var options = new NativeMethods.Ns3CaptureRingOptions
+        {
+            CapacityBytes = (uint)(capacityBytes ?? 0),
+            Snaplen = (uint)(snaplen ?? 0),
+            Flags = (dropWhenFull ? NativeMethods.CaptureRingDrop : 0u) |
+                    (promiscuous ? 0u : NativeMethods.CaptureRingNoPromisc),
+        };
+        var status = simulation.Interop.CaptureRingOpen(simulation.Handle, name, &options, out nint handle);
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Open));
+        return new CaptureRing(simulation, handle, name);
+    }
+
+    /// <summary>
+    /// Captures the frames of the given devices, which must share a link type
+    /// </summary>
+    public CaptureRing Attach(params Device[] devices)
+    {
+        ArgumentNullException.ThrowIfNull(devices);
+        if (_closed)
+            throw new InvalidOperationException("Capture ring is closed");
+
+        foreach (var device in devices)
+        {
+            ArgumentNullException.ThrowIfNull(device);
+            var status = _simulation.Interop.CaptureRingAttach(_simulation.Handle, _handle, device.NativeHandle);
+            Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Attach));
+        }
+        return this;
+    }
+
+    /// <summary>
+    /// Current counters (also available after <see cref="Close"/>)
+    /// </summary>
+    public CaptureRingStats GetStats()
+    {
+        var status = _simulation.Interop.CaptureRingGetStats(_simulation.Handle, _handle, out var stats);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetStats));
+        return new CaptureRingStats((long)stats.Records, (long)stats.Bytes, (long)stats.Dropped, (long)stats.Overwritten);
+    }
+
+    /// <summary>
+    /// Marks the ring closed for readers and removes its name; readers that
+    /// have it mapped can finish reading
+    /// </summary>
+    public void Close()
+    {
+        if (_closed)
+            throw new InvalidOperationException("Capture ring is closed");
+
+        _closed = true;
+        var status = _simulation.Interop.CaptureRingClose(_simulation.Handle, _handle);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Close));
+    }
+
+    /// <summary>
+    /// Closes the ring if still open (errors are ignored; use <see cref="Close"/> to observe them)
+    /// </summary>
+    public void Dispose()
+    {
+        if (_closed) return;
+        _closed = true;
+        _simulation.Interop.CaptureRingClose(_simulation.Handle, _handle);
+    }
+}
@@ -0,0 +1,135 @@
+// Distributed.cs
+// High-level API for conservative parallel execution of one simulation
+//
+// A large topology is described up front as a TopologyPlan, partitioned over
+// ranks along high-delay links (the lookahead), and then created with
+// Simulation.CreateNodes(systemIds). Every rank builds the same topology;
+// applications belong only on nodes where Node.IsLocal is true.
+
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// ns-3 simulator implementation
+/// </summary>
+public enum SimulatorImplementation
+{
+    /// <summary>Sequential simulator</summary>
+    Default = 0,
+
+    /// <summary>Conservative granted-time-window simulator over MPI</summary>
+    Distributed = 1,
+
+    /// <summary>Conservative null-message simulator over MPI</summary>
+    NullMessage = 2
+}
+
+/// <summary>
+/// A link in a planned topology, by node index
+/// </summary>
+/// <param name="A">First endpoint index</param>
+/// <param name="B">Second endpoint index</param>
+/// <param name="Delay">Propagation delay (zero for shared media)</param>
+public readonly record struct PlannedLink(int A, int B, TimeSpan Delay);
+
+/// <summary>
+/// Node-to-rank assignment produced by <see cref="TopologyPlan.Partition"/>
+/// </summary>
+/// <param name="SystemIds">Owning rank per planned node</param>
+/// <param name="Lookahead">Smallest delay among links cut between ranks (zero if none)</param>
+/// <param name="Imbalance">Largest rank node count divided by the mean</param>
+/// <param name="CutLinks">Number of links that cross ranks</param>
+public sealed record PartitionPlan(IReadOnlyList<uint> SystemIds, TimeSpan Lookahead, double Imbalance, int CutLinks);
+
+/// <summary>
+/// Describes a topology before its nodes exist so it can be partitioned over ranks
+/// </summary>
+public sealed class TopologyPlan
+{
+    private readonly List<PlannedLink> _links = new();
+
+    /// <summary>
+    /// Creates a plan for the given number of nodes
+    /// </summary>
+    public TopologyPlan(int nodeCount)
+    {
+        if (nodeCount <= 0)
+            throw new ArgumentOutOfRangeException(nameof(nodeCount), "Count must be positive");
+        NodeCount = nodeCount;
+    }
+
+    /// <summary>
+    /// Number of planned nodes
+    /// </summary>
+    public int NodeCount { get; }
+
+    /// <summary>
+    /// Planned links
+    /// </summary>
+    public IReadOnlyList<PlannedLink> Links => _links;
+
+    /// <summary>
+    /// Adds a point-to-point link
+    /// </summary>
+    public TopologyPlan AddLink(int a, int b, TimeSpan delay)
+    {
+        CheckIndex(a, nameof(a));
+        CheckIndex(b, nameof(b));
+        if (delay < TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(delay), "Delay cannot be negative");
+
+        _links.Add(new PlannedLink(a, b, delay));
+        return this;
+    }
+
+    /// <summary>
+    /// Adds a shared medium (CSMA segment, Wi-Fi BSS); its nodes always share a rank
+    /// </summary>
+    public TopologyPlan AddSharedMedium(params int[] nodes)
+    {
+        if (nodes == null || nodes.Length < 2)
+            throw new ArgumentException("At least two nodes required", nameof(nodes));
+
+        for (int i = 1; i < nodes.Length; i++)
+            AddLink(nodes[0], nodes[i], TimeSpan.Zero);
+        return this;
+    }
+
+    /// <summary>
+    /// Assigns planned nodes to ranks, never cutting links faster than <paramref name="minLookahead"/>
+    /// </summary>
+    /// <param name="simulation">Simulation (supplies the rank count and error reporting)</param>
+    /// <param name="minLookahead">Links with a smaller delay keep their endpoints together</param>
+    /// <param name="rankCount">Ranks to spread over (0 = the simulation's rank count)</param>
+    public unsafe PartitionPlan Partition(Simulation simulation, TimeSpan minLookahead, int rankCount = 0)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        if (rankCount < 0)
+            throw new ArgumentOutOfRangeException(nameof(rankCount));
+        if (rankCount == 0)
+            rankCount = simulation.RankCount;
+
+        var edges = _links
+            .Select(l => new NativeMethods.Ns3PartitionEdge { A = (uint)l.A, B = (uint)l.B, DelaySec = l.Delay.TotalSeconds })
+            .ToArray();
+        var systemIds = new uint[NodeCount];
+        NativeMethods.Ns3PartitionStats stats;
+
+        fixed (NativeMethods.Ns3PartitionEdge* edgePtr = edges)
+        fixed (uint* idPtr = systemIds)
+        {
+            var status = simulation.Interop.PartitionNodes(simulation.Handle, (uint)NodeCount, edgePtr, (uint)edges.Length,
+                (uint)rankCount, minLookahead.TotalSeconds, idPtr, &stats);
+            Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Partition));
+        }
+
+        return new PartitionPlan(systemIds, TimeSpan.FromSeconds(stats.LookaheadSec), stats.Imbalance, (int)stats.CutEdges);
+    }
+
+    private void CheckIndex(int index, string paramName)
+    {
+        if (index < 0 || index >= NodeCount)
+            throw new ArgumentOutOfRangeException(paramName);
+    }
+}
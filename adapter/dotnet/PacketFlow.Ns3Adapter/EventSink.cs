@@ -0,0 +1,241 @@
+// EventSink.cs
+// High-level API for the simulation-wide batched event sink
+//
+// One native registration delivers the TX/RX/drop events of every enabled
+// device in batches, each event tagged with the device's slot. There is one
+// delegate and one GCHandle per simulation instead of one per device, and a
+// batch is read in place as a span, so thousands of traced devices cost no
+// per-device or per-event allocation.
+
+using System.Runtime.InteropServices;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// Type of a <see cref="DeviceEvent"/>
+/// </summary>
+public enum DeviceEventType : byte
+{
+    /// <summary>PHY finished transmitting a packet</summary>
+    Transmit = 0,
+    /// <summary>PHY finished receiving a packet</summary>
+    Receive = 1,
+    /// <summary>PHY dropped a received packet or the MAC dropped one before transmission</summary>
+    Drop = 2,
+}
+
+/// <summary>
+/// Event types a device reports to an <see cref="EventSink"/>
+/// </summary>
+[Flags]
+public enum DeviceEventMask : uint
+{
+    /// <summary>Muted</summary>
+    None = 0,
+    /// <summary><see cref="DeviceEventType.Transmit"/></summary>
+    Transmit = 0x1,
+    /// <summary><see cref="DeviceEventType.Receive"/></summary>
+    Receive = 0x2,
+    /// <summary><see cref="DeviceEventType.Drop"/></summary>
+    Drop = 0x4,
+    /// <summary>Every event type</summary>
+    All = Transmit | Receive | Drop,
+}
+
+/// <summary>
+/// One event of a batch; the layout matches the native record, so batches
+/// are read where the simulator wrote them
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Size = 32)]
+public readonly struct DeviceEvent
+{
+    private readonly double _timeSec;
+    private readonly ulong _uid;
+    private readonly uint _slot;
+    private readonly uint _size;
+    private readonly DeviceEventType _type;
+
+    internal DeviceEvent(double timeSec, ulong uid, int slot, uint size, DeviceEventType type)
+    {
+        _timeSec = timeSec;
+        _uid = uid;
+        _slot = (uint)slot;
+        _size = size;
+        _type = type;
+    }
+
+    /// <summary>Simulation time in seconds</summary>
+    public double TimeSeconds => _timeSec;
+
+    /// <summary>Simulation time</summary>
+    public TimeSpan Time => TimeSpan.FromSeconds(_timeSec);
+
+    /// <summary>ns-3 packet uid; the same on every device the packet crosses</summary>
+    public ulong Uid => _uid;
+
+    /// <summary>Slot of the device (see <see cref="EventSink.DeviceAt"/>)</summary>
+    public int Slot => (int)_slot;
+
+    /// <summary>Packet size, including link-layer headers</summary>
+    public uint Bytes => _size;
+
+    /// <summary>Event type</summary>
+    public DeviceEventType Type => _type;
+}
+
+/// <summary>
+/// Receives a batch of events; the span is valid only during the call
+/// </summary>
+public delegate void DeviceEventBatchHandler(ReadOnlySpan<DeviceEvent> events);
+
+/// <summary>
+/// Simulation-wide batched event sink (at most one open per simulation)
+/// </summary>
+/// <remarks>
+/// Batches are delivered on the simulation thread when full, on
+/// <see cref="Flush"/>, when <see cref="Simulation.Run"/> returns and on
+/// <see cref="Close"/>. Device trace filters apply.
+/// </remarks>
+public sealed class EventSink : IDisposable
+{
+    /// <summary>Events per batch when none is given</summary>
+    public const int DefaultBatchCapacity = 4096;
+
+    private readonly Simulation _simulation;
+    private readonly GCHandle _callbackHandle;
+    private readonly List<Device?> _slots = new();
+    private bool _closed;
+
+    private EventSink(Simulation simulation, GCHandle callbackHandle, int batchCapacity)
+    {
+        _simulation = simulation;
+        _callbackHandle = callbackHandle;
+        BatchCapacity = batchCapacity;
+    }
+
+    /// <summary>
+    /// Maximum events per batch
+    /// </summary>
+    public int BatchCapacity { get; }
+
+    /// <summary>
+    /// Opens the simulation's event sink
+    /// </summary>
+    /// <param name="simulation">Simulation whose devices will report</param>
+    /// <param name="onBatch">Batch handler, called on the simulation thread</param>
+    /// <param name="batchCapacity">Events per batch (null = <see cref="DefaultBatchCapacity"/>)</param>
+    public static unsafe EventSink Open(Simulation simulation, DeviceEventBatchHandler onBatch, int? batchCapacity = null)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        ArgumentNullException.ThrowIfNull(onBatch);
+        if (batchCapacity is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(batchCapacity), batchCapacity, "batchCapacity must be positive");
+
+        NativeMethods.EventBatchCallback native = (user, events, count) =>
+            onBatch(new ReadOnlySpan<DeviceEvent>(events, (int)count));
+        var handle = GCHandle.Alloc(native);
+
+        var status = simulation.Interop.EventSinkOpen(simulation.Handle, native, GCHandle.ToIntPtr(handle),
+            (uint)(batchCapacity ?? 0));
+        if (status != NativeMethods.Ns3Status.Ok)
+        {
+            handle.Free();
+            Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Open));
+        }
+
+        simulation.RegisterTraceHandle(handle);
+        return new EventSink(simulation, handle, batchCapacity ?? DefaultBatchCapacity);
+    }
+
+    /// <summary>
+    /// Selects the events a device reports. The first call assigns the
+    /// device's slot; later calls only change the mask, which is cheap and
+    /// safe while the simulation runs.
+    /// </summary>
+    /// <returns>The device's slot</returns>
+    public int Enable(Device device, DeviceEventMask mask = DeviceEventMask.All)
+    {
+        ArgumentNullException.ThrowIfNull(device);
+        if (_closed)
+            throw new InvalidOperationException("Event sink is closed");
+
+        var status = _simulation.Interop.EventSinkEnable(_simulation.Handle, device.NativeHandle, (uint)mask, out uint slot);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Enable));
+
+        int index = (int)slot;
+        lock (_slots)
+        {
+            while (_slots.Count <= index) _slots.Add(null);
+            _slots[index] = device;
+        }
+        return index;
+    }
+
+    /// <summary>
+    /// Enables every given device with the same mask
+    /// </summary>
+    public EventSink Enable(DeviceEventMask mask, params Device[] devices)
+    {
+        ArgumentNullException.ThrowIfNull(devices);
+        foreach (var device in devices)
+            Enable(device, mask);
+        return this;
+    }
+
+    /// <summary>
+    /// Mutes a device; its slot is kept
+    /// </summary>
+    public void Disable(Device device) => Enable(device, DeviceEventMask.None);
+
+    /// <summary>
+    /// Device reporting under a slot
+    /// </summary>
+    public Device DeviceAt(int slot)
+    {
+        lock (_slots)
+        {
+            if ((uint)slot >= (uint)_slots.Count || _slots[slot] is not { } device)
+                throw new ArgumentOutOfRangeException(nameof(slot), slot, "No device has this slot");
+            return device;
+        }
+    }
+
+    /// <summary>
+    /// Delivers the pending events now (e.g. from a scheduled callback)
+    /// </summary>
+    public void Flush()
+    {
+        if (_closed)
+            throw new InvalidOperationException("Event sink is closed");
+
+        var status = _simulation.Interop.EventSinkFlush(_simulation.Handle);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Flush));
+    }
+
+    /// <summary>
+    /// Delivers the pending events and mutes every device; the handler is not
+    /// called again
+    /// </summary>
+    public void Close()
+    {
+        if (_closed)
+            throw new InvalidOperationException("Event sink is closed");
+
+        var status = _simulation.Interop.EventSinkClose(_simulation.Handle);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Close));
+        _closed = true;
+        _simulation.ReleaseTraceHandle(_callbackHandle);
+    }
+
+    /// <summary>
+    /// Closes the sink if still open (errors are ignored; use <see cref="Close"/> to observe them)
+    /// </summary>
+    public void Dispose()
+    {
+        if (_closed || _simulation.IsDisposed) return;
+        if (_simulation.Interop.EventSinkClose(_simulation.Handle) != NativeMethods.Ns3Status.Ok) return;
+        _closed = true;
+        _simulation.ReleaseTraceHandle(_callbackHandle);
+    }
+}
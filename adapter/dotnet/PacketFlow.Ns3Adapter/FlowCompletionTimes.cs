@@ -0,0 +1,203 @@
+// FlowCompletionTimes.cs
+// High-level API for native flow completion time tracking
+//
+// First-byte-sent and last-byte-received times are recorded in native code
+// per IPv4 5-tuple; completed flows are bucketed by size and summarised
+// with t-digest quantiles in one call, so incast and all-to-all studies
+// need no per-packet callback and no per-flow copy.
+
+using System.Net;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// A flow observed by <see cref="FlowCompletionTimes"/>
+/// </summary>
+/// <param name="Source">IPv4 source address</param>
+/// <param name="Destination">IPv4 destination address</param>
+/// <param name="SourcePort">Source port (0 unless TCP or UDP)</param>
+/// <param name="DestinationPort">Destination port (0 unless TCP or UDP)</param>
+/// <param name="Protocol">IP protocol number (6 = TCP, 17 = UDP)</param>
+/// <param name="Complete">Whether the flow has completed</param>
+/// <param name="Bytes">Bytes carried so far</param>
+/// <param name="StartSeconds">Simulation time of the first payload sent</param>
+/// <param name="CompletionSeconds">Last payload received minus first payload sent (so far if incomplete)</param>
+public sealed record FctFlow(
+    IPAddress Source,
+    IPAddress Destination,
+    int SourcePort,
+    int DestinationPort,
+    int Protocol,
+    bool Complete,
+    long Bytes,
+    double StartSeconds,
+    double CompletionSeconds)
+{
+    internal static FctFlow FromNative(in NativeMethods.Ns3FctFlow f) =>
+        new(LatencyFlow.ToAddress(f.SrcAddr), LatencyFlow.ToAddress(f.DstAddr), f.SrcPort, f.DstPort, f.Protocol,
+            f.Complete != 0, (long)f.Bytes, f.StartSec, f.FctSec);
+}
+
+/// <summary>
+/// Completed flows of one size bucket
+/// </summary>
+/// <param name="MaxBytes">Inclusive upper size bound (<see cref="long.MaxValue"/> for the last bucket)</param>
+/// <param name="Flows">Completed flows in the bucket</param>
+/// <param name="MinSeconds">Shortest completion time</param>
+/// <param name="MeanSeconds">Mean completion time</param>
+/// <param name="MaxSeconds">Longest completion time</param>
+public sealed record FctBucket(long MaxBytes, long Flows, double MinSeconds, double MeanSeconds, double MaxSeconds);
+
+/// <summary>
+/// Completion time distribution bucketed by flow size
+/// </summary>
+/// <param name="Quantiles">Matrix columns</param>
+/// <param name="Buckets">Bucket summaries, smallest flows first</param>
+/// <param name="QuantileSeconds">Completion times indexed [bucket, quantile]; 0 for empty buckets</param>
+public sealed record FctDistribution(IReadOnlyList<double> Quantiles, FctBucket[] Buckets, double[,] QuantileSeconds)
+{
+    /// <summary>
+    /// Index of the bucket holding flows of a given size
+    /// </summary>
+    public int BucketOf(long bytes)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(bytes);
+        for (int i = 0; i < Buckets.Length - 1; i++)
+            if (bytes <= Buckets[i].MaxBytes)
+                return i;
+        return Buckets.Length - 1;
+    }
+
+    /// <summary>
+    /// Completion time at one of the requested quantiles for a bucket
+    /// </summary>
+    public double Get(int bucket, double quantile)
+    {
+        for (int q = 0; q < Quantiles.Count; q++)
+            if (Quantiles[q] == quantile)
+                return QuantileSeconds[bucket, q];
+        throw new ArgumentException($"{quantile} was not requested", nameof(quantile));
+    }
+}
+
+/// <summary>
+/// Flow completion times of finite transfers on every IPv4 node
+/// </summary>
+/// <remarks>
+/// TCP flows complete when the sender's FIN is delivered and are sized by
+/// the highest sequence number received; other flows are sized by the
+/// payload delivered and complete after an idle timeout. Each
+/// BulkSend/PacketSink connection or UDP transfer is one flow.
+/// </remarks>
+public sealed class FlowCompletionTimes
+{
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+
+    private FlowCompletionTimes(Simulation simulation, nint handle, long[] sizeEdges)
+    {
+        _simulation = simulation;
+        _handle = handle;
+        SizeEdges = sizeEdges;
+    }
+
+    /// <summary>Inclusive upper bounds of all but the last size bucket, in bytes</summary>
+    public IReadOnlyList<long> SizeEdges { get; }
+
+    /// <summary>
+    /// Starts tracking on all existing nodes
+    /// </summary>
+    /// <param name="simulation">Simulation to monitor</param>
+    /// <param name="sizeEdges">Strictly ascending inclusive upper bounds of the size buckets in bytes;
+    /// one more bucket holds larger flows (null = a single bucket)</param>
+    /// <param name="idleTimeout">Non-TCP flows complete after this long without deliveries (null = when queried)</param>
+    /// <param name="compression">t-digest compression (null = <see cref="FlowQuantiles.DefaultCompression"/>)</param>
+    public static unsafe FlowCompletionTimes InstallAll(Simulation simulation, IReadOnlyList<long>? sizeEdges = null,
+        TimeSpan? idleTimeout = null, double? compression = null)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        var edges = sizeEdges?.ToArray() ?? Array.Empty<long>();
+        for (int i = 0; i < edges.Length; i++)
+        {
+            if (edges[i] < 0 || (i > 0 && edges[i] <= edges[i - 1]))
+                throw new ArgumentException("Size edges must be non-negative and strictly ascending", nameof(sizeEdges));
+        }
+        if (idleTimeout < TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(idleTimeout), "idleTimeout must not be negative");
+        if (compression is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(compression), compression, "compression must be positive");
+
+        NativeMethods.Ns3Status status;
+        nint handle;
+        fixed (long* edgePtr = edges)
+        {
+            var options = new NativeMethods.Ns3FctOptions
+            {
+                SizeEdges = edges.Length > 0 ? (ulong*)edgePtr : null,
+                SizeEdgeCount = (uint)edges.Length,
+                IdleSec = idleTimeout?.TotalSeconds ?? 0,
+                Compression = compression ?? 0,
+            };
+            status = simulation.Interop.FctInstallAll(simulation.Handle, &options, out handle);
+        }
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(InstallAll));
+        return new FlowCompletionTimes(simulation, handle, edges);
+    }
+
+    /// <summary>
+    /// Gets every flow that has sent payload, in order of first appearance
+    /// </summary>
+    public unsafe IReadOnlyList<FctFlow> GetFlows()
+    {
+        var status = _simulation.Interop.FctFlows(_simulation.Handle, _handle, null, 0, out uint count);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetFlows));
+
+        var flows = new NativeMethods.Ns3FctFlow[count];
+        fixed (NativeMethods.Ns3FctFlow* flowPtr = flows)
+        {
+            status = _simulation.Interop.FctFlows(_simulation.Handle, _handle, flowPtr, (uint)flows.Length, out count);
+        }
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetFlows));
+
+        var result = new FctFlow[flows.Length];
+        for (int i = 0; i < flows.Length; i++)
+            result[i] = FctFlow.FromNative(flows[i]);
+        return result;
+    }
+
+    /// <summary>
+    /// Completion time distribution of the completed flows, per size bucket
+    /// </summary>
+    /// <param name="quantiles">Quantiles in [0, 1] (e.g., 0.5, 0.99)</param>
+    public unsafe FctDistribution GetDistribution(IReadOnlyList<double> quantiles)
+    {
+        ArgumentNullException.ThrowIfNull(quantiles);
+        foreach (double q in quantiles)
+            if (q is < 0 or > 1 || double.IsNaN(q))
+                throw new ArgumentOutOfRangeException(nameof(quantiles), q, "Quantiles must be in [0, 1]");
+
+        var quantileArray = quantiles.ToArray();
+        int bucketCount = SizeEdges.Count + 1;
+        var buckets = new NativeMethods.Ns3FctBucket[bucketCount];
+        var values = new double[bucketCount * quantileArray.Length];
+
+        NativeMethods.Ns3Status status;
+        fixed (double* quantilePtr = quantileArray)
+        fixed (NativeMethods.Ns3FctBucket* bucketPtr = buckets)
+        fixed (double* valuePtr = values)
+        {
+            status = _simulation.Interop.FctDistribution(_simulation.Handle, _handle, quantilePtr,
+                (uint)quantileArray.Length, bucketPtr, valuePtr, (uint)bucketCount, out _);
+        }
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetDistribution));
+
+        var matrix = new double[bucketCount, quantileArray.Length];
+        for (int b = 0; b < bucketCount; b++)
+            for (int q = 0; q < quantileArray.Length; q++)
+                matrix[b, q] = values[b * quantileArray.Length + q];
+        var summaries = Array.ConvertAll(buckets, b => new FctBucket(
+            b.MaxBytes > long.MaxValue ? long.MaxValue : (long)b.MaxBytes, (long)b.Flows, b.MinSec, b.MeanSec, b.MaxSec));
+        return new FctDistribution(quantileArray, summaries, matrix);
+    }
+}
@@ -0,0 +1,243 @@
+// FlowEpochs.cs
+// High-level API for periodic FlowMonitor snapshots
+//
+// The native side copies every flow's cumulative counters into a
+// preallocated ring once per epoch, without calling back into managed code;
+// the retained epochs are fetched as [epoch x flow] matrices in one export.
+
+using System.Runtime.InteropServices;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// Retained epochs of a <see cref="FlowEpochs"/>, oldest first
+/// </summary>
+/// <remarks>
+/// Matrices are indexed [epoch, flow]; flow column i is FlowMonitor flow id
+/// i + 1. Counters are cumulative since the monitor was installed, so
+/// per-epoch values are differences of consecutive rows.
+/// </remarks>
+/// <param name="FirstEpoch">Epoch number of row 0 (epoch k is taken k periods after the start)</param>
+/// <param name="Period">Snapshot period</param>
+/// <param name="Times">Simulation time of each row</param>
+/// <param name="DroppedFlows">Flows with ids beyond the configured maximum, not recorded</param>
+/// <param name="TxPackets">Transmitted packets</param>
+/// <param name="RxPackets">Received packets</param>
+/// <param name="TxBytes">Transmitted bytes</param>
+/// <param name="RxBytes">Received bytes</param>
+/// <param name="LostPackets">Lost packets, as of FlowMonitor's latest periodic loss check</param>
+/// <param name="DelaySumSeconds">Sum of end-to-end delays of received packets</param>
+/// <param name="JitterSumSeconds">Sum of delay variations of received packets</param>
+public sealed record FlowEpochReport(
+    long FirstEpoch,
+    TimeSpan Period,
+    TimeSpan[] Times,
+    long DroppedFlows,
+    long[,] TxPackets,
+    long[,] RxPackets,
+    long[,] TxBytes,
+    long[,] RxBytes,
+    long[,] LostPackets,
+    double[,] DelaySumSeconds,
+    double[,] JitterSumSeconds)
+{
+    /// <summary>Number of rows</summary>
+    public int EpochCount => Times.Length;
+
+    /// <summary>Number of flow columns</summary>
+    public int FlowCount => TxPackets.GetLength(1);
+
+    /// <summary>
+    /// FlowMonitor flow id of a column
+    /// </summary>
+    public static uint FlowId(int flow) => (uint)flow + 1;
+
+    /// <summary>
+    /// Receive rate of a flow over the epoch ending at a row (row &gt;= 1), in bits per second
+    /// </summary>
+    public double RxBitsPerSecond(int row, int flow)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(row);
+        return (RxBytes[row, flow] - RxBytes[row - 1, flow]) * 8.0 / (Times[row] - Times[row - 1]).TotalSeconds;
+    }
+
+    /// <summary>
+    /// Mean delay of the packets a flow received during the epoch ending at a
+    /// row (row &gt;= 1), or null if it received none
+    /// </summary>
+    public TimeSpan? MeanDelay(int row, int flow)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(row);
+        long received = RxPackets[row, flow] - RxPackets[row - 1, flow];
+        if (received <= 0) return null;
+        return TimeSpan.FromSeconds((DelaySumSeconds[row, flow] - DelaySumSeconds[row - 1, flow]) / received);
+    }
+}
+
+/// <summary>
+/// Periodic per-flow snapshots of a <see cref="FlowMonitor"/>
+/// </summary>
+/// <remarks>
+/// Memory is epochCapacity x maxFlows cells per counter however long the
+/// run; with a file path every epoch is also streamed to disk. Like
+/// FlowMonitor itself, the periodic snapshot needs <see cref="Simulation.Stop(TimeSpan)"/>
+/// to end the run.
+/// </remarks>
+public sealed class FlowEpochs
+{
+    /// <summary>Epochs kept in memory when none is given</summary>
+    public const int DefaultEpochCapacity = 1024;
+
+    /// <summary>Flow columns per epoch when none is given</summary>
+    public const int DefaultMaxFlows = 256;
+
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+    private bool _stopped;
+
+    private FlowEpochs(Simulation simulation, nint handle, TimeSpan period, int epochCapacity, int maxFlows, string? path)
+    {
+        _simulation = simulation;
+        _handle = handle;
+        Period = period;
+        EpochCapacity = epochCapacity;
+        MaxFlows = maxFlows;
+        Path = path;
+    }
+
+    /// <summary>Snapshot period</summary>
+    public TimeSpan Period { get; }
+
+    /// <summary>Most recent epochs kept in memory</summary>
+    public int EpochCapacity { get; }
+
+    /// <summary>Flow columns per epoch; flows with higher ids are counted in <see cref="FlowEpochReport.DroppedFlows"/></summary>
+    public int MaxFlows { get; }
+
+    /// <summary>File every epoch is appended to, if any</summary>
+    public string? Path { get; }
+
+    /// <summary>
+    /// Starts snapshotting a flow monitor every period, beginning one period from now
+    /// </summary>
+    /// <param name="monitor">Flow monitor to snapshot</param>
+    /// <param name="period">Snapshot period</param>
+    /// <param name="epochCapacity">Epochs kept in memory (null = <see cref="DefaultEpochCapacity"/>)</param>
+    /// <param name="maxFlows">Flow columns per epoch (null = <see cref="DefaultMaxFlows"/>)</param>
+    /// <param name="path">If given, every epoch is also appended to this file</param>
+    public static unsafe FlowEpochs Start(FlowMonitor monitor, TimeSpan period, int? epochCapacity = null,
+        int? maxFlows = null, string? path = null)
+    {
+        ArgumentNullException.ThrowIfNull(monitor);
+        if (period <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(period), "Period must be positive");
+        if (epochCapacity is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(epochCapacity), epochCapacity, "epochCapacity must be positive");
+        if (maxFlows is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(maxFlows), maxFlows, "maxFlows must be positive");
+
+        var simulation = monitor.Simulation;
+        nint pathPtr = path != null ? Marshal.StringToCoTaskMemUTF8(path) : 0;
+        try
+        {
+            var options = new NativeMethods.Ns3FlowEpochOptions
+            {
+                EpochSec = period.TotalSeconds,
+                EpochCapacity = (uint)(epochCapacity ?? 0),
+                MaxFlows = (uint)(maxFlows ?? 0),
+                Path = pathPtr,
+            };
+            var status = simulation.Interop.FlowEpochsStart(simulation.Handle, monitor.NativeHandle, &options, out nint handle);
+            Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Start));
+            return new FlowEpochs(simulation, handle, period, epochCapacity ?? DefaultEpochCapacity,
+                maxFlows ?? DefaultMaxFlows, path);
+        }
+        finally
+        {
+            if (pathPtr != 0) Marshal.FreeCoTaskMem(pathPtr);
+        }
+    }
+
+    /// <summary>
+    /// Copies the retained epochs (not while the simulation runs on another thread)
+    /// </summary>
+    public unsafe FlowEpochReport Export()
+    {
+        var status = _simulation.Interop.FlowEpochsExport(_simulation.Handle, _handle, null, out var info);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Export));
+
+        int epochs = (int)info.EpochCount;
+        int flows = (int)info.FlowCount;
+        var times = new double[epochs];
+        var txPackets = new long[epochs, flows];
+        var rxPackets = new long[epochs, flows];
+        var txBytes = new long[epochs, flows];
+        var rxBytes = new long[epochs, flows];
+        var lostPackets = new long[epochs, flows];
+        var delaySum = new double[epochs, flows];
+        var jitterSum = new double[epochs, flows];
+
+        fixed (double* timePtr = times)
+        fixed (long* txPacketsPtr = txPackets)
+        fixed (long* rxPacketsPtr = rxPackets)
+        fixed (long* txBytesPtr = txBytes)
+        fixed (long* rxBytesPtr = rxBytes)
+        fixed (long* lostPtr = lostPackets)
+        fixed (double* delayPtr = delaySum)
+        fixed (double* jitterPtr = jitterSum)
+        {
+            var columns = new NativeMethods.Ns3FlowEpochColumns
+            {
+                TimeSec = timePtr,
+                TxPackets = (ulong*)txPacketsPtr,
+                RxPackets = (ulong*)rxPacketsPtr,
+                TxBytes = (ulong*)txBytesPtr,
+                RxBytes = (ulong*)rxBytesPtr,
+                LostPackets = (ulong*)lostPtr,
+                DelaySumSec = delayPtr,
+                JitterSumSec = jitterPtr,
+                Capacity = (uint)(epochs * flows),
+            };
+            status = _simulation.Interop.FlowEpochsExport(_simulation.Handle, _handle, &columns, out info);
+        }
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Export));
+
+        return new FlowEpochReport((long)info.FirstEpoch, TimeSpan.FromSeconds(info.EpochSec),
+            Array.ConvertAll(times, TimeSpan.FromSeconds), (long)info.DroppedFlows,
+            txPackets, rxPackets, txBytes, rxBytes, lostPackets, delaySum, jitterSum);
+    }
+
+    /// <summary>
+    /// Estimated quantiles of per-flow metrics over one epoch: the counter
+    /// differences between it and the previous epoch, both still retained
+    /// </summary>
+    /// <param name="metrics">Metrics to summarise (<see cref="FlowMetric.CompletionTime"/> is not available per epoch)</param>
+    /// <param name="quantiles">Quantiles in [0, 1]</param>
+    /// <param name="epoch">Epoch number (null = the latest)</param>
+    /// <param name="compression">t-digest compression (null = <see cref="FlowQuantiles.DefaultCompression"/>)</param>
+    public unsafe FlowQuantiles GetQuantiles(IReadOnlyList<FlowMetric> metrics, IReadOnlyList<double> quantiles,
+        long? epoch = null, double? compression = null)
+    {
+        if (epoch is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(epoch), epoch, "epoch must be positive");
+
+        return FlowQuantiles.Query(_simulation, nameof(GetQuantiles), metrics, quantiles, compression,
+            (m, mc, q, qc, c, values, counts) =>
+                _simulation.Interop.FlowEpochsQuantiles(_simulation.Handle, _handle, (ulong)(epoch ?? 0), m, mc, q, qc, c,
+                    values, counts));
+    }
+
+    /// <summary>
+    /// Stops taking snapshots and completes the file; <see cref="Export"/> keeps working
+    /// </summary>
+    public void Stop()
+    {
+        if (_stopped)
+            throw new InvalidOperationException("Flow epochs are already stopped");
+
+        var status = _simulation.Interop.FlowEpochsStop(_simulation.Handle, _handle);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Stop));
+        _stopped = true;
+    }
+}
@@ -0,0 +1,111 @@
+// FlowQuantiles.cs
+// Quantiles of per-flow metrics, estimated natively
+//
+// Each metric is computed per flow inside the shim and streamed into a
+// t-digest, so reports over hundreds of thousands of flows cost one call and
+// a [metric x quantile] result instead of copying and sorting every flow.
+
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// Per-flow metric summarised by <see cref="FlowMonitor.GetQuantiles"/>
+/// </summary>
+/// <remarks>
+/// A flow contributes only where the metric is defined: rate, delay and
+/// jitter need received packets, loss needs transmitted ones.
+/// </remarks>
+public enum FlowMetric
+{
+    /// <summary>Received bits per second, from first transmission to last reception (per epoch: over the epoch)</summary>
+    Throughput = 0,
+    /// <summary>Flow completion time in seconds: last reception minus first transmission (not available per epoch)</summary>
+    CompletionTime = 1,
+    /// <summary>Mean one-way delay in seconds</summary>
+    MeanDelay = 2,
+    /// <summary>Mean delay variation in seconds</summary>
+    MeanJitter = 3,
+    /// <summary>Lost packets over transmitted packets</summary>
+    LossRatio = 4,
+}
+
+/// <summary>
+/// Estimated quantiles of per-flow metrics
+/// </summary>
+/// <param name="Metrics">Matrix rows</param>
+/// <param name="Quantiles">Matrix columns</param>
+/// <param name="Values">Estimates indexed [metric, quantile]; 0 for metrics without flows</param>
+/// <param name="FlowCounts">Flows contributing to each metric</param>
+public sealed record FlowQuantiles(IReadOnlyList<FlowMetric> Metrics, IReadOnlyList<double> Quantiles, double[,] Values,
+    long[] FlowCounts)
+{
+    /// <summary>t-digest compression when none is given</summary>
+    public const double DefaultCompression = 100;
+
+    /// <summary>
+    /// Estimate of one metric at one of the requested quantiles
+    /// </summary>
+    public double Get(FlowMetric metric, double quantile)
+    {
+        int row = IndexOf(Metrics, metric, nameof(metric));
+        int column = IndexOf(Quantiles, quantile, nameof(quantile));
+        return Values[row, column];
+    }
+
+    /// <summary>
+    /// Number of flows contributing to a metric
+    /// </summary>
+    public long FlowCount(FlowMetric metric) => FlowCounts[IndexOf(Metrics, metric, nameof(metric))];
+
+    private static int IndexOf<T>(IReadOnlyList<T> items, T item, string paramName)
+    {
+        for (int i = 0; i < items.Count; i++)
+            if (EqualityComparer<T>.Default.Equals(items[i], item))
+                return i;
+        throw new ArgumentException($"{item} was not requested", paramName);
+    }
+
+    internal unsafe delegate NativeMethods.Ns3Status NativeQuery(NativeMethods.Ns3FlowMetric* metrics, uint metricCount,
+        double* quantiles, uint quantileCount, double compression, double* outValues, ulong* outFlowCounts);
+
+    internal static unsafe FlowQuantiles Query(Simulation simulation, string caller, IReadOnlyList<FlowMetric> metrics,
+        IReadOnlyList<double> quantiles, double? compression, NativeQuery query)
+    {
+        ArgumentNullException.ThrowIfNull(metrics);
+        ArgumentNullException.ThrowIfNull(quantiles);
+        if (metrics.Count == 0)
+            throw new ArgumentException("At least one metric required", nameof(metrics));
+        if (quantiles.Count == 0)
+            throw new ArgumentException("At least one quantile required", nameof(quantiles));
+        foreach (double q in quantiles)
+            if (q is < 0 or > 1 || double.IsNaN(q))
+                throw new ArgumentOutOfRangeException(nameof(quantiles), q, "Quantiles must be in [0, 1]");
+        if (compression is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(compression), compression, "compression must be positive");
+
+        var nativeMetrics = new NativeMethods.Ns3FlowMetric[metrics.Count];
+        for (int i = 0; i < nativeMetrics.Length; i++)
+            nativeMetrics[i] = (NativeMethods.Ns3FlowMetric)metrics[i];
+        var quantileArray = quantiles.ToArray();
+        var values = new double[metrics.Count * quantileArray.Length];
+        var counts = new ulong[metrics.Count];
+
+        NativeMethods.Ns3Status status;
+        fixed (NativeMethods.Ns3FlowMetric* metricPtr = nativeMetrics)
+        fixed (double* quantilePtr = quantileArray)
+        fixed (double* valuePtr = values)
+        fixed (ulong* countPtr = counts)
+        {
+            status = query(metricPtr, (uint)nativeMetrics.Length, quantilePtr, (uint)quantileArray.Length,
+                compression ?? 0, valuePtr, countPtr);
+        }
+        Ns3Exception.ThrowIfError(status, simulation.Handle, caller);
+
+        var matrix = new double[metrics.Count, quantileArray.Length];
+        for (int m = 0; m < metrics.Count; m++)
+            for (int q = 0; q < quantileArray.Length; q++)
+                matrix[m, q] = values[m * quantileArray.Length + q];
+        return new FlowQuantiles(metrics.ToArray(), quantileArray, matrix, Array.ConvertAll(counts, c => (long)c));
+    }
+}
@@ -18,6 +18,7 @@ internal interface INativeInterop
 
     // Simulation Lifecycle
     NativeMethods.Ns3Status SimCreate(out nint outSim);
+    unsafe NativeMethods.Ns3Status SimCreateEx(out nint outSim, NativeMethods.Ns3SimOptions* options);
     NativeMethods.Ns3Status SimSetSeed(nint sim, uint seed);
     NativeMethods.Ns3Status SimRun(nint sim);
     NativeMethods.Ns3Status SimStop(nint sim, double atTimeSec);
@@ -29,6 +30,12 @@ internal interface INativeInterop
     // Nodes & Topology
     unsafe NativeMethods.Ns3Status NodesCreate(nint sim, uint count, nint* outArray);
     unsafe NativeMethods.Ns3Status InternetInstall(nint sim, nint* nodes, uint count);
+    unsafe NativeMethods.Ns3Status NodesCreateEx(nint sim, uint count, uint* systemIds, nint* outArray);
+    NativeMethods.Ns3Status NodeGetSystemId(nint sim, nint node, out uint outSystemId, out int outIsLocal);
+
+    // Distributed Execution
+    NativeMethods.Ns3Status SimGetRank(nint sim, out uint outRank, out uint outRankCount);
+    unsafe NativeMethods.Ns3Status PartitionNodes(nint sim, uint nodeCount, NativeMethods.Ns3PartitionEdge* edges, uint edgeCount, uint rankCount, double minLookaheadSec, uint* outSystemIds, NativeMethods.Ns3PartitionStats* outStats);
 
     // Network Devices
     NativeMethods.Ns3Status P2PInstall(nint sim, nint a, nint b, string dataRate, string delay, uint mtu, out nint outDevA, out nint outDevB);
@@ -45,14 +52,69 @@ internal interface INativeInterop
     // Applications
     NativeMethods.Ns3Status AppUdpEchoServer(nint sim, nint node, ushort port, out nint outApp);
     NativeMethods.Ns3Status AppUdpEchoClient(nint sim, nint node, string dstIp, ushort port, uint packetSize, double intervalSec, uint maxPackets, out nint outApp);
+    unsafe NativeMethods.Ns3Status AppTrafficGen(nint sim, nint node, string dstIp, ushort port, NativeMethods.Ns3TrafficGenOptions* options, out nint outApp);
+    unsafe NativeMethods.Ns3Status AppPcapReplay(nint sim, nint node, string path, string dstIp, ushort port, NativeMethods.Ns3PcapReplayOptions* options, out nint outApp);
+    NativeMethods.Ns3Status AppPcapReplayStats(nint sim, nint app, out NativeMethods.Ns3PcapReplayStats outStats);
+    unsafe NativeMethods.Ns3Status AppInstallBulk(nint sim, nint* nodes, uint nodeCount, NativeMethods.Ns3AppSpec* specs, uint count, nint* outApps);
     NativeMethods.Ns3Status AppStart(nint sim, nint app, double atTimeSec);
     NativeMethods.Ns3Status AppStop(nint sim, nint app, double atTimeSec);
+    unsafe NativeMethods.Ns3Status WorkloadOpen(nint sim, string path, nint* nodes, uint nodeCount, NativeMethods.Ns3WorkloadOptions* options, out nint outWorkload);
+    NativeMethods.Ns3Status WorkloadStats(nint sim, nint workload, out NativeMethods.Ns3WorkloadStats outStats);
 
     // Tracing & Statistics
-    NativeMethods.Ns3Status TraceSubscribePacketEvents(nint sim, nint dev, NativeMethods.PacketCallback? onTx, NativeMethods.PacketCallback? onRx, nint user);
+    NativeMethods.Ns3Status TraceSubscribePacketEvents(nint sim, nint dev, NativeMethods.PacketCallback? onTx, NativeMethods.PacketCallback? onRx, nint user, out nint outSub);
+    NativeMethods.Ns3Status TraceSubscribePacketEventsEx(nint sim, nint dev, NativeMethods.PacketCallbackEx? onTx, NativeMethods.PacketCallbackEx? onRx, nint user, out nint outSub);
+    NativeMethods.Ns3Status TraceUnsubscribe(nint sim, nint sub);
+    NativeMethods.Ns3Status TraceGetStats(nint sim, out NativeMethods.Ns3TraceStats outStats);
+    unsafe NativeMethods.Ns3Status TraceSetFilter(nint sim, nint dev, NativeMethods.Ns3TraceFilter* filter);
+    NativeMethods.Ns3Status EventSinkOpen(nint sim, NativeMethods.EventBatchCallback onBatch, nint user, uint batchCapacity);
+    NativeMethods.Ns3Status EventSinkEnable(nint sim, nint dev, uint eventMask, out uint outSlot);
+    NativeMethods.Ns3Status EventSinkFlush(nint sim);
+    NativeMethods.Ns3Status EventSinkClose(nint sim);
     NativeMethods.Ns3Status PcapEnable(nint sim, nint dev, string filePrefix);
+    unsafe NativeMethods.Ns3Status PcapEnableEx(nint sim, nint dev, string filePrefix, NativeMethods.Ns3PcapOptions* options);
+    unsafe NativeMethods.Ns3Status CaptureRingOpen(nint sim, string name, NativeMethods.Ns3CaptureRingOptions* options, out nint outRing);
+    NativeMethods.Ns3Status CaptureRingAttach(nint sim, nint ring, nint dev);
+    NativeMethods.Ns3Status CaptureRingGetStats(nint sim, nint ring, out NativeMethods.Ns3CaptureRingStats outStats);
+    NativeMethods.Ns3Status CaptureRingClose(nint sim, nint ring);
+    NativeMethods.Ns3Status TraceFileOpen(nint sim, string path, uint flags, out nint outFile);
+    NativeMethods.Ns3Status TraceFileAttach(nint sim, nint file, nint dev);
+    NativeMethods.Ns3Status TraceFileClose(nint sim, nint file, out ulong outRecordCount);
+    NativeMethods.Ns3Status ThroughputCreate(nint sim, double binWidthSec, uint windowBins, out nint outThroughput);
+    NativeMethods.Ns3Status ThroughputAttach(nint sim, nint tp, nint dev);
+    unsafe NativeMethods.Ns3Status ThroughputExport(nint sim, nint tp, nint* outDevices, uint deviceCapacity, NativeMethods.Ns3BinCounts* outMatrix, uint matrixCapacity, out NativeMethods.Ns3ThroughputInfo outInfo);
     NativeMethods.Ns3Status FlowMonInstallAll(nint sim, out nint outFlowMon);
+    unsafe NativeMethods.Ns3Status FlowMonInstall(nint sim, nint* nodes, uint count, NativeMethods.Ns3FlowMonOptions* options, out nint outFlowMon, out uint outProbedNodes);
     NativeMethods.Ns3Status FlowMonCollect(nint sim, nint fm, out NativeMethods.Ns3FlowStats outStats);
+    unsafe NativeMethods.Ns3Status FlowEpochsStart(nint sim, nint fm, NativeMethods.Ns3FlowEpochOptions* options, out nint outEpochs);
+    unsafe NativeMethods.Ns3Status FlowEpochsExport(nint sim, nint epochs, NativeMethods.Ns3FlowEpochColumns* columns, out NativeMethods.Ns3FlowEpochsInfo outInfo);
+    NativeMethods.Ns3Status FlowEpochsStop(nint sim, nint epochs);
+    unsafe NativeMethods.Ns3Status FlowMonHistogram(nint sim, nint fm, NativeMethods.Ns3FlowHistKind kind, uint* flowIds, uint flowCount, ulong* outCounts, uint capacity, out double outBinWidth, out uint outBinCount);
+    unsafe NativeMethods.Ns3Status FlowMonQuantiles(nint sim, nint fm, NativeMethods.Ns3FlowMetric* metrics, uint metricCount, double* quantiles, uint quantileCount, double compression, double* outValues, ulong* outFlowCounts);
+    unsafe NativeMethods.Ns3Status FlowEpochsQuantiles(nint sim, nint epochs, ulong epoch, NativeMethods.Ns3FlowMetric* metrics, uint metricCount, double* quantiles, uint quantileCount, double compression, double* outValues, ulong* outFlowCounts);
+    NativeMethods.Ns3Status LatencyInstallAll(nint sim, uint precisionBits, out nint outLatency);
+    unsafe NativeMethods.Ns3Status LatencyFlows(nint sim, nint lat, NativeMethods.Ns3LatencyFlow* outFlows, uint capacity, out uint outCount);
+    unsafe NativeMethods.Ns3Status LatencyPercentiles(nint sim, nint lat, uint flowIndex, double* quantiles, uint count, double* outSec);
+    unsafe NativeMethods.Ns3Status LatencyBuckets(nint sim, nint lat, uint flowIndex, ulong* outCounts, double* outLowerSec, uint capacity, out uint outBucketCount);
+    unsafe NativeMethods.Ns3Status FctInstallAll(nint sim, NativeMethods.Ns3FctOptions* options, out nint outFct);
+    unsafe NativeMethods.Ns3Status FctFlows(nint sim, nint fct, NativeMethods.Ns3FctFlow* outFlows, uint capacity, out uint outCount);
+    unsafe NativeMethods.Ns3Status FctDistribution(nint sim, nint fct, double* quantiles, uint quantileCount, NativeMethods.Ns3FctBucket* outBuckets, double* outQuantileSec, uint capacity, out uint outBucketCount);
+    NativeMethods.Ns3Status QueueMonitorCreate(nint sim, double binWidthSec, uint windowBins, NativeMethods.QueueEventCallback? onEvent, nint user, out nint outMonitor);
+    NativeMethods.Ns3Status QueueMonitorAttach(nint sim, nint qm, nint dev);
+    unsafe NativeMethods.Ns3Status QueueMonitorExport(nint sim, nint qm, nint* outDevices, NativeMethods.Ns3QueueCounters* outCounters, uint deviceCapacity, NativeMethods.Ns3QueueBin* outMatrix, uint matrixCapacity, out NativeMethods.Ns3ThroughputInfo outInfo);
+
+    // TCP Bulk Transfers
+    unsafe NativeMethods.Ns3Status TcpBulkInstall(nint sim, nint* nodes, uint nodeCount, NativeMethods.Ns3TcpFlowSpec* specs, uint count, NativeMethods.Ns3TcpBulkOptions* options, nint* outSenders, out nint outBulk);
+    unsafe NativeMethods.Ns3Status TcpBulkExport(nint sim, nint bulk, NativeMethods.Ns3TcpFlowStats* outStats, uint flowCapacity, NativeMethods.Ns3TcpBin* outMatrix, uint matrixCapacity, out NativeMethods.Ns3ThroughputInfo outInfo);
+
+    // Parameter Sweeps
+    unsafe NativeMethods.Ns3Status SimSweepRun(nint sim, NativeMethods.Ns3SweepConfig* config, NativeMethods.Ns3SweepPointSummary* outSummaries, uint capacity);
+    unsafe NativeMethods.Ns3Status SimForkRuns(nint sim, ulong* runs, uint count, nint fm, double stopTimeSec, uint maxParallel, NativeMethods.Ns3ForkRunResult* outResults);
+
+    // Call Journal
+    NativeMethods.Ns3Status JournalOpen(string path);
+    NativeMethods.Ns3Status JournalClose();
+    NativeMethods.Ns3Status JournalLastError(Span<byte> buf);
 
     // Configuration
     NativeMethods.Ns3Status ConfigSet(nint sim, string path, string attrName, NativeMethods.Ns3Attr value);
@@ -26,6 +26,9 @@ internal sealed class NativeInterop : INativeInterop
     public NativeMethods.Ns3Status SimCreate(out nint outSim) =>
         NativeMethods.sim_create(out outSim);
 
+    public unsafe NativeMethods.Ns3Status SimCreateEx(out nint outSim, NativeMethods.Ns3SimOptions* options) =>
+        NativeMethods.sim_create_ex(out outSim, options);
+
     public NativeMethods.Ns3Status SimSetSeed(nint sim, uint seed) =>
         NativeMethods.sim_set_seed(sim, seed);
 
@@ -53,6 +56,18 @@ internal sealed class NativeInterop : INativeInterop
     public unsafe NativeMethods.Ns3Status InternetInstall(nint sim, nint* nodes, uint count) =>
         NativeMethods.internet_install(sim, nodes, count);
 
+    public unsafe NativeMethods.Ns3Status NodesCreateEx(nint sim, uint count, uint* systemIds, nint* outArray) =>
+        NativeMethods.nodes_create_ex(sim, count, systemIds, outArray);
+
+    public NativeMethods.Ns3Status NodeGetSystemId(nint sim, nint node, out uint outSystemId, out int outIsLocal) =>
+        NativeMethods.node_get_system_id(sim, node, out outSystemId, out outIsLocal);
+
+    public NativeMethods.Ns3Status SimGetRank(nint sim, out uint outRank, out uint outRankCount) =>
+        NativeMethods.sim_get_rank(sim, out outRank, out outRankCount);
+
+    public unsafe NativeMethods.Ns3Status PartitionNodes(nint sim, uint nodeCount, NativeMethods.Ns3PartitionEdge* edges, uint edgeCount, uint rankCount, double minLookaheadSec, uint* outSystemIds, NativeMethods.Ns3PartitionStats* outStats) =>
+        NativeMethods.partition_nodes(sim, nodeCount, edges, edgeCount, rankCount, minLookaheadSec, outSystemIds, outStats);
+
     public NativeMethods.Ns3Status P2PInstall(nint sim, nint a, nint b, string dataRate, string delay, uint mtu, out nint outDevA, out nint outDevB) =>
         NativeMethods.p2p_install(sim, a, b, dataRate, delay, mtu, out outDevA, out outDevB);
 
@@ -77,24 +92,176 @@ internal sealed class NativeInterop : INativeInterop
     public NativeMethods.Ns3Status AppUdpEchoClient(nint sim, nint node, string dstIp, ushort port, uint packetSize, double intervalSec, uint maxPackets, out nint outApp) =>
         NativeMethods.app_udpecho_client(sim, node, dstIp, port, packetSize, intervalSec, maxPackets, out outApp);
 
+    public unsafe NativeMethods.Ns3Status AppTrafficGen(nint sim, nint node, string dstIp, ushort port, NativeMethods.Ns3TrafficGenOptions* options, out nint outApp) =>
+        NativeMethods.app_traffic_gen(sim, node, dstIp, port, options, out outApp);
+
+    public unsafe NativeMethods.Ns3Status AppPcapReplay(nint sim, nint node, string path, string dstIp, ushort port, NativeMethods.Ns3PcapReplayOptions* options, out nint outApp) =>
+        NativeMethods.app_pcap_replay(sim, node, path, dstIp, port, options, out outApp);
+
+    public NativeMethods.Ns3Status AppPcapReplayStats(nint sim, nint app, out NativeMethods.Ns3PcapReplayStats outStats) =>
+        NativeMethods.app_pcap_replay_stats(sim, app, out outStats);
+
+    public unsafe NativeMethods.Ns3Status AppInstallBulk(nint sim, nint* nodes, uint nodeCount, NativeMethods.Ns3AppSpec* specs, uint count, nint* outApps) =>
+        NativeMethods.app_install_bulk(sim, nodes, nodeCount, specs, count, outApps);
+
     public NativeMethods.Ns3Status AppStart(nint sim, nint app, double atTimeSec) =>
         NativeMethods.app_start(sim, app, atTimeSec);
 
     public NativeMethods.Ns3Status AppStop(nint sim, nint app, double atTimeSec) =>
         NativeMethods.app_stop(sim, app, atTimeSec);
 
-    public NativeMethods.Ns3Status TraceSubscribePacketEvents(nint sim, nint dev, NativeMethods.PacketCallback? onTx, NativeMethods.PacketCallback? onRx, nint user) =>
-        NativeMethods.trace_subscribe_packet_events(sim, dev, onTx, onRx, user);
+    public unsafe NativeMethods.Ns3Status WorkloadOpen(nint sim, string path, nint* nodes, uint nodeCount, NativeMethods.Ns3WorkloadOptions* options, out nint outWorkload) =>
+        NativeMethods.workload_open(sim, path, nodes, nodeCount, options, out outWorkload);
+
+    public NativeMethods.Ns3Status WorkloadStats(nint sim, nint workload, out NativeMethods.Ns3WorkloadStats outStats) =>
+        NativeMethods.workload_stats(sim, workload, out outStats);
+
+    public NativeMethods.Ns3Status TraceSubscribePacketEvents(nint sim, nint dev, NativeMethods.PacketCallback? onTx, NativeMethods.PacketCallback? onRx, nint user, out nint outSub) =>
+        NativeMethods.trace_subscribe_packet_events_handle(sim, dev, onTx, onRx, user, out outSub);
+
+    public NativeMethods.Ns3Status TraceSubscribePacketEventsEx(nint sim, nint dev, NativeMethods.PacketCallbackEx? onTx, NativeMethods.PacketCallbackEx? onRx, nint user, out nint outSub) =>
+        NativeMethods.trace_subscribe_packet_events_ex_handle(sim, dev, onTx, onRx, user, out outSub);
+
+    public NativeMethods.Ns3Status TraceUnsubscribe(nint sim, nint sub) =>
+        NativeMethods.trace_unsubscribe(sim, sub);
+
+    public NativeMethods.Ns3Status TraceGetStats(nint sim, out NativeMethods.Ns3TraceStats outStats) =>
+        NativeMethods.trace_get_stats(sim, out outStats);
+
+    public unsafe NativeMethods.Ns3Status TraceSetFilter(nint sim, nint dev, NativeMethods.Ns3TraceFilter* filter) =>
+        NativeMethods.trace_set_filter(sim, dev, filter);
+
+    public NativeMethods.Ns3Status EventSinkOpen(nint sim, NativeMethods.EventBatchCallback onBatch, nint user, uint batchCapacity) =>
+        NativeMethods.event_sink_open(sim, onBatch, user, batchCapacity);
+
+    public NativeMethods.Ns3Status EventSinkEnable(nint sim, nint dev, uint eventMask, out uint outSlot) =>
+        NativeMethods.event_sink_enable(sim, dev, eventMask, out outSlot);
+
+    public NativeMethods.Ns3Status EventSinkFlush(nint sim) =>
+        NativeMethods.event_sink_flush(sim);
+
+    public NativeMethods.Ns3Status EventSinkClose(nint sim) =>
+        NativeMethods.event_sink_close(sim);
+
+    public unsafe NativeMethods.Ns3Status PcapEnableEx(nint sim, nint dev, string filePrefix, NativeMethods.Ns3PcapOptions* options) =>
+        NativeMethods.pcap_enable_ex(sim, dev, filePrefix, options);
 
     public NativeMethods.Ns3Status PcapEnable(nint sim, nint dev, string filePrefix) =>
         NativeMethods.pcap_enable(sim, dev, filePrefix);
 
+    public unsafe NativeMethods.Ns3Status CaptureRingOpen(nint sim, string name, NativeMethods.Ns3CaptureRingOptions* options, out nint outRing) =>
+        NativeMethods.capture_ring_open(sim, name, options, out outRing);
+
+    public NativeMethods.Ns3Status CaptureRingAttach(nint sim, nint ring, nint dev) =>
+        NativeMethods.capture_ring_attach(sim, ring, dev);
+
+    public NativeMethods.Ns3Status CaptureRingGetStats(nint sim, nint ring, out NativeMethods.Ns3CaptureRingStats outStats) =>
+        NativeMethods.capture_ring_get_stats(sim, ring, out outStats);
+
+    public NativeMethods.Ns3Status CaptureRingClose(nint sim, nint ring) =>
+        NativeMethods.capture_ring_close(sim, ring);
+
+    public NativeMethods.Ns3Status TraceFileOpen(nint sim, string path, uint flags, out nint outFile) =>
+        NativeMethods.trace_file_open(sim, path, flags, out outFile);
+
+    public NativeMethods.Ns3Status TraceFileAttach(nint sim, nint file, nint dev) =>
+        NativeMethods.trace_file_attach(sim, file, dev);
+
+    public NativeMethods.Ns3Status TraceFileClose(nint sim, nint file, out ulong outRecordCount) =>
+        NativeMethods.trace_file_close(sim, file, out outRecordCount);
+
+    public NativeMethods.Ns3Status ThroughputCreate(nint sim, double binWidthSec, uint windowBins, out nint outThroughput) =>
+        NativeMethods.throughput_create(sim, binWidthSec, windowBins, out outThroughput);
+
+    public NativeMethods.Ns3Status ThroughputAttach(nint sim, nint tp, nint dev) =>
+        NativeMethods.throughput_attach(sim, tp, dev);
+
+    public unsafe NativeMethods.Ns3Status ThroughputExport(nint sim, nint tp, nint* outDevices, uint deviceCapacity, NativeMethods.Ns3BinCounts* outMatrix, uint matrixCapacity, out NativeMethods.Ns3ThroughputInfo outInfo) =>
+        NativeMethods.throughput_export(sim, tp, outDevices, deviceCapacity, outMatrix, matrixCapacity, out outInfo);
+
     public NativeMethods.Ns3Status FlowMonInstallAll(nint sim, out nint outFlowMon) =>
         NativeMethods.flowmon_install_all(sim, out outFlowMon);
 
+    public unsafe NativeMethods.Ns3Status FlowMonInstall(nint sim, nint* nodes, uint count, NativeMethods.Ns3FlowMonOptions* options, out nint outFlowMon, out uint outProbedNodes) =>
+        NativeMethods.flowmon_install(sim, nodes, count, options, out outFlowMon, out outProbedNodes);
+
     public NativeMethods.Ns3Status FlowMonCollect(nint sim, nint fm, out NativeMethods.Ns3FlowStats outStats) =>
         NativeMethods.flowmon_collect(sim, fm, out outStats);
 
+    public unsafe NativeMethods.Ns3Status FlowEpochsStart(nint sim, nint fm, NativeMethods.Ns3FlowEpochOptions* options, out nint outEpochs) =>
+        NativeMethods.flowmon_epochs_start(sim, fm, options, out outEpochs);
+
+    public unsafe NativeMethods.Ns3Status FlowEpochsExport(nint sim, nint epochs, NativeMethods.Ns3FlowEpochColumns* columns, out NativeMethods.Ns3FlowEpochsInfo outInfo) =>
+        NativeMethods.flowmon_epochs_export(sim, epochs, columns, out outInfo);
+
+    public NativeMethods.Ns3Status FlowEpochsStop(nint sim, nint epochs) =>
+        NativeMethods.flowmon_epochs_stop(sim, epochs);
+
+    public unsafe NativeMethods.Ns3Status FlowMonHistogram(nint sim, nint fm, NativeMethods.Ns3FlowHistKind kind, uint* flowIds, uint flowCount, ulong* outCounts, uint capacity, out double outBinWidth, out uint outBinCount) =>
+        NativeMethods.flowmon_histogram(sim, fm, kind, flowIds, flowCount, outCounts, capacity, out outBinWidth, out outBinCount);
+
+    public unsafe NativeMethods.Ns3Status FlowMonQuantiles(nint sim, nint fm, NativeMethods.Ns3FlowMetric* metrics, uint metricCount, double* quantiles, uint quantileCount, double compression, double* outValues, ulong* outFlowCounts) =>
+        NativeMethods.flowmon_quantiles(sim, fm, metrics, metricCount, quantiles, quantileCount, compression, outValues, outFlowCounts);
+
+    public unsafe NativeMethods.Ns3Status FlowEpochsQuantiles(nint sim, nint epochs, ulong epoch, NativeMethods.Ns3FlowMetric* metrics, uint metricCount, double* quantiles, uint quantileCount, double compression, double* outValues, ulong* outFlowCounts) =>
+        NativeMethods.flowmon_epochs_quantiles(sim, epochs, epoch, metrics, metricCount, quantiles, quantileCount, compression, outValues, outFlowCounts);
+
+    public NativeMethods.Ns3Status LatencyInstallAll(nint sim, uint precisionBits, out nint outLatency) =>
+        NativeMethods.latency_install_all(sim, precisionBits, out outLatency);
+
+    public unsafe NativeMethods.Ns3Status LatencyFlows(nint sim, nint lat, NativeMethods.Ns3LatencyFlow* outFlows, uint capacity, out uint outCount) =>
+        NativeMethods.latency_flows(sim, lat, outFlows, capacity, out outCount);
+
+    public unsafe NativeMethods.Ns3Status LatencyPercentiles(nint sim, nint lat, uint flowIndex, double* quantiles, uint count, double* outSec) =>
+        NativeMethods.latency_percentiles(sim, lat, flowIndex, quantiles, count, outSec);
+
+    public unsafe NativeMethods.Ns3Status LatencyBuckets(nint sim, nint lat, uint flowIndex, ulong* outCounts, double* outLowerSec, uint capacity, out uint outBucketCount) =>
+        NativeMethods.latency_buckets(sim, lat, flowIndex, outCounts, outLowerSec, capacity, out outBucketCount);
+
+    public unsafe NativeMethods.Ns3Status FctInstallAll(nint sim, NativeMethods.Ns3FctOptions* options, out nint outFct) =>
+        NativeMethods.fct_install_all(sim, options, out outFct);
+
+    public unsafe NativeMethods.Ns3Status FctFlows(nint sim, nint fct, NativeMethods.Ns3FctFlow* outFlows, uint capacity, out uint outCount) =>
+        NativeMethods.fct_flows(sim, fct, outFlows, capacity, out outCount);
+
+    public unsafe NativeMethods.Ns3Status FctDistribution(nint sim, nint fct, double* quantiles, uint quantileCount, NativeMethods.Ns3FctBucket* outBuckets, double* outQuantileSec, uint capacity, out uint outBucketCount) =>
+        NativeMethods.fct_distribution(sim, fct, quantiles, quantileCount, outBuckets, outQuantileSec, capacity, out outBucketCount);
+
+    public NativeMethods.Ns3Status QueueMonitorCreate(nint sim, double binWidthSec, uint windowBins, NativeMethods.QueueEventCallback? onEvent, nint user, out nint outMonitor) =>
+        NativeMethods.queue_monitor_create(sim, binWidthSec, windowBins, onEvent, user, out outMonitor);
+
+    public NativeMethods.Ns3Status QueueMonitorAttach(nint sim, nint qm, nint dev) =>
+        NativeMethods.queue_monitor_attach(sim, qm, dev);
+
+    public unsafe NativeMethods.Ns3Status QueueMonitorExport(nint sim, nint qm, nint* outDevices, NativeMethods.Ns3QueueCounters* outCounters, uint deviceCapacity, NativeMethods.Ns3QueueBin* outMatrix, uint matrixCapacity, out NativeMethods.Ns3ThroughputInfo outInfo) =>
+        NativeMethods.queue_monitor_export(sim, qm, outDevices, outCounters, deviceCapacity, outMatrix, matrixCapacity, out outInfo);
+
+    public unsafe NativeMethods.Ns3Status TcpBulkInstall(nint sim, nint* nodes, uint nodeCount, NativeMethods.Ns3TcpFlowSpec* specs, uint count, NativeMethods.Ns3TcpBulkOptions* options, nint* outSenders, out nint outBulk) =>
+        NativeMethods.tcp_bulk_install(sim, nodes, nodeCount, specs, count, options, outSenders, out outBulk);
+
+    public unsafe NativeMethods.Ns3Status TcpBulkExport(nint sim, nint bulk, NativeMethods.Ns3TcpFlowStats* outStats, uint flowCapacity, NativeMethods.Ns3TcpBin* outMatrix, uint matrixCapacity, out NativeMethods.Ns3ThroughputInfo outInfo) =>
+        NativeMethods.tcp_bulk_export(sim, bulk, outStats, flowCapacity, outMatrix, matrixCapacity, out outInfo);
+
+    public unsafe NativeMethods.Ns3Status SimSweepRun(nint sim, NativeMethods.Ns3SweepConfig* config, NativeMethods.Ns3SweepPointSummary* outSummaries, uint capacity) =>
+        NativeMethods.sim_sweep_run(sim, config, outSummaries, capacity);
+
+    public unsafe NativeMethods.Ns3Status SimForkRuns(nint sim, ulong* runs, uint count, nint fm, double stopTimeSec, uint maxParallel, NativeMethods.Ns3ForkRunResult* outResults) =>
+        NativeMethods.sim_fork_runs(sim, runs, count, fm, stopTimeSec, maxParallel, outResults);
+
+    public NativeMethods.Ns3Status JournalOpen(string path) =>
+        NativeMethods.journal_open(path);
+
+    public NativeMethods.Ns3Status JournalClose() =>
+        NativeMethods.journal_close();
+
+    public unsafe NativeMethods.Ns3Status JournalLastError(Span<byte> buf)
+    {
+        fixed (byte* ptr = buf)
+        {
+            return NativeMethods.journal_last_error(ptr, (nuint)buf.Length);
+        }
+    }
+
     public NativeMethods.Ns3Status ConfigSet(nint sim, string path, string attrName, NativeMethods.Ns3Attr value) =>
         NativeMethods.config_set(sim, path, attrName, value);
 }
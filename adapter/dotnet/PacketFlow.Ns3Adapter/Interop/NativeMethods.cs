@@ -39,6 +39,24 @@ internal static unsafe class NativeMethods
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     internal delegate void PacketCallback(nint user, ulong deviceId, double timeSec, uint bytes);
 
+    /// <summary>
+    /// Extended packet trace callback delegate; the event is valid only during the call
+    /// </summary>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate void PacketCallbackEx(nint user, Ns3PktEventEx* packetEvent);
+
+    /// <summary>
+    /// Queue event callback delegate; the event is valid only during the call
+    /// </summary>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate void QueueEventCallback(nint user, Ns3QueueEvent* queueEvent);
+
+    /// <summary>
+    /// Event sink batch callback delegate; the events are valid only during the call
+    /// </summary>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate void EventBatchCallback(nint user, Ns3Event* events, uint count);
+
     // ========================================================================
     // Enums
     // ========================================================================
@@ -49,6 +67,13 @@ internal static unsafe class NativeMethods
         Error = -1
     }
 
+    internal enum Ns3SimImpl : int
+    {
+        Default = 0,
+        Distributed = 1,
+        NullMessage = 2
+    }
+
     internal enum Ns3AttrKind : int
     {
         Bool = 0,
@@ -57,6 +82,22 @@ internal static unsafe class NativeMethods
         String = 3
     }
 
+    internal enum Ns3FlowHistKind : int
+    {
+        Delay = 0,
+        Jitter = 1,
+        PacketSize = 2
+    }
+
+    internal enum Ns3FlowMetric : int
+    {
+        Throughput = 0,
+        Fct = 1,
+        MeanDelay = 2,
+        MeanJitter = 3,
+        LossRatio = 4
+    }
+
     // ========================================================================
     // Structures
     // ========================================================================
@@ -85,6 +126,334 @@ internal static unsafe class NativeMethods
         public static Ns3Attr FromString(nint value) => new() { Kind = Ns3AttrKind.String, S = value };
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3SimOptions
+    {
+        public Ns3SimImpl Impl;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3PartitionEdge
+    {
+        public uint A;
+        public uint B;
+        public double DelaySec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3PartitionStats
+    {
+        public double LookaheadSec;
+        public double Imbalance;
+        public uint CutEdges;
+    }
+
+    internal const byte PktFlagIpv4 = 0x1;
+    internal const byte PktFlagPorts = 0x2;
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3PktEventEx
+    {
+        public ulong DeviceId;
+        public double TimeSec;
+        public ulong Uid;
+        public uint Size;
+        public uint SrcAddr;
+        public uint DstAddr;
+        public ushort SrcPort;
+        public ushort DstPort;
+        public byte Direction;
+        public byte Flags;
+        public byte Protocol;
+        public byte Ttl;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3TraceFilter
+    {
+        public uint MinSize;
+        public uint MaxSize;
+        public uint SrcAddr;
+        public uint SrcMask;
+        public uint DstAddr;
+        public uint DstMask;
+        public ushort SrcPortMin;
+        public ushort SrcPortMax;
+        public ushort DstPortMin;
+        public ushort DstPortMax;
+        public uint SampleEvery;
+        public byte Protocol;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3TraceStats
+    {
+        public uint Subscriptions;
+        public uint Contexts;
+        public uint ContextCapacity;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3PcapOptions
+    {
+        public uint BufferBytes;
+        public uint Snaplen;
+        public double FlushIntervalSec;
+        public uint Flags;
+        public uint Compression;
+        public int CompressionLevel;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Size = 32)]
+    internal struct Ns3Event
+    {
+        public double TimeSec;
+        public ulong Uid;
+        public uint Slot;
+        public uint Size;
+        public byte Type;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3CaptureRingOptions
+    {
+        public uint CapacityBytes;
+        public uint Snaplen;
+        public uint Flags;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3CaptureRingStats
+    {
+        public ulong Records;
+        public ulong Bytes;
+        public ulong Dropped;
+        public ulong Overwritten;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3BinCounts
+    {
+        public ulong TxBytes;
+        public ulong RxBytes;
+        public uint TxPackets;
+        public uint RxPackets;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3ThroughputInfo
+    {
+        public uint DeviceCount;
+        public uint BinCount;
+        public ulong FirstBin;
+        public double BinWidthSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3LatencyFlow
+    {
+        public uint SrcAddr;
+        public uint DstAddr;
+        public ushort SrcPort;
+        public ushort DstPort;
+        public byte Protocol;
+        public ulong Packets;
+        public double MinSec;
+        public double MaxSec;
+        public double MeanSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3TrafficGenOptions
+    {
+        public uint PacketSize;
+        public uint Pattern;
+        public double IntervalSec;
+        public uint Batch;
+        public uint Flags;
+        public ulong MaxPackets;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3PcapReplayOptions
+    {
+        public double TimeScale;
+        public ulong MaxPackets;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3PcapReplayStats
+    {
+        public ulong Records;
+        public ulong Skipped;
+        public ulong PacketsSent;
+        public ulong BytesSent;
+        public ulong Stalls;
+        public double CaptureSpanSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3AppSpec
+    {
+        public uint Kind;
+        public uint SrcNode;
+        public uint DstNode;
+        public uint DstAddr;
+        public ushort Port;
+        public ushort Protocol;
+        public uint PacketSize;
+        public double RateBps;
+        public ulong Size;
+        public double StartSec;
+        public double StopSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3WorkloadOptions
+    {
+        public ushort Port;
+        public uint SendSize;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3WorkloadStats
+    {
+        public ulong Records;
+        public ulong Started;
+        public ulong Completed;
+        public ulong Failed;
+        public ulong Skipped;
+        public uint Active;
+        public uint PeakActive;
+        public ulong BytesDelivered;
+        public double MeanFctSec;
+        public double MaxFctSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3FctOptions
+    {
+        public ulong* SizeEdges;
+        public uint SizeEdgeCount;
+        public double IdleSec;
+        public double Compression;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3FctFlow
+    {
+        public uint SrcAddr;
+        public uint DstAddr;
+        public ushort SrcPort;
+        public ushort DstPort;
+        public byte Protocol;
+        public byte Complete;
+        public ulong Bytes;
+        public double StartSec;
+        public double FctSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3FctBucket
+    {
+        public ulong MaxBytes;
+        public ulong Flows;
+        public double MinSec;
+        public double MeanSec;
+        public double MaxSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3QueueEvent
+    {
+        public ulong DeviceId;
+        public double TimeSec;
+        public uint Size;
+        public uint Backlog;
+        public byte Kind;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3QueueCounters
+    {
+        public ulong Enqueued;
+        public ulong Dequeued;
+        public ulong Dropped;
+        public ulong QdiscEnqueued;
+        public ulong QdiscDequeued;
+        public ulong QdiscDropped;
+        public ulong PhyRxDrops;
+        public ulong MacTxDrops;
+        public ulong DroppedBytes;
+        public uint Backlog;
+        public uint MaxBacklog;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3QueueBin
+    {
+        public double MeanPackets;
+        public double CoveredSec;
+        public uint MinPackets;
+        public uint MaxPackets;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3TcpFlowSpec
+    {
+        public uint SrcNode;
+        public uint DstNode;
+        public ushort Port;
+        public ushort CongestionControl;
+        public uint InitialCwndSegments;
+        public ulong Bytes;
+        public double StartSec;
+        public double StopSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3TcpBulkOptions
+    {
+        public uint SendSize;
+        public uint SegmentSize;
+        public uint SndBufBytes;
+        public uint RcvBufBytes;
+        public double IntervalSec;
+        public uint WindowIntervals;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3TcpFlowStats
+    {
+        public ulong TxBytes;
+        public ulong RxBytes;
+        public double StartSec;
+        public double FirstRxSec;
+        public double LastRxSec;
+        public double CompleteSec;
+        public double GoodputBps;
+        public double RttSec;
+        public double MinRttSec;
+        public uint CwndBytes;
+        public uint MaxCwndBytes;
+        public uint State;
+        public ushort CongestionControl;
+        public ushort Pacing;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3TcpBin
+    {
+        public ulong RxBytes;
+        public double CwndMeanBytes;
+        public double RttMeanSec;
+        public double RttMinSec;
+        public double RttMaxSec;
+        public double CoveredSec;
+        public uint CwndMinBytes;
+        public uint CwndMaxBytes;
+    }
+
     [StructLayout(LayoutKind.Sequential)]
     internal struct Ns3FlowStats
     {
@@ -97,6 +466,112 @@ internal static unsafe class NativeMethods
         public uint FlowCount;
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3FlowMonOptions
+    {
+        public int EdgeOnly;
+        public double MaxPerHopDelaySec;
+        public double StartTimeSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3FlowEpochOptions
+    {
+        public double EpochSec;
+        public uint EpochCapacity;
+        public uint MaxFlows;
+        public nint Path;  // const char*
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3FlowEpochsInfo
+    {
+        public ulong FirstEpoch;
+        public uint EpochCount;
+        public uint FlowCount;
+        public ulong DroppedFlows;
+        public double EpochSec;
+        public double StartSec;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3FlowEpochColumns
+    {
+        public double* TimeSec;
+        public ulong* TxPackets;
+        public ulong* RxPackets;
+        public ulong* TxBytes;
+        public ulong* RxBytes;
+        public ulong* LostPackets;
+        public double* DelaySumSec;
+        public double* JitterSumSec;
+        public uint Capacity;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3SweepAxis
+    {
+        public nint Path;      // const char*
+        public nint AttrName;  // const char*
+        public Ns3Attr* Values;
+        public uint ValueCount;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3SweepConfig
+    {
+        public nint FlowMon;
+        public Ns3SweepAxis* Axes;
+        public uint AxisCount;
+        public uint Seed;
+        public ulong FirstRun;
+        public uint RunCount;
+        public uint MaxParallel;
+        public double StopTimeSec;
+        public double ConfidenceLevel;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3MetricSummary
+    {
+        public double Mean;
+        public double StdDev;
+        public double CiHalfWidth;
+        public double Min;
+        public double P50;
+        public double P90;
+        public double P95;
+        public double P99;
+        public double Max;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3SweepPointSummary
+    {
+        public uint PointIndex;
+        public uint RunsCompleted;
+        public uint RunsFailed;
+        public Ns3MetricSummary TxPackets;
+        public Ns3MetricSummary RxPackets;
+        public Ns3MetricSummary TxBytes;
+        public Ns3MetricSummary RxBytes;
+        public Ns3MetricSummary DelaySumSec;
+        public Ns3MetricSummary JitterSumSec;
+        public Ns3MetricSummary FlowCount;
+        public Ns3MetricSummary MeanDelaySec;
+        public Ns3MetricSummary MeanJitterSec;
+        public Ns3MetricSummary LossRatio;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Ns3ForkRunResult
+    {
+        public ulong Run;
+        public Ns3Status Status;
+        public double WallTimeSec;
+        public Ns3FlowStats Stats;
+    }
+
     // ========================================================================
     // Error Handling
     // ========================================================================
@@ -112,6 +587,9 @@ internal static unsafe class NativeMethods
     [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
     internal static extern Ns3Status sim_create(out nint outSim);
 
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status sim_create_ex(out nint outSim, Ns3SimOptions* options);
+
     [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
     internal static extern Ns3Status sim_set_seed(nint sim, uint seed);
 
@@ -143,6 +621,24 @@ internal static unsafe class NativeMethods
     [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
     internal static extern Ns3Status internet_install(nint sim, nint* nodes, uint count);
 
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status nodes_create_ex(nint sim, uint count, uint* systemIds, nint* outArray);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status node_get_system_id(nint sim, nint node, out uint outSystemId, out int outIsLocal);
+
+    // ========================================================================
+    // Distributed Execution
+    // ========================================================================
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status sim_get_rank(nint sim, out uint outRank, out uint outRankCount);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status partition_nodes(nint sim, uint nodeCount, Ns3PartitionEdge* edges, uint edgeCount,
+                                                     uint rankCount, double minLookaheadSec,
+                                                     uint* outSystemIds, Ns3PartitionStats* outStats);
+
     // ========================================================================
     // Network Devices & Links
     // ========================================================================
@@ -205,33 +701,277 @@ internal static unsafe class NativeMethods
                                                         uint packetSize, double intervalSec, uint maxPackets,
                                                         out nint outApp);
 
+    internal const uint TrafficGenUniqueUids = 0x1;
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl,
+               ExactSpelling = true, BestFitMapping = false, ThrowOnUnmappableChar = true, CharSet = CharSet.Ansi)]
+    internal static extern Ns3Status app_traffic_gen(nint sim, nint node,
+                                                     [MarshalAs(UnmanagedType.LPStr)] string dstIp,
+                                                     ushort port, Ns3TrafficGenOptions* options, out nint outApp);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl,
+               ExactSpelling = true, BestFitMapping = false, ThrowOnUnmappableChar = true, CharSet = CharSet.Ansi)]
+    internal static extern Ns3Status app_pcap_replay(nint sim, nint node, [MarshalAs(UnmanagedType.LPStr)] string path,
+                                                     [MarshalAs(UnmanagedType.LPStr)] string dstIp,
+                                                     ushort port, Ns3PcapReplayOptions* options, out nint outApp);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status app_pcap_replay_stats(nint sim, nint app, out Ns3PcapReplayStats outStats);
+
+    internal const uint AppNoNode = 0xFFFFFFFF;
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status app_install_bulk(nint sim, nint* nodes, uint nodeCount,
+                                                      Ns3AppSpec* specs, uint count, nint* outApps);
+
     [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
     internal static extern Ns3Status app_start(nint sim, nint app, double atTimeSec);
 
     [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
     internal static extern Ns3Status app_stop(nint sim, nint app, double atTimeSec);
 
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl,
+               ExactSpelling = true, BestFitMapping = false, ThrowOnUnmappableChar = true, CharSet = CharSet.Ansi)]
+    internal static extern Ns3Status workload_open(nint sim, [MarshalAs(UnmanagedType.LPStr)] string path,
+                                                   nint* nodes, uint nodeCount, Ns3WorkloadOptions* options,
+                                                   out nint outWorkload);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status workload_stats(nint sim, nint workload, out Ns3WorkloadStats outStats);
+
     // ========================================================================
     // Tracing & Statistics
     // ========================================================================
 
     [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
-    internal static extern Ns3Status trace_subscribe_packet_events(nint sim, nint dev,
-                                                                   PacketCallback? onTx,
-                                                                   PacketCallback? onRx,
-                                                                   nint user);
+    internal static extern Ns3Status trace_subscribe_packet_events_handle(nint sim, nint dev,
+                                                                          PacketCallback? onTx,
+                                                                          PacketCallback? onRx,
+                                                                          nint user,
+                                                                          out nint outSub);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status trace_subscribe_packet_events_ex_handle(nint sim, nint dev,
+                                                                             PacketCallbackEx? onTx,
+                                                                             PacketCallbackEx? onRx,
+                                                                             nint user,
+                                                                             out nint outSub);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status trace_unsubscribe(nint sim, nint sub);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status trace_get_stats(nint sim, out Ns3TraceStats outStats);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status trace_set_filter(nint sim, nint dev, Ns3TraceFilter* filter);
 
     [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl,
                ExactSpelling = true, BestFitMapping = false, ThrowOnUnmappableChar = true, CharSet = CharSet.Ansi)]
     internal static extern Ns3Status pcap_enable(nint sim, nint dev,
                                                  [MarshalAs(UnmanagedType.LPStr)] string filePrefix);
 
+    internal const uint PcapNoPromisc = 0x1;
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl,
+               ExactSpelling = true, BestFitMapping = false, ThrowOnUnmappableChar = true, CharSet = CharSet.Ansi)]
+    internal static extern Ns3Status pcap_enable_ex(nint sim, nint dev,
+                                                    [MarshalAs(UnmanagedType.LPStr)] string filePrefix,
+                                                    Ns3PcapOptions* options);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status event_sink_open(nint sim, EventBatchCallback onBatch, nint user, uint batchCapacity);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status event_sink_enable(nint sim, nint dev, uint eventMask, out uint outSlot);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status event_sink_flush(nint sim);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status event_sink_close(nint sim);
+
+    internal const uint CaptureRingDrop = 0x1;
+    internal const uint CaptureRingNoPromisc = 0x2;
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl,
+               ExactSpelling = true, BestFitMapping = false, ThrowOnUnmappableChar = true, CharSet = CharSet.Ansi)]
+    internal static extern Ns3Status capture_ring_open(nint sim, [MarshalAs(UnmanagedType.LPStr)] string name,
+                                                       Ns3CaptureRingOptions* options, out nint outRing);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status capture_ring_attach(nint sim, nint ring, nint dev);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status capture_ring_get_stats(nint sim, nint ring, out Ns3CaptureRingStats outStats);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status capture_ring_close(nint sim, nint ring);
+
+    internal const uint TraceFileDirect = 0x1;
+    internal const uint TraceFileHeaders = 0x2;
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl,
+               ExactSpelling = true, BestFitMapping = false, ThrowOnUnmappableChar = true, CharSet = CharSet.Ansi)]
+    internal static extern Ns3Status trace_file_open(nint sim, [MarshalAs(UnmanagedType.LPStr)] string path,
+                                                     uint flags, out nint outFile);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status trace_file_attach(nint sim, nint file, nint dev);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status trace_file_close(nint sim, nint file, out ulong outRecordCount);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status throughput_create(nint sim, double binWidthSec, uint windowBins,
+                                                       out nint outThroughput);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status throughput_attach(nint sim, nint tp, nint dev);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status throughput_export(nint sim, nint tp,
+                                                       nint* outDevices, uint deviceCapacity,
+                                                       Ns3BinCounts* outMatrix, uint matrixCapacity,
+                                                       out Ns3ThroughputInfo outInfo);
+
     [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
     internal static extern Ns3Status flowmon_install_all(nint sim, out nint outFlowMon);
 
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status flowmon_install(nint sim, nint* nodes, uint count, Ns3FlowMonOptions* options,
+                                                     out nint outFlowMon, out uint outProbedNodes);
+
     [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
     internal static extern Ns3Status flowmon_collect(nint sim, nint fm, out Ns3FlowStats outStats);
 
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status flowmon_epochs_start(nint sim, nint fm, Ns3FlowEpochOptions* options,
+                                                          out nint outEpochs);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status flowmon_epochs_export(nint sim, nint epochs, Ns3FlowEpochColumns* columns,
+                                                           out Ns3FlowEpochsInfo outInfo);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status flowmon_epochs_stop(nint sim, nint epochs);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status flowmon_histogram(nint sim, nint fm, Ns3FlowHistKind kind,
+                                                       uint* flowIds, uint flowCount,
+                                                       ulong* outCounts, uint capacity,
+                                                       out double outBinWidth, out uint outBinCount);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status flowmon_quantiles(nint sim, nint fm, Ns3FlowMetric* metrics, uint metricCount,
+                                                       double* quantiles, uint quantileCount, double compression,
+                                                       double* outValues, ulong* outFlowCounts);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status flowmon_epochs_quantiles(nint sim, nint epochs, ulong epoch,
+                                                              Ns3FlowMetric* metrics, uint metricCount,
+                                                              double* quantiles, uint quantileCount, double compression,
+                                                              double* outValues, ulong* outFlowCounts);
+
+    // ========================================================================
+    // Latency Histograms
+    // ========================================================================
+
+    internal const uint LatencyAllFlows = 0xFFFFFFFF;
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status latency_install_all(nint sim, uint precisionBits, out nint outLatency);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status latency_flows(nint sim, nint lat, Ns3LatencyFlow* outFlows, uint capacity,
+                                                   out uint outCount);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status latency_percentiles(nint sim, nint lat, uint flowIndex,
+                                                         double* quantiles, uint count, double* outSec);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status latency_buckets(nint sim, nint lat, uint flowIndex,
+                                                     ulong* outCounts, double* outLowerSec, uint capacity,
+                                                     out uint outBucketCount);
+
+    // ========================================================================
+    // Flow Completion Times
+    // ========================================================================
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status fct_install_all(nint sim, Ns3FctOptions* options, out nint outFct);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status fct_flows(nint sim, nint fct, Ns3FctFlow* outFlows, uint capacity,
+                                               out uint outCount);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status fct_distribution(nint sim, nint fct, double* quantiles, uint quantileCount,
+                                                      Ns3FctBucket* outBuckets, double* outQuantileSec, uint capacity,
+                                                      out uint outBucketCount);
+
+    // ========================================================================
+    // Queue Monitoring
+    // ========================================================================
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status queue_monitor_create(nint sim, double binWidthSec, uint windowBins,
+                                                          QueueEventCallback? onEvent, nint user,
+                                                          out nint outMonitor);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status queue_monitor_attach(nint sim, nint qm, nint dev);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status queue_monitor_export(nint sim, nint qm,
+                                                          nint* outDevices, Ns3QueueCounters* outCounters,
+                                                          uint deviceCapacity,
+                                                          Ns3QueueBin* outMatrix, uint matrixCapacity,
+                                                          out Ns3ThroughputInfo outInfo);
+
+    // ========================================================================
+    // TCP Bulk Transfers
+    // ========================================================================
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status tcp_bulk_install(nint sim, nint* nodes, uint nodeCount,
+                                                      Ns3TcpFlowSpec* specs, uint count, Ns3TcpBulkOptions* options,
+                                                      nint* outSenders, out nint outBulk);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status tcp_bulk_export(nint sim, nint bulk,
+                                                     Ns3TcpFlowStats* outStats, uint flowCapacity,
+                                                     Ns3TcpBin* outMatrix, uint matrixCapacity,
+                                                     out Ns3ThroughputInfo outInfo);
+
+    // ========================================================================
+    // Parameter Sweeps
+    // ========================================================================
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status sim_sweep_run(nint sim, Ns3SweepConfig* config,
+                                                   Ns3SweepPointSummary* outSummaries, uint capacity);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status sim_fork_runs(nint sim, ulong* runs, uint count, nint fm,
+                                                   double stopTimeSec, uint maxParallel,
+                                                   Ns3ForkRunResult* outResults);
+
+    // ========================================================================
+    // Call Journal
+    // ========================================================================
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl,
+               ExactSpelling = true, BestFitMapping = false, ThrowOnUnmappableChar = true, CharSet = CharSet.Ansi)]
+    internal static extern Ns3Status journal_open([MarshalAs(UnmanagedType.LPStr)] string path);
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status journal_close();
+
+    [DllImport(LibraryName.Ns3Shim, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+    internal static extern Ns3Status journal_last_error(byte* buf, nuint len);
+
     // ========================================================================
     // Configuration
     // ========================================================================
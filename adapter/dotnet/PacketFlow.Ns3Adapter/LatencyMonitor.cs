@@ -0,0 +1,157 @@
+// LatencyMonitor.cs
+// High-level API for native per-flow latency histograms
+//
+// One-way delays are measured in native code from a send-time tag and kept
+// in fixed-size log-bucketed histograms per IPv4 5-tuple, so tail
+// percentiles are available without any per-packet callback.
+
+using System.Net;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// A flow observed by a <see cref="LatencyMonitor"/>
+/// </summary>
+/// <param name="Index">Flow index (order of first delivery)</param>
+/// <param name="Source">IPv4 source address</param>
+/// <param name="Destination">IPv4 destination address</param>
+/// <param name="SourcePort">Source port (0 unless TCP or UDP)</param>
+/// <param name="DestinationPort">Destination port (0 unless TCP or UDP)</param>
+/// <param name="Protocol">IP protocol number (6 = TCP, 17 = UDP)</param>
+/// <param name="Packets">Delivered packets</param>
+/// <param name="MinDelaySeconds">Smallest one-way delay</param>
+/// <param name="MaxDelaySeconds">Largest one-way delay</param>
+/// <param name="MeanDelaySeconds">Mean one-way delay</param>
+public sealed record LatencyFlow(
+    int Index,
+    IPAddress Source,
+    IPAddress Destination,
+    int SourcePort,
+    int DestinationPort,
+    int Protocol,
+    long Packets,
+    double MinDelaySeconds,
+    double MaxDelaySeconds,
+    double MeanDelaySeconds)
+{
+    internal static LatencyFlow FromNative(int index, in NativeMethods.Ns3LatencyFlow f) =>
+        new(index, ToAddress(f.SrcAddr), ToAddress(f.DstAddr), f.SrcPort, f.DstPort, f.Protocol,
+            (long)f.Packets, f.MinSec, f.MaxSec, f.MeanSec);
+
+    internal static IPAddress ToAddress(uint hostOrder) =>
+        new(new[] { (byte)(hostOrder >> 24), (byte)(hostOrder >> 16), (byte)(hostOrder >> 8), (byte)hostOrder });
+}
+
+/// <summary>
+/// Raw histogram buckets; bucket i covers [LowerBoundsSeconds[i], LowerBoundsSeconds[i + 1])
+/// </summary>
+public sealed record LatencyBuckets(double[] LowerBoundsSeconds, long[] Counts);
+
+/// <summary>
+/// Per-flow one-way delay histograms installed on every IPv4 node
+/// </summary>
+public sealed class LatencyMonitor
+{
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+
+    private LatencyMonitor(Simulation simulation, nint handle)
+    {
+        _simulation = simulation;
+        _handle = handle;
+    }
+
+    /// <summary>
+    /// Installs latency histograms on all existing nodes
+    /// </summary>
+    /// <param name="simulation">Simulation to monitor</param>
+    /// <param name="precisionBits">Bucket precision, 2..8; relative bucket width is at most 2^(1 - bits)</param>
+    public static LatencyMonitor InstallAll(Simulation simulation, int precisionBits = 4)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        ArgumentOutOfRangeException.ThrowIfLessThan(precisionBits, 2);
+        ArgumentOutOfRangeException.ThrowIfGreaterThan(precisionBits, 8);
+
+        var status = simulation.Interop.LatencyInstallAll(simulation.Handle, (uint)precisionBits, out nint handle);
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(InstallAll));
+        return new LatencyMonitor(simulation, handle);
+    }
+
+    /// <summary>
+    /// Gets the flows seen so far, by index
+    /// </summary>
+    public unsafe IReadOnlyList<LatencyFlow> GetFlows()
+    {
+        var status = _simulation.Interop.LatencyFlows(_simulation.Handle, _handle, null, 0, out uint count);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetFlows));
+
+        var flows = new NativeMethods.Ns3LatencyFlow[count];
+        fixed (NativeMethods.Ns3LatencyFlow* flowPtr = flows)
+        {
+            status = _simulation.Interop.LatencyFlows(_simulation.Handle, _handle, flowPtr, (uint)flows.Length, out count);
+        }
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetFlows));
+
+        var result = new LatencyFlow[flows.Length];
+        for (int i = 0; i < flows.Length; i++)
+            result[i] = LatencyFlow.FromNative(i, flows[i]);
+        return result;
+    }
+
+    /// <summary>
+    /// Delay quantiles in seconds
+    /// </summary>
+    /// <param name="quantiles">Quantiles in [0, 1] (e.g., 0.5, 0.99, 0.999)</param>
+    /// <param name="flowIndex">Flow index, or null for all flows merged</param>
+    public unsafe double[] GetPercentiles(IReadOnlyList<double> quantiles, int? flowIndex = null)
+    {
+        ArgumentNullException.ThrowIfNull(quantiles);
+        foreach (var q in quantiles)
+        {
+            if (q is < 0 or > 1 || double.IsNaN(q))
+                throw new ArgumentOutOfRangeException(nameof(quantiles), q, "Quantiles must be in [0, 1]");
+        }
+
+        var input = quantiles.ToArray();
+        var output = new double[input.Length];
+        fixed (double* inPtr = input)
+        fixed (double* outPtr = output)
+        {
+            var status = _simulation.Interop.LatencyPercentiles(_simulation.Handle, _handle, ToNativeFlow(flowIndex),
+                inPtr, (uint)input.Length, outPtr);
+            Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetPercentiles));
+        }
+        return output;
+    }
+
+    /// <summary>
+    /// Raw bucket counts and bounds
+    /// </summary>
+    /// <param name="flowIndex">Flow index, or null for all flows merged</param>
+    public unsafe LatencyBuckets GetBuckets(int? flowIndex = null)
+    {
+        uint flow = ToNativeFlow(flowIndex);
+        var status = _simulation.Interop.LatencyBuckets(_simulation.Handle, _handle, flow, null, null, 0, out uint count);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetBuckets));
+
+        var counts = new ulong[count];
+        var lower = new double[count];
+        fixed (ulong* countPtr = counts)
+        fixed (double* lowerPtr = lower)
+        {
+            status = _simulation.Interop.LatencyBuckets(_simulation.Handle, _handle, flow, countPtr, lowerPtr, count, out count);
+        }
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetBuckets));
+
+        return new LatencyBuckets(lower, Array.ConvertAll(counts, c => (long)c));
+    }
+
+    private static uint ToNativeFlow(int? flowIndex)
+    {
+        if (flowIndex is null)
+            return NativeMethods.LatencyAllFlows;
+        ArgumentOutOfRangeException.ThrowIfNegative(flowIndex.Value, nameof(flowIndex));
+        return (uint)flowIndex.Value;
+    }
+}
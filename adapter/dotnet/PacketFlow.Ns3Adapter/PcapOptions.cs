@@ -0,0 +1,89 @@
+// PcapOptions.cs
+// Capture options for Device.EnablePcap
+//
+// PCAP records are collected in a native buffer and written in large
+// chunks, so heavily captured runs are not bound by per-packet writes.
+// Compressed captures are encoded on a native background thread, trading
+// spare CPU for disk bandwidth on high-rate links.
+
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// PCAP file compression
+/// </summary>
+public enum PcapCompression
+{
+    /// <summary>Plain ".pcap"</summary>
+    None = 0,
+
+    /// <summary>".pcap.gz" (native library built with zlib)</summary>
+    Gzip = 1,
+
+    /// <summary>".pcap.zst" (native library built with libzstd)</summary>
+    Zstd = 2
+}
+
+/// <summary>
+/// PCAP capture options for <see cref="Device.EnablePcap"/>; unset properties take the native defaults
+/// </summary>
+public sealed record PcapOptions
+{
+    /// <summary>Write buffer per file in bytes (default 4 MiB)</summary>
+    public int? BufferBytes { get; init; }
+
+    /// <summary>Bytes captured per packet, including link-layer and radiotap headers (default 65535)</summary>
+    public int? Snaplen { get; init; }
+
+    /// <summary>
+    /// Wall-clock interval after which buffered records are written (default 1 s);
+    /// <see cref="Timeout.InfiniteTimeSpan"/> writes only when the buffer fills
+    /// </summary>
+    public TimeSpan? FlushInterval { get; init; }
+
+    /// <summary>
+    /// PointToPoint/CSMA: capture every frame on the link (default) rather than
+    /// only those the device sends or receives
+    /// </summary>
+    public bool Promiscuous { get; init; } = true;
+
+    /// <summary>
+    /// Compress the file on a background thread (default none); capture fails
+    /// if the native library was built without the codec
+    /// </summary>
+    public PcapCompression Compression { get; init; }
+
+    /// <summary>Codec level (default 1, the fastest; gzip 1-9, zstd 1-22)</summary>
+    public int? CompressionLevel { get; init; }
+
+    internal NativeMethods.Ns3PcapOptions ToNative()
+    {
+        if (BufferBytes is < 0)
+            throw new ArgumentOutOfRangeException(nameof(BufferBytes), BufferBytes, "BufferBytes must not be negative");
+        if (Snaplen is < 0)
+            throw new ArgumentOutOfRangeException(nameof(Snaplen), Snaplen, "Snaplen must not be negative");
+        if (!Enum.IsDefined(Compression))
+            throw new ArgumentOutOfRangeException(nameof(Compression), Compression, "Unknown compression");
+        if (CompressionLevel is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(CompressionLevel), CompressionLevel, "CompressionLevel must be positive");
+
+        double flushSec = FlushInterval switch
+        {
+            null => 0,
+            { } t when t == Timeout.InfiniteTimeSpan => -1,
+            { } t when t > TimeSpan.Zero => t.TotalSeconds,
+            _ => throw new ArgumentOutOfRangeException(nameof(FlushInterval), FlushInterval, "FlushInterval must be positive"),
+        };
+
+        return new NativeMethods.Ns3PcapOptions
+        {
+            BufferBytes = (uint)(BufferBytes ?? 0),
+            Snaplen = (uint)(Snaplen ?? 0),
+            FlushIntervalSec = flushSec,
+            Flags = Promiscuous ? 0u : NativeMethods.PcapNoPromisc,
+            Compression = (uint)Compression,
+            CompressionLevel = CompressionLevel ?? 0,
+        };
+    }
+}
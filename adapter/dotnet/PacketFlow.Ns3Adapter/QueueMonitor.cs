@@ -0,0 +1,229 @@
+// QueueMonitor.cs
+// High-level API for native queue and drop aggregation
+//
+// Device queue, queue disc and PHY/MAC drop traces are counted in native
+// code, and the backlog is reduced to min/max/mean per time bin there, so a
+// congestion study gets its bottlenecks without PCAP-scale output. A
+// per-event stream is available but optional.
+
+using System.Runtime.InteropServices;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// Kind of a <see cref="QueueEvent"/>
+/// </summary>
+public enum QueueEventKind : byte
+{
+    /// <summary>Packet entered the device transmit queue</summary>
+    Enqueue = 0,
+    /// <summary>Packet left the device transmit queue</summary>
+    Dequeue = 1,
+    /// <summary>Device transmit queue dropped a packet</summary>
+    Drop = 2,
+    /// <summary>Packet entered the root queue disc</summary>
+    QdiscEnqueue = 3,
+    /// <summary>Packet left the root queue disc</summary>
+    QdiscDequeue = 4,
+    /// <summary>Queue disc dropped a packet</summary>
+    QdiscDrop = 5,
+    /// <summary>PHY dropped a received packet</summary>
+    PhyRxDrop = 6,
+    /// <summary>MAC dropped a packet before transmission</summary>
+    MacTxDrop = 7,
+}
+
+/// <summary>
+/// One queue or drop event
+/// </summary>
+/// <param name="DeviceId">Native device handle id</param>
+/// <param name="Time">Simulation time</param>
+/// <param name="Kind">Event kind</param>
+/// <param name="Bytes">Packet size</param>
+/// <param name="Backlog">Device backlog (queue + queue disc) after the event, in packets</param>
+public readonly record struct QueueEvent(ulong DeviceId, TimeSpan Time, QueueEventKind Kind, uint Bytes, int Backlog);
+
+/// <summary>
+/// Totals of one device since it was attached
+/// </summary>
+public readonly record struct QueueCounters(
+    long Enqueued,
+    long Dequeued,
+    long Dropped,
+    long QdiscEnqueued,
+    long QdiscDequeued,
+    long QdiscDropped,
+    long PhyRxDrops,
+    long MacTxDrops,
+    long DroppedBytes,
+    int Backlog,
+    int MaxBacklog)
+{
+    /// <summary>All drops</summary>
+    public long TotalDrops => Dropped + QdiscDropped + PhyRxDrops + MacTxDrops;
+
+    internal static QueueCounters FromNative(in NativeMethods.Ns3QueueCounters c) =>
+        new((long)c.Enqueued, (long)c.Dequeued, (long)c.Dropped,
+            (long)c.QdiscEnqueued, (long)c.QdiscDequeued, (long)c.QdiscDropped,
+            (long)c.PhyRxDrops, (long)c.MacTxDrops, (long)c.DroppedBytes, (int)c.Backlog, (int)c.MaxBacklog);
+}
+
+/// <summary>
+/// Backlog of one device in one time bin, in packets
+/// </summary>
+/// <param name="MeanPackets">Time-weighted mean</param>
+/// <param name="MinPackets">Smallest backlog</param>
+/// <param name="MaxPackets">Largest backlog</param>
+/// <param name="Covered">Part of the bin observed (zero before the device was attached)</param>
+public readonly record struct BacklogBin(double MeanPackets, int MinPackets, int MaxPackets, TimeSpan Covered)
+{
+    internal static BacklogBin FromNative(in NativeMethods.Ns3QueueBin b) =>
+        new(b.MeanPackets, (int)b.MinPackets, (int)b.MaxPackets, TimeSpan.FromSeconds(b.CoveredSec));
+}
+
+/// <summary>
+/// Snapshot of a <see cref="QueueMonitor"/>
+/// </summary>
+/// <param name="Devices">Rows, in attach order</param>
+/// <param name="Counters">Totals per device</param>
+/// <param name="FirstBin">Absolute index of column 0 (bin i covers [i, i + 1) x BinWidth)</param>
+/// <param name="BinWidth">Width of one bin</param>
+/// <param name="Backlog">Backlog indexed [device, bin]</param>
+public sealed record QueueReport(
+    IReadOnlyList<Device> Devices,
+    IReadOnlyList<QueueCounters> Counters,
+    long FirstBin,
+    TimeSpan BinWidth,
+    BacklogBin[,] Backlog)
+{
+    /// <summary>
+    /// Start time of a backlog column
+    /// </summary>
+    public TimeSpan BinStart(int column) => BinWidth * (FirstBin + column);
+}
+
+/// <summary>
+/// Native per-device queue, queue disc and drop monitor
+/// </summary>
+public sealed class QueueMonitor
+{
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+    private readonly List<Device> _devices = new();
+
+    private QueueMonitor(Simulation simulation, nint handle, TimeSpan binWidth, int windowBins)
+    {
+        _simulation = simulation;
+        _handle = handle;
+        BinWidth = binWidth;
+        WindowBins = windowBins;
+    }
+
+    /// <summary>
+    /// Width of one backlog bin
+    /// </summary>
+    public TimeSpan BinWidth { get; }
+
+    /// <summary>
+    /// Number of most recent bins retained per device
+    /// </summary>
+    public int WindowBins { get; }
+
+    /// <summary>
+    /// Attached devices, in row order
+    /// </summary>
+    public IReadOnlyList<Device> Devices => _devices;
+
+    /// <summary>
+    /// Creates a queue monitor
+    /// </summary>
+    /// <param name="simulation">Simulation whose devices will be monitored</param>
+    /// <param name="binWidth">Width of one backlog bin</param>
+    /// <param name="windowBins">Number of most recent bins retained</param>
+    /// <param name="onEvent">Optional per-event callback; aggregation alone needs none</param>
+    public static unsafe QueueMonitor Create(Simulation simulation, TimeSpan binWidth, int windowBins,
+        Action<QueueEvent>? onEvent = null)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        if (binWidth <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(binWidth), "Bin width must be positive");
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(windowBins);
+
+        NativeMethods.QueueEventCallback? nativeCallback = null;
+        GCHandle? handle = null;
+        if (onEvent != null)
+        {
+            nativeCallback = (user, queueEvent) => onEvent(new QueueEvent(queueEvent->DeviceId,
+                TimeSpan.FromSeconds(queueEvent->TimeSec), (QueueEventKind)queueEvent->Kind,
+                queueEvent->Size, (int)queueEvent->Backlog));
+            handle = GCHandle.Alloc(nativeCallback);
+        }
+
+        var status = simulation.Interop.QueueMonitorCreate(simulation.Handle, binWidth.TotalSeconds, (uint)windowBins,
+            nativeCallback, handle.HasValue ? GCHandle.ToIntPtr(handle.Value) : nint.Zero, out nint monitor);
+        if (status != NativeMethods.Ns3Status.Ok)
+        {
+            handle?.Free();
+            Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Create));
+        }
+
+        if (handle.HasValue)
+            simulation.RegisterTraceHandle(handle.Value);
+        return new QueueMonitor(simulation, monitor, binWidth, windowBins);
+    }
+
+    /// <summary>
+    /// Starts monitoring the given devices (each at most once). Attach after
+    /// assigning addresses so the default queue disc is included.
+    /// </summary>
+    public QueueMonitor Attach(params Device[] devices)
+    {
+        ArgumentNullException.ThrowIfNull(devices);
+
+        foreach (var device in devices)
+        {
+            ArgumentNullException.ThrowIfNull(device);
+            var status = _simulation.Interop.QueueMonitorAttach(_simulation.Handle, _handle, device.NativeHandle);
+            Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Attach));
+            _devices.Add(device);
+        }
+        return this;
+    }
+
+    /// <summary>
+    /// Copies the counters and the backlog window (ending at the current simulation time)
+    /// </summary>
+    public unsafe QueueReport Export()
+    {
+        var status = _simulation.Interop.QueueMonitorExport(_simulation.Handle, _handle, null, null, 0, null, 0,
+            out NativeMethods.Ns3ThroughputInfo info);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Export));
+
+        var handles = new nint[info.DeviceCount];
+        var counters = new NativeMethods.Ns3QueueCounters[info.DeviceCount];
+        var cells = new NativeMethods.Ns3QueueBin[(long)info.DeviceCount * info.BinCount];
+        fixed (nint* handlePtr = handles)
+        fixed (NativeMethods.Ns3QueueCounters* counterPtr = counters)
+        fixed (NativeMethods.Ns3QueueBin* cellPtr = cells)
+        {
+            status = _simulation.Interop.QueueMonitorExport(_simulation.Handle, _handle,
+                handlePtr, counterPtr, (uint)handles.Length, cellPtr, (uint)cells.Length, out info);
+        }
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Export));
+
+        var devices = new Device[handles.Length];
+        for (int row = 0; row < handles.Length; row++)
+            devices[row] = _devices.Find(d => d.NativeHandle == handles[row])
+                ?? throw new InvalidOperationException("Native queue monitor reported an unknown device");
+
+        int binCount = (int)info.BinCount;
+        var backlog = new BacklogBin[devices.Length, binCount];
+        for (int row = 0; row < devices.Length; row++)
+            for (int col = 0; col < binCount; col++)
+                backlog[row, col] = BacklogBin.FromNative(cells[row * binCount + col]);
+
+        return new QueueReport(devices, Array.ConvertAll(counters, c => QueueCounters.FromNative(c)),
+            (long)info.FirstBin, TimeSpan.FromSeconds(info.BinWidthSec), backlog);
+    }
+}
@@ -9,6 +9,7 @@
 // Uses INativeInterop for testability — the default implementation delegates
 // to P/Invoke; unit tests inject a mock.
 
+using System.Net;
 using System.Runtime.InteropServices;
 using PacketFlow.Ns3Adapter.Interop;
 
@@ -42,17 +43,58 @@ public sealed class Simulation : IDisposable
     {
     }
 
+    /// <summary>
+    /// Creates a new simulation context with the given simulator implementation.
+    /// </summary>
+    /// <remarks>
+    /// Distributed implementations require the native library built with
+    /// NS3SHIM_ENABLE_MPI and the host process launched under MPI (e.g.,
+    /// <c>mpirun -np 8 dotnet MyScenario.dll</c>). One distributed simulation
+    /// per process.
+    /// </remarks>
+    /// <param name="implementation">Simulator implementation</param>
+    public Simulation(SimulatorImplementation implementation)
+        : this(NativeInterop.Instance, ownsNative: true, implementation)
+    {
+    }
+
     /// <summary>
     /// Internal constructor for unit testing with a mock interop.
     /// </summary>
     internal Simulation(INativeInterop interop, bool ownsNative)
+        : this(interop, ownsNative, SimulatorImplementation.Default)
+    {
+    }
+
+    /// <summary>
+    /// Internal constructor for unit testing with a mock interop and explicit implementation.
+    /// </summary>
+    internal unsafe Simulation(INativeInterop interop, bool ownsNative, SimulatorImplementation implementation)
     {
         _interop = interop ?? throw new ArgumentNullException(nameof(interop));
-        var status = _interop.SimCreate(out nint handle);
-        Ns3Exception.ThrowIfError(status, nint.Zero, nameof(NativeMethods.sim_create));
+
+        nint handle;
+        if (implementation == SimulatorImplementation.Default)
+        {
+            var status = _interop.SimCreate(out handle);
+            Ns3Exception.ThrowIfError(status, nint.Zero, nameof(NativeMethods.sim_create));
+        }
+        else
+        {
+            var options = new NativeMethods.Ns3SimOptions { Impl = (NativeMethods.Ns3SimImpl)implementation };
+            var status = _interop.SimCreateEx(out handle, &options);
+            Ns3Exception.ThrowIfError(status, nint.Zero, nameof(NativeMethods.sim_create_ex));
+        }
+
         _handle = new SimHandle(handle, ownsNative);
+        Implementation = implementation;
     }
 
+    /// <summary>
+    /// Simulator implementation this context was created with
+    /// </summary>
+    public SimulatorImplementation Implementation { get; }
+
     /// <summary>
     /// Gets the native simulation handle
     /// </summary>
@@ -84,6 +126,47 @@ public sealed class Simulation : IDisposable
         Ns3Exception.ThrowIfError(status, Handle, nameof(Run));
     }
 
+    /// <summary>
+    /// Runs the built scenario once per RNG run number in forked native worker
+    /// processes that share the topology copy-on-write (Linux/macOS only).
+    /// </summary>
+    /// <remarks>
+    /// Topology setup is paid once for the whole batch. The simulation must be
+    /// built but not yet run; it remains unrun afterwards. Managed callbacks do
+    /// not fire inside workers.
+    /// </remarks>
+    /// <param name="runs">RNG run numbers, one worker per entry</param>
+    /// <param name="flowMonitor">Flow monitor to collect per run (optional)</param>
+    /// <param name="stopTime">Stop time for every run (zero keeps the scenario's own stop)</param>
+    /// <param name="maxParallelism">Maximum concurrent workers (0 = one per hardware thread)</param>
+    /// <returns>One result per run, in the order given</returns>
+    public unsafe IReadOnlyList<ForkRunResult> RunForked(IReadOnlyList<ulong> runs, FlowMonitor? flowMonitor = null,
+        TimeSpan stopTime = default, int maxParallelism = 0)
+    {
+        ThrowIfDisposed();
+        if (runs == null || runs.Count == 0)
+            throw new ArgumentException("At least one run required", nameof(runs));
+        if (maxParallelism < 0)
+            throw new ArgumentOutOfRangeException(nameof(maxParallelism));
+
+        var runArray = runs.ToArray();
+        var native = new NativeMethods.Ns3ForkRunResult[runArray.Length];
+
+        fixed (ulong* runPtr = runArray)
+        fixed (NativeMethods.Ns3ForkRunResult* outPtr = native)
+        {
+            var status = _interop.SimForkRuns(Handle, runPtr, (uint)runArray.Length,
+                flowMonitor?.NativeHandle ?? 0, stopTime.TotalSeconds, (uint)maxParallelism, outPtr);
+            Ns3Exception.ThrowIfError(status, Handle, nameof(RunForked));
+        }
+
+        return native.Select(r => new ForkRunResult(
+            r.Run,
+            r.Status == NativeMethods.Ns3Status.Ok,
+            TimeSpan.FromSeconds(r.WallTimeSec),
+            FlowStatistics.FromNative(r.Stats))).ToArray();
+    }
+
     /// <summary>
     /// Schedules a simulation stop at the specified time
     /// </summary>
@@ -95,6 +178,38 @@ public sealed class Simulation : IDisposable
         Ns3Exception.ThrowIfError(status, Handle, nameof(Stop));
     }
 
+    /// <summary>
+    /// Rank of this process in a distributed simulation (0 when sequential)
+    /// </summary>
+    public int Rank => (int)QueryRank().Rank;
+
+    /// <summary>
+    /// Number of ranks in a distributed simulation (1 when sequential)
+    /// </summary>
+    public int RankCount => (int)QueryRank().RankCount;
+
+    private (uint Rank, uint RankCount) QueryRank()
+    {
+        ThrowIfDisposed();
+        var status = _interop.SimGetRank(Handle, out uint rank, out uint rankCount);
+        Ns3Exception.ThrowIfError(status, Handle, nameof(Rank));
+        return (rank, rankCount);
+    }
+
+    /// <summary>
+    /// Packet event subscription counters
+    /// </summary>
+    public TraceStats TraceStats
+    {
+        get
+        {
+            ThrowIfDisposed();
+            var status = _interop.TraceGetStats(Handle, out var stats);
+            Ns3Exception.ThrowIfError(status, Handle, nameof(TraceStats));
+            return new TraceStats((int)stats.Subscriptions, (int)stats.Contexts, (int)stats.ContextCapacity);
+        }
+    }
+
     /// <summary>
     /// Checks if the simulation is currently running
     /// </summary>
@@ -188,6 +303,26 @@ public sealed class Simulation : IDisposable
         }
     }
 
+    /// <summary>
+    /// Frees a registered handle early, once native code can no longer call
+    /// through it. Returns false if the simulation already freed it.
+    /// </summary>
+    internal bool ReleaseTraceHandle(GCHandle handle)
+    {
+        lock (_handleLock)
+        {
+            if (!_traceHandles.Remove(handle))
+                return false;
+        }
+        handle.Free();
+        return true;
+    }
+
+    /// <summary>
+    /// Whether the simulation has been disposed
+    /// </summary>
+    internal bool IsDisposed => _disposed;
+
     /// <summary>
     /// Creates network nodes
     /// </summary>
@@ -215,6 +350,29 @@ public sealed class Simulation : IDisposable
         return nodes;
     }
 
+    /// <summary>
+    /// Creates network nodes owned by the given ranks (one node per entry)
+    /// </summary>
+    /// <param name="systemIds">Owning rank per node, e.g. from <see cref="TopologyPlan.Partition"/></param>
+    /// <returns>Array of node handles</returns>
+    public unsafe Node[] CreateNodes(IReadOnlyList<uint> systemIds)
+    {
+        ThrowIfDisposed();
+        if (systemIds == null || systemIds.Count == 0)
+            throw new ArgumentException("At least one node required", nameof(systemIds));
+
+        var ids = systemIds.ToArray();
+        var handles = new nint[ids.Length];
+        fixed (uint* idPtr = ids)
+        fixed (nint* ptr = handles)
+        {
+            var status = _interop.NodesCreateEx(Handle, (uint)ids.Length, idPtr, ptr);
+            Ns3Exception.ThrowIfError(status, Handle, nameof(CreateNodes));
+        }
+
+        return handles.Select(h => new Node(this, new NodeHandle(h))).ToArray();
+    }
+
     /// <summary>
     /// Installs the Internet stack (IPv4, TCP, UDP) on the specified nodes
     /// </summary>
@@ -339,6 +497,23 @@ public sealed class Node
     /// </summary>
     public Simulation Simulation => _simulation;
 
+    /// <summary>
+    /// Rank that owns this node (0 when sequential)
+    /// </summary>
+    public int SystemId => (int)QuerySystemId().SystemId;
+
+    /// <summary>
+    /// Whether this process's rank owns the node; install applications only on local nodes
+    /// </summary>
+    public bool IsLocal => QuerySystemId().IsLocal;
+
+    private (uint SystemId, bool IsLocal) QuerySystemId()
+    {
+        var status = _simulation.Interop.NodeGetSystemId(_simulation.Handle, NativeHandle, out uint systemId, out int isLocal);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(SystemId));
+        return (systemId, isLocal != 0);
+    }
+
     /// <summary>
     /// Sets a constant (static) position for this node
     /// </summary>
@@ -377,23 +552,59 @@ public sealed class Device
     public Simulation Simulation => _simulation;
 
     /// <summary>
-    /// Enables PCAP tracing on this device
+    /// Enables PCAP tracing on this device, writing
+    /// "&lt;filePrefix&gt;-&lt;node id&gt;-&lt;device index&gt;.pcap" (".pcap.gz"/".pcap.zst" when
+    /// compressed) with the device's link type (PPP, Ethernet, or 802.11 with radiotap headers)
     /// </summary>
     /// <param name="filePrefix">Prefix for PCAP file name</param>
-    public void EnablePcap(string filePrefix)
+    /// <param name="options">Buffering and capture options, or null for the defaults</param>
+    public unsafe void EnablePcap(string filePrefix, PcapOptions? options = null)
     {
-        var status = _simulation.Interop.PcapEnable(_simulation.Handle, NativeHandle, filePrefix);
+        ArgumentNullException.ThrowIfNull(filePrefix);
+
+        NativeMethods.Ns3Status status;
+        if (options is null)
+        {
+            status = _simulation.Interop.PcapEnable(_simulation.Handle, NativeHandle, filePrefix);
+        }
+        else
+        {
+            var native = options.ToNative();
+            status = _simulation.Interop.PcapEnableEx(_simulation.Handle, NativeHandle, filePrefix, &native);
+        }
         Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(EnablePcap));
     }
 
+    /// <summary>
+    /// Sets or clears the native packet filter applied to this device's packet
+    /// events and trace file records (rejected packets never reach managed code)
+    /// </summary>
+    /// <param name="filter">Filter, or null to pass every packet</param>
+    public unsafe void SetTraceFilter(TraceFilter? filter)
+    {
+        NativeMethods.Ns3Status status;
+        if (filter is null)
+        {
+            status = _simulation.Interop.TraceSetFilter(_simulation.Handle, NativeHandle, null);
+        }
+        else
+        {
+            var native = filter.ToNative();
+            status = _simulation.Interop.TraceSetFilter(_simulation.Handle, NativeHandle, &native);
+        }
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(SetTraceFilter));
+    }
+
     /// <summary>
     /// Subscribes to packet TX/RX events.
-    /// The callbacks remain active for the lifetime of the simulation.
-    /// Delegate handles are freed automatically when the simulation is disposed.
+    /// The callbacks remain active until the returned subscription is disposed,
+    /// or for the lifetime of the simulation.
+    /// Delegate handles are freed when the subscription ends or the simulation is disposed.
     /// </summary>
     /// <param name="onTx">Callback for transmitted packets (may be null)</param>
     /// <param name="onRx">Callback for received packets (may be null)</param>
-    public void SubscribeToPacketEvents(Action<PacketEvent>? onTx, Action<PacketEvent>? onRx)
+    /// <returns>Subscription; dispose it to stop the callbacks</returns>
+    public TraceSubscription SubscribeToPacketEvents(Action<PacketEvent>? onTx, Action<PacketEvent>? onRx)
     {
         NativeMethods.PacketCallback? nativeTx = null;
         NativeMethods.PacketCallback? nativeRx = null;
@@ -421,7 +632,8 @@ public sealed class Device
 
         var userPtr = txHandle.HasValue ? GCHandle.ToIntPtr(txHandle.Value) :
                       rxHandle.HasValue ? GCHandle.ToIntPtr(rxHandle.Value) : nint.Zero;
-        var status = _simulation.Interop.TraceSubscribePacketEvents(_simulation.Handle, NativeHandle, nativeTx, nativeRx, userPtr);
+        var status = _simulation.Interop.TraceSubscribePacketEvents(_simulation.Handle, NativeHandle, nativeTx, nativeRx, userPtr,
+            out nint subscription);
 
         if (status != NativeMethods.Ns3Status.Ok)
         {
@@ -430,10 +642,50 @@ public sealed class Device
             Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(SubscribeToPacketEvents));
         }
 
-        if (txHandle.HasValue)
-            _simulation.RegisterTraceHandle(txHandle.Value);
-        if (rxHandle.HasValue)
-            _simulation.RegisterTraceHandle(rxHandle.Value);
+        return new TraceSubscription(_simulation, subscription, txHandle, rxHandle);
+    }
+
+    /// <summary>
+    /// Subscribes to packet TX/RX events with the packet uid and IPv4/TCP/UDP header
+    /// fields, read in native code from the frame.
+    /// Lifetime and handle management are as for <see cref="SubscribeToPacketEvents"/>.
+    /// </summary>
+    /// <param name="onTx">Callback for transmitted packets (may be null)</param>
+    /// <param name="onRx">Callback for received packets (may be null)</param>
+    /// <returns>Subscription; dispose it to stop the callbacks</returns>
+    public unsafe TraceSubscription SubscribeToPacketEventsEx(Action<PacketEventEx>? onTx, Action<PacketEventEx>? onRx)
+    {
+        NativeMethods.PacketCallbackEx? nativeTx = null;
+        NativeMethods.PacketCallbackEx? nativeRx = null;
+
+        GCHandle? txHandle = null;
+        GCHandle? rxHandle = null;
+
+        if (onTx != null)
+        {
+            nativeTx = (user, packetEvent) => onTx(PacketEventEx.FromNative(*packetEvent));
+            txHandle = GCHandle.Alloc(nativeTx);
+        }
+
+        if (onRx != null)
+        {
+            nativeRx = (user, packetEvent) => onRx(PacketEventEx.FromNative(*packetEvent));
+            rxHandle = GCHandle.Alloc(nativeRx);
+        }
+
+        var userPtr = txHandle.HasValue ? GCHandle.ToIntPtr(txHandle.Value) :
+                      rxHandle.HasValue ? GCHandle.ToIntPtr(rxHandle.Value) : nint.Zero;
+        var status = _simulation.Interop.TraceSubscribePacketEventsEx(_simulation.Handle, NativeHandle, nativeTx, nativeRx, userPtr,
+            out nint subscription);
+
+        if (status != NativeMethods.Ns3Status.Ok)
+        {
+            txHandle?.Free();
+            rxHandle?.Free();
+            Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(SubscribeToPacketEventsEx));
+        }
+
+        return new TraceSubscription(_simulation, subscription, txHandle, rxHandle);
     }
 }
 
@@ -441,3 +693,48 @@ public sealed class Device
 /// Represents a packet event (TX or RX)
 /// </summary>
 public readonly record struct PacketEvent(ulong DeviceId, TimeSpan Time, uint Bytes);
+
+/// <summary>
+/// Packet event with header fields; addresses are kept as host-order integers so
+/// that an event costs no allocation
+/// </summary>
+/// <param name="DeviceId">Native device handle id</param>
+/// <param name="Time">Simulation time</param>
+/// <param name="Bytes">Packet size, including link-layer headers</param>
+/// <param name="Uid">ns-3 packet uid; the same on every device the packet crosses</param>
+/// <param name="IsIpv4">Whether the IPv4 fields are valid</param>
+/// <param name="HasPorts">Whether the port fields are valid (TCP/UDP first fragment)</param>
+/// <param name="Protocol">IP protocol number</param>
+/// <param name="Ttl">IPv4 time to live</param>
+/// <param name="SourceAddress">IPv4 source, host byte order</param>
+/// <param name="DestinationAddress">IPv4 destination, host byte order</param>
+/// <param name="SourcePort">TCP/UDP source port</param>
+/// <param name="DestinationPort">TCP/UDP destination port</param>
+public readonly record struct PacketEventEx(
+    ulong DeviceId,
+    TimeSpan Time,
+    uint Bytes,
+    ulong Uid,
+    bool IsIpv4,
+    bool HasPorts,
+    byte Protocol,
+    byte Ttl,
+    uint SourceAddress,
+    uint DestinationAddress,
+    ushort SourcePort,
+    ushort DestinationPort)
+{
+    /// <summary>IPv4 source, or null if the packet is not IPv4</summary>
+    public IPAddress? Source => IsIpv4 ? ToAddress(SourceAddress) : null;
+
+    /// <summary>IPv4 destination, or null if the packet is not IPv4</summary>
+    public IPAddress? Destination => IsIpv4 ? ToAddress(DestinationAddress) : null;
+
+    internal static PacketEventEx FromNative(in NativeMethods.Ns3PktEventEx e) =>
+        new(e.DeviceId, TimeSpan.FromSeconds(e.TimeSec), e.Size, e.Uid,
+            (e.Flags & NativeMethods.PktFlagIpv4) != 0, (e.Flags & NativeMethods.PktFlagPorts) != 0,
+            e.Protocol, e.Ttl, e.SrcAddr, e.DstAddr, e.SrcPort, e.DstPort);
+
+    private static IPAddress ToAddress(uint hostOrder) =>
+        new(new[] { (byte)(hostOrder >> 24), (byte)(hostOrder >> 16), (byte)(hostOrder >> 8), (byte)hostOrder });
+}
@@ -0,0 +1,263 @@
+// Sweep.cs
+// High-level API for parameter sweeps with natively aggregated statistics
+//
+// A sweep runs the built scenario once per (grid point, run) pair in forked
+// native worker processes; only the per-point summaries cross the boundary.
+// Also hosts the result type of Simulation.RunForked, the unaggregated
+// per-run form of the same fork-after-setup mechanism.
+
+using System.Runtime.InteropServices;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// One sweep dimension: a configuration attribute and the values it takes
+/// </summary>
+/// <param name="Path">Config path (e.g., "/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice")</param>
+/// <param name="AttributeName">Attribute name (e.g., "DataRate")</param>
+/// <param name="Values">Attribute values in ns-3 string form (e.g., "10Mbps")</param>
+public sealed record SweepAxis(string Path, string AttributeName, IReadOnlyList<string> Values);
+
+/// <summary>
+/// Summary of one metric across the replicated runs of a grid point
+/// </summary>
+public readonly record struct MetricSummary(
+    double Mean,
+    double StdDev,
+    double ConfidenceHalfWidth,
+    double Min,
+    double P50,
+    double P90,
+    double P95,
+    double P99,
+    double Max)
+{
+    internal static MetricSummary FromNative(in NativeMethods.Ns3MetricSummary s) =>
+        new(s.Mean, s.StdDev, s.CiHalfWidth, s.Min, s.P50, s.P90, s.P95, s.P99, s.Max);
+}
+
+/// <summary>
+/// Aggregated statistics for one grid point of a sweep
+/// </summary>
+public sealed record SweepPointResult(
+    int PointIndex,
+    IReadOnlyList<string> Values,
+    int RunsCompleted,
+    int RunsFailed,
+    MetricSummary TxPackets,
+    MetricSummary RxPackets,
+    MetricSummary TxBytes,
+    MetricSummary RxBytes,
+    MetricSummary DelaySum,
+    MetricSummary JitterSum,
+    MetricSummary FlowCount,
+    MetricSummary MeanDelay,
+    MetricSummary MeanJitter,
+    MetricSummary LossRatio);
+
+/// <summary>
+/// Outcome of one run executed by <see cref="Simulation.RunForked"/>
+/// </summary>
+/// <param name="Run">RNG run number</param>
+/// <param name="Succeeded">Whether the worker completed the run</param>
+/// <param name="WallTime">Wall-clock time of the run inside its worker</param>
+/// <param name="Statistics">Flow statistics (default when no flow monitor was given or the run failed)</param>
+public sealed record ForkRunResult(ulong Run, bool Succeeded, TimeSpan WallTime, FlowStatistics Statistics);
+
+/// <summary>
+/// Runs the built scenario across a parameter grid and a range of RNG runs,
+/// executing runs in parallel native worker processes (Linux/macOS only).
+/// </summary>
+/// <remarks>
+/// The scenario must be fully built but not yet run. Managed callbacks
+/// (packet trace subscriptions, <see cref="Simulation.Schedule"/>) do not fire
+/// inside workers.
+/// </remarks>
+public sealed class ParameterSweep
+{
+    private readonly FlowMonitor _flowMonitor;
+    private readonly List<SweepAxis> _axes = new();
+
+    /// <summary>
+    /// Creates a sweep whose runs are measured by the given flow monitor
+    /// </summary>
+    public ParameterSweep(FlowMonitor flowMonitor)
+    {
+        _flowMonitor = flowMonitor ?? throw new ArgumentNullException(nameof(flowMonitor));
+    }
+
+    /// <summary>
+    /// Grid axes in declaration order (axis 0 varies slowest)
+    /// </summary>
+    public IReadOnlyList<SweepAxis> Axes => _axes;
+
+    /// <summary>
+    /// RNG seed shared by all runs (0 keeps the simulation's current seed)
+    /// </summary>
+    public uint Seed { get; set; }
+
+    /// <summary>
+    /// First RNG run number
+    /// </summary>
+    public ulong FirstRun { get; set; } = 1;
+
+    /// <summary>
+    /// Replications per grid point
+    /// </summary>
+    public uint RunsPerPoint { get; set; } = 1;
+
+    /// <summary>
+    /// Maximum concurrent worker processes (0 = one per hardware thread)
+    /// </summary>
+    public int MaxParallelism { get; set; }
+
+    /// <summary>
+    /// Stop time applied to every run (zero keeps the scenario's own stop)
+    /// </summary>
+    public TimeSpan StopTime { get; set; } = TimeSpan.Zero;
+
+    /// <summary>
+    /// Confidence level for <see cref="MetricSummary.ConfidenceHalfWidth"/>
+    /// </summary>
+    public double ConfidenceLevel { get; set; } = 0.95;
+
+    /// <summary>
+    /// Number of grid points (product of the axis value counts)
+    /// </summary>
+    public int PointCount => _axes.Aggregate(1, (n, a) => checked(n * a.Values.Count));
+
+    /// <summary>
+    /// Adds a grid axis
+    /// </summary>
+    public ParameterSweep AddAxis(string path, string attributeName, params string[] values)
+    {
+        if (string.IsNullOrEmpty(path))
+            throw new ArgumentException("Path cannot be empty", nameof(path));
+        if (string.IsNullOrEmpty(attributeName))
+            throw new ArgumentException("Attribute name cannot be empty", nameof(attributeName));
+        if (values == null || values.Length == 0)
+            throw new ArgumentException("At least one value required", nameof(values));
+
+        _axes.Add(new SweepAxis(path, attributeName, values.ToArray()));
+        return this;
+    }
+
+    /// <summary>
+    /// Runs the sweep (blocks until all runs finish) and returns one result per grid point
+    /// </summary>
+    public unsafe IReadOnlyList<SweepPointResult> Run()
+    {
+        if (RunsPerPoint == 0)
+            throw new InvalidOperationException("RunsPerPoint must be positive");
+        if (MaxParallelism < 0)
+            throw new InvalidOperationException("MaxParallelism cannot be negative");
+
+        var simulation = _flowMonitor.Simulation;
+        int pointCount = PointCount;
+
+        var strings = new List<nint>();
+        nint Utf8(string s)
+        {
+            var ptr = Marshal.StringToCoTaskMemUTF8(s);
+            strings.Add(ptr);
+            return ptr;
+        }
+
+        try
+        {
+            var attrs = new NativeMethods.Ns3Attr[_axes.Sum(a => a.Values.Count)];
+            var axes = new NativeMethods.Ns3SweepAxis[_axes.Count];
+            var summaries = new NativeMethods.Ns3SweepPointSummary[pointCount];
+
+            int next = 0;
+            foreach (var axis in _axes)
+            {
+                foreach (var value in axis.Values)
+                    attrs[next++] = NativeMethods.Ns3Attr.FromString(Utf8(value));
+            }
+
+            fixed (NativeMethods.Ns3Attr* attrPtr = attrs)
+            fixed (NativeMethods.Ns3SweepAxis* axisPtr = axes)
+            fixed (NativeMethods.Ns3SweepPointSummary* outPtr = summaries)
+            {
+                int offset = 0;
+                for (int i = 0; i < _axes.Count; i++)
+                {
+                    axes[i] = new NativeMethods.Ns3SweepAxis
+                    {
+                        Path = Utf8(_axes[i].Path),
+                        AttrName = Utf8(_axes[i].AttributeName),
+                        Values = attrPtr + offset,
+                        ValueCount = (uint)_axes[i].Values.Count
+                    };
+                    offset += _axes[i].Values.Count;
+                }
+
+                var config = new NativeMethods.Ns3SweepConfig
+                {
+                    FlowMon = _flowMonitor.NativeHandle,
+                    Axes = _axes.Count > 0 ? axisPtr : null,
+                    AxisCount = (uint)_axes.Count,
+                    Seed = Seed,
+                    FirstRun = FirstRun,
+                    RunCount = RunsPerPoint,
+                    MaxParallel = (uint)MaxParallelism,
+                    StopTimeSec = StopTime.TotalSeconds,
+                    ConfidenceLevel = ConfidenceLevel
+                };
+
+                var status = simulation.Interop.SimSweepRun(simulation.Handle, &config, outPtr, (uint)pointCount);
+                Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Run));
+            }
+
+            var results = new SweepPointResult[pointCount];
+            for (int i = 0; i < pointCount; i++)
+            {
+                ref readonly var s = ref summaries[i];
+                results[i] = new SweepPointResult(
+                    (int)s.PointIndex,
+                    ValuesAt((int)s.PointIndex),
+                    (int)s.RunsCompleted,
+                    (int)s.RunsFailed,
+                    MetricSummary.FromNative(s.TxPackets),
+                    MetricSummary.FromNative(s.RxPackets),
+                    MetricSummary.FromNative(s.TxBytes),
+                    MetricSummary.FromNative(s.RxBytes),
+                    MetricSummary.FromNative(s.DelaySumSec),
+                    MetricSummary.FromNative(s.JitterSumSec),
+                    MetricSummary.FromNative(s.FlowCount),
+                    MetricSummary.FromNative(s.MeanDelaySec),
+                    MetricSummary.FromNative(s.MeanJitterSec),
+                    MetricSummary.FromNative(s.LossRatio));
+            }
+
+            return results;
+        }
+        finally
+        {
+            foreach (var ptr in strings)
+                Marshal.FreeCoTaskMem(ptr);
+        }
+    }
+
+    /// <summary>
+    /// Decodes a row-major point index into the per-axis values it stands for
+    /// </summary>
+    public IReadOnlyList<string> ValuesAt(int pointIndex)
+    {
+        if (pointIndex < 0 || pointIndex >= PointCount)
+            throw new ArgumentOutOfRangeException(nameof(pointIndex));
+
+        var values = new string[_axes.Count];
+        int rem = pointIndex;
+        for (int a = _axes.Count - 1; a >= 0; a--)
+        {
+            var axisValues = _axes[a].Values;
+            values[a] = axisValues[rem % axisValues.Count];
+            rem /= axisValues.Count;
+        }
+
+        return values;
+    }
+}
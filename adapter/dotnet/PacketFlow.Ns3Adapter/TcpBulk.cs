@@ -0,0 +1,328 @@
+// TcpBulk.cs
+// High-level API for TCP bulk transfers with native goodput, congestion
+// window and RTT summaries
+//
+// Both ends of every transfer are installed in one native call. The shim
+// creates the sockets itself, so each transfer picks its congestion control
+// and buffers, and its cwnd and RTT trace changes are folded into fixed
+// intervals natively instead of reaching managed code one by one.
+
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// TCP congestion control algorithm of a <see cref="TcpFlowSpec"/>
+/// </summary>
+public enum TcpCongestionControl
+{
+    /// <summary>TcpNewReno</summary>
+    NewReno = 0,
+    /// <summary>TcpCubic</summary>
+    Cubic = 1,
+    /// <summary>TcpBbr, with pacing enabled</summary>
+    Bbr = 2,
+    /// <summary>TcpDctcp; needs ECN-marking queue discs on the path</summary>
+    Dctcp = 3,
+}
+
+/// <summary>
+/// State of a TCP bulk transfer
+/// </summary>
+public enum TcpFlowState
+{
+    /// <summary>Sender not started yet</summary>
+    Pending = 0,
+    /// <summary>Connecting or sending</summary>
+    Running = 1,
+    /// <summary>Receiver has every byte of a finite transfer</summary>
+    Complete = 2,
+    /// <summary>Connection refused or reset before completion</summary>
+    Failed = 3,
+    /// <summary>Sender stopped before completion</summary>
+    Stopped = 4,
+}
+
+/// <summary>
+/// One transfer of a <see cref="TcpBulk.Install"/> call
+/// </summary>
+/// <param name="Source">Index into the node list of the sender</param>
+/// <param name="Destination">Index into the node list of the receiver (reached at its first IPv4 address)</param>
+/// <param name="Port">Receiver port, unique per destination within one call</param>
+public readonly record struct TcpFlowSpec(int Source, int Destination, ushort Port)
+{
+    /// <summary>Congestion control at both ends</summary>
+    public TcpCongestionControl CongestionControl { get; init; }
+
+    /// <summary>Initial congestion window in segments (0 = ns-3 default)</summary>
+    public int InitialCwndSegments { get; init; }
+
+    /// <summary>Bytes to send (0 = until the sender stops)</summary>
+    public long Bytes { get; init; }
+
+    /// <summary>Sender start time; the receiver listens from then too</summary>
+    public TimeSpan Start { get; init; }
+
+    /// <summary>Sender stop time (null = run until done or the simulation ends)</summary>
+    public TimeSpan? Stop { get; init; }
+}
+
+/// <summary>
+/// Socket and summary settings of <see cref="TcpBulk.Install"/>; unset properties take the native defaults
+/// </summary>
+public sealed record TcpBulkOptions
+{
+    /// <summary>Bytes per socket write (default 1448)</summary>
+    public int? SendSize { get; init; }
+
+    /// <summary>TCP segment size (default 1448, rather than ns-3's 536)</summary>
+    public int? SegmentSize { get; init; }
+
+    /// <summary>Socket send buffer in bytes (default: ns-3's 128 KiB)</summary>
+    public int? SendBufferBytes { get; init; }
+
+    /// <summary>Socket receive buffer in bytes (default: ns-3's 128 KiB)</summary>
+    public int? ReceiveBufferBytes { get; init; }
+
+    /// <summary>Width of one summary interval (default 100 ms)</summary>
+    public TimeSpan? Interval { get; init; }
+
+    /// <summary>Number of most recent intervals retained per transfer (default 100)</summary>
+    public int? WindowIntervals { get; init; }
+
+    internal NativeMethods.Ns3TcpBulkOptions ToNative()
+    {
+        if (SendSize is <= 0 || SegmentSize is <= 0 || WindowIntervals is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(TcpBulkOptions), "SendSize, SegmentSize and WindowIntervals must be positive");
+        if (SendBufferBytes is <= 0 || ReceiveBufferBytes is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(TcpBulkOptions), "Buffer sizes must be positive");
+        if (Interval is { } interval && interval <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(Interval), Interval, "Interval must be positive");
+
+        return new NativeMethods.Ns3TcpBulkOptions
+        {
+            SendSize = (uint)(SendSize ?? 0),
+            SegmentSize = (uint)(SegmentSize ?? 0),
+            SndBufBytes = (uint)(SendBufferBytes ?? 0),
+            RcvBufBytes = (uint)(ReceiveBufferBytes ?? 0),
+            IntervalSec = Interval?.TotalSeconds ?? 0,
+            WindowIntervals = (uint)(WindowIntervals ?? 0),
+        };
+    }
+}
+
+/// <summary>
+/// Totals of one TCP bulk transfer
+/// </summary>
+/// <param name="State">Progress</param>
+/// <param name="TxBytes">Bytes the sender handed to its socket</param>
+/// <param name="RxBytes">Bytes delivered to the receiver</param>
+/// <param name="Started">Sender start (null while pending)</param>
+/// <param name="FirstRx">First byte delivered (null = none yet)</param>
+/// <param name="LastRx">Latest byte delivered (null = none yet)</param>
+/// <param name="Completed">Last byte of a finite transfer delivered (null = not yet)</param>
+/// <param name="GoodputBitsPerSecond">Delivered bits over start to completion, or to now while incomplete</param>
+/// <param name="Rtt">Latest RTT sample (zero = none yet)</param>
+/// <param name="MinRtt">Smallest RTT sample (zero = none yet)</param>
+/// <param name="CwndBytes">Current congestion window</param>
+/// <param name="MaxCwndBytes">Largest congestion window</param>
+/// <param name="CongestionControl">Congestion control the sender socket runs (NewReno while pending)</param>
+/// <param name="Pacing">Whether the sender socket paces its segments</param>
+public readonly record struct TcpFlowStats(
+    TcpFlowState State,
+    long TxBytes,
+    long RxBytes,
+    TimeSpan? Started,
+    TimeSpan? FirstRx,
+    TimeSpan? LastRx,
+    TimeSpan? Completed,
+    double GoodputBitsPerSecond,
+    TimeSpan Rtt,
+    TimeSpan MinRtt,
+    int CwndBytes,
+    int MaxCwndBytes,
+    TcpCongestionControl CongestionControl,
+    bool Pacing)
+{
+    internal static TcpFlowStats FromNative(in NativeMethods.Ns3TcpFlowStats s) =>
+        new((TcpFlowState)s.State, (long)s.TxBytes, (long)s.RxBytes, Time(s.StartSec), Time(s.FirstRxSec),
+            Time(s.LastRxSec), Time(s.CompleteSec), s.GoodputBps, TimeSpan.FromSeconds(s.RttSec),
+            TimeSpan.FromSeconds(s.MinRttSec), (int)s.CwndBytes, (int)s.MaxCwndBytes,
+            (TcpCongestionControl)s.CongestionControl, s.Pacing != 0);
+
+    private static TimeSpan? Time(double seconds) => seconds < 0 ? null : TimeSpan.FromSeconds(seconds);
+}
+
+/// <summary>
+/// Congestion window, RTT and goodput of one TCP transfer in one interval
+/// </summary>
+/// <param name="RxBytes">Bytes delivered in the interval</param>
+/// <param name="CwndMeanBytes">Time-weighted mean congestion window</param>
+/// <param name="CwndMinBytes">Smallest congestion window</param>
+/// <param name="CwndMaxBytes">Largest congestion window</param>
+/// <param name="RttMean">Time-weighted mean of the latest RTT sample (zero = no sample yet)</param>
+/// <param name="RttMin">Smallest RTT sample in effect</param>
+/// <param name="RttMax">Largest RTT sample in effect</param>
+/// <param name="Covered">Part of the interval the transfer was running (zero when it was not)</param>
+public readonly record struct TcpIntervalSummary(
+    long RxBytes,
+    double CwndMeanBytes,
+    int CwndMinBytes,
+    int CwndMaxBytes,
+    TimeSpan RttMean,
+    TimeSpan RttMin,
+    TimeSpan RttMax,
+    TimeSpan Covered)
+{
+    /// <summary>Goodput over the covered part of the interval</summary>
+    public double GoodputBitsPerSecond => Covered > TimeSpan.Zero ? RxBytes * 8 / Covered.TotalSeconds : 0;
+
+    internal static TcpIntervalSummary FromNative(in NativeMethods.Ns3TcpBin b) =>
+        new((long)b.RxBytes, b.CwndMeanBytes, (int)b.CwndMinBytes, (int)b.CwndMaxBytes,
+            TimeSpan.FromSeconds(b.RttMeanSec), TimeSpan.FromSeconds(b.RttMinSec), TimeSpan.FromSeconds(b.RttMaxSec),
+            TimeSpan.FromSeconds(b.CoveredSec));
+}
+
+/// <summary>
+/// Snapshot of a <see cref="TcpBulk"/>
+/// </summary>
+/// <param name="Flows">Totals per transfer, in spec order</param>
+/// <param name="FirstInterval">Absolute index of column 0 (interval i covers [i, i + 1) x Interval)</param>
+/// <param name="Interval">Width of one interval</param>
+/// <param name="Intervals">Summaries indexed [transfer, interval]</param>
+public sealed record TcpBulkReport(
+    IReadOnlyList<TcpFlowStats> Flows,
+    long FirstInterval,
+    TimeSpan Interval,
+    TcpIntervalSummary[,] Intervals)
+{
+    /// <summary>
+    /// Start time of an interval column
+    /// </summary>
+    public TimeSpan IntervalStart(int column) => Interval * (FirstInterval + column);
+}
+
+/// <summary>
+/// TCP bulk transfers with per-flow congestion control and native goodput, cwnd and RTT summaries
+/// </summary>
+/// <remarks>
+/// Each transfer is a BulkSend-style sender that keeps its send buffer full
+/// and a PacketSink-style receiver. Congestion window and RTT changes are
+/// reduced natively to min/max/mean per interval; no callback reaches
+/// managed code. DCTCP needs queue discs on the path that mark ECN.
+/// </remarks>
+public sealed class TcpBulk
+{
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+
+    private TcpBulk(Simulation simulation, nint handle, IReadOnlyList<Application> senders)
+    {
+        _simulation = simulation;
+        _handle = handle;
+        Senders = senders;
+    }
+
+    /// <summary>
+    /// Sender application per spec, e.g. to stop a transfer early
+    /// </summary>
+    public IReadOnlyList<Application> Senders { get; }
+
+    /// <summary>
+    /// Installs every transfer in one native call
+    /// </summary>
+    /// <remarks>
+    /// All specs are validated natively before anything is installed, so on
+    /// error nothing is. Assign IPv4 addresses first.
+    /// </remarks>
+    /// <param name="simulation">Simulation to install into</param>
+    /// <param name="nodes">Nodes the specs refer to by index</param>
+    /// <param name="specs">Transfers</param>
+    /// <param name="options">Socket and summary settings (null = defaults)</param>
+    public static unsafe TcpBulk Install(Simulation simulation, IReadOnlyList<Node> nodes,
+        IReadOnlyList<TcpFlowSpec> specs, TcpBulkOptions? options = null)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        ArgumentNullException.ThrowIfNull(nodes);
+        ArgumentNullException.ThrowIfNull(specs);
+        if (specs.Count == 0)
+            throw new ArgumentException("At least one transfer is required", nameof(specs));
+
+        var nodeHandles = new nint[nodes.Count];
+        for (int i = 0; i < nodeHandles.Length; i++)
+            nodeHandles[i] = nodes[i].NativeHandle;
+
+        var nativeSpecs = new NativeMethods.Ns3TcpFlowSpec[specs.Count];
+        for (int i = 0; i < nativeSpecs.Length; i++)
+            nativeSpecs[i] = ToNative(specs[i], nodes.Count);
+        var nativeOptions = options?.ToNative() ?? default;
+
+        var senderHandles = new nint[specs.Count];
+        NativeMethods.Ns3Status status;
+        nint handle;
+        fixed (nint* nodePtr = nodeHandles)
+        fixed (NativeMethods.Ns3TcpFlowSpec* specPtr = nativeSpecs)
+        fixed (nint* senderPtr = senderHandles)
+        {
+            status = simulation.Interop.TcpBulkInstall(simulation.Handle, nodePtr, (uint)nodeHandles.Length, specPtr,
+                (uint)nativeSpecs.Length, options != null ? &nativeOptions : null, senderPtr, out handle);
+        }
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Install));
+
+        var senders = new Application[senderHandles.Length];
+        for (int i = 0; i < senders.Length; i++)
+            senders[i] = new Application(simulation, new AppHandle(senderHandles[i]));
+        return new TcpBulk(simulation, handle, senders);
+    }
+
+    /// <summary>
+    /// Copies the totals and the interval window (ending at the current simulation time)
+    /// </summary>
+    public unsafe TcpBulkReport Export()
+    {
+        var status = _simulation.Interop.TcpBulkExport(_simulation.Handle, _handle, null, 0, null, 0,
+            out NativeMethods.Ns3ThroughputInfo info);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Export));
+
+        var stats = new NativeMethods.Ns3TcpFlowStats[info.DeviceCount];
+        var cells = new NativeMethods.Ns3TcpBin[(long)info.DeviceCount * info.BinCount];
+        fixed (NativeMethods.Ns3TcpFlowStats* statsPtr = stats)
+        fixed (NativeMethods.Ns3TcpBin* cellPtr = cells)
+        {
+            status = _simulation.Interop.TcpBulkExport(_simulation.Handle, _handle, statsPtr, (uint)stats.Length,
+                cellPtr, (uint)cells.Length, out info);
+        }
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Export));
+
+        int binCount = (int)info.BinCount;
+        var intervals = new TcpIntervalSummary[stats.Length, binCount];
+        for (int row = 0; row < stats.Length; row++)
+            for (int col = 0; col < binCount; col++)
+                intervals[row, col] = TcpIntervalSummary.FromNative(cells[row * binCount + col]);
+
+        return new TcpBulkReport(Array.ConvertAll(stats, s => TcpFlowStats.FromNative(s)),
+            (long)info.FirstBin, TimeSpan.FromSeconds(info.BinWidthSec), intervals);
+    }
+
+    private static NativeMethods.Ns3TcpFlowSpec ToNative(in TcpFlowSpec spec, int nodeCount)
+    {
+        if ((uint)spec.Source >= (uint)nodeCount || (uint)spec.Destination >= (uint)nodeCount)
+            throw new ArgumentOutOfRangeException(nameof(spec), "Node index out of range");
+        if (spec.Bytes < 0 || spec.InitialCwndSegments < 0)
+            throw new ArgumentOutOfRangeException(nameof(spec), "Bytes and InitialCwndSegments must not be negative");
+        if (!Enum.IsDefined(spec.CongestionControl))
+            throw new ArgumentOutOfRangeException(nameof(spec), spec.CongestionControl, "Unknown congestion control");
+
+        return new NativeMethods.Ns3TcpFlowSpec
+        {
+            SrcNode = (uint)spec.Source,
+            DstNode = (uint)spec.Destination,
+            Port = spec.Port,
+            CongestionControl = (ushort)spec.CongestionControl,
+            InitialCwndSegments = (uint)spec.InitialCwndSegments,
+            Bytes = (ulong)spec.Bytes,
+            StartSec = spec.Start.TotalSeconds,
+            StopSec = spec.Stop?.TotalSeconds ?? 0,
+        };
+    }
+}
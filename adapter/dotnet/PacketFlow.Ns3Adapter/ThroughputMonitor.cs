@@ -0,0 +1,145 @@
+// ThroughputMonitor.cs
+// High-level API for native time-binned throughput accumulation
+//
+// Per-device TX/RX bytes and packets are summed into fixed-width time bins
+// inside the native PHY trace sinks; the managed side only sees the final
+// [device x bin] matrix, fetched in a single call.
+
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// Traffic counted in one time bin of one device
+/// </summary>
+public readonly record struct BinCounts(long TxBytes, long RxBytes, int TxPackets, int RxPackets)
+{
+    internal static BinCounts FromNative(in NativeMethods.Ns3BinCounts c) =>
+        new((long)c.TxBytes, (long)c.RxBytes, (int)c.TxPackets, (int)c.RxPackets);
+}
+
+/// <summary>
+/// Snapshot of a <see cref="ThroughputMonitor"/> window
+/// </summary>
+/// <param name="Devices">Matrix rows, in attach order</param>
+/// <param name="FirstBin">Absolute index of column 0 (bin i covers [i, i + 1) x BinWidth)</param>
+/// <param name="BinWidth">Width of one bin</param>
+/// <param name="Bins">Counts indexed [device, bin]</param>
+public sealed record ThroughputMatrix(IReadOnlyList<Device> Devices, long FirstBin, TimeSpan BinWidth, BinCounts[,] Bins)
+{
+    /// <summary>
+    /// Start time of a matrix column
+    /// </summary>
+    public TimeSpan BinStart(int column) => BinWidth * (FirstBin + column);
+
+    /// <summary>
+    /// Transmit rate of one cell in bits per second
+    /// </summary>
+    public double TxBitsPerSecond(int device, int column) => Bins[device, column].TxBytes * 8.0 / BinWidth.TotalSeconds;
+
+    /// <summary>
+    /// Receive rate of one cell in bits per second
+    /// </summary>
+    public double RxBitsPerSecond(int device, int column) => Bins[device, column].RxBytes * 8.0 / BinWidth.TotalSeconds;
+}
+
+/// <summary>
+/// Native per-device throughput accumulator over a rolling window of time bins
+/// </summary>
+public sealed class ThroughputMonitor
+{
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+    private readonly List<Device> _devices = new();
+
+    private ThroughputMonitor(Simulation simulation, nint handle, TimeSpan binWidth, int windowBins)
+    {
+        _simulation = simulation;
+        _handle = handle;
+        BinWidth = binWidth;
+        WindowBins = windowBins;
+    }
+
+    /// <summary>
+    /// Width of one bin
+    /// </summary>
+    public TimeSpan BinWidth { get; }
+
+    /// <summary>
+    /// Number of most recent bins retained per device
+    /// </summary>
+    public int WindowBins { get; }
+
+    /// <summary>
+    /// Attached devices, in matrix row order
+    /// </summary>
+    public IReadOnlyList<Device> Devices => _devices;
+
+    /// <summary>
+    /// Creates a throughput monitor; memory is devices x windowBins cells however long the run
+    /// </summary>
+    /// <param name="simulation">Simulation whose devices will be monitored</param>
+    /// <param name="binWidth">Width of one bin</param>
+    /// <param name="windowBins">Number of most recent bins retained</param>
+    public static ThroughputMonitor Create(Simulation simulation, TimeSpan binWidth, int windowBins)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        if (binWidth <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(binWidth), "Bin width must be positive");
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(windowBins);
+
+        var status = simulation.Interop.ThroughputCreate(simulation.Handle, binWidth.TotalSeconds, (uint)windowBins, out nint handle);
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Create));
+        return new ThroughputMonitor(simulation, handle, binWidth, windowBins);
+    }
+
+    /// <summary>
+    /// Starts counting TX/RX traffic of the given devices (each at most once)
+    /// </summary>
+    public ThroughputMonitor Attach(params Device[] devices)
+    {
+        ArgumentNullException.ThrowIfNull(devices);
+
+        foreach (var device in devices)
+        {
+            ArgumentNullException.ThrowIfNull(device);
+            var status = _simulation.Interop.ThroughputAttach(_simulation.Handle, _handle, device.NativeHandle);
+            Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Attach));
+            _devices.Add(device);
+        }
+        return this;
+    }
+
+    /// <summary>
+    /// Copies the current window (ending at the current simulation time) into a matrix
+    /// </summary>
+    public unsafe ThroughputMatrix Export()
+    {
+        var status = _simulation.Interop.ThroughputExport(_simulation.Handle, _handle, null, 0, null, 0,
+            out NativeMethods.Ns3ThroughputInfo info);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Export));
+
+        var handles = new nint[info.DeviceCount];
+        var cells = new NativeMethods.Ns3BinCounts[(long)info.DeviceCount * info.BinCount];
+        fixed (nint* handlePtr = handles)
+        fixed (NativeMethods.Ns3BinCounts* cellPtr = cells)
+        {
+            status = _simulation.Interop.ThroughputExport(_simulation.Handle, _handle,
+                handlePtr, (uint)handles.Length, cellPtr, (uint)cells.Length, out info);
+        }
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Export));
+
+        var devices = new Device[handles.Length];
+        for (int row = 0; row < handles.Length; row++)
+            devices[row] = _devices.Find(d => d.NativeHandle == handles[row])
+                ?? throw new InvalidOperationException("Native throughput monitor reported an unknown device");
+
+        int binCount = (int)info.BinCount;
+        var bins = new BinCounts[devices.Length, binCount];
+        for (int row = 0; row < devices.Length; row++)
+            for (int col = 0; col < binCount; col++)
+                bins[row, col] = BinCounts.FromNative(cells[row * binCount + col]);
+
+        return new ThroughputMatrix(devices, (long)info.FirstBin, TimeSpan.FromSeconds(info.BinWidthSec), bins);
+    }
+}
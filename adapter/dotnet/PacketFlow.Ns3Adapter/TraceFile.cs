@@ -0,0 +1,281 @@
+// TraceFile.cs
+// High-level API for native columnar packet trace files
+//
+// TraceFile captures packet events straight to disk from native code, with
+// no managed callback per packet. TraceFileReader memory-maps a closed file
+// and reads whole columns for analysis.
+
+using System.IO.MemoryMappedFiles;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// A native columnar packet trace file being written
+/// </summary>
+public sealed class TraceFile : IDisposable
+{
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+    private bool _closed;
+
+    private TraceFile(Simulation simulation, nint handle, string path)
+    {
+        _simulation = simulation;
+        _handle = handle;
+        Path = path;
+    }
+
+    /// <summary>
+    /// Trace file path
+    /// </summary>
+    public string Path { get; }
+
+    /// <summary>
+    /// Creates (truncates) a trace file
+    /// </summary>
+    /// <param name="simulation">Simulation whose devices will be traced</param>
+    /// <param name="path">Output file</param>
+    /// <param name="directIo">Bypass the page cache with O_DIRECT where supported</param>
+    /// <param name="includeHeaders">Also record IPv4 protocol, TTL, addresses and TCP/UDP ports</param>
+    public static TraceFile Open(Simulation simulation, string path, bool directIo = false, bool includeHeaders = false)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        ArgumentException.ThrowIfNullOrEmpty(path);
+
+        uint flags = (directIo ? NativeMethods.TraceFileDirect : 0u) | (includeHeaders ? NativeMethods.TraceFileHeaders : 0u);
+        var status = simulation.Interop.TraceFileOpen(simulation.Handle, path, flags, out nint handle);
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Open));
+        return new TraceFile(simulation, handle, path);
+    }
+
+    /// <summary>
+    /// Records TX/RX events of the given devices
+    /// </summary>
+    public TraceFile Attach(params Device[] devices)
+    {
+        ArgumentNullException.ThrowIfNull(devices);
+        if (_closed)
+            throw new InvalidOperationException("Trace file is closed");
+
+        foreach (var device in devices)
+        {
+            ArgumentNullException.ThrowIfNull(device);
+            var status = _simulation.Interop.TraceFileAttach(_simulation.Handle, _handle, device.NativeHandle);
+            Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Attach));
+        }
+        return this;
+    }
+
+    /// <summary>
+    /// Flushes and closes the file, writing its index
+    /// </summary>
+    /// <returns>Number of events written</returns>
+    public long Close()
+    {
+        if (_closed)
+            throw new InvalidOperationException("Trace file is closed");
+
+        _closed = true;
+        var status = _simulation.Interop.TraceFileClose(_simulation.Handle, _handle, out ulong records);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Close));
+        return (long)records;
+    }
+
+    /// <summary>
+    /// Closes the file if still open (errors are ignored; use <see cref="Close"/> to observe them)
+    /// </summary>
+    public void Dispose()
+    {
+        if (_closed) return;
+        _closed = true;
+        _simulation.Interop.TraceFileClose(_simulation.Handle, _handle, out _);
+    }
+}
+
+/// <summary>
+/// One block of a trace file
+/// </summary>
+/// <param name="FirstRecord">Index of the block's first record</param>
+/// <param name="Records">Records in the block</param>
+/// <param name="MinTime">Earliest event time in the block</param>
+/// <param name="MaxTime">Latest event time in the block</param>
+public readonly record struct TraceFileBlock(long FirstRecord, int Records, TimeSpan MinTime, TimeSpan MaxTime);
+
+/// <summary>
+/// Reads a closed trace file through a memory mapping, one column at a time
+/// </summary>
+public sealed class TraceFileReader : IDisposable
+{
+    private const int BaseColumnCount = 5;
+    private const int ColumnDescriptorSize = 20;
+    private const int HeaderFixedSize = 16;
+    private const int TrailerSize = 16;
+    private static readonly byte[] Magic = "NS3T"u8.ToArray();
+    // Base columns, then the optional header columns
+    private static readonly byte[] ColumnWidths = { 8, 8, 4, 1, 8, 1, 1, 4, 4, 2, 2 };
+
+    private readonly MemoryMappedFile _file;
+    private readonly MemoryMappedViewAccessor _view;
+    private readonly long[][] _offsets;
+
+    private TraceFileReader(MemoryMappedFile file, MemoryMappedViewAccessor view, long recordCount,
+        TraceFileBlock[] blocks, long[][] offsets, bool hasHeaderColumns)
+    {
+        _file = file;
+        _view = view;
+        RecordCount = recordCount;
+        Blocks = blocks;
+        _offsets = offsets;
+        HasHeaderColumns = hasHeaderColumns;
+    }
+
+    /// <summary>
+    /// Total number of records
+    /// </summary>
+    public long RecordCount { get; }
+
+    /// <summary>
+    /// Whether the file was written with header columns
+    /// </summary>
+    public bool HasHeaderColumns { get; }
+
+    /// <summary>
+    /// Block index from the file footer
+    /// </summary>
+    public IReadOnlyList<TraceFileBlock> Blocks { get; }
+
+    /// <summary>
+    /// Opens a trace file written by <see cref="TraceFile"/>
+    /// </summary>
+    /// <exception cref="InvalidDataException">The file is not a closed trace file</exception>
+    public static TraceFileReader Open(string path)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(path);
+
+        long length = new FileInfo(path).Length;
+        if (length < HeaderFixedSize + TrailerSize)
+            throw new InvalidDataException($"'{path}' is not a trace file");
+
+        var file = MemoryMappedFile.CreateFromFile(path, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+        var view = file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+        try
+        {
+            CheckMagic(view, 0, path);
+            if (view.ReadUInt16(4) != 1)
+                throw new InvalidDataException($"'{path}': unsupported trace file version {view.ReadUInt16(4)}");
+            int columnCount = view.ReadUInt16(6);
+            if (columnCount != BaseColumnCount && columnCount != ColumnWidths.Length)
+                throw new InvalidDataException($"'{path}': unexpected column count");
+            for (int c = 0; c < columnCount; c++)
+            {
+                if (view.ReadByte(HeaderFixedSize + c * ColumnDescriptorSize + 17) != ColumnWidths[c])
+                    throw new InvalidDataException($"'{path}': unexpected layout of column {c}");
+            }
+
+            CheckMagic(view, length - 4, path);
+            long footerOffset = view.ReadInt64(length - TrailerSize);
+            uint footerSize = view.ReadUInt32(length - 8);
+            if (footerOffset < 0 || footerOffset + footerSize + TrailerSize != length)
+                throw new InvalidDataException($"'{path}': corrupt trace file footer");
+
+            long recordCount = view.ReadInt64(footerOffset);
+            int blockCount = (int)view.ReadUInt32(footerOffset + 8);
+            int blockEntrySize = 32 + 8 * columnCount;
+            if (16L + (long)blockCount * blockEntrySize != footerSize)
+                throw new InvalidDataException($"'{path}': corrupt trace file footer");
+
+            var blocks = new TraceFileBlock[blockCount];
+            var offsets = new long[blockCount][];
+            long entry = footerOffset + 16;
+            for (int b = 0; b < blockCount; b++, entry += blockEntrySize)
+            {
+                blocks[b] = new TraceFileBlock(
+                    view.ReadInt64(entry),
+                    (int)view.ReadUInt32(entry + 8),
+                    TimeSpan.FromSeconds(view.ReadDouble(entry + 16)),
+                    TimeSpan.FromSeconds(view.ReadDouble(entry + 24)));
+                offsets[b] = new long[columnCount];
+                for (int c = 0; c < columnCount; c++)
+                    offsets[b][c] = view.ReadInt64(entry + 32 + 8 * c);
+            }
+
+            return new TraceFileReader(file, view, recordCount, blocks, offsets, columnCount > BaseColumnCount);
+        }
+        catch
+        {
+            view.Dispose();
+            file.Dispose();
+            throw;
+        }
+    }
+
+    /// <summary>Event times in seconds</summary>
+    public double[] ReadTimes() => ReadColumn<double>(0);
+
+    /// <summary>Native device handle ids</summary>
+    public ulong[] ReadDeviceIds() => ReadColumn<ulong>(1);
+
+    /// <summary>Packet sizes in bytes</summary>
+    public uint[] ReadSizes() => ReadColumn<uint>(2);
+
+    /// <summary>Directions: 0 = transmit, 1 = receive</summary>
+    public byte[] ReadDirections() => ReadColumn<byte>(3);
+
+    /// <summary>ns-3 packet uids</summary>
+    public ulong[] ReadUids() => ReadColumn<ulong>(4);
+
+    /// <summary>IP protocol numbers (0 if not IPv4); requires <see cref="HasHeaderColumns"/></summary>
+    public byte[] ReadProtocols() => ReadHeaderColumn<byte>(5);
+
+    /// <summary>IPv4 TTLs; requires <see cref="HasHeaderColumns"/></summary>
+    public byte[] ReadTtls() => ReadHeaderColumn<byte>(6);
+
+    /// <summary>IPv4 sources, host byte order; requires <see cref="HasHeaderColumns"/></summary>
+    public uint[] ReadSourceAddresses() => ReadHeaderColumn<uint>(7);
+
+    /// <summary>IPv4 destinations, host byte order; requires <see cref="HasHeaderColumns"/></summary>
+    public uint[] ReadDestinationAddresses() => ReadHeaderColumn<uint>(8);
+
+    /// <summary>TCP/UDP source ports (0 if absent); requires <see cref="HasHeaderColumns"/></summary>
+    public ushort[] ReadSourcePorts() => ReadHeaderColumn<ushort>(9);
+
+    /// <summary>TCP/UDP destination ports (0 if absent); requires <see cref="HasHeaderColumns"/></summary>
+    public ushort[] ReadDestinationPorts() => ReadHeaderColumn<ushort>(10);
+
+    /// <summary>
+    /// Releases the mapping
+    /// </summary>
+    public void Dispose()
+    {
+        _view.Dispose();
+        _file.Dispose();
+    }
+
+    private T[] ReadHeaderColumn<T>(int column) where T : struct
+    {
+        if (!HasHeaderColumns)
+            throw new InvalidOperationException("Trace file has no header columns");
+        return ReadColumn<T>(column);
+    }
+
+    private T[] ReadColumn<T>(int column) where T : struct
+    {
+        var values = new T[RecordCount];
+        for (int b = 0; b < Blocks.Count; b++)
+        {
+            var block = Blocks[b];
+            _view.ReadArray(_offsets[b][column], values, (int)block.FirstRecord, block.Records);
+        }
+        return values;
+    }
+
+    private static void CheckMagic(MemoryMappedViewAccessor view, long position, string path)
+    {
+        for (int i = 0; i < Magic.Length; i++)
+        {
+            if (view.ReadByte(position + i) != Magic[i])
+                throw new InvalidDataException($"'{path}' is not a trace file (or was not closed)");
+        }
+    }
+}
@@ -0,0 +1,108 @@
+// TraceFilter.cs
+// Native packet filter for device traces
+//
+// A TraceFilter is compiled into the shim and evaluated in the PHY trace
+// sinks, so packets outside the analysis never cross into managed code or
+// reach a trace file.
+
+using System.Net;
+using System.Net.Sockets;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// Inclusive port range
+/// </summary>
+public readonly record struct PortRange(int Min, int Max)
+{
+    /// <summary>
+    /// A single port
+    /// </summary>
+    public static PortRange Single(int port) => new(port, port);
+}
+
+/// <summary>
+/// Packet filter for <see cref="Device.SetTraceFilter"/>; unset properties do not constrain
+/// </summary>
+/// <remarks>
+/// Sizes include link-layer headers. Protocol, address and port conditions reject
+/// non-IPv4 frames; port conditions also reject packets other than TCP/UDP first fragments.
+/// </remarks>
+public sealed record TraceFilter
+{
+    /// <summary>Smallest packet size in bytes</summary>
+    public int? MinSize { get; init; }
+
+    /// <summary>Largest packet size in bytes</summary>
+    public int? MaxSize { get; init; }
+
+    /// <summary>IP protocol number (6 = TCP, 17 = UDP)</summary>
+    public int? Protocol { get; init; }
+
+    /// <summary>IPv4 source prefix</summary>
+    public IPNetwork? Source { get; init; }
+
+    /// <summary>IPv4 destination prefix</summary>
+    public IPNetwork? Destination { get; init; }
+
+    /// <summary>Source port range</summary>
+    public PortRange? SourcePorts { get; init; }
+
+    /// <summary>Destination port range</summary>
+    public PortRange? DestinationPorts { get; init; }
+
+    /// <summary>
+    /// Keep one in N packets, selected by packet uid so that a sampled packet
+    /// is kept on every device it crosses
+    /// </summary>
+    public int SampleEvery { get; init; } = 1;
+
+    internal NativeMethods.Ns3TraceFilter ToNative()
+    {
+        var native = new NativeMethods.Ns3TraceFilter
+        {
+            MinSize = (uint)CheckRange(MinSize ?? 0, int.MaxValue, nameof(MinSize)),
+            MaxSize = (uint)CheckRange(MaxSize ?? 0, int.MaxValue, nameof(MaxSize)),
+            Protocol = (byte)CheckRange(Protocol ?? 0, 255, nameof(Protocol)),
+            SampleEvery = (uint)CheckRange(SampleEvery, int.MaxValue, nameof(SampleEvery)),
+        };
+        if (MaxSize.HasValue && MaxSize < (MinSize ?? 0))
+            throw new ArgumentException("MaxSize is smaller than MinSize");
+
+        (native.SrcAddr, native.SrcMask) = ToPrefix(Source, nameof(Source));
+        (native.DstAddr, native.DstMask) = ToPrefix(Destination, nameof(Destination));
+        (native.SrcPortMin, native.SrcPortMax) = ToPorts(SourcePorts, nameof(SourcePorts));
+        (native.DstPortMin, native.DstPortMax) = ToPorts(DestinationPorts, nameof(DestinationPorts));
+        return native;
+    }
+
+    private static int CheckRange(int value, int max, string name)
+    {
+        if (value < 0 || value > max)
+            throw new ArgumentOutOfRangeException(name, value, $"{name} must be between 0 and {max}");
+        return value;
+    }
+
+    private static (uint Address, uint Mask) ToPrefix(IPNetwork? network, string name)
+    {
+        if (network is not { } n)
+            return (0, 0);
+        if (n.BaseAddress.AddressFamily != AddressFamily.InterNetwork)
+            throw new ArgumentException($"{name} must be an IPv4 prefix", name);
+
+        var bytes = n.BaseAddress.GetAddressBytes();
+        uint address = (uint)(bytes[0] << 24 | bytes[1] << 16 | bytes[2] << 8 | bytes[3]);
+        uint mask = n.PrefixLength == 0 ? 0 : uint.MaxValue << (32 - n.PrefixLength);
+        return (address & mask, mask);
+    }
+
+    private static (ushort Min, ushort Max) ToPorts(PortRange? range, string name)
+    {
+        if (range is not { } r)
+            return (0, 0);
+        if (r.Min < 0 || r.Max > ushort.MaxValue || r.Min > r.Max)
+            throw new ArgumentOutOfRangeException(name, r, "Invalid port range");
+        return ((ushort)r.Min, (ushort)r.Max);
+    }
+}
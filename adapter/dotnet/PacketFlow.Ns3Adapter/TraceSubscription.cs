@@ -0,0 +1,89 @@
+// TraceSubscription.cs
+// Handle to a packet event subscription
+//
+// Ending a subscription disconnects its native trace sinks and frees the
+// delegate handles, so tracing can be switched on for a window of interest
+// and off again without the callbacks piling up for the rest of the run.
+
+using System.Runtime.InteropServices;
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// An active packet event subscription (see <see cref="Device.SubscribeToPacketEvents"/>)
+/// </summary>
+public sealed class TraceSubscription : IDisposable
+{
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+    private readonly GCHandle? _txHandle;
+    private readonly GCHandle? _rxHandle;
+
+    internal TraceSubscription(Simulation simulation, nint handle, GCHandle? txHandle, GCHandle? rxHandle)
+    {
+        _simulation = simulation;
+        _handle = handle;
+        _txHandle = txHandle;
+        _rxHandle = rxHandle;
+
+        if (txHandle.HasValue)
+            simulation.RegisterTraceHandle(txHandle.Value);
+        if (rxHandle.HasValue)
+            simulation.RegisterTraceHandle(rxHandle.Value);
+    }
+
+    /// <summary>
+    /// Whether the callbacks are still subscribed
+    /// </summary>
+    public bool IsActive { get; private set; } = true;
+
+    /// <summary>
+    /// Stops the callbacks; none is invoked after this returns. May be called
+    /// from inside one of the subscription's own callbacks.
+    /// </summary>
+    public void Unsubscribe()
+    {
+        if (!IsActive)
+            throw new InvalidOperationException("Subscription has already ended");
+        if (_simulation.IsDisposed)
+            throw new ObjectDisposedException(nameof(Simulation));
+
+        var status = _simulation.Interop.TraceUnsubscribe(_simulation.Handle, _handle);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(Unsubscribe));
+        Release();
+    }
+
+    /// <summary>
+    /// Ends the subscription if still active (errors are ignored; use <see cref="Unsubscribe"/> to observe them)
+    /// </summary>
+    public void Dispose()
+    {
+        if (!IsActive) return;
+
+        // A disposed simulation has already disconnected everything and freed the handles
+        if (!_simulation.IsDisposed &&
+            _simulation.Interop.TraceUnsubscribe(_simulation.Handle, _handle) == NativeMethods.Ns3Status.Ok)
+        {
+            Release();
+        }
+        IsActive = false;
+    }
+
+    private void Release()
+    {
+        IsActive = false;
+        if (_txHandle.HasValue)
+            _simulation.ReleaseTraceHandle(_txHandle.Value);
+        if (_rxHandle.HasValue)
+            _simulation.ReleaseTraceHandle(_rxHandle.Value);
+    }
+}
+
+/// <summary>
+/// Packet event subscription counters of a simulation
+/// </summary>
+/// <param name="Subscriptions">Subscriptions not yet ended</param>
+/// <param name="Contexts">Native callback contexts in use (freed once the trace sinks disconnect)</param>
+/// <param name="ContextCapacity">Context slots allocated; slots of ended subscriptions are reused first</param>
+public readonly record struct TraceStats(int Subscriptions, int Contexts, int ContextCapacity);
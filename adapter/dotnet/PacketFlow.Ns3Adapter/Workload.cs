@@ -0,0 +1,182 @@
+// Workload.cs
+// High-level API for workload-driven TCP flow launching
+//
+// A workload file lists finite transfers sorted by start time. The native
+// side maps the file and creates sender/receiver state only while a flow
+// runs, so workloads with millions of short flows cost memory in proportion
+// to the flows in flight rather than one Application per flow.
+
+using PacketFlow.Ns3Adapter.Interop;
+
+namespace PacketFlow.Ns3Adapter;
+
+/// <summary>
+/// One transfer of a workload file
+/// </summary>
+/// <param name="Start">Simulation time the flow starts</param>
+/// <param name="Source">Index into the workload's node list of the sender</param>
+/// <param name="Destination">Index into the workload's node list of the receiver</param>
+/// <param name="Bytes">Payload bytes to transfer</param>
+public readonly record struct WorkloadFlow(TimeSpan Start, int Source, int Destination, long Bytes);
+
+/// <summary>
+/// Progress of a <see cref="Workload"/>
+/// </summary>
+/// <param name="Records">Flows in the file</param>
+/// <param name="Started">Flows started so far</param>
+/// <param name="Completed">Flows whose last byte was received</param>
+/// <param name="Failed">Flows whose connection failed or could not be opened</param>
+/// <param name="Skipped">Records with a node index out of range or the same source and destination</param>
+/// <param name="Active">Flows running now</param>
+/// <param name="PeakActive">Most flows running at once; flow state is allocated for this many</param>
+/// <param name="BytesDelivered">Payload bytes received across all flows</param>
+/// <param name="MeanCompletionSeconds">Mean completion time of the completed flows</param>
+/// <param name="MaxCompletionSeconds">Longest completion time</param>
+public sealed record WorkloadStats(
+    long Records,
+    long Started,
+    long Completed,
+    long Failed,
+    long Skipped,
+    int Active,
+    int PeakActive,
+    long BytesDelivered,
+    double MeanCompletionSeconds,
+    double MaxCompletionSeconds);
+
+/// <summary>
+/// TCP transfers launched from a memory-mapped workload file as their start times come
+/// </summary>
+/// <remarks>
+/// No <see cref="Application"/> is created per flow: a flow gets a sender
+/// socket when it starts and both ends are recycled once the receiver has
+/// the last byte. Finished senders leave TCP TIME_WAIT after 2 ms of
+/// simulated time, but a source node can still have at most about 16,000
+/// flows (its ephemeral ports) running or in TIME_WAIT at once; further
+/// flows count as <see cref="WorkloadStats.Failed"/>. Each destination node
+/// listens on <see cref="Port"/>.
+/// Combine with <see cref="FlowCompletionTimes"/> for per-flow results.
+/// Requires a POSIX platform.
+/// </remarks>
+public sealed class Workload
+{
+    /// <summary>Receiver port when none is given</summary>
+    public const ushort DefaultPort = 9000;
+
+    /// <summary>Bytes per socket write when none is given</summary>
+    public const int DefaultSendSize = 1448;
+
+    private const ushort FormatVersion = 1;
+    private const ushort RecordBytes = 24;
+
+    private readonly Simulation _simulation;
+    private readonly nint _handle;
+
+    private Workload(Simulation simulation, nint handle, string path, ushort port)
+    {
+        _simulation = simulation;
+        _handle = handle;
+        Path = path;
+        Port = port;
+    }
+
+    /// <summary>Workload file</summary>
+    public string Path { get; }
+
+    /// <summary>TCP port the receivers listen on</summary>
+    public ushort Port { get; }
+
+    /// <summary>
+    /// Writes a workload file
+    /// </summary>
+    /// <remarks>
+    /// Flows are streamed to disk, so the sequence may be generated lazily.
+    /// If it turns out to be invalid part way, the file is left with no
+    /// records.
+    /// </remarks>
+    /// <param name="path">File to create or overwrite</param>
+    /// <param name="flows">Flows in non-decreasing start time order</param>
+    /// <returns>Number of flows written</returns>
+    public static long WriteFile(string path, IEnumerable<WorkloadFlow> flows)
+    {
+        ArgumentNullException.ThrowIfNull(path);
+        ArgumentNullException.ThrowIfNull(flows);
+
+        using var stream = new FileStream(path, FileMode.Create, FileAccess.Write, FileShare.None, 1 << 16);
+        using var writer = new BinaryWriter(stream);
+        writer.Write("NS3W"u8);
+        writer.Write(FormatVersion);
+        writer.Write(RecordBytes);
+        writer.Write(0UL);  // record count, patched below
+
+        long count = 0;
+        var previous = TimeSpan.Zero;
+        foreach (var flow in flows)
+        {
+            if (flow.Start < previous)
+                throw new ArgumentException($"Flow {count} starts before its predecessor", nameof(flows));
+            if (flow.Source < 0 || flow.Destination < 0 || flow.Bytes < 0)
+                throw new ArgumentOutOfRangeException(nameof(flows), $"Flow {count} has a negative node index or size");
+            writer.Write(flow.Start.TotalSeconds);
+            writer.Write((uint)flow.Source);
+            writer.Write((uint)flow.Destination);
+            writer.Write((ulong)flow.Bytes);
+            previous = flow.Start;
+            count++;
+        }
+
+        writer.Seek(8, SeekOrigin.Begin);
+        writer.Write((ulong)count);
+        return count;
+    }
+
+    /// <summary>
+    /// Maps a workload file and schedules its first flow
+    /// </summary>
+    /// <param name="simulation">Simulation to run the flows in</param>
+    /// <param name="path">Workload file (see <see cref="WriteFile"/>)</param>
+    /// <param name="nodes">Nodes the records refer to by index; assign IPv4 addresses before the first flow starts</param>
+    /// <param name="port">Receiver port (null = <see cref="DefaultPort"/>)</param>
+    /// <param name="sendSize">Bytes per socket write (null = <see cref="DefaultSendSize"/>)</param>
+    public static unsafe Workload Open(Simulation simulation, string path, IReadOnlyList<Node> nodes,
+        ushort? port = null, int? sendSize = null)
+    {
+        ArgumentNullException.ThrowIfNull(simulation);
+        ArgumentNullException.ThrowIfNull(path);
+        ArgumentNullException.ThrowIfNull(nodes);
+        if (port == 0)
+            throw new ArgumentOutOfRangeException(nameof(port), port, "port must be positive");
+        if (sendSize is <= 0)
+            throw new ArgumentOutOfRangeException(nameof(sendSize), sendSize, "sendSize must be positive");
+
+        var nodeHandles = new nint[nodes.Count];
+        for (int i = 0; i < nodeHandles.Length; i++)
+            nodeHandles[i] = nodes[i].NativeHandle;
+
+        var options = new NativeMethods.Ns3WorkloadOptions
+        {
+            Port = port ?? 0,
+            SendSize = (uint)(sendSize ?? 0),
+        };
+        NativeMethods.Ns3Status status;
+        nint handle;
+        fixed (nint* nodePtr = nodeHandles)
+        {
+            status = simulation.Interop.WorkloadOpen(simulation.Handle, path, nodePtr, (uint)nodeHandles.Length,
+                &options, out handle);
+        }
+        Ns3Exception.ThrowIfError(status, simulation.Handle, nameof(Open));
+        return new Workload(simulation, handle, path, port ?? DefaultPort);
+    }
+
+    /// <summary>
+    /// Reads the workload's counters
+    /// </summary>
+    public WorkloadStats GetStats()
+    {
+        var status = _simulation.Interop.WorkloadStats(_simulation.Handle, _handle, out var s);
+        Ns3Exception.ThrowIfError(status, _simulation.Handle, nameof(GetStats));
+        return new WorkloadStats((long)s.Records, (long)s.Started, (long)s.Completed, (long)s.Failed, (long)s.Skipped,
+            (int)s.Active, (int)s.PeakActive, (long)s.BytesDelivered, s.MeanFctSec, s.MaxFctSec);
+    }
+}
@@ -0,0 +1,216 @@
+// distributed_scaling.cpp
+// Scaling benchmark for conservative parallel execution through the C ABI
+//
+// Builds a campus-style topology: `clusters` routers joined in a ring by
+// high-delay backbone links, each router serving `hosts` leaves over short
+// access links. Every host echoes UDP traffic with its peer in the next
+// cluster, so all traffic crosses the backbone. The topology is partitioned
+// with partition_nodes (access links are never cut) and run once.
+//
+// Usage (see run_distributed_scaling.sh for the 1..32 rank sweep):
+//   mpirun -np 8 ns3shim_bench_distributed --impl distributed --clusters 64 --hosts 128
+//
+// Rank 0 prints one CSV row:
+//   impl,ranks,nodes,links,cut_links,lookahead_s,imbalance,setup_s,run_s
+
+#include "ns3shim.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    ns3_sim_impl impl = NS3_SIMIMPL_DEFAULT;
+    uint32_t clusters = 32;
+    uint32_t hosts = 64;
+    double backboneDelaySec = 0.005;
+    double minLookaheadSec = 0.001;
+    double stopTimeSec = 10.0;
+    double intervalSec = 0.01;
+    bool header = false;
+};
+
+void Usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--impl default|distributed|null-message] [--clusters N] [--hosts N]\n"
+                 "          [--backbone-delay SEC] [--min-lookahead SEC] [--stop SEC] [--interval SEC]\n"
+                 "          [--header]\n",
+                 prog);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (arg == "--header") {
+            opt.header = true;
+            continue;
+        }
+        if (!value) return false;
+        ++i;
+
+        if (arg == "--impl") {
+            if (std::strcmp(value, "default") == 0) opt.impl = NS3_SIMIMPL_DEFAULT;
+            else if (std::strcmp(value, "distributed") == 0) opt.impl = NS3_SIMIMPL_DISTRIBUTED;
+            else if (std::strcmp(value, "null-message") == 0) opt.impl = NS3_SIMIMPL_NULL_MESSAGE;
+            else return false;
+        } else if (arg == "--clusters") {
+            opt.clusters = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--hosts") {
+            opt.hosts = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--backbone-delay") {
+            opt.backboneDelaySec = std::strtod(value, nullptr);
+        } else if (arg == "--min-lookahead") {
+            opt.minLookaheadSec = std::strtod(value, nullptr);
+        } else if (arg == "--stop") {
+            opt.stopTimeSec = std::strtod(value, nullptr);
+        } else if (arg == "--interval") {
+            opt.intervalSec = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+    }
+    return opt.clusters >= 2 && opt.hosts >= 1 && opt.stopTimeSec > 0.0 && opt.intervalSec > 0.0;
+}
+
+const char* ImplName(ns3_sim_impl impl) {
+    switch (impl) {
+        case NS3_SIMIMPL_DISTRIBUTED: return "distributed";
+        case NS3_SIMIMPL_NULL_MESSAGE: return "null-message";
+        default: return "default";
+    }
+}
+
+// /30 subnet number `index` within base (host order) as a dotted quad
+std::string Subnet(uint32_t base, uint32_t index, uint32_t hostPart = 0) {
+    const uint32_t addr = base + (index << 2) + hostPart;
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%u.%u.%u.%u",
+                  (addr >> 24) & 0xff, (addr >> 16) & 0xff, (addr >> 8) & 0xff, addr & 0xff);
+    return buf;
+}
+
+// Abort the benchmark with the shim's last error
+[[noreturn]] void Fail(ns3_sim sim, const char* what) {
+    char buf[512];
+    ns3_last_error(sim, buf, sizeof(buf));
+    std::fprintf(stderr, "%s failed: %s\n", what, buf);
+    std::exit(1);
+}
+
+#define CHECK(sim, call) do { if ((call) != NS3_OK) Fail((sim), #call); } while (0)
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    auto setupStart = std::chrono::steady_clock::now();
+
+    ns3_sim_options simOptions{};
+    simOptions.impl = opt.impl;
+    ns3_sim sim = nullptr;
+    if (sim_create_ex(&sim, &simOptions) != NS3_OK) {
+        std::fprintf(stderr, "sim_create_ex(%s) failed (is the shim built with NS3SHIM_ENABLE_MPI?)\n",
+                     ImplName(opt.impl));
+        return 1;
+    }
+
+    uint32_t rank = 0;
+    uint32_t rankCount = 1;
+    CHECK(sim, sim_get_rank(sim, &rank, &rankCount));
+
+    // Planned topology: router of cluster c at c*(hosts+1), its hosts follow
+    const uint32_t stride = opt.hosts + 1;
+    const uint32_t nodeCount = opt.clusters * stride;
+    auto router = [&](uint32_t c) { return c * stride; };
+    auto host = [&](uint32_t c, uint32_t h) { return c * stride + 1 + h; };
+
+    std::vector<ns3_partition_edge> edges;
+    edges.reserve(static_cast<size_t>(opt.clusters) * (opt.hosts + 1));
+    for (uint32_t c = 0; c < opt.clusters; ++c) {
+        for (uint32_t h = 0; h < opt.hosts; ++h) {
+            edges.push_back({host(c, h), router(c), 10e-6});
+        }
+    }
+    const size_t backboneStart = edges.size();
+    const uint32_t backboneLinks = opt.clusters == 2 ? 1 : opt.clusters;
+    for (uint32_t c = 0; c < backboneLinks; ++c) {
+        edges.push_back({router(c), router((c + 1) % opt.clusters), opt.backboneDelaySec});
+    }
+
+    std::vector<uint32_t> systemIds(nodeCount);
+    ns3_partition_stats partStats{};
+    CHECK(sim, partition_nodes(sim, nodeCount, edges.data(), static_cast<uint32_t>(edges.size()),
+                               rankCount, opt.minLookaheadSec, systemIds.data(), &partStats));
+
+    std::vector<ns3_node> nodes(nodeCount);
+    CHECK(sim, nodes_create_ex(sim, nodeCount, systemIds.data(), nodes.data()));
+    CHECK(sim, internet_install(sim, nodes.data(), nodeCount));
+
+    const uint32_t accessBase = 10u << 24;                  // 10.0.0.0/8
+    const uint32_t backboneBase = (172u << 24) | (16u << 16); // 172.16.0.0/12
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const bool backbone = i >= backboneStart;
+        ns3_device devs[2];
+        CHECK(sim, p2p_install(sim, nodes[edges[i].a], nodes[edges[i].b],
+                               backbone ? "10Gbps" : "1Gbps",
+                               backbone ? (std::to_string(opt.backboneDelaySec * 1e3) + "ms").c_str() : "10us",
+                               1500, &devs[0], &devs[1]));
+        const uint32_t index = static_cast<uint32_t>(backbone ? i - backboneStart : i);
+        CHECK(sim, ipv4_assign(sim, devs, 2, Subnet(backbone ? backboneBase : accessBase, index).c_str(),
+                               "255.255.255.252"));
+    }
+    CHECK(sim, ipv4_populate_routing_tables(sim));
+
+    // Applications only on nodes this rank owns; host (c, h) echoes with (c+1, h)
+    const uint32_t maxPackets = static_cast<uint32_t>(opt.stopTimeSec / opt.intervalSec);
+    for (uint32_t c = 0; c < opt.clusters; ++c) {
+        for (uint32_t h = 0; h < opt.hosts; ++h) {
+            ns3_node node = nodes[host(c, h)];
+            uint32_t owner = 0;
+            int isLocal = 0;
+            CHECK(sim, node_get_system_id(sim, node, &owner, &isLocal));
+            if (!isLocal) continue;
+
+            ns3_app server = nullptr;
+            ns3_app client = nullptr;
+            const uint32_t peerLink = ((c + 1) % opt.clusters) * opt.hosts + h;
+            CHECK(sim, app_udpecho_server(sim, node, 9, &server));
+            CHECK(sim, app_udpecho_client(sim, node, Subnet(accessBase, peerLink, 1).c_str(), 9,
+                                          512, opt.intervalSec, maxPackets, &client));
+            CHECK(sim, app_start(sim, server, 0.0));
+            CHECK(sim, app_start(sim, client, 1.0 + 1e-4 * h));
+        }
+    }
+
+    CHECK(sim, sim_stop(sim, opt.stopTimeSec));
+    const double setupSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - setupStart).count();
+
+    auto runStart = std::chrono::steady_clock::now();
+    CHECK(sim, sim_run(sim));
+    const double runSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+
+    if (rank == 0) {
+        if (opt.header) {
+            std::printf("impl,ranks,nodes,links,cut_links,lookahead_s,imbalance,setup_s,run_s\n");
+        }
+        std::printf("%s,%u,%u,%zu,%u,%g,%.3f,%.3f,%.3f\n",
+                    ImplName(opt.impl), rankCount, nodeCount, edges.size(), partStats.cutEdges,
+                    partStats.lookaheadSec, partStats.imbalance, setupSec, runSec);
+        std::fflush(stdout);
+    }
+
+    sim_destroy(sim);
+    return 0;
+}
@@ -0,0 +1,205 @@
+// flowmon_overhead.cpp
+// Cost of FlowMonitor probes on every node versus end hosts only
+//
+// Builds a two-tier fabric: `spines` routers fully meshed with `leaves`
+// routers, each leaf serving `hosts` end hosts. Every host echoes UDP
+// traffic with a host under another leaf, so each packet crosses a leaf, a
+// spine and a leaf. The same scenario is run with no flow monitor, with
+// flowmon_install_all (probes on every router too) or with flowmon_install
+// in edge-only mode (probes on hosts only), one mode per process so peak
+// memory is comparable.
+//
+// Usage (see run_flowmon_overhead.sh for all three modes):
+//   ns3shim_bench_flowmon --mode edge --spines 8 --leaves 64 --hosts 32
+//
+// Prints one CSV row:
+//   mode,nodes,probed,flows,rx_packets,setup_s,run_s,peak_rss_mib
+
+#include "ns3shim.h"
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Mode { None, All, Edge };
+
+struct Options {
+    Mode mode = Mode::Edge;
+    uint32_t spines = 4;
+    uint32_t leaves = 16;
+    uint32_t hosts = 16;
+    double stopTimeSec = 10.0;
+    double intervalSec = 0.01;
+    bool header = false;
+};
+
+void Usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--mode none|all|edge] [--spines N] [--leaves N] [--hosts N]\n"
+                 "          [--stop SEC] [--interval SEC] [--header]\n",
+                 prog);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (arg == "--header") {
+            opt.header = true;
+            continue;
+        }
+        if (!value) return false;
+        ++i;
+
+        if (arg == "--mode") {
+            if (std::strcmp(value, "none") == 0) opt.mode = Mode::None;
+            else if (std::strcmp(value, "all") == 0) opt.mode = Mode::All;
+            else if (std::strcmp(value, "edge") == 0) opt.mode = Mode::Edge;
+            else return false;
+        } else if (arg == "--spines") {
+            opt.spines = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--leaves") {
+            opt.leaves = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--hosts") {
+            opt.hosts = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--stop") {
+            opt.stopTimeSec = std::strtod(value, nullptr);
+        } else if (arg == "--interval") {
+            opt.intervalSec = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+    }
+    return opt.spines >= 1 && opt.leaves >= 2 && opt.hosts >= 1 && opt.stopTimeSec > 0.0 && opt.intervalSec > 0.0;
+}
+
+const char* ModeName(Mode mode) {
+    switch (mode) {
+        case Mode::None: return "none";
+        case Mode::All: return "all";
+        default: return "edge";
+    }
+}
+
+// /30 subnet number `index` within base (host order) as a dotted quad
+std::string Subnet(uint32_t base, uint32_t index, uint32_t hostPart = 0) {
+    const uint32_t addr = base + (index << 2) + hostPart;
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%u.%u.%u.%u",
+                  (addr >> 24) & 0xff, (addr >> 16) & 0xff, (addr >> 8) & 0xff, addr & 0xff);
+    return buf;
+}
+
+// Abort the benchmark with the shim's last error
+[[noreturn]] void Fail(ns3_sim sim, const char* what) {
+    char buf[512];
+    ns3_last_error(sim, buf, sizeof(buf));
+    std::fprintf(stderr, "%s failed: %s\n", what, buf);
+    std::exit(1);
+}
+
+#define CHECK(sim, call) do { if ((call) != NS3_OK) Fail((sim), #call); } while (0)
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    auto setupStart = std::chrono::steady_clock::now();
+
+    ns3_sim sim = nullptr;
+    if (sim_create(&sim) != NS3_OK) {
+        std::fprintf(stderr, "sim_create failed\n");
+        return 1;
+    }
+
+    // Spines first, then each leaf followed by its hosts
+    const uint32_t stride = opt.hosts + 1;
+    const uint32_t nodeCount = opt.spines + opt.leaves * stride;
+    auto leaf = [&](uint32_t l) { return opt.spines + l * stride; };
+    auto host = [&](uint32_t l, uint32_t h) { return leaf(l) + 1 + h; };
+
+    std::vector<ns3_node> nodes(nodeCount);
+    CHECK(sim, nodes_create(sim, nodeCount, nodes.data()));
+    CHECK(sim, internet_install(sim, nodes.data(), nodeCount));
+
+    const uint32_t accessBase = 10u << 24;                  // 10.0.0.0/8
+    const uint32_t fabricBase = (172u << 24) | (16u << 16); // 172.16.0.0/12
+    auto link = [&](uint32_t a, uint32_t b, const char* rate, const char* delay, uint32_t base, uint32_t index) {
+        ns3_device devs[2];
+        CHECK(sim, p2p_install(sim, nodes[a], nodes[b], rate, delay, 1500, &devs[0], &devs[1]));
+        CHECK(sim, ipv4_assign(sim, devs, 2, Subnet(base, index).c_str(), "255.255.255.252"));
+    };
+    for (uint32_t l = 0; l < opt.leaves; ++l) {
+        for (uint32_t h = 0; h < opt.hosts; ++h) {
+            link(host(l, h), leaf(l), "1Gbps", "10us", accessBase, l * opt.hosts + h);
+        }
+        for (uint32_t s = 0; s < opt.spines; ++s) {
+            link(leaf(l), s, "10Gbps", "50us", fabricBase, l * opt.spines + s);
+        }
+    }
+    CHECK(sim, ipv4_populate_routing_tables(sim));
+
+    // Host (l, h) echoes with (l+1, h); address .1 of its peer's access /30
+    const uint32_t maxPackets = static_cast<uint32_t>(opt.stopTimeSec / opt.intervalSec);
+    for (uint32_t l = 0; l < opt.leaves; ++l) {
+        for (uint32_t h = 0; h < opt.hosts; ++h) {
+            ns3_app server = nullptr;
+            ns3_app client = nullptr;
+            const uint32_t peerLink = ((l + 1) % opt.leaves) * opt.hosts + h;
+            CHECK(sim, app_udpecho_server(sim, nodes[host(l, h)], 9, &server));
+            CHECK(sim, app_udpecho_client(sim, nodes[host(l, h)], Subnet(accessBase, peerLink, 1).c_str(), 9,
+                                          512, opt.intervalSec, maxPackets, &client));
+            CHECK(sim, app_start(sim, server, 0.0));
+            CHECK(sim, app_start(sim, client, 1.0 + 1e-4 * h));
+        }
+    }
+
+    ns3_flowmon fm = nullptr;
+    uint32_t probed = 0;
+    if (opt.mode == Mode::All) {
+        CHECK(sim, flowmon_install_all(sim, &fm));
+        probed = nodeCount;
+    } else if (opt.mode == Mode::Edge) {
+        ns3_flowmon_options fmOptions{};
+        fmOptions.edgeOnly = 1;
+        fmOptions.maxPerHopDelaySec = 1.0;  // bounds the whole path: no probes in between
+        CHECK(sim, flowmon_install(sim, nullptr, 0, &fmOptions, &fm, &probed));
+    }
+
+    CHECK(sim, sim_stop(sim, opt.stopTimeSec));
+    const double setupSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - setupStart).count();
+
+    auto runStart = std::chrono::steady_clock::now();
+    CHECK(sim, sim_run(sim));
+    const double runSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+
+    ns3_flow_stats stats{};
+    if (fm) CHECK(sim, flowmon_collect(sim, fm, &stats));
+
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    const double peakRssMiB = usage.ru_maxrss / 1024.0;  // KiB on Linux
+
+    if (opt.header) {
+        std::printf("mode,nodes,probed,flows,rx_packets,setup_s,run_s,peak_rss_mib\n");
+    }
+    std::printf("%s,%u,%u,%u,%llu,%.3f,%.3f,%.1f\n", ModeName(opt.mode), nodeCount, probed, stats.flowCount,
+                static_cast<unsigned long long>(stats.rxPackets), setupSec, runSec, peakRssMiB);
+    std::fflush(stdout);
+
+    sim_destroy(sim);
+    return 0;
+}
@@ -0,0 +1,35 @@
+#!/bin/bash
+# Scaling sweep for ns3shim_bench_distributed on one machine
+# Usage: ./run_distributed_scaling.sh [build-dir] [impl] [extra benchmark args...]
+#
+# Runs the benchmark sequentially (1 rank, default simulator) and then with
+# 2, 4, 8, 16 and 32 local MPI ranks; prints one CSV row per run.
+# Requires a build configured with -DNS3SHIM_ENABLE_MPI=ON -DNS3SHIM_BUILD_BENCHMARKS=ON.
+
+set -e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+BUILD_DIR="${1:-$SCRIPT_DIR/../build}"
+IMPL="${2:-distributed}"
+shift $(( $# > 2 ? 2 : $# ))
+
+BENCH="$BUILD_DIR/ns3shim_bench_distributed"
+if [ ! -x "$BENCH" ]; then
+    echo "ERROR: $BENCH not found; configure with -DNS3SHIM_BUILD_BENCHMARKS=ON" >&2
+    exit 1
+fi
+
+MPIRUN="${MPIRUN:-mpirun}"
+RANKS="${RANKS:-1 2 4 8 16 32}"
+# Larger than the default so that partitioning has work to spread
+ARGS=("--clusters" "64" "--hosts" "128" "$@")
+
+HEADER="--header"
+for NP in $RANKS; do
+    if [ "$NP" -eq 1 ]; then
+        "$BENCH" --impl default $HEADER "${ARGS[@]}"
+    else
+        "$MPIRUN" -np "$NP" --oversubscribe "$BENCH" --impl "$IMPL" $HEADER "${ARGS[@]}"
+    fi
+    HEADER=""
+done
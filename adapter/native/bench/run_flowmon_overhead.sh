@@ -0,0 +1,29 @@
+#!/bin/bash
+# FlowMonitor overhead comparison for ns3shim_bench_flowmon
+# Usage: ./run_flowmon_overhead.sh [build-dir] [extra benchmark args...]
+#
+# Runs the same fabric without a flow monitor, with probes on every node and
+# with probes on end hosts only; prints one CSV row per mode.
+# Requires a build configured with -DNS3SHIM_BUILD_BENCHMARKS=ON.
+
+set -e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+BUILD_DIR="${1:-$SCRIPT_DIR/../build}"
+shift $(( $# > 1 ? 1 : $# ))
+
+BENCH="$BUILD_DIR/ns3shim_bench_flowmon"
+if [ ! -x "$BENCH" ]; then
+    echo "ERROR: $BENCH not found; configure with -DNS3SHIM_BUILD_BENCHMARKS=ON" >&2
+    exit 1
+fi
+
+MODES="${MODES:-none all edge}"
+# About 10k nodes: 8 spines, 192 leaves x 51 hosts
+ARGS=("--spines" "8" "--leaves" "192" "--hosts" "51" "$@")
+
+HEADER="--header"
+for MODE in $MODES; do
+    "$BENCH" --mode "$MODE" $HEADER "${ARGS[@]}"
+    HEADER=""
+done
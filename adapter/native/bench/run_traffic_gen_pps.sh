@@ -0,0 +1,28 @@
+#!/bin/bash
+# Packets/sec comparison for ns3shim_bench_traffic_gen
+# Usage: ./run_traffic_gen_pps.sh [build-dir] [extra benchmark args...]
+#
+# Runs UdpEchoClient, then app_traffic_gen with template clones at each
+# batch size and once with unique uids; prints one CSV row per run.
+# Requires a build configured with -DNS3SHIM_BUILD_BENCHMARKS=ON.
+
+set -e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+BUILD_DIR="${1:-$SCRIPT_DIR/../build}"
+shift $(( $# > 1 ? 1 : $# ))
+
+BENCH="$BUILD_DIR/ns3shim_bench_traffic_gen"
+if [ ! -x "$BENCH" ]; then
+    echo "ERROR: $BENCH not found; configure with -DNS3SHIM_BUILD_BENCHMARKS=ON" >&2
+    exit 1
+fi
+
+BATCHES="${BATCHES:-1 8 64}"
+ARGS=("--pairs" "16" "--packets" "200000" "$@")
+
+"$BENCH" --mode echo --header "${ARGS[@]}"
+"$BENCH" --mode gen --unique-uids "${ARGS[@]}"
+for BATCH in $BATCHES; do
+    "$BENCH" --mode gen --batch "$BATCH" "${ARGS[@]}"
+done
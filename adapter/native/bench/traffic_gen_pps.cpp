@@ -0,0 +1,187 @@
+// traffic_gen_pps.cpp
+// Packets per second of app_traffic_gen versus UdpEchoClient
+//
+// `pairs` sender/receiver pairs, each on its own point-to-point link. Every
+// sender sends `packets` UDP packets of `size` bytes, `interval` apart, to a
+// UDP PacketSink on its receiver; nothing is echoed back, so both modes do
+// the same work downstream of the application. The run ends when the last
+// packet is delivered. One mode per process.
+//
+// Usage (see run_traffic_gen_pps.sh for the comparison):
+//   ns3shim_bench_traffic_gen --mode gen --batch 16 --pairs 16 --packets 200000
+//
+// Prints one CSV row:
+//   mode,batch,unique_uids,pairs,packets,setup_s,run_s,pps,peak_rss_mib
+
+#include "ns3shim.h"
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Mode { Echo, Gen };
+
+struct Options {
+    Mode mode = Mode::Gen;
+    uint32_t pairs = 16;
+    uint32_t packets = 200000;
+    uint32_t size = 64;
+    double intervalSec = 1e-6;
+    uint32_t batch = 1;
+    bool poisson = false;
+    bool uniqueUids = false;
+    bool header = false;
+};
+
+void Usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--mode echo|gen] [--pairs N] [--packets N] [--size BYTES]\n"
+                 "          [--interval SEC] [--batch N] [--poisson] [--unique-uids] [--header]\n",
+                 prog);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (arg == "--header") {
+            opt.header = true;
+            continue;
+        }
+        if (arg == "--poisson") {
+            opt.poisson = true;
+            continue;
+        }
+        if (arg == "--unique-uids") {
+            opt.uniqueUids = true;
+            continue;
+        }
+        if (!value) return false;
+        ++i;
+
+        if (arg == "--mode") {
+            if (std::strcmp(value, "echo") == 0) opt.mode = Mode::Echo;
+            else if (std::strcmp(value, "gen") == 0) opt.mode = Mode::Gen;
+            else return false;
+        } else if (arg == "--pairs") {
+            opt.pairs = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--packets") {
+            opt.packets = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--size") {
+            opt.size = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--interval") {
+            opt.intervalSec = std::strtod(value, nullptr);
+        } else if (arg == "--batch") {
+            opt.batch = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+    return opt.pairs >= 1 && opt.packets >= 1 && opt.size >= 1 && opt.intervalSec > 0.0 && opt.batch >= 1;
+}
+
+// /30 subnet number `index` within 10.0.0.0/8 as a dotted quad
+std::string Subnet(uint32_t index, uint32_t hostPart = 0) {
+    const uint32_t addr = (10u << 24) + (index << 2) + hostPart;
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%u.%u.%u.%u",
+                  (addr >> 24) & 0xff, (addr >> 16) & 0xff, (addr >> 8) & 0xff, addr & 0xff);
+    return buf;
+}
+
+// Abort the benchmark with the shim's last error
+[[noreturn]] void Fail(ns3_sim sim, const char* what) {
+    char buf[512];
+    ns3_last_error(sim, buf, sizeof(buf));
+    std::fprintf(stderr, "%s failed: %s\n", what, buf);
+    std::exit(1);
+}
+
+#define CHECK(sim, call) do { if ((call) != NS3_OK) Fail((sim), #call); } while (0)
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    auto setupStart = std::chrono::steady_clock::now();
+
+    ns3_sim sim = nullptr;
+    if (sim_create(&sim) != NS3_OK) {
+        std::fprintf(stderr, "sim_create failed\n");
+        return 1;
+    }
+
+    // Sender of pair p is node 2p, its receiver 2p + 1 (address .2 of subnet p)
+    const uint32_t nodeCount = 2 * opt.pairs;
+    std::vector<ns3_node> nodes(nodeCount);
+    CHECK(sim, nodes_create(sim, nodeCount, nodes.data()));
+    CHECK(sim, internet_install(sim, nodes.data(), nodeCount));
+    for (uint32_t p = 0; p < opt.pairs; ++p) {
+        ns3_device devs[2];
+        CHECK(sim, p2p_install(sim, nodes[2 * p], nodes[2 * p + 1], "100Gbps", "1us", 1500, &devs[0], &devs[1]));
+        CHECK(sim, ipv4_assign(sim, devs, 2, Subnet(p).c_str(), "255.255.255.252"));
+    }
+
+    std::vector<ns3_app_spec> sinks(opt.pairs);
+    for (uint32_t p = 0; p < opt.pairs; ++p) {
+        sinks[p].kind = NS3_APP_PACKET_SINK;
+        sinks[p].srcNode = 2 * p + 1;
+        sinks[p].port = 9;
+        sinks[p].protocol = 17;
+    }
+    std::vector<ns3_app> sinkApps(opt.pairs);
+    CHECK(sim, app_install_bulk(sim, nodes.data(), nodeCount, sinks.data(), opt.pairs, sinkApps.data()));
+
+    ns3_traffic_gen_options gen{};
+    gen.packetSize = opt.size;
+    gen.pattern = opt.poisson ? NS3_TRAFFIC_POISSON : NS3_TRAFFIC_CBR;
+    gen.intervalSec = opt.intervalSec;
+    gen.batch = opt.batch;
+    gen.flags = opt.uniqueUids ? NS3_TRAFFIC_GEN_UNIQUE_UIDS : 0;
+    gen.maxPackets = opt.packets;
+    for (uint32_t p = 0; p < opt.pairs; ++p) {
+        const std::string dst = Subnet(p, 2);
+        ns3_app client = nullptr;
+        if (opt.mode == Mode::Echo) {
+            CHECK(sim, app_udpecho_client(sim, nodes[2 * p], dst.c_str(), 9, opt.size, opt.intervalSec, opt.packets,
+                                          &client));
+        } else {
+            CHECK(sim, app_traffic_gen(sim, nodes[2 * p], dst.c_str(), 9, &gen, &client));
+        }
+        CHECK(sim, app_start(sim, client, 1.0 + 1e-7 * p));
+    }
+    const double setupSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - setupStart).count();
+
+    auto runStart = std::chrono::steady_clock::now();
+    CHECK(sim, sim_run(sim));
+    const double runSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    const double peakRssMiB = usage.ru_maxrss / 1024.0;  // KiB on Linux
+
+    const uint64_t packets = static_cast<uint64_t>(opt.pairs) * opt.packets;
+    if (opt.header) {
+        std::printf("mode,batch,unique_uids,pairs,packets,setup_s,run_s,pps,peak_rss_mib\n");
+    }
+    std::printf("%s,%u,%d,%u,%llu,%.3f,%.3f,%.0f,%.1f\n", opt.mode == Mode::Echo ? "echo" : "gen",
+                opt.mode == Mode::Echo ? 1u : opt.batch, opt.uniqueUids ? 1 : 0, opt.pairs,
+                static_cast<unsigned long long>(packets), setupSec, runSec, packets / runSec, peakRssMiB);
+    std::fflush(stdout);
+
+    sim_destroy(sim);
+    return 0;
+}
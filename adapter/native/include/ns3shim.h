@@ -47,6 +47,36 @@ typedef struct ns3_app_t*     ns3_app;
 /// Opaque handle to flow monitor
 typedef struct ns3_flowmon_t* ns3_flowmon;
 
+/// Opaque handle to workload-driven flow launcher
+typedef struct ns3_workload_t* ns3_workload;
+
+/// Opaque handle to a group of TCP bulk transfers
+typedef struct ns3_tcp_bulk_t* ns3_tcp_bulk;
+
+/// Opaque handle to columnar trace file
+typedef struct ns3_trace_file_t* ns3_trace_file;
+
+/// Opaque handle to time-binned throughput accumulator
+typedef struct ns3_throughput_t* ns3_throughput;
+
+/// Opaque handle to per-flow latency histograms
+typedef struct ns3_latency_t* ns3_latency;
+
+/// Opaque handle to flow completion time tracker
+typedef struct ns3_fct_t* ns3_fct;
+
+/// Opaque handle to queue/drop monitor
+typedef struct ns3_queue_monitor_t* ns3_queue_monitor;
+
+/// Opaque handle to shared-memory live capture ring
+typedef struct ns3_capture_ring_t* ns3_capture_ring;
+
+/// Opaque handle to periodic FlowMonitor snapshots
+typedef struct ns3_flow_epochs_t* ns3_flow_epochs;
+
+/// Opaque handle to packet event subscription
+typedef struct ns3_trace_sub_t* ns3_trace_sub;
+
 // ============================================================================
 // Status & Error Handling
 // ============================================================================
@@ -79,6 +109,33 @@ typedef void(*ns3_void_cb)(void* user);
 /// @param bytes Packet size in bytes
 typedef void(*ns3_pkt_cb)(void* user, uint64_t deviceId, double timeSec, uint32_t bytes);
 
+/// ns3_pkt_event_ex.flags bits
+typedef enum {
+    NS3_PKT_IPV4  = 0x1,  ///< IPv4 fields are valid
+    NS3_PKT_PORTS = 0x2   ///< Port fields are valid (TCP/UDP first fragment)
+} ns3_pkt_flags;
+
+/// Extended packet event with header fields peeked from the frame
+typedef struct {
+    uint64_t deviceId;   ///< Device handle id
+    double   timeSec;    ///< Simulation time in seconds
+    uint64_t uid;        ///< ns-3 packet uid (kept across hops; pairs TX with RX)
+    uint32_t size;       ///< Packet size in bytes, including link-layer headers
+    uint32_t srcAddr;    ///< IPv4 source address (host byte order)
+    uint32_t dstAddr;    ///< IPv4 destination address (host byte order)
+    uint16_t srcPort;    ///< TCP/UDP source port
+    uint16_t dstPort;    ///< TCP/UDP destination port
+    uint8_t  direction;  ///< 0 = transmit, 1 = receive
+    uint8_t  flags;      ///< Bitwise OR of ns3_pkt_flags
+    uint8_t  protocol;   ///< IP protocol number
+    uint8_t  ttl;        ///< IPv4 time to live
+} ns3_pkt_event_ex;
+
+/// Extended packet trace callback
+/// @param user User-provided context pointer
+/// @param event Event record (valid only during the call)
+typedef void(*ns3_pkt_ex_cb)(void* user, const ns3_pkt_event_ex* event);
+
 // ============================================================================
 // Configuration Attributes
 // ============================================================================
@@ -119,6 +176,32 @@ NS3SHIM_API ns3_status config_set(ns3_sim sim, const char* path, const char* att
 /// @return NS3_OK on success, NS3_ERR on failure
 NS3SHIM_API ns3_status sim_create(ns3_sim* outSim);
 
+/// Simulator implementation selected at creation
+typedef enum {
+    NS3_SIMIMPL_DEFAULT = 0,      ///< Sequential DefaultSimulatorImpl
+    NS3_SIMIMPL_DISTRIBUTED = 1,  ///< Conservative granted-time-window DistributedSimulatorImpl (MPI)
+    NS3_SIMIMPL_NULL_MESSAGE = 2  ///< Conservative NullMessageSimulatorImpl (MPI)
+} ns3_sim_impl;
+
+/// Options for sim_create_ex
+typedef struct {
+    ns3_sim_impl impl;  ///< Simulator implementation
+} ns3_sim_options;
+
+/// Create a simulation context with explicit options
+///
+/// The distributed implementations partition one simulation across the ranks
+/// of an MPI launch (e.g., `mpirun -np 8 host` on a single machine). Every
+/// rank builds the same topology; each node is owned by the rank given at
+/// nodes_create_ex and point-to-point links between ranks carry the lookahead.
+/// Requires a build with NS3SHIM_ENABLE_MPI; MPI is initialized on first use
+/// and finalized when the simulation is destroyed, so a process hosts at most
+/// one distributed simulation.
+/// @param outSim Output handle to created simulation
+/// @param options Creation options (NULL = same as sim_create)
+/// @return NS3_OK on success, NS3_ERR on failure
+NS3SHIM_API ns3_status sim_create_ex(ns3_sim* outSim, const ns3_sim_options* options);
+
 /// Set random number generator seed
 /// @param sim Simulation handle
 /// @param seed RNG seed value
@@ -172,6 +255,23 @@ NS3SHIM_API ns3_status sim_destroy(ns3_sim sim);
 /// @return NS3_OK on success
 NS3SHIM_API ns3_status nodes_create(ns3_sim sim, uint32_t count, ns3_node* outArray);
 
+/// Create multiple network nodes with explicit rank ownership
+/// @param sim Simulation handle
+/// @param count Number of nodes to create
+/// @param systemIds Owning rank per node (size=count; NULL = all on rank 0)
+/// @param outArray Output array of node handles (must be preallocated, size=count)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status nodes_create_ex(ns3_sim sim, uint32_t count, const uint32_t* systemIds,
+                                       ns3_node* outArray);
+
+/// Get the rank that owns a node
+/// @param sim Simulation handle
+/// @param node Node handle
+/// @param outSystemId Output: owning rank
+/// @param outIsLocal Output: 1 if owned by this process's rank (may be NULL)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status node_get_system_id(ns3_sim sim, ns3_node node, uint32_t* outSystemId, int* outIsLocal);
+
 /// Install Internet stack (IPv4, TCP, UDP, etc.) on nodes
 /// @param sim Simulation handle
 /// @param nodes Array of node handles
@@ -179,6 +279,50 @@ NS3SHIM_API ns3_status nodes_create(ns3_sim sim, uint32_t count, ns3_node* outAr
 /// @return NS3_OK on success
 NS3SHIM_API ns3_status internet_install(ns3_sim sim, const ns3_node* nodes, uint32_t count);
 
+// ============================================================================
+// Distributed Execution
+// ============================================================================
+
+/// Get this process's rank within a distributed simulation
+/// @param sim Simulation handle
+/// @param outRank Output: rank of this process (0 for sequential simulations)
+/// @param outRankCount Output: number of ranks (1 for sequential simulations)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status sim_get_rank(ns3_sim sim, uint32_t* outRank, uint32_t* outRankCount);
+
+/// Link in a planned topology, by node index
+typedef struct {
+    uint32_t a;         ///< First endpoint (index into the planned node list)
+    uint32_t b;         ///< Second endpoint
+    double   delaySec;  ///< Propagation delay (0 for shared media such as CSMA or Wi-Fi)
+} ns3_partition_edge;
+
+/// Partitioning outcome
+typedef struct {
+    double   lookaheadSec;  ///< Smallest delay among links cut between ranks (0 if none)
+    double   imbalance;     ///< Largest rank node count divided by the mean
+    uint32_t cutEdges;      ///< Number of links that cross ranks
+} ns3_partition_stats;
+
+/// Assign planned nodes to ranks along high-delay links
+///
+/// Nodes joined by a link with delay below minLookaheadSec are kept on the
+/// same rank; the resulting clusters are balanced over ranks by node count.
+/// Feed the result to nodes_create_ex. Cross-rank links must be point-to-point.
+/// @param sim Simulation handle (for error reporting)
+/// @param nodeCount Number of planned nodes
+/// @param edges Planned links
+/// @param edgeCount Number of links
+/// @param rankCount Number of ranks to spread over
+/// @param minLookaheadSec Links faster than this are never cut
+/// @param outSystemIds Output: rank per node (size=nodeCount)
+/// @param outStats Output: partition quality (may be NULL)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status partition_nodes(ns3_sim sim, uint32_t nodeCount,
+                                       const ns3_partition_edge* edges, uint32_t edgeCount,
+                                       uint32_t rankCount, double minLookaheadSec,
+                                       uint32_t* outSystemIds, ns3_partition_stats* outStats);
+
 // ============================================================================
 // Network Devices & Links
 // ============================================================================
@@ -281,6 +425,138 @@ NS3SHIM_API ns3_status app_udpecho_server(ns3_sim sim, ns3_node node, uint16_t p
 NS3SHIM_API ns3_status app_udpecho_client(ns3_sim sim, ns3_node node, const char* dstIp, uint16_t port,
                                           uint32_t packetSize, double intervalSec, uint32_t maxPackets, ns3_app* outApp);
 
+/// Inter-packet gaps of a traffic generator
+typedef enum {
+    NS3_TRAFFIC_CBR     = 0,  ///< Constant: every gap is intervalSec
+    NS3_TRAFFIC_POISSON = 1   ///< Exponential gaps with mean intervalSec
+} ns3_traffic_pattern;
+
+/// ns3_traffic_gen_options flags
+#define NS3_TRAFFIC_GEN_UNIQUE_UIDS 0x1u  ///< Allocate every packet instead of cloning the template
+
+/// Traffic generator options (zero fields take defaults)
+typedef struct {
+    uint32_t packetSize;   ///< UDP payload bytes (0 = 1024)
+    uint32_t pattern;      ///< ns3_traffic_pattern
+    double   intervalSec;  ///< Interval (CBR) or mean interval (Poisson) between packets; required
+    uint32_t batch;        ///< Packets sent per scheduler event (0 = 1)
+    uint32_t flags;        ///< NS3_TRAFFIC_GEN_* flags
+    uint64_t maxPackets;   ///< Packets to send before stopping (0 = unlimited)
+} ns3_traffic_gen_options;
+
+/// Create a UDP traffic generator application
+///
+/// A cheaper UdpEchoClient for line-rate load: each packet is a
+/// copy-on-write clone of one template, so no payload buffer is allocated
+/// per send, and nothing is received or traced per packet. With batch > 1,
+/// that many packets leave back to back per scheduler event and the next
+/// event follows after the sum of their gaps, so the long-run rate holds
+/// with fewer events and coarser timing. Clones share the template's packet
+/// uid; set NS3_TRAFFIC_GEN_UNIQUE_UIDS when uid-based sampling or events
+/// must tell the packets apart. Point it at a UdpServer or PacketSink.
+/// @param sim Simulation handle
+/// @param node Node to host the generator
+/// @param dstIp Destination IP address (e.g., "10.1.1.2")
+/// @param port Destination UDP port
+/// @param options Packet size, pattern, interval and batching
+/// @param outApp Output: application handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status app_traffic_gen(ns3_sim sim, ns3_node node, const char* dstIp, uint16_t port,
+                                       const ns3_traffic_gen_options* options, ns3_app* outApp);
+
+/// PCAP replay options (zero fields take defaults)
+typedef struct {
+    double   timeScale;   ///< Multiplier on recorded gaps (0 = 1; 0.5 replays twice as fast)
+    uint64_t maxPackets;  ///< Packets to send before stopping (0 = whole capture)
+} ns3_pcap_replay_options;
+
+/// Progress of a PCAP replay
+typedef struct {
+    uint64_t records;         ///< Capture records read ahead so far, including skipped ones
+    uint64_t skipped;         ///< Records without an IPv4/IPv6 packet
+    uint64_t packetsSent;
+    uint64_t bytesSent;       ///< IP bytes sent (recorded length, at least 28 per packet)
+    uint64_t stalls;          ///< Times the simulation waited for the read-ahead thread
+    double   captureSpanSec;  ///< Recorded time from the first to the latest packet sent
+} ns3_pcap_replay_stats;
+
+/// Create an application that replays a packet capture as UDP traffic
+///
+/// Each IP packet of a classic pcap file (not pcapng) is sent from `node`
+/// to dstIp:port as a UDP datagram of the same IP length, at the recorded
+/// time since the first packet (times timeScale) after the application
+/// starts. Recorded addresses, ports and payloads are not used. Link types:
+/// Ethernet, PPP, raw IP, Linux cooked capture and BSD loopback; other
+/// frames (ARP, ...) are skipped. The file is memory-mapped, not loaded
+/// (POSIX only): a background thread started with the application decodes
+/// records ahead of the simulation and releases pages behind it, so the
+/// event loop does not wait on file I/O. Records earlier than their
+/// predecessor are sent immediately. Stopping the application ends the
+/// replay. Point it at a UdpServer or PacketSink.
+/// @param sim Simulation handle
+/// @param node Node to inject the packets from
+/// @param path Capture file path
+/// @param dstIp Destination IP address (e.g., "10.1.1.2")
+/// @param port Destination UDP port
+/// @param options Time scale and packet limit (may be NULL: defaults)
+/// @param outApp Output: application handle
+/// @return NS3_OK on success, NS3_ERR if the file cannot be mapped or is not a supported capture
+NS3SHIM_API ns3_status app_pcap_replay(ns3_sim sim, ns3_node node, const char* path, const char* dstIp,
+                                       uint16_t port, const ns3_pcap_replay_options* options, ns3_app* outApp);
+
+/// Read a PCAP replay application's counters
+/// @param sim Simulation handle
+/// @param app Application handle from app_pcap_replay
+/// @param outStats Output: counters
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status app_pcap_replay_stats(ns3_sim sim, ns3_app app, ns3_pcap_replay_stats* outStats);
+
+/// Application kinds for app_install_bulk
+typedef enum {
+    NS3_APP_UDP_SERVER  = 0,  ///< UdpServer listening on port
+    NS3_APP_UDP_CLIENT  = 1,  ///< UdpClient sending packetSize-byte packets at rateBps
+    NS3_APP_ONOFF       = 2,  ///< OnOffApplication, always on, sending at rateBps
+    NS3_APP_BULK_SEND   = 3,  ///< BulkSendApplication, sending as fast as the socket allows
+    NS3_APP_PACKET_SINK = 4   ///< PacketSink listening on port
+} ns3_app_kind;
+
+/// dstNode value selecting dstAddr instead of a node
+#define NS3_APP_NO_NODE 0xFFFFFFFFu
+
+/// One application of app_install_bulk (56 bytes, no padding)
+typedef struct {
+    uint32_t kind;        ///< ns3_app_kind
+    uint32_t srcNode;     ///< Index into nodes of the node hosting the application
+    uint32_t dstNode;     ///< Index into nodes of the peer, or NS3_APP_NO_NODE (senders only)
+    uint32_t dstAddr;     ///< Peer IPv4 address in host byte order, used when dstNode is NS3_APP_NO_NODE
+    uint16_t port;        ///< Destination port (senders) or listening port (servers, sinks)
+    uint16_t protocol;    ///< OnOff/PacketSink: 6 = TCP, 17 = UDP, 0 = UDP for OnOff, TCP for PacketSink
+    uint32_t packetSize;  ///< Bytes per packet or socket write (0 = 1024)
+    double   rateBps;     ///< Send rate in bits/s (UdpClient, OnOff)
+    uint64_t size;        ///< Bytes to send before stopping (senders; 0 = unlimited)
+    double   startSec;    ///< Start time in seconds
+    double   stopSec;     ///< Stop time in seconds (0 = run until the simulation ends)
+} ns3_app_spec;
+
+/// Install many applications in one call
+///
+/// Meant for traffic matrices: specs name nodes by index into one shared
+/// array, a peer node resolves to its first non-loopback IPv4 address
+/// (assign addresses first), and start/stop times are applied as part of
+/// the install. Every spec is validated before anything is installed, so on
+/// error no application is created. UdpClient sends ceil(size / packetSize)
+/// packets spaced packetSize * 8 / rateBps apart; BulkSend (TCP) ignores
+/// rateBps. Returned handles work with app_start/app_stop.
+/// @param sim Simulation handle
+/// @param nodes Nodes referenced by the specs
+/// @param nodeCount Number of nodes
+/// @param specs Applications to install
+/// @param count Number of specs
+/// @param outApps Output: one application handle per spec (array of size count)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status app_install_bulk(ns3_sim sim, const ns3_node* nodes, uint32_t nodeCount,
+                                        const ns3_app_spec* specs, uint32_t count, ns3_app* outApps);
+
 /// Start an application at a specific time
 /// @param sim Simulation handle
 /// @param app Application handle
@@ -295,6 +571,59 @@ NS3SHIM_API ns3_status app_start(ns3_sim sim, ns3_app app, double atTimeSec);
 /// @return NS3_OK on success
 NS3SHIM_API ns3_status app_stop(ns3_sim sim, ns3_app app, double atTimeSec);
 
+/// Workload launcher options (zero fields take defaults)
+typedef struct {
+    uint16_t port;       ///< TCP port the receivers listen on (0 = 9000)
+    uint32_t sendSize;   ///< Bytes per socket write (0 = 1448)
+} ns3_workload_options;
+
+/// Progress of a workload
+typedef struct {
+    uint64_t records;         ///< Records in the file
+    uint64_t started;         ///< Flows started so far
+    uint64_t completed;       ///< Flows whose last byte was received
+    uint64_t failed;          ///< Flows whose connection failed
+    uint64_t skipped;         ///< Records with a node index out of range or src == dst
+    uint32_t active;          ///< Flows running now
+    uint32_t peakActive;      ///< Most flows running at once (flow state allocated)
+    uint64_t bytesDelivered;  ///< Payload bytes received, all flows
+    double   meanFctSec;      ///< Mean completion time of completed flows (seconds)
+    double   maxFctSec;       ///< Longest completion time (seconds)
+} ns3_workload_stats;
+
+/// Launch the TCP transfers of a workload file as their start times come
+///
+/// The file is a 16-byte header ("NS3W" | u16 version 1 | u16 record size
+/// 24 | u64 record count) followed by records f64 startSec | u32 src |
+/// u32 dst | u64 bytes, native byte order, sorted by startSec; src and dst
+/// index nodes. It is memory-mapped and read one record at a time (POSIX
+/// only). No application is created: a flow gets a sender socket and a receiver
+/// slot when it starts, and both are recycled when the receiver has the
+/// last byte, so memory tracks concurrent flows rather than the length of
+/// the file. The sockets use a 1 ms maximum segment lifetime, so a finished
+/// sender leaves TIME_WAIT, and frees its socket and ephemeral port, 2 ms
+/// after its FIN rather than ns-3's default 240 s. A source node can still
+/// have at most about 16,000 flows (its ephemeral port range) running or in
+/// TIME_WAIT at once; flows beyond that count as failed. Each destination
+/// node gets one listening socket, created on first use. A record earlier than its predecessor starts immediately.
+/// Assign IPv4 addresses before the first flow starts.
+/// @param sim Simulation handle
+/// @param path Workload file path
+/// @param nodes Nodes the records refer to by index
+/// @param nodeCount Number of nodes
+/// @param options Port and write size (may be NULL: defaults)
+/// @param outWorkload Output: workload handle
+/// @return NS3_OK on success, NS3_ERR if the file cannot be mapped or is not a workload
+NS3SHIM_API ns3_status workload_open(ns3_sim sim, const char* path, const ns3_node* nodes, uint32_t nodeCount,
+                                     const ns3_workload_options* options, ns3_workload* outWorkload);
+
+/// Read a workload's counters
+/// @param sim Simulation handle
+/// @param workload Workload handle
+/// @param outStats Output: counters
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status workload_stats(ns3_sim sim, ns3_workload workload, ns3_workload_stats* outStats);
+
 // ============================================================================
 // Tracing & Statistics
 // ============================================================================
@@ -309,13 +638,402 @@ NS3SHIM_API ns3_status app_stop(ns3_sim sim, ns3_app app, double atTimeSec);
 NS3SHIM_API ns3_status trace_subscribe_packet_events(ns3_sim sim, ns3_device dev, 
                                                       ns3_pkt_cb onTx, ns3_pkt_cb onRx, void* user);
 
-/// Enable PCAP tracing on a device
+/// Subscribe to packet TX/RX events on a device, returning a handle
+///
+/// Like trace_subscribe_packet_events, but the subscription can be ended
+/// with trace_unsubscribe instead of lasting until sim_destroy.
 /// @param sim Simulation handle
 /// @param dev Device handle
+/// @param onTx Callback for transmitted packets (may be NULL)
+/// @param onRx Callback for received packets (may be NULL)
+/// @param user User context pointer passed to callbacks
+/// @param outSub Output: subscription handle for trace_unsubscribe
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status trace_subscribe_packet_events_handle(ns3_sim sim, ns3_device dev,
+                                                             ns3_pkt_cb onTx, ns3_pkt_cb onRx, void* user,
+                                                             ns3_trace_sub* outSub);
+
+/// Subscribe to extended packet TX/RX events on a device
+///
+/// Like trace_subscribe_packet_events, plus the packet uid and the IPv4
+/// addresses, protocol, TTL and TCP/UDP ports read in place from the frame
+/// (no header objects are deserialized). Pairing uids across devices gives
+/// end-to-end latency and hop-by-hop paths without PCAP post-processing.
+/// @param sim Simulation handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
+/// @param onTx Callback for transmitted packets (may be NULL)
+/// @param onRx Callback for received packets (may be NULL)
+/// @param user User context pointer passed to callbacks
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status trace_subscribe_packet_events_ex(ns3_sim sim, ns3_device dev,
+                                                         ns3_pkt_ex_cb onTx, ns3_pkt_ex_cb onRx, void* user);
+
+/// Subscribe to extended packet TX/RX events on a device, returning a handle
+///
+/// Like trace_subscribe_packet_events_ex, but the subscription can be ended
+/// with trace_unsubscribe instead of lasting until sim_destroy.
+/// @param sim Simulation handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
+/// @param onTx Callback for transmitted packets (may be NULL)
+/// @param onRx Callback for received packets (may be NULL)
+/// @param user User context pointer passed to callbacks
+/// @param outSub Output: subscription handle for trace_unsubscribe
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status trace_subscribe_packet_events_ex_handle(ns3_sim sim, ns3_device dev,
+                                                                ns3_pkt_ex_cb onTx, ns3_pkt_ex_cb onRx, void* user,
+                                                                ns3_trace_sub* outSub);
+
+/// End a packet event subscription
+///
+/// The subscription's callbacks are not invoked again once this returns, so
+/// the host may release its user context. The ns-3 trace sinks are
+/// disconnected at once, or, when called from a callback while the
+/// simulation runs, after the current event. The handle is then invalid.
+/// @param sim Simulation handle
+/// @param sub Subscription handle from trace_subscribe_packet_events_handle or _ex_handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status trace_unsubscribe(ns3_sim sim, ns3_trace_sub sub);
+
+/// Packet event subscription counters
+typedef struct {
+    uint32_t subscriptions;    ///< Subscriptions not yet ended
+    uint32_t contexts;         ///< Pooled callback contexts in use (released once the sinks disconnect)
+    uint32_t contextCapacity;  ///< Context slots allocated; ended subscriptions' slots are reused first
+} ns3_trace_stats;
+
+/// Read the simulation's packet event subscription counters
+/// @param sim Simulation handle
+/// @param outStats Output: counters
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status trace_get_stats(ns3_sim sim, ns3_trace_stats* outStats);
+
+/// Packet filter for trace subscriptions; zero fields do not constrain
+///
+/// Sizes are as seen by the device (including link-layer headers). Any
+/// protocol, address or port condition rejects frames that do not carry
+/// IPv4; port conditions also reject non-TCP/UDP packets and non-first
+/// fragments. Sampling keeps packets whose uid is a multiple of sampleEvery,
+/// so a sampled packet is kept on every device it crosses.
+typedef struct {
+    uint32_t minSize;     ///< Smallest packet size in bytes (0 = no bound)
+    uint32_t maxSize;     ///< Largest packet size in bytes (0 = no bound)
+    uint32_t srcAddr;     ///< IPv4 source prefix (host byte order)
+    uint32_t srcMask;     ///< Source prefix mask (0 = any source)
+    uint32_t dstAddr;     ///< IPv4 destination prefix (host byte order)
+    uint32_t dstMask;     ///< Destination prefix mask (0 = any destination)
+    uint16_t srcPortMin;  ///< Inclusive source port range (0 = no lower bound)
+    uint16_t srcPortMax;  ///< (0 = no upper bound)
+    uint16_t dstPortMin;  ///< Inclusive destination port range (0 = no lower bound)
+    uint16_t dstPortMax;  ///< (0 = no upper bound)
+    uint32_t sampleEvery; ///< Keep 1 in N packets (0 or 1 = all)
+    uint8_t  protocol;    ///< IP protocol number (0 = any; 6 = TCP, 17 = UDP)
+} ns3_trace_filter;
+
+/// Set or clear the packet filter of a device
+///
+/// The filter is evaluated natively before packet event callbacks and trace
+/// file writes on the device, whether they were subscribed before or after
+/// this call. Throughput accumulators are not filtered. Not safe while
+/// sim_run executes on another thread; call it from a sim_schedule callback
+/// or between runs.
+/// @param sim Simulation handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
+/// @param filter Filter to apply (copied), or NULL to pass every packet
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status trace_set_filter(ns3_sim sim, ns3_device dev, const ns3_trace_filter* filter);
+
+/// Event sink event types
+typedef enum {
+    NS3_EVENT_TX   = 0,  ///< PHY finished transmitting a packet
+    NS3_EVENT_RX   = 1,  ///< PHY finished receiving a packet
+    NS3_EVENT_DROP = 2   ///< PHY dropped a received packet or the MAC dropped one before transmission
+} ns3_event_type;
+
+/// event_sink_enable mask bits
+#define NS3_EVENT_MASK(type) (1u << (type))
+#define NS3_EVENT_MASK_ALL   (NS3_EVENT_MASK(NS3_EVENT_TX) | NS3_EVENT_MASK(NS3_EVENT_RX) | NS3_EVENT_MASK(NS3_EVENT_DROP))
+
+/// One event sink event (32 bytes)
+typedef struct {
+    double   timeSec;     ///< Simulation time in seconds
+    uint64_t uid;         ///< ns-3 packet uid
+    uint32_t slot;        ///< Device slot returned by event_sink_enable
+    uint32_t size;        ///< Packet size in bytes, including link-layer headers
+    uint8_t  type;        ///< ns3_event_type
+    uint8_t  reserved[7];
+} ns3_event;
+
+/// Event sink batch callback
+/// @param user User-provided context pointer
+/// @param events Events in time order (valid only during the call)
+/// @param count Number of events (> 0)
+typedef void(*ns3_event_batch_cb)(void* user, const ns3_event* events, uint32_t count);
+
+/// Open the simulation's event sink
+///
+/// One registration receives the events of every device enabled with
+/// event_sink_enable, tagged with the device's slot, in batches of up to
+/// batchCapacity events. A batch is delivered when it is full, on
+/// event_sink_flush, when sim_run returns and on event_sink_close. Unlike
+/// trace_subscribe_packet_events there is no per-device context on either
+/// side, which keeps thousands of traced devices cheap. Device trace filters
+/// (trace_set_filter) apply. A simulation has at most one open sink.
+/// @param sim Simulation handle
+/// @param onBatch Batch callback
+/// @param user User context pointer passed to onBatch
+/// @param batchCapacity Events per batch (0 = 4096)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status event_sink_open(ns3_sim sim, ns3_event_batch_cb onBatch, void* user, uint32_t batchCapacity);
+
+/// Select the events a device reports to the event sink
+///
+/// The first call for a device assigns its slot (0, 1, ... in call order,
+/// kept for the life of the simulation) and connects its trace sources;
+/// afterwards a call only replaces the device's event mask, and a mask of 0
+/// mutes it. Changing the mask of a device that
+/// already has a slot is safe from any thread, even while sim_run executes;
+/// the first call for a device is not (call it from a sim_schedule callback
+/// or between runs).
+/// @param sim Simulation handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
+/// @param eventMask Bitwise OR of NS3_EVENT_MASK(ns3_event_type) (0 = none)
+/// @param outSlot Output: the device's slot (may be NULL)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status event_sink_enable(ns3_sim sim, ns3_device dev, uint32_t eventMask, uint32_t* outSlot);
+
+/// Deliver the pending events now
+///
+/// Call from a sim_schedule callback to bound the delay between an event and
+/// its delivery. Does nothing when called from the batch callback itself.
+/// @param sim Simulation handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status event_sink_flush(ns3_sim sim);
+
+/// Close the event sink
+///
+/// Delivers the pending events and mutes every device; onBatch is not
+/// invoked again once this returns. Slots are kept, so a sink opened later
+/// reports each device under its old slot once it is enabled again. Pending
+/// events of a sink still open at sim_destroy are discarded.
+/// @param sim Simulation handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status event_sink_close(ns3_sim sim);
+
+/// Enable PCAP tracing on a device with default options
+/// (see pcap_enable_ex)
+/// @param sim Simulation handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
 /// @param filePrefix Prefix for PCAP file name
 /// @return NS3_OK on success
 NS3SHIM_API ns3_status pcap_enable(ns3_sim sim, ns3_device dev, const char* filePrefix);
 
+/// PCAP capture flags
+typedef enum {
+    NS3_PCAP_NO_PROMISC = 0x1  ///< PointToPoint/CSMA: only frames sent or received by the device
+} ns3_pcap_flags;
+
+/// PCAP output compression
+typedef enum {
+    NS3_PCAP_COMPRESS_NONE = 0,  ///< Plain ".pcap"
+    NS3_PCAP_COMPRESS_GZIP = 1,  ///< ".pcap.gz" (requires a build with zlib)
+    NS3_PCAP_COMPRESS_ZSTD = 2   ///< ".pcap.zst" (requires a build with libzstd)
+} ns3_pcap_compression;
+
+/// PCAP capture options; zero fields take the defaults
+typedef struct {
+    uint32_t bufferBytes;      ///< Write buffer per file (default 4 MiB)
+    uint32_t snaplen;          ///< Bytes captured per packet (default 65535)
+    double flushIntervalSec;   ///< Wall-clock flush interval (default 1 s; < 0 = only when the buffer fills)
+    uint32_t flags;            ///< ns3_pcap_flags
+    uint32_t compression;      ///< ns3_pcap_compression (default none)
+    int32_t compressionLevel;  ///< Codec level (default 1, the fastest)
+} ns3_pcap_options;
+
+/// Enable PCAP tracing on a device
+///
+/// Writes "<filePrefix>-<node id>-<device index>.pcap" with the link type
+/// of the device: PPP for PointToPoint, Ethernet for CSMA and 802.11 with
+/// radiotap headers for Wi-Fi (from the PHY monitor sniffer, so every frame
+/// the PHY sends or decodes). Records are collected in a shim-owned buffer
+/// and written when it fills, when the flush interval has passed, and when
+/// sim_run returns; a write failure makes sim_run fail.
+///
+/// With compression the file name ends in ".pcap.gz" or ".pcap.zst" and a
+/// background thread per file compresses and writes the filled buffers; the
+/// simulation thread never waits for it. Each flush interval ends a
+/// compressed block, so the file can be decoded up to there during the run.
+/// Fails if the codec is not built in.
+/// @param sim Simulation handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
+/// @param filePrefix Prefix for PCAP file name
+/// @param options Capture options, or NULL for the defaults
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status pcap_enable_ex(ns3_sim sim, ns3_device dev, const char* filePrefix,
+                                      const ns3_pcap_options* options);
+
+/// Capture ring flags
+typedef enum {
+    NS3_CAPTURE_RING_DROP       = 0x1,  ///< Drop new records while the reader is a ring behind
+                                        ///< (default: overwrite the oldest)
+    NS3_CAPTURE_RING_NO_PROMISC = 0x2   ///< PointToPoint/CSMA: only frames sent or received by the device
+} ns3_capture_ring_flags;
+
+/// Capture ring options; zero fields take the defaults
+typedef struct {
+    uint32_t capacityBytes;  ///< Record area, rounded up to a power of two (default 64 MiB)
+    uint32_t snaplen;        ///< Bytes captured per packet (default 65535)
+    uint32_t flags;          ///< ns3_capture_ring_flags
+} ns3_capture_ring_options;
+
+/// Capture ring counters
+typedef struct {
+    uint64_t records;      ///< Records written
+    uint64_t bytes;        ///< Captured bytes written
+    uint64_t dropped;      ///< Records dropped because the reader was behind (drop mode)
+    uint64_t overwritten;  ///< Records overwritten by newer ones (overwrite mode)
+} ns3_capture_ring_stats;
+
+/// Create a live capture ring in POSIX shared memory
+///
+/// PCAP records from attached devices are written into the shared-memory
+/// object `name` (e.g. "/sim-capture"), which other local processes map and
+/// tail while the simulation runs; see src/capture_ring.h for the layout and
+/// the reader protocol, and tools/ringcat.cpp (ns3shim-ringcat) for a reader
+/// that pipes the ring to Wireshark. The simulation never waits for readers:
+/// by default the oldest records are overwritten, and with
+/// NS3_CAPTURE_RING_DROP new records are dropped while the single reader is a
+/// full ring behind. Not available on Windows.
+/// @param sim Simulation handle
+/// @param name Shared-memory object name (a leading '/' is added if missing; an existing object is replaced)
+/// @param options Ring options, or NULL for the defaults
+/// @param outRing Output: capture ring handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status capture_ring_open(ns3_sim sim, const char* name, const ns3_capture_ring_options* options,
+                                         ns3_capture_ring* outRing);
+
+/// Capture a device's frames into a capture ring
+///
+/// All devices of one ring must share a link type (PPP for PointToPoint,
+/// Ethernet for CSMA, 802.11 + radiotap for Wi-Fi).
+/// @param sim Simulation handle
+/// @param ring Capture ring handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status capture_ring_attach(ns3_sim sim, ns3_capture_ring ring, ns3_device dev);
+
+/// Read a capture ring's counters (also valid after close)
+/// @param sim Simulation handle
+/// @param ring Capture ring handle
+/// @param outStats Output: counters
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status capture_ring_get_stats(ns3_sim sim, ns3_capture_ring ring, ns3_capture_ring_stats* outStats);
+
+/// Close a capture ring
+///
+/// Marks the ring closed for readers, unmaps it and removes its name; readers
+/// that have it mapped can finish reading. Later records from attached
+/// devices are dropped. Open rings are closed automatically by sim_destroy.
+/// @param sim Simulation handle
+/// @param ring Capture ring handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status capture_ring_close(ns3_sim sim, ns3_capture_ring ring);
+
+/// Trace file open flags
+typedef enum {
+    NS3_TRACE_FILE_DIRECT  = 0x1, ///< Write blocks with O_DIRECT (Linux; ignored where unsupported)
+    NS3_TRACE_FILE_HEADERS = 0x2  ///< Add header columns (protocol u8, ttl u8, src_addr u32,
+                                  ///< dst_addr u32, src_port u16, dst_port u16; zero when absent)
+} ns3_trace_file_flags;
+
+/// Open a columnar packet trace file
+///
+/// Packet events from attached devices are stored natively, one column per
+/// field (time_s f64, device u64, size u32, direction u8, uid u64, plus the
+/// header columns with NS3_TRACE_FILE_HEADERS), in blocks
+/// of 65536 rows written by a background thread. The footer indexes every
+/// block's column offsets and time range, so analysis tools can mmap single
+/// columns. See src/trace_file.h for the exact layout. No host callbacks are
+/// involved; use this instead of trace_subscribe_packet_events for
+/// high-volume captures.
+/// @param sim Simulation handle
+/// @param path Output file (truncated)
+/// @param flags Bitwise OR of ns3_trace_file_flags (0 = buffered writes)
+/// @param outFile Output: trace file handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status trace_file_open(ns3_sim sim, const char* path, uint32_t flags, ns3_trace_file* outFile);
+
+/// Record packet TX/RX events of a device into a trace file
+/// @param sim Simulation handle
+/// @param file Trace file handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status trace_file_attach(ns3_sim sim, ns3_trace_file file, ns3_device dev);
+
+/// Flush and close a trace file, writing its footer index
+///
+/// Later events from attached devices are dropped. Open trace files are
+/// closed automatically by sim_destroy.
+/// @param sim Simulation handle
+/// @param file Trace file handle
+/// @param outRecordCount Output: number of events written (may be NULL)
+/// @return NS3_OK on success, NS3_ERR if any write failed
+NS3SHIM_API ns3_status trace_file_close(ns3_sim sim, ns3_trace_file file, uint64_t* outRecordCount);
+
+/// Traffic of one device in one time bin
+typedef struct {
+    uint64_t txBytes;   ///< Bytes whose transmission ended in the bin
+    uint64_t rxBytes;   ///< Bytes whose reception ended in the bin
+    uint32_t txPackets; ///< Packets transmitted
+    uint32_t rxPackets; ///< Packets received
+} ns3_bin_counts;
+
+/// Shape of an exported throughput matrix
+typedef struct {
+    uint32_t deviceCount; ///< Matrix rows (attached devices, in attach order)
+    uint32_t binCount;    ///< Matrix columns
+    uint64_t firstBin;    ///< Index of column 0; bin i covers [i, i+1) x binWidthSec
+    double   binWidthSec; ///< Bin width (seconds)
+} ns3_throughput_info;
+
+/// Create a time-binned throughput accumulator
+///
+/// Attached devices are counted natively at PhyTxEnd/PhyRxEnd into fixed-width
+/// time bins. Only the most recent windowBins bins are kept per device, so
+/// memory is bounded by devices x windowBins for any run length.
+/// @param sim Simulation handle
+/// @param binWidthSec Bin width in seconds (> 0)
+/// @param windowBins Bins retained per device (> 0)
+/// @param outThroughput Output: accumulator handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status throughput_create(ns3_sim sim, double binWidthSec, uint32_t windowBins,
+                                         ns3_throughput* outThroughput);
+
+/// Count a device's packets in an accumulator (each device at most once)
+/// @param sim Simulation handle
+/// @param tp Accumulator handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status throughput_attach(ns3_sim sim, ns3_throughput tp, ns3_device dev);
+
+/// Export the retained window as a dense [device x bin] matrix
+///
+/// The window ends at the later of the newest event and the current
+/// simulation time. Call with outMatrix = NULL to obtain the shape only.
+/// Not safe while sim_run executes on another thread; call it from a
+/// sim_schedule callback or between runs.
+/// @param sim Simulation handle
+/// @param tp Accumulator handle
+/// @param outDevices Output: device handle per row (may be NULL)
+/// @param deviceCapacity Number of elements in outDevices
+/// @param outMatrix Output: row-major counts, deviceCount x binCount (may be NULL)
+/// @param matrixCapacity Number of elements in outMatrix
+/// @param outInfo Output: matrix shape
+/// @return NS3_OK on success, NS3_ERR if a non-NULL buffer is too small
+NS3SHIM_API ns3_status throughput_export(ns3_sim sim, ns3_throughput tp,
+                                         ns3_device* outDevices, uint32_t deviceCapacity,
+                                         ns3_bin_counts* outMatrix, uint32_t matrixCapacity,
+                                         ns3_throughput_info* outInfo);
+
 /// Flow statistics structure
 typedef struct {
     uint64_t txPackets;     ///< Total transmitted packets
@@ -333,6 +1051,34 @@ typedef struct {
 /// @return NS3_OK on success
 NS3SHIM_API ns3_status flowmon_install_all(ns3_sim sim, ns3_flowmon* outFlowMon);
 
+/// Flow monitor installation options; zero fields take ns-3's defaults
+typedef struct {
+    int    edgeOnly;           ///< Skip transit nodes: those with more than one non-loopback IPv4 interface
+    double maxPerHopDelaySec;  ///< Packets unseen by any probe for this long count as lost (0 = 10 s)
+    double startTimeSec;       ///< Simulation time monitoring starts (0 = immediately)
+} ns3_flowmon_options;
+
+/// Install flow monitor probes on a subset of nodes
+///
+/// Each probed node costs a classification and a flow-table update per
+/// packet it sends, forwards or receives. Flows are only observed between
+/// probed nodes: probing end hosts alone still yields end-to-end counts,
+/// delay, jitter and histograms, but not timesForwarded or per-hop drop
+/// reasons, and a drop inside the fabric is only detected as a loss after
+/// maxPerHopDelaySec, which then bounds the end-to-end delay instead of one
+/// hop. edgeOnly needs the nodes' IPv4 addresses to be assigned; nodes
+/// without IPv4 are always skipped.
+/// @param sim Simulation handle
+/// @param nodes Candidate nodes (NULL or count 0 = all nodes)
+/// @param count Number of nodes
+/// @param options Installation options (may be NULL)
+/// @param outFlowMon Output: flow monitor handle
+/// @param outProbedNodes Output: number of nodes probed (may be NULL)
+/// @return NS3_OK on success, NS3_ERR if no node qualifies
+NS3SHIM_API ns3_status flowmon_install(ns3_sim sim, const ns3_node* nodes, uint32_t count,
+                                       const ns3_flowmon_options* options, ns3_flowmon* outFlowMon,
+                                       uint32_t* outProbedNodes);
+
 /// Collect flow statistics
 /// @param sim Simulation handle
 /// @param fm Flow monitor handle
@@ -340,6 +1086,663 @@ NS3SHIM_API ns3_status flowmon_install_all(ns3_sim sim, ns3_flowmon* outFlowMon)
 /// @return NS3_OK on success
 NS3SHIM_API ns3_status flowmon_collect(ns3_sim sim, ns3_flowmon fm, ns3_flow_stats* outStats);
 
+/// Flow snapshot options; zero fields take the defaults
+typedef struct {
+    double      epochSec;       ///< Snapshot period in seconds (> 0)
+    uint32_t    epochCapacity;  ///< Most recent epochs kept in memory (default 1024)
+    uint32_t    maxFlows;       ///< Flow columns per epoch (default 256)
+    const char* path;           ///< If not NULL, every epoch is also appended to this file
+} ns3_flow_epoch_options;
+
+/// Retained snapshots
+typedef struct {
+    uint64_t firstEpoch;    ///< Epoch number of row 0 (epoch k is taken k periods after the start)
+    uint32_t epochCount;    ///< Rows retained
+    uint32_t flowCount;     ///< Columns: flow ids 1..flowCount seen so far (at most maxFlows)
+    uint64_t droppedFlows;  ///< Flows with ids beyond maxFlows, not recorded
+    double   epochSec;      ///< Snapshot period in seconds
+    double   startSec;      ///< Simulation time of epoch 0
+} ns3_flow_epochs_info;
+
+/// Caller buffers for flowmon_epochs_export; NULL columns are skipped
+///
+/// Matrices are [epoch x flow], row-major, with epochCount x flowCount
+/// elements; column i is FlowMonitor flow id i + 1. Counters are cumulative.
+typedef struct {
+    double*   timeSec;       ///< Snapshot time per epoch (epochCount elements)
+    uint64_t* txPackets;
+    uint64_t* rxPackets;
+    uint64_t* txBytes;
+    uint64_t* rxBytes;
+    uint64_t* lostPackets;   ///< As of FlowMonitor's latest periodic loss check
+    double*   delaySumSec;
+    double*   jitterSumSec;
+    uint32_t  capacity;      ///< Elements in each matrix buffer
+} ns3_flow_epoch_columns;
+
+/// Snapshot per-flow counters of a flow monitor at a fixed period
+///
+/// Every epochSec of simulation time, starting now, the cumulative counters
+/// of every flow are copied natively into a preallocated ring of
+/// epochCapacity epochs x maxFlows flows, stored one array per counter.
+/// With a path, every epoch is also appended to a file, so all epochs of a
+/// long run are kept (layout in src/flow_epochs.h). No host callbacks are
+/// involved. Like FlowMonitor itself, the periodic event needs sim_stop to
+/// end the run.
+/// @param sim Simulation handle
+/// @param fm Flow monitor handle
+/// @param options Snapshot options (epochSec is required)
+/// @param outEpochs Output: snapshot handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status flowmon_epochs_start(ns3_sim sim, ns3_flowmon fm, const ns3_flow_epoch_options* options,
+                                            ns3_flow_epochs* outEpochs);
+
+/// Export the retained snapshots, oldest first
+///
+/// Call with a NULL columns pointer to obtain the shape only. Not safe while
+/// sim_run executes on another thread.
+/// @param sim Simulation handle
+/// @param epochs Snapshot handle
+/// @param columns Caller buffers (may be NULL)
+/// @param outInfo Output: shape of the export
+/// @return NS3_OK on success, NS3_ERR if columns.capacity is too small
+NS3SHIM_API ns3_status flowmon_epochs_export(ns3_sim sim, ns3_flow_epochs epochs,
+                                             const ns3_flow_epoch_columns* columns,
+                                             ns3_flow_epochs_info* outInfo);
+
+/// Stop taking snapshots
+///
+/// Cancels the periodic event and completes the file, if any. The retained
+/// epochs stay available to flowmon_epochs_export until sim_destroy.
+/// @param sim Simulation handle
+/// @param epochs Snapshot handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status flowmon_epochs_stop(ns3_sim sim, ns3_flow_epochs epochs);
+
+/// FlowMonitor per-flow histograms
+typedef enum {
+    NS3_FLOW_HIST_DELAY       = 0,  ///< One-way delay of received packets (seconds)
+    NS3_FLOW_HIST_JITTER      = 1,  ///< Delay variation between consecutive received packets (seconds)
+    NS3_FLOW_HIST_PACKET_SIZE = 2   ///< Size of transmitted packets (bytes)
+} ns3_flow_hist_kind;
+
+/// Export a FlowMonitor histogram, per selected flow or merged over all flows
+///
+/// Bins are uniform: bin i covers [i * binWidth, (i + 1) * binWidth). The
+/// width is the monitor's DelayBinWidth, JitterBinWidth or
+/// PacketSizeBinWidth attribute. With flowIds, outCounts is a row-major
+/// [flowCount x binCount] matrix, one row per id (ids the monitor has not
+/// seen yield zero rows); with flowIds NULL, outCounts is a single row
+/// summed natively over every flow. binCount is the largest bin count of
+/// the histograms involved.
+/// @param sim Simulation handle
+/// @param fm Flow monitor handle
+/// @param kind Histogram to export
+/// @param flowIds FlowMonitor flow ids (NULL = merge all flows)
+/// @param flowCount Number of flow ids
+/// @param outCounts Output: bin counts (may be NULL to query the shape)
+/// @param capacity Number of elements in outCounts
+/// @param outBinWidth Output: bin width (seconds or bytes)
+/// @param outBinCount Output: bins per row
+/// @return NS3_OK on success, NS3_ERR if a non-NULL buffer is too small
+NS3SHIM_API ns3_status flowmon_histogram(ns3_sim sim, ns3_flowmon fm, ns3_flow_hist_kind kind,
+                                         const uint32_t* flowIds, uint32_t flowCount,
+                                         uint64_t* outCounts, uint32_t capacity,
+                                         double* outBinWidth, uint32_t* outBinCount);
+
+/// Per-flow metrics summarised by flowmon_quantiles
+///
+/// A flow contributes to a metric only where the metric is defined: rate,
+/// delay and jitter need received packets (per epoch: received during the
+/// epoch), loss needs transmitted ones.
+typedef enum {
+    NS3_FLOW_METRIC_THROUGHPUT  = 0,  ///< Received bits per second: over first TX to last RX (epochs: over the epoch)
+    NS3_FLOW_METRIC_FCT         = 1,  ///< Last RX minus first TX, seconds (not defined per epoch)
+    NS3_FLOW_METRIC_MEAN_DELAY  = 2,  ///< delaySum / rxPackets, seconds
+    NS3_FLOW_METRIC_MEAN_JITTER = 3,  ///< jitterSum / (rxPackets - 1), seconds
+    NS3_FLOW_METRIC_LOSS_RATIO  = 4   ///< lostPackets / txPackets
+} ns3_flow_metric;
+
+/// Quantiles of per-flow metrics across all flows of a monitor
+///
+/// Each metric is computed per flow and streamed into a t-digest natively,
+/// so only the results cross the ABI. Estimates are most accurate toward
+/// the tails; memory is O(compression) per metric whatever the flow count.
+/// @param sim Simulation handle
+/// @param fm Flow monitor handle
+/// @param metrics Metrics to summarise
+/// @param metricCount Number of metrics
+/// @param quantiles Quantiles in [0, 1] (e.g., 0.5, 0.95, 0.99)
+/// @param quantileCount Number of quantiles
+/// @param compression t-digest compression (0 = 100; higher is more accurate)
+/// @param outValues Output: [metricCount x quantileCount] values, row-major (0 for metrics without flows)
+/// @param outFlowCounts Output: flows contributing to each metric (may be NULL)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status flowmon_quantiles(ns3_sim sim, ns3_flowmon fm,
+                                         const ns3_flow_metric* metrics, uint32_t metricCount,
+                                         const double* quantiles, uint32_t quantileCount, double compression,
+                                         double* outValues, uint64_t* outFlowCounts);
+
+/// Quantiles of per-flow metrics over one snapshot epoch
+///
+/// Like flowmon_quantiles, but over the counter differences between the
+/// given epoch and the one before it, both of which must be retained.
+/// NS3_FLOW_METRIC_FCT is not defined per epoch.
+/// @param sim Simulation handle
+/// @param epochs Snapshot handle
+/// @param epoch Epoch number (0 = the latest)
+/// @param metrics Metrics to summarise
+/// @param metricCount Number of metrics
+/// @param quantiles Quantiles in [0, 1]
+/// @param quantileCount Number of quantiles
+/// @param compression t-digest compression (0 = 100)
+/// @param outValues Output: [metricCount x quantileCount] values, row-major
+/// @param outFlowCounts Output: flows contributing to each metric (may be NULL)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status flowmon_epochs_quantiles(ns3_sim sim, ns3_flow_epochs epochs, uint64_t epoch,
+                                                const ns3_flow_metric* metrics, uint32_t metricCount,
+                                                const double* quantiles, uint32_t quantileCount, double compression,
+                                                double* outValues, uint64_t* outFlowCounts);
+
+// ============================================================================
+// Latency Histograms
+// ============================================================================
+
+/// Flow index selecting the merge of all flows
+#define NS3_LATENCY_ALL_FLOWS 0xFFFFFFFFu
+
+/// One flow seen by a latency monitor
+typedef struct {
+    uint32_t srcAddr;   ///< IPv4 source address (host byte order)
+    uint32_t dstAddr;   ///< IPv4 destination address (host byte order)
+    uint16_t srcPort;   ///< Source port (0 unless TCP or UDP)
+    uint16_t dstPort;   ///< Destination port (0 unless TCP or UDP)
+    uint8_t  protocol;  ///< IP protocol number
+    uint64_t packets;   ///< Delivered packets
+    double   minSec;    ///< Smallest one-way delay (seconds)
+    double   maxSec;    ///< Largest one-way delay (seconds)
+    double   meanSec;   ///< Mean one-way delay (seconds)
+} ns3_latency_flow;
+
+/// Install per-flow one-way delay histograms on all nodes with IPv4
+///
+/// Packets are stamped with their send time when they leave the sender's
+/// IPv4 layer and measured on local delivery at the receiver; forwarding
+/// nodes are not involved. Flows are IPv4 5-tuples, indexed in order of
+/// their first delivered packet. Each flow holds a fixed log-bucketed
+/// histogram over nanoseconds whose relative bucket width is at most
+/// 2^(1 - precisionBits) (4 bits: 304 buckets, ~1.2 KiB per flow).
+/// Nodes created afterwards are not covered.
+/// @param sim Simulation handle
+/// @param precisionBits Bucket precision, 2..8 (0 = 4)
+/// @param outLatency Output: latency monitor handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status latency_install_all(ns3_sim sim, uint32_t precisionBits, ns3_latency* outLatency);
+
+/// List the flows seen so far
+/// @param sim Simulation handle
+/// @param lat Latency monitor handle
+/// @param outFlows Output: flows by index (may be NULL to query the count)
+/// @param capacity Number of elements in outFlows
+/// @param outCount Output: number of flows
+/// @return NS3_OK on success, NS3_ERR if a non-NULL buffer is too small
+NS3SHIM_API ns3_status latency_flows(ns3_sim sim, ns3_latency lat,
+                                     ns3_latency_flow* outFlows, uint32_t capacity,
+                                     uint32_t* outCount);
+
+/// Delay quantiles of one flow, or of all flows merged
+///
+/// Each result is the upper edge of the bucket holding the quantile,
+/// clamped to the observed minimum and maximum; empty flows yield 0.
+/// @param sim Simulation handle
+/// @param lat Latency monitor handle
+/// @param flowIndex Flow index, or NS3_LATENCY_ALL_FLOWS
+/// @param quantiles Quantiles in [0, 1] (e.g., 0.99, 0.999)
+/// @param count Number of quantiles
+/// @param outSec Output: one delay (seconds) per quantile
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status latency_percentiles(ns3_sim sim, ns3_latency lat, uint32_t flowIndex,
+                                           const double* quantiles, uint32_t count, double* outSec);
+
+/// Raw bucket counts of one flow, or of all flows merged
+///
+/// Bucket i covers [outLowerSec[i], outLowerSec[i + 1]); the last bucket
+/// also absorbs delays beyond the tracked range (~18 minutes).
+/// @param sim Simulation handle
+/// @param lat Latency monitor handle
+/// @param flowIndex Flow index, or NS3_LATENCY_ALL_FLOWS
+/// @param outCounts Output: packets per bucket (may be NULL to query the count)
+/// @param outLowerSec Output: lower bucket bounds in seconds (may be NULL)
+/// @param capacity Number of elements in each non-NULL buffer
+/// @param outBucketCount Output: number of buckets
+/// @return NS3_OK on success, NS3_ERR if a non-NULL buffer is too small
+NS3SHIM_API ns3_status latency_buckets(ns3_sim sim, ns3_latency lat, uint32_t flowIndex,
+                                       uint64_t* outCounts, double* outLowerSec, uint32_t capacity,
+                                       uint32_t* outBucketCount);
+
+// ============================================================================
+// Flow Completion Times
+// ============================================================================
+
+/// Flow completion time tracker options (zero fields take defaults)
+typedef struct {
+    const uint64_t* sizeEdges;  ///< Ascending inclusive upper bounds of the size buckets in bytes (may be NULL)
+    uint32_t sizeEdgeCount;     ///< Number of edges; one more bucket holds larger flows
+    double   idleSec;           ///< Non-TCP flows complete after this long without deliveries (0 = at query time)
+    double   compression;       ///< t-digest compression for quantiles (0 = 100)
+} ns3_fct_options;
+
+/// One flow seen by a completion time tracker
+typedef struct {
+    uint32_t srcAddr;    ///< IPv4 source address (host byte order)
+    uint32_t dstAddr;    ///< IPv4 destination address (host byte order)
+    uint16_t srcPort;    ///< Source port (0 unless TCP or UDP)
+    uint16_t dstPort;    ///< Destination port (0 unless TCP or UDP)
+    uint8_t  protocol;   ///< IP protocol number
+    uint8_t  complete;   ///< 1 if the flow has completed
+    uint64_t bytes;      ///< Bytes carried so far
+    double   startSec;   ///< First payload sent (seconds)
+    double   fctSec;     ///< Completion time (seconds; so far if incomplete)
+} ns3_fct_flow;
+
+/// Completed flows of one size bucket
+typedef struct {
+    uint64_t maxBytes;   ///< Inclusive upper bound (UINT64_MAX for the last bucket)
+    uint64_t flows;      ///< Completed flows in the bucket
+    double   minSec;     ///< Shortest completion time (seconds)
+    double   meanSec;    ///< Mean completion time (seconds)
+    double   maxSec;     ///< Longest completion time (seconds)
+} ns3_fct_bucket;
+
+/// Track flow completion times on all nodes with IPv4
+///
+/// A flow is an IPv4 5-tuple; its completion time runs from the first
+/// payload-bearing packet leaving the sender's IPv4 layer to the last one
+/// delivered at the receiver. TCP flows complete when the sender's FIN is
+/// delivered and are sized by the highest sequence number received;
+/// other flows are sized by the payload delivered and complete after
+/// idleSec without deliveries. Works with any application, so each
+/// BulkSend/PacketSink or UDP transfer is one flow. Costs one hash lookup
+/// per payload packet at the end hosts; nodes created afterwards are not
+/// covered.
+/// @param sim Simulation handle
+/// @param options Size buckets and completion rules (may be NULL: one bucket)
+/// @param outFct Output: tracker handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status fct_install_all(ns3_sim sim, const ns3_fct_options* options, ns3_fct* outFct);
+
+/// List the flows that have sent payload, in order of first appearance
+/// @param sim Simulation handle
+/// @param fct Tracker handle
+/// @param outFlows Output: flows (may be NULL to query the count)
+/// @param capacity Number of elements in outFlows
+/// @param outCount Output: number of flows
+/// @return NS3_OK on success, NS3_ERR if a non-NULL buffer is too small
+NS3SHIM_API ns3_status fct_flows(ns3_sim sim, ns3_fct fct, ns3_fct_flow* outFlows, uint32_t capacity,
+                                 uint32_t* outCount);
+
+/// Completion time distribution of completed flows, bucketed by flow size
+///
+/// Quantiles are estimated with a t-digest per bucket; empty buckets yield 0.
+/// @param sim Simulation handle
+/// @param fct Tracker handle
+/// @param quantiles Quantiles in [0, 1] (may be NULL if quantileCount is 0)
+/// @param quantileCount Number of quantiles
+/// @param outBuckets Output: bucket summaries (may be NULL to query the count)
+/// @param outQuantileSec Output: [bucket x quantile] completion times in seconds, row-major (may be NULL)
+/// @param capacity Number of buckets the outputs hold
+/// @param outBucketCount Output: number of buckets
+/// @return NS3_OK on success, NS3_ERR if a non-NULL buffer is too small
+NS3SHIM_API ns3_status fct_distribution(ns3_sim sim, ns3_fct fct, const double* quantiles, uint32_t quantileCount,
+                                        ns3_fct_bucket* outBuckets, double* outQuantileSec, uint32_t capacity,
+                                        uint32_t* outBucketCount);
+
+// ============================================================================
+// Queue Monitoring
+// ============================================================================
+
+/// Queue and drop event kinds
+typedef enum {
+    NS3_QUEUE_ENQUEUE = 0,  ///< Packet entered the device transmit queue
+    NS3_QUEUE_DEQUEUE = 1,  ///< Packet left the device transmit queue
+    NS3_QUEUE_DROP    = 2,  ///< Device transmit queue dropped a packet
+    NS3_QDISC_ENQUEUE = 3,  ///< Packet entered the root queue disc
+    NS3_QDISC_DEQUEUE = 4,  ///< Packet left the root queue disc
+    NS3_QDISC_DROP    = 5,  ///< Queue disc dropped a packet (before enqueue or after dequeue)
+    NS3_PHY_RX_DROP   = 6,  ///< PHY dropped a received packet
+    NS3_MAC_TX_DROP   = 7   ///< MAC dropped a packet before transmission
+} ns3_queue_event_kind;
+
+/// One queue or drop event
+typedef struct {
+    uint64_t deviceId;  ///< Device handle id
+    double   timeSec;   ///< Simulation time in seconds
+    uint32_t size;      ///< Packet (or queue disc item) size in bytes
+    uint32_t backlog;   ///< Device backlog after the event, in packets
+    uint8_t  kind;      ///< ns3_queue_event_kind
+} ns3_queue_event;
+
+/// Queue event callback
+/// @param user User-provided context pointer
+/// @param event Event record (valid only during the call)
+typedef void(*ns3_queue_event_cb)(void* user, const ns3_queue_event* event);
+
+/// Totals of one device since it was attached
+typedef struct {
+    uint64_t enqueued;       ///< Device queue enqueues
+    uint64_t dequeued;       ///< Device queue dequeues
+    uint64_t dropped;        ///< Device queue drops
+    uint64_t qdiscEnqueued;  ///< Root queue disc enqueues
+    uint64_t qdiscDequeued;  ///< Root queue disc dequeues
+    uint64_t qdiscDropped;   ///< Root queue disc drops
+    uint64_t phyRxDrops;     ///< PHY receive drops
+    uint64_t macTxDrops;     ///< MAC transmit drops
+    uint64_t droppedBytes;   ///< Bytes of all drops above
+    uint32_t backlog;        ///< Current backlog (device queue + queue disc), packets
+    uint32_t maxBacklog;     ///< Peak backlog, packets
+} ns3_queue_counters;
+
+/// Backlog of one device in one time bin
+typedef struct {
+    double   meanPackets;  ///< Time-weighted mean backlog
+    double   coveredSec;   ///< Part of the bin observed (less than the width for the current bin)
+    uint32_t minPackets;   ///< Smallest backlog in the bin
+    uint32_t maxPackets;   ///< Largest backlog in the bin
+} ns3_queue_bin;
+
+/// Create a queue/drop monitor
+///
+/// Attached devices are aggregated natively: per-device counters plus the
+/// backlog (device queue + root queue disc) as a min/max/mean time series
+/// over the most recent windowBins bins. onEvent, if set, additionally
+/// receives every event; leave it NULL to pay only for the aggregation.
+/// @param sim Simulation handle
+/// @param binWidthSec Bin width in seconds (> 0)
+/// @param windowBins Bins retained per device (> 0)
+/// @param onEvent Per-event callback (may be NULL)
+/// @param user User context pointer passed to onEvent
+/// @param outMonitor Output: monitor handle
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status queue_monitor_create(ns3_sim sim, double binWidthSec, uint32_t windowBins,
+                                            ns3_queue_event_cb onEvent, void* user,
+                                            ns3_queue_monitor* outMonitor);
+
+/// Monitor a device's queues and drops (each device at most once)
+///
+/// Connects the device transmit queue (PointToPoint, CSMA), the root queue
+/// disc the traffic control layer has installed on the device (attach after
+/// ipv4_assign, which installs the default one), and the PhyRxDrop and
+/// MacTxDrop traces (Wi-Fi: on its PHY and MAC).
+/// @param sim Simulation handle
+/// @param qm Monitor handle
+/// @param dev Device handle (PointToPoint, CSMA or Wi-Fi)
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status queue_monitor_attach(ns3_sim sim, ns3_queue_monitor qm, ns3_device dev);
+
+/// Export counters and the retained backlog window
+///
+/// The series are extended to the current simulation time first. Rows are
+/// in attach order; the matrix is [device x bin], row-major, with the shape
+/// reported in outInfo as for throughput_export. Call with NULL buffers to
+/// obtain the shape only. Not safe while sim_run executes on another thread.
+/// @param sim Simulation handle
+/// @param qm Monitor handle
+/// @param outDevices Output: device handle per row (may be NULL)
+/// @param outCounters Output: counters per row (may be NULL)
+/// @param deviceCapacity Number of elements in outDevices and outCounters
+/// @param outMatrix Output: backlog bins, deviceCount x binCount (may be NULL)
+/// @param matrixCapacity Number of elements in outMatrix
+/// @param outInfo Output: matrix shape
+/// @return NS3_OK on success, NS3_ERR if a non-NULL buffer is too small
+NS3SHIM_API ns3_status queue_monitor_export(ns3_sim sim, ns3_queue_monitor qm,
+                                            ns3_device* outDevices, ns3_queue_counters* outCounters,
+                                            uint32_t deviceCapacity,
+                                            ns3_queue_bin* outMatrix, uint32_t matrixCapacity,
+                                            ns3_throughput_info* outInfo);
+
+// ============================================================================
+// TCP Bulk Transfers
+// ============================================================================
+
+/// TCP congestion control algorithms
+typedef enum {
+    NS3_TCP_NEWRENO = 0,  ///< TcpNewReno
+    NS3_TCP_CUBIC   = 1,  ///< TcpCubic
+    NS3_TCP_BBR     = 2,  ///< TcpBbr, with pacing enabled on its socket
+    NS3_TCP_DCTCP   = 3   ///< TcpDctcp; needs ECN-marking queue discs on the path
+} ns3_tcp_cc;
+
+/// One transfer of tcp_bulk_install (40 bytes, no padding)
+typedef struct {
+    uint32_t srcNode;              ///< Index into nodes of the sender
+    uint32_t dstNode;              ///< Index into nodes of the receiver; the sender connects to its first IPv4 address
+    uint16_t port;                 ///< Receiver port, unique per dstNode within one call
+    uint16_t congestionControl;    ///< ns3_tcp_cc, used at both ends
+    uint32_t initialCwndSegments;  ///< Initial congestion window in segments (0 = ns-3 default)
+    uint64_t bytes;                ///< Bytes to send (0 = until the sender stops)
+    double   startSec;             ///< Sender start time (the receiver listens from then too)
+    double   stopSec;              ///< Sender stop time (0 = none); must be after startSec
+} ns3_tcp_flow_spec;
+
+/// Socket and summary settings of tcp_bulk_install (zero fields use the defaults)
+typedef struct {
+    uint32_t sendSize;         ///< Bytes per socket write (0 = 1448)
+    uint32_t segmentSize;      ///< TCP segment size (0 = 1448, rather than ns-3's 536)
+    uint32_t sndBufBytes;      ///< Socket send buffer (0 = ns-3 default, 128 KiB)
+    uint32_t rcvBufBytes;      ///< Socket receive buffer (0 = ns-3 default, 128 KiB)
+    double   intervalSec;      ///< Summary interval (0 = 0.1 s)
+    uint32_t windowIntervals;  ///< Intervals retained per flow (0 = 100)
+} ns3_tcp_bulk_options;
+
+/// State of a TCP bulk transfer
+typedef enum {
+    NS3_TCP_FLOW_PENDING  = 0,  ///< Sender not started yet
+    NS3_TCP_FLOW_RUNNING  = 1,  ///< Connecting or sending
+    NS3_TCP_FLOW_COMPLETE = 2,  ///< Receiver has every byte of a finite transfer
+    NS3_TCP_FLOW_FAILED   = 3,  ///< Connection refused or reset before completion
+    NS3_TCP_FLOW_STOPPED  = 4   ///< Sender stopped before completion
+} ns3_tcp_flow_state;
+
+/// Totals of one TCP bulk transfer
+typedef struct {
+    uint64_t txBytes;            ///< Bytes the sender handed to its socket
+    uint64_t rxBytes;            ///< Bytes delivered to the receiver (goodput)
+    double   startSec;           ///< Sender start (-1 while pending)
+    double   firstRxSec;         ///< First byte delivered (-1 = none yet)
+    double   lastRxSec;          ///< Latest byte delivered (-1 = none yet)
+    double   completeSec;        ///< Last byte of a finite transfer delivered (-1 = not yet)
+    double   goodputBps;         ///< rxBytes in bits over startSec to completeSec, or to now while incomplete
+    double   rttSec;             ///< Latest RTT sample (0 = none yet)
+    double   minRttSec;          ///< Smallest RTT sample (0 = none yet)
+    uint32_t cwndBytes;          ///< Current congestion window
+    uint32_t maxCwndBytes;       ///< Largest congestion window
+    uint32_t state;              ///< ns3_tcp_flow_state
+    uint16_t congestionControl;  ///< ns3_tcp_cc of the sender socket's congestion ops (0 while pending)
+    uint16_t pacing;             ///< 1 if the sender socket paces its segments
+} ns3_tcp_flow_stats;
+
+/// Congestion window, RTT and goodput of one TCP transfer in one interval
+typedef struct {
+    uint64_t rxBytes;        ///< Bytes delivered to the receiver in the interval
+    double   cwndMeanBytes;  ///< Time-weighted mean congestion window
+    double   rttMeanSec;     ///< Time-weighted mean of the latest RTT sample (0 = no sample yet)
+    double   rttMinSec;      ///< Smallest RTT sample in effect during the interval
+    double   rttMaxSec;      ///< Largest RTT sample in effect during the interval
+    double   coveredSec;     ///< Part of the interval the transfer was running
+    uint32_t cwndMinBytes;   ///< Smallest congestion window
+    uint32_t cwndMaxBytes;   ///< Largest congestion window
+} ns3_tcp_bin;
+
+/// Install many TCP bulk transfers with native goodput, cwnd and RTT summaries
+///
+/// Each spec gets a BulkSend-style sender, which keeps its socket's send
+/// buffer full until `bytes` are written and then closes, and a
+/// PacketSink-style receiver listening on dstNode:port. The shim creates
+/// both sockets itself, so each transfer has its own congestion control,
+/// buffers and segment size, and its CongestionWindow and LastRTT traces
+/// are connected before the connection opens. Trace changes are folded
+/// natively into per-interval summaries (see tcp_bulk_export); nothing is
+/// called back per change. Every spec is checked before anything is
+/// installed. Memory is about specs x windowIntervals x 72 bytes.
+/// @param sim Simulation handle
+/// @param nodes Nodes the specs refer to by index
+/// @param nodeCount Number of nodes
+/// @param specs Transfers
+/// @param count Number of specs (> 0)
+/// @param options Socket and summary settings (may be NULL for defaults)
+/// @param outSenders Output: sender application per spec, for app_stop (may be NULL)
+/// @param outBulk Output: group handle
+/// @return NS3_OK on success, NS3_ERR if any spec is invalid (nothing installed)
+NS3SHIM_API ns3_status tcp_bulk_install(ns3_sim sim, const ns3_node* nodes, uint32_t nodeCount,
+                                        const ns3_tcp_flow_spec* specs, uint32_t count,
+                                        const ns3_tcp_bulk_options* options, ns3_app* outSenders,
+                                        ns3_tcp_bulk* outBulk);
+
+/// Export per-transfer totals and the retained interval window
+///
+/// Running transfers are extended to the current simulation time first.
+/// Rows are in spec order; the matrix is [transfer x interval], row-major,
+/// with the shape reported in outInfo as for throughput_export (deviceCount
+/// holds the number of transfers). Call with NULL buffers to obtain the
+/// shape only. Not safe while sim_run executes on another thread.
+/// @param sim Simulation handle
+/// @param bulk Group handle
+/// @param outStats Output: totals per transfer (may be NULL)
+/// @param flowCapacity Number of elements in outStats
+/// @param outMatrix Output: interval summaries, transfers x binCount (may be NULL)
+/// @param matrixCapacity Number of elements in outMatrix
+/// @param outInfo Output: matrix shape
+/// @return NS3_OK on success, NS3_ERR if a non-NULL buffer is too small
+NS3SHIM_API ns3_status tcp_bulk_export(ns3_sim sim, ns3_tcp_bulk bulk,
+                                       ns3_tcp_flow_stats* outStats, uint32_t flowCapacity,
+                                       ns3_tcp_bin* outMatrix, uint32_t matrixCapacity,
+                                       ns3_throughput_info* outInfo);
+
+// ============================================================================
+// Parameter Sweeps
+// ============================================================================
+
+/// One sweep dimension: a Config path/attribute and the values it takes
+typedef struct {
+    const char*     path;       ///< Config path (e.g., "/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice")
+    const char*     attrName;   ///< Attribute name (e.g., "DataRate")
+    const ns3_attr* values;     ///< Values for this axis
+    uint32_t        valueCount; ///< Number of values
+} ns3_sweep_axis;
+
+/// Sweep definition: parameter grid x replicated runs over the built scenario
+typedef struct {
+    ns3_flowmon           flowMon;         ///< Flow monitor whose stats are aggregated (required)
+    const ns3_sweep_axis* axes;            ///< Grid axes (may be NULL when axisCount=0)
+    uint32_t              axisCount;       ///< Number of axes; grid size is the product of valueCounts
+    uint32_t              seed;            ///< RngSeedManager seed shared by all runs (0 = keep current seed)
+    uint64_t              firstRun;        ///< First RngSeedManager run number
+    uint32_t              runCount;        ///< Replications per grid point (runs firstRun..firstRun+runCount-1)
+    uint32_t              maxParallel;     ///< Concurrent worker processes (0 = hardware concurrency)
+    double                stopTimeSec;     ///< Stop time applied to every run (0 = use sim_stop of base scenario)
+    double                confidenceLevel; ///< Confidence level for ciHalfWidth (0 = 0.95)
+} ns3_sweep_config;
+
+/// Summary of one metric across the replications of a grid point
+typedef struct {
+    double mean;        ///< Sample mean
+    double stddev;      ///< Sample standard deviation
+    double ciHalfWidth; ///< Student-t confidence interval half-width
+    double min;         ///< Minimum
+    double p50;         ///< Median
+    double p90;         ///< 90th percentile
+    double p95;         ///< 95th percentile
+    double p99;         ///< 99th percentile
+    double max;         ///< Maximum
+} ns3_metric_summary;
+
+/// Aggregated result for one grid point
+typedef struct {
+    uint32_t           pointIndex;    ///< Row-major grid index (axis 0 varies slowest)
+    uint32_t           runsCompleted; ///< Runs that produced statistics
+    uint32_t           runsFailed;    ///< Runs that failed or crashed
+    ns3_metric_summary txPackets;     ///< ns3_flow_stats.txPackets
+    ns3_metric_summary rxPackets;     ///< ns3_flow_stats.rxPackets
+    ns3_metric_summary txBytes;       ///< ns3_flow_stats.txBytes
+    ns3_metric_summary rxBytes;       ///< ns3_flow_stats.rxBytes
+    ns3_metric_summary delaySumSec;   ///< ns3_flow_stats.delaySumSec
+    ns3_metric_summary jitterSumSec;  ///< ns3_flow_stats.jitterSumSec
+    ns3_metric_summary flowCount;     ///< ns3_flow_stats.flowCount
+    ns3_metric_summary meanDelaySec;  ///< delaySumSec / rxPackets
+    ns3_metric_summary meanJitterSec; ///< jitterSumSec / rxPackets
+    ns3_metric_summary lossRatio;     ///< 1 - rxPackets / txPackets
+} ns3_sweep_point_summary;
+
+/// Run a parameter sweep over the built (not yet run) scenario
+///
+/// Each (grid point, run) pair executes in a forked worker process that
+/// inherits the built topology, applies the point's attribute values via
+/// Config::Set, selects the run with RngSeedManager and runs to completion.
+/// Random streams reachable through the attribute graph are re-derived for
+/// the run; streams held privately by models keep the base scenario's run.
+/// Managed callbacks (trace subscriptions, sim_schedule) are suppressed in
+/// workers. The base scenario itself is left unrun. POSIX only.
+/// @param sim Simulation handle (built, not yet run)
+/// @param config Sweep definition
+/// @param outSummaries Output array of per-point summaries (size >= grid size)
+/// @param capacity Number of elements in outSummaries
+/// @return NS3_OK if the sweep completed (individual runs may still fail; see runsFailed)
+NS3SHIM_API ns3_status sim_sweep_run(ns3_sim sim, const ns3_sweep_config* config,
+                                     ns3_sweep_point_summary* outSummaries, uint32_t capacity);
+
+/// Result of one forked run
+typedef struct {
+    uint64_t       run;         ///< RngSeedManager run number used
+    int32_t        status;      ///< NS3_OK if the run completed
+    double         wallTimeSec; ///< Wall-clock time of the run inside its worker
+    ns3_flow_stats stats;       ///< Flow statistics (zero when no flow monitor or status != NS3_OK)
+} ns3_fork_run_result;
+
+/// Run the built scenario once per RNG run without rebuilding it
+///
+/// The topology, routing tables and applications are built once in this
+/// process; each run then executes in a fork()ed worker that shares the built
+/// state copy-on-write, sets RngSeedManager::SetRun, runs and returns its
+/// statistics over a pipe. Setup cost is paid once per batch instead of once
+/// per run. Same worker semantics as sim_sweep_run. POSIX only.
+/// @param sim Simulation handle (built, not yet run)
+/// @param runs Run numbers, one worker per entry
+/// @param count Number of runs
+/// @param fm Flow monitor to collect per run (may be NULL)
+/// @param stopTimeSec Stop time applied to every run (0 = use sim_stop of base scenario)
+/// @param maxParallel Concurrent workers (0 = hardware concurrency)
+/// @param outResults Output array of per-run results (size=count, same order as runs)
+/// @return NS3_OK if at least one run completed
+NS3SHIM_API ns3_status sim_fork_runs(ns3_sim sim, const uint64_t* runs, uint32_t count, ns3_flowmon fm,
+                                     double stopTimeSec, uint32_t maxParallel,
+                                     ns3_fork_run_result* outResults);
+
+// ============================================================================
+// Call Journal
+// ============================================================================
+
+/// Start recording every state-changing API call to a binary journal
+///
+/// The journal captures arguments, returned handles, status and timing of
+/// each call and can be re-executed without the host by `ns3shim-replay`.
+/// Setting the NS3SHIM_JOURNAL environment variable to a path records from
+/// process start without calling this function. Packet and scheduled
+/// callbacks are recorded as subscriptions; replay substitutes native no-ops.
+/// @param path Output file (truncated)
+/// @return NS3_OK on success, NS3_ERR if the file cannot be created or a journal is already open
+///         (see journal_last_error)
+NS3SHIM_API ns3_status journal_open(const char* path);
+
+/// Retrieve why the latest journal_open, or the NS3SHIM_JOURNAL variable, failed
+/// @param buf Output buffer for error string (UTF-8, null-terminated; empty if the latest open succeeded)
+/// @param len Size of output buffer
+/// @return NS3_OK on success
+NS3SHIM_API ns3_status journal_last_error(char* buf, size_t len);
+
+/// Flush and close the journal (no-op if none is open)
+/// @return NS3_OK
+NS3SHIM_API ns3_status journal_close(void);
+
 #ifdef __cplusplus
 }
 #endif
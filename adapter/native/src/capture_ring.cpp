@@ -0,0 +1,133 @@
+// capture_ring.cpp
+// Shared-memory live capture ring (see capture_ring.h for the layout)
+
+#include "capture_ring.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ns3shim {
+
+CaptureRing::~CaptureRing() {
+    Close();
+}
+
+bool CaptureRing::Open(const std::string& name, uint32_t dataBytes, uint32_t snaplen, bool dropWhenFull,
+                       std::string& error) {
+#ifdef _WIN32
+    (void)name;
+    (void)dataBytes;
+    (void)snaplen;
+    (void)dropWhenFull;
+    error = "capture rings require POSIX shared memory";
+    return false;
+#else
+    if (header_) {
+        error = "capture ring already open";
+        return false;
+    }
+    // POSIX object names have one leading slash
+    const std::string shmName = !name.empty() && name[0] == '/' ? name : "/" + name;
+    if (shmName.size() < 2 || shmName.find('/', 1) != std::string::npos) {
+        error = "invalid capture ring name '" + name + "'";
+        return false;
+    }
+
+    snaplen_ = snaplen ? snaplen : PCAP_DEFAULT_SNAPLEN;
+    // Room for at least two full records, so one is always intact
+    uint64_t size = std::max<uint64_t>(dataBytes ? dataBytes : CAPTURE_RING_DEFAULT_BYTES,
+                                       2 * CaptureRingRecordBytes(snaplen_));
+    uint64_t ringBytes = 1;
+    while (ringBytes < size) ringBytes <<= 1;
+
+    // Readers of a previous run keep their mapping of the old object
+    ::shm_unlink(shmName.c_str());
+    const int fd = ::shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        error = "cannot create capture ring '" + shmName + "': " + std::strerror(errno);
+        return false;
+    }
+    const size_t total = CAPTURE_RING_HEADER_BYTES + ringBytes;
+    int mapFlags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    mapFlags |= MAP_POPULATE;  // no page faults on the simulation thread
+#endif
+    void* map = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(total)) == 0) {
+        map = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, mapFlags, fd, 0);
+    }
+    const int mapErrno = errno;
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        ::shm_unlink(shmName.c_str());
+        error = "cannot map capture ring '" + shmName + "': " + std::strerror(mapErrno);
+        return false;
+    }
+
+    // ftruncate zero-fills, so every counter starts at zero
+    header_ = new (map) CaptureRingHeader();
+    std::memcpy(header_->magic, CAPTURE_RING_MAGIC, sizeof(CAPTURE_RING_MAGIC));
+    header_->version = CAPTURE_RING_VERSION;
+    header_->headerBytes = CAPTURE_RING_HEADER_BYTES;
+    header_->flags = dropWhenFull ? CAPTURE_RING_DROP : 0;
+    header_->dataBytes = ringBytes;
+    header_->snaplen = snaplen_;
+
+    name_ = shmName;
+    data_ = static_cast<uint8_t*>(map) + CAPTURE_RING_HEADER_BYTES;
+    mappedBytes_ = total;
+    mask_ = ringBytes - 1;
+    drop_ = dropWhenFull;
+    writePos_ = tailPos_ = pending_ = 0;
+    pendingBytes_ = 0;
+    records_ = bytes_ = dropped_ = overwritten_ = 0;
+    return true;
+#endif
+}
+
+bool CaptureRing::SetLinkType(uint32_t linkType) {
+    if (!header_) return false;
+    uint32_t current = header_->linkType.load(std::memory_order_relaxed);
+    if (current == 0) {
+        header_->linkType.store(linkType, std::memory_order_release);
+        return true;
+    }
+    return current == linkType;
+}
+
+void CaptureRing::Evict(uint64_t end) {
+    while (end - tailPos_ > mask_ + 1) {
+        const uint64_t offset = tailPos_ & mask_;
+        uint32_t capLen;
+        std::memcpy(&capLen, data_ + offset + 8, sizeof(capLen));
+        if (capLen == CAPTURE_RING_PAD) {
+            tailPos_ += mask_ + 1 - offset;
+        } else {
+            tailPos_ += CaptureRingRecordBytes(capLen);
+            ++overwritten_;
+        }
+    }
+    header_->tailPos.store(tailPos_, std::memory_order_relaxed);
+    header_->overwritten.store(overwritten_, std::memory_order_relaxed);
+}
+
+void CaptureRing::Close() {
+#ifndef _WIN32
+    if (!header_) return;
+    header_->closed.store(1, std::memory_order_release);
+    ::munmap(header_, mappedBytes_);
+    ::shm_unlink(name_.c_str());
+    header_ = nullptr;
+    data_ = nullptr;
+    mappedBytes_ = 0;
+#endif
+}
+
+} // namespace ns3shim
@@ -0,0 +1,184 @@
+// capture_ring.h
+// Shared-memory live capture ring (internal to ns3shim)
+//
+// PCAP records are written into a POSIX shared-memory object that other
+// local processes map read-only and tail while the simulation runs. Records
+// are the libpcap record format (see pcap_writer.h), so a reader can emit a
+// pcap file header built from the ring header followed by the record bytes
+// as they sit in the mapping. tools/ringcat.cpp is a reference reader.
+//
+// Object layout (native byte order):
+//
+//   header   CAPTURE_RING_HEADER_BYTES, see CaptureRingHeader
+//   records  dataBytes (a power of two), addressed by byte positions that
+//            only grow; position p lives at offset p & (dataBytes - 1)
+//
+//   record   u32 tsSec | u32 tsUsec | u32 capLen | u32 origLen | data[capLen]
+//            padded to a multiple of 16 bytes
+//   pad      a header with capLen == CAPTURE_RING_PAD: skip to the start of
+//            the record area (records never wrap)
+//
+// The simulator is the only writer and never waits for readers. It writes a
+// record past writePos and then publishes the new writePos (release); a
+// reader loads writePos (acquire) and consumes records up to it.
+//
+// Overwrite mode (default): the oldest records are overwritten. Before the
+// writer reuses space it advances tailPos, the start of the oldest intact
+// record. A reader validates each record after processing it: acquire fence,
+// then if tailPos is past the record's position the record may have been
+// overwritten meanwhile; discard it and resume at tailPos. Any number of
+// readers can tail the ring this way.
+//
+// Drop mode (CAPTURE_RING_DROP): a single reader stores the position it has
+// consumed to in readPos (release), and the writer drops new records that
+// would overwrite unread ones, counting them in `dropped`.
+//
+// `linkType` is zero until the first device is attached. `closed` becomes 1
+// when the simulator closes the ring; the object name is then unlinked, but
+// mappings stay valid.
+
+#ifndef NS3SHIM_CAPTURE_RING_H
+#define NS3SHIM_CAPTURE_RING_H
+
+#include "pcap_writer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace ns3shim {
+
+constexpr char     CAPTURE_RING_MAGIC[4]      = {'N', 'S', '3', 'R'};
+constexpr uint16_t CAPTURE_RING_VERSION       = 1;
+constexpr uint32_t CAPTURE_RING_HEADER_BYTES  = 4096;
+constexpr uint32_t CAPTURE_RING_DEFAULT_BYTES = 64u << 20;
+constexpr uint32_t CAPTURE_RING_ALIGN         = 16;
+constexpr uint32_t CAPTURE_RING_PAD           = 0xffffffffu;  // capLen of a pad record
+constexpr uint32_t CAPTURE_RING_DROP          = 0x1;          // header flags
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring positions are shared between processes");
+
+/// Ring header at offset 0 of the shared-memory object
+struct CaptureRingHeader {
+    char magic[4];                  ///< "NS3R"
+    uint16_t version;               ///< CAPTURE_RING_VERSION
+    uint16_t reserved0;
+    uint32_t headerBytes;           ///< Offset of the record area
+    uint32_t flags;                 ///< CAPTURE_RING_DROP
+    uint64_t dataBytes;             ///< Size of the record area (power of two)
+    uint32_t snaplen;               ///< Largest capLen
+    std::atomic<uint32_t> linkType; ///< libpcap link type (0 until a device is attached)
+    std::atomic<uint32_t> closed;   ///< 1 once the writer is done
+
+    // Written by the simulator
+    alignas(64) std::atomic<uint64_t> writePos;  ///< End of the last complete record
+    std::atomic<uint64_t> tailPos;               ///< Start of the oldest intact record
+    std::atomic<uint64_t> records;               ///< Records written
+    std::atomic<uint64_t> bytes;                 ///< Captured bytes written (capLen sum)
+    std::atomic<uint64_t> dropped;               ///< Drop mode: records dropped for a slow reader
+    std::atomic<uint64_t> overwritten;           ///< Overwrite mode: records overwritten
+
+    // Written by the reader (drop mode)
+    alignas(64) std::atomic<uint64_t> readPos;   ///< Position consumed up to
+};
+
+static_assert(sizeof(CaptureRingHeader) <= CAPTURE_RING_HEADER_BYTES, "capture ring header size");
+
+/// Bytes a record with `capLen` captured bytes occupies in the ring
+constexpr uint64_t CaptureRingRecordBytes(uint32_t capLen) {
+    return (PCAP_RECORD_HEADER_BYTES + uint64_t{capLen} + CAPTURE_RING_ALIGN - 1) & ~uint64_t{CAPTURE_RING_ALIGN - 1};
+}
+
+/// Writer side; the sinks call Begin/Commit like PcapWriter
+class CaptureRing {
+public:
+    CaptureRing() = default;
+    ~CaptureRing();
+
+    CaptureRing(const CaptureRing&) = delete;
+    CaptureRing& operator=(const CaptureRing&) = delete;
+
+    /// Create the shared-memory object `name` (replacing a stale one)
+    /// @param dataBytes Record area size, rounded up to a power of two (0 = 64 MiB)
+    bool Open(const std::string& name, uint32_t dataBytes, uint32_t snaplen, bool dropWhenFull, std::string& error);
+
+    /// Fix the link type on first use; false if it differs from the current one
+    bool SetLinkType(uint32_t linkType);
+
+    /// Start a record (simulation thread only). Returns where its `capLen`
+    /// captured bytes must be copied, or nullptr if the record is dropped or
+    /// the ring is closed. Commit() publishes it.
+    uint8_t* Begin(double timeSec, uint32_t origLen, uint32_t& capLen) {
+        if (!header_) return nullptr;
+        capLen = std::min(origLen, snaplen_);
+        const uint64_t size = CaptureRingRecordBytes(capLen);
+        uint64_t pos = writePos_;
+        const uint64_t offset = pos & mask_;
+        const uint64_t pad = mask_ + 1 - offset < size ? mask_ + 1 - offset : 0;
+
+        if (drop_) {
+            if (pos + pad + size - header_->readPos.load(std::memory_order_acquire) > mask_ + 1) {
+                header_->dropped.store(++dropped_, std::memory_order_relaxed);
+                return nullptr;
+            }
+        } else if (pos + pad + size - tailPos_ > mask_ + 1) {
+            Evict(pos + pad + size);
+            // Readers must see the new tail before the bytes it releases change
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        if (pad) {
+            PcapRecordHeader(data_ + offset, 0.0, CAPTURE_RING_PAD, 0);
+            pos += pad;
+        }
+        uint8_t* record = data_ + (pos & mask_);
+        PcapRecordHeader(record, timeSec, capLen, origLen);
+        pending_ = pos + size;
+        pendingBytes_ = capLen;
+        return record + PCAP_RECORD_HEADER_BYTES;
+    }
+
+    void Commit() {
+        writePos_ = pending_;
+        header_->writePos.store(writePos_, std::memory_order_release);
+        header_->records.store(++records_, std::memory_order_relaxed);
+        bytes_ += pendingBytes_;
+        header_->bytes.store(bytes_, std::memory_order_relaxed);
+    }
+
+    /// Mark the ring closed, unmap it and unlink its name
+    void Close();
+
+    bool IsOpen() const { return header_ != nullptr; }
+    const std::string& Name() const { return name_; }
+    uint64_t Records() const { return records_; }
+    uint64_t Bytes() const { return bytes_; }
+    uint64_t Dropped() const { return dropped_; }
+    uint64_t Overwritten() const { return overwritten_; }
+
+private:
+    /// Advance the tail until [tail, end) fits in the ring
+    void Evict(uint64_t end);
+
+    std::string name_;
+    CaptureRingHeader* header_ = nullptr;
+    uint8_t* data_ = nullptr;
+    size_t mappedBytes_ = 0;
+    uint64_t mask_ = 0;
+    uint32_t snaplen_ = PCAP_DEFAULT_SNAPLEN;
+    bool drop_ = false;
+
+    // Writer-side copies of the shared counters
+    uint64_t writePos_ = 0;
+    uint64_t tailPos_ = 0;
+    uint64_t pending_ = 0;
+    uint32_t pendingBytes_ = 0;
+    uint64_t records_ = 0;
+    uint64_t bytes_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t overwritten_ = 0;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_CAPTURE_RING_H
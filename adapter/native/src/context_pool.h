@@ -0,0 +1,70 @@
+// context_pool.h
+// Slab pool for trace callback contexts (internal to ns3shim)
+//
+// ns-3 trace sinks are bound to raw context pointers, so a context must not
+// move while it is connected. The pool hands out slots from fixed-size slabs
+// and recycles released slots through a free list; all slabs are freed
+// together when the pool is destroyed with its simulation. Subscribe and
+// unsubscribe churn therefore costs no allocation once the pool has grown.
+
+#ifndef NS3SHIM_CONTEXT_POOL_H
+#define NS3SHIM_CONTEXT_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ns3shim {
+
+template <typename T, size_t SlabSize = 64>
+class ContextPool {
+    // Slots are reused and slabs freed without running destructors
+    static_assert(std::is_trivially_destructible<T>::value, "pooled contexts must be trivially destructible");
+
+public:
+    ContextPool() = default;
+    ContextPool(const ContextPool&) = delete;
+    ContextPool& operator=(const ContextPool&) = delete;
+
+    /// Constructs a context in a free slot (aggregate initialization)
+    template <typename... Args>
+    T* Acquire(Args&&... args) {
+        if (free_.empty()) Grow();
+        void* slot = free_.back();
+        free_.pop_back();
+        ++live_;
+        return new (slot) T{std::forward<Args>(args)...};
+    }
+
+    /// Returns a context's slot to the free list
+    void Release(T* ctx) {
+        free_.push_back(ctx);
+        --live_;
+    }
+
+    size_t Live() const { return live_; }
+    size_t Capacity() const { return slabs_.size() * SlabSize; }
+
+private:
+    struct alignas(T) Slot {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    void Grow() {
+        slabs_.emplace_back(new Slot[SlabSize]);
+        Slot* slab = slabs_.back().get();
+        // Hand out the slab front to back
+        for (size_t i = SlabSize; i-- > 0;) free_.push_back(&slab[i]);
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    std::vector<void*> free_;
+    size_t live_ = 0;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_CONTEXT_POOL_H
@@ -0,0 +1,118 @@
+// event_sink.h
+// Simulation-wide batched packet event sink (internal to ns3shim)
+//
+// One host registration receives the TX/RX/drop events of every enabled
+// device as arrays of fixed-size ns3_event records. A device gets a dense
+// slot the first time it is enabled; its trace sinks are bound to that slot
+// once and from then on only the slot's event mask changes, so enabling or
+// muting a device is a single store and there is no per-device callback
+// context or host delegate. Events are appended to one buffer and delivered
+// when it is full or the shim flushes it.
+
+#ifndef NS3SHIM_EVENT_SINK_H
+#define NS3SHIM_EVENT_SINK_H
+
+#include "ns3shim.h"
+#include "packet_filter.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace ns3shim {
+
+class EventSink;
+
+constexpr uint32_t EVENT_SINK_DEFAULT_BATCH = 4096;
+
+/// A device's slot; its trace sinks are bound to it for the simulation's life
+struct EventSlot {
+    EventSink* sink;
+    uint32_t index;                 ///< Reported as ns3_event.slot
+    const DeviceFilter* filter;     ///< Device trace filter slot
+    std::atomic<uint32_t> mask{0};  ///< Enabled NS3_EVENT_MASK bits
+
+    EventSlot(EventSink* s, uint32_t i, const DeviceFilter* f) : sink(s), index(i), filter(f) {}
+
+    bool Wants(uint8_t type) const { return (mask.load(std::memory_order_relaxed) & (1u << type)) != 0; }
+};
+
+class EventSink {
+public:
+    EventSink() = default;
+    EventSink(const EventSink&) = delete;
+    EventSink& operator=(const EventSink&) = delete;
+
+    bool IsOpen() const { return onBatch_ != nullptr; }
+    bool IsFlushing() const { return flushing_; }
+
+    void Open(ns3_event_batch_cb onBatch, void* user, uint32_t batchCapacity) {
+        onBatch_ = onBatch;
+        user_ = user;
+        buffer_.resize(batchCapacity ? batchCapacity : EVENT_SINK_DEFAULT_BATCH);
+        count_ = 0;
+    }
+
+    /// Deliver the pending events, mute every slot and forget the callback
+    void Close() {
+        Flush();
+        for (EventSlot& slot : slots_) slot.mask.store(0, std::memory_order_relaxed);
+        onBatch_ = nullptr;
+        user_ = nullptr;
+    }
+
+    /// Slot of a device, or nullptr if it was never enabled
+    EventSlot* Find(uint64_t deviceId) {
+        auto it = slotByDevice_.find(deviceId);
+        return it == slotByDevice_.end() ? nullptr : &slots_[it->second];
+    }
+
+    /// Assign the next slot to a device (addresses are stable)
+    EventSlot& Add(uint64_t deviceId, const DeviceFilter* filter) {
+        const uint32_t index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back(this, index, filter);
+        slotByDevice_.emplace(deviceId, index);
+        return slots_.back();
+    }
+
+    /// Append an event; true when the batch is full and must be flushed
+    bool Push(uint32_t slot, uint8_t type, double timeSec, uint64_t uid, uint32_t size) {
+        if (!onBatch_) return false;
+        ns3_event& e = buffer_[count_++];
+        e.timeSec = timeSec;
+        e.uid = uid;
+        e.slot = slot;
+        e.size = size;
+        e.type = type;
+        return count_ == buffer_.size();
+    }
+
+    /// Hand the pending events to the host. The buffer is reused only after
+    /// the callback returns; a flush requested from the callback is ignored.
+    void Flush() {
+        if (flushing_ || count_ == 0 || !onBatch_) return;
+        flushing_ = true;
+        const uint32_t count = static_cast<uint32_t>(count_);
+        count_ = 0;
+        onBatch_(user_, buffer_.data(), count);
+        flushing_ = false;
+    }
+
+    size_t Pending() const { return count_; }
+
+private:
+    ns3_event_batch_cb onBatch_ = nullptr;
+    void* user_ = nullptr;
+    std::vector<ns3_event> buffer_;
+    size_t count_ = 0;
+    bool flushing_ = false;
+
+    std::deque<EventSlot> slots_;
+    std::map<uint64_t, uint32_t> slotByDevice_;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_EVENT_SINK_H
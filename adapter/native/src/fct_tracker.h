@@ -0,0 +1,147 @@
+// fct_tracker.h
+// Flow completion times of finite transfers (internal to ns3shim)
+//
+// A flow is an IPv4 5-tuple. Its completion time runs from the first
+// payload-bearing packet leaving the sender's IPv4 layer to the last one
+// delivered at the receiver. TCP flows complete when the sender's FIN is
+// delivered and are sized by the highest sequence number received, so
+// retransmissions are not counted twice; other flows are sized by the
+// payload delivered and complete once idle. Completed flows are grouped
+// into caller-defined size buckets when a distribution is requested.
+
+#ifndef NS3SHIM_FCT_TRACKER_H
+#define NS3SHIM_FCT_TRACKER_H
+
+#include "latency_histogram.h"  // LatencyFlowKey
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3shim {
+
+constexpr uint8_t FCT_PROTO_TCP = 6;
+constexpr uint8_t FCT_TCP_FIN = 0x01;
+constexpr uint8_t FCT_TCP_SYN = 0x02;
+
+/// Progress of one flow
+struct FctFlow {
+    LatencyFlowKey key;
+    int64_t firstTxNs = -1;    ///< First payload sent (-1 = none yet)
+    int64_t lastRxNs = -1;     ///< Last payload delivered (-1 = none yet)
+    uint64_t rxPayload = 0;    ///< Payload bytes delivered, duplicates included
+    uint64_t highSeqEnd = 0;   ///< TCP: bytes up to the highest sequence delivered
+    uint32_t isn = 0;          ///< TCP: initial sequence number from the SYN
+    bool finSeen = false;      ///< TCP: the sender's FIN was delivered
+
+    /// Bytes the flow carried
+    uint64_t Size() const { return key.protocol == FCT_PROTO_TCP ? highSeqEnd : rxPayload; }
+};
+
+class FctTracker {
+public:
+    /// sizeEdges: ascending upper bounds (inclusive) of the size buckets;
+    /// one more bucket holds larger flows
+    FctTracker(std::vector<uint64_t> sizeEdges, int64_t idleNs, double compression)
+        : sizeEdges_(std::move(sizeEdges)), idleNs_(idleNs), compression_(compression) {}
+
+    const std::vector<uint64_t>& SizeEdges() const { return sizeEdges_; }
+    double Compression() const { return compression_; }
+    uint32_t BucketCount() const { return static_cast<uint32_t>(sizeEdges_.size() + 1); }
+    uint32_t FlowCount() const { return static_cast<uint32_t>(flows_.size()); }
+    const FctFlow& Flow(uint32_t index) const { return flows_[index]; }
+
+    /// Size bucket of a flow size
+    uint32_t Bucket(uint64_t bytes) const {
+        return static_cast<uint32_t>(std::lower_bound(sizeEdges_.begin(), sizeEdges_.end(), bytes) -
+                                     sizeEdges_.begin());
+    }
+
+    /// Whether a flow has completed as of nowNs
+    bool Complete(const FctFlow& f, int64_t nowNs) const {
+        if (f.firstTxNs < 0 || f.lastRxNs < 0) return false;
+        if (f.key.protocol == FCT_PROTO_TCP) return f.finSeen;
+        return nowNs - f.lastRxNs >= idleNs_;
+    }
+
+    /// Payload leaving the sender's IPv4 layer
+    void OnSend(const LatencyFlowKey& key, uint32_t payload, int64_t nowNs) {
+        if (payload == 0) return;
+        FctFlow& f = Get(key);
+        if (f.firstTxNs < 0) f.firstTxNs = nowNs;
+    }
+
+    /// Segment delivered to the receiver's L4; seq and flags are TCP only
+    void OnDeliver(const LatencyFlowKey& key, uint32_t payload, uint32_t seq, uint8_t flags, int64_t nowNs) {
+        const bool tcp = key.protocol == FCT_PROTO_TCP;
+        if (payload == 0) {
+            if (tcp && (flags & (FCT_TCP_SYN | FCT_TCP_FIN))) OnControl(key, seq, flags);
+            return;
+        }
+
+        FctFlow& f = Get(key);
+        if (tcp && (flags & FCT_TCP_SYN)) f.isn = seq;
+        f.lastRxNs = nowNs;
+        f.rxPayload += payload;
+        if (tcp) {
+            // The SYN takes sequence number isn; data starts one later
+            const uint64_t end = Unwrap(seq - f.isn - 1, f.highSeqEnd) + payload;
+            f.highSeqEnd = std::max(f.highSeqEnd, end);
+        }
+        if (tcp && (flags & FCT_TCP_FIN)) f.finSeen = true;
+    }
+
+private:
+    // A SYN or FIN without payload. Only a flow that has sent payload is
+    // updated; otherwise a SYN-ACK or the receiver's FIN would open a
+    // reverse flow that never completes, so the ISN is only remembered
+    // for the flow's first payload.
+    void OnControl(const LatencyFlowKey& key, uint32_t seq, uint8_t flags) {
+        auto it = index_.find(key);
+        if (it == index_.end() || flows_[it->second].firstTxNs < 0) {
+            if (flags & FCT_TCP_SYN) pendingIsn_[key] = seq;
+            else pendingIsn_.erase(key);
+            return;
+        }
+        FctFlow& f = flows_[it->second];
+        if (flags & FCT_TCP_SYN) f.isn = seq;
+        if (flags & FCT_TCP_FIN) f.finSeen = true;
+    }
+
+    FctFlow& Get(const LatencyFlowKey& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            it = index_.emplace(key, FlowCount()).first;
+            flows_.emplace_back();
+            flows_.back().key = key;
+            auto pending = pendingIsn_.find(key);
+            if (pending != pendingIsn_.end()) {
+                flows_.back().isn = pending->second;
+                pendingIsn_.erase(pending);
+            }
+        }
+        return flows_[it->second];
+    }
+
+    // 64-bit offset closest to `near` whose low 32 bits are `offset`
+    static uint64_t Unwrap(uint32_t offset, uint64_t near) {
+        const uint64_t wrap = uint64_t{1} << 32;
+        uint64_t value = (near & ~(wrap - 1)) | offset;
+        if (value + wrap / 2 < near) value += wrap;
+        else if (value > near + wrap / 2 && value >= wrap) value -= wrap;
+        return value;
+    }
+
+    std::vector<uint64_t> sizeEdges_;
+    int64_t idleNs_;
+    double compression_;  ///< t-digest compression for distributions (0 = default)
+    std::unordered_map<LatencyFlowKey, uint32_t, LatencyFlowKeyHash> index_;
+    std::vector<FctFlow> flows_;
+    std::unordered_map<LatencyFlowKey, uint32_t, LatencyFlowKeyHash> pendingIsn_;  ///< TCP SYNs of flows without payload yet
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_FCT_TRACKER_H
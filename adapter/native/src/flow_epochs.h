@@ -0,0 +1,240 @@
+// flow_epochs.h
+// Ring of periodic per-flow FlowMonitor snapshots (internal to ns3shim)
+//
+// Every epoch the shim copies the cumulative counters of each FlowMonitor
+// flow into one row of a preallocated ring. Storage is struct-of-arrays:
+// one column per counter, each laid out [epoch slot x flow index], where
+// flow index i is FlowMonitor flow id i + 1. Recording an epoch writes in
+// place and never allocates; the ring keeps the most recent `capacity`
+// epochs.
+//
+// Optionally every epoch is also appended to a file, so a run keeps all of
+// its epochs however small the ring (native byte order):
+//
+//   header  "NS3E" | u16 version | u16 headerBytes | f64 epochSec | u32 maxFlows | u32 reserved
+//   epoch*  u64 epoch | f64 timeSec | u32 flowCount | u32 reserved
+//           | txPackets u64[flowCount] | rxPackets u64[flowCount] | txBytes u64[flowCount]
+//           | rxBytes u64[flowCount] | lostPackets u64[flowCount]
+//           | delaySumSec f64[flowCount] | jitterSumSec f64[flowCount]
+//
+// `epoch` is the absolute epoch number (1 = first snapshot, one period after
+// the start). Counters are cumulative since the monitor was installed;
+// per-epoch rates are differences of consecutive rows.
+
+#ifndef NS3SHIM_FLOW_EPOCHS_H
+#define NS3SHIM_FLOW_EPOCHS_H
+
+#include "ns3shim.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ns3shim {
+
+constexpr char     FLOW_EPOCHS_MAGIC[4]    = {'N', 'S', '3', 'E'};
+constexpr uint16_t FLOW_EPOCHS_VERSION     = 1;
+constexpr uint16_t FLOW_EPOCHS_HEADER_BYTES = 24;
+constexpr uint32_t FLOW_EPOCHS_DEFAULT_CAPACITY = 1024;
+constexpr uint32_t FLOW_EPOCHS_DEFAULT_FLOWS    = 256;
+
+/// Cumulative counters of one flow at one epoch
+struct FlowEpochSample {
+    uint64_t txPackets;
+    uint64_t rxPackets;
+    uint64_t txBytes;
+    uint64_t rxBytes;
+    uint64_t lostPackets;
+    double delaySumSec;
+    double jitterSumSec;
+};
+
+class FlowEpochRing {
+public:
+    enum Counter { TxPackets, RxPackets, TxBytes, RxBytes, LostPackets, COUNTERS };
+    enum Sum { DelaySum, JitterSum, SUMS };
+
+    FlowEpochRing(double epochSec, uint32_t capacity, uint32_t maxFlows)
+        : epochSec_(epochSec),
+          capacity_(capacity ? capacity : FLOW_EPOCHS_DEFAULT_CAPACITY),
+          maxFlows_(maxFlows ? maxFlows : FLOW_EPOCHS_DEFAULT_FLOWS),
+          times_(capacity_, 0.0),
+          rowFlows_(capacity_, 0) {
+        const size_t cells = static_cast<size_t>(capacity_) * maxFlows_;
+        for (auto& column : counters_) column.assign(cells, 0);
+        for (auto& column : sums_) column.assign(cells, 0.0);
+    }
+
+    ~FlowEpochRing() { CloseFile(); }
+
+    FlowEpochRing(const FlowEpochRing&) = delete;
+    FlowEpochRing& operator=(const FlowEpochRing&) = delete;
+
+    double EpochSec() const { return epochSec_; }
+    uint32_t Capacity() const { return capacity_; }
+    uint32_t MaxFlows() const { return maxFlows_; }
+    uint64_t Epochs() const { return epochs_; }
+    uint32_t FlowCount() const { return flowCount_; }
+    uint64_t DroppedFlows() const { return droppedFlows_; }
+    bool HasFile() const { return file_ != nullptr; }
+    const std::string& Path() const { return path_; }
+
+    /// Stream every following epoch to `path` (truncated)
+    bool OpenFile(const std::string& path, std::string& error) {
+        file_ = std::fopen(path.c_str(), "wb");
+        if (!file_) {
+            error = "cannot open '" + path + "': " + std::strerror(errno);
+            return false;
+        }
+        path_ = path;
+        const uint16_t version = FLOW_EPOCHS_VERSION;
+        const uint16_t headerBytes = FLOW_EPOCHS_HEADER_BYTES;
+        const uint32_t reserved = 0;
+        std::fwrite(FLOW_EPOCHS_MAGIC, 1, sizeof(FLOW_EPOCHS_MAGIC), file_);
+        std::fwrite(&version, sizeof(version), 1, file_);
+        std::fwrite(&headerBytes, sizeof(headerBytes), 1, file_);
+        std::fwrite(&epochSec_, sizeof(epochSec_), 1, file_);
+        std::fwrite(&maxFlows_, sizeof(maxFlows_), 1, file_);
+        std::fwrite(&reserved, sizeof(reserved), 1, file_);
+        return !std::ferror(file_);
+    }
+
+    /// Start the next epoch's row
+    void Begin(double timeSec) {
+        ++epochs_;
+        slot_ = static_cast<size_t>((epochs_ - 1) % capacity_);
+        times_[slot_] = timeSec;
+        // Clear what the slot held, in case a flow id is missing this epoch
+        const size_t base = slot_ * maxFlows_;
+        for (auto& column : counters_) std::fill_n(&column[base], rowFlows_[slot_], 0);
+        for (auto& column : sums_) std::fill_n(&column[base], rowFlows_[slot_], 0.0);
+        rowFlows_[slot_] = 0;
+    }
+
+    /// Record one flow of the current epoch (flow ids are 1-based). Flows
+    /// beyond maxFlows are not stored; each such flow is counted once.
+    void Set(uint32_t flowId, const FlowEpochSample& s) {
+        if (flowId == 0) return;
+        const uint32_t index = flowId - 1;
+        if (index >= maxFlows_) {
+            droppedFlows_ = std::max<uint64_t>(droppedFlows_, index - maxFlows_ + 1);
+            return;
+        }
+        const size_t cell = slot_ * maxFlows_ + index;
+        counters_[TxPackets][cell] = s.txPackets;
+        counters_[RxPackets][cell] = s.rxPackets;
+        counters_[TxBytes][cell] = s.txBytes;
+        counters_[RxBytes][cell] = s.rxBytes;
+        counters_[LostPackets][cell] = s.lostPackets;
+        sums_[DelaySum][cell] = s.delaySumSec;
+        sums_[JitterSum][cell] = s.jitterSumSec;
+        rowFlows_[slot_] = std::max(rowFlows_[slot_], index + 1);
+        flowCount_ = std::max(flowCount_, index + 1);
+    }
+
+    /// Complete the current epoch; false if the file write failed
+    bool End() {
+        if (!file_) return true;
+        const uint32_t flows = rowFlows_[slot_];
+        const uint32_t reserved = 0;
+        const size_t base = slot_ * maxFlows_;
+        std::fwrite(&epochs_, sizeof(epochs_), 1, file_);
+        std::fwrite(&times_[slot_], sizeof(double), 1, file_);
+        std::fwrite(&flows, sizeof(flows), 1, file_);
+        std::fwrite(&reserved, sizeof(reserved), 1, file_);
+        for (const auto& column : counters_) std::fwrite(&column[base], sizeof(uint64_t), flows, file_);
+        for (const auto& column : sums_) std::fwrite(&column[base], sizeof(double), flows, file_);
+        return !std::ferror(file_);
+    }
+
+    bool FlushFile() { return !file_ || std::fflush(file_) == 0; }
+
+    bool CloseFile() {
+        if (!file_) return true;
+        const bool ok = std::fclose(file_) == 0;
+        file_ = nullptr;
+        return ok;
+    }
+
+    /// Retained epochs: [firstEpoch, firstEpoch + count)
+    void Window(uint64_t& firstEpoch, uint32_t& count) const {
+        count = static_cast<uint32_t>(std::min<uint64_t>(epochs_, capacity_));
+        firstEpoch = epochs_ - count + 1;
+    }
+
+    /// Ring slot of a retained epoch; false if it is not retained
+    bool SlotOf(uint64_t epoch, size_t& slot) const {
+        uint64_t first = 0;
+        uint32_t count = 0;
+        Window(first, count);
+        if (count == 0 || epoch < first || epoch - first >= count) return false;
+        slot = static_cast<size_t>((epoch - 1) % capacity_);
+        return true;
+    }
+
+    double TimeAt(size_t slot) const { return times_[slot]; }
+
+    /// One flow (0-based index) of a slot; zero if the row has not seen it
+    FlowEpochSample SampleAt(size_t slot, uint32_t index) const {
+        if (index >= rowFlows_[slot]) return FlowEpochSample{};
+        const size_t cell = slot * maxFlows_ + index;
+        return FlowEpochSample{counters_[TxPackets][cell], counters_[RxPackets][cell], counters_[TxBytes][cell],
+                               counters_[RxBytes][cell], counters_[LostPackets][cell], sums_[DelaySum][cell],
+                               sums_[JitterSum][cell]};
+    }
+
+    /// Copy the retained epochs, oldest first, as [epoch x FlowCount()]
+    /// matrices; flows a row has not seen yet read as zero. Null columns
+    /// are skipped.
+    void Export(ns3_flow_epoch_columns& out) const {
+        uint64_t first = 0;
+        uint32_t count = 0;
+        Window(first, count);
+        for (uint32_t row = 0; row < count; ++row) {
+            const size_t slot = static_cast<size_t>((first - 1 + row) % capacity_);
+            if (out.timeSec) out.timeSec[row] = times_[slot];
+            uint64_t* counterOut[COUNTERS] = {out.txPackets, out.rxPackets, out.txBytes, out.rxBytes,
+                                              out.lostPackets};
+            double* sumOut[SUMS] = {out.delaySumSec, out.jitterSumSec};
+            for (int c = 0; c < COUNTERS; ++c) {
+                if (counterOut[c]) CopyRow(counters_[c], slot, row, counterOut[c]);
+            }
+            for (int c = 0; c < SUMS; ++c) {
+                if (sumOut[c]) CopyRow(sums_[c], slot, row, sumOut[c]);
+            }
+        }
+    }
+
+private:
+    template <typename T>
+    void CopyRow(const std::vector<T>& column, size_t slot, uint32_t row, T* out) const {
+        const uint32_t flows = rowFlows_[slot];
+        const T* src = &column[slot * maxFlows_];
+        T* dst = out + static_cast<size_t>(row) * flowCount_;
+        std::copy(src, src + flows, dst);
+        std::fill(dst + flows, dst + flowCount_, T{});
+    }
+
+    double epochSec_;
+    uint32_t capacity_;
+    uint32_t maxFlows_;
+    std::vector<double> times_;
+    std::vector<uint32_t> rowFlows_;  ///< Flow columns written per slot
+    std::vector<uint64_t> counters_[COUNTERS];
+    std::vector<double> sums_[SUMS];
+    uint64_t epochs_ = 0;
+    size_t slot_ = 0;
+    uint32_t flowCount_ = 0;
+    uint64_t droppedFlows_ = 0;
+
+    std::FILE* file_ = nullptr;
+    std::string path_;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_FLOW_EPOCHS_H
@@ -0,0 +1,182 @@
+// journal.cpp
+// Binary API call journal writer (see journal.h for the file format)
+
+#include "journal.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace ns3shim {
+
+namespace {
+
+// Records are staged here and written in large chunks
+constexpr size_t JOURNAL_BUFFER_BYTES = 1 << 20;
+
+uint64_t SteadyNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // anonymous namespace
+
+thread_local int JournalScope::depth_ = 0;
+thread_local double JournalScope::callbackTimeSec_ = -1.0;
+
+Journal& Journal::Instance() {
+    static Journal instance;
+    return instance;
+}
+
+Journal::Journal() {
+    // Record without touching the host: NS3SHIM_JOURNAL=/path/to/run.ns3j;
+    // a failure is kept for journal_last_error
+    if (const char* path = std::getenv("NS3SHIM_JOURNAL")) {
+        std::string error;
+        if (*path) Open(path, error);
+    }
+}
+
+Journal::~Journal() {
+    Close();
+}
+
+bool Journal::Open(const std::string& path, std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        error = lastError_ = "journal already open";
+        return false;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = lastError_ = "cannot open journal '" + path + "': " + std::strerror(errno);
+        return false;
+    }
+
+    JournalFileHeader header{};
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.headerSize = sizeof(JournalFileHeader);
+    header.wallClockStartNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+        std::fclose(file);
+        error = lastError_ = "cannot write journal header";
+        return false;
+    }
+
+    file_ = file;
+    lastError_.clear();
+    buffer_.clear();
+    buffer_.reserve(JOURNAL_BUFFER_BYTES);
+    openedAtNs_ = SteadyNs();
+    nextSimId_ = 1;
+    simIds_.clear();
+    open_.store(true, std::memory_order_release);
+    return true;
+}
+
+std::string Journal::LastError() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastError_;
+}
+
+void Journal::Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) return;
+
+    open_.store(false, std::memory_order_release);
+    FlushLocked();
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+uint64_t Journal::NowNs() const {
+    return SteadyNs() - openedAtNs_;
+}
+
+uint32_t Journal::RegisterSim(const void* sim) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint32_t id = nextSimId_++;
+    simIds_[sim] = id;
+    return id;
+}
+
+uint32_t Journal::SimId(const void* sim) {
+    if (!sim) return 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = simIds_.find(sim);
+    return it == simIds_.end() ? 0 : it->second;
+}
+
+void Journal::ForgetSim(const void* sim) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    simIds_.erase(sim);
+}
+
+void Journal::Write(JournalRecordHeader header, const std::string& payload) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) return;
+
+    header.payloadSize = static_cast<uint32_t>(payload.size());
+    const size_t total = sizeof(header) + payload.size();
+    if (buffer_.size() + total > JOURNAL_BUFFER_BYTES) {
+        FlushLocked();
+    }
+
+    const char* h = reinterpret_cast<const char*>(&header);
+    buffer_.insert(buffer_.end(), h, h + sizeof(header));
+    buffer_.insert(buffer_.end(), payload.begin(), payload.end());
+
+    // Runs are long and a crash mid-run should still leave the setup on disk
+    if (static_cast<JournalOp>(header.op) == JournalOp::SimRun ||
+        static_cast<JournalOp>(header.op) == JournalOp::SimDestroy) {
+        FlushLocked();
+    }
+}
+
+void Journal::FlushLocked() {
+    if (!file_ || buffer_.empty()) return;
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    std::fflush(file_);
+    buffer_.clear();
+}
+
+JournalScope::~JournalScope() {
+    --depth_;
+    if (!active_) return;
+
+    try {
+        Journal& journal = Journal::Instance();
+
+        JournalRecordHeader header{};
+        header.op = static_cast<uint16_t>(op_);
+        header.flags = status_ == NS3_OK ? JOURNAL_FLAG_OK : 0;
+        if (callbackTimeSec_ >= 0.0) {
+            header.flags |= JOURNAL_FLAG_IN_CALLBACK;
+            header.simTimeSec = callbackTimeSec_;
+        }
+        header.startNs = startNs_;
+        header.durationNs = journal.NowNs() - startNs_;
+
+        if (status_ == NS3_OK && outputs_) {
+            outputs_(record_);
+        }
+
+        // Created simulations get their ordinal from outputs_; destroyed ones
+        // keep theirs for this last record only
+        header.simId = journal.SimId(sim_);
+        journal.Write(header, record_.Bytes());
+
+        if (op_ == JournalOp::SimDestroy && sim_) {
+            journal.ForgetSim(sim_);
+        }
+    } catch (...) {
+        // Journaling must never affect the call being journaled
+    }
+}
+
+} // namespace ns3shim
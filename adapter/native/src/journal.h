@@ -0,0 +1,437 @@
+// journal.h
+// Binary API call journal (internal to ns3shim and ns3shim-replay)
+//
+// When enabled (journal_open or the NS3SHIM_JOURNAL environment variable),
+// every state-changing shim call is appended to a compact binary file with
+// its arguments, returned handles, status, start time and duration. The
+// ns3shim-replay tool re-executes a journal through the C ABI, which both
+// reproduces a host's simulation without its managed stack and separates
+// shim + ns-3 cost from P/Invoke and host overhead.
+//
+// File layout (native byte order; little-endian on all supported platforms):
+//
+//   header   "NS3J" | u16 version | u16 headerSize | u64 wallClockStartNs
+//   record*  u16 op | u16 flags | u32 payloadSize | u64 startNs | u64 durationNs
+//            | u32 simId | u32 reserved | f64 simTimeSec | payload[payloadSize]
+//
+// startNs is relative to journal open (steady clock). simId is a journal-local
+// ordinal assigned when a simulation is created (0 = none). The payload holds
+// the op's inputs followed, when flags has JOURNAL_FLAG_OK, by its outputs.
+// Calls made by host callbacks while the simulation runs carry
+// JOURNAL_FLAG_IN_CALLBACK and the simulation time of the callback; they are
+// written before the enclosing sim_run record, which completes last.
+// Field encodings: integers and doubles are raw; strings are u32 length
+// (0xFFFFFFFF = NULL) + bytes; handles are u64 ids; handle arrays are
+// u32 count + u64 ids. Queries that do not change simulation state
+// (sim_now, sim_is_running, ns3_last_error, node_get_system_id, sim_get_rank,
+// trace_get_stats,
+// partition_nodes, throughput_export, latency_flows/percentiles/buckets,
+// queue_monitor_export, capture_ring_get_stats, flowmon_epochs_export,
+// flowmon_histogram, flowmon_quantiles, flowmon_epochs_quantiles,
+// fct_flows, fct_distribution, workload_stats, tcp_bulk_export,
+// app_pcap_replay_stats) are not journaled.
+
+#ifndef NS3SHIM_JOURNAL_H
+#define NS3SHIM_JOURNAL_H
+
+#include "ns3shim.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ns3shim {
+
+constexpr char     JOURNAL_MAGIC[4]         = {'N', 'S', '3', 'J'};
+constexpr uint16_t JOURNAL_VERSION          = 4;  // 3: pcap compression; 4: handle-returning subscriptions are separate ops
+constexpr uint16_t JOURNAL_FLAG_OK          = 0x0001;
+constexpr uint16_t JOURNAL_FLAG_IN_CALLBACK = 0x0002;
+constexpr uint32_t JOURNAL_NULL_STRING      = 0xFFFFFFFFu;
+
+/// Journaled operations; values are part of the file format
+enum class JournalOp : uint16_t {
+    SimCreate                   = 1,
+    SimCreateEx                 = 2,
+    SimSetSeed                  = 3,
+    SimRun                      = 4,
+    SimStop                     = 5,
+    SimSchedule                 = 6,
+    SimDestroy                  = 7,
+    NodesCreate                 = 8,
+    InternetInstall             = 9,
+    P2PInstall                  = 10,
+    CsmaInstall                 = 11,
+    WifiInstallStaAp            = 12,
+    MobilitySetConstantPosition = 13,
+    Ipv4Assign                  = 14,
+    Ipv4PopulateRoutingTables   = 15,
+    AppUdpEchoServer            = 16,
+    AppUdpEchoClient            = 17,
+    AppStart                    = 18,
+    AppStop                     = 19,
+    TraceSubscribePacketEvents  = 20,
+    PcapEnable                  = 21,
+    FlowMonInstallAll           = 22,
+    FlowMonCollect              = 23,
+    SimSweepRun                 = 24,
+    SimForkRuns                 = 25,
+    ConfigSet                   = 26,
+    TraceFileOpen               = 27,
+    TraceFileAttach             = 28,
+    TraceFileClose              = 29,
+    ThroughputCreate            = 30,
+    ThroughputAttach            = 31,
+    LatencyInstallAll           = 32,
+    TraceSetFilter              = 33,
+    TraceSubscribePacketEventsEx = 34,
+    QueueMonitorCreate          = 35,
+    QueueMonitorAttach          = 36,
+    TraceUnsubscribe            = 37,
+    PcapEnableEx                = 38,
+    CaptureRingOpen             = 39,
+    CaptureRingAttach           = 40,
+    CaptureRingClose            = 41,
+    EventSinkOpen               = 42,
+    EventSinkEnable             = 43,
+    EventSinkFlush              = 44,
+    EventSinkClose              = 45,
+    FlowEpochsStart             = 46,
+    FlowEpochsStop              = 47,
+    FlowMonInstall              = 48,
+    FctInstallAll               = 49,
+    AppInstallBulk              = 50,
+    WorkloadOpen                = 51,
+    AppTrafficGen               = 52,
+    TcpBulkInstall              = 53,
+    AppPcapReplay               = 54,
+    TraceSubscribePacketEventsHandle   = 55,
+    TraceSubscribePacketEventsExHandle = 56,
+};
+
+/// C ABI name of an operation (for reports)
+inline const char* JournalOpName(JournalOp op) {
+    switch (op) {
+        case JournalOp::SimCreate: return "sim_create";
+        case JournalOp::SimCreateEx: return "sim_create_ex";
+        case JournalOp::SimSetSeed: return "sim_set_seed";
+        case JournalOp::SimRun: return "sim_run";
+        case JournalOp::SimStop: return "sim_stop";
+        case JournalOp::SimSchedule: return "sim_schedule";
+        case JournalOp::SimDestroy: return "sim_destroy";
+        case JournalOp::NodesCreate: return "nodes_create";
+        case JournalOp::InternetInstall: return "internet_install";
+        case JournalOp::P2PInstall: return "p2p_install";
+        case JournalOp::CsmaInstall: return "csma_install";
+        case JournalOp::WifiInstallStaAp: return "wifi_install_sta_ap";
+        case JournalOp::MobilitySetConstantPosition: return "mobility_set_constant_position";
+        case JournalOp::Ipv4Assign: return "ipv4_assign";
+        case JournalOp::Ipv4PopulateRoutingTables: return "ipv4_populate_routing_tables";
+        case JournalOp::AppUdpEchoServer: return "app_udpecho_server";
+        case JournalOp::AppUdpEchoClient: return "app_udpecho_client";
+        case JournalOp::AppStart: return "app_start";
+        case JournalOp::AppStop: return "app_stop";
+        case JournalOp::TraceSubscribePacketEvents: return "trace_subscribe_packet_events";
+        case JournalOp::PcapEnable: return "pcap_enable";
+        case JournalOp::FlowMonInstallAll: return "flowmon_install_all";
+        case JournalOp::FlowMonCollect: return "flowmon_collect";
+        case JournalOp::SimSweepRun: return "sim_sweep_run";
+        case JournalOp::SimForkRuns: return "sim_fork_runs";
+        case JournalOp::ConfigSet: return "config_set";
+        case JournalOp::TraceFileOpen: return "trace_file_open";
+        case JournalOp::TraceFileAttach: return "trace_file_attach";
+        case JournalOp::TraceFileClose: return "trace_file_close";
+        case JournalOp::ThroughputCreate: return "throughput_create";
+        case JournalOp::ThroughputAttach: return "throughput_attach";
+        case JournalOp::LatencyInstallAll: return "latency_install_all";
+        case JournalOp::TraceSetFilter: return "trace_set_filter";
+        case JournalOp::TraceSubscribePacketEventsEx: return "trace_subscribe_packet_events_ex";
+        case JournalOp::QueueMonitorCreate: return "queue_monitor_create";
+        case JournalOp::QueueMonitorAttach: return "queue_monitor_attach";
+        case JournalOp::TraceUnsubscribe: return "trace_unsubscribe";
+        case JournalOp::PcapEnableEx: return "pcap_enable_ex";
+        case JournalOp::CaptureRingOpen: return "capture_ring_open";
+        case JournalOp::CaptureRingAttach: return "capture_ring_attach";
+        case JournalOp::CaptureRingClose: return "capture_ring_close";
+        case JournalOp::EventSinkOpen: return "event_sink_open";
+        case JournalOp::EventSinkEnable: return "event_sink_enable";
+        case JournalOp::EventSinkFlush: return "event_sink_flush";
+        case JournalOp::EventSinkClose: return "event_sink_close";
+        case JournalOp::FlowEpochsStart: return "flowmon_epochs_start";
+        case JournalOp::FlowEpochsStop: return "flowmon_epochs_stop";
+        case JournalOp::FlowMonInstall: return "flowmon_install";
+        case JournalOp::FctInstallAll: return "fct_install_all";
+        case JournalOp::AppInstallBulk: return "app_install_bulk";
+        case JournalOp::WorkloadOpen: return "workload_open";
+        case JournalOp::AppTrafficGen: return "app_traffic_gen";
+        case JournalOp::TcpBulkInstall: return "tcp_bulk_install";
+        case JournalOp::AppPcapReplay: return "app_pcap_replay";
+        case JournalOp::TraceSubscribePacketEventsHandle: return "trace_subscribe_packet_events_handle";
+        case JournalOp::TraceSubscribePacketEventsExHandle: return "trace_subscribe_packet_events_ex_handle";
+    }
+    return "unknown";
+}
+
+#pragma pack(push, 1)
+struct JournalFileHeader {
+    char     magic[4];
+    uint16_t version;
+    uint16_t headerSize;
+    uint64_t wallClockStartNs;
+};
+
+struct JournalRecordHeader {
+    uint16_t op;
+    uint16_t flags;
+    uint32_t payloadSize;
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint32_t simId;
+    uint32_t reserved;
+    double   simTimeSec;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(JournalFileHeader) == 16, "journal header layout");
+static_assert(sizeof(JournalRecordHeader) == 40, "journal record header layout");
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+/// Append-only payload encoder
+class JournalRecord {
+public:
+    JournalRecord& U8(uint8_t v) { return Raw(&v, sizeof(v)); }
+    JournalRecord& U16(uint16_t v) { return Raw(&v, sizeof(v)); }
+    JournalRecord& U32(uint32_t v) { return Raw(&v, sizeof(v)); }
+    JournalRecord& I32(int32_t v) { return Raw(&v, sizeof(v)); }
+    JournalRecord& U64(uint64_t v) { return Raw(&v, sizeof(v)); }
+    JournalRecord& F64(double v) { return Raw(&v, sizeof(v)); }
+
+    JournalRecord& Str(const char* s) {
+        if (!s) return U32(JOURNAL_NULL_STRING);
+        const uint32_t len = static_cast<uint32_t>(std::strlen(s));
+        U32(len);
+        return Raw(s, len);
+    }
+
+    template <typename H>
+    JournalRecord& Handle(H* h) { return U64(reinterpret_cast<uint64_t>(h)); }
+
+    template <typename H>
+    JournalRecord& Handles(H* const* hs, uint32_t count) {
+        if (!hs) count = 0;
+        U32(count);
+        for (uint32_t i = 0; i < count; ++i) Handle(hs[i]);
+        return *this;
+    }
+
+    JournalRecord& Attr(const ns3_attr& a) {
+        I32(a.kind);
+        switch (a.kind) {
+            case NS3_ATTR_BOOL: return I32(a.b);
+            case NS3_ATTR_UINT: return U64(a.u);
+            case NS3_ATTR_DOUBLE: return F64(a.d);
+            case NS3_ATTR_STRING: return Str(a.s);
+        }
+        return *this;
+    }
+
+    const std::string& Bytes() const { return buf_; }
+
+private:
+    JournalRecord& Raw(const void* p, size_t n) {
+        buf_.append(static_cast<const char*>(p), n);
+        return *this;
+    }
+
+    std::string buf_;
+};
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+/// Bounds-checked payload decoder; throws std::runtime_error on truncation
+class JournalCursor {
+public:
+    JournalCursor(const uint8_t* data, size_t size) : p_(data), end_(data + size) {}
+
+    uint8_t U8() { return Read<uint8_t>(); }
+    uint16_t U16() { return Read<uint16_t>(); }
+    uint32_t U32() { return Read<uint32_t>(); }
+    int32_t I32() { return Read<int32_t>(); }
+    uint64_t U64() { return Read<uint64_t>(); }
+    double F64() { return Read<double>(); }
+
+    /// Returns false for a NULL string
+    bool Str(std::string& out) {
+        const uint32_t len = U32();
+        if (len == JOURNAL_NULL_STRING) {
+            out.clear();
+            return false;
+        }
+        Need(len);
+        out.assign(reinterpret_cast<const char*>(p_), len);
+        p_ += len;
+        return true;
+    }
+
+    std::vector<uint64_t> Handles() {
+        std::vector<uint64_t> ids(U32());
+        for (uint64_t& id : ids) id = U64();
+        return ids;
+    }
+
+    /// Decodes an attribute; string storage is kept in `storage`
+    ns3_attr Attr(std::string& storage) {
+        ns3_attr a{};
+        a.kind = static_cast<ns3_attr_kind>(I32());
+        switch (a.kind) {
+            case NS3_ATTR_BOOL: a.b = I32(); break;
+            case NS3_ATTR_UINT: a.u = U64(); break;
+            case NS3_ATTR_DOUBLE: a.d = F64(); break;
+            case NS3_ATTR_STRING: a.s = Str(storage) ? storage.c_str() : nullptr; break;
+            default: throw std::runtime_error("unknown attribute kind");
+        }
+        return a;
+    }
+
+    bool AtEnd() const { return p_ == end_; }
+
+private:
+    void Need(size_t n) const {
+        if (static_cast<size_t>(end_ - p_) < n) throw std::runtime_error("truncated journal record");
+    }
+
+    template <typename T>
+    T Read() {
+        Need(sizeof(T));
+        T v;
+        std::memcpy(&v, p_, sizeof(T));
+        p_ += sizeof(T);
+        return v;
+    }
+
+    const uint8_t* p_;
+    const uint8_t* end_;
+};
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+/// Process-wide journal sink
+class Journal {
+public:
+    static Journal& Instance();
+
+    bool Open(const std::string& path, std::string& error);
+    void Close();
+    bool IsOpen() const { return open_.load(std::memory_order_acquire); }
+
+    /// Why the latest Open failed (empty after a successful one)
+    std::string LastError();
+
+    /// Nanoseconds since the journal was opened
+    uint64_t NowNs() const;
+
+    /// Assign a journal ordinal to a newly created simulation
+    uint32_t RegisterSim(const void* sim);
+    /// Ordinal of a live simulation (0 if unknown)
+    uint32_t SimId(const void* sim);
+    void ForgetSim(const void* sim);
+
+    void Write(JournalRecordHeader header, const std::string& payload);
+
+private:
+    Journal();
+    ~Journal();
+    void FlushLocked();
+
+    std::atomic<bool> open_{false};
+    std::mutex mutex_;
+    std::FILE* file_ = nullptr;
+    std::string lastError_;
+    std::vector<char> buffer_;
+    uint64_t openedAtNs_ = 0;
+    uint32_t nextSimId_ = 1;
+    std::map<const void*, uint32_t> simIds_;
+};
+
+/// Records one API call: inputs on entry, status and outputs on exit.
+/// Calls made by the shim to its own entry points are not journaled again.
+class JournalScope {
+public:
+    JournalScope(JournalOp op, const void* sim)
+        : op_(op), sim_(sim), active_(depth_++ == 0 && Journal::Instance().IsOpen()) {
+        if (active_) startNs_ = Journal::Instance().NowNs();
+    }
+
+    /// Marks a host callback invocation: calls made from it are journaled
+    /// (they are not shim-internal) and stamped with the simulation time
+    class CallbackFrame {
+    public:
+        explicit CallbackFrame(double simTimeSec)
+            : savedDepth_(depth_), savedTime_(callbackTimeSec_) {
+            depth_ = 0;
+            callbackTimeSec_ = simTimeSec;
+        }
+
+        ~CallbackFrame() {
+            depth_ = savedDepth_;
+            callbackTimeSec_ = savedTime_;
+        }
+
+        CallbackFrame(const CallbackFrame&) = delete;
+        CallbackFrame& operator=(const CallbackFrame&) = delete;
+
+    private:
+        int savedDepth_;
+        double savedTime_;
+    };
+
+    ~JournalScope();
+
+    JournalScope(const JournalScope&) = delete;
+    JournalScope& operator=(const JournalScope&) = delete;
+
+    explicit operator bool() const { return active_; }
+
+    /// Input encoder (only meaningful when the scope is active)
+    JournalRecord& In() { return record_; }
+
+    /// Encoder for outputs, invoked on exit only if the call succeeded
+    void OnOk(std::function<void(JournalRecord&)> outputs) { outputs_ = std::move(outputs); }
+
+    /// Record the call's status and pass it through
+    ns3_status Status(ns3_status status) {
+        status_ = status;
+        return status;
+    }
+
+    ns3_status Ok() { return Status(NS3_OK); }
+
+private:
+    static thread_local int depth_;
+    static thread_local double callbackTimeSec_;  // < 0 outside host callbacks
+
+    JournalOp op_;
+    const void* sim_;
+    bool active_;
+    uint64_t startNs_ = 0;
+    ns3_status status_ = NS3_ERR;
+    JournalRecord record_;
+    std::function<void(JournalRecord&)> outputs_;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_JOURNAL_H
@@ -0,0 +1,184 @@
+// latency_histogram.h
+// Per-flow log-bucketed latency histograms (internal to ns3shim)
+//
+// HDR-style layout over integer nanoseconds: values below 2^bits get one
+// bucket each; above that every power-of-two range is split into 2^(bits-1)
+// equal buckets, so the relative bucket width never exceeds 2^(1-bits).
+// Values up to LATENCY_MAX_NS are resolved; larger ones land in the last
+// bucket. A histogram is a fixed array of 32-bit counts (304 buckets,
+// ~1.2 KiB at the default 4 bits), independent of the packet count.
+
+#ifndef NS3SHIM_LATENCY_HISTOGRAM_H
+#define NS3SHIM_LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3shim {
+
+constexpr uint32_t LATENCY_DEFAULT_BITS = 4;
+constexpr uint32_t LATENCY_MIN_BITS = 2;
+constexpr uint32_t LATENCY_MAX_BITS = 8;
+constexpr uint32_t LATENCY_RANGE_LOG2 = 40;  // 2^40 ns ~ 18 minutes
+constexpr uint64_t LATENCY_MAX_NS = (uint64_t{1} << LATENCY_RANGE_LOG2) - 1;
+
+/// Bucket index <-> value mapping for a given precision
+class LatencyLayout {
+public:
+    explicit LatencyLayout(uint32_t bits)
+        : bits_(bits), half_(uint64_t{1} << (bits - 1)),
+          bucketCount_(static_cast<uint32_t>(half_ * (LATENCY_RANGE_LOG2 + 2 - bits))) {}
+
+    uint32_t Bits() const { return bits_; }
+    uint32_t BucketCount() const { return bucketCount_; }
+
+    uint32_t Index(uint64_t ns) const {
+        if (ns > LATENCY_MAX_NS) ns = LATENCY_MAX_NS;
+        if (ns < 2 * half_) return static_cast<uint32_t>(ns);
+        const uint32_t shift = Log2(ns) - (bits_ - 1);
+        return static_cast<uint32_t>(half_ * shift + (ns >> shift));
+    }
+
+    /// Smallest value mapped to a bucket
+    uint64_t Lower(uint32_t index) const {
+        if (index < 2 * half_) return index;
+        const uint64_t shift = index / half_ - 1;
+        return (index % half_ + half_) << shift;
+    }
+
+    /// Largest value mapped to a bucket
+    uint64_t Upper(uint32_t index) const {
+        return index + 1 < bucketCount_ ? Lower(index + 1) - 1 : LATENCY_MAX_NS;
+    }
+
+private:
+    static uint32_t Log2(uint64_t v) {
+        uint32_t r = 0;
+        while (v >>= 1) ++r;
+        return r;
+    }
+
+    uint32_t bits_;
+    uint64_t half_;
+    uint32_t bucketCount_;
+};
+
+/// One flow's delay distribution
+class LatencyHistogram {
+public:
+    explicit LatencyHistogram(const LatencyLayout& layout) : counts_(layout.BucketCount(), 0) {}
+
+    void Record(const LatencyLayout& layout, uint64_t ns) {
+        uint32_t& bucket = counts_[layout.Index(ns)];
+        if (bucket != std::numeric_limits<uint32_t>::max()) ++bucket;
+        ++count_;
+        sumNs_ += static_cast<double>(ns);
+        minNs_ = std::min(minNs_, ns);
+        maxNs_ = std::max(maxNs_, ns);
+    }
+
+    void Merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            const uint64_t sum = uint64_t{counts_[i]} + other.counts_[i];
+            counts_[i] = static_cast<uint32_t>(std::min<uint64_t>(sum, std::numeric_limits<uint32_t>::max()));
+        }
+        count_ += other.count_;
+        sumNs_ += other.sumNs_;
+        minNs_ = std::min(minNs_, other.minNs_);
+        maxNs_ = std::max(maxNs_, other.maxNs_);
+    }
+
+    /// Value at quantile q in [0, 1]: the upper edge of the bucket holding
+    /// the ceil(q * count)-th sample, clamped to the observed min/max
+    uint64_t Quantile(const LatencyLayout& layout, double q) const {
+        if (count_ == 0) return 0;
+        if (q <= 0.0) return minNs_;
+        if (q >= 1.0) return maxNs_;
+
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_))));
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::clamp(layout.Upper(i), minNs_, maxNs_);
+        }
+        return maxNs_;
+    }
+
+    const std::vector<uint32_t>& Counts() const { return counts_; }
+    uint64_t Count() const { return count_; }
+    uint64_t MinNs() const { return count_ ? minNs_ : 0; }
+    uint64_t MaxNs() const { return maxNs_; }
+    double MeanNs() const { return count_ ? sumNs_ / static_cast<double>(count_) : 0.0; }
+
+private:
+    std::vector<uint32_t> counts_;
+    uint64_t count_ = 0;
+    double sumNs_ = 0.0;
+    uint64_t minNs_ = std::numeric_limits<uint64_t>::max();
+    uint64_t maxNs_ = 0;
+};
+
+/// IPv4 5-tuple identifying a flow (addresses in host byte order)
+struct LatencyFlowKey {
+    uint32_t srcAddr;
+    uint32_t dstAddr;
+    uint16_t srcPort;
+    uint16_t dstPort;
+    uint8_t protocol;
+
+    bool operator==(const LatencyFlowKey& o) const {
+        return srcAddr == o.srcAddr && dstAddr == o.dstAddr && srcPort == o.srcPort &&
+               dstPort == o.dstPort && protocol == o.protocol;
+    }
+};
+
+struct LatencyFlowKeyHash {
+    size_t operator()(const LatencyFlowKey& k) const {
+        uint64_t h = (uint64_t{k.srcAddr} << 32) | k.dstAddr;
+        h ^= ((uint64_t{k.srcPort} << 24) | (uint64_t{k.dstPort} << 8) | k.protocol) * 0x9E3779B97F4A7C15ull;
+        return std::hash<uint64_t>()(h);
+    }
+};
+
+/// Histograms for every flow seen, indexed in order of first delivery
+class LatencyMonitor {
+public:
+    explicit LatencyMonitor(uint32_t bits) : layout_(bits) {}
+
+    const LatencyLayout& Layout() const { return layout_; }
+    uint32_t FlowCount() const { return static_cast<uint32_t>(keys_.size()); }
+    const LatencyFlowKey& Key(uint32_t flow) const { return keys_[flow]; }
+    const LatencyHistogram& Histogram(uint32_t flow) const { return histograms_[flow]; }
+
+    void Record(const LatencyFlowKey& key, uint64_t ns) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            it = index_.emplace(key, FlowCount()).first;
+            keys_.push_back(key);
+            histograms_.emplace_back(layout_);
+        }
+        histograms_[it->second].Record(layout_, ns);
+    }
+
+    /// All flows folded into one histogram
+    LatencyHistogram Merged() const {
+        LatencyHistogram merged(layout_);
+        for (const LatencyHistogram& h : histograms_) merged.Merge(h);
+        return merged;
+    }
+
+private:
+    LatencyLayout layout_;
+    std::unordered_map<LatencyFlowKey, uint32_t, LatencyFlowKeyHash> index_;
+    std::vector<LatencyFlowKey> keys_;
+    std::vector<LatencyHistogram> histograms_;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_LATENCY_HISTOGRAM_H
@@ -0,0 +1,84 @@
+// mapped_file.cpp
+// Read-only memory-mapped input file (see mapped_file.h)
+
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3shim {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path, std::string& error) {
+#ifdef _WIN32
+    (void)path;
+    error = "memory-mapped input files require POSIX mmap";
+    return false;
+#else
+    if (data_) {
+        error = "file already open";
+        return false;
+    }
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open '" + path + "': " + std::strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+        error = st.st_size == 0 ? "'" + path + "' is empty" : "cannot stat '" + path + "': " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    void* map = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    const int mapErrno = errno;
+    ::close(fd);  // the mapping keeps the file open
+    if (map == MAP_FAILED) {
+        error = "cannot map '" + path + "': " + std::strerror(mapErrno);
+        return false;
+    }
+    // Read ahead aggressively and drop pages behind the reader
+    ::madvise(map, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+    data_ = static_cast<const uint8_t*>(map);
+    size_ = static_cast<size_t>(st.st_size);
+    discarded_ = 0;
+    return true;
+#endif
+}
+
+void MappedFile::Discard(size_t end) {
+#ifndef _WIN32
+    if (!data_) return;
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    end = std::min(end, size_) / page * page;
+    if (end <= discarded_) return;
+    ::madvise(const_cast<uint8_t*>(data_) + discarded_, end - discarded_, MADV_DONTNEED);
+    discarded_ = end;
+#else
+    (void)end;
+#endif
+}
+
+void MappedFile::Close() {
+#ifndef _WIN32
+    if (!data_) return;
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    discarded_ = 0;
+#endif
+}
+
+} // namespace ns3shim
@@ -0,0 +1,47 @@
+// mapped_file.h
+// Read-only memory-mapped input file (internal to ns3shim)
+//
+// Inputs that are consumed front to back (workload files, replayed
+// captures) are mapped rather than read, so the kernel pages them in on
+// demand and the simulator never holds more of the file than it is working
+// on. Discard() hands pages that have been consumed back to the page cache.
+
+#ifndef NS3SHIM_MAPPED_FILE_H
+#define NS3SHIM_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ns3shim {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Map `path` read-only for sequential access
+    bool Open(const std::string& path, std::string& error);
+
+    /// Release the pages before `end` (rounded down to a page); they are
+    /// re-read from the file if touched again
+    void Discard(size_t end);
+
+    void Close();
+
+    bool IsOpen() const { return data_ != nullptr; }
+    const uint8_t* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t discarded_ = 0;  ///< Pages before this offset were released
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_MAPPED_FILE_H
@@ -11,24 +11,62 @@
 
 #define NS3SHIM_EXPORTS
 #include "ns3shim.h"
+#include "summary_stats.h"
+#include "partition.h"
+#include "journal.h"
+#include "trace_file.h"
+#include "time_bins.h"
+#include "latency_histogram.h"
+#include "fct_tracker.h"
+#include "packet_filter.h"
+#include "queue_monitor.h"
+#include "context_pool.h"
+#include "pcap_writer.h"
+#include "capture_ring.h"
+#include "event_sink.h"
+#include "flow_epochs.h"
+#include "workload_file.h"
+#include "tcp_bulk.h"
+#include "pcap_reader.h"
+#include "tdigest.h"
 
 #include <ns3/core-module.h>
 #include <ns3/network-module.h>
 #include <ns3/internet-module.h>
+#include <ns3/traffic-control-module.h>
 #include <ns3/point-to-point-module.h>
 #include <ns3/csma-module.h>
 #include <ns3/wifi-module.h>
 #include <ns3/mobility-module.h>
 #include <ns3/applications-module.h>
 #include <ns3/flow-monitor-module.h>
+#ifdef NS3SHIM_HAVE_MPI
+#include <ns3/mpi-module.h>
+#endif
 
+#include <algorithm>
 #include <map>
+#include <memory>
 #include <vector>
 #include <string>
 #include <sstream>
 #include <cstring>
 #include <atomic>
 #include <mutex>
+#include <set>
+#include <unordered_map>
+#include <thread>
+#include <functional>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 using namespace ns3;
 
@@ -36,6 +74,678 @@ using namespace ns3;
 // Internal Structures
 // ============================================================================
 
+namespace ns3shim {
+
+// Callback context for packet traces; a subscription sets either the plain
+// or the extended callbacks. Contexts are pooled per simulation.
+struct PacketTraceContext {
+    ns3_pkt_cb onTx;
+    ns3_pkt_cb onRx;
+    void* user;
+    uint64_t deviceId;
+    const DeviceFilter* filter;
+    ns3_pkt_ex_cb onTxEx = nullptr;
+    ns3_pkt_ex_cb onRxEx = nullptr;
+    bool active = true;  ///< Cleared by trace_unsubscribe before the sinks are disconnected
+};
+
+// A packet event subscription: the trace sinks to disconnect and the
+// context to return to the pool
+struct PacketSubscription {
+    Ptr<Object> source;
+    PacketTraceContext* ctx;
+    Callback<void, Ptr<const Packet>> onTx;  ///< Null when not connected
+    Callback<void, Ptr<const Packet>> onRx;
+};
+
+// A capture ring and the ns3_capture_ring_flags its devices are attached with
+struct CaptureRingEntry {
+    std::unique_ptr<CaptureRing> ring;
+    uint32_t flags;
+};
+
+// Periodic snapshots of a flow monitor and the event taking the next one
+struct FlowEpochsEntry {
+    std::unique_ptr<FlowEpochRing> ring;
+    Ptr<FlowMonitor> monitor;
+    double startSec;
+    EventId next;
+    bool writeFailed = false;  ///< The file was closed after a failed write
+};
+
+// First non-loopback IPv4 address of a node (0.0.0.0 if none is assigned)
+Ipv4Address PrimaryIpv4Address(Ptr<Node> node) {
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    if (!ipv4) return Ipv4Address::GetAny();
+    for (uint32_t i = 0; i < ipv4->GetNInterfaces(); ++i) {
+        for (uint32_t a = 0; a < ipv4->GetNAddresses(i); ++a) {
+            const Ipv4Address addr = ipv4->GetAddress(i, a).GetLocal();
+            if (!addr.IsLocalhost()) return addr;
+        }
+    }
+    return Ipv4Address::GetAny();
+}
+
+// Maximum segment lifetime of workload sockets. The sender closes first and
+// waits 2 x MSL in TIME_WAIT holding its socket and ephemeral port; ns-3's
+// default of 120 s would keep every flow of the last 4 minutes alive.
+// Ports are allocated round-robin, so a port comes back long after 2 ms.
+constexpr double WORKLOAD_MSL_SEC = 0.001;
+
+// TCP transfers of a workload file, started as their times come. No
+// Application is created: a running flow owns a sender socket and the
+// receiver socket accepted for it, and its slot is recycled when the
+// receiver has the last byte, so memory follows concurrent flows.
+class WorkloadLauncher {
+public:
+    WorkloadLauncher(std::unique_ptr<WorkloadReader> reader, std::vector<Ptr<Node>> nodes, uint16_t port,
+                     uint32_t sendSize)
+        : reader_(std::move(reader)), nodes_(std::move(nodes)), addrs_(nodes_.size(), Ipv4Address::GetAny()),
+          listeners_(nodes_.size()), port_(port), sendSize_(sendSize), records_(reader_->RecordCount()) {}
+
+    /// Schedule the first record
+    void Start() { ScheduleNext(); }
+
+    void Stats(ns3_workload_stats& out) const {
+        out.records = records_;
+        out.started = started_;
+        out.completed = completed_;
+        out.failed = failed_;
+        out.skipped = skipped_;
+        out.active = static_cast<uint32_t>(flows_.size() - free_.size());
+        out.peakActive = static_cast<uint32_t>(flows_.size());
+        out.bytesDelivered = bytesDelivered_;
+        out.meanFctSec = completed_ ? fctSumNs_ * 1e-9 / static_cast<double>(completed_) : 0.0;
+        out.maxFctSec = fctMaxNs_ * 1e-9;
+    }
+
+private:
+    struct Flow {
+        Ptr<Socket> tx;
+        Ptr<Socket> rx;          ///< Null until the receiver accepts
+        uint64_t bytes = 0;
+        uint64_t sent = 0;       ///< Bytes handed to tx
+        uint64_t received = 0;
+        uint64_t pendingKey = 0; ///< Sender address awaiting accept
+        int64_t startNs = 0;
+        bool txClosed = false;
+    };
+
+    static uint64_t AddressKey(const InetSocketAddress& a) {
+        return (uint64_t{a.GetIpv4().Get()} << 16) | a.GetPort();
+    }
+
+    void ScheduleNext() {
+        if (reader_->Done()) return;
+        const double startNs = reader_->PeekStartSec() * 1e9;
+        const int64_t nowNs = Simulator::Now().GetNanoSeconds();
+        const int64_t delayNs = startNs > static_cast<double>(nowNs) ? std::llround(startNs) - nowNs : 0;
+        Simulator::Schedule(NanoSeconds(delayNs), &WorkloadLauncher::LaunchDue, this);
+    }
+
+    void LaunchDue() {
+        const double nowNs = static_cast<double>(Simulator::Now().GetNanoSeconds());
+        while (!reader_->Done() && !(reader_->PeekStartSec() * 1e9 > nowNs + 0.5)) {
+            Launch(reader_->Next());
+        }
+        ScheduleNext();
+    }
+
+    Ipv4Address AddressOf(uint32_t node) {
+        if (addrs_[node].IsAny()) addrs_[node] = PrimaryIpv4Address(nodes_[node]);
+        return addrs_[node];
+    }
+
+    Ptr<Socket> ListenerOf(uint32_t node) {
+        Ptr<Socket>& listener = listeners_[node];
+        if (!listener) {
+            Ptr<Socket> socket = Socket::CreateSocket(nodes_[node], TcpSocketFactory::GetTypeId());
+            socket->SetAttribute("MaxSegLifetime", DoubleValue(WORKLOAD_MSL_SEC));  // inherited by accepted sockets
+            if (socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), port_)) != 0 || socket->Listen() != 0) {
+                return nullptr;
+            }
+            socket->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                                      MakeCallback(&WorkloadLauncher::OnAccept, this));
+            listener = socket;
+        }
+        return listener;
+    }
+
+    void Launch(const WorkloadRecord& r) {
+        if (r.src >= nodes_.size() || r.dst >= nodes_.size() || r.src == r.dst) {
+            ++skipped_;
+            return;
+        }
+        ++started_;
+        if (r.bytes == 0) {
+            ++completed_;
+            return;
+        }
+        const Ipv4Address src = AddressOf(r.src);
+        const Ipv4Address dst = AddressOf(r.dst);
+        if (src.IsAny() || dst.IsAny() || !ListenerOf(r.dst)) {
+            ++failed_;
+            return;
+        }
+
+        Ptr<Socket> tx = Socket::CreateSocket(nodes_[r.src], TcpSocketFactory::GetTypeId());
+        tx->SetAttribute("MaxSegLifetime", DoubleValue(WORKLOAD_MSL_SEC));
+        Address local;
+        if (tx->Bind(InetSocketAddress(src, 0)) != 0 || tx->GetSockName(local) != 0) {
+            ++failed_;  // ephemeral ports exhausted: ~16k flows running or in TIME_WAIT on this node
+            return;
+        }
+
+        uint32_t slot;
+        if (free_.empty()) {
+            slot = static_cast<uint32_t>(flows_.size());
+            flows_.emplace_back();
+        } else {
+            slot = free_.back();
+            free_.pop_back();
+        }
+        Flow& f = flows_[slot];
+        f.tx = tx;
+        f.bytes = r.bytes;
+        f.startNs = Simulator::Now().GetNanoSeconds();
+        f.pendingKey = AddressKey(InetSocketAddress::ConvertFrom(local));
+        pending_[f.pendingKey] = slot;
+        slotOf_[PeekPointer(tx)] = slot;
+
+        tx->SetConnectCallback(MakeCallback(&WorkloadLauncher::OnConnected, this),
+                               MakeCallback(&WorkloadLauncher::OnConnectFailed, this));
+        tx->SetSendCallback(MakeCallback(&WorkloadLauncher::OnSendSpace, this));
+        tx->Connect(InetSocketAddress(dst, port_));
+    }
+
+    Flow* FlowOf(Ptr<Socket> socket, uint32_t& slot) {
+        auto it = slotOf_.find(PeekPointer(socket));
+        if (it == slotOf_.end()) return nullptr;
+        slot = it->second;
+        return &flows_[slot];
+    }
+
+    void OnConnected(Ptr<Socket> socket) { Fill(socket); }
+
+    void OnSendSpace(Ptr<Socket> socket, uint32_t) { Fill(socket); }
+
+    void Fill(Ptr<Socket> socket) {
+        uint32_t slot;
+        Flow* f = FlowOf(socket, slot);
+        if (!f || f->txClosed) return;
+        while (f->sent < f->bytes) {
+            const uint32_t chunk = static_cast<uint32_t>(
+                std::min<uint64_t>({sendSize_, f->bytes - f->sent, socket->GetTxAvailable()}));
+            if (chunk == 0 || socket->Send(Create<Packet>(chunk)) < 0) return;
+            f->sent += chunk;
+        }
+        // FIN follows the buffered data
+        socket->Close();
+        f->txClosed = true;
+    }
+
+    void OnConnectFailed(Ptr<Socket> socket) {
+        uint32_t slot;
+        if (!FlowOf(socket, slot)) return;
+        ++failed_;
+        Release(slot);
+    }
+
+    void OnAccept(Ptr<Socket> socket, const Address& from) {
+        auto it = pending_.find(AddressKey(InetSocketAddress::ConvertFrom(from)));
+        if (it == pending_.end()) {
+            socket->Close();
+            return;
+        }
+        const uint32_t slot = it->second;
+        pending_.erase(it);
+        flows_[slot].rx = socket;
+        slotOf_[PeekPointer(socket)] = slot;
+        socket->SetRecvCallback(MakeCallback(&WorkloadLauncher::OnRecv, this));
+    }
+
+    void OnRecv(Ptr<Socket> socket) {
+        uint32_t slot;
+        Flow* f = FlowOf(socket, slot);
+        if (!f) return;
+        while (Ptr<Packet> packet = socket->Recv()) {
+            if (packet->GetSize() == 0) break;
+            f->received += packet->GetSize();
+            bytesDelivered_ += packet->GetSize();
+        }
+        if (f->received < f->bytes) return;
+
+        const int64_t fctNs = Simulator::Now().GetNanoSeconds() - f->startNs;
+        ++completed_;
+        fctSumNs_ += static_cast<double>(fctNs);
+        fctMaxNs_ = std::max(fctMaxNs_, fctNs);
+        Release(slot);
+    }
+
+    // Detach a flow's sockets and recycle its slot; TCP keeps the sockets
+    // alive until their connections are closed
+    void Release(uint32_t slot) {
+        Flow& f = flows_[slot];
+        slotOf_.erase(PeekPointer(f.tx));
+        f.tx->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(), MakeNullCallback<void, Ptr<Socket>>());
+        f.tx->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        if (f.rx) {
+            slotOf_.erase(PeekPointer(f.rx));
+            f.rx->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+            f.rx->Close();
+        } else {
+            pending_.erase(f.pendingKey);
+        }
+        f = Flow();
+        free_.push_back(slot);
+    }
+
+    std::unique_ptr<WorkloadReader> reader_;
+    std::vector<Ptr<Node>> nodes_;
+    std::vector<Ipv4Address> addrs_;      ///< Resolved on first use (0.0.0.0 = not yet)
+    std::vector<Ptr<Socket>> listeners_;  ///< Per node, created on first use
+    uint16_t port_;
+    uint32_t sendSize_;
+
+    std::vector<Flow> flows_;             ///< Slots; grows to the peak concurrency
+    std::vector<uint32_t> free_;
+    std::unordered_map<const Socket*, uint32_t> slotOf_;
+    std::unordered_map<uint64_t, uint32_t> pending_;  ///< Sender address -> slot, until accepted
+
+    uint64_t records_;
+    uint64_t started_ = 0;
+    uint64_t completed_ = 0;
+    uint64_t failed_ = 0;
+    uint64_t skipped_ = 0;
+    uint64_t bytesDelivered_ = 0;
+    double fctSumNs_ = 0.0;
+    int64_t fctMaxNs_ = 0;
+};
+
+// Constant-rate or Poisson UDP source for app_traffic_gen. Packets are
+// copy-on-write clones of one template unless unique uids are requested;
+// `batch` packets leave per scheduler event.
+class TrafficGenApp : public Application {
+public:
+    static TypeId GetTypeId() {
+        static TypeId tid = TypeId("ns3shim::TrafficGenApp").SetParent<Application>().SetGroupName("Applications");
+        return tid;
+    }
+
+    void Configure(const Address& peer, uint32_t packetSize, double intervalSec, bool poisson, uint32_t batch,
+                   uint64_t maxPackets, bool uniqueUids) {
+        peer_ = peer;
+        packetSize_ = packetSize;
+        intervalSec_ = intervalSec;
+        batch_ = batch;
+        maxPackets_ = maxPackets;
+        uniqueUids_ = uniqueUids;
+        if (!uniqueUids) template_ = Create<Packet>(packetSize);
+        if (poisson) {
+            gaps_ = CreateObject<ExponentialRandomVariable>();
+            gaps_->SetAttribute("Mean", DoubleValue(intervalSec));
+        }
+    }
+
+protected:
+    void DoDispose() override {
+        socket_ = nullptr;
+        template_ = nullptr;
+        gaps_ = nullptr;
+        Application::DoDispose();
+    }
+
+private:
+    void StartApplication() override {
+        if (!socket_) {
+            socket_ = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+            socket_->Bind();
+            socket_->Connect(peer_);
+        }
+        if (maxPackets_ == 0 || sent_ < maxPackets_) {
+            next_ = Simulator::ScheduleNow(&TrafficGenApp::SendBatch, this);
+        }
+    }
+
+    void StopApplication() override {
+        next_.Cancel();
+        if (socket_) {
+            socket_->Close();
+            socket_ = nullptr;
+        }
+    }
+
+    void SendBatch() {
+        uint64_t count = batch_;
+        if (maxPackets_) count = std::min(count, maxPackets_ - sent_);
+        double gapSec = 0.0;
+        for (uint64_t i = 0; i < count; ++i) {
+            socket_->Send(uniqueUids_ ? Create<Packet>(packetSize_) : template_->Copy());
+            gapSec += gaps_ ? gaps_->GetValue() : intervalSec_;
+        }
+        sent_ += count;
+        if (maxPackets_ && sent_ >= maxPackets_) return;
+        next_ = Simulator::Schedule(Seconds(gapSec), &TrafficGenApp::SendBatch, this);
+    }
+
+    Address peer_;
+    uint32_t packetSize_ = 0;
+    double intervalSec_ = 0.0;
+    uint32_t batch_ = 1;
+    uint64_t maxPackets_ = 0;
+    bool uniqueUids_ = false;
+    uint64_t sent_ = 0;
+    Ptr<Packet> template_;                  ///< Null with unique uids
+    Ptr<RandomVariableStream> gaps_;        ///< Poisson only
+    Ptr<Socket> socket_;
+    EventId next_;
+};
+
+// UDP source for app_pcap_replay: one datagram per captured IP packet, sent
+// at its recorded offset from the start time. The reader decodes ahead on
+// its own thread from StartApplication on; the replay runs once.
+class PcapReplayApp : public Application {
+public:
+    static TypeId GetTypeId() {
+        static TypeId tid = TypeId("ns3shim::PcapReplayApp").SetParent<Application>().SetGroupName("Applications");
+        return tid;
+    }
+
+    void Configure(std::unique_ptr<PcapReader> reader, const Address& peer, double timeScale, uint64_t maxPackets) {
+        reader_ = std::move(reader);
+        peer_ = peer;
+        timeScale_ = timeScale;
+        maxPackets_ = maxPackets;
+    }
+
+    void Stats(ns3_pcap_replay_stats& out) const {
+        out = ns3_pcap_replay_stats{};
+        if (reader_) {
+            out.records = reader_->Records();
+            out.skipped = reader_->Skipped();
+            out.stalls = reader_->Stalls();
+        }
+        out.packetsSent = sent_;
+        out.bytesSent = bytesSent_;
+        out.captureSpanSec = spanNs_ * 1e-9;
+    }
+
+protected:
+    void DoDispose() override {
+        reader_.reset();  // joins the reader thread
+        socket_ = nullptr;
+        Application::DoDispose();
+    }
+
+private:
+    // IP and UDP headers added by the simulated stack
+    static constexpr uint32_t HEADER_BYTES = 28;
+
+    void StartApplication() override {
+        if (!reader_ || !reader_->IsOpen()) return;
+        if (!socket_) {
+            socket_ = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+            socket_->Bind();
+            socket_->Connect(peer_);
+        }
+        start_ = Simulator::Now();
+        reader_->Start();
+        if (reader_->Next(pending_)) {
+            next_ = Simulator::Schedule(DueTime(pending_) - start_, &PcapReplayApp::SendDue, this);
+        } else {
+            reader_->Close();
+        }
+    }
+
+    void StopApplication() override {
+        next_.Cancel();
+        if (reader_) reader_->Close();
+        if (socket_) {
+            socket_->Close();
+            socket_ = nullptr;
+        }
+    }
+
+    Time DueTime(const PcapPacket& packet) const {
+        return start_ + NanoSeconds(static_cast<int64_t>(std::max<int64_t>(packet.timeNs, 0) * timeScale_));
+    }
+
+    // Send every packet due by now, then wait for the next one
+    void SendDue() {
+        const Time now = Simulator::Now();
+        do {
+            const uint32_t payload = std::max(pending_.ipBytes, HEADER_BYTES) - HEADER_BYTES;
+            socket_->Send(Create<Packet>(payload));
+            ++sent_;
+            bytesSent_ += payload + HEADER_BYTES;
+            spanNs_ = std::max(spanNs_, pending_.timeNs);
+            if ((maxPackets_ && sent_ >= maxPackets_) || !reader_->Next(pending_)) {
+                reader_->Close();
+                return;
+            }
+        } while (DueTime(pending_) <= now);
+        next_ = Simulator::Schedule(DueTime(pending_) - now, &PcapReplayApp::SendDue, this);
+    }
+
+    std::unique_ptr<PcapReader> reader_;
+    Address peer_;
+    double timeScale_ = 1.0;
+    uint64_t maxPackets_ = 0;
+    Time start_;
+    PcapPacket pending_{};  ///< Next packet to send
+    uint64_t sent_ = 0;
+    uint64_t bytesSent_ = 0;
+    int64_t spanNs_ = 0;
+    Ptr<Socket> socket_;
+    EventId next_;
+};
+
+// Socket settings shared by both ends of a tcp_bulk_install transfer
+struct TcpSocketConfig {
+    TypeId congestionControl;
+    bool pacing = false;
+    uint32_t segmentSize = 1448;
+    uint32_t sndBufBytes = 0;          ///< 0 = ns-3 default
+    uint32_t rcvBufBytes = 0;          ///< 0 = ns-3 default
+    uint32_t initialCwndSegments = 0;  ///< 0 = ns-3 default
+};
+
+// ns3_tcp_cc of a congestion control object, by its exact type
+inline uint16_t TcpCongestionOf(const Ptr<TcpCongestionOps>& ops) {
+    const TypeId tid = ops->GetInstanceTypeId();
+    if (tid == TcpCubic::GetTypeId()) return NS3_TCP_CUBIC;
+    if (tid == TcpBbr::GetTypeId()) return NS3_TCP_BBR;
+    if (tid == TcpDctcp::GetTypeId()) return NS3_TCP_DCTCP;
+    return NS3_TCP_NEWRENO;
+}
+
+// A TCP socket with its own congestion control; null without a TCP stack.
+// The congestion control object is created here, as TcpL4Protocol would,
+// so outCongestionControl reports the type the socket really runs.
+inline Ptr<Socket> CreateTcpSocket(Ptr<Node> node, const TcpSocketConfig& config,
+                                   uint16_t* outCongestionControl = nullptr) {
+    Ptr<TcpL4Protocol> tcp = node->GetObject<TcpL4Protocol>();
+    if (!tcp) return nullptr;
+    ObjectFactory factory;
+    factory.SetTypeId(config.congestionControl);
+    Ptr<TcpCongestionOps> ops = factory.Create<TcpCongestionOps>();
+    Ptr<Socket> socket = tcp->CreateSocket();
+    DynamicCast<TcpSocketBase>(socket)->SetCongestionControlAlgorithm(ops);
+    if (outCongestionControl) *outCongestionControl = TcpCongestionOf(ops);
+    socket->SetAttribute("SegmentSize", UintegerValue(config.segmentSize));
+    if (config.sndBufBytes) socket->SetAttribute("SndBufSize", UintegerValue(config.sndBufBytes));
+    if (config.rcvBufBytes) socket->SetAttribute("RcvBufSize", UintegerValue(config.rcvBufBytes));
+    if (config.initialCwndSegments) socket->SetAttribute("InitialCwnd", UintegerValue(config.initialCwndSegments));
+    if (config.pacing) DynamicCast<TcpSocketBase>(socket)->SetPacingStatus(true);
+    return socket;
+}
+
+// BulkSendApplication equivalent for tcp_bulk_install: keeps the send
+// buffer full until the transfer is written, then closes. Owning the
+// socket lets it choose the congestion control and connect the cwnd and
+// RTT traces before the connection opens.
+class TcpBulkSendApp : public Application {
+public:
+    static TypeId GetTypeId() {
+        static TypeId tid = TypeId("ns3shim::TcpBulkSendApp").SetParent<Application>().SetGroupName("Applications");
+        return tid;
+    }
+
+    void Configure(const Address& peer, const TcpSocketConfig& config, uint64_t bytes, uint32_t sendSize,
+                   TcpBulkMonitor* monitor, uint32_t row) {
+        peer_ = peer;
+        config_ = config;
+        bytes_ = bytes;
+        sendSize_ = sendSize;
+        monitor_ = monitor;
+        row_ = row;
+    }
+
+protected:
+    void DoDispose() override {
+        socket_ = nullptr;
+        Application::DoDispose();
+    }
+
+private:
+    static double NowSec() { return Simulator::Now().GetSeconds(); }
+
+    void StartApplication() override {
+        if (socket_) return;
+        monitor_->Begin(row_, NowSec());
+        uint16_t congestionControl = NS3_TCP_NEWRENO;
+        socket_ = CreateTcpSocket(GetNode(), config_, &congestionControl);
+        if (!socket_ || socket_->Bind() != 0) {
+            monitor_->End(row_, NowSec(), NS3_TCP_FLOW_FAILED);
+            socket_ = nullptr;
+            return;
+        }
+        monitor_->SetSocket(row_, congestionControl, config_.pacing);
+        socket_->TraceConnectWithoutContext("CongestionWindow", MakeCallback(&TcpBulkSendApp::OnCwnd, this));
+        if (!socket_->TraceConnectWithoutContext("LastRTT", MakeCallback(&TcpBulkSendApp::OnRtt, this))) {
+            socket_->TraceConnectWithoutContext("RTT", MakeCallback(&TcpBulkSendApp::OnRtt, this));
+        }
+        socket_->SetConnectCallback(MakeCallback(&TcpBulkSendApp::OnConnected, this),
+                                    MakeCallback(&TcpBulkSendApp::OnFailed, this));
+        socket_->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                                   MakeCallback(&TcpBulkSendApp::OnFailed, this));
+        socket_->SetSendCallback(MakeCallback(&TcpBulkSendApp::OnSendSpace, this));
+        socket_->Connect(peer_);
+    }
+
+    void StopApplication() override {
+        if (!socket_) return;
+        monitor_->End(row_, NowSec(), NS3_TCP_FLOW_STOPPED);
+        socket_->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        if (!closed_) socket_->Close();
+        closed_ = true;
+    }
+
+    void OnConnected(Ptr<Socket>) { Fill(); }
+
+    void OnSendSpace(Ptr<Socket>, uint32_t) { Fill(); }
+
+    void Fill() {
+        if (closed_) return;
+        while (bytes_ == 0 || sent_ < bytes_) {
+            uint64_t chunk = std::min<uint64_t>(sendSize_, socket_->GetTxAvailable());
+            if (bytes_) chunk = std::min(chunk, bytes_ - sent_);
+            if (chunk == 0 || socket_->Send(Create<Packet>(static_cast<uint32_t>(chunk))) < 0) return;
+            sent_ += chunk;
+            monitor_->AddTx(row_, static_cast<uint32_t>(chunk));
+        }
+        // FIN follows the buffered data
+        socket_->Close();
+        closed_ = true;
+    }
+
+    void OnFailed(Ptr<Socket>) { monitor_->End(row_, NowSec(), NS3_TCP_FLOW_FAILED); }
+
+    void OnCwnd(uint32_t, uint32_t cwnd) { monitor_->SetCwnd(row_, NowSec(), cwnd); }
+
+    void OnRtt(Time, Time rtt) { monitor_->SetRtt(row_, NowSec(), rtt.GetSeconds()); }
+
+    Address peer_;
+    TcpSocketConfig config_;
+    uint64_t bytes_ = 0;  ///< 0 = until stopped
+    uint32_t sendSize_ = 1448;
+    uint64_t sent_ = 0;
+    bool closed_ = false;
+    TcpBulkMonitor* monitor_ = nullptr;
+    uint32_t row_ = 0;
+    Ptr<Socket> socket_;
+};
+
+// PacketSink equivalent for tcp_bulk_install: accepts on its port with the
+// transfer's socket settings and counts every byte read as goodput
+class TcpBulkSinkApp : public Application {
+public:
+    static TypeId GetTypeId() {
+        static TypeId tid = TypeId("ns3shim::TcpBulkSinkApp").SetParent<Application>().SetGroupName("Applications");
+        return tid;
+    }
+
+    void Configure(uint16_t port, const TcpSocketConfig& config, TcpBulkMonitor* monitor, uint32_t row) {
+        port_ = port;
+        config_ = config;
+        monitor_ = monitor;
+        row_ = row;
+    }
+
+protected:
+    void DoDispose() override {
+        listener_ = nullptr;
+        accepted_.clear();
+        Application::DoDispose();
+    }
+
+private:
+    void StartApplication() override {
+        if (listener_) return;
+        // A failed bind leaves the port closed, and the sender fails on the reset
+        listener_ = CreateTcpSocket(GetNode(), config_);
+        if (!listener_ || listener_->Bind(InetSocketAddress(Ipv4Address::GetAny(), port_)) != 0 ||
+            listener_->Listen() != 0) {
+            return;
+        }
+        listener_->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                                     MakeCallback(&TcpBulkSinkApp::OnAccept, this));
+    }
+
+    void StopApplication() override {
+        for (Ptr<Socket>& socket : accepted_) {
+            socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+            socket->Close();
+        }
+        accepted_.clear();
+        if (listener_) {
+            listener_->Close();
+            listener_ = nullptr;
+        }
+    }
+
+    void OnAccept(Ptr<Socket> socket, const Address&) {
+        socket->SetRecvCallback(MakeCallback(&TcpBulkSinkApp::OnRecv, this));
+        accepted_.push_back(socket);
+    }
+
+    void OnRecv(Ptr<Socket> socket) {
+        while (Ptr<Packet> packet = socket->Recv()) {
+            if (packet->GetSize() == 0) break;
+            monitor_->AddRx(row_, Simulator::Now().GetSeconds(), packet->GetSize());
+        }
+    }
+
+    uint16_t port_ = 0;
+    TcpSocketConfig config_;
+    TcpBulkMonitor* monitor_ = nullptr;
+    uint32_t row_ = 0;
+    Ptr<Socket> listener_;
+    std::vector<Ptr<Socket>> accepted_;
+};
+
+} // namespace ns3shim
+
 /// Per-simulation context (must be in global namespace to match header forward declaration)
 struct ns3_sim_t {
     // Handle maps
@@ -43,6 +753,16 @@ struct ns3_sim_t {
     std::map<uint64_t, Ptr<NetDevice>> devices;
     std::map<uint64_t, Ptr<Application>> apps;
     std::map<uint64_t, Ptr<FlowMonitor>> flowMons;
+    std::map<uint64_t, std::unique_ptr<ns3shim::WorkloadLauncher>> workloads;
+    std::map<uint64_t, std::unique_ptr<ns3shim::TraceFileWriter>> traceFiles;  // closed on destruction
+    std::map<uint64_t, std::unique_ptr<ns3shim::TimeBinAccumulator>> throughputs;
+    std::map<uint64_t, std::unique_ptr<ns3shim::LatencyMonitor>> latencies;
+    std::map<uint64_t, std::unique_ptr<ns3shim::FctTracker>> fcts;
+    std::map<uint64_t, std::unique_ptr<ns3shim::QueueMonitor>> queueMonitors;
+    std::map<uint64_t, std::unique_ptr<ns3shim::TcpBulkMonitor>> tcpBulks;
+    std::map<uint64_t, std::unique_ptr<ns3shim::DeviceFilter>> deviceFilters;  // by device id
+    std::map<uint64_t, ns3shim::CaptureRingEntry> captureRings;  // closed on destruction
+    std::map<uint64_t, ns3shim::FlowEpochsEntry> flowEpochs;      // files flushed after every run
 
     // Helpers (stateful objects reused for configuration)
     InternetStackHelper internetStack;
@@ -50,6 +770,12 @@ struct ns3_sim_t {
 
     // State
     std::atomic<bool> isRunning{false};
+    bool hasRun = false;
+
+    // Distributed execution (rank 0 of 1 for sequential simulations)
+    ns3_sim_impl impl = NS3_SIMIMPL_DEFAULT;
+    uint32_t rank = 0;
+    uint32_t rankCount = 1;
     std::string lastError;
     std::mutex errorMutex;
 
@@ -58,11 +784,27 @@ struct ns3_sim_t {
     uint64_t nextDeviceId = 1;
     uint64_t nextAppId = 1;
     uint64_t nextFlowMonId = 1;
+    uint64_t nextWorkloadId = 1;
+    uint64_t nextTraceFileId = 1;
+    uint64_t nextThroughputId = 1;
+    uint64_t nextLatencyId = 1;
+    uint64_t nextFctId = 1;
+    uint64_t nextQueueMonitorId = 1;
+    uint64_t nextTcpBulkId = 1;
+    uint64_t nextTraceSubId = 1;
+    uint64_t nextCaptureRingId = 1;
+    uint64_t nextFlowEpochsId = 1;
 
-    // Trace contexts — tracked for cleanup on sim_destroy (void* to avoid
-    // dependency on PacketTraceContext which is defined in anonymous namespace)
-    std::vector<void*> traceContexts;
+    // Packet event subscriptions; their contexts come from a pool that is
+    // freed wholesale with the simulation
+    std::map<uint64_t, ns3shim::PacketSubscription> traceSubs;
+    ns3shim::ContextPool<ns3shim::PacketTraceContext> traceContextPool;
     std::mutex traceContextMutex;
+    std::vector<std::unique_ptr<ns3shim::TraceFileTap>> traceFileTaps;
+    std::vector<std::unique_ptr<ns3shim::TimeBinTap>> throughputTaps;
+    std::vector<std::unique_ptr<ns3shim::QueueTap>> queueTaps;
+    std::vector<std::unique_ptr<ns3shim::PcapWriter>> pcapWriters;  // flushed after every run
+    ns3shim::EventSink eventSink;  // flushed after every run
     
     // Utility
     void SetError(const std::string& msg) {
@@ -78,23 +820,53 @@ struct ns3_sim_t {
 
 namespace {
 
+using ns3shim::Journal;
+using ns3shim::JournalOp;
+using ns3shim::JournalRecord;
+using ns3shim::JournalScope;
+using ns3shim::PacketTraceContext;
+using ns3shim::PrimaryIpv4Address;
+
 // Opaque handle type definitions
 struct ns3_node_t { uint64_t id; };
 struct ns3_device_t { uint64_t id; };
 struct ns3_app_t { uint64_t id; };
 struct ns3_flowmon_t { uint64_t id; };
+struct ns3_trace_file_t { uint64_t id; };
+struct ns3_throughput_t { uint64_t id; };
+struct ns3_latency_t { uint64_t id; };
 
 // Helper to convert handle to ID
 inline uint64_t HandleToId(ns3_node node) { return reinterpret_cast<uint64_t>(node); }
 inline uint64_t HandleToId(ns3_device dev) { return reinterpret_cast<uint64_t>(dev); }
 inline uint64_t HandleToId(ns3_app app) { return reinterpret_cast<uint64_t>(app); }
 inline uint64_t HandleToId(ns3_flowmon fm) { return reinterpret_cast<uint64_t>(fm); }
+inline uint64_t HandleToId(ns3_workload wl) { return reinterpret_cast<uint64_t>(wl); }
+inline uint64_t HandleToId(ns3_trace_file tf) { return reinterpret_cast<uint64_t>(tf); }
+inline uint64_t HandleToId(ns3_throughput tp) { return reinterpret_cast<uint64_t>(tp); }
+inline uint64_t HandleToId(ns3_latency lat) { return reinterpret_cast<uint64_t>(lat); }
+inline uint64_t HandleToId(ns3_fct fct) { return reinterpret_cast<uint64_t>(fct); }
+inline uint64_t HandleToId(ns3_queue_monitor qm) { return reinterpret_cast<uint64_t>(qm); }
+inline uint64_t HandleToId(ns3_tcp_bulk bulk) { return reinterpret_cast<uint64_t>(bulk); }
+inline uint64_t HandleToId(ns3_trace_sub sub) { return reinterpret_cast<uint64_t>(sub); }
+inline uint64_t HandleToId(ns3_capture_ring ring) { return reinterpret_cast<uint64_t>(ring); }
+inline uint64_t HandleToId(ns3_flow_epochs ep) { return reinterpret_cast<uint64_t>(ep); }
 
 // Helper to convert ID to handle
 inline ns3_node IdToNodeHandle(uint64_t id) { return reinterpret_cast<ns3_node>(id); }
 inline ns3_device IdToDeviceHandle(uint64_t id) { return reinterpret_cast<ns3_device>(id); }
 inline ns3_app IdToAppHandle(uint64_t id) { return reinterpret_cast<ns3_app>(id); }
 inline ns3_flowmon IdToFlowMonHandle(uint64_t id) { return reinterpret_cast<ns3_flowmon>(id); }
+inline ns3_workload IdToWorkloadHandle(uint64_t id) { return reinterpret_cast<ns3_workload>(id); }
+inline ns3_trace_file IdToTraceFileHandle(uint64_t id) { return reinterpret_cast<ns3_trace_file>(id); }
+inline ns3_throughput IdToThroughputHandle(uint64_t id) { return reinterpret_cast<ns3_throughput>(id); }
+inline ns3_latency IdToLatencyHandle(uint64_t id) { return reinterpret_cast<ns3_latency>(id); }
+inline ns3_fct IdToFctHandle(uint64_t id) { return reinterpret_cast<ns3_fct>(id); }
+inline ns3_queue_monitor IdToQueueMonitorHandle(uint64_t id) { return reinterpret_cast<ns3_queue_monitor>(id); }
+inline ns3_tcp_bulk IdToTcpBulkHandle(uint64_t id) { return reinterpret_cast<ns3_tcp_bulk>(id); }
+inline ns3_trace_sub IdToTraceSubHandle(uint64_t id) { return reinterpret_cast<ns3_trace_sub>(id); }
+inline ns3_capture_ring IdToCaptureRingHandle(uint64_t id) { return reinterpret_cast<ns3_capture_ring>(id); }
+inline ns3_flow_epochs IdToFlowEpochsHandle(uint64_t id) { return reinterpret_cast<ns3_flow_epochs>(id); }
 
 // Validate simulation handle
 bool ValidateSim(ns3_sim sim) {
@@ -142,636 +914,3911 @@ Ptr<FlowMonitor> GetFlowMon(ns3_sim sim, ns3_flowmon fm) {
     return it->second;
 }
 
-// Callback context for packet traces
-struct PacketTraceContext {
-    ns3_pkt_cb onTx;
-    ns3_pkt_cb onRx;
-    void* user;
-    uint64_t deviceId;
+ns3shim::WorkloadLauncher* GetWorkload(ns3_sim sim, ns3_workload wl) {
+    if (!sim || !wl) return nullptr;
+    auto it = sim->workloads.find(HandleToId(wl));
+    if (it == sim->workloads.end()) {
+        sim->SetError("Invalid workload handle");
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+ns3shim::TraceFileWriter* GetTraceFile(ns3_sim sim, ns3_trace_file tf) {
+    if (!sim || !tf) return nullptr;
+    auto it = sim->traceFiles.find(HandleToId(tf));
+    if (it == sim->traceFiles.end()) {
+        sim->SetError("Invalid trace file handle");
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+ns3shim::TimeBinAccumulator* GetThroughput(ns3_sim sim, ns3_throughput tp) {
+    if (!sim || !tp) return nullptr;
+    auto it = sim->throughputs.find(HandleToId(tp));
+    if (it == sim->throughputs.end()) {
+        sim->SetError("Invalid throughput handle");
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+ns3shim::LatencyMonitor* GetLatency(ns3_sim sim, ns3_latency lat) {
+    if (!sim || !lat) return nullptr;
+    auto it = sim->latencies.find(HandleToId(lat));
+    if (it == sim->latencies.end()) {
+        sim->SetError("Invalid latency monitor handle");
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+ns3shim::FctTracker* GetFct(ns3_sim sim, ns3_fct fct) {
+    if (!sim || !fct) return nullptr;
+    auto it = sim->fcts.find(HandleToId(fct));
+    if (it == sim->fcts.end()) {
+        sim->SetError("Invalid flow completion time tracker handle");
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+ns3shim::QueueMonitor* GetQueueMonitor(ns3_sim sim, ns3_queue_monitor qm) {
+    if (!sim || !qm) return nullptr;
+    auto it = sim->queueMonitors.find(HandleToId(qm));
+    if (it == sim->queueMonitors.end()) {
+        sim->SetError("Invalid queue monitor handle");
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+ns3shim::TcpBulkMonitor* GetTcpBulk(ns3_sim sim, ns3_tcp_bulk bulk) {
+    if (!sim || !bulk) return nullptr;
+    auto it = sim->tcpBulks.find(HandleToId(bulk));
+    if (it == sim->tcpBulks.end()) {
+        sim->SetError("Invalid TCP bulk transfer handle");
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+ns3shim::CaptureRingEntry* GetCaptureRing(ns3_sim sim, ns3_capture_ring ring) {
+    if (!sim || !ring) return nullptr;
+    auto it = sim->captureRings.find(HandleToId(ring));
+    if (it == sim->captureRings.end()) {
+        sim->SetError("Invalid capture ring handle");
+        return nullptr;
+    }
+    return &it->second;
+}
+
+ns3shim::FlowEpochsEntry* GetFlowEpochs(ns3_sim sim, ns3_flow_epochs ep) {
+    if (!sim || !ep) return nullptr;
+    auto it = sim->flowEpochs.find(HandleToId(ep));
+    if (it == sim->flowEpochs.end()) {
+        sim->SetError("Invalid flow epochs handle");
+        return nullptr;
+    }
+    return &it->second;
+}
+
+// Set in forked sweep workers: managed callbacks must never run in a child
+// of the host process, so trace and scheduled callbacks become no-ops there
+bool g_forkChild = false;
+
+// A packet at a PHY trace sink. Headers are peeked at most once, on first
+// use, and shared by the trace filter and whatever records the packet.
+class PeekedPacket {
+public:
+    PeekedPacket(const ns3shim::DeviceFilter* df, const Ptr<const Packet>& packet)
+        : df_(df), packet_(packet) {}
+
+    const ns3shim::PacketHeaders& Headers() {
+        if (!parsed_) {
+            parsed_ = true;
+            if (df_) {
+                uint8_t bytes[ns3shim::PACKET_PEEK_BYTES];
+                const uint32_t len = packet_->CopyData(bytes, sizeof(bytes));
+                headers_ = ns3shim::ParseHeaders(df_->framing, bytes, len);
+            }
+        }
+        return headers_;
+    }
+
+    // Evaluate the device's trace filter; headers are peeked only when the
+    // filter has IP-level conditions
+    bool Admit() {
+        if (!df_ || !df_->filter) return true;
+        const ns3shim::PacketFilter& filter = *df_->filter;
+        static const ns3shim::PacketHeaders none;
+        return filter.Admit(packet_->GetSize(), packet_->GetUid(), filter.NeedsHeaders() ? Headers() : none);
+    }
+
+private:
+    const ns3shim::DeviceFilter* df_;
+    const Ptr<const Packet>& packet_;
+    ns3shim::PacketHeaders headers_;
+    bool parsed_ = false;
 };
 
 // Helper callback functions for packet tracing
 void PacketTxCallback(PacketTraceContext* ctx, Ptr<const Packet> packet) {
+    if (g_forkChild || !ctx->active) return;
+    if (!PeekedPacket(ctx->filter, packet).Admit()) return;
     double now = Simulator::Now().GetSeconds();
+    JournalScope::CallbackFrame frame(now);
     ctx->onTx(ctx->user, ctx->deviceId, now, packet->GetSize());
 }
 
 void PacketRxCallback(PacketTraceContext* ctx, Ptr<const Packet> packet) {
+    if (g_forkChild || !ctx->active) return;
+    if (!PeekedPacket(ctx->filter, packet).Admit()) return;
     double now = Simulator::Now().GetSeconds();
+    JournalScope::CallbackFrame frame(now);
     ctx->onRx(ctx->user, ctx->deviceId, now, packet->GetSize());
 }
 
-} // anonymous namespace
+// Extended events: the record lives on this stack frame and is passed by
+// pointer, so the host reads the fields in place
+void PacketExCallback(PacketTraceContext* ctx, ns3_pkt_ex_cb cb, uint8_t direction, Ptr<const Packet> packet) {
+    if (g_forkChild || !ctx->active) return;
+    PeekedPacket peeked(ctx->filter, packet);
+    if (!peeked.Admit()) return;
 
-// ============================================================================
-// Error Handling
-// ============================================================================
+    const ns3shim::PacketHeaders& h = peeked.Headers();
+    ns3_pkt_event_ex event{};
+    event.deviceId = ctx->deviceId;
+    event.timeSec = Simulator::Now().GetSeconds();
+    event.uid = packet->GetUid();
+    event.size = packet->GetSize();
+    event.srcAddr = h.srcAddr;
+    event.dstAddr = h.dstAddr;
+    event.srcPort = h.srcPort;
+    event.dstPort = h.dstPort;
+    event.direction = direction;
+    event.flags = static_cast<uint8_t>((h.ipv4 ? NS3_PKT_IPV4 : 0) | (h.ports ? NS3_PKT_PORTS : 0));
+    event.protocol = h.protocol;
+    event.ttl = h.ttl;
 
-NS3SHIM_API ns3_status ns3_last_error(ns3_sim sim, char* buf, size_t len) {
-    if (!buf || len == 0) return NS3_ERR;
-    
-    std::string msg = sim ? sim->GetError() : "No simulation context";
-    size_t copyLen = std::min(msg.size(), len - 1);
-    std::memcpy(buf, msg.c_str(), copyLen);
-    buf[copyLen] = '\0';
-    
-    return NS3_OK;
+    JournalScope::CallbackFrame frame(event.timeSec);
+    cb(ctx->user, &event);
 }
 
-// ============================================================================
-// Simulation Lifecycle
-// ============================================================================
+void PacketTxExCallback(PacketTraceContext* ctx, Ptr<const Packet> packet) {
+    PacketExCallback(ctx, ctx->onTxEx, 0, packet);
+}
 
-NS3SHIM_API ns3_status sim_create(ns3_sim* outSim) {
-    if (!outSim) return NS3_ERR;
-    
-    try {
-        *outSim = new ns3_sim_t();
-        return NS3_OK;
-    } catch (const std::exception& e) {
-        return NS3_ERR;
+void PacketRxExCallback(PacketTraceContext* ctx, Ptr<const Packet> packet) {
+    PacketExCallback(ctx, ctx->onRxEx, 1, packet);
+}
+
+// Connect a pooled context to a device's PHY trace sources and register the
+// subscription; exactly one of the plain/extended sink pairs is used
+ns3_trace_sub ConnectPacketSubscription(ns3_sim sim, const Ptr<Object>& source, PacketTraceContext* ctx,
+                                        void (*txSink)(PacketTraceContext*, Ptr<const Packet>),
+                                        void (*rxSink)(PacketTraceContext*, Ptr<const Packet>)) {
+    ns3shim::PacketSubscription subscription{source, ctx, {}, {}};
+    if (txSink) {
+        subscription.onTx = MakeBoundCallback(txSink, ctx);
+        source->TraceConnectWithoutContext("PhyTxEnd", subscription.onTx);
     }
+    if (rxSink) {
+        subscription.onRx = MakeBoundCallback(rxSink, ctx);
+        source->TraceConnectWithoutContext("PhyRxEnd", subscription.onRx);
+    }
+
+    const uint64_t id = sim->nextTraceSubId++;
+    sim->traceSubs.emplace(id, std::move(subscription));
+    return IdToTraceSubHandle(id);
 }
 
-NS3SHIM_API ns3_status sim_set_seed(ns3_sim sim, uint32_t seed) {
-    if (!ValidateSim(sim)) return NS3_ERR;
-    
-    try {
-        RngSeedManager::SetSeed(seed);
-        return NS3_OK;
-    } catch (const std::exception& e) {
-        sim->SetError(std::string("sim_set_seed failed: ") + e.what());
-        return NS3_ERR;
+void DisconnectPacketSubscription(ns3_sim sim, const ns3shim::PacketSubscription& subscription) {
+    if (!subscription.onTx.IsNull()) {
+        subscription.source->TraceDisconnectWithoutContext("PhyTxEnd", subscription.onTx);
+    }
+    if (!subscription.onRx.IsNull()) {
+        subscription.source->TraceDisconnectWithoutContext("PhyRxEnd", subscription.onRx);
     }
+    std::lock_guard<std::mutex> lock(sim->traceContextMutex);
+    sim->traceContextPool.Release(subscription.ctx);
 }
 
-NS3SHIM_API ns3_status sim_run(ns3_sim sim) {
-    if (!ValidateSim(sim)) return NS3_ERR;
+// Event sink: one store into the shared batch; the host is called only
+// when the batch fills
+void EventSinkAppend(ns3shim::EventSlot* slot, uint8_t type, const Ptr<const Packet>& packet) {
+    if (g_forkChild || !slot->Wants(type)) return;
+    if (!PeekedPacket(slot->filter, packet).Admit()) return;
+    const double now = Simulator::Now().GetSeconds();
+    if (slot->sink->Push(slot->index, type, now, packet->GetUid(), packet->GetSize())) {
+        JournalScope::CallbackFrame frame(now);
+        slot->sink->Flush();
+    }
+}
+
+// Deliver the sink's pending events. Host calls made from the batch
+// callback are journaled as callback calls stamped with the simulation time
+// when they belong to a run, and as top-level calls otherwise.
+void FlushEventSink(ns3_sim sim, bool inRun) {
+    JournalScope::CallbackFrame frame(inRun ? Simulator::Now().GetSeconds() : -1.0);
+    sim->eventSink.Flush();
+}
+
+void EventSinkTxCallback(ns3shim::EventSlot* slot, Ptr<const Packet> packet) {
+    EventSinkAppend(slot, NS3_EVENT_TX, packet);
+}
+
+void EventSinkRxCallback(ns3shim::EventSlot* slot, Ptr<const Packet> packet) {
+    EventSinkAppend(slot, NS3_EVENT_RX, packet);
+}
+
+void EventSinkDropCallback(ns3shim::EventSlot* slot, Ptr<const Packet> packet) {
+    EventSinkAppend(slot, NS3_EVENT_DROP, packet);
+}
+
+void EventSinkWifiDropCallback(ns3shim::EventSlot* slot, Ptr<const Packet> packet, WifiPhyRxfailureReason) {
+    EventSinkAppend(slot, NS3_EVENT_DROP, packet);
+}
+
+// Trace file taps: one store per column, no host involvement
+void TraceFileAppend(ns3shim::TraceFileTap* tap, uint8_t direction, const Ptr<const Packet>& packet) {
+    if (g_forkChild) return;
+    PeekedPacket peeked(tap->filter, packet);
+    if (!peeked.Admit()) return;
+    static const ns3shim::PacketHeaders none;
+    tap->writer->Append(Simulator::Now().GetSeconds(), tap->deviceId, packet->GetSize(), direction,
+                        packet->GetUid(), tap->writer->HasHeaders() ? peeked.Headers() : none);
+}
+
+void TraceFileTxCallback(ns3shim::TraceFileTap* tap, Ptr<const Packet> packet) {
+    TraceFileAppend(tap, 0, packet);
+}
+
+void TraceFileRxCallback(ns3shim::TraceFileTap* tap, Ptr<const Packet> packet) {
+    TraceFileAppend(tap, 1, packet);
+}
+
+// Throughput taps: bin accumulation at the PHY sinks
+void ThroughputTxCallback(ns3shim::TimeBinTap* tap, Ptr<const Packet> packet) {
+    tap->accumulator->Add(tap->row, Simulator::Now().GetSeconds(), packet->GetSize(), false);
+}
+
+void ThroughputRxCallback(ns3shim::TimeBinTap* tap, Ptr<const Packet> packet) {
+    tap->accumulator->Add(tap->row, Simulator::Now().GetSeconds(), packet->GetSize(), true);
+}
+
+// Queue monitor taps: events are always counted; the per-event stream is
+// only built when the monitor has a callback
+void QueueEvent(ns3shim::QueueTap* tap, ns3_queue_event_kind kind, uint32_t size) {
+    ns3shim::QueueMonitor& monitor = *tap->monitor;
+    monitor.Count(tap->row, kind, size);
+    if (!monitor.OnEvent() || g_forkChild) return;
+
+    ns3_queue_event event{};
+    event.deviceId = monitor.DeviceIds()[tap->row];
+    event.timeSec = Simulator::Now().GetSeconds();
+    event.size = size;
+    event.backlog = monitor.Counters(tap->row).backlog;
+    event.kind = static_cast<uint8_t>(kind);
+    JournalScope::CallbackFrame frame(event.timeSec);
+    monitor.OnEvent()(monitor.User(), &event);
+}
+
+void QueueEnqueueCallback(ns3shim::QueueTap* tap, Ptr<const Packet> packet) {
+    QueueEvent(tap, NS3_QUEUE_ENQUEUE, packet->GetSize());
+}
+
+void QueueDequeueCallback(ns3shim::QueueTap* tap, Ptr<const Packet> packet) {
+    QueueEvent(tap, NS3_QUEUE_DEQUEUE, packet->GetSize());
+}
+
+void QueueDropCallback(ns3shim::QueueTap* tap, Ptr<const Packet> packet) {
+    QueueEvent(tap, NS3_QUEUE_DROP, packet->GetSize());
+}
+
+void QdiscEnqueueCallback(ns3shim::QueueTap* tap, Ptr<const QueueDiscItem> item) {
+    QueueEvent(tap, NS3_QDISC_ENQUEUE, item->GetSize());
+}
+
+void QdiscDequeueCallback(ns3shim::QueueTap* tap, Ptr<const QueueDiscItem> item) {
+    QueueEvent(tap, NS3_QDISC_DEQUEUE, item->GetSize());
+}
+
+void QdiscDropCallback(ns3shim::QueueTap* tap, Ptr<const QueueDiscItem> item) {
+    QueueEvent(tap, NS3_QDISC_DROP, item->GetSize());
+}
+
+void PhyRxDropCallback(ns3shim::QueueTap* tap, Ptr<const Packet> packet) {
+    QueueEvent(tap, NS3_PHY_RX_DROP, packet->GetSize());
+}
+
+void WifiPhyRxDropCallback(ns3shim::QueueTap* tap, Ptr<const Packet> packet, WifiPhyRxfailureReason) {
+    QueueEvent(tap, NS3_PHY_RX_DROP, packet->GetSize());
+}
+
+void MacTxDropCallback(ns3shim::QueueTap* tap, Ptr<const Packet> packet) {
+    QueueEvent(tap, NS3_MAC_TX_DROP, packet->GetSize());
+}
+
+void QueueBacklogCallback(ns3shim::QueueTap* tap, uint32_t, uint32_t packets) {
+    tap->monitor->SetBacklog(tap->row, Simulator::Now().GetSeconds(), false, packets);
+}
+
+void QdiscBacklogCallback(ns3shim::QueueTap* tap, uint32_t, uint32_t packets) {
+    tap->monitor->SetBacklog(tap->row, Simulator::Now().GetSeconds(), true, packets);
+}
+
+// Send time carried from the sender's IPv4 layer to the receiver's
+class LatencyStampTag : public Tag {
+public:
+    static TypeId GetTypeId() {
+        static TypeId tid = TypeId("ns3shim::LatencyStampTag")
+            .SetParent<Tag>()
+            .SetGroupName("ns3shim")
+            .AddConstructor<LatencyStampTag>();
+        return tid;
+    }
+    TypeId GetInstanceTypeId() const override { return GetTypeId(); }
+    uint32_t GetSerializedSize() const override { return 8; }
+    void Serialize(TagBuffer buf) const override { buf.WriteU64(static_cast<uint64_t>(sendNs)); }
+    void Deserialize(TagBuffer buf) override { sendNs = static_cast<int64_t>(buf.ReadU64()); }
+    void Print(std::ostream& os) const override { os << "sendNs=" << sendNs; }
+
+    int64_t sendNs = 0;
+};
+
+// Ipv4L3Protocol SendOutgoing: stamp locally originated packets once, so
+// several monitors share one tag
+void LatencyStamp(ns3shim::LatencyMonitor*, const Ipv4Header&, Ptr<const Packet> packet, uint32_t) {
+    LatencyStampTag tag;
+    if (packet->PeekPacketTag(tag)) return;
+    tag.sendNs = Simulator::Now().GetNanoSeconds();
+    packet->AddPacketTag(tag);
+}
+
+// Ipv4L3Protocol LocalDeliver: the packet starts at the L4 header here
+void LatencyDeliver(ns3shim::LatencyMonitor* monitor, const Ipv4Header& header, Ptr<const Packet> packet,
+                    uint32_t) {
+    LatencyStampTag tag;
+    if (!packet->PeekPacketTag(tag)) return;
+
+    ns3shim::LatencyFlowKey key{header.GetSource().Get(), header.GetDestination().Get(), 0, 0,
+                                header.GetProtocol()};
+    uint8_t ports[4];
+    if ((key.protocol == 6 || key.protocol == 17) && packet->CopyData(ports, sizeof(ports)) == sizeof(ports)) {
+        key.srcPort = static_cast<uint16_t>((ports[0] << 8) | ports[1]);
+        key.dstPort = static_cast<uint16_t>((ports[2] << 8) | ports[3]);
+    }
+
+    const int64_t delay = Simulator::Now().GetNanoSeconds() - tag.sendNs;
+    monitor->Record(key, delay > 0 ? static_cast<uint64_t>(delay) : 0);
+}
+
+// Flow key, payload size and TCP sequence/flags of a packet that starts at
+// its L4 header (as in the SendOutgoing and LocalDeliver traces)
+struct FctSegment {
+    ns3shim::LatencyFlowKey key;
+    uint32_t payload = 0;
+    uint32_t seq = 0;
+    uint8_t flags = 0;
+};
+
+bool ParseFctSegment(const Ipv4Header& header, Ptr<const Packet> packet, FctSegment& seg) {
+    seg.key = ns3shim::LatencyFlowKey{header.GetSource().Get(), header.GetDestination().Get(), 0, 0,
+                                      header.GetProtocol()};
+    const uint32_t size = packet->GetSize();
+    uint8_t l4[14];
+    if (seg.key.protocol == 6) {
+        if (packet->CopyData(l4, sizeof(l4)) != sizeof(l4)) return false;
+        const uint32_t headerLen = (l4[12] >> 4) * 4u;
+        if (headerLen < 20 || headerLen > size) return false;
+        seg.seq = (uint32_t{l4[4]} << 24) | (uint32_t{l4[5]} << 16) | (uint32_t{l4[6]} << 8) | l4[7];
+        seg.flags = l4[13];
+        seg.payload = size - headerLen;
+    } else if (seg.key.protocol == 17) {
+        if (packet->CopyData(l4, 8) != 8) return false;
+        seg.payload = size - 8;
+    } else {
+        seg.payload = size;
+        return true;
+    }
+    seg.key.srcPort = static_cast<uint16_t>((l4[0] << 8) | l4[1]);
+    seg.key.dstPort = static_cast<uint16_t>((l4[2] << 8) | l4[3]);
+    return true;
+}
+
+// Ipv4L3Protocol SendOutgoing: locally originated packets only
+void FctSend(ns3shim::FctTracker* tracker, const Ipv4Header& header, Ptr<const Packet> packet, uint32_t) {
+    FctSegment seg;
+    if (ParseFctSegment(header, packet, seg)) {
+        tracker->OnSend(seg.key, seg.payload, Simulator::Now().GetNanoSeconds());
+    }
+}
+
+// Ipv4L3Protocol LocalDeliver
+void FctDeliver(ns3shim::FctTracker* tracker, const Ipv4Header& header, Ptr<const Packet> packet, uint32_t) {
+    FctSegment seg;
+    if (ParseFctSegment(header, packet, seg)) {
+        tracker->OnDeliver(seg.key, seg.payload, seg.seq, seg.flags, Simulator::Now().GetNanoSeconds());
+    }
+}
+
+// Resolve a latency flow selector into a histogram (merged for ALL_FLOWS)
+const ns3shim::LatencyHistogram* SelectLatencyFlow(ns3_sim sim, const ns3shim::LatencyMonitor& monitor,
+                                                   uint32_t flowIndex, ns3shim::LatencyHistogram& merged) {
+    if (flowIndex == NS3_LATENCY_ALL_FLOWS) {
+        merged = monitor.Merged();
+        return &merged;
+    }
+    if (flowIndex >= monitor.FlowCount()) {
+        sim->SetError("Invalid latency flow index " + std::to_string(flowIndex));
+        return nullptr;
+    }
+    return &monitor.Histogram(flowIndex);
+}
+
+// Object owning the PhyTxEnd / PhyRxEnd trace sources of a supported device
+// (null if unsupported). Wi-Fi exposes them on its WifiPhy, not the device.
+Ptr<Object> PhyEndTraceSource(Ptr<NetDevice> device) {
+    if (auto p2pDev = DynamicCast<PointToPointNetDevice>(device)) return p2pDev;
+    if (auto csmaDev = DynamicCast<CsmaNetDevice>(device)) return csmaDev;
+    if (auto wifiDev = DynamicCast<WifiNetDevice>(device)) return wifiDev->GetPhy();
+    return nullptr;
+}
+
+// Transmit queue of a PointToPoint or CSMA device (null for Wi-Fi, whose
+// MAC keeps per-access-category queues)
+Ptr<Queue<Packet>> DeviceTxQueue(Ptr<NetDevice> device) {
+    if (auto p2pDev = DynamicCast<PointToPointNetDevice>(device)) return p2pDev->GetQueue();
+    if (auto csmaDev = DynamicCast<CsmaNetDevice>(device)) return csmaDev->GetQueue();
+    return nullptr;
+}
+
+// Root queue disc installed on a device by the traffic control layer (if any)
+Ptr<QueueDisc> DeviceRootQueueDisc(Ptr<NetDevice> device) {
+    Ptr<Node> node = device->GetNode();
+    Ptr<TrafficControlLayer> tc = node ? node->GetObject<TrafficControlLayer>() : nullptr;
+    return tc ? tc->GetRootQueueDiscOnDevice(device) : nullptr;
+}
+
+// Framing of the frames a supported device's PHY trace sources carry
+ns3shim::LinkFraming FramingOf(Ptr<NetDevice> device) {
+    if (DynamicCast<WifiNetDevice>(device)) return ns3shim::LinkFraming::Wifi;
+    if (DynamicCast<CsmaNetDevice>(device)) return ns3shim::LinkFraming::Ethernet;
+    return ns3shim::LinkFraming::Ppp;
+}
+
+// Filter slot of a device, created (admitting everything) on first use
+ns3shim::DeviceFilter* DeviceFilterFor(ns3_sim sim, uint64_t deviceId, Ptr<NetDevice> device) {
+    std::unique_ptr<ns3shim::DeviceFilter>& slot = sim->deviceFilters[deviceId];
+    if (!slot) slot.reset(new ns3shim::DeviceFilter{FramingOf(device), nullptr});
+    return slot.get();
+}
+
+constexpr const char* UNSUPPORTED_TRACE_DEVICE =
+    "unsupported device type — only PointToPoint, CSMA, and Wi-Fi devices are supported";
+
+// Body of trace_subscribe_packet_events(_handle); exactly one of the plain
+// (onTx/onRx) and extended (onTxEx/onRxEx) callback pairs is used
+ns3_status SubscribePacketEvents(ns3_sim sim, ns3_device dev, const char* fn,
+                                 ns3_pkt_cb onTx, ns3_pkt_cb onRx,
+                                 ns3_pkt_ex_cb onTxEx, ns3_pkt_ex_cb onRxEx,
+                                 void* user, ns3_trace_sub* outSub) {
+    if (!ValidateSim(sim) || !dev) return NS3_ERR;
+
+    try {
+        Ptr<NetDevice> device = GetDevice(sim, dev);
+        if (!device) return NS3_ERR;
+
+        // PointToPoint and CSMA devices carry the PHY trace sources themselves;
+        // WifiNetDevice has none, so Wi-Fi connects to its WifiPhy
+        Ptr<Object> source = PhyEndTraceSource(device);
+        if (!source) {
+            sim->SetError(std::string(fn) + ": " + UNSUPPORTED_TRACE_DEVICE);
+            return NS3_ERR;
+        }
+
+        // Context lives in the sim's pool until trace_unsubscribe or sim_destroy;
+        // the filter slot also carries the framing the header parser needs
+        const uint64_t deviceId = HandleToId(dev);
+        const bool extended = onTxEx || onRxEx;
+        PacketTraceContext* ctx;
+        {
+            std::lock_guard<std::mutex> lock(sim->traceContextMutex);
+            ctx = sim->traceContextPool.Acquire(onTx, onRx, user, deviceId, DeviceFilterFor(sim, deviceId, device),
+                                                onTxEx, onRxEx);
+        }
+
+        ns3_trace_sub sub = extended
+            ? ConnectPacketSubscription(sim, source, ctx, onTxEx ? &PacketTxExCallback : nullptr,
+                                        onRxEx ? &PacketRxExCallback : nullptr)
+            : ConnectPacketSubscription(sim, source, ctx, onTx ? &PacketTxCallback : nullptr,
+                                        onRx ? &PacketRxCallback : nullptr);
+        if (outSub) *outSub = sub;
+        return NS3_OK;
+    } catch (const std::exception& e) {
+        sim->SetError(std::string(fn) + " failed: " + e.what());
+        return NS3_ERR;
+    }
+}
+
+// PCAP sinks: each record is assembled in place in the writer's buffer or
+// the capture ring (Sink is ns3shim::PcapWriter or ns3shim::CaptureRing)
+template <typename Sink>
+void PcapSniff(Sink* sink, Ptr<const Packet> packet) {
+    if (g_forkChild) return;
+    uint32_t capLen = 0;
+    uint8_t* data = sink->Begin(Simulator::Now().GetSeconds(), packet->GetSize(), capLen);
+    if (!data) return;
+    packet->CopyData(data, capLen);
+    sink->Commit();
+}
+
+// Radiotap header for a Wi-Fi frame (little-endian): flags (FCS included),
+// legacy rate, channel and, for received frames, antenna signal and noise
+uint32_t BuildRadiotap(uint8_t* out, uint16_t channelFreqMhz, const WifiTxVector& txVector,
+                       const SignalNoiseDbm* signalNoise) {
+    const uint16_t length = signalNoise ? 16 : 14;
+    uint32_t present = (1u << 1) | (1u << 2) | (1u << 3);
+    if (signalNoise) present |= (1u << 5) | (1u << 6);
+    // The rate field holds 500 kbps units; HT and later rates do not fit
+    const uint64_t rate = txVector.GetMode().GetDataRate(txVector) / 500000;
+    const uint16_t channelFlags = channelFreqMhz < 3000 ? 0x0080 : 0x0100;
+
+    out[0] = 0;
+    out[1] = 0;
+    std::memcpy(out + 2, &length, sizeof(length));
+    std::memcpy(out + 4, &present, sizeof(present));
+    out[8] = 0x10;
+    out[9] = static_cast<uint8_t>(rate <= 0xff ? rate : 0);
+    std::memcpy(out + 10, &channelFreqMhz, sizeof(channelFreqMhz));
+    std::memcpy(out + 12, &channelFlags, sizeof(channelFlags));
+    if (signalNoise) {
+        auto dbm = [](double v) { return static_cast<uint8_t>(static_cast<int8_t>(std::clamp(std::lround(v), -128L, 127L))); };
+        out[14] = dbm(signalNoise->signal);
+        out[15] = dbm(signalNoise->noise);
+    }
+    return length;
+}
+
+template <typename Sink>
+void PcapWifi(Sink* sink, const Ptr<const Packet>& packet, uint16_t channelFreqMhz,
+              const WifiTxVector& txVector, const SignalNoiseDbm* signalNoise) {
+    if (g_forkChild) return;
+    uint8_t radiotap[16];
+    const uint32_t radiotapLen = BuildRadiotap(radiotap, channelFreqMhz, txVector, signalNoise);
+    uint32_t capLen = 0;
+    uint8_t* data = sink->Begin(Simulator::Now().GetSeconds(), radiotapLen + packet->GetSize(), capLen);
+    if (!data) return;
+    const uint32_t head = std::min(capLen, radiotapLen);
+    std::memcpy(data, radiotap, head);
+    if (capLen > head) packet->CopyData(data + head, capLen - head);
+    sink->Commit();
+}
+
+template <typename Sink>
+void PcapWifiTx(Sink* sink, Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                WifiTxVector txVector, MpduInfo, uint16_t) {
+    PcapWifi(sink, packet, channelFreqMhz, txVector, nullptr);
+}
+
+template <typename Sink>
+void PcapWifiRx(Sink* sink, Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                WifiTxVector txVector, MpduInfo, SignalNoiseDbm signalNoise, uint16_t) {
+    PcapWifi(sink, packet, channelFreqMhz, txVector, &signalNoise);
+}
+
+// libpcap link type of a device; false for unsupported devices
+bool PcapLinkType(const Ptr<NetDevice>& device, uint32_t& linkType) {
+    if (DynamicCast<PointToPointNetDevice>(device)) {
+        linkType = ns3shim::PCAP_LINKTYPE_PPP;
+    } else if (DynamicCast<CsmaNetDevice>(device)) {
+        linkType = ns3shim::PCAP_LINKTYPE_ETHERNET;
+    } else if (DynamicCast<WifiNetDevice>(device)) {
+        linkType = ns3shim::PCAP_LINKTYPE_RADIOTAP;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Connect a device's sniffer trace sources to a PCAP sink
+template <typename Sink>
+void ConnectPcapSink(const Ptr<NetDevice>& device, Sink* sink, bool promiscuous) {
+    if (Ptr<WifiNetDevice> wifiDev = DynamicCast<WifiNetDevice>(device)) {
+        Ptr<WifiPhy> phy = wifiDev->GetPhy();
+        phy->TraceConnectWithoutContext("MonitorSnifferTx", MakeBoundCallback(&PcapWifiTx<Sink>, sink));
+        phy->TraceConnectWithoutContext("MonitorSnifferRx", MakeBoundCallback(&PcapWifiRx<Sink>, sink));
+    } else {
+        // The sniffers see frames with their PPP or Ethernet header
+        device->TraceConnectWithoutContext(promiscuous ? "PromiscSniffer" : "Sniffer",
+                                           MakeBoundCallback(&PcapSniff<Sink>, sink));
+    }
+}
+
+// Open a device's PCAP file with the link type of the device and connect
+// its sniffer trace sources
+bool EnablePcapOnDevice(ns3_sim sim, const Ptr<NetDevice>& device, const std::string& filePrefix,
+                        const ns3_pcap_options& options, std::string& error) {
+    uint32_t linkType;
+    if (!PcapLinkType(device, linkType)) {
+        error = UNSUPPORTED_TRACE_DEVICE;
+        return false;
+    }
+
+    // Same file name as ns-3's PcapHelper, plus the codec suffix
+    const auto compression = static_cast<ns3shim::PcapCompression>(options.compression);
+    std::ostringstream path;
+    path << filePrefix << '-' << device->GetNode()->GetId() << '-' << device->GetIfIndex()
+         << ns3shim::PcapFileSuffix(compression);
+    const double flushSec = options.flushIntervalSec == 0.0 ? ns3shim::PCAP_DEFAULT_FLUSH_SEC : options.flushIntervalSec;
+
+    auto writer = std::make_unique<ns3shim::PcapWriter>();
+    if (!writer->Open(path.str(), linkType, options.snaplen, options.bufferBytes, flushSec, compression,
+                      options.compressionLevel, error)) {
+        return false;
+    }
+
+    ConnectPcapSink(device, writer.get(), (options.flags & NS3_PCAP_NO_PROMISC) == 0);
+    sim->pcapWriters.push_back(std::move(writer));
+    return true;
+}
+
+// Apply an ns3_attr through Config::Set; false if the value is malformed
+bool ConfigSetAttr(const std::string& fullPath, const ns3_attr& value) {
+    switch (value.kind) {
+        case NS3_ATTR_BOOL:
+            Config::Set(fullPath, BooleanValue(value.b != 0));
+            return true;
+        case NS3_ATTR_UINT:
+            Config::Set(fullPath, UintegerValue(value.u));
+            return true;
+        case NS3_ATTR_DOUBLE:
+            Config::Set(fullPath, DoubleValue(value.d));
+            return true;
+        case NS3_ATTR_STRING:
+            if (!value.s) return false;
+            Config::Set(fullPath, StringValue(value.s));
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Sum per-flow FlowMonitor counters into the flat ns3_flow_stats view
+void AccumulateFlowStats(Ptr<FlowMonitor> monitor, ns3_flow_stats* outStats) {
+    const FlowMonitor::FlowStatsContainer& stats = monitor->GetFlowStats();
+
+    uint64_t txPackets = 0, rxPackets = 0;
+    uint64_t txBytes = 0, rxBytes = 0;
+    double delaySum = 0.0, jitterSum = 0.0;
+
+    for (auto& flow : stats) {
+        txPackets += flow.second.txPackets;
+        rxPackets += flow.second.rxPackets;
+        txBytes += flow.second.txBytes;
+        rxBytes += flow.second.rxBytes;
+        delaySum += flow.second.delaySum.GetSeconds();
+        jitterSum += flow.second.jitterSum.GetSeconds();
+    }
+
+    outStats->txPackets = txPackets;
+    outStats->rxPackets = rxPackets;
+    outStats->txBytes = txBytes;
+    outStats->rxBytes = rxBytes;
+    outStats->delaySumSec = delaySum;
+    outStats->jitterSumSec = jitterSum;
+    outStats->flowCount = stats.size();
+}
+
+// Copy every flow's counters into the next epoch row, then schedule the
+// following snapshot one period later (Time is integral, so no drift)
+void FlowEpochTick(ns3_sim sim, uint64_t id) {
+    auto it = sim->flowEpochs.find(id);
+    if (it == sim->flowEpochs.end() || g_forkChild) return;
+    ns3shim::FlowEpochsEntry& entry = it->second;
+    ns3shim::FlowEpochRing& ring = *entry.ring;
+
+    ring.Begin(Simulator::Now().GetSeconds());
+    for (const auto& flow : entry.monitor->GetFlowStats()) {
+        const FlowMonitor::FlowStats& f = flow.second;
+        ring.Set(flow.first, ns3shim::FlowEpochSample{f.txPackets, f.rxPackets, f.txBytes, f.rxBytes, f.lostPackets,
+                                                      f.delaySum.GetSeconds(), f.jitterSum.GetSeconds()});
+    }
+    if (!ring.End()) {
+        // Keep the in-memory ring going; sim_run reports the failure
+        ring.CloseFile();
+        entry.writeFailed = true;
+    }
+    entry.next = Simulator::Schedule(Seconds(ring.EpochSec()), &FlowEpochTick, sim, id);
+}
+
+// Histogram of a flow selected by kind (ns-3's Histogram getters are not
+// const, hence the mutable stats)
+Histogram* FlowHistogram(FlowMonitor::FlowStats& stats, ns3_flow_hist_kind kind) {
+    switch (kind) {
+        case NS3_FLOW_HIST_DELAY: return &stats.delayHistogram;
+        case NS3_FLOW_HIST_JITTER: return &stats.jitterHistogram;
+        case NS3_FLOW_HIST_PACKET_SIZE: return &stats.packetSizeHistogram;
+    }
+    return nullptr;
+}
+
+// Per-flow inputs of the ns3_flow_metric values
+struct FlowMetricInput {
+    double txPackets;
+    double rxPackets;
+    double rxBytes;
+    double lostPackets;
+    double delaySumSec;
+    double jitterSumSec;
+    double jitterSamples;  ///< Packets the jitter sum covers
+    double activeSec;      ///< Interval the throughput is measured over
+    double fctSec;         ///< < 0 when not defined
+};
+
+// Value of a metric for one flow; false where the metric is not defined
+bool FlowMetricValue(ns3_flow_metric metric, const FlowMetricInput& f, double& out) {
+    switch (metric) {
+        case NS3_FLOW_METRIC_THROUGHPUT:
+            if (f.rxPackets <= 0 || f.activeSec <= 0) return false;
+            out = f.rxBytes * 8.0 / f.activeSec;
+            return true;
+        case NS3_FLOW_METRIC_FCT:
+            if (f.rxPackets <= 0 || f.fctSec < 0) return false;
+            out = f.fctSec;
+            return true;
+        case NS3_FLOW_METRIC_MEAN_DELAY:
+            if (f.rxPackets <= 0) return false;
+            out = f.delaySumSec / f.rxPackets;
+            return true;
+        case NS3_FLOW_METRIC_MEAN_JITTER:
+            if (f.jitterSamples <= 0) return false;
+            out = f.jitterSumSec / f.jitterSamples;
+            return true;
+        case NS3_FLOW_METRIC_LOSS_RATIO:
+            if (f.txPackets <= 0) return false;
+            out = f.lostPackets / f.txPackets;
+            return true;
+    }
+    return false;
+}
+
+// Check the arguments shared by flowmon_quantiles and flowmon_epochs_quantiles
+bool ValidateFlowQuantileArgs(ns3_sim sim, const char* fn, const ns3_flow_metric* metrics, uint32_t metricCount,
+                              const double* quantiles, uint32_t quantileCount, double compression, bool perEpoch) {
+    if ((metricCount && !metrics) || (quantileCount && !quantiles) || compression < 0.0) {
+        sim->SetError(std::string(fn) + ": invalid arguments");
+        return false;
+    }
+    for (uint32_t m = 0; m < metricCount; ++m) {
+        if (metrics[m] < NS3_FLOW_METRIC_THROUGHPUT || metrics[m] > NS3_FLOW_METRIC_LOSS_RATIO ||
+            (perEpoch && metrics[m] == NS3_FLOW_METRIC_FCT)) {
+            sim->SetError(std::string(fn) + ": unsupported metric " + std::to_string(static_cast<int>(metrics[m])));
+            return false;
+        }
+    }
+    for (uint32_t q = 0; q < quantileCount; ++q) {
+        if (!(quantiles[q] >= 0.0 && quantiles[q] <= 1.0)) {
+            sim->SetError(std::string(fn) + ": quantile out of [0, 1]");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Stream every flow yielded by forEachFlow into one t-digest per metric,
+// then write [metric x quantile] estimates
+template <typename ForEachFlow>
+void SummariseFlowMetrics(const ns3_flow_metric* metrics, uint32_t metricCount, const double* quantiles,
+                          uint32_t quantileCount, double compression, ForEachFlow forEachFlow,
+                          double* outValues, uint64_t* outFlowCounts) {
+    std::vector<ns3shim::TDigest> digests(metricCount, ns3shim::TDigest(compression));
+    forEachFlow([&](const FlowMetricInput& flow) {
+        double value = 0.0;
+        for (uint32_t m = 0; m < metricCount; ++m) {
+            if (FlowMetricValue(metrics[m], flow, value)) digests[m].Add(value);
+        }
+    });
+    for (uint32_t m = 0; m < metricCount; ++m) {
+        for (uint32_t q = 0; q < quantileCount; ++q) {
+            outValues[static_cast<size_t>(m) * quantileCount + q] = digests[m].Quantile(quantiles[q]);
+        }
+        if (outFlowCounts) outFlowCounts[m] = static_cast<uint64_t>(digests[m].Count());
+    }
+}
+
+// Check one app_install_bulk spec and resolve its peer; empty if usable
+std::string CheckAppSpec(const ns3_app_spec& spec, const std::vector<Ptr<Node>>& nodes,
+                         std::vector<Ipv4Address>& addrCache, Ipv4Address& peer) {
+    if (spec.kind > NS3_APP_PACKET_SINK) return "unknown kind " + std::to_string(spec.kind);
+    if (spec.srcNode >= nodes.size()) return "srcNode " + std::to_string(spec.srcNode) + " out of range";
+    if (!(spec.startSec >= 0.0) || (spec.stopSec != 0.0 && !(spec.stopSec > spec.startSec))) {
+        return "stopSec must be 0 or after a non-negative startSec";
+    }
+
+    const bool tcpOnly = spec.kind == NS3_APP_BULK_SEND;
+    const bool udpOnly = spec.kind == NS3_APP_UDP_SERVER || spec.kind == NS3_APP_UDP_CLIENT;
+    if ((spec.protocol != 0 && spec.protocol != 6 && spec.protocol != 17) ||
+        (tcpOnly && spec.protocol == 17) || (udpOnly && spec.protocol == 6)) {
+        return "protocol " + std::to_string(spec.protocol) + " not supported by this kind";
+    }
+    if ((spec.kind == NS3_APP_UDP_CLIENT || spec.kind == NS3_APP_ONOFF) && !(spec.rateBps > 0.0)) {
+        return "rateBps must be positive";
+    }
+    if (spec.kind == NS3_APP_UDP_CLIENT && spec.packetSize != 0 && spec.packetSize < 12) {
+        return "UdpClient packetSize must be at least 12 (sequence/timestamp header)";
+    }
+
+    if (spec.kind == NS3_APP_UDP_SERVER || spec.kind == NS3_APP_PACKET_SINK) return {};
+    if (spec.dstNode == NS3_APP_NO_NODE) {
+        if (spec.dstAddr == 0) return "dstAddr is required when dstNode is NS3_APP_NO_NODE";
+        peer = Ipv4Address(spec.dstAddr);
+        return {};
+    }
+    if (spec.dstNode >= nodes.size()) return "dstNode " + std::to_string(spec.dstNode) + " out of range";
+    Ipv4Address& cached = addrCache[spec.dstNode];
+    if (cached.IsAny()) cached = PrimaryIpv4Address(nodes[spec.dstNode]);
+    if (cached.IsAny()) return "dstNode " + std::to_string(spec.dstNode) + " has no IPv4 address";
+    peer = cached;
+    return {};
+}
+
+// Create the application a checked spec describes (not yet on a node)
+Ptr<Application> CreateSpecApp(const ns3_app_spec& spec, Ipv4Address peer, Ptr<RandomVariableStream> alwaysOn,
+                               Ptr<RandomVariableStream> neverOff) {
+    const uint32_t packetSize = spec.packetSize ? spec.packetSize : 1024;
+    const bool tcp = spec.protocol == 6 || (spec.protocol == 0 &&
+                     (spec.kind == NS3_APP_BULK_SEND || spec.kind == NS3_APP_PACKET_SINK));
+    const TypeIdValue factory(tcp ? TcpSocketFactory::GetTypeId() : UdpSocketFactory::GetTypeId());
+
+    switch (spec.kind) {
+        case NS3_APP_UDP_SERVER: {
+            Ptr<UdpServer> app = CreateObject<UdpServer>();
+            app->SetAttribute("Port", UintegerValue(spec.port));
+            return app;
+        }
+        case NS3_APP_UDP_CLIENT: {
+            const uint64_t packets = (spec.size + packetSize - 1) / packetSize;
+            Ptr<UdpClient> app = CreateObject<UdpClient>();
+            app->SetAttribute("RemoteAddress", AddressValue(peer));
+            app->SetAttribute("RemotePort", UintegerValue(spec.port));
+            app->SetAttribute("PacketSize", UintegerValue(packetSize));
+            app->SetAttribute("Interval", TimeValue(Seconds(packetSize * 8.0 / spec.rateBps)));
+            app->SetAttribute("MaxPackets", UintegerValue(std::min<uint64_t>(packets, UINT32_MAX)));
+            return app;
+        }
+        case NS3_APP_ONOFF: {
+            Ptr<OnOffApplication> app = CreateObject<OnOffApplication>();
+            app->SetAttribute("Protocol", factory);
+            app->SetAttribute("Remote", AddressValue(InetSocketAddress(peer, spec.port)));
+            app->SetAttribute("DataRate", DataRateValue(DataRate(static_cast<uint64_t>(spec.rateBps))));
+            app->SetAttribute("PacketSize", UintegerValue(packetSize));
+            app->SetAttribute("MaxBytes", UintegerValue(spec.size));
+            app->SetAttribute("OnTime", PointerValue(alwaysOn));
+            app->SetAttribute("OffTime", PointerValue(neverOff));
+            return app;
+        }
+        case NS3_APP_BULK_SEND: {
+            Ptr<BulkSendApplication> app = CreateObject<BulkSendApplication>();
+            app->SetAttribute("Protocol", factory);
+            app->SetAttribute("Remote", AddressValue(InetSocketAddress(peer, spec.port)));
+            app->SetAttribute("SendSize", UintegerValue(packetSize));
+            app->SetAttribute("MaxBytes", UintegerValue(spec.size));
+            return app;
+        }
+        default: {
+            Ptr<PacketSink> app = CreateObject<PacketSink>();
+            app->SetAttribute("Protocol", factory);
+            app->SetAttribute("Local", AddressValue(InetSocketAddress(Ipv4Address::GetAny(), spec.port)));
+            return app;
+        }
+    }
+}
+
+// Check one tcp_bulk_install spec and resolve its receiver; empty if usable
+std::string CheckTcpFlowSpec(const ns3_tcp_flow_spec& spec, const std::vector<Ptr<Node>>& nodes,
+                             std::vector<Ipv4Address>& addrCache, std::set<std::pair<uint32_t, uint16_t>>& sinks,
+                             Ipv4Address& peer) {
+    if (spec.congestionControl > NS3_TCP_DCTCP) {
+        return "unknown congestionControl " + std::to_string(spec.congestionControl);
+    }
+    if (spec.srcNode >= nodes.size()) return "srcNode " + std::to_string(spec.srcNode) + " out of range";
+    if (spec.dstNode >= nodes.size()) return "dstNode " + std::to_string(spec.dstNode) + " out of range";
+    if (spec.srcNode == spec.dstNode) return "srcNode and dstNode must differ";
+    if (spec.port == 0) return "port must be non-zero";
+    if (!(spec.startSec >= 0.0) || (spec.stopSec != 0.0 && !(spec.stopSec > spec.startSec))) {
+        return "stopSec must be 0 or after a non-negative startSec";
+    }
+    if (!sinks.insert({spec.dstNode, spec.port}).second) {
+        return "port " + std::to_string(spec.port) + " already used on dstNode " + std::to_string(spec.dstNode);
+    }
+    if (!nodes[spec.srcNode]->GetObject<TcpL4Protocol>() || !nodes[spec.dstNode]->GetObject<TcpL4Protocol>()) {
+        return "srcNode and dstNode need an internet stack";
+    }
+    Ipv4Address& cached = addrCache[spec.dstNode];
+    if (cached.IsAny()) cached = PrimaryIpv4Address(nodes[spec.dstNode]);
+    if (cached.IsAny()) return "dstNode " + std::to_string(spec.dstNode) + " has no IPv4 address";
+    peer = cached;
+    return {};
+}
+
+TypeId TcpCongestionTypeId(uint16_t cc) {
+    switch (cc) {
+        case NS3_TCP_CUBIC: return TcpCubic::GetTypeId();
+        case NS3_TCP_BBR: return TcpBbr::GetTypeId();
+        case NS3_TCP_DCTCP: return TcpDctcp::GetTypeId();
+        default: return TcpNewReno::GetTypeId();
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Forked runs
+// ----------------------------------------------------------------------------
+
+// Result record a worker writes to its pipe; kept under PIPE_BUF so the
+// write is atomic and a worker never blocks on a slow parent
+struct ForkRunResult {
+    int32_t status;
+    double wallTimeSec;
+    ns3_flow_stats stats;
+    char error[256];
+};
+static_assert(sizeof(ForkRunResult) < 4096, "ForkRunResult must fit in PIPE_BUF");
+
+// Re-derive random streams reachable from obj through aggregation and
+// Pointer/ObjectPtrContainer attributes from the current RngSeedManager run.
+// Streams are seeded when constructed, so without this every forked run would
+// replay the base scenario's random sequence regardless of SetRun.
+void ReseedStreams(Ptr<Object> obj, std::set<const Object*>& visited) {
+    if (!obj || !visited.insert(PeekPointer(obj)).second) return;
+
+    if (Ptr<RandomVariableStream> rv = DynamicCast<RandomVariableStream>(obj)) {
+        rv->SetStream(rv->GetStream());
+    }
+
+    Object::AggregateIterator agg = obj->GetAggregateIterator();
+    while (agg.HasNext()) {
+        ReseedStreams(ConstCast<Object>(agg.Next()), visited);
+    }
+
+    TypeId tid = obj->GetInstanceTypeId();
+    while (true) {
+        for (std::size_t i = 0; i < tid.GetAttributeN(); ++i) {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter()) continue;
+
+            std::string valueType = info.checker->GetValueTypeName();
+            if (valueType == "ns3::PointerValue") {
+                PointerValue value;
+                if (info.accessor->Get(PeekPointer(obj), value)) {
+                    ReseedStreams(value.Get<Object>(), visited);
+                }
+            } else if (valueType == "ns3::ObjectPtrContainerValue") {
+                ObjectPtrContainerValue value;
+                if (info.accessor->Get(PeekPointer(obj), value)) {
+                    for (auto it = value.Begin(); it != value.End(); ++it) {
+                        ReseedStreams(it->second, visited);
+                    }
+                }
+            }
+        }
+
+        TypeId parent = tid.GetParent();
+        if (parent == tid) break; // ns3::ObjectBase is its own parent
+        tid = parent;
+    }
+}
+
+void ReseedAllStreams() {
+    std::set<const Object*> visited;
+    for (uint32_t i = 0; i < NodeList::GetNNodes(); ++i) {
+        ReseedStreams(NodeList::GetNode(i), visited);
+    }
+    for (uint32_t i = 0; i < ChannelList::GetNChannels(); ++i) {
+        ReseedStreams(ChannelList::GetChannel(i), visited);
+    }
+}
+
+// Worker body shared by sweeps and fork runs: select the run, let configure()
+// adjust attributes, re-derive random streams, run to completion and collect
+void ExecuteForkedRun(Ptr<FlowMonitor> monitor, uint32_t seed, uint64_t run, double stopTimeSec,
+                      const std::function<void()>& configure, ForkRunResult* result) {
+    auto started = std::chrono::steady_clock::now();
+
+    if (seed != 0) {
+        RngSeedManager::SetSeed(seed);
+    }
+    RngSeedManager::SetRun(run);
+
+    if (configure) configure();
+
+    ReseedAllStreams();
+
+    if (stopTimeSec > 0.0) {
+        Simulator::Stop(Seconds(stopTimeSec));
+    }
+    Simulator::Run();
+
+    if (monitor) {
+        AccumulateFlowStats(monitor, &result->stats);
+    }
+    result->wallTimeSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    result->status = NS3_OK;
+}
+
+// Journal payload for sim_sweep_run (axes inline, then the scalar settings)
+void JournalSweepConfig(JournalRecord& r, const ns3_sweep_config* config, uint32_t capacity) {
+    r.U8(config ? 1 : 0);
+    if (!config) return;
+
+    const uint32_t axisCount = config->axes ? config->axisCount : 0;
+    r.Handle(config->flowMon).U32(axisCount);
+    for (uint32_t a = 0; a < axisCount; ++a) {
+        const ns3_sweep_axis& axis = config->axes[a];
+        const uint32_t valueCount = axis.values ? axis.valueCount : 0;
+        r.Str(axis.path).Str(axis.attrName).U32(valueCount);
+        for (uint32_t v = 0; v < valueCount; ++v) r.Attr(axis.values[v]);
+    }
+    r.U32(config->seed).U64(config->firstRun).U32(config->runCount).U32(config->maxParallel)
+     .F64(config->stopTimeSec).F64(config->confidenceLevel).U32(capacity);
+}
+
+// Fork-based entry points need an unrun, sequential base scenario
+bool CheckForkable(ns3_sim sim, const char* fn) {
+    if (sim->impl != NS3_SIMIMPL_DEFAULT) {
+        sim->SetError(std::string(fn) + ": not supported for distributed simulations");
+        return false;
+    }
+    if (sim->hasRun) {
+        sim->SetError(std::string(fn) + ": base scenario has already been run");
+        return false;
+    }
+    return true;
+}
+
+// Shared-medium channels (CSMA, Wi-Fi) have no remote variant: all attached
+// nodes must be owned by one rank
+bool CheckSingleRank(ns3_sim sim, const NodeContainer& nodes, const char* fn) {
+    for (uint32_t i = 1; i < nodes.GetN(); ++i) {
+        if (nodes.Get(i)->GetSystemId() != nodes.Get(0)->GetSystemId()) {
+            sim->SetError(std::string(fn) + ": nodes on a shared medium must be owned by the same rank");
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifndef _WIN32
+
+// Execute jobCount jobs, each in its own forked copy of this process, with at
+// most maxParallel alive at once. body runs in the child and fills the result;
+// the parent only multiplexes pipes and reaps its own pids (never waitpid(-1),
+// which would steal exit statuses from the host runtime's children).
+bool RunForked(size_t jobCount, uint32_t maxParallel,
+               const std::function<void(size_t, ForkRunResult*)>& body,
+               std::vector<ForkRunResult>& results, std::string& error) {
+    struct Worker {
+        pid_t pid;
+        int fd;
+        size_t job;
+        size_t received;
+        ForkRunResult buffer;
+    };
+
+    results.assign(jobCount, ForkRunResult{});
+    if (maxParallel == 0) {
+        maxParallel = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Buffered stdio would otherwise be flushed once per child
+    std::fflush(nullptr);
+
+    std::vector<Worker> active;
+    size_t nextJob = 0;
+
+    while (nextJob < jobCount || !active.empty()) {
+        while (error.empty() && nextJob < jobCount && active.size() < maxParallel) {
+            int fds[2];
+            if (pipe(fds) != 0) {
+                error = std::string("pipe failed: ") + std::strerror(errno);
+                break;
+            }
+
+            pid_t pid = fork();
+            if (pid < 0) {
+                close(fds[0]);
+                close(fds[1]);
+                error = std::string("fork failed: ") + std::strerror(errno);
+                break;
+            }
+
+            if (pid == 0) {
+                close(fds[0]);
+                g_forkChild = true;
+                ForkRunResult result{};
+                try {
+                    body(nextJob, &result);
+                } catch (const std::exception& e) {
+                    result.status = NS3_ERR;
+                    std::snprintf(result.error, sizeof(result.error), "%s", e.what());
+                } catch (...) {
+                    result.status = NS3_ERR;
+                    std::snprintf(result.error, sizeof(result.error), "unknown exception");
+                }
+                ssize_t written = write(fds[1], &result, sizeof(result));
+                _exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+            }
+
+            close(fds[1]);
+            results[nextJob].status = NS3_ERR;
+            std::snprintf(results[nextJob].error, sizeof(results[nextJob].error), "worker exited without a result");
+            active.push_back(Worker{pid, fds[0], nextJob, 0, ForkRunResult{}});
+            ++nextJob;
+        }
+
+        if (active.empty()) {
+            // Could not start any worker
+            return false;
+        }
+
+        std::vector<pollfd> fds(active.size());
+        for (size_t i = 0; i < active.size(); ++i) {
+            fds[i] = pollfd{active[i].fd, POLLIN, 0};
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            // No revents to act on: polling again would spin, so give up on
+            // the workers still running
+            error = std::string("poll failed: ") + std::strerror(errno);
+            for (Worker& w : active) {
+                kill(w.pid, SIGKILL);
+                close(w.fd);
+                while (waitpid(w.pid, nullptr, 0) < 0 && errno == EINTR) {}
+            }
+            return false;
+        }
+
+        for (size_t i = active.size(); i-- > 0;) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+            Worker& w = active[i];
+            char* dst = reinterpret_cast<char*>(&w.buffer);
+            ssize_t n = read(w.fd, dst + w.received, sizeof(w.buffer) - w.received);
+            if (n > 0) {
+                w.received += static_cast<size_t>(n);
+                if (w.received < sizeof(w.buffer)) continue;
+                results[w.job] = w.buffer;
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            }
+
+            close(w.fd);
+            int wstatus = 0;
+            while (waitpid(w.pid, &wstatus, 0) < 0 && errno == EINTR) {}
+            if (WIFSIGNALED(wstatus) && w.received != sizeof(ForkRunResult)) {
+                std::snprintf(results[w.job].error, sizeof(results[w.job].error),
+                              "worker terminated by signal %d", WTERMSIG(wstatus));
+            }
+            active.erase(active.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+
+    return error.empty();
+}
+
+#endif // _WIN32
+
+} // anonymous namespace
+
+// ============================================================================
+// Error Handling
+// ============================================================================
+
+NS3SHIM_API ns3_status ns3_last_error(ns3_sim sim, char* buf, size_t len) {
+    if (!buf || len == 0) return NS3_ERR;
+    
+    std::string msg = sim ? sim->GetError() : "No simulation context";
+    size_t copyLen = std::min(msg.size(), len - 1);
+    std::memcpy(buf, msg.c_str(), copyLen);
+    buf[copyLen] = '\0';
+    
+    return NS3_OK;
+}
+
+// ============================================================================
+// Simulation Lifecycle
+// ============================================================================
+
+NS3SHIM_API ns3_status sim_create(ns3_sim* outSim) {
+    JournalScope journal(JournalOp::SimCreate, nullptr);
+    if (journal) {
+        journal.OnOk([outSim](JournalRecord& r) {
+            r.U32(Journal::Instance().RegisterSim(*outSim));
+        });
+    }
+
+    if (!outSim) return NS3_ERR;
+    
+    try {
+        *outSim = new ns3_sim_t();
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status sim_create_ex(ns3_sim* outSim, const ns3_sim_options* options) {
+    JournalScope journal(JournalOp::SimCreateEx, nullptr);
+    if (journal) {
+        journal.In().U8(options ? 1 : 0).I32(options ? options->impl : NS3_SIMIMPL_DEFAULT);
+        journal.OnOk([outSim](JournalRecord& r) {
+            r.U32(Journal::Instance().RegisterSim(*outSim));
+        });
+    }
+
+    if (!outSim) return NS3_ERR;
+    *outSim = nullptr;
+    if (!options || options->impl == NS3_SIMIMPL_DEFAULT) return journal.Status(sim_create(outSim));
+
+    if (options->impl != NS3_SIMIMPL_DISTRIBUTED && options->impl != NS3_SIMIMPL_NULL_MESSAGE) {
+        return NS3_ERR;
+    }
+
+#ifdef NS3SHIM_HAVE_MPI
+    try {
+        std::unique_ptr<ns3_sim_t> sim(new ns3_sim_t());
+
+        // The implementation type must be bound before MpiInterface::Enable,
+        // which picks the matching MPI interface from it
+        GlobalValue::Bind("SimulatorImplementationType",
+                          StringValue(options->impl == NS3_SIMIMPL_DISTRIBUTED
+                                          ? "ns3::DistributedSimulatorImpl"
+                                          : "ns3::NullMessageSimulatorImpl"));
+        if (!MpiInterface::IsEnabled()) {
+            int argc = 0;
+            char** argv = nullptr;
+            MpiInterface::Enable(&argc, &argv);
+        }
+
+        sim->impl = options->impl;
+        sim->rank = MpiInterface::GetSystemId();
+        sim->rankCount = MpiInterface::GetSize();
+        *outSim = sim.release();
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        return NS3_ERR;
+    }
+#else
+    // Built without NS3SHIM_ENABLE_MPI
+    return NS3_ERR;
+#endif
+}
+
+NS3SHIM_API ns3_status sim_set_seed(ns3_sim sim, uint32_t seed) {
+    JournalScope journal(JournalOp::SimSetSeed, sim);
+    if (journal) {
+        journal.In().U32(seed);
+    }
+
+    if (!ValidateSim(sim)) return NS3_ERR;
+    
+    try {
+        RngSeedManager::SetSeed(seed);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("sim_set_seed failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status sim_run(ns3_sim sim) {
+    JournalScope journal(JournalOp::SimRun, sim);
+
+    if (!ValidateSim(sim)) return NS3_ERR;
+    
+    try {
+        sim->isRunning = true;
+        sim->hasRun = true;
+        Simulator::Run();
+        sim->isRunning = false;
+
+        // Events of the run reach the host before sim_run returns
+        FlushEventSink(sim, true);
+
+        // PCAP files are complete on disk whenever the host regains control
+        for (const auto& writer : sim->pcapWriters) {
+            if (!writer->Flush()) {
+                sim->SetError("sim_run: pcap write failed for '" + writer->Path() + "'");
+                return NS3_ERR;
+            }
+        }
+        for (auto& [id, entry] : sim->flowEpochs) {
+            if (entry.writeFailed || !entry.ring->FlushFile()) {
+                sim->SetError("sim_run: flow epoch write failed for '" + entry.ring->Path() + "'");
+                return NS3_ERR;
+            }
+        }
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->isRunning = false;
+        sim->SetError(std::string("sim_run failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status sim_stop(ns3_sim sim, double atTimeSec) {
+    JournalScope journal(JournalOp::SimStop, sim);
+    if (journal) {
+        journal.In().F64(atTimeSec);
+    }
+
+    if (!ValidateSim(sim)) return NS3_ERR;
+    
+    try {
+        Simulator::Stop(Seconds(atTimeSec));
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("sim_stop failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status sim_is_running(ns3_sim sim, int* outIsRunning) {
+    if (!ValidateSim(sim) || !outIsRunning) return NS3_ERR;
+    
+    *outIsRunning = sim->isRunning ? 1 : 0;
+    return NS3_OK;
+}
+
+NS3SHIM_API ns3_status sim_now(ns3_sim sim, double* outTimeSec) {
+    if (!ValidateSim(sim) || !outTimeSec) return NS3_ERR;
+    
+    try {
+        *outTimeSec = Simulator::Now().GetSeconds();
+        return NS3_OK;
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("sim_now failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status sim_schedule(ns3_sim sim, double inSeconds, ns3_void_cb cb, void* user) {
+    JournalScope journal(JournalOp::SimSchedule, sim);
+    if (journal) {
+        journal.In().F64(inSeconds);
+    }
+
+    if (!ValidateSim(sim) || !cb) return NS3_ERR;
+    
+    try {
+        Simulator::Schedule(Seconds(inSeconds), [cb, user]() {
+            if (g_forkChild) return;
+            JournalScope::CallbackFrame frame(Simulator::Now().GetSeconds());
+            cb(user);
+        });
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("sim_schedule failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status sim_destroy(ns3_sim sim) {
+    JournalScope journal(JournalOp::SimDestroy, sim);
+
+    if (!sim) return journal.Ok(); // NULL-safe, idempotent
+
+    try {
+        // Clean up ns-3 state (pooled trace contexts are freed with the sim)
+        Simulator::Destroy();
+
+#ifdef NS3SHIM_HAVE_MPI
+        if (sim->impl != NS3_SIMIMPL_DEFAULT) {
+            MpiInterface::Disable();
+            GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+        }
+#endif
+
+        delete sim;
+        return journal.Ok();
+    } catch (...) {
+        // Best effort cleanup
+        delete sim;
+        return NS3_ERR;
+    }
+}
+
+// ============================================================================
+// Nodes & Topology
+// ============================================================================
+
+NS3SHIM_API ns3_status nodes_create(ns3_sim sim, uint32_t count, ns3_node* outArray) {
+    return nodes_create_ex(sim, count, nullptr, outArray);
+}
+
+NS3SHIM_API ns3_status nodes_create_ex(ns3_sim sim, uint32_t count, const uint32_t* systemIds,
+                                       ns3_node* outArray) {
+    JournalScope journal(JournalOp::NodesCreate, sim);
+    if (journal) {
+        journal.In().U32(count).U8(systemIds ? 1 : 0);
+        for (uint32_t i = 0; systemIds && i < count; ++i) journal.In().U32(systemIds[i]);
+        journal.OnOk([outArray, count](JournalRecord& r) {
+            r.Handles(outArray, count);
+        });
+    }
+
+    if (!ValidateSim(sim) || !outArray || count == 0) return NS3_ERR;
+    
+    try {
+        if (systemIds) {
+            for (uint32_t i = 0; i < count; ++i) {
+                if (systemIds[i] >= sim->rankCount) {
+                    sim->SetError("nodes_create_ex: system id " + std::to_string(systemIds[i]) +
+                                  " out of range for " + std::to_string(sim->rankCount) + " rank(s)");
+                    return NS3_ERR;
+                }
+            }
+        }
+
+        NodeContainer nodes;
+        if (systemIds) {
+            for (uint32_t i = 0; i < count; ++i) {
+                nodes.Create(1, systemIds[i]);
+            }
+        } else {
+            nodes.Create(count);
+        }
+        
+        for (uint32_t i = 0; i < count; ++i) {
+            uint64_t id = sim->nextNodeId++;
+            sim->nodes[id] = nodes.Get(i);
+            outArray[i] = IdToNodeHandle(id);
+        }
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("nodes_create failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status node_get_system_id(ns3_sim sim, ns3_node node, uint32_t* outSystemId, int* outIsLocal) {
+    if (!ValidateSim(sim) || !node || !outSystemId) return NS3_ERR;
+
+    Ptr<Node> n = GetNode(sim, node);
+    if (!n) return NS3_ERR;
+
+    *outSystemId = n->GetSystemId();
+    if (outIsLocal) {
+        *outIsLocal = n->GetSystemId() == sim->rank ? 1 : 0;
+    }
+    return NS3_OK;
+}
+
+NS3SHIM_API ns3_status internet_install(ns3_sim sim, const ns3_node* nodes, uint32_t count) {
+    JournalScope journal(JournalOp::InternetInstall, sim);
+    if (journal) {
+        journal.In().Handles(nodes, count);
+    }
+
+    if (!ValidateSim(sim) || !nodes || count == 0) return NS3_ERR;
+    
+    try {
+        NodeContainer nc;
+        for (uint32_t i = 0; i < count; ++i) {
+            Ptr<Node> node = GetNode(sim, nodes[i]);
+            if (!node) return NS3_ERR;
+            nc.Add(node);
+        }
+        
+        sim->internetStack.Install(nc);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("internet_install failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+// ============================================================================
+// Distributed Execution
+// ============================================================================
+
+NS3SHIM_API ns3_status sim_get_rank(ns3_sim sim, uint32_t* outRank, uint32_t* outRankCount) {
+    if (!ValidateSim(sim) || !outRank || !outRankCount) return NS3_ERR;
+
+    *outRank = sim->rank;
+    *outRankCount = sim->rankCount;
+    return NS3_OK;
+}
+
+NS3SHIM_API ns3_status partition_nodes(ns3_sim sim, uint32_t nodeCount,
+                                       const ns3_partition_edge* edges, uint32_t edgeCount,
+                                       uint32_t rankCount, double minLookaheadSec,
+                                       uint32_t* outSystemIds, ns3_partition_stats* outStats) {
+    if (!ValidateSim(sim) || nodeCount == 0 || (edgeCount > 0 && !edges) || rankCount == 0 || !outSystemIds) {
+        return NS3_ERR;
+    }
+
+    try {
+        ns3shim::PartitionResult result = ns3shim::PartitionByLookahead(
+            nodeCount, edges, edgeCount, rankCount, minLookaheadSec, outSystemIds);
+
+        if (outStats) {
+            outStats->lookaheadSec = result.lookaheadSec;
+            outStats->imbalance = result.imbalance;
+            outStats->cutEdges = result.cutEdges;
+        }
+        return NS3_OK;
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("partition_nodes failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+// ============================================================================
+// Network Devices & Links
+// ============================================================================
+
+NS3SHIM_API ns3_status p2p_install(ns3_sim sim, ns3_node a, ns3_node b,
+                                   const char* dataRate, const char* delay, uint32_t mtu,
+                                   ns3_device* outDevA, ns3_device* outDevB) {
+    JournalScope journal(JournalOp::P2PInstall, sim);
+    if (journal) {
+        journal.In().Handle(a).Handle(b).Str(dataRate).Str(delay).U32(mtu);
+        journal.OnOk([outDevA, outDevB](JournalRecord& r) {
+            r.Handle(*outDevA).Handle(*outDevB);
+        });
+    }
+
+    if (!ValidateSim(sim) || !a || !b || !dataRate || !delay || !outDevA || !outDevB) return NS3_ERR;
+    
+    try {
+        Ptr<Node> nodeA = GetNode(sim, a);
+        Ptr<Node> nodeB = GetNode(sim, b);
+        if (!nodeA || !nodeB) return NS3_ERR;
+        
+        PointToPointHelper p2p;
+        p2p.SetDeviceAttribute("DataRate", StringValue(dataRate));
+        p2p.SetChannelAttribute("Delay", StringValue(delay));
+        p2p.SetDeviceAttribute("Mtu", UintegerValue(mtu));
+        
+        NodeContainer nc(nodeA, nodeB);
+        NetDeviceContainer devices = p2p.Install(nc);
+        
+        uint64_t idA = sim->nextDeviceId++;
+        uint64_t idB = sim->nextDeviceId++;
+        
+        sim->devices[idA] = devices.Get(0);
+        sim->devices[idB] = devices.Get(1);
+        
+        *outDevA = IdToDeviceHandle(idA);
+        *outDevB = IdToDeviceHandle(idB);
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("p2p_install failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status csma_install(ns3_sim sim, const ns3_node* nodes, uint32_t count,
+                                    const char* dataRate, const char* delay,
+                                    ns3_device* outDevices) {
+    JournalScope journal(JournalOp::CsmaInstall, sim);
+    if (journal) {
+        journal.In().Handles(nodes, count).Str(dataRate).Str(delay);
+        journal.OnOk([outDevices, count](JournalRecord& r) {
+            r.Handles(outDevices, count);
+        });
+    }
+
+    if (!ValidateSim(sim) || !nodes || count == 0 || !dataRate || !delay || !outDevices) return NS3_ERR;
+    
+    try {
+        NodeContainer nc;
+        for (uint32_t i = 0; i < count; ++i) {
+            Ptr<Node> node = GetNode(sim, nodes[i]);
+            if (!node) return NS3_ERR;
+            nc.Add(node);
+        }
+
+        if (!CheckSingleRank(sim, nc, "csma_install")) return NS3_ERR;
+        
+        CsmaHelper csma;
+        csma.SetChannelAttribute("DataRate", StringValue(dataRate));
+        csma.SetChannelAttribute("Delay", StringValue(delay));
+        
+        NetDeviceContainer devices = csma.Install(nc);
+        
+        for (uint32_t i = 0; i < count; ++i) {
+            uint64_t id = sim->nextDeviceId++;
+            sim->devices[id] = devices.Get(i);
+            outDevices[i] = IdToDeviceHandle(id);
+        }
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("csma_install failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status wifi_install_sta_ap(ns3_sim sim, const ns3_node* stas, uint32_t staCount, ns3_node ap,
+                                           int phyStandard, const char* dataRate, int channelNumber,
+                                           ns3_device* outStaDevices, ns3_device* outApDevice) {
+    JournalScope journal(JournalOp::WifiInstallStaAp, sim);
+    if (journal) {
+        journal.In().Handles(stas, staCount).Handle(ap).I32(phyStandard).Str(dataRate).I32(channelNumber);
+        journal.OnOk([outStaDevices, staCount, outApDevice](JournalRecord& r) {
+            r.Handles(outStaDevices, staCount).Handle(*outApDevice);
+        });
+    }
+
+    if (!ValidateSim(sim) || !stas || staCount == 0 || !ap || !dataRate || !outStaDevices || !outApDevice) return NS3_ERR;
+    
+    try {
+        NodeContainer staNodes;
+        for (uint32_t i = 0; i < staCount; ++i) {
+            Ptr<Node> node = GetNode(sim, stas[i]);
+            if (!node) return NS3_ERR;
+            staNodes.Add(node);
+        }
+        
+        Ptr<Node> apNode = GetNode(sim, ap);
+        if (!apNode) return NS3_ERR;
+
+        NodeContainer allNodes(staNodes);
+        allNodes.Add(apNode);
+        if (!CheckSingleRank(sim, allNodes, "wifi_install_sta_ap")) return NS3_ERR;
+        
+        // Create Wi-Fi channel
+        YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+        YansWifiPhyHelper phy;
+        phy.SetChannel(channel.Create());
+        
+        // Wi-Fi helper
+        WifiHelper wifi;
+        WifiMacHelper mac;
+        
+        // Set standard
+        switch (phyStandard) {
+            case 0: wifi.SetStandard(WIFI_STANDARD_80211a); break;
+            case 1: wifi.SetStandard(WIFI_STANDARD_80211b); break;
+            case 2: wifi.SetStandard(WIFI_STANDARD_80211g); break;
+            case 3: wifi.SetStandard(WIFI_STANDARD_80211n); break;
+            case 4: wifi.SetStandard(WIFI_STANDARD_80211n); break;
+            case 5: wifi.SetStandard(WIFI_STANDARD_80211ac); break;
+            default: wifi.SetStandard(WIFI_STANDARD_80211n); break;
+        }
+        
+        wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                     "DataMode", StringValue(dataRate),
+                                     "ControlMode", StringValue(dataRate));
+        
+        // Configure SSID
+        Ssid ssid = Ssid("ns3-wifi");
+        
+        // Install STA devices
+        mac.SetType("ns3::StaWifiMac",
+                   "Ssid", SsidValue(ssid),
+                   "ActiveProbing", BooleanValue(false));
+        NetDeviceContainer staDevices = wifi.Install(phy, mac, staNodes);
+        
+        // Install AP device
+        mac.SetType("ns3::ApWifiMac",
+                   "Ssid", SsidValue(ssid));
+        NetDeviceContainer apDevices = wifi.Install(phy, mac, apNode);
+        
+        // Store devices
+        for (uint32_t i = 0; i < staCount; ++i) {
+            uint64_t id = sim->nextDeviceId++;
+            sim->devices[id] = staDevices.Get(i);
+            outStaDevices[i] = IdToDeviceHandle(id);
+        }
+        
+        uint64_t apId = sim->nextDeviceId++;
+        sim->devices[apId] = apDevices.Get(0);
+        *outApDevice = IdToDeviceHandle(apId);
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("wifi_install_sta_ap failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+// ============================================================================
+// Mobility
+// ============================================================================
+
+NS3SHIM_API ns3_status mobility_set_constant_position(ns3_sim sim, ns3_node node, double x, double y, double z) {
+    JournalScope journal(JournalOp::MobilitySetConstantPosition, sim);
+    if (journal) {
+        journal.In().Handle(node).F64(x).F64(y).F64(z);
+    }
+
+    if (!ValidateSim(sim) || !node) return NS3_ERR;
+    
+    try {
+        Ptr<Node> n = GetNode(sim, node);
+        if (!n) return NS3_ERR;
+        
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(n);
+        
+        Ptr<MobilityModel> mobModel = n->GetObject<MobilityModel>();
+        if (mobModel) {
+            mobModel->SetPosition(Vector(x, y, z));
+        }
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("mobility_set_constant_position failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+// ============================================================================
+// IP Addressing & Routing
+// ============================================================================
+
+NS3SHIM_API ns3_status ipv4_assign(ns3_sim sim, const ns3_device* devices, uint32_t count,
+                                   const char* networkBase, const char* mask) {
+    JournalScope journal(JournalOp::Ipv4Assign, sim);
+    if (journal) {
+        journal.In().Handles(devices, count).Str(networkBase).Str(mask);
+    }
+
+    if (!ValidateSim(sim) || !devices || count == 0 || !networkBase || !mask) return NS3_ERR;
+    
+    try {
+        NetDeviceContainer devContainer;
+        for (uint32_t i = 0; i < count; ++i) {
+            Ptr<NetDevice> dev = GetDevice(sim, devices[i]);
+            if (!dev) return NS3_ERR;
+            devContainer.Add(dev);
+        }
+        
+        sim->ipv4Helper.SetBase(networkBase, mask);
+        sim->ipv4Helper.Assign(devContainer);
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("ipv4_assign failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status ipv4_populate_routing_tables(ns3_sim sim) {
+    JournalScope journal(JournalOp::Ipv4PopulateRoutingTables, sim);
+
+    if (!ValidateSim(sim)) return NS3_ERR;
+    
+    try {
+        Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("ipv4_populate_routing_tables failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+// ============================================================================
+// Applications
+// ============================================================================
+
+NS3SHIM_API ns3_status app_udpecho_server(ns3_sim sim, ns3_node node, uint16_t port, ns3_app* outApp) {
+    JournalScope journal(JournalOp::AppUdpEchoServer, sim);
+    if (journal) {
+        journal.In().Handle(node).U32(port);
+        journal.OnOk([outApp](JournalRecord& r) {
+            r.Handle(*outApp);
+        });
+    }
+
+    if (!ValidateSim(sim) || !node || !outApp) return NS3_ERR;
+    
+    try {
+        Ptr<Node> n = GetNode(sim, node);
+        if (!n) return NS3_ERR;
+        
+        UdpEchoServerHelper server(port);
+        ApplicationContainer apps = server.Install(n);
+        
+        uint64_t id = sim->nextAppId++;
+        sim->apps[id] = apps.Get(0);
+        *outApp = IdToAppHandle(id);
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("app_udpecho_server failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status app_udpecho_client(ns3_sim sim, ns3_node node, const char* dstIp, uint16_t port,
+                                          uint32_t packetSize, double intervalSec, uint32_t maxPackets, ns3_app* outApp) {
+    JournalScope journal(JournalOp::AppUdpEchoClient, sim);
+    if (journal) {
+        journal.In().Handle(node).Str(dstIp).U32(port).U32(packetSize).F64(intervalSec).U32(maxPackets);
+        journal.OnOk([outApp](JournalRecord& r) {
+            r.Handle(*outApp);
+        });
+    }
+
+    if (!ValidateSim(sim) || !node || !dstIp || !outApp) return NS3_ERR;
+    
+    try {
+        Ptr<Node> n = GetNode(sim, node);
+        if (!n) return NS3_ERR;
+        
+        UdpEchoClientHelper client(Ipv4Address(dstIp), port);
+        client.SetAttribute("MaxPackets", UintegerValue(maxPackets));
+        client.SetAttribute("Interval", TimeValue(Seconds(intervalSec)));
+        client.SetAttribute("PacketSize", UintegerValue(packetSize));
+        
+        ApplicationContainer apps = client.Install(n);
+        
+        uint64_t id = sim->nextAppId++;
+        sim->apps[id] = apps.Get(0);
+        *outApp = IdToAppHandle(id);
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("app_udpecho_client failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status app_traffic_gen(ns3_sim sim, ns3_node node, const char* dstIp, uint16_t port,
+                                       const ns3_traffic_gen_options* options, ns3_app* outApp) {
+    JournalScope journal(JournalOp::AppTrafficGen, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Handle(node).Str(dstIp).U16(port).U8(options ? 1 : 0);
+        if (options) {
+            in.U32(options->packetSize).U32(options->pattern).F64(options->intervalSec).U32(options->batch)
+              .U32(options->flags).U64(options->maxPackets);
+        }
+        journal.OnOk([outApp](JournalRecord& r) {
+            r.Handle(*outApp);
+        });
+    }
+
+    if (!ValidateSim(sim) || !node || !dstIp || !options || !outApp) return NS3_ERR;
+    if (options->pattern > NS3_TRAFFIC_POISSON) {
+        sim->SetError("app_traffic_gen: unknown pattern " + std::to_string(options->pattern));
+        return NS3_ERR;
+    }
+    if (!(options->intervalSec > 0.0)) {
+        sim->SetError("app_traffic_gen: intervalSec must be positive");
+        return NS3_ERR;
+    }
+
+    try {
+        Ptr<Node> n = GetNode(sim, node);
+        if (!n) return NS3_ERR;
+
+        Ptr<ns3shim::TrafficGenApp> app = CreateObject<ns3shim::TrafficGenApp>();
+        app->Configure(InetSocketAddress(Ipv4Address(dstIp), port), options->packetSize ? options->packetSize : 1024,
+                       options->intervalSec, options->pattern == NS3_TRAFFIC_POISSON,
+                       options->batch ? options->batch : 1, options->maxPackets,
+                       (options->flags & NS3_TRAFFIC_GEN_UNIQUE_UIDS) != 0);
+        n->AddApplication(app);
+
+        uint64_t id = sim->nextAppId++;
+        sim->apps[id] = app;
+        *outApp = IdToAppHandle(id);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("app_traffic_gen failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status app_pcap_replay(ns3_sim sim, ns3_node node, const char* path, const char* dstIp,
+                                       uint16_t port, const ns3_pcap_replay_options* options, ns3_app* outApp) {
+    JournalScope journal(JournalOp::AppPcapReplay, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Handle(node).Str(path).Str(dstIp).U16(port).U8(options ? 1 : 0);
+        if (options) in.F64(options->timeScale).U64(options->maxPackets);
+        journal.OnOk([outApp](JournalRecord& r) {
+            r.Handle(*outApp);
+        });
+    }
+
+    if (!ValidateSim(sim) || !node || !path || !dstIp || !outApp) return NS3_ERR;
+    const double timeScale = options && options->timeScale != 0.0 ? options->timeScale : 1.0;
+    if (!(timeScale > 0.0)) {
+        sim->SetError("app_pcap_replay: timeScale must be positive");
+        return NS3_ERR;
+    }
+
+    try {
+        Ptr<Node> n = GetNode(sim, node);
+        if (!n) return NS3_ERR;
+
+        auto reader = std::make_unique<ns3shim::PcapReader>();
+        std::string error;
+        if (!reader->Open(path, error)) {
+            sim->SetError("app_pcap_replay: " + error);
+            return NS3_ERR;
+        }
+
+        Ptr<ns3shim::PcapReplayApp> app = CreateObject<ns3shim::PcapReplayApp>();
+        app->Configure(std::move(reader), InetSocketAddress(Ipv4Address(dstIp), port), timeScale,
+                       options ? options->maxPackets : 0);
+        n->AddApplication(app);
+
+        uint64_t id = sim->nextAppId++;
+        sim->apps[id] = app;
+        *outApp = IdToAppHandle(id);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("app_pcap_replay failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status app_pcap_replay_stats(ns3_sim sim, ns3_app app, ns3_pcap_replay_stats* outStats) {
+    if (!ValidateSim(sim) || !app || !outStats) return NS3_ERR;
+
+    Ptr<ns3shim::PcapReplayApp> replay = DynamicCast<ns3shim::PcapReplayApp>(GetApp(sim, app));
+    if (!replay) {
+        sim->SetError("app_pcap_replay_stats: not a PCAP replay application");
+        return NS3_ERR;
+    }
+    replay->Stats(*outStats);
+    return NS3_OK;
+}
+
+NS3SHIM_API ns3_status app_install_bulk(ns3_sim sim, const ns3_node* nodes, uint32_t nodeCount,
+                                        const ns3_app_spec* specs, uint32_t count, ns3_app* outApps) {
+    JournalScope journal(JournalOp::AppInstallBulk, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Handles(nodes, nodeCount).U32(specs ? count : 0);
+        for (uint32_t i = 0; specs && i < count; ++i) {
+            const ns3_app_spec& spec = specs[i];
+            in.U32(spec.kind).U32(spec.srcNode).U32(spec.dstNode).U32(spec.dstAddr).U16(spec.port)
+              .U16(spec.protocol).U32(spec.packetSize).F64(spec.rateBps).U64(spec.size).F64(spec.startSec)
+              .F64(spec.stopSec);
+        }
+        journal.OnOk([outApps, count](JournalRecord& r) {
+            r.Handles(outApps, count);
+        });
+    }
+
+    if (!ValidateSim(sim) || (count > 0 && (!nodes || !specs || !outApps))) return NS3_ERR;
+
+    try {
+        std::vector<Ptr<Node>> nodePtrs(nodeCount);
+        for (uint32_t i = 0; i < nodeCount; ++i) {
+            nodePtrs[i] = GetNode(sim, nodes[i]);
+            if (!nodePtrs[i]) return NS3_ERR;
+        }
+
+        // Check everything first so a bad spec leaves nothing half-installed
+        std::vector<Ipv4Address> addrCache(nodeCount, Ipv4Address::GetAny());
+        std::vector<Ipv4Address> peers(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const std::string error = CheckAppSpec(specs[i], nodePtrs, addrCache, peers[i]);
+            if (!error.empty()) {
+                sim->SetError("app_install_bulk: spec " + std::to_string(i) + ": " + error);
+                return NS3_ERR;
+            }
+        }
+
+        Ptr<ConstantRandomVariable> alwaysOn = CreateObject<ConstantRandomVariable>();
+        alwaysOn->SetAttribute("Constant", DoubleValue(1e9));
+        Ptr<ConstantRandomVariable> neverOff = CreateObject<ConstantRandomVariable>();
+        neverOff->SetAttribute("Constant", DoubleValue(0.0));
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const ns3_app_spec& spec = specs[i];
+            Ptr<Application> app = CreateSpecApp(spec, peers[i], alwaysOn, neverOff);
+            nodePtrs[spec.srcNode]->AddApplication(app);
+            app->SetStartTime(Seconds(spec.startSec));
+            if (spec.stopSec > 0.0) app->SetStopTime(Seconds(spec.stopSec));
+
+            // Ids only grow, so every insertion lands at the end of the map
+            const uint64_t id = sim->nextAppId++;
+            sim->apps.emplace_hint(sim->apps.end(), id, app);
+            outApps[i] = IdToAppHandle(id);
+        }
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("app_install_bulk failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status app_start(ns3_sim sim, ns3_app app, double atTimeSec) {
+    JournalScope journal(JournalOp::AppStart, sim);
+    if (journal) {
+        journal.In().Handle(app).F64(atTimeSec);
+    }
+
+    if (!ValidateSim(sim) || !app) return NS3_ERR;
+    
+    try {
+        Ptr<Application> a = GetApp(sim, app);
+        if (!a) return NS3_ERR;
+        
+        a->SetStartTime(Seconds(atTimeSec));
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("app_start failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status app_stop(ns3_sim sim, ns3_app app, double atTimeSec) {
+    JournalScope journal(JournalOp::AppStop, sim);
+    if (journal) {
+        journal.In().Handle(app).F64(atTimeSec);
+    }
+
+    if (!ValidateSim(sim) || !app) return NS3_ERR;
+    
+    try {
+        Ptr<Application> a = GetApp(sim, app);
+        if (!a) return NS3_ERR;
+        
+        a->SetStopTime(Seconds(atTimeSec));
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("app_stop failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status workload_open(ns3_sim sim, const char* path, const ns3_node* nodes, uint32_t nodeCount,
+                                     const ns3_workload_options* options, ns3_workload* outWorkload) {
+    JournalScope journal(JournalOp::WorkloadOpen, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Str(path).Handles(nodes, nodeCount).U8(options ? 1 : 0);
+        if (options) in.U16(options->port).U32(options->sendSize);
+        journal.OnOk([outWorkload](JournalRecord& r) {
+            r.Handle(*outWorkload);
+        });
+    }
+
+    if (!ValidateSim(sim) || !path || !outWorkload) return NS3_ERR;
+    if (nodeCount > 0 && !nodes) return NS3_ERR;
+
+    try {
+        std::vector<Ptr<Node>> resolved(nodeCount);
+        for (uint32_t i = 0; i < nodeCount; ++i) {
+            resolved[i] = GetNode(sim, nodes[i]);
+            if (!resolved[i]) return NS3_ERR;
+        }
+
+        auto reader = std::make_unique<ns3shim::WorkloadReader>();
+        std::string error;
+        if (!reader->Open(path, error)) {
+            sim->SetError("workload_open: " + error);
+            return NS3_ERR;
+        }
+
+        const uint16_t port = options && options->port ? options->port : 9000;
+        const uint32_t sendSize = options && options->sendSize ? options->sendSize : 1448;
+        auto launcher = std::make_unique<ns3shim::WorkloadLauncher>(std::move(reader), std::move(resolved), port,
+                                                                    sendSize);
+        launcher->Start();
+
+        uint64_t id = sim->nextWorkloadId++;
+        sim->workloads[id] = std::move(launcher);
+        *outWorkload = IdToWorkloadHandle(id);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("workload_open failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status workload_stats(ns3_sim sim, ns3_workload workload, ns3_workload_stats* outStats) {
+    if (!ValidateSim(sim) || !workload || !outStats) return NS3_ERR;
+
+    ns3shim::WorkloadLauncher* launcher = GetWorkload(sim, workload);
+    if (!launcher) return NS3_ERR;
+    launcher->Stats(*outStats);
+    return NS3_OK;
+}
+
+// ============================================================================
+// Tracing & Statistics
+// ============================================================================
+
+NS3SHIM_API ns3_status trace_subscribe_packet_events(ns3_sim sim, ns3_device dev,
+                                                      ns3_pkt_cb onTx, ns3_pkt_cb onRx, void* user) {
+    JournalScope journal(JournalOp::TraceSubscribePacketEvents, sim);
+    if (journal) {
+        journal.In().Handle(dev).U8(onTx ? 1 : 0).U8(onRx ? 1 : 0);
+    }
+
+    if (SubscribePacketEvents(sim, dev, "trace_subscribe_packet_events", onTx, onRx, nullptr, nullptr, user,
+                              nullptr) != NS3_OK) {
+        return NS3_ERR;
+    }
+    return journal.Ok();
+}
+
+NS3SHIM_API ns3_status trace_subscribe_packet_events_handle(ns3_sim sim, ns3_device dev,
+                                                             ns3_pkt_cb onTx, ns3_pkt_cb onRx, void* user,
+                                                             ns3_trace_sub* outSub) {
+    JournalScope journal(JournalOp::TraceSubscribePacketEventsHandle, sim);
+    if (journal) {
+        journal.In().Handle(dev).U8(onTx ? 1 : 0).U8(onRx ? 1 : 0);
+        journal.OnOk([outSub](JournalRecord& r) {
+            r.Handle(*outSub);
+        });
+    }
+
+    if (!outSub || SubscribePacketEvents(sim, dev, "trace_subscribe_packet_events_handle", onTx, onRx, nullptr,
+                                         nullptr, user, outSub) != NS3_OK) {
+        return NS3_ERR;
+    }
+    return journal.Ok();
+}
+
+NS3SHIM_API ns3_status trace_subscribe_packet_events_ex(ns3_sim sim, ns3_device dev,
+                                                         ns3_pkt_ex_cb onTx, ns3_pkt_ex_cb onRx, void* user) {
+    JournalScope journal(JournalOp::TraceSubscribePacketEventsEx, sim);
+    if (journal) {
+        journal.In().Handle(dev).U8(onTx ? 1 : 0).U8(onRx ? 1 : 0);
+    }
+
+    if (SubscribePacketEvents(sim, dev, "trace_subscribe_packet_events_ex", nullptr, nullptr, onTx, onRx, user,
+                              nullptr) != NS3_OK) {
+        return NS3_ERR;
+    }
+    return journal.Ok();
+}
+
+NS3SHIM_API ns3_status trace_subscribe_packet_events_ex_handle(ns3_sim sim, ns3_device dev,
+                                                                ns3_pkt_ex_cb onTx, ns3_pkt_ex_cb onRx, void* user,
+                                                                ns3_trace_sub* outSub) {
+    JournalScope journal(JournalOp::TraceSubscribePacketEventsExHandle, sim);
+    if (journal) {
+        journal.In().Handle(dev).U8(onTx ? 1 : 0).U8(onRx ? 1 : 0);
+        journal.OnOk([outSub](JournalRecord& r) {
+            r.Handle(*outSub);
+        });
+    }
+
+    if (!outSub || SubscribePacketEvents(sim, dev, "trace_subscribe_packet_events_ex_handle", nullptr, nullptr, onTx,
+                                         onRx, user, outSub) != NS3_OK) {
+        return NS3_ERR;
+    }
+    return journal.Ok();
+}
+
+NS3SHIM_API ns3_status trace_unsubscribe(ns3_sim sim, ns3_trace_sub sub) {
+    JournalScope journal(JournalOp::TraceUnsubscribe, sim);
+    if (journal) {
+        journal.In().Handle(sub);
+    }
+
+    if (!ValidateSim(sim) || !sub) return NS3_ERR;
+
+    try {
+        auto it = sim->traceSubs.find(HandleToId(sub));
+        if (it == sim->traceSubs.end()) {
+            sim->SetError("Invalid trace subscription handle");
+            return NS3_ERR;
+        }
+        ns3shim::PacketSubscription subscription = std::move(it->second);
+        sim->traceSubs.erase(it);
+
+        // No host call from here on, even for the packet being traced now
+        subscription.ctx->active = false;
+        if (sim->isRunning) {
+            // A host callback may be running inside the very TracedCallback
+            // the sink would be removed from; disconnect after this event
+            Simulator::ScheduleNow([sim, subscription]() { DisconnectPacketSubscription(sim, subscription); });
+        } else {
+            DisconnectPacketSubscription(sim, subscription);
+        }
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("trace_unsubscribe failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status trace_get_stats(ns3_sim sim, ns3_trace_stats* outStats) {
+    if (!ValidateSim(sim) || !outStats) return NS3_ERR;
+
+    std::lock_guard<std::mutex> lock(sim->traceContextMutex);
+    outStats->subscriptions = static_cast<uint32_t>(sim->traceSubs.size());
+    outStats->contexts = static_cast<uint32_t>(sim->traceContextPool.Live());
+    outStats->contextCapacity = static_cast<uint32_t>(sim->traceContextPool.Capacity());
+    return NS3_OK;
+}
+
+NS3SHIM_API ns3_status trace_set_filter(ns3_sim sim, ns3_device dev, const ns3_trace_filter* filter) {
+    JournalScope journal(JournalOp::TraceSetFilter, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Handle(dev).U8(filter ? 1 : 0);
+        if (filter) {
+            in.U32(filter->minSize).U32(filter->maxSize)
+              .U32(filter->srcAddr).U32(filter->srcMask).U32(filter->dstAddr).U32(filter->dstMask)
+              .U16(filter->srcPortMin).U16(filter->srcPortMax).U16(filter->dstPortMin).U16(filter->dstPortMax)
+              .U32(filter->sampleEvery).U8(filter->protocol);
+        }
+    }
+
+    if (!ValidateSim(sim) || !dev) return NS3_ERR;
+
+    try {
+        Ptr<NetDevice> device = GetDevice(sim, dev);
+        if (!device) return NS3_ERR;
+        if (!PhyEndTraceSource(device)) {
+            sim->SetError(std::string("trace_set_filter: ") + UNSUPPORTED_TRACE_DEVICE);
+            return NS3_ERR;
+        }
+
+        ns3shim::DeviceFilter* slot = DeviceFilterFor(sim, HandleToId(dev), device);
+        slot->filter = filter ? std::make_unique<ns3shim::PacketFilter>(*filter) : nullptr;
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("trace_set_filter failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status event_sink_open(ns3_sim sim, ns3_event_batch_cb onBatch, void* user, uint32_t batchCapacity) {
+    JournalScope journal(JournalOp::EventSinkOpen, sim);
+    if (journal) {
+        journal.In().U8(onBatch ? 1 : 0).U32(batchCapacity);
+    }
+
+    if (!ValidateSim(sim)) return NS3_ERR;
+    if (!onBatch) {
+        sim->SetError("event_sink_open: onBatch is required");
+        return NS3_ERR;
+    }
+    if (sim->eventSink.IsOpen()) {
+        sim->SetError("event_sink_open: the event sink is already open");
+        return NS3_ERR;
+    }
+
+    try {
+        sim->eventSink.Open(onBatch, user, batchCapacity);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("event_sink_open failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status event_sink_enable(ns3_sim sim, ns3_device dev, uint32_t eventMask, uint32_t* outSlot) {
+    JournalScope journal(JournalOp::EventSinkEnable, sim);
+    if (journal) {
+        journal.In().Handle(dev).U32(eventMask);
+        journal.OnOk([outSlot](JournalRecord& r) {
+            r.U32(outSlot ? *outSlot : 0);
+        });
+    }
+
+    if (!ValidateSim(sim) || !dev) return NS3_ERR;
+    if ((eventMask & ~NS3_EVENT_MASK_ALL) != 0) {
+        sim->SetError("event_sink_enable: unknown event mask bits");
+        return NS3_ERR;
+    }
+
+    try {
+        Ptr<NetDevice> device = GetDevice(sim, dev);
+        if (!device) return NS3_ERR;
+
+        const uint64_t deviceId = HandleToId(dev);
+        ns3shim::EventSlot* slot = sim->eventSink.Find(deviceId);
+        if (!slot) {
+            Ptr<Object> source = PhyEndTraceSource(device);
+            if (!source) {
+                sim->SetError(std::string("event_sink_enable: ") + UNSUPPORTED_TRACE_DEVICE);
+                return NS3_ERR;
+            }
+
+            // Every event source is connected once; the mask decides what is kept
+            slot = &sim->eventSink.Add(deviceId, DeviceFilterFor(sim, deviceId, device));
+            source->TraceConnectWithoutContext("PhyTxEnd", MakeBoundCallback(&EventSinkTxCallback, slot));
+            source->TraceConnectWithoutContext("PhyRxEnd", MakeBoundCallback(&EventSinkRxCallback, slot));
+            if (auto wifiDev = DynamicCast<WifiNetDevice>(device)) {
+                source->TraceConnectWithoutContext("PhyRxDrop", MakeBoundCallback(&EventSinkWifiDropCallback, slot));
+                wifiDev->GetMac()->TraceConnectWithoutContext("MacTxDrop",
+                                                              MakeBoundCallback(&EventSinkDropCallback, slot));
+            } else {
+                source->TraceConnectWithoutContext("PhyRxDrop", MakeBoundCallback(&EventSinkDropCallback, slot));
+                source->TraceConnectWithoutContext("MacTxDrop", MakeBoundCallback(&EventSinkDropCallback, slot));
+            }
+        }
+
+        slot->mask.store(eventMask, std::memory_order_relaxed);
+        if (outSlot) *outSlot = slot->index;
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("event_sink_enable failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status event_sink_flush(ns3_sim sim) {
+    JournalScope journal(JournalOp::EventSinkFlush, sim);
+
+    if (!ValidateSim(sim)) return NS3_ERR;
+
+    try {
+        FlushEventSink(sim, sim->isRunning);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("event_sink_flush failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status event_sink_close(ns3_sim sim) {
+    JournalScope journal(JournalOp::EventSinkClose, sim);
+
+    if (!ValidateSim(sim)) return NS3_ERR;
+    if (sim->eventSink.IsFlushing()) {
+        sim->SetError("event_sink_close: cannot close the event sink from its own callback");
+        return NS3_ERR;
+    }
+
+    try {
+        FlushEventSink(sim, sim->isRunning);
+        sim->eventSink.Close();
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("event_sink_close failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status pcap_enable(ns3_sim sim, ns3_device dev, const char* filePrefix) {
+    JournalScope journal(JournalOp::PcapEnable, sim);
+    if (journal) {
+        journal.In().Handle(dev).Str(filePrefix);
+    }
+
+    if (!ValidateSim(sim) || !dev || !filePrefix) return NS3_ERR;
     
     try {
-        sim->isRunning = true;
-        Simulator::Run();
-        sim->isRunning = false;
+        Ptr<NetDevice> device = GetDevice(sim, dev);
+        if (!device) return NS3_ERR;
+
+        std::string error;
+        if (!EnablePcapOnDevice(sim, device, filePrefix, ns3_pcap_options{}, error)) {
+            sim->SetError("pcap_enable: " + error);
+            return NS3_ERR;
+        }
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("pcap_enable failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status pcap_enable_ex(ns3_sim sim, ns3_device dev, const char* filePrefix,
+                                      const ns3_pcap_options* options) {
+    JournalScope journal(JournalOp::PcapEnableEx, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Handle(dev).Str(filePrefix).U8(options ? 1 : 0);
+        if (options) {
+            in.U32(options->bufferBytes).U32(options->snaplen).F64(options->flushIntervalSec).U32(options->flags)
+                .U32(options->compression).I32(options->compressionLevel);
+        }
+    }
+
+    if (!ValidateSim(sim) || !dev || !filePrefix) return NS3_ERR;
+
+    try {
+        Ptr<NetDevice> device = GetDevice(sim, dev);
+        if (!device) return NS3_ERR;
+
+        std::string error;
+        if (!EnablePcapOnDevice(sim, device, filePrefix, options ? *options : ns3_pcap_options{}, error)) {
+            sim->SetError("pcap_enable_ex: " + error);
+            return NS3_ERR;
+        }
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("pcap_enable_ex failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status capture_ring_open(ns3_sim sim, const char* name, const ns3_capture_ring_options* options,
+                                         ns3_capture_ring* outRing) {
+    JournalScope journal(JournalOp::CaptureRingOpen, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Str(name).U8(options ? 1 : 0);
+        if (options) {
+            in.U32(options->capacityBytes).U32(options->snaplen).U32(options->flags);
+        }
+        journal.OnOk([outRing](JournalRecord& r) {
+            r.Handle(*outRing);
+        });
+    }
+
+    if (!ValidateSim(sim) || !name || !outRing) return NS3_ERR;
+
+    try {
+        const ns3_capture_ring_options opts = options ? *options : ns3_capture_ring_options{};
+        auto ring = std::make_unique<ns3shim::CaptureRing>();
+        std::string error;
+        if (!ring->Open(name, opts.capacityBytes, opts.snaplen, (opts.flags & NS3_CAPTURE_RING_DROP) != 0, error)) {
+            sim->SetError("capture_ring_open: " + error);
+            return NS3_ERR;
+        }
+
+        uint64_t id = sim->nextCaptureRingId++;
+        sim->captureRings[id] = ns3shim::CaptureRingEntry{std::move(ring), opts.flags};
+        *outRing = IdToCaptureRingHandle(id);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("capture_ring_open failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status capture_ring_attach(ns3_sim sim, ns3_capture_ring ring, ns3_device dev) {
+    JournalScope journal(JournalOp::CaptureRingAttach, sim);
+    if (journal) {
+        journal.In().Handle(ring).Handle(dev);
+    }
+
+    if (!ValidateSim(sim) || !ring || !dev) return NS3_ERR;
+
+    try {
+        ns3shim::CaptureRingEntry* entry = GetCaptureRing(sim, ring);
+        if (!entry) return NS3_ERR;
+        if (!entry->ring->IsOpen()) {
+            sim->SetError("capture_ring_attach: capture ring is closed");
+            return NS3_ERR;
+        }
+
+        Ptr<NetDevice> device = GetDevice(sim, dev);
+        if (!device) return NS3_ERR;
+
+        uint32_t linkType;
+        if (!PcapLinkType(device, linkType)) {
+            sim->SetError(std::string("capture_ring_attach: ") + UNSUPPORTED_TRACE_DEVICE);
+            return NS3_ERR;
+        }
+        // A pcap stream has one link type
+        if (!entry->ring->SetLinkType(linkType)) {
+            sim->SetError("capture_ring_attach: device link type differs from the ring's other devices");
+            return NS3_ERR;
+        }
+
+        ConnectPcapSink(device, entry->ring.get(), (entry->flags & NS3_CAPTURE_RING_NO_PROMISC) == 0);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("capture_ring_attach failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status capture_ring_get_stats(ns3_sim sim, ns3_capture_ring ring, ns3_capture_ring_stats* outStats) {
+    if (!ValidateSim(sim) || !ring || !outStats) return NS3_ERR;
+
+    ns3shim::CaptureRingEntry* entry = GetCaptureRing(sim, ring);
+    if (!entry) return NS3_ERR;
+
+    const ns3shim::CaptureRing& r = *entry->ring;
+    *outStats = ns3_capture_ring_stats{r.Records(), r.Bytes(), r.Dropped(), r.Overwritten()};
+    return NS3_OK;
+}
+
+NS3SHIM_API ns3_status capture_ring_close(ns3_sim sim, ns3_capture_ring ring) {
+    JournalScope journal(JournalOp::CaptureRingClose, sim);
+    if (journal) {
+        journal.In().Handle(ring);
+    }
+
+    if (!ValidateSim(sim) || !ring) return NS3_ERR;
+
+    try {
+        ns3shim::CaptureRingEntry* entry = GetCaptureRing(sim, ring);
+        if (!entry) return NS3_ERR;
+
+        // The ring object stays allocated: attached sinks keep pointing at it
+        entry->ring->Close();
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("capture_ring_close failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status trace_file_open(ns3_sim sim, const char* path, uint32_t flags, ns3_trace_file* outFile) {
+    JournalScope journal(JournalOp::TraceFileOpen, sim);
+    if (journal) {
+        journal.In().Str(path).U32(flags);
+        journal.OnOk([outFile](JournalRecord& r) {
+            r.Handle(*outFile);
+        });
+    }
+
+    if (!ValidateSim(sim) || !path || !outFile) return NS3_ERR;
+
+    try {
+        auto writer = std::make_unique<ns3shim::TraceFileWriter>();
+        std::string error;
+        if (!writer->Open(path, (flags & NS3_TRACE_FILE_DIRECT) != 0, (flags & NS3_TRACE_FILE_HEADERS) != 0, error)) {
+            sim->SetError("trace_file_open: " + error);
+            return NS3_ERR;
+        }
+
+        uint64_t id = sim->nextTraceFileId++;
+        sim->traceFiles[id] = std::move(writer);
+        *outFile = IdToTraceFileHandle(id);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("trace_file_open failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status trace_file_attach(ns3_sim sim, ns3_trace_file file, ns3_device dev) {
+    JournalScope journal(JournalOp::TraceFileAttach, sim);
+    if (journal) {
+        journal.In().Handle(file).Handle(dev);
+    }
+
+    if (!ValidateSim(sim) || !file || !dev) return NS3_ERR;
+
+    try {
+        ns3shim::TraceFileWriter* writer = GetTraceFile(sim, file);
+        if (!writer) return NS3_ERR;
+        if (!writer->IsOpen()) {
+            sim->SetError("trace_file_attach: trace file is closed");
+            return NS3_ERR;
+        }
+
+        Ptr<NetDevice> device = GetDevice(sim, dev);
+        if (!device) return NS3_ERR;
+
+        Ptr<Object> source = PhyEndTraceSource(device);
+        if (!source) {
+            sim->SetError(std::string("trace_file_attach: ") + UNSUPPORTED_TRACE_DEVICE);
+            return NS3_ERR;
+        }
+
+        const uint64_t deviceId = HandleToId(dev);
+        auto tap = std::make_unique<ns3shim::TraceFileTap>(
+            ns3shim::TraceFileTap{writer, deviceId, DeviceFilterFor(sim, deviceId, device)});
+        source->TraceConnectWithoutContext("PhyTxEnd", MakeBoundCallback(&TraceFileTxCallback, tap.get()));
+        source->TraceConnectWithoutContext("PhyRxEnd", MakeBoundCallback(&TraceFileRxCallback, tap.get()));
+        sim->traceFileTaps.push_back(std::move(tap));
+
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("trace_file_attach failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status trace_file_close(ns3_sim sim, ns3_trace_file file, uint64_t* outRecordCount) {
+    JournalScope journal(JournalOp::TraceFileClose, sim);
+    if (journal) {
+        journal.In().Handle(file);
+    }
+
+    if (!ValidateSim(sim) || !file) return NS3_ERR;
+
+    try {
+        ns3shim::TraceFileWriter* writer = GetTraceFile(sim, file);
+        if (!writer) return NS3_ERR;
+
+        // The writer stays allocated: attached taps keep pointing at it
+        const uint64_t records = writer->RowCount();
+        std::string error;
+        if (!writer->Close(error)) {
+            sim->SetError("trace_file_close: " + error);
+            return NS3_ERR;
+        }
+        if (outRecordCount) *outRecordCount = records;
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("trace_file_close failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status throughput_create(ns3_sim sim, double binWidthSec, uint32_t windowBins,
+                                         ns3_throughput* outThroughput) {
+    JournalScope journal(JournalOp::ThroughputCreate, sim);
+    if (journal) {
+        journal.In().F64(binWidthSec).U32(windowBins);
+        journal.OnOk([outThroughput](JournalRecord& r) {
+            r.Handle(*outThroughput);
+        });
+    }
+
+    if (!ValidateSim(sim) || !outThroughput) return NS3_ERR;
+    if (!(binWidthSec > 0.0) || windowBins == 0) {
+        sim->SetError("throughput_create: binWidthSec and windowBins must be positive");
+        return NS3_ERR;
+    }
+
+    try {
+        uint64_t id = sim->nextThroughputId++;
+        sim->throughputs[id] = std::make_unique<ns3shim::TimeBinAccumulator>(binWidthSec, windowBins);
+        *outThroughput = IdToThroughputHandle(id);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("throughput_create failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status throughput_attach(ns3_sim sim, ns3_throughput tp, ns3_device dev) {
+    JournalScope journal(JournalOp::ThroughputAttach, sim);
+    if (journal) {
+        journal.In().Handle(tp).Handle(dev);
+    }
+
+    if (!ValidateSim(sim) || !tp || !dev) return NS3_ERR;
+
+    try {
+        ns3shim::TimeBinAccumulator* accumulator = GetThroughput(sim, tp);
+        if (!accumulator) return NS3_ERR;
+
+        Ptr<NetDevice> device = GetDevice(sim, dev);
+        if (!device) return NS3_ERR;
+
+        const uint64_t deviceId = HandleToId(dev);
+        if (accumulator->HasDevice(deviceId)) {
+            sim->SetError("throughput_attach: device is already attached");
+            return NS3_ERR;
+        }
+
+        Ptr<Object> source = PhyEndTraceSource(device);
+        if (!source) {
+            sim->SetError(std::string("throughput_attach: ") + UNSUPPORTED_TRACE_DEVICE);
+            return NS3_ERR;
+        }
+
+        auto tap = std::make_unique<ns3shim::TimeBinTap>(
+            ns3shim::TimeBinTap{accumulator, accumulator->AddDevice(deviceId)});
+        source->TraceConnectWithoutContext("PhyTxEnd", MakeBoundCallback(&ThroughputTxCallback, tap.get()));
+        source->TraceConnectWithoutContext("PhyRxEnd", MakeBoundCallback(&ThroughputRxCallback, tap.get()));
+        sim->throughputTaps.push_back(std::move(tap));
+
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("throughput_attach failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status throughput_export(ns3_sim sim, ns3_throughput tp,
+                                         ns3_device* outDevices, uint32_t deviceCapacity,
+                                         ns3_bin_counts* outMatrix, uint32_t matrixCapacity,
+                                         ns3_throughput_info* outInfo) {
+    if (!ValidateSim(sim) || !tp || !outInfo) return NS3_ERR;
+
+    try {
+        ns3shim::TimeBinAccumulator* accumulator = GetThroughput(sim, tp);
+        if (!accumulator) return NS3_ERR;
+
+        uint64_t firstBin = 0;
+        uint32_t binCount = 0;
+        accumulator->Window(Simulator::Now().GetSeconds(), firstBin, binCount);
+
+        const uint32_t deviceCount = accumulator->DeviceCount();
+        const uint64_t cells = static_cast<uint64_t>(deviceCount) * binCount;
+        if ((outDevices && deviceCapacity < deviceCount) || (outMatrix && matrixCapacity < cells)) {
+            sim->SetError("throughput_export: output buffer too small (" + std::to_string(deviceCount) +
+                          " devices x " + std::to_string(binCount) + " bins)");
+            return NS3_ERR;
+        }
+
+        if (outDevices) {
+            for (uint32_t i = 0; i < deviceCount; ++i) {
+                outDevices[i] = IdToDeviceHandle(accumulator->DeviceIds()[i]);
+            }
+        }
+        if (outMatrix) {
+            accumulator->Export(firstBin, binCount, outMatrix);
+        }
+
+        outInfo->deviceCount = deviceCount;
+        outInfo->binCount = binCount;
+        outInfo->firstBin = firstBin;
+        outInfo->binWidthSec = accumulator->BinWidth();
         return NS3_OK;
     } catch (const std::exception& e) {
-        sim->isRunning = false;
-        sim->SetError(std::string("sim_run failed: ") + e.what());
+        sim->SetError(std::string("throughput_export failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-NS3SHIM_API ns3_status sim_stop(ns3_sim sim, double atTimeSec) {
-    if (!ValidateSim(sim)) return NS3_ERR;
+NS3SHIM_API ns3_status flowmon_install_all(ns3_sim sim, ns3_flowmon* outFlowMon) {
+    JournalScope journal(JournalOp::FlowMonInstallAll, sim);
+    if (journal) {
+        journal.OnOk([outFlowMon](JournalRecord& r) {
+            r.Handle(*outFlowMon);
+        });
+    }
+
+    if (!ValidateSim(sim) || !outFlowMon) return NS3_ERR;
     
     try {
-        Simulator::Stop(Seconds(atTimeSec));
+        FlowMonitorHelper flowHelper;
+        Ptr<FlowMonitor> monitor = flowHelper.InstallAll();
+        
+        uint64_t id = sim->nextFlowMonId++;
+        sim->flowMons[id] = monitor;
+        *outFlowMon = IdToFlowMonHandle(id);
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("flowmon_install_all failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status flowmon_install(ns3_sim sim, const ns3_node* nodes, uint32_t count,
+                                       const ns3_flowmon_options* options, ns3_flowmon* outFlowMon,
+                                       uint32_t* outProbedNodes) {
+    JournalScope journal(JournalOp::FlowMonInstall, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Handles(nodes, count).U8(options ? 1 : 0);
+        if (options) {
+            in.I32(options->edgeOnly).F64(options->maxPerHopDelaySec).F64(options->startTimeSec);
+        }
+        journal.OnOk([outFlowMon](JournalRecord& r) {
+            r.Handle(*outFlowMon);
+        });
+    }
+
+    if (!ValidateSim(sim) || !outFlowMon) return NS3_ERR;
+
+    try {
+        NodeContainer candidates;
+        if (nodes && count > 0) {
+            for (uint32_t i = 0; i < count; ++i) {
+                Ptr<Node> node = GetNode(sim, nodes[i]);
+                if (!node) return NS3_ERR;
+                candidates.Add(node);
+            }
+        } else {
+            candidates = NodeContainer::GetGlobal();
+        }
+
+        // Interface 0 is the loopback; a node with more is multi-homed or forwards
+        const bool edgeOnly = options && options->edgeOnly;
+        NodeContainer probed;
+        for (auto it = candidates.Begin(); it != candidates.End(); ++it) {
+            Ptr<Ipv4> ipv4 = (*it)->GetObject<Ipv4>();
+            if (!ipv4) continue;
+            if (edgeOnly && ipv4->GetNInterfaces() > 2) continue;
+            probed.Add(*it);
+        }
+        if (probed.GetN() == 0) {
+            sim->SetError("flowmon_install: no selected node has IPv4" +
+                          std::string(edgeOnly ? " and at most one interface" : ""));
+            return NS3_ERR;
+        }
+
+        FlowMonitorHelper flowHelper;
+        if (options && options->maxPerHopDelaySec > 0.0) {
+            flowHelper.SetMonitorAttribute("MaxPerHopDelay", TimeValue(Seconds(options->maxPerHopDelaySec)));
+        }
+        if (options && options->startTimeSec > 0.0) {
+            flowHelper.SetMonitorAttribute("StartTime", TimeValue(Seconds(options->startTimeSec)));
+        }
+        Ptr<FlowMonitor> monitor = flowHelper.Install(probed);
+
+        uint64_t id = sim->nextFlowMonId++;
+        sim->flowMons[id] = monitor;
+        *outFlowMon = IdToFlowMonHandle(id);
+        if (outProbedNodes) *outProbedNodes = probed.GetN();
+
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("flowmon_install failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status flowmon_collect(ns3_sim sim, ns3_flowmon fm, ns3_flow_stats* outStats) {
+    JournalScope journal(JournalOp::FlowMonCollect, sim);
+    if (journal) {
+        journal.In().Handle(fm);
+        journal.OnOk([outStats](JournalRecord& r) {
+            r.U64(outStats->txPackets).U64(outStats->rxPackets).U64(outStats->txBytes).U64(outStats->rxBytes)
+             .F64(outStats->delaySumSec).F64(outStats->jitterSumSec).U32(outStats->flowCount);
+        });
+    }
+
+    if (!ValidateSim(sim) || !fm || !outStats) return NS3_ERR;
+    
+    try {
+        Ptr<FlowMonitor> monitor = GetFlowMon(sim, fm);
+        if (!monitor) return NS3_ERR;
+        
+        AccumulateFlowStats(monitor, outStats);
+        
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("flowmon_collect failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status flowmon_epochs_start(ns3_sim sim, ns3_flowmon fm, const ns3_flow_epoch_options* options,
+                                            ns3_flow_epochs* outEpochs) {
+    JournalScope journal(JournalOp::FlowEpochsStart, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Handle(fm).U8(options ? 1 : 0);
+        if (options) {
+            in.F64(options->epochSec).U32(options->epochCapacity).U32(options->maxFlows).Str(options->path);
+        }
+        journal.OnOk([outEpochs](JournalRecord& r) {
+            r.Handle(*outEpochs);
+        });
+    }
+
+    if (!ValidateSim(sim) || !fm || !options || !outEpochs) return NS3_ERR;
+    if (!(options->epochSec > 0.0)) {
+        sim->SetError("flowmon_epochs_start: epochSec must be positive");
+        return NS3_ERR;
+    }
+
+    try {
+        Ptr<FlowMonitor> monitor = GetFlowMon(sim, fm);
+        if (!monitor) return NS3_ERR;
+
+        auto ring = std::make_unique<ns3shim::FlowEpochRing>(options->epochSec, options->epochCapacity,
+                                                             options->maxFlows);
+        std::string error;
+        if (options->path && !ring->OpenFile(options->path, error)) {
+            sim->SetError("flowmon_epochs_start: " + error);
+            return NS3_ERR;
+        }
+
+        const uint64_t id = sim->nextFlowEpochsId++;
+        ns3shim::FlowEpochsEntry& entry = sim->flowEpochs[id];
+        entry.ring = std::move(ring);
+        entry.monitor = monitor;
+        entry.startSec = Simulator::Now().GetSeconds();
+        entry.next = Simulator::Schedule(Seconds(options->epochSec), &FlowEpochTick, sim, id);
+        *outEpochs = IdToFlowEpochsHandle(id);
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("flowmon_epochs_start failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status flowmon_epochs_export(ns3_sim sim, ns3_flow_epochs epochs,
+                                             const ns3_flow_epoch_columns* columns,
+                                             ns3_flow_epochs_info* outInfo) {
+    if (!ValidateSim(sim) || !epochs || !outInfo) return NS3_ERR;
+
+    try {
+        ns3shim::FlowEpochsEntry* entry = GetFlowEpochs(sim, epochs);
+        if (!entry) return NS3_ERR;
+        const ns3shim::FlowEpochRing& ring = *entry->ring;
+
+        uint64_t firstEpoch = 0;
+        uint32_t epochCount = 0;
+        ring.Window(firstEpoch, epochCount);
+        const uint64_t cells = static_cast<uint64_t>(epochCount) * ring.FlowCount();
+        if (columns && columns->capacity < cells) {
+            sim->SetError("flowmon_epochs_export: output buffer too small (" + std::to_string(epochCount) +
+                          " epochs x " + std::to_string(ring.FlowCount()) + " flows)");
+            return NS3_ERR;
+        }
+        if (columns) {
+            ns3_flow_epoch_columns out = *columns;
+            ring.Export(out);
+        }
+
+        outInfo->firstEpoch = firstEpoch;
+        outInfo->epochCount = epochCount;
+        outInfo->flowCount = ring.FlowCount();
+        outInfo->droppedFlows = ring.DroppedFlows();
+        outInfo->epochSec = ring.EpochSec();
+        outInfo->startSec = entry->startSec;
+        return NS3_OK;
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("flowmon_epochs_export failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status flowmon_epochs_stop(ns3_sim sim, ns3_flow_epochs epochs) {
+    JournalScope journal(JournalOp::FlowEpochsStop, sim);
+    if (journal) {
+        journal.In().Handle(epochs);
+    }
+
+    if (!ValidateSim(sim) || !epochs) return NS3_ERR;
+
+    try {
+        ns3shim::FlowEpochsEntry* entry = GetFlowEpochs(sim, epochs);
+        if (!entry) return NS3_ERR;
+
+        Simulator::Cancel(entry->next);
+        if (!entry->ring->CloseFile() || entry->writeFailed) {
+            sim->SetError("flowmon_epochs_stop: write failed for '" + entry->ring->Path() + "'");
+            entry->writeFailed = false;
+            return NS3_ERR;
+        }
+        return journal.Ok();
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("flowmon_epochs_stop failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status flowmon_histogram(ns3_sim sim, ns3_flowmon fm, ns3_flow_hist_kind kind,
+                                         const uint32_t* flowIds, uint32_t flowCount,
+                                         uint64_t* outCounts, uint32_t capacity,
+                                         double* outBinWidth, uint32_t* outBinCount) {
+    if (!ValidateSim(sim) || !fm || !outBinWidth || !outBinCount) return NS3_ERR;
+
+    static const char* const BIN_WIDTH_ATTRIBUTES[] = {"DelayBinWidth", "JitterBinWidth", "PacketSizeBinWidth"};
+    if (kind < NS3_FLOW_HIST_DELAY || kind > NS3_FLOW_HIST_PACKET_SIZE) {
+        sim->SetError("flowmon_histogram: unknown histogram kind " + std::to_string(static_cast<int>(kind)));
+        return NS3_ERR;
+    }
+
+    try {
+        Ptr<FlowMonitor> monitor = GetFlowMon(sim, fm);
+        if (!monitor) return NS3_ERR;
+
+        auto& stats = const_cast<FlowMonitor::FlowStatsContainer&>(monitor->GetFlowStats());
+        std::vector<Histogram*> histograms;
+        if (flowIds) {
+            histograms.reserve(flowCount);
+            for (uint32_t i = 0; i < flowCount; ++i) {
+                auto it = stats.find(flowIds[i]);
+                histograms.push_back(it == stats.end() ? nullptr : FlowHistogram(it->second, kind));
+            }
+        } else {
+            histograms.reserve(stats.size());
+            for (auto& flow : stats) histograms.push_back(FlowHistogram(flow.second, kind));
+        }
+
+        uint32_t bins = 0;
+        for (const Histogram* h : histograms) {
+            if (h) bins = std::max(bins, h->GetNBins());
+        }
+        DoubleValue binWidth;
+        monitor->GetAttribute(BIN_WIDTH_ATTRIBUTES[kind], binWidth);
+        *outBinWidth = binWidth.Get();
+        *outBinCount = bins;
+        if (!outCounts) return NS3_OK;
+
+        const uint32_t rows = flowIds ? flowCount : 1;
+        const uint64_t cells = static_cast<uint64_t>(rows) * bins;
+        if (capacity < cells) {
+            sim->SetError("flowmon_histogram: buffer holds " + std::to_string(capacity) + " of " +
+                          std::to_string(rows) + " x " + std::to_string(bins) + " bins");
+            return NS3_ERR;
+        }
+
+        // Merging is a per-bin sum: every flow of a monitor shares the bin width
+        std::fill_n(outCounts, cells, 0);
+        for (size_t r = 0; r < histograms.size(); ++r) {
+            Histogram* h = histograms[r];
+            if (!h) continue;
+            uint64_t* row = outCounts + (flowIds ? r * bins : 0);
+            const uint32_t n = h->GetNBins();
+            for (uint32_t i = 0; i < n; ++i) row[i] += h->GetBinCount(i);
+        }
+        return NS3_OK;
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("flowmon_histogram failed: ") + e.what());
+        return NS3_ERR;
+    }
+}
+
+NS3SHIM_API ns3_status flowmon_quantiles(ns3_sim sim, ns3_flowmon fm,
+                                         const ns3_flow_metric* metrics, uint32_t metricCount,
+                                         const double* quantiles, uint32_t quantileCount, double compression,
+                                         double* outValues, uint64_t* outFlowCounts) {
+    if (!ValidateSim(sim) || !fm || !outValues) return NS3_ERR;
+    if (!ValidateFlowQuantileArgs(sim, "flowmon_quantiles", metrics, metricCount, quantiles, quantileCount,
+                                  compression, false)) {
+        return NS3_ERR;
+    }
+
+    try {
+        Ptr<FlowMonitor> monitor = GetFlowMon(sim, fm);
+        if (!monitor) return NS3_ERR;
+
+        SummariseFlowMetrics(metrics, metricCount, quantiles, quantileCount, compression, [&](auto&& add) {
+            for (const auto& flow : monitor->GetFlowStats()) {
+                const FlowMonitor::FlowStats& f = flow.second;
+                const double fct = f.rxPackets > 0 ? (f.timeLastRxPacket - f.timeFirstTxPacket).GetSeconds() : -1.0;
+                add(FlowMetricInput{static_cast<double>(f.txPackets), static_cast<double>(f.rxPackets),
+                                    static_cast<double>(f.rxBytes), static_cast<double>(f.lostPackets),
+                                    f.delaySum.GetSeconds(), f.jitterSum.GetSeconds(),
+                                    f.rxPackets > 1 ? f.rxPackets - 1.0 : 0.0, fct, fct});
+            }
+        }, outValues, outFlowCounts);
         return NS3_OK;
     } catch (const std::exception& e) {
-        sim->SetError(std::string("sim_stop failed: ") + e.what());
+        sim->SetError(std::string("flowmon_quantiles failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-NS3SHIM_API ns3_status sim_is_running(ns3_sim sim, int* outIsRunning) {
-    if (!ValidateSim(sim) || !outIsRunning) return NS3_ERR;
-    
-    *outIsRunning = sim->isRunning ? 1 : 0;
-    return NS3_OK;
-}
+NS3SHIM_API ns3_status flowmon_epochs_quantiles(ns3_sim sim, ns3_flow_epochs epochs, uint64_t epoch,
+                                                const ns3_flow_metric* metrics, uint32_t metricCount,
+                                                const double* quantiles, uint32_t quantileCount, double compression,
+                                                double* outValues, uint64_t* outFlowCounts) {
+    if (!ValidateSim(sim) || !epochs || !outValues) return NS3_ERR;
+    if (!ValidateFlowQuantileArgs(sim, "flowmon_epochs_quantiles", metrics, metricCount, quantiles, quantileCount,
+                                  compression, true)) {
+        return NS3_ERR;
+    }
 
-NS3SHIM_API ns3_status sim_now(ns3_sim sim, double* outTimeSec) {
-    if (!ValidateSim(sim) || !outTimeSec) return NS3_ERR;
-    
     try {
-        *outTimeSec = Simulator::Now().GetSeconds();
+        ns3shim::FlowEpochsEntry* entry = GetFlowEpochs(sim, epochs);
+        if (!entry) return NS3_ERR;
+        const ns3shim::FlowEpochRing& ring = *entry->ring;
+
+        if (epoch == 0) epoch = ring.Epochs();
+        size_t slot = 0, previous = 0;
+        if (epoch < 2 || !ring.SlotOf(epoch, slot) || !ring.SlotOf(epoch - 1, previous)) {
+            sim->SetError("flowmon_epochs_quantiles: epochs " + std::to_string(epoch) + " and " +
+                          std::to_string(epoch > 0 ? epoch - 1 : 0) + " are not both retained");
+            return NS3_ERR;
+        }
+
+        const double epochSec = ring.TimeAt(slot) - ring.TimeAt(previous);
+        SummariseFlowMetrics(metrics, metricCount, quantiles, quantileCount, compression, [&](auto&& add) {
+            for (uint32_t i = 0; i < ring.FlowCount(); ++i) {
+                const ns3shim::FlowEpochSample now = ring.SampleAt(slot, i);
+                const ns3shim::FlowEpochSample before = ring.SampleAt(previous, i);
+                const double rxPackets = static_cast<double>(now.rxPackets - before.rxPackets);
+                add(FlowMetricInput{static_cast<double>(now.txPackets - before.txPackets), rxPackets,
+                                    static_cast<double>(now.rxBytes - before.rxBytes),
+                                    static_cast<double>(now.lostPackets - before.lostPackets),
+                                    now.delaySumSec - before.delaySumSec, now.jitterSumSec - before.jitterSumSec,
+                                    rxPackets, epochSec, -1.0});
+            }
+        }, outValues, outFlowCounts);
         return NS3_OK;
     } catch (const std::exception& e) {
-        sim->SetError(std::string("sim_now failed: ") + e.what());
+        sim->SetError(std::string("flowmon_epochs_quantiles failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-NS3SHIM_API ns3_status sim_schedule(ns3_sim sim, double inSeconds, ns3_void_cb cb, void* user) {
-    if (!ValidateSim(sim) || !cb) return NS3_ERR;
-    
-    try {
-        Simulator::Schedule(Seconds(inSeconds), [cb, user]() {
-            cb(user);
+// ============================================================================
+// Latency Histograms
+// ============================================================================
+
+NS3SHIM_API ns3_status latency_install_all(ns3_sim sim, uint32_t precisionBits, ns3_latency* outLatency) {
+    JournalScope journal(JournalOp::LatencyInstallAll, sim);
+    if (journal) {
+        journal.In().U32(precisionBits);
+        journal.OnOk([outLatency](JournalRecord& r) {
+            r.Handle(*outLatency);
         });
-        return NS3_OK;
+    }
+
+    if (!ValidateSim(sim) || !outLatency) return NS3_ERR;
+
+    if (precisionBits == 0) precisionBits = ns3shim::LATENCY_DEFAULT_BITS;
+    if (precisionBits < ns3shim::LATENCY_MIN_BITS || precisionBits > ns3shim::LATENCY_MAX_BITS) {
+        sim->SetError("latency_install_all: precisionBits must be between " +
+                      std::to_string(ns3shim::LATENCY_MIN_BITS) + " and " +
+                      std::to_string(ns3shim::LATENCY_MAX_BITS));
+        return NS3_ERR;
+    }
+
+    try {
+        auto monitor = std::make_unique<ns3shim::LatencyMonitor>(precisionBits);
+        for (uint32_t i = 0; i < NodeList::GetNNodes(); ++i) {
+            Ptr<Ipv4L3Protocol> ipv4 = NodeList::GetNode(i)->GetObject<Ipv4L3Protocol>();
+            if (!ipv4) continue;
+            ipv4->TraceConnectWithoutContext("SendOutgoing", MakeBoundCallback(&LatencyStamp, monitor.get()));
+            ipv4->TraceConnectWithoutContext("LocalDeliver", MakeBoundCallback(&LatencyDeliver, monitor.get()));
+        }
+
+        uint64_t id = sim->nextLatencyId++;
+        sim->latencies[id] = std::move(monitor);
+        *outLatency = IdToLatencyHandle(id);
+        return journal.Ok();
     } catch (const std::exception& e) {
-        sim->SetError(std::string("sim_schedule failed: ") + e.what());
+        sim->SetError(std::string("latency_install_all failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-NS3SHIM_API ns3_status sim_destroy(ns3_sim sim) {
-    if (!sim) return NS3_OK; // NULL-safe, idempotent
+NS3SHIM_API ns3_status latency_flows(ns3_sim sim, ns3_latency lat,
+                                     ns3_latency_flow* outFlows, uint32_t capacity,
+                                     uint32_t* outCount) {
+    if (!ValidateSim(sim) || !lat || !outCount) return NS3_ERR;
 
     try {
-        // Clean up trace contexts
-        {
-            std::lock_guard<std::mutex> lock(sim->traceContextMutex);
-            for (void* ptr : sim->traceContexts) {
-                delete static_cast<PacketTraceContext*>(ptr);
-            }
-            sim->traceContexts.clear();
+        ns3shim::LatencyMonitor* monitor = GetLatency(sim, lat);
+        if (!monitor) return NS3_ERR;
+
+        const uint32_t count = monitor->FlowCount();
+        *outCount = count;
+        if (!outFlows) return NS3_OK;
+        if (capacity < count) {
+            sim->SetError("latency_flows: buffer holds " + std::to_string(capacity) + " of " +
+                          std::to_string(count) + " flows");
+            return NS3_ERR;
         }
 
-        // Clean up ns-3 state
-        Simulator::Destroy();
-        delete sim;
+        for (uint32_t i = 0; i < count; ++i) {
+            const ns3shim::LatencyFlowKey& key = monitor->Key(i);
+            const ns3shim::LatencyHistogram& h = monitor->Histogram(i);
+            ns3_latency_flow& f = outFlows[i];
+            f.srcAddr = key.srcAddr;
+            f.dstAddr = key.dstAddr;
+            f.srcPort = key.srcPort;
+            f.dstPort = key.dstPort;
+            f.protocol = key.protocol;
+            f.packets = h.Count();
+            f.minSec = h.MinNs() * 1e-9;
+            f.maxSec = h.MaxNs() * 1e-9;
+            f.meanSec = h.MeanNs() * 1e-9;
+        }
         return NS3_OK;
-    } catch (...) {
-        // Best effort cleanup
-        delete sim;
+    } catch (const std::exception& e) {
+        sim->SetError(std::string("latency_flows failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-// ============================================================================
-// Nodes & Topology
-// ============================================================================
+NS3SHIM_API ns3_status latency_percentiles(ns3_sim sim, ns3_latency lat, uint32_t flowIndex,
+                                           const double* quantiles, uint32_t count, double* outSec) {
+    if (!ValidateSim(sim) || !lat || (count > 0 && (!quantiles || !outSec))) return NS3_ERR;
 
-NS3SHIM_API ns3_status nodes_create(ns3_sim sim, uint32_t count, ns3_node* outArray) {
-    if (!ValidateSim(sim) || !outArray || count == 0) return NS3_ERR;
-    
     try {
-        NodeContainer nodes;
-        nodes.Create(count);
-        
+        ns3shim::LatencyMonitor* monitor = GetLatency(sim, lat);
+        if (!monitor) return NS3_ERR;
+
+        ns3shim::LatencyHistogram merged(monitor->Layout());
+        const ns3shim::LatencyHistogram* h = SelectLatencyFlow(sim, *monitor, flowIndex, merged);
+        if (!h) return NS3_ERR;
+
         for (uint32_t i = 0; i < count; ++i) {
-            uint64_t id = sim->nextNodeId++;
-            sim->nodes[id] = nodes.Get(i);
-            outArray[i] = IdToNodeHandle(id);
+            outSec[i] = h->Quantile(monitor->Layout(), quantiles[i]) * 1e-9;
         }
-        
         return NS3_OK;
     } catch (const std::exception& e) {
-        sim->SetError(std::string("nodes_create failed: ") + e.what());
+        sim->SetError(std::string("latency_percentiles failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-NS3SHIM_API ns3_status internet_install(ns3_sim sim, const ns3_node* nodes, uint32_t count) {
-    if (!ValidateSim(sim) || !nodes || count == 0) return NS3_ERR;
-    
+NS3SHIM_API ns3_status latency_buckets(ns3_sim sim, ns3_latency lat, uint32_t flowIndex,
+                                       uint64_t* outCounts, double* outLowerSec, uint32_t capacity,
+                                       uint32_t* outBucketCount) {
+    if (!ValidateSim(sim) || !lat || !outBucketCount) return NS3_ERR;
+
     try {
-        NodeContainer nc;
-        for (uint32_t i = 0; i < count; ++i) {
-            Ptr<Node> node = GetNode(sim, nodes[i]);
-            if (!node) return NS3_ERR;
-            nc.Add(node);
+        ns3shim::LatencyMonitor* monitor = GetLatency(sim, lat);
+        if (!monitor) return NS3_ERR;
+
+        const ns3shim::LatencyLayout& layout = monitor->Layout();
+        const uint32_t buckets = layout.BucketCount();
+        *outBucketCount = buckets;
+        if (!outCounts && !outLowerSec) return NS3_OK;
+        if (capacity < buckets) {
+            sim->SetError("latency_buckets: buffer holds " + std::to_string(capacity) + " of " +
+                          std::to_string(buckets) + " buckets");
+            return NS3_ERR;
+        }
+
+        if (outLowerSec) {
+            for (uint32_t i = 0; i < buckets; ++i) outLowerSec[i] = layout.Lower(i) * 1e-9;
+        }
+        if (outCounts) {
+            ns3shim::LatencyHistogram merged(layout);
+            const ns3shim::LatencyHistogram* h = SelectLatencyFlow(sim, *monitor, flowIndex, merged);
+            if (!h) return NS3_ERR;
+            for (uint32_t i = 0; i < buckets; ++i) outCounts[i] = h->Counts()[i];
         }
-        
-        sim->internetStack.Install(nc);
         return NS3_OK;
     } catch (const std::exception& e) {
-        sim->SetError(std::string("internet_install failed: ") + e.what());
+        sim->SetError(std::string("latency_buckets failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
 // ============================================================================
-// Network Devices & Links
+// Flow Completion Times
 // ============================================================================
 
-NS3SHIM_API ns3_status p2p_install(ns3_sim sim, ns3_node a, ns3_node b,
-                                   const char* dataRate, const char* delay, uint32_t mtu,
-                                   ns3_device* outDevA, ns3_device* outDevB) {
-    if (!ValidateSim(sim) || !a || !b || !dataRate || !delay || !outDevA || !outDevB) return NS3_ERR;
-    
+NS3SHIM_API ns3_status fct_install_all(ns3_sim sim, const ns3_fct_options* options, ns3_fct* outFct) {
+    JournalScope journal(JournalOp::FctInstallAll, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.U8(options ? 1 : 0);
+        if (options) {
+            const uint32_t edges = options->sizeEdges ? options->sizeEdgeCount : 0;
+            in.U32(edges);
+            for (uint32_t i = 0; i < edges; ++i) in.U64(options->sizeEdges[i]);
+            in.F64(options->idleSec).F64(options->compression);
+        }
+        journal.OnOk([outFct](JournalRecord& r) {
+            r.Handle(*outFct);
+        });
+    }
+
+    if (!ValidateSim(sim) || !outFct) return NS3_ERR;
+
+    std::vector<uint64_t> edges;
+    double idleSec = 0.0;
+    double compression = 0.0;
+    if (options) {
+        if (options->sizeEdgeCount > 0 && !options->sizeEdges) {
+            sim->SetError("fct_install_all: sizeEdges is NULL");
+            return NS3_ERR;
+        }
+        edges.assign(options->sizeEdges, options->sizeEdges + options->sizeEdgeCount);
+        if (!std::is_sorted(edges.begin(), edges.end()) ||
+            std::adjacent_find(edges.begin(), edges.end()) != edges.end()) {
+            sim->SetError("fct_install_all: sizeEdges must be strictly ascending");
+            return NS3_ERR;
+        }
+        if (options->idleSec < 0.0 || options->compression < 0.0) {
+            sim->SetError("fct_install_all: idleSec and compression must not be negative");
+            return NS3_ERR;
+        }
+        idleSec = options->idleSec;
+        compression = options->compression;
+    }
+
     try {
-        Ptr<Node> nodeA = GetNode(sim, a);
-        Ptr<Node> nodeB = GetNode(sim, b);
-        if (!nodeA || !nodeB) return NS3_ERR;
-        
-        PointToPointHelper p2p;
-        p2p.SetDeviceAttribute("DataRate", StringValue(dataRate));
-        p2p.SetChannelAttribute("Delay", StringValue(delay));
-        p2p.SetDeviceAttribute("Mtu", UintegerValue(mtu));
-        
-        NodeContainer nc(nodeA, nodeB);
-        NetDeviceContainer devices = p2p.Install(nc);
-        
-        uint64_t idA = sim->nextDeviceId++;
-        uint64_t idB = sim->nextDeviceId++;
-        
-        sim->devices[idA] = devices.Get(0);
-        sim->devices[idB] = devices.Get(1);
-        
-        *outDevA = IdToDeviceHandle(idA);
-        *outDevB = IdToDeviceHandle(idB);
-        
-        return NS3_OK;
+        auto tracker = std::make_unique<ns3shim::FctTracker>(std::move(edges),
+                                                             static_cast<int64_t>(idleSec * 1e9), compression);
+        for (uint32_t i = 0; i < NodeList::GetNNodes(); ++i) {
+            Ptr<Ipv4L3Protocol> ipv4 = NodeList::GetNode(i)->GetObject<Ipv4L3Protocol>();
+            if (!ipv4) continue;
+            ipv4->TraceConnectWithoutContext("SendOutgoing", MakeBoundCallback(&FctSend, tracker.get()));
+            ipv4->TraceConnectWithoutContext("LocalDeliver", MakeBoundCallback(&FctDeliver, tracker.get()));
+        }
+
+        uint64_t id = sim->nextFctId++;
+        sim->fcts[id] = std::move(tracker);
+        *outFct = IdToFctHandle(id);
+        return journal.Ok();
     } catch (const std::exception& e) {
-        sim->SetError(std::string("p2p_install failed: ") + e.what());
+        sim->SetError(std::string("fct_install_all failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-NS3SHIM_API ns3_status csma_install(ns3_sim sim, const ns3_node* nodes, uint32_t count,
-                                    const char* dataRate, const char* delay,
-                                    ns3_device* outDevices) {
-    if (!ValidateSim(sim) || !nodes || count == 0 || !dataRate || !delay || !outDevices) return NS3_ERR;
-    
+NS3SHIM_API ns3_status fct_flows(ns3_sim sim, ns3_fct fct, ns3_fct_flow* outFlows, uint32_t capacity,
+                                 uint32_t* outCount) {
+    if (!ValidateSim(sim) || !fct || !outCount) return NS3_ERR;
+
     try {
-        NodeContainer nc;
-        for (uint32_t i = 0; i < count; ++i) {
-            Ptr<Node> node = GetNode(sim, nodes[i]);
-            if (!node) return NS3_ERR;
-            nc.Add(node);
+        ns3shim::FctTracker* tracker = GetFct(sim, fct);
+        if (!tracker) return NS3_ERR;
+
+        // Flows whose first payload was delivered but never seen leaving are skipped
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < tracker->FlowCount(); ++i) {
+            if (tracker->Flow(i).firstTxNs >= 0) ++count;
         }
-        
-        CsmaHelper csma;
-        csma.SetChannelAttribute("DataRate", StringValue(dataRate));
-        csma.SetChannelAttribute("Delay", StringValue(delay));
-        
-        NetDeviceContainer devices = csma.Install(nc);
-        
-        for (uint32_t i = 0; i < count; ++i) {
-            uint64_t id = sim->nextDeviceId++;
-            sim->devices[id] = devices.Get(i);
-            outDevices[i] = IdToDeviceHandle(id);
+        *outCount = count;
+        if (!outFlows) return NS3_OK;
+        if (capacity < count) {
+            sim->SetError("fct_flows: buffer holds " + std::to_string(capacity) + " of " +
+                          std::to_string(count) + " flows");
+            return NS3_ERR;
+        }
+
+        const int64_t nowNs = Simulator::Now().GetNanoSeconds();
+        uint32_t out = 0;
+        for (uint32_t i = 0; i < tracker->FlowCount(); ++i) {
+            const ns3shim::FctFlow& flow = tracker->Flow(i);
+            if (flow.firstTxNs < 0) continue;
+            ns3_fct_flow& f = outFlows[out++];
+            f.srcAddr = flow.key.srcAddr;
+            f.dstAddr = flow.key.dstAddr;
+            f.srcPort = flow.key.srcPort;
+            f.dstPort = flow.key.dstPort;
+            f.protocol = flow.key.protocol;
+            f.complete = tracker->Complete(flow, nowNs) ? 1 : 0;
+            f.bytes = flow.Size();
+            f.startSec = flow.firstTxNs * 1e-9;
+            f.fctSec = flow.lastRxNs >= 0 ? (flow.lastRxNs - flow.firstTxNs) * 1e-9 : 0.0;
         }
-        
         return NS3_OK;
     } catch (const std::exception& e) {
-        sim->SetError(std::string("csma_install failed: ") + e.what());
+        sim->SetError(std::string("fct_flows failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-NS3SHIM_API ns3_status wifi_install_sta_ap(ns3_sim sim, const ns3_node* stas, uint32_t staCount, ns3_node ap,
-                                           int phyStandard, const char* dataRate, int channelNumber,
-                                           ns3_device* outStaDevices, ns3_device* outApDevice) {
-    if (!ValidateSim(sim) || !stas || staCount == 0 || !ap || !dataRate || !outStaDevices || !outApDevice) return NS3_ERR;
-    
+NS3SHIM_API ns3_status fct_distribution(ns3_sim sim, ns3_fct fct, const double* quantiles, uint32_t quantileCount,
+                                        ns3_fct_bucket* outBuckets, double* outQuantileSec, uint32_t capacity,
+                                        uint32_t* outBucketCount) {
+    if (!ValidateSim(sim) || !fct || !outBucketCount) return NS3_ERR;
+    if (quantileCount > 0 && !quantiles) return NS3_ERR;
+
     try {
-        NodeContainer staNodes;
-        for (uint32_t i = 0; i < staCount; ++i) {
-            Ptr<Node> node = GetNode(sim, stas[i]);
-            if (!node) return NS3_ERR;
-            staNodes.Add(node);
+        ns3shim::FctTracker* tracker = GetFct(sim, fct);
+        if (!tracker) return NS3_ERR;
+
+        const uint32_t buckets = tracker->BucketCount();
+        *outBucketCount = buckets;
+        if (!outBuckets && !outQuantileSec) return NS3_OK;
+        if (capacity < buckets) {
+            sim->SetError("fct_distribution: buffer holds " + std::to_string(capacity) + " of " +
+                          std::to_string(buckets) + " buckets");
+            return NS3_ERR;
         }
-        
-        Ptr<Node> apNode = GetNode(sim, ap);
-        if (!apNode) return NS3_ERR;
-        
-        // Create Wi-Fi channel
-        YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
-        YansWifiPhyHelper phy;
-        phy.SetChannel(channel.Create());
-        
-        // Wi-Fi helper
-        WifiHelper wifi;
-        WifiMacHelper mac;
-        
-        // Set standard
-        switch (phyStandard) {
-            case 0: wifi.SetStandard(WIFI_STANDARD_80211a); break;
-            case 1: wifi.SetStandard(WIFI_STANDARD_80211b); break;
-            case 2: wifi.SetStandard(WIFI_STANDARD_80211g); break;
-            case 3: wifi.SetStandard(WIFI_STANDARD_80211n); break;
-            case 4: wifi.SetStandard(WIFI_STANDARD_80211n); break;
-            case 5: wifi.SetStandard(WIFI_STANDARD_80211ac); break;
-            default: wifi.SetStandard(WIFI_STANDARD_80211n); break;
+
+        std::vector<ns3_fct_bucket> summary(buckets);
+        std::vector<ns3shim::TDigest> digests;
+        if (outQuantileSec) digests.assign(buckets, ns3shim::TDigest(tracker->Compression()));
+        for (uint32_t b = 0; b < buckets; ++b) {
+            summary[b].maxBytes = b < buckets - 1 ? tracker->SizeEdges()[b] : UINT64_MAX;
         }
-        
-        wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
-                                     "DataMode", StringValue(dataRate),
-                                     "ControlMode", StringValue(dataRate));
-        
-        // Configure SSID
-        Ssid ssid = Ssid("ns3-wifi");
-        
-        // Install STA devices
-        mac.SetType("ns3::StaWifiMac",
-                   "Ssid", SsidValue(ssid),
-                   "ActiveProbing", BooleanValue(false));
-        NetDeviceContainer staDevices = wifi.Install(phy, mac, staNodes);
-        
-        // Install AP device
-        mac.SetType("ns3::ApWifiMac",
-                   "Ssid", SsidValue(ssid));
-        NetDeviceContainer apDevices = wifi.Install(phy, mac, apNode);
-        
-        // Store devices
-        for (uint32_t i = 0; i < staCount; ++i) {
-            uint64_t id = sim->nextDeviceId++;
-            sim->devices[id] = staDevices.Get(i);
-            outStaDevices[i] = IdToDeviceHandle(id);
+
+        const int64_t nowNs = Simulator::Now().GetNanoSeconds();
+        for (uint32_t i = 0; i < tracker->FlowCount(); ++i) {
+            const ns3shim::FctFlow& flow = tracker->Flow(i);
+            if (!tracker->Complete(flow, nowNs)) continue;
+
+            const uint32_t b = tracker->Bucket(flow.Size());
+            const double fctSec = (flow.lastRxNs - flow.firstTxNs) * 1e-9;
+            ns3_fct_bucket& s = summary[b];
+            s.minSec = s.flows == 0 ? fctSec : std::min(s.minSec, fctSec);
+            s.maxSec = std::max(s.maxSec, fctSec);
+            s.meanSec += (fctSec - s.meanSec) / static_cast<double>(++s.flows);
+            if (outQuantileSec) digests[b].Add(fctSec);
+        }
+
+        if (outBuckets) std::copy(summary.begin(), summary.end(), outBuckets);
+        if (outQuantileSec) {
+            for (uint32_t b = 0; b < buckets; ++b) {
+                for (uint32_t q = 0; q < quantileCount; ++q) {
+                    outQuantileSec[b * quantileCount + q] = digests[b].Quantile(quantiles[q]);
+                }
+            }
         }
-        
-        uint64_t apId = sim->nextDeviceId++;
-        sim->devices[apId] = apDevices.Get(0);
-        *outApDevice = IdToDeviceHandle(apId);
-        
         return NS3_OK;
     } catch (const std::exception& e) {
-        sim->SetError(std::string("wifi_install_sta_ap failed: ") + e.what());
+        sim->SetError(std::string("fct_distribution failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
 // ============================================================================
-// Mobility
+// Queue Monitoring
 // ============================================================================
 
-NS3SHIM_API ns3_status mobility_set_constant_position(ns3_sim sim, ns3_node node, double x, double y, double z) {
-    if (!ValidateSim(sim) || !node) return NS3_ERR;
-    
+NS3SHIM_API ns3_status queue_monitor_create(ns3_sim sim, double binWidthSec, uint32_t windowBins,
+                                            ns3_queue_event_cb onEvent, void* user,
+                                            ns3_queue_monitor* outMonitor) {
+    JournalScope journal(JournalOp::QueueMonitorCreate, sim);
+    if (journal) {
+        journal.In().F64(binWidthSec).U32(windowBins).U8(onEvent ? 1 : 0);
+        journal.OnOk([outMonitor](JournalRecord& r) {
+            r.Handle(*outMonitor);
+        });
+    }
+
+    if (!ValidateSim(sim) || !outMonitor) return NS3_ERR;
+    if (!(binWidthSec > 0.0) || windowBins == 0) {
+        sim->SetError("queue_monitor_create: binWidthSec and windowBins must be positive");
+        return NS3_ERR;
+    }
+
     try {
-        Ptr<Node> n = GetNode(sim, node);
-        if (!n) return NS3_ERR;
-        
-        MobilityHelper mobility;
-        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
-        mobility.Install(n);
-        
-        Ptr<MobilityModel> mobModel = n->GetObject<MobilityModel>();
-        if (mobModel) {
-            mobModel->SetPosition(Vector(x, y, z));
-        }
-        
-        return NS3_OK;
+        uint64_t id = sim->nextQueueMonitorId++;
+        sim->queueMonitors[id] = std::make_unique<ns3shim::QueueMonitor>(binWidthSec, windowBins, onEvent, user);
+        *outMonitor = IdToQueueMonitorHandle(id);
+        return journal.Ok();
     } catch (const std::exception& e) {
-        sim->SetError(std::string("mobility_set_constant_position failed: ") + e.what());
+        sim->SetError(std::string("queue_monitor_create failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-// ============================================================================
-// IP Addressing & Routing
-// ============================================================================
+NS3SHIM_API ns3_status queue_monitor_attach(ns3_sim sim, ns3_queue_monitor qm, ns3_device dev) {
+    JournalScope journal(JournalOp::QueueMonitorAttach, sim);
+    if (journal) {
+        journal.In().Handle(qm).Handle(dev);
+    }
+
+    if (!ValidateSim(sim) || !qm || !dev) return NS3_ERR;
 
-NS3SHIM_API ns3_status ipv4_assign(ns3_sim sim, const ns3_device* devices, uint32_t count,
-                                   const char* networkBase, const char* mask) {
-    if (!ValidateSim(sim) || !devices || count == 0 || !networkBase || !mask) return NS3_ERR;
-    
     try {
-        NetDeviceContainer devContainer;
-        for (uint32_t i = 0; i < count; ++i) {
-            Ptr<NetDevice> dev = GetDevice(sim, devices[i]);
-            if (!dev) return NS3_ERR;
-            devContainer.Add(dev);
+        ns3shim::QueueMonitor* monitor = GetQueueMonitor(sim, qm);
+        if (!monitor) return NS3_ERR;
+
+        Ptr<NetDevice> device = GetDevice(sim, dev);
+        if (!device) return NS3_ERR;
+
+        const uint64_t deviceId = HandleToId(dev);
+        if (monitor->HasDevice(deviceId)) {
+            sim->SetError("queue_monitor_attach: device is already attached");
+            return NS3_ERR;
         }
-        
-        sim->ipv4Helper.SetBase(networkBase, mask);
-        sim->ipv4Helper.Assign(devContainer);
-        
-        return NS3_OK;
+
+        // Drop traces live on the device for PointToPoint/CSMA and on the
+        // PHY and MAC for Wi-Fi
+        Ptr<Object> phyDropSource = device;
+        Ptr<Object> macDropSource = device;
+        auto wifiDev = DynamicCast<WifiNetDevice>(device);
+        if (wifiDev) {
+            phyDropSource = wifiDev->GetPhy();
+            macDropSource = wifiDev->GetMac();
+        } else if (!DynamicCast<PointToPointNetDevice>(device) && !DynamicCast<CsmaNetDevice>(device)) {
+            sim->SetError(std::string("queue_monitor_attach: ") + UNSUPPORTED_TRACE_DEVICE);
+            return NS3_ERR;
+        }
+
+        Ptr<Queue<Packet>> queue = DeviceTxQueue(device);
+        Ptr<QueueDisc> qdisc = DeviceRootQueueDisc(device);
+        const uint32_t row = monitor->AddDevice(deviceId, Simulator::Now().GetSeconds(),
+                                                queue ? queue->GetNPackets() : 0,
+                                                qdisc ? qdisc->GetNPackets() : 0);
+        auto tap = std::make_unique<ns3shim::QueueTap>(ns3shim::QueueTap{monitor, row});
+        ns3shim::QueueTap* t = tap.get();
+        sim->queueTaps.push_back(std::move(tap));
+
+        if (queue) {
+            queue->TraceConnectWithoutContext("Enqueue", MakeBoundCallback(&QueueEnqueueCallback, t));
+            queue->TraceConnectWithoutContext("Dequeue", MakeBoundCallback(&QueueDequeueCallback, t));
+            queue->TraceConnectWithoutContext("Drop", MakeBoundCallback(&QueueDropCallback, t));
+            queue->TraceConnectWithoutContext("PacketsInQueue", MakeBoundCallback(&QueueBacklogCallback, t));
+        }
+        if (qdisc) {
+            qdisc->TraceConnectWithoutContext("Enqueue", MakeBoundCallback(&QdiscEnqueueCallback, t));
+            qdisc->TraceConnectWithoutContext("Dequeue", MakeBoundCallback(&QdiscDequeueCallback, t));
+            qdisc->TraceConnectWithoutContext("Drop", MakeBoundCallback(&QdiscDropCallback, t));
+            qdisc->TraceConnectWithoutContext("PacketsInQueue", MakeBoundCallback(&QdiscBacklogCallback, t));
+        }
+        if (wifiDev) {
+            phyDropSource->TraceConnectWithoutContext("PhyRxDrop", MakeBoundCallback(&WifiPhyRxDropCallback, t));
+        } else {
+            phyDropSource->TraceConnectWithoutContext("PhyRxDrop", MakeBoundCallback(&PhyRxDropCallback, t));
+        }
+        macDropSource->TraceConnectWithoutContext("MacTxDrop", MakeBoundCallback(&MacTxDropCallback, t));
+
+        return journal.Ok();
     } catch (const std::exception& e) {
-        sim->SetError(std::string("ipv4_assign failed: ") + e.what());
+        sim->SetError(std::string("queue_monitor_attach failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-NS3SHIM_API ns3_status ipv4_populate_routing_tables(ns3_sim sim) {
-    if (!ValidateSim(sim)) return NS3_ERR;
-    
+NS3SHIM_API ns3_status queue_monitor_export(ns3_sim sim, ns3_queue_monitor qm,
+                                            ns3_device* outDevices, ns3_queue_counters* outCounters,
+                                            uint32_t deviceCapacity,
+                                            ns3_queue_bin* outMatrix, uint32_t matrixCapacity,
+                                            ns3_throughput_info* outInfo) {
+    if (!ValidateSim(sim) || !qm || !outInfo) return NS3_ERR;
+
     try {
-        Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+        ns3shim::QueueMonitor* monitor = GetQueueMonitor(sim, qm);
+        if (!monitor) return NS3_ERR;
+
+        monitor->AdvanceAll(Simulator::Now().GetSeconds());
+        uint64_t firstBin = 0;
+        uint32_t binCount = 0;
+        monitor->Window(firstBin, binCount);
+
+        const uint32_t deviceCount = monitor->DeviceCount();
+        const uint64_t cells = static_cast<uint64_t>(deviceCount) * binCount;
+        const bool rowsRequested = outDevices || outCounters;
+        if ((rowsRequested && deviceCapacity < deviceCount) || (outMatrix && matrixCapacity < cells)) {
+            sim->SetError("queue_monitor_export: output buffer too small (" + std::to_string(deviceCount) +
+                          " devices x " + std::to_string(binCount) + " bins)");
+            return NS3_ERR;
+        }
+
+        for (uint32_t i = 0; i < deviceCount; ++i) {
+            if (outDevices) outDevices[i] = IdToDeviceHandle(monitor->DeviceIds()[i]);
+            if (outCounters) outCounters[i] = monitor->Counters(i);
+        }
+        if (outMatrix) {
+            monitor->Export(firstBin, binCount, outMatrix);
+        }
+
+        outInfo->deviceCount = deviceCount;
+        outInfo->binCount = binCount;
+        outInfo->firstBin = firstBin;
+        outInfo->binWidthSec = monitor->BinWidth();
         return NS3_OK;
     } catch (const std::exception& e) {
-        sim->SetError(std::string("ipv4_populate_routing_tables failed: ") + e.what());
+        sim->SetError(std::string("queue_monitor_export failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
 // ============================================================================
-// Applications
+// TCP Bulk Transfers
 // ============================================================================
 
-NS3SHIM_API ns3_status app_udpecho_server(ns3_sim sim, ns3_node node, uint16_t port, ns3_app* outApp) {
-    if (!ValidateSim(sim) || !node || !outApp) return NS3_ERR;
-    
-    try {
-        Ptr<Node> n = GetNode(sim, node);
-        if (!n) return NS3_ERR;
-        
-        UdpEchoServerHelper server(port);
-        ApplicationContainer apps = server.Install(n);
-        
-        uint64_t id = sim->nextAppId++;
-        sim->apps[id] = apps.Get(0);
-        *outApp = IdToAppHandle(id);
-        
-        return NS3_OK;
-    } catch (const std::exception& e) {
-        sim->SetError(std::string("app_udpecho_server failed: ") + e.what());
-        return NS3_ERR;
+NS3SHIM_API ns3_status tcp_bulk_install(ns3_sim sim, const ns3_node* nodes, uint32_t nodeCount,
+                                        const ns3_tcp_flow_spec* specs, uint32_t count,
+                                        const ns3_tcp_bulk_options* options, ns3_app* outSenders,
+                                        ns3_tcp_bulk* outBulk) {
+    JournalScope journal(JournalOp::TcpBulkInstall, sim);
+    if (journal) {
+        JournalRecord& in = journal.In();
+        in.Handles(nodes, nodeCount).U32(specs ? count : 0);
+        for (uint32_t i = 0; specs && i < count; ++i) {
+            const ns3_tcp_flow_spec& spec = specs[i];
+            in.U32(spec.srcNode).U32(spec.dstNode).U16(spec.port).U16(spec.congestionControl)
+              .U32(spec.initialCwndSegments).U64(spec.bytes).F64(spec.startSec).F64(spec.stopSec);
+        }
+        in.U8(options ? 1 : 0);
+        if (options) {
+            in.U32(options->sendSize).U32(options->segmentSize).U32(options->sndBufBytes)
+              .U32(options->rcvBufBytes).F64(options->intervalSec).U32(options->windowIntervals);
+        }
+        journal.OnOk([outSenders, count, outBulk](JournalRecord& r) {
+            r.Handles(outSenders, outSenders ? count : 0).Handle(*outBulk);
+        });
     }
-}
 
-NS3SHIM_API ns3_status app_udpecho_client(ns3_sim sim, ns3_node node, const char* dstIp, uint16_t port,
-                                          uint32_t packetSize, double intervalSec, uint32_t maxPackets, ns3_app* outApp) {
-    if (!ValidateSim(sim) || !node || !dstIp || !outApp) return NS3_ERR;
-    
-    try {
-        Ptr<Node> n = GetNode(sim, node);
-        if (!n) return NS3_ERR;
-        
-        UdpEchoClientHelper client(Ipv4Address(dstIp), port);
-        client.SetAttribute("MaxPackets", UintegerValue(maxPackets));
-        client.SetAttribute("Interval", TimeValue(Seconds(intervalSec)));
-        client.SetAttribute("PacketSize", UintegerValue(packetSize));
-        
-        ApplicationContainer apps = client.Install(n);
-        
-        uint64_t id = sim->nextAppId++;
-        sim->apps[id] = apps.Get(0);
-        *outApp = IdToAppHandle(id);
-        
-        return NS3_OK;
-    } catch (const std::exception& e) {
-        sim->SetError(std::string("app_udpecho_client failed: ") + e.what());
+    if (!ValidateSim(sim) || !nodes || !specs || count == 0 || !outBulk) return NS3_ERR;
+    const double intervalSec = options && options->intervalSec != 0.0 ? options->intervalSec : 0.1;
+    if (!(intervalSec > 0.0)) {
+        sim->SetError("tcp_bulk_install: intervalSec must be positive");
         return NS3_ERR;
     }
-}
 
-NS3SHIM_API ns3_status app_start(ns3_sim sim, ns3_app app, double atTimeSec) {
-    if (!ValidateSim(sim) || !app) return NS3_ERR;
-    
     try {
-        Ptr<Application> a = GetApp(sim, app);
-        if (!a) return NS3_ERR;
-        
-        a->SetStartTime(Seconds(atTimeSec));
-        return NS3_OK;
+        std::vector<Ptr<Node>> nodePtrs(nodeCount);
+        for (uint32_t i = 0; i < nodeCount; ++i) {
+            nodePtrs[i] = GetNode(sim, nodes[i]);
+            if (!nodePtrs[i]) return NS3_ERR;
+        }
+
+        // Check everything first so a bad spec leaves nothing half-installed
+        std::vector<Ipv4Address> addrCache(nodeCount, Ipv4Address::GetAny());
+        std::set<std::pair<uint32_t, uint16_t>> sinks;
+        std::vector<Ipv4Address> peers(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const std::string error = CheckTcpFlowSpec(specs[i], nodePtrs, addrCache, sinks, peers[i]);
+            if (!error.empty()) {
+                sim->SetError("tcp_bulk_install: spec " + std::to_string(i) + ": " + error);
+                return NS3_ERR;
+            }
+        }
+
+        const uint32_t sendSize = options && options->sendSize ? options->sendSize : 1448;
+        const uint32_t windowIntervals = options && options->windowIntervals ? options->windowIntervals : 100;
+        auto monitor = std::make_unique<ns3shim::TcpBulkMonitor>(intervalSec, windowIntervals);
+        ns3shim::TcpSocketConfig config;
+        if (options) {
+            if (options->segmentSize) config.segmentSize = options->segmentSize;
+            config.sndBufBytes = options->sndBufBytes;
+            config.rcvBufBytes = options->rcvBufBytes;
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const ns3_tcp_flow_spec& spec = specs[i];
+            config.congestionControl = TcpCongestionTypeId(spec.congestionControl);
+            config.pacing = spec.congestionControl == NS3_TCP_BBR;
+            config.initialCwndSegments = spec.initialCwndSegments;
+            const uint32_t row = monitor->AddFlow(spec.bytes);
+
+            Ptr<ns3shim::TcpBulkSinkApp> sink = CreateObject<ns3shim::TcpBulkSinkApp>();
+            sink->Configure(spec.port, config, monitor.get(), row);
+            nodePtrs[spec.dstNode]->AddApplication(sink);
+            sink->SetStartTime(Seconds(spec.startSec));
+
+            Ptr<ns3shim::TcpBulkSendApp> sender = CreateObject<ns3shim::TcpBulkSendApp>();
+            sender->Configure(InetSocketAddress(peers[i], spec.port), config, spec.bytes, sendSize, monitor.get(),
+                              row);
+            nodePtrs[spec.srcNode]->AddApplication(sender);
+            sender->SetStartTime(Seconds(spec.startSec));
+            if (spec.stopSec > 0.0) sender->SetStopTime(Seconds(spec.stopSec));
+
+            const uint64_t appId = sim->nextAppId++;
+            sim->apps.emplace_hint(sim->apps.end(), appId, sender);
+            if (outSenders) outSenders[i] = IdToAppHandle(appId);
+        }
+
+        uint64_t id = sim->nextTcpBulkId++;
+        sim->tcpBulks[id] = std::move(monitor);
+        *outBulk = IdToTcpBulkHandle(id);
+        return journal.Ok();
     } catch (const std::exception& e) {
-        sim->SetError(std::string("app_start failed: ") + e.what());
+        sim->SetError(std::string("tcp_bulk_install failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
-NS3SHIM_API ns3_status app_stop(ns3_sim sim, ns3_app app, double atTimeSec) {
-    if (!ValidateSim(sim) || !app) return NS3_ERR;
-    
+NS3SHIM_API ns3_status tcp_bulk_export(ns3_sim sim, ns3_tcp_bulk bulk,
+                                       ns3_tcp_flow_stats* outStats, uint32_t flowCapacity,
+                                       ns3_tcp_bin* outMatrix, uint32_t matrixCapacity,
+                                       ns3_throughput_info* outInfo) {
+    if (!ValidateSim(sim) || !bulk || !outInfo) return NS3_ERR;
+
     try {
-        Ptr<Application> a = GetApp(sim, app);
-        if (!a) return NS3_ERR;
-        
-        a->SetStopTime(Seconds(atTimeSec));
+        ns3shim::TcpBulkMonitor* monitor = GetTcpBulk(sim, bulk);
+        if (!monitor) return NS3_ERR;
+
+        const double nowSec = Simulator::Now().GetSeconds();
+        monitor->AdvanceAll(nowSec);
+        uint64_t firstBin = 0;
+        uint32_t binCount = 0;
+        monitor->Window(firstBin, binCount);
+
+        const uint32_t flowCount = monitor->FlowCount();
+        const uint64_t cells = static_cast<uint64_t>(flowCount) * binCount;
+        if ((outStats && flowCapacity < flowCount) || (outMatrix && matrixCapacity < cells)) {
+            sim->SetError("tcp_bulk_export: output buffer too small (" + std::to_string(flowCount) +
+                          " transfers x " + std::to_string(binCount) + " intervals)");
+            return NS3_ERR;
+        }
+
+        for (uint32_t i = 0; outStats && i < flowCount; ++i) {
+            outStats[i] = monitor->Stats(i, nowSec);
+        }
+        if (outMatrix) {
+            monitor->Export(firstBin, binCount, outMatrix);
+        }
+
+        outInfo->deviceCount = flowCount;
+        outInfo->binCount = binCount;
+        outInfo->firstBin = firstBin;
+        outInfo->binWidthSec = monitor->BinWidth();
         return NS3_OK;
     } catch (const std::exception& e) {
-        sim->SetError(std::string("app_stop failed: ") + e.what());
+        sim->SetError(std::string("tcp_bulk_export failed: ") + e.what());
         return NS3_ERR;
     }
 }
 
 // ============================================================================
-// Tracing & Statistics
+// Parameter Sweeps
 // ============================================================================
 
-NS3SHIM_API ns3_status trace_subscribe_packet_events(ns3_sim sim, ns3_device dev,
-                                                      ns3_pkt_cb onTx, ns3_pkt_cb onRx, void* user) {
-    if (!ValidateSim(sim) || !dev) return NS3_ERR;
+NS3SHIM_API ns3_status sim_sweep_run(ns3_sim sim, const ns3_sweep_config* config,
+                                     ns3_sweep_point_summary* outSummaries, uint32_t capacity) {
+    JournalScope journal(JournalOp::SimSweepRun, sim);
+    if (journal) {
+        JournalSweepConfig(journal.In(), config, capacity);
+    }
 
+    if (!ValidateSim(sim) || !config || !outSummaries || config->runCount == 0) return NS3_ERR;
+
+#ifdef _WIN32
+    sim->SetError("sim_sweep_run requires fork() and is not supported on Windows");
+    return NS3_ERR;
+#else
     try {
-        Ptr<NetDevice> device = GetDevice(sim, dev);
-        if (!device) return NS3_ERR;
+        if (!CheckForkable(sim, "sim_sweep_run")) return NS3_ERR;
 
-        uint64_t deviceId = HandleToId(dev);
+        Ptr<FlowMonitor> monitor = GetFlowMon(sim, config->flowMon);
+        if (!monitor) return NS3_ERR;
 
-        // Create persistent context — tracked in sim for cleanup on sim_destroy
-        auto* ctx = new PacketTraceContext{onTx, onRx, user, deviceId};
-        {
-            std::lock_guard<std::mutex> lock(sim->traceContextMutex);
-            sim->traceContexts.push_back(ctx);
+        if (config->axisCount > 0 && !config->axes) {
+            sim->SetError("sim_sweep_run: axes is NULL but axisCount > 0");
+            return NS3_ERR;
         }
 
-        bool connected = false;
-
-        // Try to connect via PointToPointNetDevice
-        if (auto p2pDev = DynamicCast<PointToPointNetDevice>(device)) {
-            if (onTx) {
-                p2pDev->TraceConnectWithoutContext(
-                    "PhyTxEnd",
-                    MakeBoundCallback(&PacketTxCallback, ctx));
-            }
-            if (onRx) {
-                p2pDev->TraceConnectWithoutContext(
-                    "PhyRxEnd",
-                    MakeBoundCallback(&PacketRxCallback, ctx));
-            }
-            connected = true;
-        }
-        // Try CsmaNetDevice
-        else if (auto csmaDev = DynamicCast<CsmaNetDevice>(device)) {
-            if (onTx) {
-                csmaDev->TraceConnectWithoutContext(
-                    "PhyTxEnd",
-                    MakeBoundCallback(&PacketTxCallback, ctx));
-            }
-            if (onRx) {
-                csmaDev->TraceConnectWithoutContext(
-                    "PhyRxEnd",
-                    MakeBoundCallback(&PacketRxCallback, ctx));
-            }
-            connected = true;
-        }
-        // Try WifiNetDevice
-        else if (auto wifiDev = DynamicCast<WifiNetDevice>(device)) {
-            if (onTx) {
-                wifiDev->TraceConnectWithoutContext(
-                    "PhyTxEnd",
-                    MakeBoundCallback(&PacketTxCallback, ctx));
+        uint64_t pointCount = 1;
+        for (uint32_t a = 0; a < config->axisCount; ++a) {
+            const ns3_sweep_axis& axis = config->axes[a];
+            if (!axis.path || !axis.attrName || !axis.values || axis.valueCount == 0) {
+                sim->SetError("sim_sweep_run: axis " + std::to_string(a) + " is incomplete");
+                return NS3_ERR;
             }
-            if (onRx) {
-                wifiDev->TraceConnectWithoutContext(
-                    "PhyRxEnd",
-                    MakeBoundCallback(&PacketRxCallback, ctx));
+            pointCount *= axis.valueCount;
+            if (pointCount > UINT32_MAX) {
+                sim->SetError("sim_sweep_run: parameter grid is too large");
+                return NS3_ERR;
             }
-            connected = true;
         }
 
-        if (!connected) {
-            sim->SetError("trace_subscribe_packet_events: unsupported device type — "
-                          "only PointToPoint, CSMA, and Wi-Fi devices are supported");
+        if (capacity < pointCount) {
+            sim->SetError("sim_sweep_run: outSummaries holds " + std::to_string(capacity) +
+                          " points but the grid has " + std::to_string(pointCount));
             return NS3_ERR;
         }
 
-        return NS3_OK;
-    } catch (const std::exception& e) {
-        sim->SetError(std::string("trace_subscribe_packet_events failed: ") + e.what());
-        return NS3_ERR;
-    }
-}
+        const uint32_t runCount = config->runCount;
+        const size_t jobCount = static_cast<size_t>(pointCount) * runCount;
 
-NS3SHIM_API ns3_status pcap_enable(ns3_sim sim, ns3_device dev, const char* filePrefix) {
-    if (!ValidateSim(sim) || !dev || !filePrefix) return NS3_ERR;
-    
-    try {
-        Ptr<NetDevice> device = GetDevice(sim, dev);
-        if (!device) return NS3_ERR;
-        
-        PointToPointHelper p2p;
-        p2p.EnablePcap(filePrefix, device, true);
-        
-        return NS3_OK;
+        auto body = [config, monitor, runCount](size_t job, ForkRunResult* result) {
+            const uint32_t point = static_cast<uint32_t>(job / runCount);
+            const uint64_t run = config->firstRun + job % runCount;
+
+            ExecuteForkedRun(monitor, config->seed, run, config->stopTimeSec, [config, point]() {
+                // Row-major decode: the last axis varies fastest
+                uint32_t rem = point;
+                for (uint32_t a = config->axisCount; a-- > 0;) {
+                    const ns3_sweep_axis& axis = config->axes[a];
+                    const ns3_attr& value = axis.values[rem % axis.valueCount];
+                    rem /= axis.valueCount;
+                    if (!ConfigSetAttr(std::string(axis.path) + "/" + axis.attrName, value)) {
+                        throw std::invalid_argument("invalid value on sweep axis " + std::to_string(a));
+                    }
+                }
+            }, result);
+        };
+
+        std::vector<ForkRunResult> results;
+        std::string forkError;
+        if (!RunForked(jobCount, config->maxParallel, body, results, forkError)) {
+            sim->SetError("sim_sweep_run failed: " + forkError);
+            return NS3_ERR;
+        }
+
+        const double confidence = (config->confidenceLevel > 0.0 && config->confidenceLevel < 1.0)
+            ? config->confidenceLevel : 0.95;
+
+        std::string firstFailure;
+        uint64_t totalCompleted = 0;
+
+        for (uint32_t p = 0; p < pointCount; ++p) {
+            ns3_sweep_point_summary& out = outSummaries[p];
+            out = ns3_sweep_point_summary{};
+            out.pointIndex = p;
+
+            std::vector<double> txPackets, rxPackets, txBytes, rxBytes, delaySum, jitterSum,
+                                flowCount, meanDelay, meanJitter, lossRatio;
+
+            for (uint32_t r = 0; r < runCount; ++r) {
+                const ForkRunResult& res = results[static_cast<size_t>(p) * runCount + r];
+                if (res.status != NS3_OK) {
+                    ++out.runsFailed;
+                    if (firstFailure.empty()) firstFailure = res.error;
+                    continue;
+                }
+
+                ++out.runsCompleted;
+                const ns3_flow_stats& st = res.stats;
+                txPackets.push_back(static_cast<double>(st.txPackets));
+                rxPackets.push_back(static_cast<double>(st.rxPackets));
+                txBytes.push_back(static_cast<double>(st.txBytes));
+                rxBytes.push_back(static_cast<double>(st.rxBytes));
+                delaySum.push_back(st.delaySumSec);
+                jitterSum.push_back(st.jitterSumSec);
+                flowCount.push_back(static_cast<double>(st.flowCount));
+                meanDelay.push_back(st.rxPackets > 0 ? st.delaySumSec / st.rxPackets : 0.0);
+                meanJitter.push_back(st.rxPackets > 0 ? st.jitterSumSec / st.rxPackets : 0.0);
+                lossRatio.push_back(st.txPackets > 0
+                    ? 1.0 - static_cast<double>(st.rxPackets) / st.txPackets : 0.0);
+            }
+
+            totalCompleted += out.runsCompleted;
+            ns3shim::Summarize(txPackets, confidence, &out.txPackets);
+            ns3shim::Summarize(rxPackets, confidence, &out.rxPackets);
+            ns3shim::Summarize(txBytes, confidence, &out.txBytes);
+            ns3shim::Summarize(rxBytes, confidence, &out.rxBytes);
+            ns3shim::Summarize(delaySum, confidence, &out.delaySumSec);
+            ns3shim::Summarize(jitterSum, confidence, &out.jitterSumSec);
+            ns3shim::Summarize(flowCount, confidence, &out.flowCount);
+            ns3shim::Summarize(meanDelay, confidence, &out.meanDelaySec);
+            ns3shim::Summarize(meanJitter, confidence, &out.meanJitterSec);
+            ns3shim::Summarize(lossRatio, confidence, &out.lossRatio);
+        }
+
+        if (!firstFailure.empty()) {
+            // Surface the first worker failure so runsFailed can be diagnosed
+            sim->SetError("sim_sweep_run: run failed: " + firstFailure);
+            if (totalCompleted == 0) return NS3_ERR;
+        }
+
+        return journal.Ok();
     } catch (const std::exception& e) {
-        sim->SetError(std::string("pcap_enable failed: ") + e.what());
+        sim->SetError(std::string("sim_sweep_run failed: ") + e.what());
         return NS3_ERR;
     }
+#endif
 }
 
-NS3SHIM_API ns3_status flowmon_install_all(ns3_sim sim, ns3_flowmon* outFlowMon) {
-    if (!ValidateSim(sim) || !outFlowMon) return NS3_ERR;
-    
-    try {
-        FlowMonitorHelper flowHelper;
-        Ptr<FlowMonitor> monitor = flowHelper.InstallAll();
-        
-        uint64_t id = sim->nextFlowMonId++;
-        sim->flowMons[id] = monitor;
-        *outFlowMon = IdToFlowMonHandle(id);
-        
-        return NS3_OK;
-    } catch (const std::exception& e) {
-        sim->SetError(std::string("flowmon_install_all failed: ") + e.what());
-        return NS3_ERR;
+NS3SHIM_API ns3_status sim_fork_runs(ns3_sim sim, const uint64_t* runs, uint32_t count, ns3_flowmon fm,
+                                     double stopTimeSec, uint32_t maxParallel,
+                                     ns3_fork_run_result* outResults) {
+    JournalScope journal(JournalOp::SimForkRuns, sim);
+    if (journal) {
+        journal.In().U32(runs ? count : 0);
+        for (uint32_t i = 0; runs && i < count; ++i) journal.In().U64(runs[i]);
+        journal.In().Handle(fm).F64(stopTimeSec).U32(maxParallel);
     }
-}
 
-NS3SHIM_API ns3_status flowmon_collect(ns3_sim sim, ns3_flowmon fm, ns3_flow_stats* outStats) {
-    if (!ValidateSim(sim) || !fm || !outStats) return NS3_ERR;
-    
+    if (!ValidateSim(sim) || !runs || count == 0 || !outResults) return NS3_ERR;
+
+#ifdef _WIN32
+    sim->SetError("sim_fork_runs requires fork() and is not supported on Windows");
+    return NS3_ERR;
+#else
     try {
-        Ptr<FlowMonitor> monitor = GetFlowMon(sim, fm);
-        if (!monitor) return NS3_ERR;
-        
-        FlowMonitorHelper flowHelper;
-        Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier>(flowHelper.GetClassifier());
-        
-        std::map<FlowId, FlowMonitor::FlowStats> stats = monitor->GetFlowStats();
-        
-        uint64_t txPackets = 0, rxPackets = 0;
-        uint64_t txBytes = 0, rxBytes = 0;
-        double delaySum = 0.0, jitterSum = 0.0;
+        if (!CheckForkable(sim, "sim_fork_runs")) return NS3_ERR;
 
-        for (auto& flow : stats) {
-            txPackets += flow.second.txPackets;
-            rxPackets += flow.second.rxPackets;
-            txBytes += flow.second.txBytes;
-            rxBytes += flow.second.rxBytes;
-            delaySum += flow.second.delaySum.GetSeconds();
-            jitterSum += flow.second.jitterSum.GetSeconds();
+        Ptr<FlowMonitor> monitor;
+        if (fm) {
+            monitor = GetFlowMon(sim, fm);
+            if (!monitor) return NS3_ERR;
         }
-        
-        outStats->txPackets = txPackets;
-        outStats->rxPackets = rxPackets;
-        outStats->txBytes = txBytes;
-        outStats->rxBytes = rxBytes;
-        outStats->delaySumSec = delaySum;
-        outStats->jitterSumSec = jitterSum;
-        outStats->flowCount = stats.size();
-        
-        return NS3_OK;
+
+        auto body = [runs, monitor, stopTimeSec](size_t job, ForkRunResult* result) {
+            ExecuteForkedRun(monitor, 0, runs[job], stopTimeSec, nullptr, result);
+        };
+
+        std::vector<ForkRunResult> results;
+        std::string forkError;
+        if (!RunForked(count, maxParallel, body, results, forkError)) {
+            sim->SetError("sim_fork_runs failed: " + forkError);
+            return NS3_ERR;
+        }
+
+        std::string firstFailure;
+        uint32_t completed = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            ns3_fork_run_result& out = outResults[i];
+            out = ns3_fork_run_result{};
+            out.run = runs[i];
+            out.status = results[i].status == NS3_OK ? NS3_OK : NS3_ERR;
+            out.wallTimeSec = results[i].wallTimeSec;
+            if (out.status == NS3_OK) {
+                out.stats = results[i].stats;
+                ++completed;
+            } else if (firstFailure.empty()) {
+                firstFailure = results[i].error;
+            }
+        }
+
+        if (!firstFailure.empty()) {
+            sim->SetError("sim_fork_runs: run failed: " + firstFailure);
+            if (completed == 0) return NS3_ERR;
+        }
+
+        return journal.Ok();
     } catch (const std::exception& e) {
-        sim->SetError(std::string("flowmon_collect failed: ") + e.what());
+        sim->SetError(std::string("sim_fork_runs failed: ") + e.what());
         return NS3_ERR;
     }
+#endif
+}
+
+// ============================================================================
+// Call Journal
+// ============================================================================
+
+NS3SHIM_API ns3_status journal_open(const char* path) {
+    // No simulation context to carry the message: the journal keeps it for journal_last_error
+    std::string error;
+    return Journal::Instance().Open(path ? path : "", error) ? NS3_OK : NS3_ERR;
+}
+
+NS3SHIM_API ns3_status journal_last_error(char* buf, size_t len) {
+    if (!buf || len == 0) return NS3_ERR;
+
+    std::string msg = Journal::Instance().LastError();
+    size_t copyLen = std::min(msg.size(), len - 1);
+    std::memcpy(buf, msg.c_str(), copyLen);
+    buf[copyLen] = '\0';
+    return NS3_OK;
+}
+
+NS3SHIM_API ns3_status journal_close(void) {
+    Journal::Instance().Close();
+    return NS3_OK;
 }
 
 // ============================================================================
@@ -779,31 +4826,22 @@ NS3SHIM_API ns3_status flowmon_collect(ns3_sim sim, ns3_flowmon fm, ns3_flow_sta
 // ============================================================================
 
 NS3SHIM_API ns3_status config_set(ns3_sim sim, const char* path, const char* attrName, ns3_attr value) {
+    JournalScope journal(JournalOp::ConfigSet, sim);
+    if (journal) {
+        journal.In().Str(path).Str(attrName).Attr(value);
+    }
+
     if (!ValidateSim(sim) || !path || !attrName) return NS3_ERR;
     
     try {
         std::string fullPath = std::string(path) + "/" + attrName;
         
-        switch (value.kind) {
-            case NS3_ATTR_BOOL:
-                Config::Set(fullPath, BooleanValue(value.b != 0));
-                break;
-            case NS3_ATTR_UINT:
-                Config::Set(fullPath, UintegerValue(value.u));
-                break;
-            case NS3_ATTR_DOUBLE:
-                Config::Set(fullPath, DoubleValue(value.d));
-                break;
-            case NS3_ATTR_STRING:
-                if (!value.s) return NS3_ERR;
-                Config::Set(fullPath, StringValue(value.s));
-                break;
-            default:
-                sim->SetError("Invalid attribute kind");
-                return NS3_ERR;
+        if (!ConfigSetAttr(fullPath, value)) {
+            sim->SetError("Invalid attribute kind");
+            return NS3_ERR;
         }
         
-        return NS3_OK;
+        return journal.Ok();
     } catch (const std::exception& e) {
         sim->SetError(std::string("config_set failed: ") + e.what());
         return NS3_ERR;
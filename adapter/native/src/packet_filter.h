@@ -0,0 +1,182 @@
+// packet_filter.h
+// Header peeking and trace filter predicates (internal to ns3shim)
+//
+// PHY trace sinks see link-layer frames. The parser walks the few bytes in
+// front of the IPv4 header for the device's framing (PPP, Ethernet/LLC or
+// 802.11 data + LLC/SNAP) and reads IPv4 and TCP/UDP fields in place, so a
+// filter costs one small CopyData and some byte compares per packet.
+
+#ifndef NS3SHIM_PACKET_FILTER_H
+#define NS3SHIM_PACKET_FILTER_H
+
+#include "ns3shim.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace ns3shim {
+
+/// Bytes copied out of a packet for parsing: link header (at most 36 bytes
+/// for QoS+HT 802.11 with four addresses and LLC/SNAP), IPv4 with options
+/// (at most 60) and the first 4 bytes of TCP/UDP
+constexpr uint32_t PACKET_PEEK_BYTES = 100;
+
+/// Link-layer encapsulation seen by a device's PHY trace sources
+enum class LinkFraming : uint8_t {
+    Ppp,       ///< PointToPoint: 2-byte PPP protocol field
+    Ethernet,  ///< CSMA: Ethernet II or 802.3 + LLC/SNAP
+    Wifi,      ///< Wi-Fi: 802.11 MAC header + LLC/SNAP
+};
+
+/// IPv4 and transport fields of a packet
+struct PacketHeaders {
+    bool ipv4 = false;   ///< False if the frame does not carry (parsable) IPv4
+    bool ports = false;  ///< True for TCP/UDP first fragments
+    uint8_t protocol = 0;
+    uint8_t ttl = 0;
+    uint32_t srcAddr = 0;  ///< Host byte order
+    uint32_t dstAddr = 0;
+    uint16_t srcPort = 0;
+    uint16_t dstPort = 0;
+};
+
+namespace detail {
+
+inline uint16_t Be16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+inline uint32_t Be32(const uint8_t* p) {
+    return (uint32_t{p[0]} << 24) | (uint32_t{p[1]} << 16) | (uint32_t{p[2]} << 8) | p[3];
+}
+
+// LLC/SNAP carrying an EtherType: AA AA 03 00 00 00 <type>
+inline bool SnapEtherType(const uint8_t* p, uint32_t len, uint32_t offset, uint16_t& etherType) {
+    if (offset + 8 > len) return false;
+    const uint8_t* s = p + offset;
+    if (s[0] != 0xAA || s[1] != 0xAA || s[2] != 0x03 || s[3] || s[4] || s[5]) return false;
+    etherType = Be16(s + 6);
+    return true;
+}
+
+// Offset of the IPv4 header, or -1 if the frame does not carry IPv4
+inline int32_t Ipv4Offset(LinkFraming framing, const uint8_t* p, uint32_t len) {
+    constexpr uint16_t ETHERTYPE_IPV4 = 0x0800;
+    uint16_t etherType = 0;
+
+    switch (framing) {
+        case LinkFraming::Ppp:
+            return len >= 2 && Be16(p) == 0x0021 ? 2 : -1;
+
+        case LinkFraming::Ethernet: {
+            if (len < 14) return -1;
+            uint32_t offset = 12;
+            etherType = Be16(p + offset);
+            if (etherType == 0x8100) {  // 802.1Q tag
+                offset += 4;
+                if (offset + 2 > len) return -1;
+                etherType = Be16(p + offset);
+            }
+            offset += 2;
+            if (etherType <= 1500) {  // 802.3 length field: LLC follows
+                if (!SnapEtherType(p, len, offset, etherType)) return -1;
+                offset += 8;
+            }
+            return etherType == ETHERTYPE_IPV4 ? static_cast<int32_t>(offset) : -1;
+        }
+
+        case LinkFraming::Wifi: {
+            if (len < 24) return -1;
+            const uint8_t type = (p[0] >> 2) & 0x3;
+            const uint8_t subtype = p[0] >> 4;
+            if (type != 2 || (subtype & 0x4)) return -1;  // data frames carrying a payload only
+            uint32_t offset = 24;
+            const bool qos = subtype & 0x8;
+            if ((p[1] & 0x3) == 0x3) offset += 6;  // ToDS and FromDS: fourth address
+            if (qos) offset += 2;
+            if (qos && (p[1] & 0x80)) offset += 4;  // HT control
+            if (!SnapEtherType(p, len, offset, etherType)) return -1;
+            return etherType == ETHERTYPE_IPV4 ? static_cast<int32_t>(offset + 8) : -1;
+        }
+    }
+    return -1;
+}
+
+} // namespace detail
+
+/// Parse the headers of a frame copied from the start of a packet
+inline PacketHeaders ParseHeaders(LinkFraming framing, const uint8_t* p, uint32_t len) {
+    PacketHeaders h;
+    const int32_t ip = detail::Ipv4Offset(framing, p, len);
+    if (ip < 0 || static_cast<uint32_t>(ip) + 20 > len) return h;
+
+    const uint8_t* iph = p + ip;
+    const uint32_t ihl = (iph[0] & 0x0F) * 4u;
+    if ((iph[0] >> 4) != 4 || ihl < 20) return h;
+
+    h.ipv4 = true;
+    h.ttl = iph[8];
+    h.protocol = iph[9];
+    h.srcAddr = detail::Be32(iph + 12);
+    h.dstAddr = detail::Be32(iph + 16);
+
+    const bool firstFragment = (detail::Be16(iph + 6) & 0x1FFF) == 0;
+    const uint32_t l4 = static_cast<uint32_t>(ip) + ihl;
+    if ((h.protocol == 6 || h.protocol == 17) && firstFragment && l4 + 4 <= len) {
+        h.ports = true;
+        h.srcPort = detail::Be16(p + l4);
+        h.dstPort = detail::Be16(p + l4 + 2);
+    }
+    return h;
+}
+
+/// Compiled ns3_trace_filter
+class PacketFilter {
+public:
+    explicit PacketFilter(const ns3_trace_filter& f)
+        : f_(f), needsHeaders_(f.protocol != 0 || f.srcMask != 0 || f.dstMask != 0 || HasPorts(f)) {}
+
+    /// Whether Admit needs ParseHeaders output (otherwise pass an empty one)
+    bool NeedsHeaders() const { return needsHeaders_; }
+
+    bool Admit(uint32_t size, uint64_t uid, const PacketHeaders& h) const {
+        if (f_.minSize != 0 && size < f_.minSize) return false;
+        if (f_.maxSize != 0 && size > f_.maxSize) return false;
+        // By uid rather than a counter: a sampled packet is kept on every
+        // device it crosses, in both directions
+        if (f_.sampleEvery > 1 && uid % f_.sampleEvery != 0) return false;
+        if (!needsHeaders_) return true;
+
+        if (!h.ipv4) return false;
+        if (f_.protocol != 0 && h.protocol != f_.protocol) return false;
+        if ((h.srcAddr & f_.srcMask) != (f_.srcAddr & f_.srcMask)) return false;
+        if ((h.dstAddr & f_.dstMask) != (f_.dstAddr & f_.dstMask)) return false;
+        if (HasPorts(f_)) {
+            if (!h.ports) return false;
+            if (!InRange(h.srcPort, f_.srcPortMin, f_.srcPortMax)) return false;
+            if (!InRange(h.dstPort, f_.dstPortMin, f_.dstPortMax)) return false;
+        }
+        return true;
+    }
+
+private:
+    static bool HasPorts(const ns3_trace_filter& f) {
+        return f.srcPortMin || f.srcPortMax || f.dstPortMin || f.dstPortMax;
+    }
+
+    static bool InRange(uint16_t port, uint16_t min, uint16_t max) {
+        return port >= min && (max == 0 || port <= max);
+    }
+
+    ns3_trace_filter f_;
+    bool needsHeaders_;
+};
+
+/// Filter state shared by every trace tap of one device; taps keep a
+/// pointer to it, so the filter can be set or replaced after subscribing
+struct DeviceFilter {
+    LinkFraming framing;
+    std::unique_ptr<PacketFilter> filter;  ///< Null: admit everything
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_PACKET_FILTER_H
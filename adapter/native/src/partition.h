@@ -0,0 +1,150 @@
+// partition.h
+// Lookahead-aware node-to-rank partitioning (internal to ns3shim)
+//
+// Conservative parallel execution is only as fast as its lookahead: every
+// link that crosses ranks bounds how far a rank may run ahead of the others.
+// Nodes joined by a link faster than the requested minimum lookahead are
+// therefore kept on one rank (union-find), and the resulting clusters are
+// spread over ranks largest-first, balancing node counts while keeping
+// neighbouring clusters together where the balance allows.
+
+#ifndef NS3SHIM_PARTITION_H
+#define NS3SHIM_PARTITION_H
+
+#include "ns3shim.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ns3shim {
+
+/// Disjoint-set forest with path halving and union by size
+class DisjointSet {
+public:
+    explicit DisjointSet(uint32_t count) : parent_(count), size_(count, 1) {
+        std::iota(parent_.begin(), parent_.end(), 0u);
+    }
+
+    uint32_t Find(uint32_t x) {
+        while (parent_[x] != x) {
+            parent_[x] = parent_[parent_[x]];
+            x = parent_[x];
+        }
+        return x;
+    }
+
+    void Union(uint32_t a, uint32_t b) {
+        a = Find(a);
+        b = Find(b);
+        if (a == b) return;
+        if (size_[a] < size_[b]) std::swap(a, b);
+        parent_[b] = a;
+        size_[a] += size_[b];
+    }
+
+    uint32_t Size(uint32_t root) const { return size_[root]; }
+
+private:
+    std::vector<uint32_t> parent_;
+    std::vector<uint32_t> size_;
+};
+
+/// Outcome of a partitioning pass
+struct PartitionResult {
+    double lookaheadSec = 0.0;  ///< Smallest delay among cut edges (0 if nothing is cut)
+    double imbalance = 1.0;     ///< Largest rank load divided by the mean load
+    uint32_t cutEdges = 0;      ///< Edges whose endpoints ended up on different ranks
+};
+
+/// Assign nodes to ranks; throws std::invalid_argument on malformed input
+inline PartitionResult PartitionByLookahead(uint32_t nodeCount, const ns3_partition_edge* edges,
+                                            uint32_t edgeCount, uint32_t rankCount,
+                                            double minLookaheadSec, uint32_t* outSystemIds) {
+    if (nodeCount == 0) throw std::invalid_argument("nodeCount must be positive");
+    if (rankCount == 0) throw std::invalid_argument("rankCount must be positive");
+
+    DisjointSet sets(nodeCount);
+    for (uint32_t i = 0; i < edgeCount; ++i) {
+        const ns3_partition_edge& e = edges[i];
+        if (e.a >= nodeCount || e.b >= nodeCount) {
+            throw std::invalid_argument("edge " + std::to_string(i) + " references an unknown node");
+        }
+        // Shared media (CSMA, Wi-Fi) are passed with zero delay and always fuse
+        if (e.delaySec < minLookaheadSec) {
+            sets.Union(e.a, e.b);
+        }
+    }
+
+    // Clusters in descending size; ties broken by root for a deterministic layout
+    std::vector<uint32_t> roots;
+    for (uint32_t n = 0; n < nodeCount; ++n) {
+        if (sets.Find(n) == n) roots.push_back(n);
+    }
+    std::sort(roots.begin(), roots.end(), [&sets](uint32_t x, uint32_t y) {
+        return sets.Size(x) != sets.Size(y) ? sets.Size(x) > sets.Size(y) : x < y;
+    });
+
+    // Cluster adjacency over the links that may be cut
+    std::vector<std::vector<uint32_t>> neighbours(nodeCount);
+    for (uint32_t i = 0; i < edgeCount; ++i) {
+        const uint32_t ra = sets.Find(edges[i].a);
+        const uint32_t rb = sets.Find(edges[i].b);
+        if (ra != rb) {
+            neighbours[ra].push_back(rb);
+            neighbours[rb].push_back(ra);
+        }
+    }
+
+    // Largest cluster first; among ranks with room left under the balanced
+    // target, prefer the one already holding the most neighbouring clusters
+    // (fewer cut links), otherwise fall back to the least-loaded rank
+    const uint64_t target = (nodeCount + rankCount - 1) / rankCount;
+    const uint32_t unplaced = std::numeric_limits<uint32_t>::max();
+    std::vector<uint64_t> load(rankCount, 0);
+    std::vector<uint32_t> affinity(rankCount, 0);
+    std::vector<uint32_t> rankOfRoot(nodeCount, unplaced);
+    for (uint32_t root : roots) {
+        std::fill(affinity.begin(), affinity.end(), 0u);
+        for (uint32_t nb : neighbours[root]) {
+            if (rankOfRoot[nb] != unplaced) ++affinity[rankOfRoot[nb]];
+        }
+
+        uint32_t rank = static_cast<uint32_t>(std::min_element(load.begin(), load.end()) - load.begin());
+        for (uint32_t r = 0; r < rankCount; ++r) {
+            if (load[r] + sets.Size(root) > target) continue;
+            if (affinity[r] > affinity[rank] || (affinity[r] == affinity[rank] && load[r] < load[rank])) {
+                rank = r;
+            }
+        }
+
+        rankOfRoot[root] = rank;
+        load[rank] += sets.Size(root);
+    }
+
+    for (uint32_t n = 0; n < nodeCount; ++n) {
+        outSystemIds[n] = rankOfRoot[sets.Find(n)];
+    }
+
+    PartitionResult result;
+    double lookahead = std::numeric_limits<double>::infinity();
+    for (uint32_t i = 0; i < edgeCount; ++i) {
+        const ns3_partition_edge& e = edges[i];
+        if (outSystemIds[e.a] != outSystemIds[e.b]) {
+            lookahead = std::min(lookahead, e.delaySec);
+            ++result.cutEdges;
+        }
+    }
+    result.lookaheadSec = result.cutEdges > 0 ? lookahead : 0.0;
+
+    const double mean = static_cast<double>(nodeCount) / rankCount;
+    result.imbalance = static_cast<double>(*std::max_element(load.begin(), load.end())) / mean;
+    return result;
+}
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_PARTITION_H
@@ -0,0 +1,191 @@
+// pcap_reader.cpp
+// Streaming PCAP reader (see pcap_reader.h)
+
+#include "pcap_reader.h"
+#include "pcap_writer.h"
+#include "packet_filter.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace ns3shim {
+
+namespace {
+
+constexpr uint32_t PCAP_MAGIC_NSEC     = 0xa1b23c4d;
+constexpr uint32_t PCAPNG_MAGIC        = 0x0a0d0d0a;
+constexpr uint32_t LINKTYPE_NULL       = 0;    // BSD loopback: 4-byte address family
+constexpr uint32_t LINKTYPE_RAW        = 101;
+constexpr uint32_t LINKTYPE_LINUX_SLL  = 113;
+constexpr uint32_t LINKTYPE_IPV4       = 228;
+constexpr uint32_t LINKTYPE_IPV6       = 229;
+constexpr uint32_t LINKTYPE_LINUX_SLL2 = 276;
+constexpr std::chrono::milliseconds READER_POLL{10};
+
+uint32_t Swap32(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+}
+
+bool IsIpEtherType(uint16_t type) {
+    return type == 0x0800 || type == 0x86DD;
+}
+
+// IPv4 or IPv6 header at `offset`, judged by its version nibble
+bool IsIpVersion(const uint8_t* frame, uint32_t capLen, uint32_t offset) {
+    return capLen > offset && ((frame[offset] >> 4) == 4 || (frame[offset] >> 4) == 6);
+}
+
+} // namespace
+
+PcapReader::~PcapReader() {
+    Close();
+}
+
+bool PcapReader::Open(const std::string& path, std::string& error) {
+    if (!file_.Open(path, error)) return false;
+
+    uint32_t magic = 0;
+    if (file_.Size() >= PCAP_FILE_HEADER_BYTES) std::memcpy(&magic, file_.Data(), 4);
+    swapped_ = magic == Swap32(PCAP_MAGIC_USEC) || magic == Swap32(PCAP_MAGIC_NSEC);
+    fracNs_ = magic == PCAP_MAGIC_NSEC || magic == Swap32(PCAP_MAGIC_NSEC) ? 1 : 1000;
+    linkType_ = file_.Size() >= PCAP_FILE_HEADER_BYTES ? U32(file_.Data() + 20) & 0xFFFF : 0;
+
+    if (magic == PCAPNG_MAGIC) {
+        error = "'" + path + "' is pcapng; convert it to pcap (editcap -F pcap)";
+    } else if (file_.Size() < PCAP_FILE_HEADER_BYTES || (magic != PCAP_MAGIC_USEC && magic != PCAP_MAGIC_NSEC &&
+                                                         magic != Swap32(PCAP_MAGIC_USEC) &&
+                                                         magic != Swap32(PCAP_MAGIC_NSEC))) {
+        error = "'" + path + "' is not a pcap file";
+    } else if (linkType_ != PCAP_LINKTYPE_ETHERNET && linkType_ != PCAP_LINKTYPE_PPP && linkType_ != LINKTYPE_NULL &&
+               linkType_ != LINKTYPE_RAW && linkType_ != LINKTYPE_IPV4 && linkType_ != LINKTYPE_IPV6 &&
+               linkType_ != LINKTYPE_LINUX_SLL && linkType_ != LINKTYPE_LINUX_SLL2) {
+        error = "'" + path + "' has unsupported link type " + std::to_string(linkType_);
+    } else {
+        return true;
+    }
+    file_.Close();
+    return false;
+}
+
+void PcapReader::Start() {
+    if (!file_.IsOpen() || thread_.joinable() || finished_.load(std::memory_order_acquire)) return;
+    stopping_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread(&PcapReader::ReadLoop, this);
+}
+
+bool PcapReader::Next(PcapPacket& out) {
+    bool stalled = false;
+    for (;;) {
+        // Read before popping: the last packets are pushed before finished_
+        const bool finished = finished_.load(std::memory_order_acquire);
+        if (queue_.TryPop(out)) {
+            // Wake the reader once per half queue rather than per packet
+            if ((++popped_ & (PCAP_READ_QUEUE / 2 - 1)) == 0) wake_.notify_one();
+            return true;
+        }
+        if (finished || !thread_.joinable()) return false;
+        // Waiting for the first packet after Start is not a stall
+        if (!stalled && popped_ > 0) {
+            ++stalls_;
+            stalled = true;
+        }
+        wake_.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+void PcapReader::Close() {
+    if (thread_.joinable()) {
+        stopping_.store(true, std::memory_order_release);
+        wake_.notify_one();
+        thread_.join();
+    }
+    file_.Close();
+}
+
+void PcapReader::ReadLoop() {
+    const uint8_t* data = file_.Data();
+    const size_t size = file_.Size();
+    size_t pos = PCAP_FILE_HEADER_BYTES;
+    size_t released = 0;
+    bool first = true;
+    int64_t baseNs = 0;
+
+    while (size - pos >= PCAP_RECORD_HEADER_BYTES) {
+        const uint8_t* rec = data + pos;
+        const uint32_t capLen = U32(rec + 8);
+        const uint32_t origLen = U32(rec + 12);
+        if (capLen > size - pos - PCAP_RECORD_HEADER_BYTES) break;  // truncated final record
+        const uint8_t* frame = rec + PCAP_RECORD_HEADER_BYTES;
+        pos += PCAP_RECORD_HEADER_BYTES + capLen;
+        records_.fetch_add(1, std::memory_order_relaxed);
+
+        uint32_t offset = 0;
+        if (IpOffset(frame, capLen, offset) && origLen > offset) {
+            const int64_t timeNs = int64_t{U32(rec)} * 1000000000 + int64_t{U32(rec + 4)} * fracNs_;
+            if (first) {
+                baseNs = timeNs;
+                first = false;
+            }
+            const PcapPacket packet{timeNs - baseNs, origLen - offset};
+            while (!queue_.TryPush(packet)) {
+                if (stopping_.load(std::memory_order_acquire)) return;
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                wake_.wait_for(lock, READER_POLL, [this] { return stopping_.load(std::memory_order_acquire); });
+            }
+        } else {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (pos - released >= PCAP_READ_DISCARD_BYTES) {
+            file_.Discard(pos);
+            released = pos;
+        }
+        if (stopping_.load(std::memory_order_relaxed)) return;
+    }
+    finished_.store(true, std::memory_order_release);
+}
+
+uint32_t PcapReader::U32(const uint8_t* p) const {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return swapped_ ? Swap32(v) : v;
+}
+
+bool PcapReader::IpOffset(const uint8_t* frame, uint32_t capLen, uint32_t& offset) const {
+    using detail::Be16;
+    switch (linkType_) {
+        case PCAP_LINKTYPE_ETHERNET: {
+            if (capLen < 14) return false;
+            offset = 12;
+            uint16_t type = Be16(frame + offset);
+            while ((type == 0x8100 || type == 0x88A8) && offset + 6 <= capLen) {  // VLAN / QinQ tags
+                offset += 4;
+                type = Be16(frame + offset);
+            }
+            offset += 2;
+            return IsIpEtherType(type);
+        }
+        case PCAP_LINKTYPE_PPP: {
+            offset = capLen >= 2 && frame[0] == 0xFF && frame[1] == 0x03 ? 2 : 0;  // optional HDLC address/control
+            if (capLen < offset + 2) return false;
+            const uint16_t protocol = Be16(frame + offset);
+            offset += 2;
+            return protocol == 0x0021 || protocol == 0x0057;
+        }
+        case LINKTYPE_LINUX_SLL:
+            offset = 16;
+            return capLen >= offset && IsIpEtherType(Be16(frame + 14));
+        case LINKTYPE_LINUX_SLL2:
+            offset = 20;
+            return capLen >= offset && IsIpEtherType(Be16(frame));
+        case LINKTYPE_NULL:
+            offset = 4;
+            return IsIpVersion(frame, capLen, offset);
+        default:  // raw IP
+            offset = 0;
+            return IsIpVersion(frame, capLen, offset);
+    }
+}
+
+} // namespace ns3shim
@@ -0,0 +1,98 @@
+// pcap_reader.h
+// Streaming PCAP reader for app_pcap_replay (internal to ns3shim)
+//
+// The capture is memory-mapped, never loaded. A background thread walks it
+// front to back, decodes each record header and the link-layer header in
+// front of the IP packet, and hands (time, IP length) descriptors to the
+// simulation thread through a lock-free queue. Page faults and disk reads
+// therefore happen on that thread, up to a queue's worth of packets ahead
+// of the simulation, and the pages it has passed are handed back to the
+// page cache. The simulation thread only pops descriptors; it waits only
+// when the reader has fallen a whole queue behind, which is counted as a
+// stall.
+//
+// Classic libpcap files in either byte order, with microsecond or
+// nanosecond timestamps, are accepted (not pcapng). Link types: Ethernet
+// (with VLAN tags), PPP, raw IP, Linux cooked capture v1/v2 and BSD
+// loopback. Frames that carry neither IPv4 nor IPv6 are skipped.
+
+#ifndef NS3SHIM_PCAP_READER_H
+#define NS3SHIM_PCAP_READER_H
+
+#include "mapped_file.h"
+#include "spsc_queue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ns3shim {
+
+constexpr size_t PCAP_READ_QUEUE         = 1u << 16;  ///< Packets decoded ahead of the simulation
+constexpr size_t PCAP_READ_DISCARD_BYTES = 4u << 20;  ///< Consumed bytes released at a time
+
+/// One IP packet of a capture
+struct PcapPacket {
+    int64_t timeNs;    ///< Capture timestamp relative to the first record (negative if out of order)
+    uint32_t ipBytes;  ///< Length of the IP packet on the wire
+};
+
+class PcapReader {
+public:
+    PcapReader() = default;
+    ~PcapReader();
+
+    PcapReader(const PcapReader&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+
+    /// Map a capture and validate its file header; the thread starts later
+    bool Open(const std::string& path, std::string& error);
+
+    /// Start decoding ahead on the background thread (once, after any fork)
+    void Start();
+
+    /// Next IP packet (simulation thread); false once the capture is exhausted
+    bool Next(PcapPacket& out);
+
+    /// Stop the thread and unmap the file
+    void Close();
+
+    bool IsOpen() const { return file_.IsOpen(); }
+
+    /// Records decoded so far, including skipped ones
+    uint64_t Records() const { return records_.load(std::memory_order_relaxed); }
+
+    /// Records without an IP packet (other protocols, or shorter than their link header)
+    uint64_t Skipped() const { return skipped_.load(std::memory_order_relaxed); }
+
+    /// Times Next() found the queue empty after the first packet, before the reader finished
+    uint64_t Stalls() const { return stalls_; }
+
+private:
+    void ReadLoop();
+    uint32_t U32(const uint8_t* p) const;
+    bool IpOffset(const uint8_t* frame, uint32_t capLen, uint32_t& offset) const;
+
+    MappedFile file_;
+    bool swapped_ = false;      ///< File written in the other byte order
+    uint32_t fracNs_ = 1000;    ///< Nanoseconds per unit of the fractional timestamp
+    uint32_t linkType_ = 0;
+
+    SpscQueue<PcapPacket, PCAP_READ_QUEUE> queue_;
+    std::atomic<bool> finished_{false};  ///< Reader pushed its last packet
+    std::atomic<bool> stopping_{false};
+    std::atomic<uint64_t> records_{0};
+    std::atomic<uint64_t> skipped_{0};
+    uint64_t stalls_ = 0;
+    uint64_t popped_ = 0;
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;  // reader: queue drained (notified without the lock; waits time out)
+    std::thread thread_;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_PCAP_READER_H
@@ -0,0 +1,366 @@
+// pcap_writer.cpp
+// Buffered PCAP writer (see pcap_writer.h for the file format)
+
+#include "pcap_writer.h"
+
+#include <cerrno>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef NS3SHIM_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef NS3SHIM_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace ns3shim {
+
+namespace {
+
+constexpr size_t ENCODE_STEP = 1u << 20;  // output grows in steps of this many bytes
+constexpr std::chrono::milliseconds ENCODER_POLL{10};
+
+} // namespace
+
+/// Streaming compressor, used only on the encoder thread
+class PcapEncoder {
+public:
+    virtual ~PcapEncoder() = default;
+    virtual bool Init(int level, std::string& error) = 0;
+
+    /// Append the encoding of `size` bytes to `out`. `sync` makes all input
+    /// so far decodable from the output; `finish` ends the stream.
+    virtual bool Encode(const uint8_t* data, size_t size, bool sync, bool finish, std::vector<uint8_t>& out) = 0;
+};
+
+namespace {
+
+#ifdef NS3SHIM_HAVE_ZLIB
+class GzipEncoder final : public PcapEncoder {
+public:
+    ~GzipEncoder() override {
+        if (initialized_) deflateEnd(&stream_);
+    }
+
+    bool Init(int level, std::string& error) override {
+        // windowBits 15 + 16 selects the gzip wrapper
+        if (deflateInit2(&stream_, level > 0 ? std::min(level, 9) : 1, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            error = "cannot initialize gzip encoder";
+            return false;
+        }
+        initialized_ = true;
+        return true;
+    }
+
+    bool Encode(const uint8_t* data, size_t size, bool sync, bool finish, std::vector<uint8_t>& out) override {
+        const int flush = finish ? Z_FINISH : sync ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+        stream_.next_in = const_cast<Bytef*>(data);
+        stream_.avail_in = static_cast<uInt>(size);  // at most one buffer (< 4 GiB)
+        for (;;) {
+            const size_t offset = out.size();
+            out.resize(offset + ENCODE_STEP);
+            stream_.next_out = out.data() + offset;
+            stream_.avail_out = static_cast<uInt>(ENCODE_STEP);
+            const int rc = deflate(&stream_, flush);
+            const uInt left = stream_.avail_out;
+            out.resize(offset + ENCODE_STEP - left);
+            if (rc == Z_STREAM_ERROR) return false;
+            // Done once the input is consumed and deflate stopped short of filling the output
+            if (finish ? rc == Z_STREAM_END : (stream_.avail_in == 0 && left != 0)) return true;
+        }
+    }
+
+private:
+    z_stream stream_{};
+    bool initialized_ = false;
+};
+#endif
+
+#ifdef NS3SHIM_HAVE_ZSTD
+class ZstdEncoder final : public PcapEncoder {
+public:
+    ~ZstdEncoder() override { ZSTD_freeCCtx(ctx_); }
+
+    bool Init(int level, std::string& error) override {
+        ctx_ = ZSTD_createCCtx();
+        if (!ctx_ || ZSTD_isError(ZSTD_CCtx_setParameter(ctx_, ZSTD_c_compressionLevel, level > 0 ? level : 1))) {
+            error = "cannot initialize zstd encoder";
+            return false;
+        }
+        return true;
+    }
+
+    bool Encode(const uint8_t* data, size_t size, bool sync, bool finish, std::vector<uint8_t>& out) override {
+        const ZSTD_EndDirective mode = finish ? ZSTD_e_end : sync ? ZSTD_e_flush : ZSTD_e_continue;
+        ZSTD_inBuffer in{data, size, 0};
+        for (;;) {
+            const size_t offset = out.size();
+            out.resize(offset + ENCODE_STEP);
+            ZSTD_outBuffer outBuf{out.data() + offset, ENCODE_STEP, 0};
+            const size_t remaining = ZSTD_compressStream2(ctx_, &outBuf, &in, mode);
+            out.resize(offset + outBuf.pos);
+            if (ZSTD_isError(remaining)) return false;
+            if (mode == ZSTD_e_continue ? in.pos == in.size : remaining == 0) return true;
+        }
+    }
+
+private:
+    ZSTD_CCtx* ctx_ = nullptr;
+};
+#endif
+
+std::unique_ptr<PcapEncoder> MakeEncoder(PcapCompression compression) {
+    switch (compression) {
+#ifdef NS3SHIM_HAVE_ZLIB
+        case PcapCompression::Gzip: return std::make_unique<GzipEncoder>();
+#endif
+#ifdef NS3SHIM_HAVE_ZSTD
+        case PcapCompression::Zstd: return std::make_unique<ZstdEncoder>();
+#endif
+        default: return nullptr;
+    }
+}
+
+} // namespace
+
+bool PcapCompressionSupported(PcapCompression compression) {
+    switch (compression) {
+        case PcapCompression::None: return true;
+#ifdef NS3SHIM_HAVE_ZLIB
+        case PcapCompression::Gzip: return true;
+#endif
+#ifdef NS3SHIM_HAVE_ZSTD
+        case PcapCompression::Zstd: return true;
+#endif
+        default: return false;
+    }
+}
+
+const char* PcapFileSuffix(PcapCompression compression) {
+    switch (compression) {
+        case PcapCompression::Gzip: return ".pcap.gz";
+        case PcapCompression::Zstd: return ".pcap.zst";
+        default: return ".pcap";
+    }
+}
+
+PcapWriter::PcapWriter() = default;
+
+PcapWriter::~PcapWriter() {
+    std::string ignored;
+    Close(ignored);
+}
+
+bool PcapWriter::Open(const std::string& path, uint32_t linkType, uint32_t snaplen, uint32_t bufferBytes,
+                      double flushIntervalSec, PcapCompression compression, int level, std::string& error) {
+    if (open_) {
+        error = "pcap file already open";
+        return false;
+    }
+    if (compression != PcapCompression::None) {
+        if (!PcapCompressionSupported(compression)) {
+            error = compression == PcapCompression::Gzip ? "gzip compression requires a build with zlib"
+                  : compression == PcapCompression::Zstd ? "zstd compression requires a build with libzstd"
+                  : "unknown pcap compression";
+            return false;
+        }
+        encoder_ = MakeEncoder(compression);
+        if (!encoder_->Init(level, error)) {
+            encoder_.reset();
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "cannot create pcap file '" + path + "'";
+        return false;
+    }
+    file_ = file;
+#else
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        error = "cannot create pcap file '" + path + "': " + std::strerror(errno);
+        return false;
+    }
+#endif
+
+    path_ = path;
+    linkType_ = linkType;
+    snaplen_ = snaplen ? snaplen : PCAP_DEFAULT_SNAPLEN;
+    // Room for at least the file header and one full record
+    const size_t minimum = PCAP_FILE_HEADER_BYTES + PCAP_RECORD_HEADER_BYTES + snaplen_;
+    capacity_ = std::max<size_t>(bufferBytes ? bufferBytes : PCAP_DEFAULT_BUFFER, minimum);
+    current_ = AcquireChunk();
+    buffer_ = current_->data.get();
+
+    const uint32_t header[6] = {PCAP_MAGIC_USEC, 2u | (4u << 16), 0, 0, snaplen_, linkType_};
+    static_assert(sizeof(header) == PCAP_FILE_HEADER_BYTES, "pcap file header size");
+    std::memcpy(buffer_, header, sizeof(header));
+    used_ = sizeof(header);
+
+    flushInterval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(flushIntervalSec > 0.0 ? flushIntervalSec : 0.0));
+    lastFlush_ = std::chrono::steady_clock::now();
+    records_ = 0;
+    failed_.store(false, std::memory_order_relaxed);
+    open_ = true;
+
+    if (encoder_) {
+        submitted_ = 0;
+        completed_.store(0, std::memory_order_relaxed);
+        stopping_.store(false, std::memory_order_relaxed);
+        encoderThread_ = std::thread(&PcapWriter::EncoderLoop, this);
+    }
+    return true;
+}
+
+bool PcapWriter::Flush() {
+    if (!open_) return !Failed();
+    if (!Rotate(ChunkEnd::Sync)) return false;
+    if (encoder_) WaitIdle();
+    return !Failed();
+}
+
+bool PcapWriter::Rotate(ChunkEnd end) {
+    lastFlush_ = std::chrono::steady_clock::now();
+    if (Failed()) return false;
+
+    if (!encoder_) {
+        if (used_ > 0 && !WriteAll(buffer_, used_)) failed_.store(true, std::memory_order_relaxed);
+        used_ = 0;
+        return !Failed();
+    }
+
+    // Encoder failures surface through failed_ on a later record
+    current_->used = used_;
+    current_->end = end;
+    Submit(current_);
+    current_ = AcquireChunk();
+    buffer_ = current_->data.get();
+    used_ = 0;
+    return true;
+}
+
+PcapWriter::Chunk* PcapWriter::AcquireChunk() {
+    Chunk* chunk = nullptr;
+    if (recycled_.TryPop(chunk)) return chunk;
+    chunks_.push_back(std::make_unique<Chunk>());
+    chunk = chunks_.back().get();
+    chunk->data.reset(new uint8_t[capacity_]);
+    return chunk;
+}
+
+void PcapWriter::Submit(Chunk* chunk) {
+    ++submitted_;
+    DrainBacklog();
+    // Never wait for the encoder: hold the buffer back if the queue is full
+    if (!backlog_.empty() || !ready_.TryPush(chunk)) backlog_.push_back(chunk);
+    wake_.notify_one();
+}
+
+void PcapWriter::DrainBacklog() {
+    while (!backlog_.empty() && ready_.TryPush(backlog_.front())) backlog_.pop_front();
+}
+
+void PcapWriter::WaitIdle() {
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    while (completed_.load(std::memory_order_acquire) != submitted_) {
+        DrainBacklog();
+        wake_.notify_one();
+        done_.wait_for(lock, ENCODER_POLL);
+    }
+}
+
+void PcapWriter::EncoderLoop() {
+    std::vector<uint8_t> out;
+    for (;;) {
+        Chunk* chunk = nullptr;
+        if (!ready_.TryPop(chunk)) {
+            if (stopping_.load(std::memory_order_acquire)) return;
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait_for(lock, ENCODER_POLL,
+                           [this] { return !ready_.Empty() || stopping_.load(std::memory_order_acquire); });
+            continue;
+        }
+
+        // After a failure buffers are still consumed so waiters make progress
+        if (!Failed()) {
+            out.clear();
+            const bool ok = encoder_->Encode(chunk->data.get(), chunk->used, chunk->end != ChunkEnd::Continue,
+                                             chunk->end == ChunkEnd::Finish, out) &&
+                            WriteAll(out.data(), out.size());
+            if (!ok) failed_.store(true, std::memory_order_relaxed);
+        }
+        chunk->used = 0;
+        chunk->end = ChunkEnd::Continue;
+        // A full recycle queue leaves surplus buffers idle until Close
+        recycled_.TryPush(chunk);
+
+        completed_.fetch_add(1, std::memory_order_release);
+        done_.notify_all();
+    }
+}
+
+bool PcapWriter::WriteAll(const uint8_t* data, size_t size) {
+#ifdef _WIN32
+    return std::fwrite(data, 1, size, static_cast<std::FILE*>(file_)) == size;
+#else
+    while (size > 0) {
+        const ssize_t n = ::write(fd_, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+#endif
+}
+
+bool PcapWriter::Close(std::string& error) {
+    if (!open_) return true;
+
+    if (!encoder_) {
+        Rotate(ChunkEnd::Continue);
+    } else if (encoderThread_.joinable()) {
+        current_->used = used_;
+        current_->end = ChunkEnd::Finish;
+        Submit(current_);
+        current_ = nullptr;
+        WaitIdle();
+        stopping_.store(true, std::memory_order_release);
+        wake_.notify_one();
+        encoderThread_.join();
+    }
+    open_ = false;
+    bool ok = !Failed();
+#ifdef _WIN32
+    if (file_ && std::fclose(static_cast<std::FILE*>(file_)) != 0) ok = false;
+    file_ = nullptr;
+#else
+    if (fd_ >= 0 && ::close(fd_) != 0) ok = false;
+    fd_ = -1;
+#endif
+    encoder_.reset();
+    Chunk* stale = nullptr;
+    while (recycled_.TryPop(stale)) {
+    }
+    backlog_.clear();
+    chunks_.clear();
+    current_ = nullptr;
+    buffer_ = nullptr;
+    used_ = 0;
+
+    if (!ok) error = "pcap write failed for '" + path_ + "'";
+    return ok;
+}
+
+} // namespace ns3shim
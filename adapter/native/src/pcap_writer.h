@@ -0,0 +1,195 @@
+// pcap_writer.h
+// Buffered PCAP writer (internal to ns3shim)
+//
+// Records are assembled in place in a large shim-owned buffer and written
+// with one system call when it fills, or when the flush interval of wall-
+// clock time has passed, instead of one stream write per packet as with
+// ns-3's PcapFileWrapper. Output is classic libpcap format (microsecond
+// timestamps, native byte order), readable by Wireshark and tcpdump.
+//
+// Compressed files (gzip or zstd stream) are encoded and written by a
+// background thread. Filled buffers are handed to it through a lock-free
+// queue and empty ones come back through another, so the simulation thread
+// only copies bytes; if the encoder falls behind, further buffers queue in
+// memory rather than stalling the simulation. Interval flushes end a
+// flushable compressed block, so the file decodes up to that point while
+// the run continues.
+//
+//   file header    u32 magic 0xa1b2c3d4 | u16 major 2 | u16 minor 4
+//                  | i32 thiszone 0 | u32 sigfigs 0 | u32 snaplen | u32 linkType
+//   record*        u32 tsSec | u32 tsUsec | u32 capLen | u32 origLen | data[capLen]
+
+#ifndef NS3SHIM_PCAP_WRITER_H
+#define NS3SHIM_PCAP_WRITER_H
+
+#include "spsc_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3shim {
+
+constexpr uint32_t PCAP_MAGIC_USEC          = 0xa1b2c3d4;
+constexpr uint32_t PCAP_LINKTYPE_ETHERNET   = 1;    // CSMA
+constexpr uint32_t PCAP_LINKTYPE_PPP        = 9;    // PointToPoint
+constexpr uint32_t PCAP_LINKTYPE_RADIOTAP   = 127;  // Wi-Fi (802.11 + radiotap)
+constexpr uint32_t PCAP_DEFAULT_BUFFER      = 4u << 20;
+constexpr uint32_t PCAP_DEFAULT_SNAPLEN     = 65535;
+constexpr double   PCAP_DEFAULT_FLUSH_SEC   = 1.0;
+constexpr size_t   PCAP_FILE_HEADER_BYTES   = 24;
+constexpr size_t   PCAP_RECORD_HEADER_BYTES = 16;
+constexpr size_t   PCAP_QUEUE_BUFFERS       = 64;    // buffers in flight to the encoder thread
+
+/// Output codecs; values match ns3_pcap_compression
+enum class PcapCompression : uint32_t {
+    None = 0,
+    Gzip = 1,
+    Zstd = 2,
+};
+
+/// Whether this build can write `compression` (zlib and libzstd are optional)
+bool PcapCompressionSupported(PcapCompression compression);
+
+/// File name suffix for `compression`: ".pcap", ".pcap.gz" or ".pcap.zst"
+const char* PcapFileSuffix(PcapCompression compression);
+
+class PcapEncoder;
+
+/// Write a record header (microsecond timestamp) to `out`
+inline void PcapRecordHeader(uint8_t* out, double timeSec, uint32_t capLen, uint32_t origLen) {
+    const double whole = std::floor(timeSec);
+    uint32_t header[4] = {static_cast<uint32_t>(whole),
+                          static_cast<uint32_t>(std::lround((timeSec - whole) * 1e6)), capLen, origLen};
+    if (header[1] >= 1000000) {
+        ++header[0];
+        header[1] -= 1000000;
+    }
+    std::memcpy(out, header, sizeof(header));
+}
+
+class PcapWriter {
+public:
+    PcapWriter();
+    ~PcapWriter();
+
+    PcapWriter(const PcapWriter&) = delete;
+    PcapWriter& operator=(const PcapWriter&) = delete;
+
+    /// Create (truncate) the file and buffer its header; compressed files
+    /// start their encoder thread
+    /// @param flushIntervalSec Wall-clock flush interval; <= 0 flushes only when the buffer fills
+    /// @param level Codec level; 0 = fastest (gzip 1, zstd 1)
+    bool Open(const std::string& path, uint32_t linkType, uint32_t snaplen, uint32_t bufferBytes,
+              double flushIntervalSec, PcapCompression compression, int level, std::string& error);
+
+    /// Start a record of `origLen` bytes (simulation thread only). Returns
+    /// where its `capLen` captured bytes (origLen cut to the snaplen) must be
+    /// copied, or nullptr if the writer is closed or has failed. Commit()
+    /// follows the copy.
+    uint8_t* Begin(double timeSec, uint32_t origLen, uint32_t& capLen) {
+        if (!open_ || failed_.load(std::memory_order_relaxed)) return nullptr;
+        capLen = std::min(origLen, snaplen_);
+        const size_t need = PCAP_RECORD_HEADER_BYTES + capLen;
+        // The clock is read on every record (a vDSO call, no system call):
+        // sampling it every N records would hold a slow capture's packets
+        // back for N records rather than the flush interval
+        if (used_ + need > capacity_) {
+            if (!Rotate(ChunkEnd::Continue)) return nullptr;
+        } else if (flushInterval_.count() > 0 && std::chrono::steady_clock::now() - lastFlush_ >= flushInterval_) {
+            if (!Rotate(ChunkEnd::Sync)) return nullptr;
+        }
+
+        uint8_t* record = buffer_ + used_;
+        PcapRecordHeader(record, timeSec, capLen, origLen);
+        used_ += need;
+        ++records_;
+        return record + PCAP_RECORD_HEADER_BYTES;
+    }
+
+    /// Records are complete once their bytes are copied
+    void Commit() {}
+
+    /// Write out the buffer and wait until everything buffered so far is on
+    /// disk (host thread, between runs); false once any write has failed
+    bool Flush();
+
+    /// Flush and close; later records are dropped
+    /// @return false if any write failed
+    bool Close(std::string& error);
+
+    const std::string& Path() const { return path_; }
+    uint32_t LinkType() const { return linkType_; }
+    uint64_t Records() const { return records_; }
+    bool Failed() const { return failed_.load(std::memory_order_relaxed); }
+
+private:
+    /// How the encoder ends a buffer: keep streaming, make everything so far
+    /// decodable, or close the compressed stream
+    enum class ChunkEnd : uint8_t { Continue, Sync, Finish };
+
+    struct Chunk {
+        std::unique_ptr<uint8_t[]> data;
+        size_t used = 0;
+        ChunkEnd end = ChunkEnd::Continue;
+    };
+
+    /// Pass on the current buffer and start the next (simulation thread)
+    bool Rotate(ChunkEnd end);
+    Chunk* AcquireChunk();
+    void Submit(Chunk* chunk);
+    void DrainBacklog();
+    void WaitIdle();
+    void EncoderLoop();
+    bool WriteAll(const uint8_t* data, size_t size);
+
+    std::string path_;
+    uint8_t* buffer_ = nullptr;  // data of current_
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    uint32_t snaplen_ = PCAP_DEFAULT_SNAPLEN;
+    uint32_t linkType_ = 0;
+    uint64_t records_ = 0;
+    bool open_ = false;
+    std::atomic<bool> failed_{false};
+
+    // Buffers are owned here; the queues pass raw pointers between threads
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    Chunk* current_ = nullptr;
+
+    // Compressed output only
+    std::unique_ptr<PcapEncoder> encoder_;
+    SpscQueue<Chunk*, PCAP_QUEUE_BUFFERS> ready_;     // simulation -> encoder
+    SpscQueue<Chunk*, PCAP_QUEUE_BUFFERS> recycled_;  // encoder -> simulation
+    std::deque<Chunk*> backlog_;                      // filled buffers waiting for room in ready_
+    uint64_t submitted_ = 0;
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;  // encoder: buffers ready (notified without the lock; waits time out)
+    std::condition_variable done_;  // host: a buffer was written
+    std::thread encoderThread_;
+
+    std::chrono::steady_clock::duration flushInterval_{};
+    std::chrono::steady_clock::time_point lastFlush_;
+
+#ifdef _WIN32
+    void* file_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_PCAP_WRITER_H
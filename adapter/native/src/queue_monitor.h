@@ -0,0 +1,189 @@
+// queue_monitor.h
+// Native queue and drop aggregation (internal to ns3shim)
+//
+// Each attached device has a set of counters and a backlog (device queue +
+// root queue disc, in packets). The backlog is a step function of time; it
+// is integrated into a ring of `windowBins` slots holding the min, max and
+// time-weighted mean per bin. As in time_bins.h, slots remember their bin
+// and are reset lazily, so memory is devices x windowBins for any run length.
+
+#ifndef NS3SHIM_QUEUE_MONITOR_H
+#define NS3SHIM_QUEUE_MONITOR_H
+
+#include "ns3shim.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ns3shim {
+
+class QueueMonitor {
+public:
+    QueueMonitor(double binWidthSec, uint32_t windowBins, ns3_queue_event_cb onEvent, void* user)
+        : binWidth_(binWidthSec), window_(windowBins), onEvent_(onEvent), user_(user) {}
+
+    double BinWidth() const { return binWidth_; }
+    uint32_t DeviceCount() const { return static_cast<uint32_t>(rows_.size()); }
+    const std::vector<uint64_t>& DeviceIds() const { return deviceIds_; }
+    ns3_queue_event_cb OnEvent() const { return onEvent_; }
+    void* User() const { return user_; }
+
+    bool HasDevice(uint64_t deviceId) const {
+        return std::find(deviceIds_.begin(), deviceIds_.end(), deviceId) != deviceIds_.end();
+    }
+
+    /// Adds a row for a device whose backlog is tracked from `nowSec`
+    uint32_t AddDevice(uint64_t deviceId, double nowSec, uint32_t queuePackets, uint32_t qdiscPackets) {
+        deviceIds_.push_back(deviceId);
+        Row row;
+        row.lastTime = nowSec;
+        row.queuePackets = queuePackets;
+        row.qdiscPackets = qdiscPackets;
+        row.counters.backlog = row.counters.maxBacklog = queuePackets + qdiscPackets;
+        rows_.push_back(row);
+        slots_.resize(slots_.size() + window_);
+        Touch(DeviceCount() - 1, BinOf(nowSec));
+        return DeviceCount() - 1;
+    }
+
+    /// Counts one event (simulation thread only)
+    void Count(uint32_t row, ns3_queue_event_kind kind, uint32_t bytes) {
+        ns3_queue_counters& c = rows_[row].counters;
+        switch (kind) {
+            case NS3_QUEUE_ENQUEUE: ++c.enqueued; return;
+            case NS3_QUEUE_DEQUEUE: ++c.dequeued; return;
+            case NS3_QUEUE_DROP: ++c.dropped; break;
+            case NS3_QDISC_ENQUEUE: ++c.qdiscEnqueued; return;
+            case NS3_QDISC_DEQUEUE: ++c.qdiscDequeued; return;
+            case NS3_QDISC_DROP: ++c.qdiscDropped; break;
+            case NS3_PHY_RX_DROP: ++c.phyRxDrops; break;
+            case NS3_MAC_TX_DROP: ++c.macTxDrops; break;
+        }
+        c.droppedBytes += bytes;
+    }
+
+    /// Records a new packet count of the device queue or the queue disc
+    void SetBacklog(uint32_t row, double timeSec, bool qdisc, uint32_t packets) {
+        Advance(row, timeSec);
+        Row& r = rows_[row];
+        (qdisc ? r.qdiscPackets : r.queuePackets) = packets;
+
+        const uint32_t backlog = r.queuePackets + r.qdiscPackets;
+        r.counters.backlog = backlog;
+        r.counters.maxBacklog = std::max(r.counters.maxBacklog, backlog);
+        Slot& slot = Touch(row, BinOf(timeSec));
+        slot.min = std::min(slot.min, backlog);
+        slot.max = std::max(slot.max, backlog);
+    }
+
+    const ns3_queue_counters& Counters(uint32_t row) const { return rows_[row].counters; }
+
+    /// Extends every backlog series to `nowSec` (call before Window/Export)
+    void AdvanceAll(double nowSec) {
+        for (uint32_t row = 0; row < DeviceCount(); ++row) Advance(row, nowSec);
+    }
+
+    /// Window reported by Export: up to windowBins bins ending at the newest
+    /// bin touched (AdvanceAll(now) makes that the bin holding `now`)
+    void Window(uint64_t& firstBin, uint32_t& binCount) const {
+        binCount = static_cast<uint32_t>(std::min<uint64_t>(window_, headBin_ + 1));
+        firstBin = headBin_ + 1 - binCount;
+    }
+
+    /// Writes the dense [device x bin] matrix (row-major) for the window
+    void Export(uint64_t firstBin, uint32_t binCount, ns3_queue_bin* out) const {
+        for (uint32_t row = 0; row < DeviceCount(); ++row) {
+            const Slot* ring = &slots_[static_cast<size_t>(row) * window_];
+            ns3_queue_bin* dst = out + static_cast<size_t>(row) * binCount;
+            for (uint32_t i = 0; i < binCount; ++i) {
+                const uint64_t bin = firstBin + i;
+                const Slot& slot = ring[bin % window_];
+                ns3_queue_bin& b = dst[i];
+                if (slot.bin != bin) {
+                    b = ns3_queue_bin{};  // before the device was attached
+                    continue;
+                }
+                b.minPackets = slot.min;
+                b.maxPackets = slot.max;
+                b.meanPackets = slot.covered > 0.0 ? slot.area / slot.covered : slot.min;
+                b.coveredSec = slot.covered;
+            }
+        }
+    }
+
+private:
+    struct Row {
+        ns3_queue_counters counters{};
+        uint32_t queuePackets = 0;
+        uint32_t qdiscPackets = 0;
+        double lastTime = 0.0;  ///< Backlog integrated up to here
+    };
+
+    struct Slot {
+        uint64_t bin = std::numeric_limits<uint64_t>::max();
+        uint32_t min = 0;
+        uint32_t max = 0;
+        double area = 0.0;     ///< Packet-seconds
+        double covered = 0.0;  ///< Seconds of the bin integrated so far
+    };
+
+    uint64_t BinOf(double timeSec) const {
+        return timeSec <= 0.0 ? 0 : static_cast<uint64_t>(timeSec / binWidth_);
+    }
+
+    // Slot for a bin of a row, reset to the row's current backlog if it held
+    // an older bin
+    Slot& Touch(uint32_t row, uint64_t bin) {
+        if (bin > headBin_) headBin_ = bin;
+        Slot& slot = slots_[static_cast<size_t>(row) * window_ + bin % window_];
+        if (slot.bin != bin) {
+            const uint32_t backlog = rows_[row].counters.backlog;
+            slot = Slot{bin, backlog, backlog, 0.0, 0.0};
+        }
+        return slot;
+    }
+
+    // Integrate the row's (constant) backlog from its last change up to t
+    void Advance(uint32_t row, double t) {
+        Row& r = rows_[row];
+        if (!(t > r.lastTime)) return;
+
+        const double backlog = r.counters.backlog;
+        const uint64_t lastBin = BinOf(t);
+        uint64_t bin = BinOf(r.lastTime);
+        // Bins older than the window would be overwritten anyway
+        if (lastBin - bin >= window_) bin = lastBin - window_ + 1;
+
+        for (; bin <= lastBin; ++bin) {
+            const double start = std::max(r.lastTime, bin * binWidth_);
+            const double end = bin == lastBin ? t : (bin + 1) * binWidth_;
+            Slot& slot = Touch(row, bin);
+            if (end > start) {
+                slot.area += backlog * (end - start);
+                slot.covered += end - start;
+            }
+        }
+        r.lastTime = t;
+    }
+
+    double binWidth_;
+    uint32_t window_;
+    ns3_queue_event_cb onEvent_;
+    void* user_;
+    uint64_t headBin_ = 0;
+    std::vector<uint64_t> deviceIds_;
+    std::vector<Row> rows_;
+    std::vector<Slot> slots_;
+};
+
+/// Trace source binding: events from one device into one monitor row
+struct QueueTap {
+    QueueMonitor* monitor;
+    uint32_t row;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_QUEUE_MONITOR_H
@@ -0,0 +1,57 @@
+// spsc_queue.h
+// Bounded single-producer/single-consumer queue (internal to ns3shim)
+//
+// A fixed ring of slots with one atomic index per side: the producer only
+// writes the tail and the consumer only writes the head, so neither side
+// ever takes a lock or waits for the other. Used to hand buffers between the
+// simulation thread and a background worker.
+
+#ifndef NS3SHIM_SPSC_QUEUE_H
+#define NS3SHIM_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace ns3shim {
+
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    SpscQueue() = default;
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Producer side; false if the queue is full
+    bool TryPush(const T& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity) return false;
+        slots_[tail & (Capacity - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side; false if the queue is empty
+    bool TryPop(T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        value = slots_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    // Separate cache lines so the two sides do not contend
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    T slots_[Capacity]{};
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_SPSC_QUEUE_H
@@ -0,0 +1,128 @@
+// summary_stats.h
+// Descriptive statistics over per-run samples (internal to ns3shim)
+//
+// Used by the parameter sweep engine to reduce replicated runs to a single
+// ns3_metric_summary: mean, sample standard deviation, Student-t confidence
+// interval half-width and order-statistic percentiles.
+
+#ifndef NS3SHIM_SUMMARY_STATS_H
+#define NS3SHIM_SUMMARY_STATS_H
+
+#include "ns3shim.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ns3shim {
+
+/// Regularized incomplete beta I_x(a, b) via Lentz's continued fraction
+inline double IncompleteBeta(double a, double b, double x) {
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+
+    // Use the symmetry relation where the continued fraction converges fastest
+    if (x > (a + 1.0) / (a + b + 2.0)) {
+        return 1.0 - IncompleteBeta(b, a, 1.0 - x);
+    }
+
+    const double lnFront = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b)
+                         + a * std::log(x) + b * std::log1p(-x);
+    const double tiny = 1e-300;
+
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    if (std::fabs(d) < tiny) d = tiny;
+    d = 1.0 / d;
+    double f = d;
+
+    for (int m = 1; m <= 300; ++m) {
+        // Even step
+        double num = m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m));
+        d = 1.0 + num * d;
+        if (std::fabs(d) < tiny) d = tiny;
+        c = 1.0 + num / c;
+        if (std::fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        f *= d * c;
+
+        // Odd step
+        num = -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0));
+        d = 1.0 + num * d;
+        if (std::fabs(d) < tiny) d = tiny;
+        c = 1.0 + num / c;
+        if (std::fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        const double delta = d * c;
+        f *= delta;
+
+        if (std::fabs(delta - 1.0) < 1e-14) break;
+    }
+
+    return std::exp(lnFront) * f / a;
+}
+
+/// Cumulative distribution function of Student's t with df degrees of freedom
+inline double StudentTCdf(double t, double df) {
+    const double x = df / (df + t * t);
+    const double tail = 0.5 * IncompleteBeta(0.5 * df, 0.5, x);
+    return t >= 0.0 ? 1.0 - tail : tail;
+}
+
+/// Inverse CDF of Student's t (bisection; p in (0, 1))
+inline double StudentTQuantile(double p, double df) {
+    double lo = -1e3;
+    double hi = 1e3;
+    for (int i = 0; i < 200; ++i) {
+        const double mid = 0.5 * (lo + hi);
+        if (StudentTCdf(mid, df) < p) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+/// Linear-interpolated percentile of an ascending sample (q in [0, 1])
+inline double Percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    const double pos = q * static_cast<double>(sorted.size() - 1);
+    const size_t lower = static_cast<size_t>(pos);
+    const size_t upper = std::min(lower + 1, sorted.size() - 1);
+    const double frac = pos - static_cast<double>(lower);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * frac;
+}
+
+/// Reduce samples to a metric summary; sorts samples in place
+inline void Summarize(std::vector<double>& samples, double confidence, ns3_metric_summary* out) {
+    *out = ns3_metric_summary{};
+    if (samples.empty()) return;
+
+    std::sort(samples.begin(), samples.end());
+    const double n = static_cast<double>(samples.size());
+
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+    const double mean = sum / n;
+
+    double sq = 0.0;
+    for (double v : samples) sq += (v - mean) * (v - mean);
+    const double stddev = samples.size() > 1 ? std::sqrt(sq / (n - 1.0)) : 0.0;
+
+    out->mean = mean;
+    out->stddev = stddev;
+    out->ciHalfWidth = samples.size() > 1
+        ? StudentTQuantile(0.5 + 0.5 * confidence, n - 1.0) * stddev / std::sqrt(n)
+        : 0.0;
+    out->min = samples.front();
+    out->p50 = Percentile(samples, 0.50);
+    out->p90 = Percentile(samples, 0.90);
+    out->p95 = Percentile(samples, 0.95);
+    out->p99 = Percentile(samples, 0.99);
+    out->max = samples.back();
+}
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_SUMMARY_STATS_H
@@ -0,0 +1,226 @@
+// tcp_bulk.h
+// Goodput, congestion window and RTT summaries of TCP bulk transfers
+// (internal to ns3shim)
+//
+// Each transfer is a row with running totals. Its congestion window and
+// latest RTT sample are step functions of time; while the transfer runs
+// they are integrated into a ring of `windowBins` slots holding the min,
+// max and time-weighted mean per bin, next to the bytes delivered in the
+// bin. As in queue_monitor.h, slots remember their bin and are reset
+// lazily, so memory is transfers x windowBins for any run length.
+
+#ifndef NS3SHIM_TCP_BULK_H
+#define NS3SHIM_TCP_BULK_H
+
+#include "ns3shim.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ns3shim {
+
+class TcpBulkMonitor {
+public:
+    TcpBulkMonitor(double binWidthSec, uint32_t windowBins) : binWidth_(binWidthSec), window_(windowBins) {}
+
+    double BinWidth() const { return binWidth_; }
+    uint32_t FlowCount() const { return static_cast<uint32_t>(rows_.size()); }
+
+    /// Adds a pending transfer of `bytes` (0 = unlimited)
+    uint32_t AddFlow(uint64_t bytes) {
+        Row row;
+        row.bytes = bytes;
+        row.stats.startSec = row.stats.firstRxSec = row.stats.lastRxSec = row.stats.completeSec = -1.0;
+        rows_.push_back(row);
+        slots_.resize(slots_.size() + window_);
+        return FlowCount() - 1;
+    }
+
+    /// The sender started at `timeSec`
+    void Begin(uint32_t row, double timeSec) {
+        Row& r = rows_[row];
+        if (r.stats.state != NS3_TCP_FLOW_PENDING) return;
+        r.stats.state = NS3_TCP_FLOW_RUNNING;
+        r.stats.startSec = r.lastTime = timeSec;
+        Touch(row, BinOf(timeSec));
+    }
+
+    /// The sender's socket runs `congestionControl` (ns3_tcp_cc), paced or not
+    void SetSocket(uint32_t row, uint16_t congestionControl, bool pacing) {
+        rows_[row].stats.congestionControl = congestionControl;
+        rows_[row].stats.pacing = pacing ? 1 : 0;
+    }
+
+    /// The transfer ended at `timeSec` without completing (FAILED or STOPPED)
+    void End(uint32_t row, double timeSec, ns3_tcp_flow_state state) {
+        if (rows_[row].stats.state != NS3_TCP_FLOW_RUNNING) return;
+        Advance(row, timeSec);
+        rows_[row].stats.state = state;
+    }
+
+    void AddTx(uint32_t row, uint32_t bytes) { rows_[row].stats.txBytes += bytes; }
+
+    /// Counts bytes delivered to the receiver; completes a finite transfer
+    void AddRx(uint32_t row, double timeSec, uint32_t bytes) {
+        Row& r = rows_[row];
+        ns3_tcp_flow_stats& s = r.stats;
+        Advance(row, timeSec);
+        s.rxBytes += bytes;
+        if (s.firstRxSec < 0.0) s.firstRxSec = timeSec;
+        s.lastRxSec = timeSec;
+        if (s.state == NS3_TCP_FLOW_RUNNING) Touch(row, BinOf(timeSec)).rxBytes += bytes;
+        if (s.state == NS3_TCP_FLOW_RUNNING && r.bytes != 0 && s.rxBytes >= r.bytes) {
+            s.state = NS3_TCP_FLOW_COMPLETE;
+            s.completeSec = timeSec;
+        }
+    }
+
+    /// Records a new congestion window (bytes)
+    void SetCwnd(uint32_t row, double timeSec, uint32_t cwnd) {
+        Row& r = rows_[row];
+        if (r.stats.state != NS3_TCP_FLOW_RUNNING) return;
+        Advance(row, timeSec);
+        r.stats.cwndBytes = cwnd;
+        r.stats.maxCwndBytes = std::max(r.stats.maxCwndBytes, cwnd);
+        Slot& slot = Touch(row, BinOf(timeSec));
+        slot.cwndMin = std::min(slot.cwndMin, cwnd);
+        slot.cwndMax = std::max(slot.cwndMax, cwnd);
+    }
+
+    /// Records a new RTT sample (seconds)
+    void SetRtt(uint32_t row, double timeSec, double rttSec) {
+        Row& r = rows_[row];
+        if (r.stats.state != NS3_TCP_FLOW_RUNNING || !(rttSec > 0.0)) return;
+        Advance(row, timeSec);
+        r.stats.rttSec = rttSec;
+        if (r.stats.minRttSec == 0.0 || rttSec < r.stats.minRttSec) r.stats.minRttSec = rttSec;
+        Slot& slot = Touch(row, BinOf(timeSec));
+        if (slot.rttMin == 0.0 || rttSec < slot.rttMin) slot.rttMin = rttSec;
+        slot.rttMax = std::max(slot.rttMax, rttSec);
+    }
+
+    /// Totals of a row, with goodput up to `nowSec` while incomplete
+    ns3_tcp_flow_stats Stats(uint32_t row, double nowSec) const {
+        ns3_tcp_flow_stats s = rows_[row].stats;
+        const double end = s.completeSec >= 0.0 ? s.completeSec : nowSec;
+        s.goodputBps = s.startSec >= 0.0 && end > s.startSec ? s.rxBytes * 8.0 / (end - s.startSec) : 0.0;
+        return s;
+    }
+
+    /// Extends every running transfer to `nowSec` (call before Window/Export)
+    void AdvanceAll(double nowSec) {
+        for (uint32_t row = 0; row < FlowCount(); ++row) Advance(row, nowSec);
+    }
+
+    /// Window reported by Export: up to windowBins bins ending at the newest
+    /// bin touched (AdvanceAll(now) makes that the bin holding `now` while
+    /// any transfer runs)
+    void Window(uint64_t& firstBin, uint32_t& binCount) const {
+        binCount = static_cast<uint32_t>(std::min<uint64_t>(window_, headBin_ + 1));
+        firstBin = headBin_ + 1 - binCount;
+    }
+
+    /// Writes the dense [transfer x bin] matrix (row-major) for the window
+    void Export(uint64_t firstBin, uint32_t binCount, ns3_tcp_bin* out) const {
+        for (uint32_t row = 0; row < FlowCount(); ++row) {
+            const Slot* ring = &slots_[static_cast<size_t>(row) * window_];
+            ns3_tcp_bin* dst = out + static_cast<size_t>(row) * binCount;
+            for (uint32_t i = 0; i < binCount; ++i) {
+                const uint64_t bin = firstBin + i;
+                const Slot& slot = ring[bin % window_];
+                ns3_tcp_bin& b = dst[i];
+                if (slot.bin != bin) {
+                    b = ns3_tcp_bin{};  // transfer not running
+                    continue;
+                }
+                b.rxBytes = slot.rxBytes;
+                b.cwndMinBytes = slot.cwndMin;
+                b.cwndMaxBytes = slot.cwndMax;
+                b.cwndMeanBytes = slot.covered > 0.0 ? slot.cwndArea / slot.covered : slot.cwndMin;
+                b.rttMinSec = slot.rttMin;
+                b.rttMaxSec = slot.rttMax;
+                b.rttMeanSec = slot.rttCovered > 0.0 ? slot.rttArea / slot.rttCovered : slot.rttMin;
+                b.coveredSec = slot.covered;
+            }
+        }
+    }
+
+private:
+    struct Row {
+        ns3_tcp_flow_stats stats{};
+        uint64_t bytes = 0;     ///< Transfer size (0 = unlimited)
+        double lastTime = 0.0;  ///< Series integrated up to here
+    };
+
+    struct Slot {
+        uint64_t bin = std::numeric_limits<uint64_t>::max();
+        uint64_t rxBytes = 0;
+        uint32_t cwndMin = 0;
+        uint32_t cwndMax = 0;
+        double cwndArea = 0.0;    ///< Byte-seconds
+        double covered = 0.0;     ///< Seconds of the bin integrated so far
+        double rttMin = 0.0;      ///< 0 = no sample in effect yet
+        double rttMax = 0.0;
+        double rttArea = 0.0;     ///< Seconds-seconds, while a sample is in effect
+        double rttCovered = 0.0;
+    };
+
+    uint64_t BinOf(double timeSec) const {
+        return timeSec <= 0.0 ? 0 : static_cast<uint64_t>(timeSec / binWidth_);
+    }
+
+    // Slot for a bin of a row, reset to the row's current values if it held
+    // an older bin
+    Slot& Touch(uint32_t row, uint64_t bin) {
+        if (bin > headBin_) headBin_ = bin;
+        Slot& slot = slots_[static_cast<size_t>(row) * window_ + bin % window_];
+        if (slot.bin != bin) {
+            const ns3_tcp_flow_stats& s = rows_[row].stats;
+            slot = Slot{};
+            slot.bin = bin;
+            slot.cwndMin = slot.cwndMax = s.cwndBytes;
+            slot.rttMin = slot.rttMax = s.rttSec;
+        }
+        return slot;
+    }
+
+    // Integrate a running row's (constant) cwnd and RTT from its last change up to t
+    void Advance(uint32_t row, double t) {
+        Row& r = rows_[row];
+        if (r.stats.state != NS3_TCP_FLOW_RUNNING || !(t > r.lastTime)) return;
+
+        const double cwnd = r.stats.cwndBytes;
+        const double rtt = r.stats.rttSec;
+        const uint64_t lastBin = BinOf(t);
+        uint64_t bin = BinOf(r.lastTime);
+        // Bins older than the window would be overwritten anyway
+        if (lastBin - bin >= window_) bin = lastBin - window_ + 1;
+
+        for (; bin <= lastBin; ++bin) {
+            const double start = std::max(r.lastTime, bin * binWidth_);
+            const double end = bin == lastBin ? t : (bin + 1) * binWidth_;
+            Slot& slot = Touch(row, bin);
+            if (end > start) {
+                slot.cwndArea += cwnd * (end - start);
+                slot.covered += end - start;
+                if (rtt > 0.0) {
+                    slot.rttArea += rtt * (end - start);
+                    slot.rttCovered += end - start;
+                }
+            }
+        }
+        r.lastTime = t;
+    }
+
+    double binWidth_;
+    uint32_t window_;
+    uint64_t headBin_ = 0;
+    std::vector<Row> rows_;
+    std::vector<Slot> slots_;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_TCP_BULK_H
@@ -0,0 +1,126 @@
+// tdigest.h
+// Streaming quantile sketch (internal to ns3shim)
+//
+// Merging t-digest (Dunning & Ertl) with the k1 scale function. Values are
+// buffered and periodically merged into at most ~compression/2 centroids
+// whose size shrinks toward both tails, so extreme quantiles stay accurate
+// while memory is bounded by the compression, not by the number of values.
+
+#ifndef NS3SHIM_TDIGEST_H
+#define NS3SHIM_TDIGEST_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace ns3shim {
+
+constexpr double TDIGEST_DEFAULT_COMPRESSION = 100.0;
+constexpr double TDIGEST_PI = 3.14159265358979323846;
+
+class TDigest {
+public:
+    explicit TDigest(double compression = TDIGEST_DEFAULT_COMPRESSION)
+        : compression_(compression > 0.0 ? compression : TDIGEST_DEFAULT_COMPRESSION),
+          bufferLimit_(static_cast<size_t>(compression_ * 5)) {
+        buffer_.reserve(bufferLimit_);
+    }
+
+    /// Add a value (non-finite values are ignored)
+    void Add(double x, double weight = 1.0) {
+        if (!std::isfinite(x) || !(weight > 0.0)) return;
+        buffer_.push_back({x, weight});
+        total_ += weight;
+        min_ = std::min(min_, x);
+        max_ = std::max(max_, x);
+        if (buffer_.size() >= bufferLimit_) Compress();
+    }
+
+    double Count() const { return total_; }
+
+    /// Estimated value at quantile q in [0, 1]; 0 when empty
+    double Quantile(double q) {
+        Compress();
+        if (centroids_.empty()) return 0.0;
+        if (centroids_.size() == 1) return centroids_[0].mean;
+
+        const double index = std::clamp(q, 0.0, 1.0) * total_;
+        const Centroid& first = centroids_.front();
+        if (index < first.weight / 2) {
+            return min_ + (first.mean - min_) * (index / (first.weight / 2));
+        }
+
+        // Interpolate between the centers of neighbouring centroids
+        double before = 0.0;
+        for (size_t i = 0; i + 1 < centroids_.size(); ++i) {
+            const Centroid& a = centroids_[i];
+            const Centroid& b = centroids_[i + 1];
+            const double left = before + a.weight / 2;
+            const double right = before + a.weight + b.weight / 2;
+            if (index <= right) {
+                const double t = right > left ? (index - left) / (right - left) : 0.0;
+                return a.mean + t * (b.mean - a.mean);
+            }
+            before += a.weight;
+        }
+
+        const Centroid& last = centroids_.back();
+        const double left = total_ - last.weight / 2;
+        const double t = last.weight > 0.0 ? (index - left) / (last.weight / 2) : 1.0;
+        return std::min(max_, last.mean + std::clamp(t, 0.0, 1.0) * (max_ - last.mean));
+    }
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    // k1 scale: centroid size limit in q space
+    double K(double q) const { return compression_ / (2 * TDIGEST_PI) * std::asin(2 * q - 1); }
+    double Q(double k) const {
+        const double kMax = compression_ / 4;
+        if (k >= kMax) return 1.0;
+        return (std::sin(k * 2 * TDIGEST_PI / compression_) + 1) / 2;
+    }
+
+    void Compress() {
+        if (buffer_.empty()) return;
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end(),
+                  [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+        centroids_.clear();
+
+        double weightBefore = 0.0;
+        double weightLimit = total_ * Q(K(0.0) + 1);
+        Centroid current = buffer_.front();
+        for (size_t i = 1; i < buffer_.size(); ++i) {
+            const Centroid& next = buffer_[i];
+            if (weightBefore + current.weight + next.weight <= weightLimit) {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean) * next.weight / current.weight;
+            } else {
+                weightBefore += current.weight;
+                centroids_.push_back(current);
+                weightLimit = total_ * Q(K(weightBefore / total_) + 1);
+                current = next;
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+    double compression_;
+    size_t bufferLimit_;
+    std::vector<Centroid> buffer_;
+    std::vector<Centroid> centroids_;
+    double total_ = 0.0;
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_TDIGEST_H
@@ -0,0 +1,108 @@
+// time_bins.h
+// Rolling per-device time-bin accumulators (internal to ns3shim)
+//
+// Each attached device owns a ring of `windowBins` slots; an event at time t
+// lands in bin floor(t / binWidth), slot bin % windowBins. Slots remember the
+// bin they hold and are reset lazily when the ring wraps, so recording is a
+// handful of adds with no per-bin sweep and memory stays at
+// devices x windowBins regardless of run length.
+
+#ifndef NS3SHIM_TIME_BINS_H
+#define NS3SHIM_TIME_BINS_H
+
+#include "ns3shim.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ns3shim {
+
+class TimeBinAccumulator {
+public:
+    TimeBinAccumulator(double binWidthSec, uint32_t windowBins)
+        : binWidth_(binWidthSec), window_(windowBins) {}
+
+    double BinWidth() const { return binWidth_; }
+    uint32_t DeviceCount() const { return static_cast<uint32_t>(deviceIds_.size()); }
+    const std::vector<uint64_t>& DeviceIds() const { return deviceIds_; }
+
+    bool HasDevice(uint64_t deviceId) const {
+        return std::find(deviceIds_.begin(), deviceIds_.end(), deviceId) != deviceIds_.end();
+    }
+
+    /// Adds a matrix row for a device and returns its index
+    uint32_t AddDevice(uint64_t deviceId) {
+        deviceIds_.push_back(deviceId);
+        slots_.resize(slots_.size() + window_);
+        return DeviceCount() - 1;
+    }
+
+    /// Records one packet (simulation thread only; simulation time never
+    /// decreases, so an event is never older than the window)
+    void Add(uint32_t row, double timeSec, uint32_t bytes, bool rx) {
+        const uint64_t bin = BinOf(timeSec);
+        if (bin > headBin_) headBin_ = bin;
+
+        Slot& slot = slots_[static_cast<size_t>(row) * window_ + bin % window_];
+        if (slot.bin != bin) {
+            slot.bin = bin;
+            slot.counts = ns3_bin_counts{};
+        }
+        if (rx) {
+            slot.counts.rxBytes += bytes;
+            ++slot.counts.rxPackets;
+        } else {
+            slot.counts.txBytes += bytes;
+            ++slot.counts.txPackets;
+        }
+    }
+
+    /// Window reported by Export: up to windowBins bins ending at the later of
+    /// the newest event and `nowSec`, so idle trailing bins show as zero
+    void Window(double nowSec, uint64_t& firstBin, uint32_t& binCount) const {
+        const uint64_t head = std::max(headBin_, BinOf(nowSec));
+        binCount = static_cast<uint32_t>(std::min<uint64_t>(window_, head + 1));
+        firstBin = head + 1 - binCount;
+    }
+
+    /// Writes the dense [device x bin] matrix (row-major) for the window
+    void Export(uint64_t firstBin, uint32_t binCount, ns3_bin_counts* out) const {
+        for (uint32_t row = 0; row < DeviceCount(); ++row) {
+            const Slot* ring = &slots_[static_cast<size_t>(row) * window_];
+            ns3_bin_counts* dst = out + static_cast<size_t>(row) * binCount;
+            for (uint32_t i = 0; i < binCount; ++i) {
+                const uint64_t bin = firstBin + i;
+                const Slot& slot = ring[bin % window_];
+                dst[i] = slot.bin == bin ? slot.counts : ns3_bin_counts{};
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        uint64_t bin = std::numeric_limits<uint64_t>::max();
+        ns3_bin_counts counts{};
+    };
+
+    uint64_t BinOf(double timeSec) const {
+        return timeSec <= 0.0 ? 0 : static_cast<uint64_t>(timeSec / binWidth_);
+    }
+
+    double binWidth_;
+    uint32_t window_;
+    uint64_t headBin_ = 0;
+    std::vector<uint64_t> deviceIds_;
+    std::vector<Slot> slots_;
+};
+
+/// Trace source binding: events from one device into one accumulator row
+struct TimeBinTap {
+    TimeBinAccumulator* accumulator;
+    uint32_t row;
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_TIME_BINS_H
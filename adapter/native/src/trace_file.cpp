@@ -0,0 +1,289 @@
+// trace_file.cpp
+// Columnar packet trace file writer (see trace_file.h for the file format)
+
+#include "trace_file.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ns3shim {
+
+namespace {
+
+struct ColumnDesc {
+    const char* name;
+    TraceColumnType type;
+    uint8_t width;
+};
+
+constexpr ColumnDesc COLUMNS[TRACE_COL_COUNT] = {
+    {"time_s", TraceColumnType::F64, 8},
+    {"device", TraceColumnType::U64, 8},
+    {"size", TraceColumnType::U32, 4},
+    {"direction", TraceColumnType::U8, 1},
+    {"uid", TraceColumnType::U64, 8},
+    {"protocol", TraceColumnType::U8, 1},
+    {"ttl", TraceColumnType::U8, 1},
+    {"src_addr", TraceColumnType::U32, 4},
+    {"dst_addr", TraceColumnType::U32, 4},
+    {"src_port", TraceColumnType::U16, 2},
+    {"dst_port", TraceColumnType::U16, 2},
+};
+
+size_t AlignUp(size_t n) {
+    return (n + TRACE_FILE_ALIGNMENT - 1) / TRACE_FILE_ALIGNMENT * TRACE_FILE_ALIGNMENT;
+}
+
+size_t ChunkBytes(uint32_t column, uint32_t rows) {
+    return AlignUp(static_cast<size_t>(rows) * COLUMNS[column].width);
+}
+
+// Chunk offsets of a full block within its image
+size_t FullChunkOffset(uint32_t column) {
+    size_t offset = 0;
+    for (uint32_t c = 0; c < column; ++c) offset += ChunkBytes(c, TRACE_FILE_BLOCK_ROWS);
+    return offset;
+}
+
+template <typename T>
+void Put(std::vector<uint8_t>& out, T v) {
+    const auto* p = reinterpret_cast<const uint8_t*>(&v);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+} // anonymous namespace
+
+TraceFileWriter::~TraceFileWriter() {
+    std::string ignored;
+    Close(ignored);
+}
+
+bool TraceFileWriter::Open(const std::string& path, bool direct, bool headers, std::string& error) {
+    if (open_) {
+        error = "trace file already open";
+        return false;
+    }
+
+    columnCount_ = headers ? TRACE_COL_COUNT : TRACE_BASE_COLUMNS;
+    blockBytes_ = FullChunkOffset(columnCount_);
+    for (int i = 0; i < 2; ++i) {
+        storage_[i].assign(blockBytes_ + TRACE_FILE_ALIGNMENT, 0);
+        auto base = reinterpret_cast<uintptr_t>(storage_[i].data());
+        blocks_[i] = reinterpret_cast<uint8_t*>(AlignUp(base));
+    }
+
+#ifdef _WIN32
+    direct = false;
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "cannot create trace file '" + path + "'";
+        return false;
+    }
+    file_ = file;
+#else
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+    if (direct) {
+        fd_ = ::open(path.c_str(), flags | O_DIRECT, 0644);
+        // tmpfs and some network filesystems reject O_DIRECT
+        if (fd_ < 0 && errno == EINVAL) direct = false;
+    }
+#else
+    direct = false;
+#endif
+    if (fd_ < 0) {
+        direct = false;
+        fd_ = ::open(path.c_str(), flags, 0644);
+    }
+    if (fd_ < 0) {
+        error = "cannot create trace file '" + path + "': " + std::strerror(errno);
+        return false;
+    }
+#endif
+    direct_ = direct;
+
+    // Header occupies the first aligned page; block 0's image is still free
+    uint8_t* header = blocks_[0];
+    std::memset(header, 0, TRACE_FILE_ALIGNMENT);
+    std::vector<uint8_t> h;
+    h.insert(h.end(), TRACE_FILE_MAGIC, TRACE_FILE_MAGIC + 4);
+    Put<uint16_t>(h, TRACE_FILE_VERSION);
+    Put<uint16_t>(h, static_cast<uint16_t>(columnCount_));
+    Put<uint32_t>(h, TRACE_FILE_BLOCK_ROWS);
+    Put<uint32_t>(h, TRACE_FILE_ALIGNMENT);
+    for (uint32_t c = 0; c < columnCount_; ++c) {
+        const ColumnDesc& col = COLUMNS[c];
+        char name[16] = {};
+        std::strncpy(name, col.name, sizeof(name) - 1);
+        h.insert(h.end(), name, name + sizeof(name));
+        Put<uint8_t>(h, static_cast<uint8_t>(col.type));
+        Put<uint8_t>(h, col.width);
+        Put<uint16_t>(h, 0);
+    }
+    std::memcpy(header, h.data(), h.size());
+    if (!WriteAll(header, TRACE_FILE_ALIGNMENT)) {
+        error = "cannot write trace file header";
+#ifdef _WIN32
+        std::fclose(static_cast<std::FILE*>(file_));
+        file_ = nullptr;
+#else
+        ::close(fd_);
+        fd_ = -1;
+#endif
+        return false;
+    }
+
+    fileOffset_ = TRACE_FILE_ALIGNMENT;
+    totalRows_ = 0;
+    index_.clear();
+    active_ = 0;
+    BindColumns(blocks_[active_]);
+    stopping_ = false;
+    failed_ = false;
+    pending_ = nullptr;
+    writer_ = std::thread(&TraceFileWriter::WriterLoop, this);
+    open_ = true;
+    return true;
+}
+
+void TraceFileWriter::BindColumns(uint8_t* block) {
+    for (uint32_t c = 0; c < columnCount_; ++c) column_[c] = block + FullChunkOffset(c);
+    rows_ = 0;
+    minTime_ = HUGE_VAL;
+    maxTime_ = -HUGE_VAL;
+}
+
+void TraceFileWriter::Submit() {
+    uint8_t* block = blocks_[active_];
+
+    BlockInfo info{};
+    info.firstRow = totalRows_;
+    info.rows = rows_;
+    info.minTimeSec = minTime_;
+    info.maxTimeSec = maxTime_;
+
+    // A short (final) block is compacted so that it stays dense on disk
+    size_t bytes = 0;
+    for (uint32_t c = 0; c < columnCount_; ++c) {
+        const size_t used = static_cast<size_t>(rows_) * COLUMNS[c].width;
+        if (rows_ != TRACE_FILE_BLOCK_ROWS) {
+            std::memmove(block + bytes, column_[c], used);
+            std::memset(block + bytes + used, 0, ChunkBytes(c, rows_) - used);
+        }
+        info.offsets[c] = fileOffset_ + bytes;
+        bytes += ChunkBytes(c, rows_);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return pending_ == nullptr; });
+        pending_ = block;
+        pendingBytes_ = bytes;
+    }
+    cv_.notify_all();
+
+    index_.push_back(info);
+    fileOffset_ += bytes;
+    totalRows_ += rows_;
+    active_ ^= 1;
+    BindColumns(blocks_[active_]);
+}
+
+void TraceFileWriter::WriterLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return pending_ != nullptr || stopping_; });
+        if (!pending_) return;
+
+        const uint8_t* data = pending_;
+        const size_t size = pendingBytes_;
+        lock.unlock();
+        const bool ok = WriteAll(data, size);
+        lock.lock();
+
+        if (!ok) failed_ = true;
+        pending_ = nullptr;
+        cv_.notify_all();
+    }
+}
+
+bool TraceFileWriter::WriteAll(const uint8_t* data, size_t size) {
+#ifdef _WIN32
+    return std::fwrite(data, 1, size, static_cast<std::FILE*>(file_)) == size;
+#else
+    while (size > 0) {
+        const ssize_t n = ::write(fd_, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+#endif
+}
+
+bool TraceFileWriter::Close(std::string& error) {
+    if (!open_) return true;
+
+    if (rows_ > 0 && writer_.joinable()) Submit();
+    if (writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        writer_.join();
+    }
+    open_ = false;
+
+    bool ok = !failed_;
+
+#if !defined(_WIN32) && defined(O_DIRECT)
+    // The footer is not block sized; finish with ordinary writes
+    if (direct_ && fd_ >= 0) {
+        const int flags = ::fcntl(fd_, F_GETFL);
+        if (flags >= 0) ::fcntl(fd_, F_SETFL, flags & ~O_DIRECT);
+    }
+#endif
+
+    std::vector<uint8_t> footer;
+    Put<uint64_t>(footer, totalRows_);
+    Put<uint32_t>(footer, static_cast<uint32_t>(index_.size()));
+    Put<uint32_t>(footer, 0);
+    for (const BlockInfo& b : index_) {
+        Put<uint64_t>(footer, b.firstRow);
+        Put<uint32_t>(footer, b.rows);
+        Put<uint32_t>(footer, 0);
+        Put<double>(footer, b.minTimeSec);
+        Put<double>(footer, b.maxTimeSec);
+        for (uint32_t c = 0; c < columnCount_; ++c) Put<uint64_t>(footer, b.offsets[c]);
+    }
+    const auto footerSize = static_cast<uint32_t>(footer.size());
+    Put<uint64_t>(footer, fileOffset_);
+    Put<uint32_t>(footer, footerSize);
+    footer.insert(footer.end(), TRACE_FILE_MAGIC, TRACE_FILE_MAGIC + 4);
+
+    if (ok) ok = WriteAll(footer.data(), footer.size());
+
+#ifdef _WIN32
+    if (file_ && std::fclose(static_cast<std::FILE*>(file_)) != 0) ok = false;
+    file_ = nullptr;
+#else
+    if (fd_ >= 0 && ::close(fd_) != 0) ok = false;
+    fd_ = -1;
+#endif
+
+    if (!ok) error = "trace file write failed";
+    return ok;
+}
+
+} // namespace ns3shim
@@ -0,0 +1,178 @@
+// trace_file.h
+// Columnar packet trace file writer (internal to ns3shim)
+//
+// Packet events are appended to per-column arrays and written in blocks,
+// so capture costs a few stores per packet and analysis tools can mmap a
+// single column without touching the others.
+//
+// File layout (little-endian):
+//
+//   header   TRACE_FILE_ALIGNMENT bytes: "NS3T" | u16 version | u16 columnCount
+//            | u32 blockRows | u32 alignment | columnCount x column descriptor
+//            (char name[16] | u8 type | u8 width | u16 reserved), zero padded
+//   block*   one chunk per column, in column order; every chunk starts on an
+//            alignment boundary and holds `rows` values of that column
+//   footer   u64 rowCount | u32 blockCount | u32 reserved
+//            | blockCount x (u64 firstRow | u32 rows | u32 reserved
+//              | f64 minTimeSec | f64 maxTimeSec | columnCount x u64 offset)
+//   trailer  u64 footerOffset | u32 footerSize | "NS3T"
+//
+// A reader seeks to the last 16 bytes, loads the footer, and maps the chunks
+// of the columns it needs. Files without a trailer were not closed and hold
+// no index. The five base columns are always present; files opened with
+// header columns append six more (see TraceColumn), and readers should
+// locate columns by name.
+
+#ifndef NS3SHIM_TRACE_FILE_H
+#define NS3SHIM_TRACE_FILE_H
+
+#include "packet_filter.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3shim {
+
+constexpr char     TRACE_FILE_MAGIC[4]    = {'N', 'S', '3', 'T'};
+constexpr uint16_t TRACE_FILE_VERSION     = 1;
+constexpr uint32_t TRACE_FILE_ALIGNMENT   = 4096;  // O_DIRECT-safe on common filesystems
+constexpr uint32_t TRACE_FILE_BLOCK_ROWS  = 65536;
+
+/// Column value types; values are part of the file format
+enum class TraceColumnType : uint8_t {
+    F64 = 1,
+    U64 = 2,
+    U32 = 3,
+    U8  = 4,
+    U16 = 5,
+};
+
+/// Packet event columns, in file order
+enum TraceColumn : uint32_t {
+    TRACE_COL_TIME,       ///< f64 simulation time (seconds)
+    TRACE_COL_DEVICE,     ///< u64 device handle id
+    TRACE_COL_SIZE,       ///< u32 packet size (bytes)
+    TRACE_COL_DIRECTION,  ///< u8 0 = transmit, 1 = receive
+    TRACE_COL_UID,        ///< u64 ns-3 packet uid
+    TRACE_COL_PROTOCOL,   ///< u8 IP protocol number (0 if not IPv4)    [header columns]
+    TRACE_COL_TTL,        ///< u8 IPv4 TTL                              [header columns]
+    TRACE_COL_SRC_ADDR,   ///< u32 IPv4 source, host byte order         [header columns]
+    TRACE_COL_DST_ADDR,   ///< u32 IPv4 destination, host byte order    [header columns]
+    TRACE_COL_SRC_PORT,   ///< u16 TCP/UDP source port                  [header columns]
+    TRACE_COL_DST_PORT,   ///< u16 TCP/UDP destination port             [header columns]
+    TRACE_COL_COUNT
+};
+
+constexpr uint32_t TRACE_BASE_COLUMNS = TRACE_COL_PROTOCOL;
+
+/// Append-only columnar writer; one background thread performs the I/O
+class TraceFileWriter {
+public:
+    TraceFileWriter() = default;
+    ~TraceFileWriter();
+
+    TraceFileWriter(const TraceFileWriter&) = delete;
+    TraceFileWriter& operator=(const TraceFileWriter&) = delete;
+
+    /// Create (truncate) the file and start the writer thread
+    /// @param direct Request O_DIRECT (Linux); falls back to buffered I/O if unsupported
+    /// @param headers Add the header columns
+    bool Open(const std::string& path, bool direct, bool headers, std::string& error);
+
+    /// Record one packet event (simulation thread only); `headers` is read
+    /// only when the file has header columns
+    void Append(double timeSec, uint64_t deviceId, uint32_t size, uint8_t direction, uint64_t uid,
+                const PacketHeaders& headers) {
+        if (!open_) return;
+        const uint32_t row = rows_++;
+        reinterpret_cast<double*>(column_[TRACE_COL_TIME])[row] = timeSec;
+        reinterpret_cast<uint64_t*>(column_[TRACE_COL_DEVICE])[row] = deviceId;
+        reinterpret_cast<uint32_t*>(column_[TRACE_COL_SIZE])[row] = size;
+        column_[TRACE_COL_DIRECTION][row] = direction;
+        reinterpret_cast<uint64_t*>(column_[TRACE_COL_UID])[row] = uid;
+        if (columnCount_ > TRACE_BASE_COLUMNS) {
+            column_[TRACE_COL_PROTOCOL][row] = headers.protocol;
+            column_[TRACE_COL_TTL][row] = headers.ttl;
+            reinterpret_cast<uint32_t*>(column_[TRACE_COL_SRC_ADDR])[row] = headers.srcAddr;
+            reinterpret_cast<uint32_t*>(column_[TRACE_COL_DST_ADDR])[row] = headers.dstAddr;
+            reinterpret_cast<uint16_t*>(column_[TRACE_COL_SRC_PORT])[row] = headers.srcPort;
+            reinterpret_cast<uint16_t*>(column_[TRACE_COL_DST_PORT])[row] = headers.dstPort;
+        }
+        if (timeSec < minTime_) minTime_ = timeSec;
+        if (timeSec > maxTime_) maxTime_ = timeSec;
+        if (rows_ == TRACE_FILE_BLOCK_ROWS) Submit();
+    }
+
+    /// Write the pending block, footer and trailer; later appends are dropped
+    /// @return false if any write failed
+    bool Close(std::string& error);
+
+    bool IsOpen() const { return open_; }
+    bool IsDirect() const { return direct_; }
+    bool HasHeaders() const { return columnCount_ > TRACE_BASE_COLUMNS; }
+    uint64_t RowCount() const { return totalRows_ + rows_; }
+
+private:
+    struct BlockInfo {
+        uint64_t firstRow;
+        uint32_t rows;
+        double minTimeSec;
+        double maxTimeSec;
+        uint64_t offsets[TRACE_COL_COUNT];  ///< First columnCount_ used
+    };
+
+    void Submit();
+    void WriterLoop();
+    bool WriteAll(const uint8_t* data, size_t size);
+    void BindColumns(uint8_t* block);
+
+    // Two block images laid out as on disk; one fills while the other is written
+    std::vector<uint8_t> storage_[2];
+    uint8_t* blocks_[2] = {nullptr, nullptr};
+    size_t blockBytes_ = 0;
+    int active_ = 0;
+    uint32_t columnCount_ = TRACE_BASE_COLUMNS;
+
+    uint8_t* column_[TRACE_COL_COUNT] = {};
+    uint32_t rows_ = 0;
+    double minTime_ = 0.0;
+    double maxTime_ = 0.0;
+
+    bool open_ = false;
+    bool direct_ = false;
+    uint64_t totalRows_ = 0;
+    uint64_t fileOffset_ = 0;
+    std::vector<BlockInfo> index_;
+
+#ifdef _WIN32
+    void* file_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+
+    // Hand-off to the writer thread
+    std::thread writer_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    const uint8_t* pending_ = nullptr;
+    size_t pendingBytes_ = 0;
+    bool stopping_ = false;
+    bool failed_ = false;
+};
+
+struct DeviceFilter;
+
+/// Trace source binding: events from one device into one writer
+struct TraceFileTap {
+    TraceFileWriter* writer;
+    uint64_t deviceId;
+    const DeviceFilter* filter;  ///< Device trace filter slot (packet_filter.h)
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_TRACE_FILE_H
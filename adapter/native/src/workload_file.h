@@ -0,0 +1,119 @@
+// workload_file.h
+// Flow workload file reader (internal to ns3shim)
+//
+// A workload is a list of finite transfers sorted by start time, in native
+// byte order:
+//
+//   header  "NS3W" | u16 version | u16 recordBytes | u64 recordCount
+//   record  f64 startSec | u32 src | u32 dst | u64 bytes
+//
+// src and dst index the node array given to workload_open. The file is
+// memory-mapped and decoded one record at a time as start times come due;
+// pages already consumed are released as the reader moves on, so resident
+// memory does not grow with the length of the workload.
+
+#ifndef NS3SHIM_WORKLOAD_FILE_H
+#define NS3SHIM_WORKLOAD_FILE_H
+
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace ns3shim {
+
+constexpr char     WORKLOAD_MAGIC[4]        = {'N', 'S', '3', 'W'};
+constexpr uint16_t WORKLOAD_VERSION         = 1;
+constexpr uint32_t WORKLOAD_HEADER_BYTES    = 16;
+constexpr uint32_t WORKLOAD_RECORD_BYTES    = 24;
+constexpr size_t   WORKLOAD_DISCARD_BYTES   = 4u << 20;  ///< Consumed bytes released at a time
+
+/// One transfer of a workload
+struct WorkloadRecord {
+    double startSec;
+    uint32_t src;    ///< Index of the sending node
+    uint32_t dst;    ///< Index of the receiving node
+    uint64_t bytes;  ///< Payload bytes to transfer
+};
+
+class WorkloadReader {
+public:
+    /// Map and validate a workload file
+    bool Open(const std::string& path, std::string& error) {
+        if (!file_.Open(path, error)) return false;
+
+        char magic[4];
+        uint16_t version = 0;
+        uint16_t recordBytes = 0;
+        const uint8_t* p = file_.Data();
+        if (file_.Size() >= WORKLOAD_HEADER_BYTES) {
+            std::memcpy(magic, p, 4);
+            std::memcpy(&version, p + 4, 2);
+            std::memcpy(&recordBytes, p + 6, 2);
+            std::memcpy(&count_, p + 8, 8);
+        }
+        if (file_.Size() < WORKLOAD_HEADER_BYTES || std::memcmp(magic, WORKLOAD_MAGIC, 4) != 0) {
+            error = "'" + path + "' is not a workload file";
+        } else if (version != WORKLOAD_VERSION || recordBytes != WORKLOAD_RECORD_BYTES) {
+            error = "'" + path + "' has unsupported workload version " + std::to_string(version);
+        } else if (count_ > (file_.Size() - WORKLOAD_HEADER_BYTES) / WORKLOAD_RECORD_BYTES) {
+            error = "'" + path + "' is truncated: header promises " + std::to_string(count_) + " records";
+        } else {
+            next_ = 0;
+            released_ = 0;
+            return true;
+        }
+        file_.Close();
+        count_ = 0;
+        return false;
+    }
+
+    uint64_t RecordCount() const { return count_; }
+
+    /// Records consumed so far
+    uint64_t Position() const { return next_; }
+
+    bool Done() const { return next_ >= count_; }
+
+    /// Start time of the next record (not Done())
+    double PeekStartSec() const {
+        double startSec;
+        std::memcpy(&startSec, RecordAt(next_), sizeof(startSec));
+        return startSec;
+    }
+
+    /// Decode the next record (not Done()); the mapping is released once
+    /// the last record has been read
+    WorkloadRecord Next() {
+        const uint8_t* p = RecordAt(next_++);
+        WorkloadRecord r;
+        std::memcpy(&r.startSec, p, 8);
+        std::memcpy(&r.src, p + 8, 4);
+        std::memcpy(&r.dst, p + 12, 4);
+        std::memcpy(&r.bytes, p + 16, 8);
+
+        const size_t consumed = p + WORKLOAD_RECORD_BYTES - file_.Data();
+        if (Done()) {
+            file_.Close();
+        } else if (consumed - released_ >= WORKLOAD_DISCARD_BYTES) {
+            file_.Discard(consumed);
+            released_ = consumed;
+        }
+        return r;
+    }
+
+private:
+    const uint8_t* RecordAt(uint64_t index) const {
+        return file_.Data() + WORKLOAD_HEADER_BYTES + index * WORKLOAD_RECORD_BYTES;
+    }
+
+    MappedFile file_;
+    uint64_t count_ = 0;
+    uint64_t next_ = 0;
+    size_t released_ = 0;  ///< Bytes handed back to the page cache
+};
+
+} // namespace ns3shim
+
+#endif // NS3SHIM_WORKLOAD_FILE_H
@@ -0,0 +1,897 @@
+// replay.cpp
+// ns3shim-replay: re-executes a binary API call journal through the C ABI
+//
+// A journal recorded from any host (journal_open or NS3SHIM_JOURNAL) is
+// replayed call by call against this build of the shim. Recorded handles are
+// mapped to the handles returned by the replayed calls, and calls made from
+// host callbacks during sim_run are re-issued at their recorded simulation
+// time via sim_schedule. Host callbacks themselves (trace subscriptions,
+// sim_schedule targets) are replaced by counting no-ops, so the replay
+// measures shim + ns-3 cost only.
+//
+// Usage:
+//   ns3shim-replay [-v] [--strict] run.ns3j
+//
+// Prints a per-operation table of recorded vs replayed call time. The gap
+// between the recorded wall span and the recorded call time is host-side
+// work (P/Invoke, managed code, callbacks). Exit status is 1 if the journal
+// is unreadable, or with --strict if any replayed status or flowmon_collect
+// result differs from the recording.
+
+#include "ns3shim.h"
+#include "journal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using ns3shim::JournalCursor;
+using ns3shim::JournalFileHeader;
+using ns3shim::JournalOp;
+using ns3shim::JournalRecordHeader;
+
+namespace {
+
+struct Options {
+    const char* path = nullptr;
+    bool verbose = false;
+    bool strict = false;
+};
+
+void Usage(const char* prog) {
+    std::fprintf(stderr, "usage: %s [-v] [--strict] journal.ns3j\n", prog);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-v" || arg == "--verbose") opt.verbose = true;
+        else if (arg == "--strict") opt.strict = true;
+        else if (!opt.path && arg[0] != '-') opt.path = argv[i];
+        else return false;
+    }
+    return opt.path != nullptr;
+}
+
+bool ReadFile(const char* path, std::vector<uint8_t>& out) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        std::fclose(file);
+        return false;
+    }
+
+    out.resize(static_cast<size_t>(size));
+    const bool ok = out.empty() || std::fread(out.data(), 1, out.size(), file) == out.size();
+    std::fclose(file);
+    return ok;
+}
+
+uint64_t NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Host callback stand-ins
+uint64_t g_voidCallbacks = 0;
+uint64_t g_packetCallbacks = 0;
+
+void CountVoid(void*) { ++g_voidCallbacks; }
+void CountPacket(void*, uint64_t, double, uint32_t) { ++g_packetCallbacks; }
+void CountPacketEx(void*, const ns3_pkt_event_ex*) { ++g_packetCallbacks; }
+void CountQueueEvent(void*, const ns3_queue_event*) { ++g_packetCallbacks; }
+void CountEventBatch(void*, const ns3_event*, uint32_t count) { g_packetCallbacks += count; }
+
+struct OpStats {
+    uint64_t calls = 0;
+    uint64_t failed = 0;
+    uint64_t mismatches = 0;
+    uint64_t recordedNs = 0;
+    uint64_t replayedNs = 0;
+};
+
+/// One journal record, pointing into the loaded file
+struct Record {
+    JournalRecordHeader header;
+    const uint8_t* payload;
+};
+
+class Replayer;
+
+/// Deferred in-callback record, executed from a sim_schedule trampoline
+struct Deferred {
+    Replayer* replayer;
+    Record record;
+};
+
+class Replayer {
+public:
+    explicit Replayer(const Options& opt) : opt_(opt) {}
+
+    ~Replayer() {
+        // A journal cut short (crash, no sim_destroy) still leaves live simulations
+        for (auto& [id, sim] : sims_) sim_destroy(sim);
+    }
+
+    /// Replays a top-level record; in-callback records are held for their sim_run
+    void Execute(const Record& rec);
+    void Report(uint64_t recordCount, uint64_t spanNs) const;
+    uint64_t Mismatches() const { return mismatches_; }
+
+private:
+    static void Trampoline(void* user) {
+        auto* d = static_cast<Deferred*>(user);
+        d->replayer->Run(d->record);
+    }
+
+    void Run(const Record& rec);
+
+    ns3_sim Sim(uint32_t id) const {
+        auto it = sims_.find(id);
+        return it == sims_.end() ? nullptr : it->second;
+    }
+
+    // Recorded handle ids are per kind; unknown ids pass through unchanged so
+    // that the shim reports the same invalid-handle errors as when recorded
+    template <typename H>
+    H Map(const std::unordered_map<uint64_t, uint64_t>& map, uint64_t recorded) const {
+        if (recorded == 0) return nullptr;
+        auto it = map.find(recorded);
+        return reinterpret_cast<H>(it == map.end() ? recorded : it->second);
+    }
+
+    template <typename H>
+    std::vector<H> MapAll(const std::unordered_map<uint64_t, uint64_t>& map,
+                          const std::vector<uint64_t>& recorded) const {
+        std::vector<H> out(recorded.size());
+        for (size_t i = 0; i < recorded.size(); ++i) out[i] = Map<H>(map, recorded[i]);
+        return out;
+    }
+
+    template <typename H>
+    static void Bind(std::unordered_map<uint64_t, uint64_t>& map, uint64_t recorded, H live) {
+        map[recorded] = reinterpret_cast<uint64_t>(live);
+    }
+
+    ns3_status Dispatch(const Record& rec, JournalCursor& in, bool recordedOk, bool& outputMismatch);
+    void ScheduleDeferred(ns3_sim sim);
+
+    const Options& opt_;
+    std::map<uint32_t, ns3_sim> sims_;
+    std::unordered_map<uint64_t, uint64_t> nodes_;
+    std::unordered_map<uint64_t, uint64_t> devices_;
+    std::unordered_map<uint64_t, uint64_t> apps_;
+    std::unordered_map<uint64_t, uint64_t> flowMons_;
+    std::unordered_map<uint64_t, uint64_t> workloads_;
+    std::unordered_map<uint64_t, uint64_t> traceFiles_;
+    std::unordered_map<uint64_t, uint64_t> throughputs_;
+    std::unordered_map<uint64_t, uint64_t> latencies_;
+    std::unordered_map<uint64_t, uint64_t> fcts_;
+    std::unordered_map<uint64_t, uint64_t> queueMonitors_;
+    std::unordered_map<uint64_t, uint64_t> tcpBulks_;
+    std::unordered_map<uint64_t, uint64_t> traceSubs_;
+    std::unordered_map<uint64_t, uint64_t> captureRings_;
+    std::unordered_map<uint64_t, uint64_t> flowEpochs_;
+    std::vector<Record> pending_;     // in-callback records awaiting their sim_run
+    std::deque<Deferred> deferred_;   // stable storage for scheduled records
+    std::map<JournalOp, OpStats> stats_;
+    uint64_t mismatches_ = 0;
+};
+
+void Replayer::Execute(const Record& rec) {
+    // Calls made from host callbacks are recorded before the sim_run that
+    // invoked them; hold them until that run is replayed
+    if (rec.header.flags & ns3shim::JOURNAL_FLAG_IN_CALLBACK) {
+        pending_.push_back(rec);
+        return;
+    }
+
+    if (static_cast<JournalOp>(rec.header.op) == JournalOp::SimRun) {
+        ScheduleDeferred(Sim(rec.header.simId));
+    }
+    Run(rec);
+}
+
+void Replayer::Run(const Record& rec) {
+    const auto op = static_cast<JournalOp>(rec.header.op);
+    const bool recordedOk = (rec.header.flags & ns3shim::JOURNAL_FLAG_OK) != 0;
+    const bool inCallback = (rec.header.flags & ns3shim::JOURNAL_FLAG_IN_CALLBACK) != 0;
+
+    JournalCursor in(rec.payload, rec.header.payloadSize);
+    bool outputMismatch = false;
+    const uint64_t start = NowNs();
+    ns3_status status = Dispatch(rec, in, recordedOk, outputMismatch);
+    const uint64_t elapsed = NowNs() - start;
+
+    const bool mismatch = (status == NS3_OK) != recordedOk || outputMismatch;
+    OpStats& s = stats_[op];
+    ++s.calls;
+    s.recordedNs += rec.header.durationNs;
+    s.replayedNs += elapsed;
+    if (status != NS3_OK) ++s.failed;
+    if (mismatch) {
+        ++s.mismatches;
+        ++mismatches_;
+    }
+
+    if (opt_.verbose || mismatch) {
+        std::fprintf(mismatch ? stderr : stdout, "%s%-32s sim=%u %s recorded=%s %10.3f us -> %s %10.3f us\n",
+                     mismatch ? "MISMATCH " : "", ns3shim::JournalOpName(op), rec.header.simId,
+                     inCallback ? "(callback)" : "          ", recordedOk ? "ok " : "err",
+                     rec.header.durationNs / 1e3, status == NS3_OK ? "ok " : "err", elapsed / 1e3);
+    }
+}
+
+void Replayer::ScheduleDeferred(ns3_sim sim) {
+    if (pending_.empty()) return;
+
+    double now = 0.0;
+    if (sim) sim_now(sim, &now);
+
+    for (const Record& rec : pending_) {
+        deferred_.push_back(Deferred{this, rec});
+        const double delay = std::max(0.0, rec.header.simTimeSec - now);
+        if (!sim || sim_schedule(sim, delay, &Replayer::Trampoline, &deferred_.back()) != NS3_OK) {
+            std::fprintf(stderr, "cannot schedule %s at t=%.9f\n",
+                         ns3shim::JournalOpName(static_cast<JournalOp>(rec.header.op)), rec.header.simTimeSec);
+            ++mismatches_;
+        }
+    }
+    pending_.clear();
+}
+
+ns3_status Replayer::Dispatch(const Record& rec, JournalCursor& in, bool recordedOk, bool& outputMismatch) {
+    ns3_sim sim = Sim(rec.header.simId);
+    std::string s1, s2;
+
+    switch (static_cast<JournalOp>(rec.header.op)) {
+        case JournalOp::SimCreate:
+        case JournalOp::SimCreateEx: {
+            ns3_sim_options options{};
+            bool hasOptions = false;
+            if (static_cast<JournalOp>(rec.header.op) == JournalOp::SimCreateEx) {
+                hasOptions = in.U8() != 0;
+                options.impl = static_cast<ns3_sim_impl>(in.I32());
+            }
+            ns3_sim created = nullptr;
+            ns3_status status = hasOptions ? sim_create_ex(&created, &options) : sim_create(&created);
+            if (status == NS3_OK && recordedOk) sims_[in.U32()] = created;
+            return status;
+        }
+        case JournalOp::SimSetSeed:
+            return sim_set_seed(sim, in.U32());
+        case JournalOp::SimRun:
+            return sim_run(sim);
+        case JournalOp::SimStop:
+            return sim_stop(sim, in.F64());
+        case JournalOp::SimSchedule:
+            return sim_schedule(sim, in.F64(), &CountVoid, nullptr);
+        case JournalOp::SimDestroy: {
+            ns3_status status = sim_destroy(sim);
+            sims_.erase(rec.header.simId);
+            return status;
+        }
+        case JournalOp::NodesCreate: {
+            const uint32_t count = in.U32();
+            std::vector<uint32_t> systemIds;
+            if (in.U8()) {
+                systemIds.resize(count);
+                for (uint32_t& id : systemIds) id = in.U32();
+            }
+            std::vector<ns3_node> out(count);
+            ns3_status status = nodes_create_ex(sim, count, systemIds.empty() ? nullptr : systemIds.data(), out.data());
+            if (status == NS3_OK && recordedOk) {
+                const auto recorded = in.Handles();
+                for (size_t i = 0; i < recorded.size() && i < out.size(); ++i) Bind(nodes_, recorded[i], out[i]);
+            }
+            return status;
+        }
+        case JournalOp::InternetInstall: {
+            const auto nodes = MapAll<ns3_node>(nodes_, in.Handles());
+            return internet_install(sim, nodes.data(), static_cast<uint32_t>(nodes.size()));
+        }
+        case JournalOp::P2PInstall: {
+            ns3_node a = Map<ns3_node>(nodes_, in.U64());
+            ns3_node b = Map<ns3_node>(nodes_, in.U64());
+            const bool hasRate = in.Str(s1);
+            const bool hasDelay = in.Str(s2);
+            const uint32_t mtu = in.U32();
+            ns3_device devA = nullptr, devB = nullptr;
+            ns3_status status = p2p_install(sim, a, b, hasRate ? s1.c_str() : nullptr,
+                                            hasDelay ? s2.c_str() : nullptr, mtu, &devA, &devB);
+            if (status == NS3_OK && recordedOk) {
+                Bind(devices_, in.U64(), devA);
+                Bind(devices_, in.U64(), devB);
+            }
+            return status;
+        }
+        case JournalOp::CsmaInstall: {
+            const auto nodes = MapAll<ns3_node>(nodes_, in.Handles());
+            const bool hasRate = in.Str(s1);
+            const bool hasDelay = in.Str(s2);
+            std::vector<ns3_device> out(nodes.size());
+            ns3_status status = csma_install(sim, nodes.data(), static_cast<uint32_t>(nodes.size()),
+                                             hasRate ? s1.c_str() : nullptr, hasDelay ? s2.c_str() : nullptr,
+                                             out.data());
+            if (status == NS3_OK && recordedOk) {
+                const auto recorded = in.Handles();
+                for (size_t i = 0; i < recorded.size() && i < out.size(); ++i) Bind(devices_, recorded[i], out[i]);
+            }
+            return status;
+        }
+        case JournalOp::WifiInstallStaAp: {
+            const auto stas = MapAll<ns3_node>(nodes_, in.Handles());
+            ns3_node ap = Map<ns3_node>(nodes_, in.U64());
+            const int standard = in.I32();
+            const bool hasRate = in.Str(s1);
+            const int channel = in.I32();
+            std::vector<ns3_device> out(stas.size());
+            ns3_device apDev = nullptr;
+            ns3_status status = wifi_install_sta_ap(sim, stas.data(), static_cast<uint32_t>(stas.size()), ap,
+                                                    standard, hasRate ? s1.c_str() : nullptr, channel,
+                                                    out.data(), &apDev);
+            if (status == NS3_OK && recordedOk) {
+                const auto recorded = in.Handles();
+                for (size_t i = 0; i < recorded.size() && i < out.size(); ++i) Bind(devices_, recorded[i], out[i]);
+                Bind(devices_, in.U64(), apDev);
+            }
+            return status;
+        }
+        case JournalOp::MobilitySetConstantPosition: {
+            ns3_node node = Map<ns3_node>(nodes_, in.U64());
+            const double x = in.F64();
+            const double y = in.F64();
+            const double z = in.F64();
+            return mobility_set_constant_position(sim, node, x, y, z);
+        }
+        case JournalOp::Ipv4Assign: {
+            const auto devices = MapAll<ns3_device>(devices_, in.Handles());
+            const bool hasBase = in.Str(s1);
+            const bool hasMask = in.Str(s2);
+            return ipv4_assign(sim, devices.data(), static_cast<uint32_t>(devices.size()),
+                               hasBase ? s1.c_str() : nullptr, hasMask ? s2.c_str() : nullptr);
+        }
+        case JournalOp::Ipv4PopulateRoutingTables:
+            return ipv4_populate_routing_tables(sim);
+        case JournalOp::AppUdpEchoServer: {
+            ns3_node node = Map<ns3_node>(nodes_, in.U64());
+            const auto port = static_cast<uint16_t>(in.U32());
+            ns3_app app = nullptr;
+            ns3_status status = app_udpecho_server(sim, node, port, &app);
+            if (status == NS3_OK && recordedOk) Bind(apps_, in.U64(), app);
+            return status;
+        }
+        case JournalOp::AppUdpEchoClient: {
+            ns3_node node = Map<ns3_node>(nodes_, in.U64());
+            const bool hasIp = in.Str(s1);
+            const auto port = static_cast<uint16_t>(in.U32());
+            const uint32_t size = in.U32();
+            const double interval = in.F64();
+            const uint32_t maxPackets = in.U32();
+            ns3_app app = nullptr;
+            ns3_status status = app_udpecho_client(sim, node, hasIp ? s1.c_str() : nullptr, port, size,
+                                                   interval, maxPackets, &app);
+            if (status == NS3_OK && recordedOk) Bind(apps_, in.U64(), app);
+            return status;
+        }
+        case JournalOp::AppTrafficGen: {
+            ns3_node node = Map<ns3_node>(nodes_, in.U64());
+            const bool hasIp = in.Str(s1);
+            const uint16_t port = in.U16();
+            ns3_traffic_gen_options options{};
+            const bool hasOptions = in.U8() != 0;
+            if (hasOptions) {
+                options.packetSize = in.U32();
+                options.pattern = in.U32();
+                options.intervalSec = in.F64();
+                options.batch = in.U32();
+                options.flags = in.U32();
+                options.maxPackets = in.U64();
+            }
+            ns3_app app = nullptr;
+            ns3_status status = app_traffic_gen(sim, node, hasIp ? s1.c_str() : nullptr, port,
+                                                hasOptions ? &options : nullptr, &app);
+            if (status == NS3_OK && recordedOk) Bind(apps_, in.U64(), app);
+            return status;
+        }
+        case JournalOp::AppPcapReplay: {
+            ns3_node node = Map<ns3_node>(nodes_, in.U64());
+            const bool hasPath = in.Str(s1);
+            const bool hasIp = in.Str(s2);
+            const uint16_t port = in.U16();
+            ns3_pcap_replay_options options{};
+            const bool hasOptions = in.U8() != 0;
+            if (hasOptions) {
+                options.timeScale = in.F64();
+                options.maxPackets = in.U64();
+            }
+            ns3_app app = nullptr;
+            ns3_status status = app_pcap_replay(sim, node, hasPath ? s1.c_str() : nullptr, hasIp ? s2.c_str() : nullptr,
+                                                port, hasOptions ? &options : nullptr, &app);
+            if (status == NS3_OK && recordedOk) Bind(apps_, in.U64(), app);
+            return status;
+        }
+        case JournalOp::AppInstallBulk: {
+            const auto nodes = MapAll<ns3_node>(nodes_, in.Handles());
+            std::vector<ns3_app_spec> specs(in.U32());
+            for (ns3_app_spec& spec : specs) {
+                spec.kind = in.U32();
+                spec.srcNode = in.U32();
+                spec.dstNode = in.U32();
+                spec.dstAddr = in.U32();
+                spec.port = in.U16();
+                spec.protocol = in.U16();
+                spec.packetSize = in.U32();
+                spec.rateBps = in.F64();
+                spec.size = in.U64();
+                spec.startSec = in.F64();
+                spec.stopSec = in.F64();
+            }
+            std::vector<ns3_app> out(specs.size());
+            ns3_status status = app_install_bulk(sim, nodes.data(), static_cast<uint32_t>(nodes.size()),
+                                                 specs.data(), static_cast<uint32_t>(specs.size()), out.data());
+            if (status == NS3_OK && recordedOk) {
+                const auto recorded = in.Handles();
+                for (size_t i = 0; i < recorded.size() && i < out.size(); ++i) Bind(apps_, recorded[i], out[i]);
+            }
+            return status;
+        }
+        case JournalOp::WorkloadOpen: {
+            const bool hasPath = in.Str(s1);
+            const auto nodes = MapAll<ns3_node>(nodes_, in.Handles());
+            ns3_workload_options options{};
+            const bool hasOptions = in.U8() != 0;
+            if (hasOptions) {
+                options.port = in.U16();
+                options.sendSize = in.U32();
+            }
+            ns3_workload workload = nullptr;
+            ns3_status status = workload_open(sim, hasPath ? s1.c_str() : nullptr, nodes.data(),
+                                              static_cast<uint32_t>(nodes.size()), hasOptions ? &options : nullptr,
+                                              &workload);
+            if (status == NS3_OK && recordedOk) Bind(workloads_, in.U64(), workload);
+            return status;
+        }
+        case JournalOp::AppStart: {
+            ns3_app app = Map<ns3_app>(apps_, in.U64());
+            return app_start(sim, app, in.F64());
+        }
+        case JournalOp::AppStop: {
+            ns3_app app = Map<ns3_app>(apps_, in.U64());
+            return app_stop(sim, app, in.F64());
+        }
+        case JournalOp::TraceSubscribePacketEvents: {
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            const bool hasTx = in.U8() != 0;
+            const bool hasRx = in.U8() != 0;
+            return trace_subscribe_packet_events(sim, dev, hasTx ? &CountPacket : nullptr,
+                                                 hasRx ? &CountPacket : nullptr, nullptr);
+        }
+        case JournalOp::TraceSubscribePacketEventsHandle: {
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            const bool hasTx = in.U8() != 0;
+            const bool hasRx = in.U8() != 0;
+            ns3_trace_sub sub = nullptr;
+            ns3_status status = trace_subscribe_packet_events_handle(sim, dev, hasTx ? &CountPacket : nullptr,
+                                                                     hasRx ? &CountPacket : nullptr, nullptr, &sub);
+            if (status == NS3_OK && recordedOk) Bind(traceSubs_, in.U64(), sub);
+            return status;
+        }
+        case JournalOp::TraceSubscribePacketEventsEx: {
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            const bool hasTx = in.U8() != 0;
+            const bool hasRx = in.U8() != 0;
+            return trace_subscribe_packet_events_ex(sim, dev, hasTx ? &CountPacketEx : nullptr,
+                                                    hasRx ? &CountPacketEx : nullptr, nullptr);
+        }
+        case JournalOp::TraceSubscribePacketEventsExHandle: {
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            const bool hasTx = in.U8() != 0;
+            const bool hasRx = in.U8() != 0;
+            ns3_trace_sub sub = nullptr;
+            ns3_status status = trace_subscribe_packet_events_ex_handle(sim, dev,
+                                                                        hasTx ? &CountPacketEx : nullptr,
+                                                                        hasRx ? &CountPacketEx : nullptr, nullptr,
+                                                                        &sub);
+            if (status == NS3_OK && recordedOk) Bind(traceSubs_, in.U64(), sub);
+            return status;
+        }
+        case JournalOp::TraceUnsubscribe: {
+            ns3_trace_sub sub = Map<ns3_trace_sub>(traceSubs_, in.U64());
+            return trace_unsubscribe(sim, sub);
+        }
+        case JournalOp::TraceSetFilter: {
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            if (in.U8() == 0) return trace_set_filter(sim, dev, nullptr);
+            ns3_trace_filter filter{};
+            filter.minSize = in.U32();
+            filter.maxSize = in.U32();
+            filter.srcAddr = in.U32();
+            filter.srcMask = in.U32();
+            filter.dstAddr = in.U32();
+            filter.dstMask = in.U32();
+            filter.srcPortMin = in.U16();
+            filter.srcPortMax = in.U16();
+            filter.dstPortMin = in.U16();
+            filter.dstPortMax = in.U16();
+            filter.sampleEvery = in.U32();
+            filter.protocol = in.U8();
+            return trace_set_filter(sim, dev, &filter);
+        }
+        case JournalOp::PcapEnable: {
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            const bool hasPrefix = in.Str(s1);
+            return pcap_enable(sim, dev, hasPrefix ? s1.c_str() : nullptr);
+        }
+        case JournalOp::PcapEnableEx: {
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            const bool hasPrefix = in.Str(s1);
+            if (in.U8() == 0) return pcap_enable_ex(sim, dev, hasPrefix ? s1.c_str() : nullptr, nullptr);
+            ns3_pcap_options options{};
+            options.bufferBytes = in.U32();
+            options.snaplen = in.U32();
+            options.flushIntervalSec = in.F64();
+            options.flags = in.U32();
+            options.compression = in.U32();
+            options.compressionLevel = in.I32();
+            return pcap_enable_ex(sim, dev, hasPrefix ? s1.c_str() : nullptr, &options);
+        }
+        case JournalOp::CaptureRingOpen: {
+            const bool hasName = in.Str(s1);
+            ns3_capture_ring_options options{};
+            const bool hasOptions = in.U8() != 0;
+            if (hasOptions) {
+                options.capacityBytes = in.U32();
+                options.snaplen = in.U32();
+                options.flags = in.U32();
+            }
+            ns3_capture_ring ring = nullptr;
+            ns3_status status = capture_ring_open(sim, hasName ? s1.c_str() : nullptr, hasOptions ? &options : nullptr, &ring);
+            if (status == NS3_OK && recordedOk) Bind(captureRings_, in.U64(), ring);
+            return status;
+        }
+        case JournalOp::CaptureRingAttach: {
+            ns3_capture_ring ring = Map<ns3_capture_ring>(captureRings_, in.U64());
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            return capture_ring_attach(sim, ring, dev);
+        }
+        case JournalOp::CaptureRingClose:
+            return capture_ring_close(sim, Map<ns3_capture_ring>(captureRings_, in.U64()));
+        case JournalOp::EventSinkOpen: {
+            const bool hasCallback = in.U8() != 0;
+            const uint32_t batchCapacity = in.U32();
+            return event_sink_open(sim, hasCallback ? &CountEventBatch : nullptr, nullptr, batchCapacity);
+        }
+        case JournalOp::EventSinkEnable: {
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            const uint32_t eventMask = in.U32();
+            uint32_t slot = 0;
+            ns3_status status = event_sink_enable(sim, dev, eventMask, &slot);
+            if (status == NS3_OK && recordedOk && slot != in.U32()) outputMismatch = true;
+            return status;
+        }
+        case JournalOp::EventSinkFlush:
+            return event_sink_flush(sim);
+        case JournalOp::EventSinkClose:
+            return event_sink_close(sim);
+        case JournalOp::TraceFileOpen: {
+            const bool hasPath = in.Str(s1);
+            const uint32_t flags = in.U32();
+            ns3_trace_file file = nullptr;
+            ns3_status status = trace_file_open(sim, hasPath ? s1.c_str() : nullptr, flags, &file);
+            if (status == NS3_OK && recordedOk) Bind(traceFiles_, in.U64(), file);
+            return status;
+        }
+        case JournalOp::TraceFileAttach: {
+            ns3_trace_file file = Map<ns3_trace_file>(traceFiles_, in.U64());
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            return trace_file_attach(sim, file, dev);
+        }
+        case JournalOp::TraceFileClose:
+            return trace_file_close(sim, Map<ns3_trace_file>(traceFiles_, in.U64()), nullptr);
+        case JournalOp::ThroughputCreate: {
+            const double binWidth = in.F64();
+            const uint32_t windowBins = in.U32();
+            ns3_throughput tp = nullptr;
+            ns3_status status = throughput_create(sim, binWidth, windowBins, &tp);
+            if (status == NS3_OK && recordedOk) Bind(throughputs_, in.U64(), tp);
+            return status;
+        }
+        case JournalOp::ThroughputAttach: {
+            ns3_throughput tp = Map<ns3_throughput>(throughputs_, in.U64());
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            return throughput_attach(sim, tp, dev);
+        }
+        case JournalOp::QueueMonitorCreate: {
+            const double binWidth = in.F64();
+            const uint32_t windowBins = in.U32();
+            const bool hasCallback = in.U8() != 0;
+            ns3_queue_monitor qm = nullptr;
+            ns3_status status = queue_monitor_create(sim, binWidth, windowBins,
+                                                     hasCallback ? &CountQueueEvent : nullptr, nullptr, &qm);
+            if (status == NS3_OK && recordedOk) Bind(queueMonitors_, in.U64(), qm);
+            return status;
+        }
+        case JournalOp::QueueMonitorAttach: {
+            ns3_queue_monitor qm = Map<ns3_queue_monitor>(queueMonitors_, in.U64());
+            ns3_device dev = Map<ns3_device>(devices_, in.U64());
+            return queue_monitor_attach(sim, qm, dev);
+        }
+        case JournalOp::TcpBulkInstall: {
+            const auto nodes = MapAll<ns3_node>(nodes_, in.Handles());
+            std::vector<ns3_tcp_flow_spec> specs(in.U32());
+            for (ns3_tcp_flow_spec& spec : specs) {
+                spec.srcNode = in.U32();
+                spec.dstNode = in.U32();
+                spec.port = in.U16();
+                spec.congestionControl = in.U16();
+                spec.initialCwndSegments = in.U32();
+                spec.bytes = in.U64();
+                spec.startSec = in.F64();
+                spec.stopSec = in.F64();
+            }
+            ns3_tcp_bulk_options options{};
+            const bool hasOptions = in.U8() != 0;
+            if (hasOptions) {
+                options.sendSize = in.U32();
+                options.segmentSize = in.U32();
+                options.sndBufBytes = in.U32();
+                options.rcvBufBytes = in.U32();
+                options.intervalSec = in.F64();
+                options.windowIntervals = in.U32();
+            }
+            std::vector<ns3_app> senders(specs.size());
+            ns3_tcp_bulk bulk = nullptr;
+            ns3_status status = tcp_bulk_install(sim, nodes.data(), static_cast<uint32_t>(nodes.size()),
+                                                 specs.data(), static_cast<uint32_t>(specs.size()),
+                                                 hasOptions ? &options : nullptr, senders.data(), &bulk);
+            if (status == NS3_OK && recordedOk) {
+                const auto recorded = in.Handles();
+                for (size_t i = 0; i < recorded.size() && i < senders.size(); ++i) Bind(apps_, recorded[i], senders[i]);
+                Bind(tcpBulks_, in.U64(), bulk);
+            }
+            return status;
+        }
+        case JournalOp::LatencyInstallAll: {
+            const uint32_t precisionBits = in.U32();
+            ns3_latency lat = nullptr;
+            ns3_status status = latency_install_all(sim, precisionBits, &lat);
+            if (status == NS3_OK && recordedOk) Bind(latencies_, in.U64(), lat);
+            return status;
+        }
+        case JournalOp::FctInstallAll: {
+            ns3_fct_options options{};
+            std::vector<uint64_t> edges;
+            const bool hasOptions = in.U8() != 0;
+            if (hasOptions) {
+                edges.resize(in.U32());
+                for (uint64_t& edge : edges) edge = in.U64();
+                options.sizeEdges = edges.empty() ? nullptr : edges.data();
+                options.sizeEdgeCount = static_cast<uint32_t>(edges.size());
+                options.idleSec = in.F64();
+                options.compression = in.F64();
+            }
+            ns3_fct fct = nullptr;
+            ns3_status status = fct_install_all(sim, hasOptions ? &options : nullptr, &fct);
+            if (status == NS3_OK && recordedOk) Bind(fcts_, in.U64(), fct);
+            return status;
+        }
+        case JournalOp::FlowMonInstallAll: {
+            ns3_flowmon fm = nullptr;
+            ns3_status status = flowmon_install_all(sim, &fm);
+            if (status == NS3_OK && recordedOk) Bind(flowMons_, in.U64(), fm);
+            return status;
+        }
+        case JournalOp::FlowMonInstall: {
+            const auto nodes = MapAll<ns3_node>(nodes_, in.Handles());
+            ns3_flowmon_options options{};
+            const bool hasOptions = in.U8() != 0;
+            if (hasOptions) {
+                options.edgeOnly = in.I32();
+                options.maxPerHopDelaySec = in.F64();
+                options.startTimeSec = in.F64();
+            }
+            ns3_flowmon fm = nullptr;
+            ns3_status status = flowmon_install(sim, nodes.empty() ? nullptr : nodes.data(),
+                                                static_cast<uint32_t>(nodes.size()),
+                                                hasOptions ? &options : nullptr, &fm, nullptr);
+            if (status == NS3_OK && recordedOk) Bind(flowMons_, in.U64(), fm);
+            return status;
+        }
+        case JournalOp::FlowMonCollect: {
+            ns3_flowmon fm = Map<ns3_flowmon>(flowMons_, in.U64());
+            ns3_flow_stats stats{};
+            ns3_status status = flowmon_collect(sim, fm, &stats);
+            if (status == NS3_OK && recordedOk) {
+                ns3_flow_stats recorded{};
+                recorded.txPackets = in.U64();
+                recorded.rxPackets = in.U64();
+                recorded.txBytes = in.U64();
+                recorded.rxBytes = in.U64();
+                recorded.delaySumSec = in.F64();
+                recorded.jitterSumSec = in.F64();
+                recorded.flowCount = in.U32();
+                outputMismatch = stats.txPackets != recorded.txPackets || stats.rxPackets != recorded.rxPackets ||
+                                 stats.txBytes != recorded.txBytes || stats.rxBytes != recorded.rxBytes ||
+                                 stats.flowCount != recorded.flowCount;
+            }
+            return status;
+        }
+        case JournalOp::FlowEpochsStart: {
+            ns3_flowmon fm = Map<ns3_flowmon>(flowMons_, in.U64());
+            ns3_flow_epoch_options options{};
+            const bool hasOptions = in.U8() != 0;
+            bool hasPath = false;
+            if (hasOptions) {
+                options.epochSec = in.F64();
+                options.epochCapacity = in.U32();
+                options.maxFlows = in.U32();
+                hasPath = in.Str(s1);
+                options.path = hasPath ? s1.c_str() : nullptr;
+            }
+            ns3_flow_epochs epochs = nullptr;
+            ns3_status status = flowmon_epochs_start(sim, fm, hasOptions ? &options : nullptr, &epochs);
+            if (status == NS3_OK && recordedOk) Bind(flowEpochs_, in.U64(), epochs);
+            return status;
+        }
+        case JournalOp::FlowEpochsStop:
+            return flowmon_epochs_stop(sim, Map<ns3_flow_epochs>(flowEpochs_, in.U64()));
+        case JournalOp::SimSweepRun: {
+            if (!in.U8()) return sim_sweep_run(sim, nullptr, nullptr, 0);
+
+            ns3_sweep_config config{};
+            config.flowMon = Map<ns3_flowmon>(flowMons_, in.U64());
+            const uint32_t axisCount = in.U32();
+
+            // Axis strings and attribute values must outlive the call
+            std::deque<std::string> strings;
+            std::vector<std::vector<ns3_attr>> values(axisCount);
+            std::vector<ns3_sweep_axis> axes(axisCount);
+            for (uint32_t a = 0; a < axisCount; ++a) {
+                strings.emplace_back();
+                axes[a].path = in.Str(strings.back()) ? strings.back().c_str() : nullptr;
+                strings.emplace_back();
+                axes[a].attrName = in.Str(strings.back()) ? strings.back().c_str() : nullptr;
+                values[a].resize(in.U32());
+                for (ns3_attr& v : values[a]) {
+                    strings.emplace_back();
+                    v = in.Attr(strings.back());
+                }
+                axes[a].values = values[a].data();
+                axes[a].valueCount = static_cast<uint32_t>(values[a].size());
+            }
+            config.axes = axes.data();
+            config.axisCount = axisCount;
+            config.seed = in.U32();
+            config.firstRun = in.U64();
+            config.runCount = in.U32();
+            config.maxParallel = in.U32();
+            config.stopTimeSec = in.F64();
+            config.confidenceLevel = in.F64();
+            const uint32_t capacity = in.U32();
+
+            std::vector<ns3_sweep_point_summary> summaries(capacity);
+            return sim_sweep_run(sim, &config, summaries.empty() ? nullptr : summaries.data(), capacity);
+        }
+        case JournalOp::SimForkRuns: {
+            std::vector<uint64_t> runs(in.U32());
+            for (uint64_t& run : runs) run = in.U64();
+            ns3_flowmon fm = Map<ns3_flowmon>(flowMons_, in.U64());
+            const double stop = in.F64();
+            const uint32_t maxParallel = in.U32();
+            std::vector<ns3_fork_run_result> results(runs.size());
+            return sim_fork_runs(sim, runs.empty() ? nullptr : runs.data(), static_cast<uint32_t>(runs.size()), fm,
+                                 stop, maxParallel, results.empty() ? nullptr : results.data());
+        }
+        case JournalOp::ConfigSet: {
+            const bool hasPath = in.Str(s1);
+            const bool hasName = in.Str(s2);
+            std::string storage;
+            const ns3_attr value = in.Attr(storage);
+            return config_set(sim, hasPath ? s1.c_str() : nullptr, hasName ? s2.c_str() : nullptr, value);
+        }
+    }
+
+    std::fprintf(stderr, "unknown journal op %u\n", rec.header.op);
+    return NS3_ERR;
+}
+
+void Replayer::Report(uint64_t recordCount, uint64_t spanNs) const {
+    OpStats total;
+    std::printf("%-32s %10s %8s %8s %14s %14s\n", "op", "calls", "failed", "mismatch", "recorded_ms", "replayed_ms");
+    for (const auto& [op, s] : stats_) {
+        std::printf("%-32s %10llu %8llu %8llu %14.3f %14.3f\n", ns3shim::JournalOpName(op),
+                    static_cast<unsigned long long>(s.calls), static_cast<unsigned long long>(s.failed),
+                    static_cast<unsigned long long>(s.mismatches), s.recordedNs / 1e6, s.replayedNs / 1e6);
+        total.calls += s.calls;
+        total.failed += s.failed;
+        total.mismatches += s.mismatches;
+        total.recordedNs += s.recordedNs;
+        total.replayedNs += s.replayedNs;
+    }
+    std::printf("%-32s %10llu %8llu %8llu %14.3f %14.3f\n", "total",
+                static_cast<unsigned long long>(total.calls), static_cast<unsigned long long>(total.failed),
+                static_cast<unsigned long long>(total.mismatches), total.recordedNs / 1e6, total.replayedNs / 1e6);
+
+    // Nested calls overlap their enclosing sim_run, so the host share is a lower bound
+    const uint64_t hostNs = spanNs > total.recordedNs ? spanNs - total.recordedNs : 0;
+    std::printf("\nrecords: %llu  recorded span: %.3f ms  host time between calls: %.3f ms\n",
+                static_cast<unsigned long long>(recordCount), spanNs / 1e6, hostNs / 1e6);
+    std::printf("substituted callbacks: %llu scheduled, %llu packet events\n",
+                static_cast<unsigned long long>(g_voidCallbacks), static_cast<unsigned long long>(g_packetCallbacks));
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> data;
+    if (!ReadFile(opt.path, data)) {
+        std::fprintf(stderr, "cannot read %s\n", opt.path);
+        return 1;
+    }
+
+    JournalFileHeader fileHeader{};
+    if (data.size() < sizeof(fileHeader)) {
+        std::fprintf(stderr, "%s: not a journal\n", opt.path);
+        return 1;
+    }
+    std::memcpy(&fileHeader, data.data(), sizeof(fileHeader));
+    if (std::memcmp(fileHeader.magic, ns3shim::JOURNAL_MAGIC, sizeof(fileHeader.magic)) != 0 ||
+        fileHeader.headerSize < sizeof(fileHeader) || fileHeader.headerSize > data.size()) {
+        std::fprintf(stderr, "%s: not a journal\n", opt.path);
+        return 1;
+    }
+    if (fileHeader.version != ns3shim::JOURNAL_VERSION) {
+        std::fprintf(stderr, "%s: unsupported journal version %u\n", opt.path, fileHeader.version);
+        return 1;
+    }
+
+    // Index every record up front so that replay does no I/O
+    std::vector<Record> records;
+    size_t offset = fileHeader.headerSize;
+    while (offset + sizeof(JournalRecordHeader) <= data.size()) {
+        Record rec{};
+        std::memcpy(&rec.header, data.data() + offset, sizeof(rec.header));
+        offset += sizeof(rec.header);
+        if (rec.header.payloadSize > data.size() - offset) break;
+        rec.payload = data.data() + offset;
+        offset += rec.header.payloadSize;
+        records.push_back(rec);
+    }
+    if (offset != data.size()) {
+        std::fprintf(stderr, "%s: truncated after %zu records; replaying those\n", opt.path, records.size());
+    }
+
+    uint64_t spanNs = 0;
+    for (const Record& rec : records) {
+        spanNs = std::max(spanNs, rec.header.startNs + rec.header.durationNs);
+    }
+    if (!records.empty()) spanNs -= records.front().header.startNs;
+
+    Replayer replayer(opt);
+    try {
+        for (const Record& rec : records) replayer.Execute(rec);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s: %s\n", opt.path, e.what());
+        return 1;
+    }
+
+    replayer.Report(records.size(), spanNs);
+    return opt.strict && replayer.Mismatches() > 0 ? 1 : 0;
+}
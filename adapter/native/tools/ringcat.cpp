@@ -0,0 +1,191 @@
+// ringcat.cpp
+// ns3shim-ringcat: tails a live capture ring and writes it as a pcap stream
+//
+// Reference reader for the shared-memory layout in src/capture_ring.h. The
+// ring is mapped, a pcap file header is built from the ring header, and
+// records are copied out in batches and validated against tailPos before
+// they are written, so a batch the simulator overwrote mid-copy is skipped
+// rather than emitted torn. In drop mode the consumed position is published
+// so the simulator can reuse the space.
+//
+// Usage:
+//   ns3shim-ringcat [-q] ring-name | wireshark -k -i -
+//
+// Exits when the simulator closes the ring and every record has been read.
+// Unless -q is given, a summary of read, overwritten and dropped records is
+// printed to stderr.
+
+#include "capture_ring.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using ns3shim::CaptureRingHeader;
+
+namespace {
+
+constexpr size_t BATCH_BYTES = 1u << 20;
+constexpr std::chrono::milliseconds IDLE_POLL{1};
+
+struct Options {
+    bool quiet = false;
+    const char* name = nullptr;
+};
+
+void Usage(const char* prog) {
+    std::fprintf(stderr, "usage: %s [-q] ring-name\n", prog);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-q" || arg == "--quiet") opt.quiet = true;
+        else if (!opt.name && arg[0] != '-') opt.name = argv[i];
+        else return false;
+    }
+    return opt.name != nullptr;
+}
+
+struct Batch {
+    std::vector<uint8_t> bytes;
+    size_t records = 0;
+};
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    const std::string name = opt.name[0] == '/' ? opt.name : std::string("/") + opt.name;
+    // Drop-mode rings need a writable readPos; overwrite-mode readers only read
+    bool writable = true;
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        writable = false;
+        fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    }
+    if (fd < 0) {
+        std::fprintf(stderr, "cannot open capture ring %s: %s\n", name.c_str(), std::strerror(errno));
+        return 1;
+    }
+
+    const int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* headMap = ::mmap(nullptr, ns3shim::CAPTURE_RING_HEADER_BYTES, PROT_READ, MAP_SHARED, fd, 0);
+    if (headMap == MAP_FAILED) {
+        std::fprintf(stderr, "cannot map capture ring %s: %s\n", name.c_str(), std::strerror(errno));
+        return 1;
+    }
+    const auto* probe = static_cast<const CaptureRingHeader*>(headMap);
+    if (std::memcmp(probe->magic, ns3shim::CAPTURE_RING_MAGIC, sizeof(probe->magic)) != 0 ||
+        probe->version != ns3shim::CAPTURE_RING_VERSION) {
+        std::fprintf(stderr, "%s: not a capture ring (or unsupported version)\n", name.c_str());
+        return 1;
+    }
+    const uint64_t dataBytes = probe->dataBytes;
+    const uint32_t headerBytes = probe->headerBytes;
+    const bool dropMode = (probe->flags & ns3shim::CAPTURE_RING_DROP) != 0;
+    ::munmap(headMap, ns3shim::CAPTURE_RING_HEADER_BYTES);
+    if (dropMode && !writable) {
+        std::fprintf(stderr, "%s: drop-mode ring needs write access\n", name.c_str());
+        return 1;
+    }
+
+    void* map = ::mmap(nullptr, headerBytes + dataBytes, prot, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        std::fprintf(stderr, "cannot map capture ring %s: %s\n", name.c_str(), std::strerror(errno));
+        return 1;
+    }
+    auto* ring = static_cast<CaptureRingHeader*>(map);
+    const uint8_t* data = static_cast<const uint8_t*>(map) + headerBytes;
+    const uint64_t mask = dataBytes - 1;
+
+    // The link type is known once the first device is attached
+    uint32_t linkType;
+    while ((linkType = ring->linkType.load(std::memory_order_acquire)) == 0) {
+        if (ring->closed.load(std::memory_order_acquire)) return 0;
+        std::this_thread::sleep_for(IDLE_POLL);
+    }
+    const uint32_t fileHeader[6] = {ns3shim::PCAP_MAGIC_USEC, 2u | (4u << 16), 0, 0, ring->snaplen, linkType};
+    std::fwrite(fileHeader, 1, sizeof(fileHeader), stdout);
+    std::fflush(stdout);
+
+    uint64_t pos = dropMode ? ring->readPos.load(std::memory_order_relaxed)
+                            : ring->tailPos.load(std::memory_order_acquire);
+    uint64_t read = 0;
+    uint64_t resyncs = 0;
+    Batch batch;
+    batch.bytes.reserve(BATCH_BYTES + ns3shim::CaptureRingRecordBytes(ring->snaplen));
+
+    for (;;) {
+        const uint64_t end = ring->writePos.load(std::memory_order_acquire);
+        if (pos == end) {
+            if (ring->closed.load(std::memory_order_acquire) && ring->writePos.load(std::memory_order_acquire) == pos) break;
+            std::this_thread::sleep_for(IDLE_POLL);
+            continue;
+        }
+
+        // Copy out whole records; headers may be garbage if overwritten, so bound them
+        batch.bytes.clear();
+        batch.records = 0;
+        uint64_t next = pos;
+        while (next < end && batch.bytes.size() < BATCH_BYTES) {
+            const uint64_t offset = next & mask;
+            uint32_t capLen;
+            std::memcpy(&capLen, data + offset + 8, sizeof(capLen));
+            if (capLen == ns3shim::CAPTURE_RING_PAD) {
+                next += dataBytes - offset;
+                continue;
+            }
+            if (capLen > ring->snaplen) break;
+            const size_t at = batch.bytes.size();
+            batch.bytes.resize(at + ns3shim::PCAP_RECORD_HEADER_BYTES + capLen);
+            std::memcpy(batch.bytes.data() + at, data + offset, ns3shim::PCAP_RECORD_HEADER_BYTES + capLen);
+            ++batch.records;
+            next += ns3shim::CaptureRingRecordBytes(capLen);
+        }
+
+        // If the tail passed the batch start, the writer overwrote part of
+        // what was copied (and record boundaries after it may be wrong):
+        // discard the batch and resume at the oldest intact record
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t tail = dropMode ? 0 : ring->tailPos.load(std::memory_order_relaxed);
+        if (tail > pos) {
+            ++resyncs;
+            pos = tail;
+            continue;
+        }
+        if (!batch.bytes.empty()) {
+            std::fwrite(batch.bytes.data(), 1, batch.bytes.size(), stdout);
+            std::fflush(stdout);
+            read += batch.records;
+        }
+        pos = next;
+        if (dropMode) ring->readPos.store(pos, std::memory_order_release);
+        if (std::ferror(stdout)) break;
+    }
+
+    if (!opt.quiet) {
+        std::fprintf(stderr, "%s: %llu records read, %llu resyncs after falling behind; writer: %llu records, "
+                             "%llu overwritten, %llu dropped\n",
+                     name.c_str(), static_cast<unsigned long long>(read), static_cast<unsigned long long>(resyncs),
+                     static_cast<unsigned long long>(ring->records.load(std::memory_order_relaxed)),
+                     static_cast<unsigned long long>(ring->overwritten.load(std::memory_order_relaxed)),
+                     static_cast<unsigned long long>(ring->dropped.load(std::memory_order_relaxed)));
+    }
+    return 0;
+}